@@ -0,0 +1,16 @@
+<?xml version="1.0" encoding="UTF-8"?>
+<tileset version="1.10" tiledversion="1.11.2" name="water_anim" tilewidth="32" tileheight="32" tilecount="3072" columns="64">
+ <image source="../Pipoya_RPG_Tileset_32x32/SampleMap/[A]Water_pipo.png" width="2048" height="1536"/>
+ <tile id="70">
+  <animation>
+   <frame tileid="70" duration="150"/>
+   <frame tileid="78" duration="150"/>
+   <frame tileid="86" duration="150"/>
+   <frame tileid="94" duration="150"/>
+   <frame tileid="102" duration="150"/>
+   <frame tileid="110" duration="150"/>
+   <frame tileid="118" duration="150"/>
+   <frame tileid="126" duration="150"/>
+  </animation>
+ </tile>
+</tileset>
@@ -0,0 +1,121 @@
+#pragma once
+#include "Systems/FrameStats.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// 微基准测试框架 (Bench)
+//
+// 用法：
+//   runner.run("TileMap::isColliding", "map=part1", [&] {
+//       doNotOptimize(tileMap.isColliding(boxes[i++ & mask]));
+//   });
+//
+// 每个用例先校准迭代次数（单次采样 >= minSampleMs），再采样 sampleCount 次，
+// 记录每次操作耗时的 中位数 / 最小 / 最大 和平均堆分配次数。
+// 结果以 JSON 输出，便于不同提交之间对比；输入数据全部由固定种子生成。
+// ============================================================================
+
+// 阻止编译器把结果优化掉
+template<typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+struct BenchResult {
+    std::string name;
+    std::string params;
+    std::uint64_t iterations = 0;       // 每次采样的迭代数
+    double medianNs = 0;
+    double minNs = 0;
+    double maxNs = 0;
+    double allocsPerOp = 0;
+    double bytesPerOp = 0;
+};
+
+struct BenchConfig {
+    std::string filter;                 // 只运行名字包含该子串的用例
+    double minSampleMs = 20.0;
+    int sampleCount = 9;
+};
+
+class BenchRunner {
+public:
+    explicit BenchRunner(const BenchConfig& config) : config(config) {}
+
+    bool isEnabled(const std::string& name) const {
+        return config.filter.empty() || name.find(config.filter) != std::string::npos;
+    }
+
+    template<typename Op>
+    void run(const std::string& name, const std::string& params, Op&& op) {
+        if (!isEnabled(name)) return;
+
+        // 预热 + 校准：找到单次采样达到 minSampleMs 的迭代数
+        const double targetNs = config.minSampleMs * 1.0e6;
+        std::uint64_t iterations = 1;
+        while (true) {
+            double elapsed = timeLoop(iterations, op);
+            if (elapsed >= targetNs || iterations >= (1ULL << 32)) break;
+            double scale = elapsed > 0 ? targetNs / elapsed : 100.0;
+            iterations = static_cast<std::uint64_t>(static_cast<double>(iterations) *
+                                                    std::min(100.0, std::max(2.0, scale * 1.1)));
+        }
+
+        std::vector<double> perOpNs;
+        perOpNs.reserve(static_cast<size_t>(config.sampleCount));
+        FrameCounters before = FrameStats::current();
+        for (int s = 0; s < config.sampleCount; s++) {
+            perOpNs.push_back(timeLoop(iterations, op) / static_cast<double>(iterations));
+        }
+        FrameCounters allocated = FrameStats::current() - before;
+        std::sort(perOpNs.begin(), perOpNs.end());
+
+        BenchResult result;
+        result.name = name;
+        result.params = params;
+        result.iterations = iterations;
+        result.medianNs = perOpNs[perOpNs.size() / 2];
+        result.minNs = perOpNs.front();
+        result.maxNs = perOpNs.back();
+        double totalOps = static_cast<double>(iterations) * config.sampleCount;
+        result.allocsPerOp = static_cast<double>(allocated.allocations) / totalOps;
+        result.bytesPerOp = static_cast<double>(allocated.allocatedBytes) / totalOps;
+        results.push_back(result);
+        report(result);
+    }
+
+    const std::vector<BenchResult>& getResults() const { return results; }
+
+    // 写出 JSON（path 为空时写到标准输出）
+    bool writeJson(const std::string& path) const;
+
+private:
+    template<typename Op>
+    static double timeLoop(std::uint64_t iterations, Op& op) {
+        auto start = std::chrono::steady_clock::now();
+        for (std::uint64_t i = 0; i < iterations; i++) {
+            op();
+        }
+        auto end = std::chrono::steady_clock::now();
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    }
+
+    void report(const BenchResult& result) const;
+
+private:
+    BenchConfig config;
+    std::vector<BenchResult> results;
+};
+
+// 各组用例（bench/Bench*.cpp）
+void runWorldBenchmarks(BenchRunner& runner);
+void runItemBenchmarks(BenchRunner& runner);
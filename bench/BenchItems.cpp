@@ -0,0 +1,117 @@
+#include "Bench.h"
+#include "Items/Item.h"
+#include "Items/CategoryInventory.h"
+#include "Items/Crafting.h"
+#include "Items/DroppedItem.h"
+#include "Pet/Pet.h"
+#include "Systems/Random.h"
+#include "Systems/FrameArena.h"
+
+// ============================================================================
+// 物品：背包增删查、掉落计算、合成检查、孵化品质
+// （物品定义由 BenchMain 从 assets/data 加载）
+// ============================================================================
+
+namespace {
+    constexpr size_t QUERY_COUNT = 1024;
+
+    std::vector<ItemId> collectItemIds() {
+        std::vector<ItemId> ids;
+        ItemDatabase& db = ItemDatabase::getInstance();
+        for (size_t i = 1; i <= db.getItemCount(); i++) {
+            ids.push_back(static_cast<ItemId>(i));
+        }
+        return ids;
+    }
+
+    void benchInventory(BenchRunner& runner, const std::vector<ItemId>& ids) {
+        if (ids.empty() || !runner.isEnabled("CategoryInventory")) return;
+
+        Rng rng(0x5eed0101ULL, 0);
+        std::vector<ItemId> queries(QUERY_COUNT);
+        for (auto& id : queries) id = ids[static_cast<size_t>(rng.range(0, static_cast<int>(ids.size()) - 1))];
+
+        CategoryInventory inventory;
+        for (ItemId id : ids) inventory.addItem(id, 5);
+
+        size_t next = 0;
+        const std::string params = "items=" + std::to_string(ids.size());
+        runner.run("CategoryInventory::addItem+removeItem", params, [&] {
+            ItemId id = queries[next++ & (QUERY_COUNT - 1)];
+            doNotOptimize(inventory.addItem(id, 1));
+            doNotOptimize(inventory.removeItem(id, 1));
+        });
+        runner.run("CategoryInventory::getItemCount", params, [&] {
+            doNotOptimize(inventory.getItemCount(queries[next++ & (QUERY_COUNT - 1)]));
+        });
+        runner.run("CategoryInventory::hasItem(string)", params, [&] {
+            const std::string& id = ItemDatabase::getInstance().getStringId(queries[next++ & (QUERY_COUNT - 1)]);
+            doNotOptimize(inventory.hasItem(id, 3));
+        });
+    }
+
+    void benchDrops(BenchRunner& runner, const std::vector<ItemId>& ids) {
+        if (ids.empty()) return;
+
+        std::vector<std::string> dropTypes;
+        std::vector<float> dropProbabilities;
+        for (size_t i = 0; i < ids.size() && i < 4; i++) {
+            dropTypes.push_back(ItemDatabase::getInstance().getStringId(ids[i]));
+            dropProbabilities.push_back(0.3f + 0.15f * static_cast<float>(i));
+        }
+
+        runner.run("DroppedItemManager::calculateDrops", "types=" + std::to_string(dropTypes.size()), [&] {
+            FrameArena::Scope frame;
+            doNotOptimize(DroppedItemManager::calculateDrops(dropTypes, dropProbabilities, 3));
+        });
+    }
+
+    void benchCrafting(BenchRunner& runner) {
+        CraftingManager& crafting = CraftingManager::getInstance();
+        const auto& recipes = crafting.getAllRecipes();
+        if (recipes.empty() || !runner.isEnabled("CraftingManager")) return;
+
+        // 随机背包：每种材料 0~3 个，大约一半配方可合成
+        Rng rng(0x5eed0102ULL, 0);
+        CategoryInventory inventory;
+        for (const auto& recipe : recipes) {
+            for (const auto& ingredient : recipe.ingredients) {
+                int count = rng.range(0, 3);
+                if (count > 0) inventory.addItem(ingredient.itemId, count);
+            }
+        }
+
+        const std::string params = "recipes=" + std::to_string(recipes.size());
+        runner.run("CraftingManager::canCraft(all)", params, [&] {
+            int craftable = 0;
+            for (const auto& recipe : recipes) {
+                if (crafting.canCraft(recipe, &inventory)) craftable++;
+            }
+            doNotOptimize(craftable);
+        });
+        runner.run("CraftingManager::canCraftDirect(all)", params, [&] {
+            int craftable = 0;
+            for (size_t i = 0; i < recipes.size(); i++) {
+                if (crafting.canCraftDirect(i, inventory)) craftable++;
+            }
+            doNotOptimize(craftable);
+        });
+    }
+
+    void benchPets(BenchRunner& runner) {
+        Rng rng(0x5eed0103ULL, 0);
+        for (int enhancers : {0, 3}) {
+            runner.run("Pet::rollHatchQuality", "enhancers=" + std::to_string(enhancers), [&] {
+                doNotOptimize(Pet::rollHatchQuality(rng, enhancers));
+            });
+        }
+    }
+}
+
+void runItemBenchmarks(BenchRunner& runner) {
+    std::vector<ItemId> ids = collectItemIds();
+    benchInventory(runner, ids);
+    benchDrops(runner, ids);
+    benchCrafting(runner);
+    benchPets(runner);
+}
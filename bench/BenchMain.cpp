@@ -0,0 +1,137 @@
+#include "Bench.h"
+#include "Items/ItemDefinitions.h"
+#include "Items/Item.h"
+#include "Items/Equipment.h"
+#include "Items/Crafting.h"
+#include "Systems/Logger.h"
+#include "Systems/Random.h"
+#include "Systems/CollisionSystem.h"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+// ============================================================================
+// bench - 引擎热点路径的微基准测试
+//
+// 用法：bench [--filter <子串>] [--out <结果.json>] [--quick] [--root <项目目录>]
+//   --root 默认为源码目录（读取 assets/），结果 JSON 默认写到标准输出，
+//   人类可读的表格写到标准错误。
+//
+// 无窗口、无贴图：可以在无显示环境的 Linux 上运行。
+// ============================================================================
+
+#ifndef PF_BENCH_ROOT
+#define PF_BENCH_ROOT "."
+#endif
+
+#ifndef PF_BENCH_REVISION
+#define PF_BENCH_REVISION "unknown"
+#endif
+
+namespace {
+    constexpr std::uint64_t BENCH_WORLD_SEED = 20240601;
+
+    std::string jsonEscape(const std::string& s) {
+        std::string out;
+        out.reserve(s.size() + 2);
+        for (char c : s) {
+            if (c == '"' || c == '\\') out += '\\';
+            out += c;
+        }
+        return out;
+    }
+}
+
+void BenchRunner::report(const BenchResult& result) const {
+    std::fprintf(stderr, "%-44s %-18s %12.1f ns/op  (min %.1f, max %.1f)  %6.2f allocs/op\n",
+                 result.name.c_str(), result.params.c_str(),
+                 result.medianNs, result.minNs, result.maxNs, result.allocsPerOp);
+}
+
+bool BenchRunner::writeJson(const std::string& path) const {
+    std::ostringstream out;
+    out << "{\n";
+    out << "  \"revision\": \"" << jsonEscape(PF_BENCH_REVISION) << "\",\n";
+    out << "  \"seed\": " << BENCH_WORLD_SEED << ",\n";
+    out << "  \"collisionKernel\": \"" << CollisionSystem::getBatchKernelName() << "\",\n";
+    out << "  \"allocationTracking\": " << (FrameStats::isAllocationTrackingEnabled() ? "true" : "false") << ",\n";
+    out << "  \"benchmarks\": [\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult& r = results[i];
+        char numbers[256];
+        std::snprintf(numbers, sizeof(numbers),
+                      "\"iterations\": %llu, \"medianNs\": %.2f, \"minNs\": %.2f, \"maxNs\": %.2f, "
+                      "\"allocsPerOp\": %.3f, \"bytesPerOp\": %.1f",
+                      static_cast<unsigned long long>(r.iterations),
+                      r.medianNs, r.minNs, r.maxNs, r.allocsPerOp, r.bytesPerOp);
+        out << "    {\"name\": \"" << jsonEscape(r.name) << "\", \"params\": \""
+            << jsonEscape(r.params) << "\", " << numbers << "}"
+            << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    out << "  ]\n}\n";
+
+    if (path.empty()) {
+        std::cout << out.str();
+        return static_cast<bool>(std::cout);
+    }
+
+    std::ofstream file(path, std::ios::trunc);
+    if (!file) {
+        std::cerr << "[bench] 无法写入: " << path << std::endl;
+        return false;
+    }
+    file << out.str();
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    BenchConfig config;
+    std::string outPath;
+    std::string root = PF_BENCH_ROOT;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            config.filter = argv[++i];
+        } else if (std::strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+            outPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--root") == 0 && i + 1 < argc) {
+            root = argv[++i];
+        } else if (std::strcmp(argv[i], "--quick") == 0) {
+            config.minSampleMs = 5.0;
+            config.sampleCount = 5;
+        } else {
+            std::cerr << "Usage: bench [--filter <substr>] [--out <file.json>] [--quick] [--root <dir>]" << std::endl;
+            return 2;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::current_path(root, ec);
+    if (ec) {
+        std::cerr << "[bench] 无法进入目录: " << root << std::endl;
+        return 1;
+    }
+
+    // 游戏日志不输出（避免污染 JSON，也不占用被测线程）
+    Logger::getInstance().start("", false);
+    RandomService::getInstance().setWorldSeed(BENCH_WORLD_SEED);
+
+    ItemDefinitionSet definitions;
+    if (!ItemDefinitions::load(definitions)) {
+        std::cerr << "[bench] 无法加载物品定义（assets/data）" << std::endl;
+        return 1;
+    }
+    ItemDatabase::getInstance().initialize(definitions.items);
+    EquipmentManager::getInstance().initialize(definitions.equipments);
+    CraftingManager::getInstance().initialize(definitions.recipes);
+
+    BenchRunner runner(config);
+    runWorldBenchmarks(runner);
+    runItemBenchmarks(runner);
+
+    Logger::getInstance().stop();
+    return runner.writeJson(outPath) ? 0 : 1;
+}
@@ -0,0 +1,221 @@
+#include "Bench.h"
+#include "World/TileMap.h"
+#include "World/StressScene.h"
+#include "Entity/Rabbit.h"
+#include "Entity/Tree.h"
+#include "Systems/Random.h"
+#include "Systems/Broadphase.h"
+#include "Systems/FrameArena.h"
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <iostream>
+
+// ============================================================================
+// 世界：地图加载、地图碰撞、兔子范围查询与推挤、树木更新
+// ============================================================================
+
+namespace {
+    const char* BUNDLED_MAP = "assets/game_source/part1.tmj";
+    constexpr int DISPLAY_TILE_SIZE = 48;
+    constexpr size_t QUERY_COUNT = 1024;        // 预生成的查询数（2 的幂，循环使用）
+
+    std::vector<sf::FloatRect> makeQueryBoxes(Rng& rng, sf::Vector2f area, sf::Vector2f size) {
+        std::vector<sf::FloatRect> boxes(QUERY_COUNT);
+        for (auto& box : boxes) {
+            box = sf::FloatRect(rng.range(0.0f, area.x - size.x), rng.range(0.0f, area.y - size.y),
+                                size.x, size.y);
+        }
+        return boxes;
+    }
+
+    void benchTileMap(BenchRunner& runner, const std::string& mapPath, const std::string& label) {
+        std::string params = "map=" + label;
+
+        runner.run("TileMap::loadFromTiled", params, [&] {
+            TileMap map;
+            map.setTexturesEnabled(false);
+            doNotOptimize(map.loadFromTiled(mapPath, DISPLAY_TILE_SIZE));
+        });
+
+        if (!runner.isEnabled("TileMap::isColliding")) return;
+
+        TileMap map;
+        map.setTexturesEnabled(false);
+        if (!map.loadFromTiled(mapPath, DISPLAY_TILE_SIZE)) return;
+
+        Rng rng(0x5eed0002ULL, 0);
+        sf::Vector2i size = map.getMapSize();
+        auto boxes = makeQueryBoxes(rng, sf::Vector2f(size), sf::Vector2f(28.0f, 20.0f));
+        size_t next = 0;
+        runner.run("TileMap::isColliding", params, [&] {
+            doNotOptimize(map.isColliding(boxes[next++ & (QUERY_COUNT - 1)]));
+        });
+    }
+
+    // 块顶点缓存与动画 tile
+    void benchTileChunks(BenchRunner& runner, const std::string& mapPath, const std::string& label) {
+        if (!runner.isEnabled("TileMap::prepareChunks") && !runner.isEnabled("TileMap::update")) return;
+
+        TileMap map;
+        map.setTexturesEnabled(false);
+        if (!map.loadFromTiled(mapPath, DISPLAY_TILE_SIZE)) return;
+        sf::Vector2f mapSize(map.getMapSize());
+
+        // 1080p 视野逐帧横向平移 8 格，到边换行：持续生成新块、淘汰旧块
+        const sf::Vector2f viewSize(1920.0f, 1080.0f);
+        const float step = 8.0f * DISPLAY_TILE_SIZE;
+        sf::Vector2f viewPos(0.0f, 0.0f);
+        runner.run("TileMap::prepareChunks", "map=" + label, [&] {
+            map.prepareChunks(sf::FloatRect(viewPos, viewSize));
+            viewPos.x += step;
+            if (viewPos.x + viewSize.x > mapSize.x) {
+                viewPos.x = 0.0f;
+                viewPos.y = (viewPos.y + viewSize.y + viewSize.y > mapSize.y) ? 0.0f : viewPos.y + viewSize.y;
+            }
+        });
+
+        if (!runner.isEnabled("TileMap::update")) return;
+
+        // 动画 tile：在地图中央生成 224x224 格（算上外扩最多 16x16 = 256 个块，不超过缓存上限），
+        // 步长取一帧的时长（150ms），每次调用都换帧、改写其中全部动画格子
+        sf::Vector2f area(std::min(mapSize.x, 224.0f * DISPLAY_TILE_SIZE),
+                          std::min(mapSize.y, 224.0f * DISPLAY_TILE_SIZE));
+        map.prepareChunks(sf::FloatRect((mapSize - area) / 2.0f, area - sf::Vector2f(1.0f, 1.0f)));
+        size_t cells = map.getAnimatedCellCount();
+        if (cells == 0) {
+            std::cerr << "[bench] " << label << " 没有动画格子，跳过 TileMap::update" << std::endl;
+            return;
+        }
+
+        runner.run("TileMap::update", "map=" + label + ",cells=" + std::to_string(cells), [&] {
+            map.update(0.15f);
+        });
+    }
+
+    void benchRabbits(BenchRunner& runner, int count) {
+        const std::string params = "rabbits=" + std::to_string(count);
+        if (!runner.isEnabled("RabbitManager") && !runner.isEnabled("SweepAndPrune") &&
+            !runner.isEnabled("CollisionSystem")) return;
+
+        // 保持密度不变：每只兔子约 96x96 像素的活动范围
+        float side = std::sqrt(static_cast<float>(count)) * 96.0f;
+        sf::Vector2f area(side, side);
+
+        Rng rng(0x5eed0003ULL, static_cast<std::uint64_t>(count));
+        RabbitManager manager;      // 不调用 init：不加载贴图
+        for (int i = 0; i < count; i++) {
+            manager.addRabbit(rng.range(0.0f, side), rng.range(0.0f, side));
+        }
+
+        auto boxes = makeQueryBoxes(rng, area, sf::Vector2f(48.0f, 64.0f));
+        size_t next = 0;
+
+        // 查询结果分配在帧内存池上：每次调用用 Scope 回退，相当于每帧一次查询
+        runner.run("RabbitManager::getRabbitsCollidingWith", params, [&] {
+            FrameArena::Scope frame;
+            doNotOptimize(manager.getRabbitsCollidingWith(boxes[next++ & (QUERY_COUNT - 1)]));
+        });
+        runner.run("RabbitManager::getMovingRabbitsCollidingWith", params, [&] {
+            FrameArena::Scope frame;
+            doNotOptimize(manager.getMovingRabbitsCollidingWith(boxes[next++ & (QUERY_COUNT - 1)]));
+        });
+        runner.run("RabbitManager::isCollidingWithAnyRabbit", params, [&] {
+            doNotOptimize(manager.isCollidingWithAnyRabbit(boxes[next++ & (QUERY_COUNT - 1)]));
+        });
+        runner.run("RabbitManager::getAttackingRabbitsInRange", params, [&] {
+            FrameArena::Scope frame;
+            const sf::FloatRect& box = boxes[next++ & (QUERY_COUNT - 1)];
+            doNotOptimize(manager.getAttackingRabbitsInRange(sf::Vector2f(box.left, box.top), 150.0f));
+        });
+        runner.run("RabbitManager::pushRabbitsFromRect", params, [&] {
+            FrameArena::Scope frame;
+            doNotOptimize(manager.pushRabbitsFromRect(boxes[next++ & (QUERY_COUNT - 1)], 1.0f));
+        });
+        
+        // 批量内核 vs 逐个 sf::FloatRect::intersects（同一批碰撞盒）
+        CollisionSystem::AABBBatch batch;
+        std::vector<sf::FloatRect> rabbitBoxes;
+        for (const auto& rabbit : manager.getRabbits()) {
+            batch.add(rabbit->getCollisionBox());
+            rabbitBoxes.push_back(rabbit->getCollisionBox());
+        }
+        std::vector<std::uint8_t> mask;
+        runner.run("CollisionSystem::overlapMask", params, [&] {
+            doNotOptimize(CollisionSystem::overlapMask(batch, boxes[next++ & (QUERY_COUNT - 1)], mask));
+        });
+        runner.run("CollisionSystem::overlapScalar", params, [&] {
+            const sf::FloatRect& box = boxes[next++ & (QUERY_COUNT - 1)];
+            size_t hits = 0;
+            for (const auto& rabbitBox : rabbitBoxes) {
+                if (box.intersects(rabbitBox)) hits++;
+            }
+            doNotOptimize(hits);
+        });
+        
+        // 所有兔子两两重叠检测（GameState::resolveDynamicCollisions 的宽阶段）
+        SweepAndPrune broadphase;
+        runner.run("SweepAndPrune::findPairs", params, [&] {
+            broadphase.clear();
+            for (const auto& rabbit : manager.getRabbits()) {
+                broadphase.add(rabbit->getCollisionBox());
+            }
+            doNotOptimize(broadphase.findPairs().size());
+        });
+    }
+
+    void benchTrees(BenchRunner& runner, int count) {
+        const std::string params = "trees=" + std::to_string(count);
+        if (!runner.isEnabled("TreeManager")) return;
+
+        float side = std::sqrt(static_cast<float>(count)) * 96.0f;
+        sf::Vector2f area(side, side);
+
+        // 四个树种轮流：每个树种一份原型，树木实例只有位置和生长状态
+        const char* types[] = {"tree1", "pine", "apple_tree", "cherry_tree"};
+        Rng rng(0x5eed0004ULL, static_cast<std::uint64_t>(count));
+        TreeManager manager;        // 不调用 init：不加载字体
+        for (int i = 0; i < count; i++) {
+            manager.addTree(rng.range(0.0f, side), rng.range(0.0f, side), types[i & 3]);
+        }
+
+        auto boxes = makeQueryBoxes(rng, area, sf::Vector2f(28.0f, 20.0f));
+        size_t next = 0;
+
+        runner.run("TreeManager::update", params, [&] {
+            manager.update(1.0f / 60.0f);
+        });
+        runner.run("TreeManager::isCollidingWithAnyTree", params, [&] {
+            doNotOptimize(manager.isCollidingWithAnyTree(boxes[next++ & (QUERY_COUNT - 1)]));
+        });
+    }
+}
+
+void runWorldBenchmarks(BenchRunner& runner) {
+    if (std::filesystem::exists(BUNDLED_MAP)) {
+        benchTileMap(runner, BUNDLED_MAP, "part1");
+    }
+
+    // 压力测试场景：对象数量按面积推算（见 StressScene::resolveCounts）
+    if (runner.isEnabled("TileMap")) {
+        for (int size : {256, 1024}) {
+            StressSceneConfig config;
+            config.width = size;
+            config.height = size;
+            config.seed = RandomService::getInstance().getWorldSeed();
+            std::string path = StressScene::defaultPath(config);
+            if (StressScene::writeMap(config, path)) {
+                benchTileMap(runner, path, "stress" + std::to_string(size));
+                benchTileChunks(runner, path, "stress" + std::to_string(size));
+            }
+        }
+    }
+
+    for (int count : {100, 1000, 10000}) {
+        benchRabbits(runner, count);
+    }
+
+    for (int count : {1000, 10000}) {
+        benchTrees(runner, count);
+    }
+}
@@ -0,0 +1,336 @@
+#include "BenchMode.h"
+#include "../Systems/Json.h"
+#include "../Systems/Logger.h"
+#include "../Systems/Profiler.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+// ============================================================================
+// 内置场景
+// ============================================================================
+
+namespace {
+
+struct BuiltinScenario {
+    const char* name;
+    MapType map;
+    const char* stressSpec;
+};
+
+const BuiltinScenario BUILTIN_SCENARIOS[] = {
+    { "farm",        MapType::Farm,   "" },
+    { "forest",      MapType::Forest, "" },
+    { "stress-256",  MapType::Farm,   "256x256" },
+    { "stress-1024", MapType::Farm,   "1024x1024" },
+    { "stress-2048", MapType::Farm,   "2048x2048" },
+};
+
+// 排序后取百分位（nearest-rank）
+double percentile(const std::vector<float>& sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    size_t index = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+std::string jsonEscape(const std::string& s) {
+    std::string out;
+    out.reserve(s.size() + 2);
+    for (char c : s) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    return out;
+}
+
+sf::Event makeKeyPress(sf::Keyboard::Key key) {
+    sf::Event event;
+    event.type = sf::Event::KeyPressed;
+    event.key.code = key;
+    event.key.alt = false;
+    event.key.control = false;
+    event.key.shift = false;
+    event.key.system = false;
+    return event;
+}
+
+} // namespace
+
+// ============================================================================
+// 逐帧收集
+// ============================================================================
+
+BenchRecorder::BenchRecorder(std::uint32_t warmupFrames)
+    : warmupFrames(warmupFrames)
+{
+}
+
+void BenchRecorder::beginFrame() {
+    frameStartNs = Profiler::now();
+    frameStartCounters = FrameStats::current();
+}
+
+void BenchRecorder::endFrame() {
+    std::uint64_t frameEndNs = Profiler::now();
+    FrameCounters counters = FrameStats::current() - frameStartCounters;
+
+    if (frameIndex++ < warmupFrames) return;
+
+    frameMs.push_back(static_cast<float>(static_cast<double>(frameEndNs - frameStartNs) / 1.0e6));
+    frameCounters.push_back(counters);
+
+    // 新出现的标记补齐之前的帧（计 0）
+    Profiler& profiler = Profiler::getInstance();
+    const auto& profilerSections = profiler.getSections();
+    for (size_t i = 0; i < profilerSections.size(); i++) {
+        if (i >= sections.size()) {
+            SectionTrack track;
+            track.name = profilerSections[i].name;
+            track.depth = profilerSections[i].depth;
+            track.samples.assign(frameMs.size() - 1, 0.0f);
+            sections.push_back(std::move(track));
+        }
+        sections[i].samples.push_back(profiler.getLastMs(profilerSections[i]));
+        sections[i].calls += profilerSections[i].lastCalls;
+    }
+}
+
+void BenchRecorder::finish(BenchReport& report) const {
+    report.warmupFrames = std::min(frameIndex, warmupFrames);
+    report.measuredFrames = static_cast<std::uint32_t>(frameMs.size());
+    if (frameMs.empty()) return;
+
+    const double frames = static_cast<double>(frameMs.size());
+
+    std::vector<float> sorted = frameMs;
+    std::sort(sorted.begin(), sorted.end());
+    report.totalMs = 0;
+    for (float ms : frameMs) report.totalMs += ms;
+    report.avgMs = report.totalMs / frames;
+    report.p50Ms = percentile(sorted, 0.50);
+    report.p95Ms = percentile(sorted, 0.95);
+    report.p99Ms = percentile(sorted, 0.99);
+    report.maxMs = sorted.back();
+
+    double drawCalls = 0, vertices = 0, allocations = 0;
+    for (const auto& c : frameCounters) {
+        drawCalls += static_cast<double>(c.drawCalls);
+        vertices += static_cast<double>(c.vertices);
+        allocations += static_cast<double>(c.allocations);
+        report.drawCallsMax = std::max(report.drawCallsMax, c.drawCalls);
+        report.allocationsMax = std::max(report.allocationsMax, c.allocations);
+    }
+    report.drawCallsAvg = drawCalls / frames;
+    report.verticesAvg = vertices / frames;
+    report.allocationsAvg = allocations / frames;
+
+    report.sections.clear();
+    for (const auto& track : sections) {
+        BenchSectionResult result;
+        result.name = track.name;
+        result.depth = track.depth;
+
+        std::vector<float> samples = track.samples;
+        double sum = 0;
+        for (float ms : samples) sum += ms;
+        std::sort(samples.begin(), samples.end());
+        result.avgMs = sum / frames;
+        result.p95Ms = percentile(samples, 0.95);
+        result.maxMs = samples.empty() ? 0.0 : samples.back();
+        result.callsPerFrame = static_cast<double>(track.calls) / frames;
+        report.sections.push_back(result);
+    }
+}
+
+// ============================================================================
+// 场景
+// ============================================================================
+
+std::vector<std::string> BenchMode::getBuiltinScenarioNames() {
+    std::vector<std::string> names;
+    for (const auto& scenario : BUILTIN_SCENARIOS) {
+        names.push_back(scenario.name);
+    }
+    return names;
+}
+
+bool BenchMode::findScenario(const std::string& nameOrPath, BenchScenario& out) {
+    for (const auto& scenario : BUILTIN_SCENARIOS) {
+        if (nameOrPath == scenario.name) {
+            out = BenchScenario();
+            out.name = scenario.name;
+            out.map = scenario.map;
+            out.stressSpec = scenario.stressSpec;
+            return true;
+        }
+    }
+
+    JsonValue root;
+    std::string error;
+    if (!JsonValue::parseFile(nameOrPath, root, error)) {
+        LOG_ERROR("[Bench] 未知场景: " << nameOrPath << " (" << error << ")");
+        return false;
+    }
+
+    std::string map = root.getString("map", "farm");
+    if (map != "farm" && map != "forest") {
+        LOG_ERROR("[Bench] 场景 " << nameOrPath << ": 未知地图 \"" << map << "\"");
+        return false;
+    }
+
+    out = BenchScenario();
+    out.name = root.getString("name", nameOrPath);
+    out.map = (map == "forest") ? MapType::Forest : MapType::Farm;
+    out.stressSpec = root.getString("stress");
+    out.replayPath = root.getString("replay");
+    return true;
+}
+
+// ============================================================================
+// 脚本输入
+// ============================================================================
+
+std::vector<InputFrame> BenchMode::buildScriptedInput(std::uint32_t frameCount, float dt) {
+    // 路线：右、下、左、上，每两段边长增加 SEGMENT_GROWTH 帧，到上限后重新开始
+    constexpr std::uint32_t SEGMENT_START = 60;
+    constexpr std::uint32_t SEGMENT_GROWTH = 45;
+    constexpr std::uint32_t SEGMENT_MAX = 600;
+    constexpr std::uint32_t ATTACK_PERIOD = 45;     // 每 45 帧按住攻击 10 帧
+    constexpr std::uint32_t ATTACK_HOLD = 10;
+    constexpr std::uint32_t PICKUP_PERIOD = 120;
+    constexpr std::uint32_t PANEL_PERIOD = 900;     // 每 15 秒开关一次背包和工作台
+    constexpr std::uint32_t PANEL_OPEN = 120;
+
+    const InputAction directions[] = {
+        InputAction::MoveRight, InputAction::MoveDown, InputAction::MoveLeft, InputAction::MoveUp
+    };
+
+    std::vector<InputFrame> frames(frameCount);
+    std::uint32_t segment = 0;
+    std::uint32_t segmentLength = SEGMENT_START;
+    std::uint32_t segmentFrame = 0;
+
+    for (std::uint32_t i = 0; i < frameCount; i++) {
+        InputFrame& frame = frames[i];
+        frame.dt = dt;
+        frame.mousePosition = sf::Vector2i(1280, 800);     // 窗口中央，不悬停在面板上
+
+        frame.setDown(directions[segment % 4]);
+        if (++segmentFrame >= segmentLength) {
+            segmentFrame = 0;
+            segment++;
+            if (segment % 2 == 0) {
+                segmentLength += SEGMENT_GROWTH;
+                if (segmentLength > SEGMENT_MAX) segmentLength = SEGMENT_START;
+            }
+        }
+
+        if (i % ATTACK_PERIOD < ATTACK_HOLD) frame.setDown(InputAction::Attack);
+        if (i % PICKUP_PERIOD == 0) frame.setDown(InputAction::Pickup);
+
+        std::uint32_t panelPhase = i % PANEL_PERIOD;
+        if (panelPhase == PANEL_PERIOD / 3 || panelPhase == PANEL_PERIOD / 3 + PANEL_OPEN) {
+            frame.events.push_back(makeKeyPress(sf::Keyboard::I));
+        } else if (panelPhase == 2 * PANEL_PERIOD / 3 || panelPhase == 2 * PANEL_PERIOD / 3 + PANEL_OPEN) {
+            frame.events.push_back(makeKeyPress(sf::Keyboard::C));
+        }
+    }
+    return frames;
+}
+
+// ============================================================================
+// 峰值内存
+// ============================================================================
+
+std::uint64_t BenchMode::getPeakRssBytes() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return static_cast<std::uint64_t>(counters.PeakWorkingSetSize);
+    }
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#ifdef __APPLE__
+    return static_cast<std::uint64_t>(usage.ru_maxrss);            // 字节
+#else
+    return static_cast<std::uint64_t>(usage.ru_maxrss) * 1024;     // KB
+#endif
+#endif
+}
+
+// ============================================================================
+// 输出
+// ============================================================================
+
+bool BenchMode::writeReport(const BenchReport& report, const std::string& path) {
+    std::ostringstream out;
+    char buffer[512];
+
+    out << "{\n";
+    out << "  \"scenario\": \"" << jsonEscape(report.scenario) << "\",\n";
+    out << "  \"stress\": \"" << jsonEscape(report.stress) << "\",\n";
+    out << "  \"input\": \"" << jsonEscape(report.input) << "\",\n";
+    out << "  \"seed\": " << report.seed << ",\n";
+    std::snprintf(buffer, sizeof(buffer),
+                  "  \"fixedDt\": %.6f,\n  \"requestedFrames\": %u,\n  \"warmupFrames\": %u,\n"
+                  "  \"measuredFrames\": %u,\n",
+                  report.fixedDt, report.requestedFrames, report.warmupFrames, report.measuredFrames);
+    out << buffer;
+    std::snprintf(buffer, sizeof(buffer),
+                  "  \"loadMs\": %.2f,\n  \"frameMs\": {\"total\": %.2f, \"avg\": %.3f, \"p50\": %.3f, "
+                  "\"p95\": %.3f, \"p99\": %.3f, \"max\": %.3f},\n",
+                  report.loadMs, report.totalMs, report.avgMs, report.p50Ms, report.p95Ms,
+                  report.p99Ms, report.maxMs);
+    out << buffer;
+    std::snprintf(buffer, sizeof(buffer),
+                  "  \"perFrame\": {\"drawCallsAvg\": %.1f, \"drawCallsMax\": %llu, \"verticesAvg\": %.1f, "
+                  "\"allocationsAvg\": %.1f, \"allocationsMax\": %llu},\n",
+                  report.drawCallsAvg, static_cast<unsigned long long>(report.drawCallsMax),
+                  report.verticesAvg, report.allocationsAvg,
+                  static_cast<unsigned long long>(report.allocationsMax));
+    out << buffer;
+    out << "  \"allocationTracking\": " << (FrameStats::isAllocationTrackingEnabled() ? "true" : "false") << ",\n";
+    out << "  \"peakRssBytes\": " << report.peakRssBytes << ",\n";
+    std::snprintf(buffer, sizeof(buffer), "%016llx", static_cast<unsigned long long>(report.stateHash));
+    out << "  \"stateHash\": \"" << buffer << "\",\n";
+
+    out << "  \"sections\": [\n";
+    for (size_t i = 0; i < report.sections.size(); i++) {
+        const BenchSectionResult& s = report.sections[i];
+        std::snprintf(buffer, sizeof(buffer),
+                      "\"depth\": %d, \"avgMs\": %.4f, \"p95Ms\": %.4f, \"maxMs\": %.4f, \"callsPerFrame\": %.2f",
+                      s.depth, s.avgMs, s.p95Ms, s.maxMs, s.callsPerFrame);
+        out << "    {\"name\": \"" << jsonEscape(s.name) << "\", " << buffer << "}"
+            << (i + 1 < report.sections.size() ? ",\n" : "\n");
+    }
+    out << "  ]\n}\n";
+
+    if (path.empty()) {
+        std::cout << out.str() << std::flush;
+        return static_cast<bool>(std::cout);
+    }
+
+    std::ofstream file(path, std::ios::trunc);
+    if (!file) {
+        LOG_ERROR("[Bench] 无法写入: " << path);
+        return false;
+    }
+    file << out.str();
+    LOG_INFO("[Bench] 结果已写入: " << path);
+    return true;
+}
@@ -0,0 +1,122 @@
+#pragma once
+#include "../States/GameState.h"
+#include "../Systems/InputSystem.h"
+#include "../Systems/FrameStats.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// 端到端基准测试模式 (Bench Mode)
+//
+//   PixelFarmRPG --bench <场景> --frames N [--bench-out <结果.json>]
+//
+// 跑真实的 Game → GameState::update / render 流程（所有管理器一起工作），
+// 和 bench 目标的微基准互补：
+//   - 固定 dt（FIXED_DT），窗口隐藏、不限帧率、关闭垂直同步
+//   - 输入来自录制文件或脚本（见 buildScriptedInput），不读键盘
+//   - 前 WARMUP_FRAMES 帧不计入统计
+//   - 结束时输出 JSON：帧耗时 p50/p95/p99、各计时标记耗时、draw call、
+//     堆分配、峰值内存（RSS）、加载耗时和最终状态哈希
+//
+// 场景：内置名字（getBuiltinScenarioNames）或 JSON 文件：
+//   { "map": "farm" | "forest",
+//     "stress": "1024x1024,rabbits=500",     // 可选，见 StressScene::parseSpec
+//     "replay": "recordings/walk.pfr" }      // 可选，缺省为脚本输入
+// ============================================================================
+
+struct BenchScenario {
+    std::string name;
+    MapType map = MapType::Farm;
+    std::string stressSpec;             // 空 = 使用真实地图
+    std::string replayPath;             // 空 = 脚本输入
+};
+
+// 单个计时标记的统计（按统计帧数平均，未调用的帧计 0）
+struct BenchSectionResult {
+    std::string name;
+    int depth = 0;
+    double avgMs = 0;
+    double p95Ms = 0;
+    double maxMs = 0;
+    double callsPerFrame = 0;
+};
+
+struct BenchReport {
+    std::string scenario;
+    std::string stress;
+    std::string input;                  // "script" 或回放文件路径
+    std::uint64_t seed = 0;
+    float fixedDt = 0;
+    std::uint32_t requestedFrames = 0;
+    std::uint32_t warmupFrames = 0;
+    std::uint32_t measuredFrames = 0;
+
+    double loadMs = 0;                  // 创建 GameState（加载地图和所有管理器）
+    double totalMs = 0;                 // 统计帧的总耗时
+    double avgMs = 0;
+    double p50Ms = 0;
+    double p95Ms = 0;
+    double p99Ms = 0;
+    double maxMs = 0;
+
+    double drawCallsAvg = 0;
+    std::uint64_t drawCallsMax = 0;
+    double verticesAvg = 0;
+    double allocationsAvg = 0;
+    std::uint64_t allocationsMax = 0;
+
+    std::uint64_t peakRssBytes = 0;
+    std::uint64_t stateHash = 0;
+
+    std::vector<BenchSectionResult> sections;
+};
+
+// 逐帧收集耗时和计数（由 Game::runBench 驱动）
+class BenchRecorder {
+public:
+    explicit BenchRecorder(std::uint32_t warmupFrames);
+
+    void beginFrame();
+    // 在 PROFILE_FRAME_END 之后调用（读取 Profiler 刚汇总的标记耗时）
+    void endFrame();
+
+    // 汇总到 report（只填写帧统计部分）
+    void finish(BenchReport& report) const;
+
+private:
+    struct SectionTrack {
+        const char* name = nullptr;
+        int depth = 0;
+        std::vector<float> samples;     // 每个统计帧的耗时
+        std::uint64_t calls = 0;
+    };
+
+    std::uint32_t warmupFrames;
+    std::uint32_t frameIndex = 0;
+    std::uint64_t frameStartNs = 0;
+    FrameCounters frameStartCounters;
+
+    std::vector<float> frameMs;
+    std::vector<FrameCounters> frameCounters;
+    std::vector<SectionTrack> sections;   // 与 Profiler::getSections() 下标一致
+};
+
+class BenchMode {
+public:
+    static constexpr float FIXED_DT = 1.0f / 60.0f;
+    static constexpr std::uint32_t WARMUP_FRAMES = 30;
+
+    // 按名字查找内置场景；不是内置名字时当作 JSON 场景文件读取
+    static bool findScenario(const std::string& nameOrPath, BenchScenario& out);
+    static std::vector<std::string> getBuiltinScenarioNames();
+
+    // 脚本输入：绕逐渐扩大的方形路线行走，定期攻击、拾取、开关背包和工作台
+    static std::vector<InputFrame> buildScriptedInput(std::uint32_t frameCount, float dt);
+
+    // 进程峰值常驻内存（不支持的平台返回 0）
+    static std::uint64_t getPeakRssBytes();
+
+    // 写出 JSON（path 为空时写到标准输出）
+    static bool writeReport(const BenchReport& report, const std::string& path);
+};
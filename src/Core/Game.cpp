@@ -1,38 +1,184 @@
 #include "Game.h"
 #include "../States/State.h"
+#include "../Systems/InputSystem.h"
+#include "../Systems/Profiler.h"
+#include "../Systems/FrameStats.h"
+#include "../Systems/FrameArena.h"
+#include "BenchMode.h"
+#include <algorithm>
+#include <iostream>
 
 Game::Game() 
     : window(sf::VideoMode(2560, 1600), "Pixel Farm RPG")
     , deltaTime(0.0f)
 {
     window.setFramerateLimit(FPS);
+    profilerOverlay.init();
 }
 
 Game::~Game() {
 }
 
 void Game::run() {
+    if (InputSystem::getInstance().isReplaying()) {
+        runReplay();
+        return;
+    }
+    
     while (window.isOpen() && !states.empty()) {
         deltaTime = clock.restart().asSeconds();
         
         processEvents();
         update(deltaTime);
         render();
+        
+        PROFILE_FRAME_END();
+        FrameArena::getInstance().reset();
+    }
+}
+
+// ============================================================================
+// 回放：按录制的 dt 逐帧重跑模拟，不渲染、不限帧率
+// ============================================================================
+void Game::runReplay() {
+    InputSystem& input = InputSystem::getInstance();
+    
+    window.setVisible(false);
+    window.setFramerateLimit(0);
+    
+    sf::Clock totalClock;
+    sf::Clock frameClock;
+    float maxFrameMs = 0.0f;
+    size_t frames = 0;
+    
+    // 模拟线程（本线程）的堆分配
+    FrameCounters startCounters = FrameStats::current();
+    std::uint64_t maxFrameAllocations = 0;
+    
+    while (!states.empty() && input.hasReplayFrames()) {
+        const InputFrame& frame = input.advanceReplay();
+        deltaTime = frame.dt;
+        
+        frameClock.restart();
+        std::uint64_t frameStartAllocations = FrameStats::getThreadAllocations();
+        {
+            PROFILE_SCOPE("Game::processEvents");
+            for (const sf::Event& event : frame.events) {
+                dispatchEvent(event);
+            }
+        }
+        update(deltaTime);
+        PROFILE_FRAME_END();
+        FrameArena::getInstance().reset();
+        
+        maxFrameMs = std::max(maxFrameMs, frameClock.getElapsedTime().asSeconds() * 1000.0f);
+        maxFrameAllocations = std::max(maxFrameAllocations,
+                                       FrameStats::getThreadAllocations() - frameStartAllocations);
+        frames++;
+    }
+    
+    float totalMs = totalClock.getElapsedTime().asSeconds() * 1000.0f;
+    std::cout << "[Replay] 帧数: " << frames
+              << "  总耗时: " << totalMs << " ms"
+              << "  平均: " << (frames > 0 ? totalMs / frames : 0.0f) << " ms"
+              << "  最大: " << maxFrameMs << " ms" << std::endl;
+    
+    if (FrameStats::isAllocationTrackingEnabled()) {
+        FrameCounters total = FrameStats::current() - startCounters;
+        std::cout << "[Replay] 堆分配: " << total.allocations << " 次 / "
+                  << total.allocatedBytes / 1024 << " KB"
+                  << "  每帧平均: " << (frames > 0 ? total.allocations / frames : 0) << " 次"
+                  << "  单帧最多: " << maxFrameAllocations << " 次" << std::endl;
+    }
+    
+    if (!states.empty()) {
+        std::cout << "[Replay] 状态哈希: " << std::hex << states.top()->computeStateHash()
+                  << std::dec << std::endl;
+    }
+}
+
+// ============================================================================
+// 基准测试：完整的 更新 + 渲染 + display，固定 dt，不限帧率
+// ============================================================================
+void Game::runBench(std::uint32_t frameCount, BenchReport& report) {
+    InputSystem& input = InputSystem::getInstance();
+    
+    window.setVisible(false);
+    window.setFramerateLimit(0);
+    window.setVerticalSyncEnabled(false);
+    
+    BenchRecorder recorder(BenchMode::WARMUP_FRAMES);
+    deltaTime = BenchMode::FIXED_DT;
+    
+    for (std::uint32_t frame = 0; frame < frameCount && !states.empty() && input.hasReplayFrames(); frame++) {
+        recorder.beginFrame();
+        {
+            PROFILE_SCOPE("Game::processEvents");
+            
+            // 系统事件照常取出（避免窗口无响应），游戏输入只来自回放/脚本
+            sf::Event event;
+            while (window.pollEvent(event)) {
+            }
+            
+            const InputFrame& inputFrame = input.advanceReplay();
+            for (const sf::Event& e : inputFrame.events) {
+                dispatchEvent(e);
+            }
+        }
+        update(deltaTime);
+        render();
+        PROFILE_FRAME_END();
+        FrameArena::getInstance().reset();
+        recorder.endFrame();
+    }
+    
+    recorder.finish(report);
+    report.fixedDt = BenchMode::FIXED_DT;
+    report.requestedFrames = frameCount;
+    report.peakRssBytes = BenchMode::getPeakRssBytes();
+    if (!states.empty()) {
+        report.stateHash = states.top()->computeStateHash();
     }
 }
 
 void Game::processEvents() {
+    PROFILE_SCOPE("Game::processEvents");
+    
+    InputSystem& input = InputSystem::getInstance();
+    input.beginFrame(deltaTime, window);
+    
     sf::Event event;
     while (window.pollEvent(event)) {
         if (event.type == sf::Event::Closed)
             window.close();
-            
-        if (!states.empty())
-            states.top()->handleInput(event);
+        
+        // 性能面板快捷键（不录制、不分发给游戏状态）
+        if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F10) {
+            profilerOverlay.toggle();
+            continue;
+        }
+        if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F11) {
+            Profiler::getInstance().captureNextFrames(TRACE_CAPTURE_FRAMES, "profile_trace.json");
+            continue;
+        }
+        
+        input.recordEvent(event);
+        dispatchEvent(event);
     }
+    
+    input.endFrame();
+}
+
+void Game::dispatchEvent(const sf::Event& event) {
+    if (!states.empty())
+        states.top()->handleInput(event);
 }
 
 void Game::update(float dt) {
+    PROFILE_SCOPE("Game::update");
+    
+    profilerOverlay.update(dt);
+    
     if (!states.empty()) {
         states.top()->update(dt);
         
@@ -44,11 +190,23 @@ void Game::update(float dt) {
 }
 
 void Game::render() {
-    window.clear(sf::Color(34, 139, 34)); // 草地绿色背景
-    
-    if (!states.empty())
-        states.top()->render(window);
+    {
+        PROFILE_SCOPE("Game::render");
+        
+        window.clear(sf::Color(34, 139, 34)); // 草地绿色背景
+        
+        if (!states.empty())
+            states.top()->render(window);
+        
+        {
+            PROFILE_SCOPE("ProfilerOverlay::render");
+            window.setView(window.getDefaultView());
+            profilerOverlay.render(window);
+        }
+    }
     
+    // display 包含垂直同步/限帧等待，单独计时
+    PROFILE_SCOPE("Game::display");
     window.display();
 }
 
@@ -1,9 +1,12 @@
 #pragma once
 #include <SFML/Graphics.hpp>
+#include "../UI/ProfilerOverlay.h"
+#include <cstdint>
 #include <memory>
 #include <stack>
 
 class State;
+struct BenchReport;
 
 class Game {
 public:
@@ -11,6 +14,11 @@ public:
     ~Game();
     
     void run();  // 运行程序
+    void runReplay();  // 无渲染回放（由 InputSystem 提供输入）
+    
+    // 基准测试：固定 dt、隐藏窗口、照常渲染，最多 frameCount 帧
+    // （输入由 InputSystem 的回放/脚本帧提供，统计结果写入 report）
+    void runBench(std::uint32_t frameCount, BenchReport& report);
     
     // 状态管理
     void pushState(std::unique_ptr<State> state);
@@ -23,6 +31,7 @@ public:
     
 private:
     void processEvents();
+    void dispatchEvent(const sf::Event& event);
     void update(float dt);
     void render();
     
@@ -32,6 +41,11 @@ private:
     sf::Clock clock;
     float deltaTime;
     
+    // 性能面板（F10 开关，F11 录制 Chrome Trace）
+    ProfilerOverlay profilerOverlay;
+    
+    static constexpr std::uint32_t TRACE_CAPTURE_FRAMES = 120;
+    
     const int FPS = 60;
     const sf::Time timePerFrame = sf::seconds(1.0f / FPS);
 };
\ No newline at end of file
@@ -1,27 +1,21 @@
 #include "Monster.h"
-#include <iostream>
+#include "../Systems/Logger.h"
 #include <algorithm>
 
 // ============================================================================
 // Monster 基类实现
 // ============================================================================
 
-Monster::Monster()
-    : health(50.0f)
+Monster::Monster(const MonsterSpecies& species_)
+    : species(&species_)
+    , health(50.0f)
     , maxHealth(50.0f)
     , defense(3.0f)
     , attack(5.0f)
     , dodge(1)
     , level(1)
-    , healthMin(30.0f), healthMax(70.0f)
-    , defenseMin(1.0f), defenseMax(5.0f)
-    , attackMin(3.0f), attackMax(8.0f)
-    , dodgeMin(0), dodgeMax(5)
-    , expMin(10), expMax(20)
-    , goldMin(5), goldMax(15)
     , lastAttackUsedSkill(false)
     , position(0.0f, 0.0f)
-    , size(32.0f, 32.0f)
     , velocity(0.0f, 0.0f)
     , homePosition(0.0f, 0.0f)
     , aiState(MonsterAIState::Idle)
@@ -32,15 +26,7 @@ Monster::Monster()
     , lastAttackTime(0.0f)
     , textureLoaded(false)
     , isHovered(false)
-    , moveSpeed(40.0f)
-    , chaseSpeed(70.0f)
-    , returnSpeed(50.0f)
-    , aggroDuration(8.0f)
-    , attackRange(35.0f)
-    , attackCooldownTime(1.2f)
-    , chaseRange(200.0f)
-    , leashRange(300.0f)
-    , rng(std::random_device{}())
+    , rng(RandomService::getInstance().makeEntityStream(RngStream::Monster))
 {
 }
 
@@ -50,28 +36,17 @@ void Monster::init(float x, float y) {
     randomizeStats();
 }
 
-bool Monster::loadTexture(const std::string& texturePath) {
-    if (texture.loadFromFile(texturePath)) {
-        sprite.setTexture(texture);
-        textureLoaded = true;
-        return true;
-    }
-    
-    std::cerr << "[Monster] Failed to load texture: " << texturePath << std::endl;
-    return false;
+void Monster::setTexture(const sf::Texture& texture) {
+    sprite.setTexture(texture);
+    textureLoaded = true;
 }
 
 void Monster::randomizeStats() {
-    std::uniform_real_distribution<float> healthDist(healthMin, healthMax);
-    std::uniform_real_distribution<float> defenseDist(defenseMin, defenseMax);
-    std::uniform_real_distribution<float> attackDist(attackMin, attackMax);
-    std::uniform_int_distribution<int> dodgeDist(dodgeMin, dodgeMax);
-    
-    maxHealth = healthDist(rng);
+    maxHealth = rng.range(species->healthMin, species->healthMax);
     health = maxHealth;
-    defense = defenseDist(rng);
-    attack = attackDist(rng);
-    dodge = dodgeDist(rng);
+    defense = rng.range(species->defenseMin, species->defenseMax);
+    attack = rng.range(species->attackMin, species->attackMax);
+    dodge = rng.range(species->dodgeMin, species->dodgeMax);
 }
 
 // ========================================
@@ -81,7 +56,7 @@ void Monster::randomizeStats() {
 bool Monster::takeDamage(float damage, bool ignoreDefense) {
     // 闪避判定
     if (rollDodge()) {
-        std::cout << "[" << getTypeName() << "] 闪避了攻击!" << std::endl;
+        LOG_DEBUG("[" << getTypeName() << "] 闪避了攻击!");
         return false;
     }
     
@@ -94,16 +69,12 @@ bool Monster::takeDamage(float damage, bool ignoreDefense) {
     health -= actualDamage;
     health = std::max(0.0f, health);
     
-    std::cout << "[" << getTypeName() << "] 受到 " << actualDamage << " 点伤害, 剩余HP: " 
-              << health << "/" << maxHealth << std::endl;
+    LOG_DEBUG("[" << getTypeName() << "] 受到 " << actualDamage << " 点伤害, 剩余HP: " 
+          << health << "/" << maxHealth);
     
-    // 被攻击后激怒
+    // 被攻击后激怒（死亡由管理器压入击杀事件）
     if (!isDead()) {
-        aggro(aggroDuration);
-    } else {
-        if (onDeath) {
-            onDeath(*this);
-        }
+        aggro(species->aggroDuration);
     }
     
     return isDead();
@@ -114,36 +85,30 @@ float Monster::performAttack() {
     
     // 检查是否触发技能
     if (rollSkill()) {
-        damage *= skill.damageMultiplier;
+        damage *= species->skill.damageMultiplier;
         lastAttackUsedSkill = true;
-        std::cout << "[" << getTypeName() << "] 使用技能 [" << skill.name << "]!" << std::endl;
+        LOG_DEBUG("[" << getTypeName() << "] 使用技能 [" << species->skill.name << "]!");
     } else {
         lastAttackUsedSkill = false;
     }
     
-    attackCooldown = attackCooldownTime;
-    
-    if (onAttack) {
-        onAttack(*this);
-    }
+    attackCooldown = species->attackCooldownTime;
     
     return damage;
 }
 
 bool Monster::rollSkill() const {
-    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
-    return dist(rng) < skill.triggerChance;
+    return rng.nextFloat() < species->skill.triggerChance;
 }
 
 float Monster::getSkillMultiplier() const {
-    return skill.damageMultiplier;
+    return species->skill.damageMultiplier;
 }
 
 bool Monster::rollDodge() const {
     // 闪避几率 = 闪避值 * 0.5%
     float dodgeChance = dodge * 0.005f;
-    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
-    return dist(rng) < dodgeChance;
+    return rng.nextFloat() < dodgeChance;
 }
 
 void Monster::aggro(float duration) {
@@ -172,7 +137,7 @@ sf::FloatRect Monster::getBounds() const {
     if (spriteBounds.width > 0 && spriteBounds.height > 0) {
         return spriteBounds;
     }
-    return sf::FloatRect(position.x, position.y, size.x, size.y);
+    return sf::FloatRect(position.x, position.y, species->size.x, species->size.y);
 }
 
 sf::FloatRect Monster::getCollisionBox() const {
@@ -222,15 +187,13 @@ void Monster::updateSprite() {
 // 掉落奖励
 // ========================================
 
-std::vector<std::pair<std::string, int>> Monster::generateDrops() const {
-    std::vector<std::pair<std::string, int>> result;
+FrameVector<std::pair<std::string, int>> Monster::generateDrops() const {
+    FrameVector<std::pair<std::string, int>> result;
+    result.reserve(species->drops.size());
     
-    for (const auto& drop : drops) {
-        std::uniform_real_distribution<float> chanceDist(0.0f, 1.0f);
-        
-        if (chanceDist(rng) <= drop.dropChance) {
-            std::uniform_int_distribution<int> countDist(drop.minCount, drop.maxCount);
-            int count = countDist(rng);
+    for (const auto& drop : species->drops) {
+        if (rng.nextFloat() <= drop.dropChance) {
+            int count = rng.range(drop.minCount, drop.maxCount);
             
             if (count > 0) {
                 result.push_back({drop.itemId, count});
@@ -242,11 +205,9 @@ std::vector<std::pair<std::string, int>> Monster::generateDrops() const {
 }
 
 int Monster::getExpReward() const {
-    std::uniform_int_distribution<int> dist(expMin, expMax);
-    return dist(rng);
+    return rng.range(species->expMin, species->expMax);
 }
 
 int Monster::getGoldReward() const {
-    std::uniform_int_distribution<int> dist(goldMin, goldMax);
-    return dist(rng);
+    return rng.range(species->goldMin, species->goldMax);
 }
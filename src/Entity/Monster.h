@@ -2,15 +2,19 @@
 #include <SFML/Graphics.hpp>
 #include <string>
 #include <vector>
-#include <functional>
-#include <random>
 #include <memory>
 #include <cmath>
+#include "../Systems/Random.h"
+#include "../Systems/FrameArena.h"
+#include "../Systems/SpriteSheet.h"
+
+class FlowField;
 
 // ============================================================================
 // 怪物基类 (Monster Base Class)
 // 
 // 所有怪物的共有属性和行为，子类继承并扩展特定功能
+// 同类怪物的配置（属性范围、技能、掉落、AI参数、动画布局）放在 MonsterSpecies 里共享
 // ============================================================================
 
 // 怪物掉落物品结构
@@ -42,6 +46,40 @@ struct MonsterSkill {
           damageMultiplier(mult), triggerChance(chance), iconColor(color) {}
 };
 
+// 怪物物种（同类怪物共享的只读配置，由 MonsterSpeciesRegistry 持有）
+// 实例只保存随机出来的属性和运行状态，其余数据都从这里读
+struct MonsterSpecies {
+    std::string id;                 // 注册键（如 "rabbit"）
+    std::string name;               // 显示名称（如 "兔子"）
+    
+    // 属性范围（用于随机化）
+    float healthMin = 30.0f, healthMax = 70.0f;
+    float defenseMin = 1.0f, defenseMax = 5.0f;
+    float attackMin = 3.0f, attackMax = 8.0f;
+    int dodgeMin = 0, dodgeMax = 5;
+    
+    // 掉落奖励范围
+    int expMin = 10, expMax = 20;
+    int goldMin = 5, goldMax = 15;
+    
+    std::vector<MonsterDrop> drops;
+    MonsterSkill skill;
+    
+    // AI参数
+    float moveSpeed = 40.0f;
+    float chaseSpeed = 70.0f;
+    float returnSpeed = 50.0f;
+    float aggroDuration = 8.0f;
+    float attackRange = 35.0f;
+    float attackCooldownTime = 1.2f;
+    float chaseRange = 200.0f;
+    float leashRange = 300.0f;
+    
+    // 尺寸和动画
+    sf::Vector2f size{32.0f, 32.0f};
+    SpriteSheetLayout sheet;
+};
+
 // 怪物AI状态基础枚举
 enum class MonsterAIState {
     Idle,           // 站立
@@ -65,9 +103,7 @@ enum class MonsterDirection {
 // ============================================================================
 class Monster {
 public:
-    using MonsterCallback = std::function<void(Monster&)>;
-
-    Monster();
+    explicit Monster(const MonsterSpecies& species);
     virtual ~Monster() = default;
     
     // ========================================
@@ -75,14 +111,18 @@ public:
     // ========================================
     virtual void update(float dt, const sf::Vector2f& playerPos) = 0;
     virtual void render(sf::RenderWindow& window) = 0;
-    virtual std::string getName() const = 0;
-    virtual std::string getTypeName() const = 0;  // 怪物类型名称（如"兔子"、"史莱姆"）
+    
+    // 名称和类型名都来自物种（如"兔子"、"史莱姆"）
+    const std::string& getName() const { return species->name; }
+    const std::string& getTypeName() const { return species->name; }
+    const MonsterSpecies& getSpecies() const { return *species; }
     
     // ========================================
     // 初始化
     // ========================================
     virtual void init(float x, float y);
-    virtual bool loadTexture(const std::string& texturePath);
+    // 贴图由管理器加载一次，同类怪物共享（需比怪物活得久）
+    virtual void setTexture(const sf::Texture& texture);
     virtual void randomizeStats();  // 随机化属性（在给定范围内）
     
     // ========================================
@@ -105,7 +145,7 @@ public:
     bool hasTriggeredSkill() const { return lastAttackUsedSkill; }
     
     // 获取技能信息
-    const MonsterSkill& getSkill() const { return skill; }
+    const MonsterSkill& getSkill() const { return species->skill; }
     
     // 闪避判定
     bool rollDodge() const;
@@ -142,7 +182,7 @@ public:
     // ========================================
     sf::Vector2f getPosition() const { return position; }
     sf::Vector2f getVelocity() const { return velocity; }
-    sf::Vector2f getSize() const { return size; }
+    sf::Vector2f getSize() const { return species->size; }
     sf::Vector2f getHomePosition() const { return homePosition; }
     
     void setPosition(float x, float y);
@@ -156,27 +196,24 @@ public:
     // 被推挤时调用（移动位置）
     virtual void applyPush(const sf::Vector2f& pushVector);
     
+    // 追击时使用的共享流场（为空时直线追击）
+    void setFlowField(const FlowField* field) { flowField = field; }
+    
     // ========================================
     // 掉落奖励
     // ========================================
-    virtual std::vector<std::pair<std::string, int>> generateDrops() const;
+    virtual FrameVector<std::pair<std::string, int>> generateDrops() const;
     virtual int getExpReward() const;
     virtual int getGoldReward() const;
-    const std::vector<MonsterDrop>& getDrops() const { return drops; }
-    std::pair<int, int> getExpRange() const { return {expMin, expMax}; }
-    std::pair<int, int> getGoldRange() const { return {goldMin, goldMax}; }
+    const std::vector<MonsterDrop>& getDrops() const { return species->drops; }
+    std::pair<int, int> getExpRange() const { return {species->expMin, species->expMax}; }
+    std::pair<int, int> getGoldRange() const { return {species->goldMin, species->goldMax}; }
     
     // ========================================
     // 悬浮提示
     // ========================================
     void setHovered(bool hovered) { isHovered = hovered; }
     bool getHovered() const { return isHovered; }
-    
-    // ========================================
-    // 回调设置
-    // ========================================
-    void setOnDeath(MonsterCallback cb) { onDeath = cb; }
-    void setOnAttack(MonsterCallback cb) { onAttack = cb; }
 
 protected:
     // 更新方向（根据速度）
@@ -186,6 +223,9 @@ protected:
     virtual void updateSprite();
     
 protected:
+    // === 物种（共享配置）===
+    const MonsterSpecies* species;
+    
     // === 基础属性 ===
     float health;
     float maxHealth;
@@ -194,28 +234,14 @@ protected:
     int dodge;          // 闪避值 0-200, 1点 = 0.5%闪避几率
     int level;
     
-    // === 属性范围（用于随机化）===
-    float healthMin, healthMax;
-    float defenseMin, defenseMax;
-    float attackMin, attackMax;
-    int dodgeMin, dodgeMax;
-    
-    // === 掉落奖励范围 ===
-    int expMin, expMax;
-    int goldMin, goldMax;
-    
-    // === 掉落物品 ===
-    std::vector<MonsterDrop> drops;
-    
     // === 技能 ===
-    MonsterSkill skill;
     bool lastAttackUsedSkill;
     
     // === 位置和移动 ===
     sf::Vector2f position;
-    sf::Vector2f size;
     sf::Vector2f velocity;
     sf::Vector2f homePosition;
+    const FlowField* flowField = nullptr;
     
     // === AI状态 ===
     MonsterAIState aiState;
@@ -227,28 +253,13 @@ protected:
     
     // === 渲染 ===
     sf::Sprite sprite;
-    sf::Texture texture;
     bool textureLoaded;
     
     // === 交互状态 ===
     bool isHovered;
     
-    // === 回调 ===
-    MonsterCallback onDeath;
-    MonsterCallback onAttack;
-    
-    // === 随机数生成 ===
-    mutable std::mt19937 rng;
-    
-    // === AI常量（可在子类中覆盖）===
-    float moveSpeed;
-    float chaseSpeed;
-    float returnSpeed;
-    float aggroDuration;
-    float attackRange;
-    float attackCooldownTime;
-    float chaseRange;
-    float leashRange;
+    // === 随机数生成（实体独立流）===
+    mutable Rng rng;
 };
 
 // ============================================================================
@@ -257,15 +268,14 @@ protected:
 template<typename T>
 class MonsterManager {
 public:
-    MonsterManager() : hoveredMonster(nullptr) {
-        rng.seed(std::random_device{}());
-    }
+    MonsterManager() : hoveredMonster(nullptr) {}
     
     virtual ~MonsterManager() = default;
     
-    // 初始化
+    // 初始化（贴图只加载一次，所有怪物共享）
     virtual bool init(const std::string& resourcePath) {
         texturePath = resourcePath;
+        textureLoaded = texture.loadFromFile(texturePath);
         return true;
     }
     
@@ -303,7 +313,9 @@ public:
     // 添加怪物
     T* addMonster(float x, float y) {
         auto monster = std::make_unique<T>(x, y);
-        monster->loadTexture(texturePath);
+        if (textureLoaded) {
+            monster->setTexture(texture);
+        }
         T* ptr = monster.get();
         monsters.push_back(std::move(monster));
         return ptr;
@@ -492,6 +504,7 @@ public:
 protected:
     std::vector<std::unique_ptr<T>> monsters;
     std::string texturePath;
+    sf::Texture texture;
+    bool textureLoaded = false;
     T* hoveredMonster;
-    std::mt19937 rng;
 };
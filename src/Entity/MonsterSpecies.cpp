@@ -0,0 +1,71 @@
+#include "MonsterSpecies.h"
+#include "../Systems/Logger.h"
+
+MonsterSpeciesRegistry& MonsterSpeciesRegistry::getInstance() {
+    static MonsterSpeciesRegistry instance;
+    return instance;
+}
+
+MonsterSpeciesRegistry::MonsterSpeciesRegistry() {
+    registerBuiltins();
+}
+
+MonsterSpeciesId MonsterSpeciesRegistry::add(MonsterSpecies species) {
+    entries.push_back(std::move(species));
+    return static_cast<MonsterSpeciesId>(entries.size() - 1);
+}
+
+const MonsterSpecies* MonsterSpeciesRegistry::find(const std::string& id) const {
+    for (const auto& species : entries) {
+        if (species.id == id) {
+            return &species;
+        }
+    }
+    return nullptr;
+}
+
+// ============================================================================
+// 内置物种
+// ============================================================================
+
+void MonsterSpeciesRegistry::registerBuiltins() {
+    // 兔子
+    {
+        MonsterSpecies rabbit;
+        rabbit.id = "rabbit";
+        rabbit.name = "兔子";
+        
+        rabbit.healthMin = 30.0f; rabbit.healthMax = 50.0f;
+        rabbit.defenseMin = 1.0f; rabbit.defenseMax = 5.0f;
+        rabbit.attackMin = 3.0f; rabbit.attackMax = 8.0f;
+        rabbit.dodgeMin = 0; rabbit.dodgeMax = 2;
+        
+        rabbit.expMin = 10; rabbit.expMax = 20;
+        rabbit.goldMin = 10; rabbit.goldMax = 30;
+        
+        rabbit.drops = {
+            MonsterDrop("rabbit_fur", "兔毛", 1, 2, 0.30f),
+            MonsterDrop("carrot", "胡萝卜", 1, 2, 0.20f),
+            MonsterDrop("rabbit_meat", "兔肉", 1, 1, 0.10f),
+            MonsterDrop("rabbit_essence", "兔子精元", 1, 1, 0.02f)   // 2%掉落宠物精元
+        };
+        rabbit.skill = MonsterSkill("bite", "撕咬", "凶猛撕咬，造成双倍伤害", 2.0f, 0.10f, sf::Color(255, 80, 80));
+        
+        rabbit.moveSpeed = 40.0f;
+        rabbit.chaseSpeed = 70.0f;
+        rabbit.returnSpeed = 50.0f;
+        rabbit.aggroDuration = 8.0f;
+        rabbit.attackRange = 35.0f;
+        rabbit.attackCooldownTime = 1.2f;
+        rabbit.chaseRange = 200.0f;
+        rabbit.leashRange = 300.0f;
+        
+        // 精灵表 128x256：每帧32x32，每行4帧，0-3行移动、4-7行攻击
+        rabbit.size = sf::Vector2f(32.0f, 32.0f);
+        rabbit.sheet.scale = 2.0f;
+        
+        add(std::move(rabbit));
+    }
+    
+    LOG_INFO("[MonsterSpeciesRegistry] Registered " << entries.size() << " species");
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include "Monster.h"
+#include <cstdint>
+#include <deque>
+#include <string>
+
+// ============================================================================
+// 怪物物种注册表 (Monster Species Registry)
+//
+// 每种怪物一份只读的 MonsterSpecies，怪物实例构造时拿到它的引用：
+//   Rabbit rabbit;   // 使用 MonsterSpeciesRegistry::RABBIT
+//   const MonsterSpecies& s = MonsterSpeciesRegistry::getInstance().get(MonsterSpeciesRegistry::RABBIT);
+//
+//   - 物种按注册顺序编号，内置物种的编号是下面的常量
+//   - 新物种只需 add 一份数据（属性范围、技能、掉落、AI参数、动画布局）
+//   - 已注册物种的地址不会变化，实例可以长期持有引用
+// ============================================================================
+
+using MonsterSpeciesId = std::uint16_t;
+
+class MonsterSpeciesRegistry {
+public:
+    // 内置物种编号（与注册顺序一致）
+    static constexpr MonsterSpeciesId RABBIT = 0;
+
+    static MonsterSpeciesRegistry& getInstance();
+
+    // 注册新物种，返回编号
+    MonsterSpeciesId add(MonsterSpecies species);
+
+    const MonsterSpecies& get(MonsterSpeciesId id) const { return entries[id]; }
+
+    // 按注册键查找（未找到返回 nullptr）
+    const MonsterSpecies* find(const std::string& id) const;
+
+    size_t size() const { return entries.size(); }
+
+private:
+    MonsterSpeciesRegistry();
+    MonsterSpeciesRegistry(const MonsterSpeciesRegistry&) = delete;
+    MonsterSpeciesRegistry& operator=(const MonsterSpeciesRegistry&) = delete;
+
+    void registerBuiltins();
+
+    // deque：追加时已有元素不搬家
+    std::deque<MonsterSpecies> entries;
+};
@@ -1,9 +1,11 @@
 #pragma once
 #include <SFML/Graphics.hpp>
-#include <iostream>
 #include <vector>
 #include <cmath>
 #include "PlayerStats.h"
+#include "../Systems/InputSystem.h"
+#include "../Systems/Logger.h"
+#include "../Systems/RenderStats.h"
 
 // 动画状态枚举
 enum class AnimState {
@@ -41,7 +43,7 @@ public:
     {
         // 加载精灵表
         if (!texture.loadFromFile("../../assets/player.png")) {
-            std::cerr << "error：无法加载 player.png" << std::endl;
+            LOG_ERROR("error：无法加载 player.png");
             texture.create(64, 64);
         }
 
@@ -111,23 +113,25 @@ public:
             currentSpeed *= 0.3f;
         }
         
+        const InputSystem& input = InputSystem::getInstance();
+        
         // 拾取时不能移动
         if (!isPickingUp) {
             // 键盘控制
-            if (sf::Keyboard::isKeyPressed(sf::Keyboard::W) || sf::Keyboard::isKeyPressed(sf::Keyboard::Up)) {
+            if (input.isDown(InputAction::MoveUp)) {
                 movement.y -= currentSpeed * dt;
                 isMoving = true;
             }
-            if (sf::Keyboard::isKeyPressed(sf::Keyboard::S) || sf::Keyboard::isKeyPressed(sf::Keyboard::Down)) {
+            if (input.isDown(InputAction::MoveDown)) {
                 movement.y += currentSpeed * dt;
                 isMoving = true;
             }
-            if (sf::Keyboard::isKeyPressed(sf::Keyboard::A) || sf::Keyboard::isKeyPressed(sf::Keyboard::Left)) {
+            if (input.isDown(InputAction::MoveLeft)) {
                 movement.x -= currentSpeed * dt;
                 isMoving = true;
                 facing = Direction::Left;
             }
-            if (sf::Keyboard::isKeyPressed(sf::Keyboard::D) || sf::Keyboard::isKeyPressed(sf::Keyboard::Right)) {
+            if (input.isDown(InputAction::MoveRight)) {
                 movement.x += currentSpeed * dt;
                 isMoving = true;
                 facing = Direction::Right;
@@ -139,7 +143,7 @@ public:
 
         // 状态切换（受伤动画优先级低于攻击）
         if (currentState != AnimState::Attack && currentState != AnimState::Pickup) {
-            if (sf::Keyboard::isKeyPressed(sf::Keyboard::Space)) {
+            if (input.isDown(InputAction::Attack)) {
                 // 攻击消耗体力
                 if (stats.hasStamina(5.0f)) {
                     stats.consumeStamina(5.0f);
@@ -168,7 +172,7 @@ public:
     }
     
     void render(sf::RenderWindow& window) {
-        window.draw(sprite);
+        RenderStats::draw(window, sprite);
     }
     
     // ========================================
@@ -211,14 +215,7 @@ public:
     
     // 判断玩家是否正在主动移动（用于碰撞响应）
     bool isMoving() const {
-        return sf::Keyboard::isKeyPressed(sf::Keyboard::W) ||
-               sf::Keyboard::isKeyPressed(sf::Keyboard::A) ||
-               sf::Keyboard::isKeyPressed(sf::Keyboard::S) ||
-               sf::Keyboard::isKeyPressed(sf::Keyboard::D) ||
-               sf::Keyboard::isKeyPressed(sf::Keyboard::Up) ||
-               sf::Keyboard::isKeyPressed(sf::Keyboard::Down) ||
-               sf::Keyboard::isKeyPressed(sf::Keyboard::Left) ||
-               sf::Keyboard::isKeyPressed(sf::Keyboard::Right);
+        return InputSystem::getInstance().isAnyMoveDown();
     }
     
     // 被推挤时调用（移动位置）
@@ -280,7 +277,7 @@ public:
         
         if (crit) {
             damage *= stats.getCriticalMultiplier();
-            std::cout << "暴击! ";
+            LOG_DEBUG("暴击!");
         }
         
         return damage;
@@ -334,7 +331,7 @@ public:
     void receiveDamage(float damage, const sf::Vector2f& attackerPos, float attackerDodgeReduction = 0.0f) {
         // 闪避判定
         if (stats.rollDodge(attackerDodgeReduction)) {
-            std::cout << "闪避成功!" << std::endl;
+            LOG_INFO("闪避成功!");
             return;
         }
         
@@ -365,7 +362,7 @@ public:
         isKnockedBack = true;
         
         if (stats.isDead()) {
-            std::cout << "玩家死亡!" << std::endl;
+            LOG_INFO("玩家死亡!");
         }
     }
     
@@ -373,7 +370,7 @@ public:
     void receiveDamage(float damage, float attackerDodgeReduction = 0.0f) {
         // 闪避判定
         if (stats.rollDodge(attackerDodgeReduction)) {
-            std::cout << "闪避成功!" << std::endl;
+            LOG_INFO("闪避成功!");
             return;
         }
         
@@ -385,7 +382,7 @@ public:
         setState(AnimState::Hurt);
         
         if (stats.isDead()) {
-            std::cout << "玩家死亡!" << std::endl;
+            LOG_INFO("玩家死亡!");
         }
     }
     
@@ -1,9 +1,9 @@
 #include "PlayerStats.h"
+#include "../Systems/Logger.h"
 #include <cmath>
 #include <algorithm>
 #include <sstream>
 #include <iomanip>
-#include <cstdlib>
 #include <iostream>
 
 // ============================================================================
@@ -49,7 +49,7 @@ PlayerStats::PlayerStats()
     , onGoldChange(nullptr)
     , onSkillLevelUp(nullptr)
     // 随机数生成器
-    , rng(std::random_device{}())
+    , rng(RandomService::getInstance().makeEntityStream(RngStream::Player))
 {
     // 初始化生活技能
     farmingSkill = SkillInfo();
@@ -196,19 +196,12 @@ void PlayerStats::checkLevelUp() {
 }
 
 void PlayerStats::applyLevelUpBonus() {
-    // 随机属性成长范围
-    std::uniform_int_distribution<int> attackDist(3, 6);      // 攻击力 3-6
-    std::uniform_int_distribution<int> healthDist(20, 50);    // 生命值 20-50
-    std::uniform_int_distribution<int> staminaDist(10, 20);   // 体力 10-20
-    std::uniform_int_distribution<int> defenseDist(2, 5);     // 防御力 2-5
-    std::uniform_int_distribution<int> luckDist(1, 2);        // 幸运 1-2
-    
-    // 应用随机成长
-    int atkGain = attackDist(rng);
-    int hpGain = healthDist(rng);
-    int spGain = staminaDist(rng);
-    int defGain = defenseDist(rng);
-    int luckGain = luckDist(rng);
+    // 随机属性成长
+    int atkGain = rng.range(3, 6);      // 攻击力 3-6
+    int hpGain = rng.range(20, 50);     // 生命值 20-50
+    int spGain = rng.range(10, 20);     // 体力 10-20
+    int defGain = rng.range(2, 5);      // 防御力 2-5
+    int luckGain = rng.range(1, 2);     // 幸运 1-2
     
     baseAttack += static_cast<float>(atkGain);
     baseDefense += static_cast<float>(defGain);
@@ -223,11 +216,11 @@ void PlayerStats::applyLevelUpBonus() {
     stamina = maxStamina;
     
     // 输出升级信息（调试用）
-    std::cout << "[升级] ATK+" << atkGain 
-              << " DEF+" << defGain 
-              << " HP+" << hpGain 
-              << " SP+" << spGain 
-              << " LCK+" << luckGain << std::endl;
+    LOG_INFO("[升级] ATK+" << atkGain 
+          << " DEF+" << defGain 
+          << " HP+" << hpGain 
+          << " SP+" << spGain 
+          << " LCK+" << luckGain);
 }
 
 int PlayerStats::calculateExpForLevel(int lvl) const {
@@ -262,14 +255,14 @@ bool PlayerStats::rollDodge(float enemyDodgeReduction) const {
     float effectiveDodge = baseDodgePercent - enemyDodgeReduction;
     effectiveDodge = clamp(effectiveDodge, 0.0f, 100.0f);  // 最高100%闪避
     
-    float roll = static_cast<float>(rand() % 100);
+    float roll = static_cast<float>(rng.range(0, 99));
     return roll < effectiveDodge;
 }
 
 bool PlayerStats::rollCritical() const {
     // 暴击率 = 幸运值 / 2 (最高50%)
     float critChance = std::min(luck / 2.0f, 50.0f);
-    float roll = static_cast<float>(rand() % 100);
+    float roll = static_cast<float>(rng.range(0, 99));
     return roll < critChance;
 }
 
@@ -458,6 +451,76 @@ float PlayerStats::clamp(float value, float minVal, float maxVal) const {
     return std::max(minVal, std::min(value, maxVal));
 }
 
+// ============================================================================
+// 存档
+// ============================================================================
+
+PlayerStatsSaveData PlayerStats::captureSaveData() const {
+    PlayerStatsSaveData data;
+    data.health = health;
+    data.maxHealth = maxHealth;
+    data.stamina = stamina;
+    data.maxStamina = maxStamina;
+    data.hunger = hunger;
+    data.maxHunger = maxHunger;
+    data.level = level;
+    data.exp = exp;
+    data.expToNextLevel = expToNextLevel;
+    data.baseAttack = baseAttack;
+    data.baseDefense = baseDefense;
+    data.baseSpeed = baseSpeed;
+    data.baseDodge = baseDodge;
+    data.bonusAttack = bonusAttack;
+    data.bonusDefense = bonusDefense;
+    data.bonusSpeed = bonusSpeed;
+    data.bonusDodge = bonusDodge;
+    data.luck = luck;
+    data.damageBonus = damageBonus;
+    data.dodgeReduction = dodgeReduction;
+    data.gold = gold;
+    data.farmingSkill = farmingSkill;
+    data.fishingSkill = fishingSkill;
+    data.miningSkill = miningSkill;
+    data.hungerDecayTimer = hungerDecayTimer;
+    data.staminaRegenTimer = staminaRegenTimer;
+    data.healthRegenTimer = healthRegenTimer;
+    return data;
+}
+
+void PlayerStats::applySaveData(const PlayerStatsSaveData& data) {
+    health = data.health;
+    maxHealth = data.maxHealth;
+    stamina = data.stamina;
+    maxStamina = data.maxStamina;
+    hunger = data.hunger;
+    maxHunger = data.maxHunger;
+    level = data.level;
+    exp = data.exp;
+    expToNextLevel = data.expToNextLevel;
+    baseAttack = data.baseAttack;
+    baseDefense = data.baseDefense;
+    baseSpeed = data.baseSpeed;
+    baseDodge = data.baseDodge;
+    bonusAttack = data.bonusAttack;
+    bonusDefense = data.bonusDefense;
+    bonusSpeed = data.bonusSpeed;
+    bonusDodge = data.bonusDodge;
+    luck = data.luck;
+    damageBonus = data.damageBonus;
+    dodgeReduction = data.dodgeReduction;
+    gold = data.gold;
+    farmingSkill = data.farmingSkill;
+    fishingSkill = data.fishingSkill;
+    miningSkill = data.miningSkill;
+    hungerDecayTimer = data.hungerDecayTimer;
+    staminaRegenTimer = data.staminaRegenTimer;
+    healthRegenTimer = data.healthRegenTimer;
+    
+    if (onHealthChange) onHealthChange();
+    if (onStaminaChange) onStaminaChange();
+    if (onGoldChange) onGoldChange();
+}
+
 // ============================================================================
 // 调试信息
 // ============================================================================
@@ -1,7 +1,7 @@
 #pragma once
 #include <string>
 #include <functional>
-#include <random>
+#include "../Systems/Random.h"
 
 // ============================================================================
 // 角色属性系统
@@ -33,6 +33,25 @@ struct SkillInfo {
 // 属性变化回调类型（用于UI更新等）
 using StatsCallback = std::function<void()>;
 
+// 存档数据（所有需要持久化的数值，不含回调）
+struct PlayerStatsSaveData {
+    float health = 0, maxHealth = 0;
+    float stamina = 0, maxStamina = 0;
+    float hunger = 0, maxHunger = 0;
+    
+    int level = 1, exp = 0, expToNextLevel = 0;
+    
+    float baseAttack = 0, baseDefense = 0, baseSpeed = 0, baseDodge = 0;
+    float bonusAttack = 0, bonusDefense = 0, bonusSpeed = 0, bonusDodge = 0;
+    float luck = 0, damageBonus = 0, dodgeReduction = 0;
+    
+    int gold = 0;
+    
+    SkillInfo farmingSkill, fishingSkill, miningSkill;
+    
+    float hungerDecayTimer = 0, staminaRegenTimer = 0, healthRegenTimer = 0;
+};
+
 class PlayerStats {
 public:
     PlayerStats();
@@ -190,6 +209,12 @@ public:
     void setOnGoldChange(StatsCallback callback) { onGoldChange = callback; }
     void setOnSkillLevelUp(StatsCallback callback) { onSkillLevelUp = callback; }
     
+    // ========================================
+    // 存档
+    // ========================================
+    PlayerStatsSaveData captureSaveData() const;
+    void applySaveData(const PlayerStatsSaveData& data);
+    
     // ========================================
     // 调试信息
     // ========================================
@@ -261,8 +286,8 @@ private:
     StatsCallback onGoldChange;
     StatsCallback onSkillLevelUp;
     
-    // === 随机数生成器 ===
-    mutable std::mt19937 rng;
+    // === 随机数生成器（实体独立流）===
+    mutable Rng rng;
     
     // === 常量配置 ===
     static constexpr float HUNGER_DECAY_RATE = 1.0f;        // 每秒饥饿度下降
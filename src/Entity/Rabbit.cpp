@@ -1,5 +1,10 @@
 #include "Rabbit.h"
-#include <iostream>
+#include "MonsterSpecies.h"
+#include "../Systems/InputSystem.h"
+#include "../Systems/Logger.h"
+#include "../Systems/EventBus.h"
+#include "../Systems/RenderStats.h"
+#include "../World/FlowField.h"
 #include <algorithm>
 #include <cmath>
 
@@ -8,8 +13,7 @@
 // ============================================================================
 
 Rabbit::Rabbit()
-    : Monster()
-    , rabbitSkill("bite", "撕咬", "凶猛撕咬，造成双倍伤害", 2.0f, 0.10f, sf::Color(255, 80, 80))
+    : Monster(MonsterSpeciesRegistry::getInstance().get(MonsterSpeciesRegistry::RABBIT))
     , wanderTimer(0.0f)
     , wanderDuration(0.0f)
     , idleTimer(0.0f)
@@ -17,47 +21,9 @@ Rabbit::Rabbit()
     , lastAnimState(RabbitAnimState::MoveDown)
     , currentFrame(0)
     , animTimer(0.0f)
-    , frameTime(0.15f)
     , animationLocked(false)
     , animLockTimer(0.0f)
 {
-    // 设置兔子特有的属性范围
-    healthMin = 30.0f; healthMax = 50.0f;
-    defenseMin = 1.0f; defenseMax = 5.0f;
-    attackMin = 3.0f; attackMax = 8.0f;
-    dodgeMin = 0; dodgeMax = 2;
-    
-    // 设置掉落奖励范围
-    expMin = 10; expMax = 20;
-    goldMin = 10; goldMax = 30;
-    
-    // 设置兔子特有掉落
-    rabbitDrops.push_back(RabbitDrop("rabbit_fur", "兔毛", 1, 2, 0.30f));
-    rabbitDrops.push_back(RabbitDrop("carrot", "胡萝卜", 1, 2, 0.20f));
-    rabbitDrops.push_back(RabbitDrop("rabbit_meat", "兔肉", 1, 1, 0.10f));
-    rabbitDrops.push_back(RabbitDrop("rabbit_essence", "兔子精元", 1, 1, 0.02f));  // 2%掉落宠物精元
-    
-    // 同时添加到父类的掉落列表
-    drops.push_back(MonsterDrop("rabbit_fur", "兔毛", 1, 2, 0.30f));
-    drops.push_back(MonsterDrop("carrot", "胡萝卜", 1, 2, 0.20f));
-    drops.push_back(MonsterDrop("rabbit_meat", "兔肉", 1, 1, 0.10f));
-    drops.push_back(MonsterDrop("rabbit_essence", "兔子精元", 1, 1, 0.02f));  // 2%掉落宠物精元
-    
-    // 设置父类技能
-    skill = MonsterSkill("bite", "撕咬", "凶猛撕咬，造成双倍伤害", 2.0f, 0.10f, sf::Color(255, 80, 80));
-    
-    // 设置兔子的AI参数
-    moveSpeed = RABBIT_MOVE_SPEED;
-    chaseSpeed = RABBIT_CHASE_SPEED;
-    returnSpeed = RABBIT_RETURN_SPEED;
-    aggroDuration = RABBIT_AGGRO_DURATION;
-    attackRange = RABBIT_ATTACK_RANGE;
-    attackCooldownTime = RABBIT_ATTACK_COOLDOWN;
-    chaseRange = RABBIT_CHASE_RANGE;
-    leashRange = RABBIT_LEASH_RANGE;
-    
-    // 设置尺寸
-    size = sf::Vector2f(32.0f, 32.0f);
 }
 
 Rabbit::Rabbit(float x, float y) : Rabbit() {
@@ -68,32 +34,20 @@ void Rabbit::init(float x, float y) {
     Monster::init(x, y);
 }
 
-bool Rabbit::loadTexture(const std::string& texturePath) {
-    if (texture.loadFromFile(texturePath)) {
-        sprite.setTexture(texture);
-        sprite.setTextureRect(getFrameRect(ROW_MOVE_DOWN, 0));
-        sprite.setScale(2.0f, 2.0f);
-        updateSprite();
-        textureLoaded = true;
-        std::cout << "[Rabbit] Texture loaded: " << texturePath << std::endl;
-        return true;
-    }
-    
-    std::cerr << "[Rabbit] Failed to load texture: " << texturePath << std::endl;
-    return false;
+void Rabbit::setTexture(const sf::Texture& texture) {
+    const SpriteSheetLayout& sheet = species->sheet;
+    Monster::setTexture(texture);
+    sprite.setTextureRect(sheet.frameRect(sheet.moveRow, 0));
+    sprite.setScale(sheet.scale, sheet.scale);
+    updateSprite();
 }
 
 void Rabbit::randomizeStats() {
-    std::uniform_int_distribution<int> healthDist(static_cast<int>(healthMin), static_cast<int>(healthMax));
-    std::uniform_int_distribution<int> defenseDist(static_cast<int>(defenseMin), static_cast<int>(defenseMax));
-    std::uniform_int_distribution<int> attackDist(static_cast<int>(attackMin), static_cast<int>(attackMax));
-    std::uniform_int_distribution<int> dodgeDist(dodgeMin, dodgeMax);
-    
-    maxHealth = static_cast<float>(healthDist(rng));
+    maxHealth = static_cast<float>(rng.range(static_cast<int>(species->healthMin), static_cast<int>(species->healthMax)));
     health = maxHealth;
-    defense = static_cast<float>(defenseDist(rng));
-    attack = static_cast<float>(attackDist(rng));
-    dodge = dodgeDist(rng);
+    defense = static_cast<float>(rng.range(static_cast<int>(species->defenseMin), static_cast<int>(species->defenseMax)));
+    attack = static_cast<float>(rng.range(static_cast<int>(species->attackMin), static_cast<int>(species->attackMax)));
+    dodge = rng.range(species->dodgeMin, species->dodgeMax);
 }
 
 void Rabbit::update(float dt, const sf::Vector2f& playerPos) {
@@ -158,19 +112,16 @@ void Rabbit::updateAI(float dt, const sf::Vector2f& playerPos) {
             
             // 随机开始游荡
             if (idleTimer > 2.0f) {
-                std::uniform_real_distribution<float> dist(0.0f, 1.0f);
-                if (dist(rng) < 0.3f) {
+                if (rng.nextFloat() < 0.3f) {
                     aiState = MonsterAIState::Wandering;
                     idleTimer = 0;
                     
                     // 随机选择方向
-                    std::uniform_real_distribution<float> angleDist(0.0f, 2.0f * 3.14159f);
-                    float angle = angleDist(rng);
-                    velocity.x = std::cos(angle) * moveSpeed;
-                    velocity.y = std::sin(angle) * moveSpeed;
+                    float angle = rng.range(0.0f, 2.0f * 3.14159f);
+                    velocity.x = std::cos(angle) * species->moveSpeed;
+                    velocity.y = std::sin(angle) * species->moveSpeed;
                     
-                    std::uniform_real_distribution<float> durationDist(1.0f, 3.0f);
-                    wanderDuration = durationDist(rng);
+                    wanderDuration = rng.range(1.0f, 3.0f);
                     wanderTimer = 0;
                     
                     updateDirectionFromVelocityRabbit();
@@ -193,17 +144,25 @@ void Rabbit::updateAI(float dt, const sf::Vector2f& playerPos) {
             
         case MonsterAIState::Chasing:
             // 检查是否超出牵引范围
-            if (distToHome > leashRange) {
+            if (distToHome > species->leashRange) {
                 isAggroed = false;
                 aiState = MonsterAIState::Returning;
                 break;
             }
             
-            // 追击玩家
-            if (distToPlayer > attackRange) {
+            // 追击玩家（远时沿流场绕开障碍，近时直线贴近）
+            if (distToPlayer > species->attackRange) {
                 if (distToPlayer > 0) {
                     sf::Vector2f chaseDir = toPlayer / distToPlayer;
-                    velocity = chaseDir * chaseSpeed;
+                    if (flowField && distToPlayer > FLOW_FIELD_MIN_DISTANCE) {
+                        sf::FloatRect box = getCollisionBox();
+                        sf::Vector2f flowDir = flowField->sampleDirection(
+                            sf::Vector2f(box.left + box.width / 2, box.top + box.height / 2));
+                        if (flowDir.x != 0 || flowDir.y != 0) {
+                            chaseDir = flowDir;
+                        }
+                    }
+                    velocity = chaseDir * species->chaseSpeed;
                     updateDirectionFromVelocityRabbit();
                 }
             } else {
@@ -214,7 +173,7 @@ void Rabbit::updateAI(float dt, const sf::Vector2f& playerPos) {
             
         case MonsterAIState::Attacking:
             // 检查是否超出牵引范围
-            if (distToHome > leashRange) {
+            if (distToHome > species->leashRange) {
                 isAggroed = false;
                 aiState = MonsterAIState::Returning;
                 break;
@@ -228,7 +187,7 @@ void Rabbit::updateAI(float dt, const sf::Vector2f& playerPos) {
             }
             
             // 如果玩家跑出攻击范围，继续追
-            if (distToPlayer > attackRange * 1.5f) {
+            if (distToPlayer > species->attackRange * 1.5f) {
                 aiState = MonsterAIState::Chasing;
                 break;
             }
@@ -243,13 +202,8 @@ void Rabbit::updateAI(float dt, const sf::Vector2f& playerPos) {
             
             // 执行攻击
             if (attackCooldown <= 0) {
-                if (onAttack) {
-                    onAttack(*this);
-                }
-                if (onAttackRabbit) {
-                    onAttackRabbit(*this);
-                }
-                attackCooldown = attackCooldownTime;
+                EventBus::getInstance().push(RabbitAttackEvent{handle});
+                attackCooldown = species->attackCooldownTime;
             }
             
             velocity = sf::Vector2f(0, 0);
@@ -259,7 +213,7 @@ void Rabbit::updateAI(float dt, const sf::Vector2f& playerPos) {
             // 返回家的位置
             if (distToHome > 10.0f) {
                 sf::Vector2f returnDir = toHome / distToHome;
-                velocity = returnDir * returnSpeed;
+                velocity = returnDir * species->returnSpeed;
                 updateDirectionFromVelocityRabbit();
             } else {
                 velocity = sf::Vector2f(0, 0);
@@ -293,25 +247,18 @@ void Rabbit::updateDirectionFromVelocityRabbit() {
 }
 
 void Rabbit::updateAnimation(float dt) {
+    const SpriteSheetLayout& sheet = species->sheet;
     animTimer += dt;
     
-    if (animTimer >= frameTime) {
-        animTimer -= frameTime;
-        currentFrame = (currentFrame + 1) % FRAMES_PER_ROW;
+    if (animTimer >= sheet.frameTime) {
+        animTimer -= sheet.frameTime;
+        currentFrame = (currentFrame + 1) % sheet.framesPerRow;
         
-        int row = 0;
-        switch (animState) {
-            case RabbitAnimState::MoveDown: row = ROW_MOVE_DOWN; break;
-            case RabbitAnimState::MoveUp: row = ROW_MOVE_UP; break;
-            case RabbitAnimState::MoveLeft: row = ROW_MOVE_LEFT; break;
-            case RabbitAnimState::MoveRight: row = ROW_MOVE_RIGHT; break;
-            case RabbitAnimState::AttackDown: row = ROW_ATTACK_DOWN; break;
-            case RabbitAnimState::AttackUp: row = ROW_ATTACK_UP; break;
-            case RabbitAnimState::AttackLeft: row = ROW_ATTACK_LEFT; break;
-            case RabbitAnimState::AttackRight: row = ROW_ATTACK_RIGHT; break;
-        }
+        // RabbitAnimState 按 移动下/上/左/右、攻击下/上/左/右 排列，与精灵表方向顺序一致
+        int state = static_cast<int>(animState);
+        int row = state < 4 ? sheet.moveRow + state : sheet.attackRow + (state - 4);
         
-        sprite.setTextureRect(getFrameRect(row, currentFrame));
+        sprite.setTextureRect(sheet.frameRect(row, currentFrame));
     }
 }
 
@@ -339,51 +286,42 @@ void Rabbit::updateSprite() {
     sprite.setPosition(position);
 }
 
-sf::IntRect Rabbit::getFrameRect(int row, int col) const {
-    return sf::IntRect(
-        col * FRAME_WIDTH,
-        row * FRAME_HEIGHT,
-        FRAME_WIDTH,
-        FRAME_HEIGHT
-    );
-}
-
 void Rabbit::render(sf::RenderWindow& window) {
     if (textureLoaded && !isDead()) {
-        window.draw(sprite);
+        RenderStats::draw(window, sprite);
         
         // 绘制生命条
         float barWidth = 40.0f;
         float barHeight = 4.0f;
-        float barX = position.x + (size.x * 2 - barWidth) / 2;
+        float barX = position.x + (species->size.x * 2 - barWidth) / 2;
         float barY = position.y - 10;
         
         // 背景
         sf::RectangleShape bgBar(sf::Vector2f(barWidth, barHeight));
         bgBar.setPosition(barX, barY);
         bgBar.setFillColor(sf::Color(40, 40, 40, 180));
-        window.draw(bgBar);
+        RenderStats::draw(window, bgBar);
         
         // 生命值
         float healthWidth = barWidth * getHealthPercent();
         sf::RectangleShape healthBar(sf::Vector2f(healthWidth, barHeight));
         healthBar.setPosition(barX, barY);
         healthBar.setFillColor(sf::Color(220, 60, 60));
-        window.draw(healthBar);
+        RenderStats::draw(window, healthBar);
         
         // 如果被激怒，显示愤怒标记
         if (isAggroed) {
             sf::CircleShape aggroIndicator(5);
             aggroIndicator.setFillColor(sf::Color(255, 100, 100));
             aggroIndicator.setPosition(barX + barWidth + 5, barY);
-            window.draw(aggroIndicator);
+            RenderStats::draw(window, aggroIndicator);
         }
     }
 }
 
 sf::FloatRect Rabbit::getCollisionBox() const {
     float shrink = 0.2f;
-    sf::FloatRect bounds = sf::FloatRect(position.x, position.y, size.x * 2, size.y * 2);
+    sf::FloatRect bounds = sf::FloatRect(position.x, position.y, species->size.x * 2, species->size.y * 2);
     return sf::FloatRect(
         bounds.left + bounds.width * shrink / 2,
         bounds.top + bounds.height * shrink / 2,
@@ -397,15 +335,20 @@ sf::FloatRect Rabbit::getCollisionBox() const {
 // ============================================================================
 
 RabbitManager::RabbitManager()
-    : fontLoaded(false)
-    , hoveredRabbit(nullptr)
-    , rng(std::random_device{}())
+    : textureLoaded(false)
+    , fontLoaded(false)
 {
 }
 
 bool RabbitManager::init(const std::string& texturePath_) {
     texturePath = texturePath_;
     
+    // 所有兔子共用一张精灵表
+    textureLoaded = texture.loadFromFile(texturePath);
+    if (!textureLoaded) {
+        LOG_ERROR("[RabbitManager] Failed to load texture: " << texturePath);
+    }
+    
     // 尝试加载字体
     std::vector<std::string> fontPaths = {
         "../../assets/fonts/NotoSansSC-Regular.ttf",
@@ -421,22 +364,25 @@ bool RabbitManager::init(const std::string& texturePath_) {
         }
     }
     
-    std::cout << "[RabbitManager] Initialized with texture: " << texturePath << std::endl;
+    LOG_INFO("[RabbitManager] Initialized with texture: " << texturePath);
     return true;
 }
 
 void RabbitManager::update(float dt, const sf::Vector2f& playerPos) {
-    // 移除死亡的兔子
-    rabbits.erase(
-        std::remove_if(rabbits.begin(), rabbits.end(),
-            [](const std::unique_ptr<Rabbit>& r) { return r->isDead(); }),
-        rabbits.end()
-    );
-    
-    // 更新所有兔子
+    // 更新存活的兔子（死亡的留到击杀事件处理完再移除）
     for (auto& rabbit : rabbits) {
-        rabbit->update(dt, playerPos);
+        if (!rabbit->isDead()) {
+            rabbit->update(dt, playerPos);
+        }
     }
+    
+    refreshQueryCenters();
+}
+
+void RabbitManager::removeDeadRabbits() {
+    size_t before = rabbits.size();
+    rabbits.removeIf([](const std::unique_ptr<Rabbit>& r) { return r->isDead(); });
+    if (rabbits.size() != before) queryCentersDirty = true;
 }
 
 void RabbitManager::render(sf::RenderWindow& window, const sf::View& view) {
@@ -463,15 +409,16 @@ void RabbitManager::render(sf::RenderWindow& window, const sf::View& view) {
 void RabbitManager::renderTooltips(sf::RenderWindow& window, const sf::Vector2f& mouseWorldPos) {
     updateHover(mouseWorldPos);
     
-    if (hoveredRabbit && fontLoaded) {
-        renderTooltip(window, hoveredRabbit);
+    Rabbit* hovered = getRabbit(hoveredRabbit);
+    if (hovered && fontLoaded) {
+        renderTooltip(window, hovered);
     }
 }
 
 void RabbitManager::renderTooltip(sf::RenderWindow& window, Rabbit* rabbit) {
     if (!rabbit || !fontLoaded) return;
     
-    sf::Vector2i mousePos = sf::Mouse::getPosition(window);
+    sf::Vector2i mousePos = InputSystem::getInstance().getMousePosition();
     float tooltipX = mousePos.x + 15.0f;
     float tooltipY = mousePos.y + 15.0f;
     
@@ -483,7 +430,7 @@ void RabbitManager::renderTooltip(sf::RenderWindow& window, Rabbit* rabbit) {
         bool isSkillIcon;
         sf::Color iconColor;
     };
-    std::vector<TooltipLine> lines;
+    FrameVector<TooltipLine> lines;
     
     // 标题
     lines.push_back({rabbit->getName(), sf::Color(255, 200, 100), true, false, sf::Color::White});
@@ -558,7 +505,7 @@ void RabbitManager::renderTooltip(sf::RenderWindow& window, Rabbit* rabbit) {
     background.setFillColor(sf::Color(20, 20, 30, 230));
     background.setOutlineThickness(2);
     background.setOutlineColor(sf::Color(80, 80, 100));
-    window.draw(background);
+    RenderStats::draw(window, background);
     
     // 绘制文字
     float y = tooltipY + padding;
@@ -579,7 +526,7 @@ void RabbitManager::renderTooltip(sf::RenderWindow& window, Rabbit* rabbit) {
             icon.setOutlineThickness(1);
             icon.setOutlineColor(sf::Color(255, 255, 255, 150));
             icon.setPosition(textX, y + 2);
-            window.draw(icon);
+            RenderStats::draw(window, icon);
             
             textX += 20;
         }
@@ -593,7 +540,7 @@ void RabbitManager::renderTooltip(sf::RenderWindow& window, Rabbit* rabbit) {
         if (line.bold) {
             text.setStyle(sf::Text::Bold);
         }
-        window.draw(text);
+        RenderStats::draw(window, text);
         
         y += lineHeight;
     }
@@ -601,39 +548,65 @@ void RabbitManager::renderTooltip(sf::RenderWindow& window, Rabbit* rabbit) {
 
 Rabbit* RabbitManager::addRabbit(float x, float y) {
     auto rabbit = std::make_unique<Rabbit>(x, y);
-    rabbit->loadTexture(texturePath);
+    if (textureLoaded) {            // 未 init 时（如基准测试）没有贴图
+        rabbit->setTexture(texture);
+    }
+    rabbit->setFlowField(flowField);
     Rabbit* ptr = rabbit.get();
-    rabbits.push_back(std::move(rabbit));
+    ptr->setHandle(rabbits.insert(std::move(rabbit)));
+    queryCentersDirty = true;
     return ptr;
 }
 
+Rabbit* RabbitManager::getRabbit(RabbitHandle handle) const {
+    const auto* slot = rabbits.get(handle);
+    return slot ? slot->get() : nullptr;
+}
+
+RabbitHandle RabbitManager::getHandle(const Rabbit* rabbit) const {
+    for (size_t i = 0; i < rabbits.size(); i++) {
+        if (rabbits[i].get() == rabbit) {
+            return rabbits.handleAt(i);
+        }
+    }
+    return RabbitHandle{};
+}
+
+void RabbitManager::setFlowField(const FlowField* field) {
+    flowField = field;
+    for (auto& rabbit : rabbits) {
+        rabbit->setFlowField(field);
+    }
+}
+
 void RabbitManager::removeRabbit(Rabbit* rabbit) {
-    rabbits.erase(
-        std::remove_if(rabbits.begin(), rabbits.end(),
-            [rabbit](const std::unique_ptr<Rabbit>& r) { return r.get() == rabbit; }),
-        rabbits.end()
-    );
+    rabbits.removeIf([rabbit](const std::unique_ptr<Rabbit>& r) { return r.get() == rabbit; });
+    queryCentersDirty = true;
+}
+
+void RabbitManager::removeRabbit(RabbitHandle handle) {
+    rabbits.remove(handle);
+    queryCentersDirty = true;
 }
 
 void RabbitManager::clearAllRabbits() {
     rabbits.clear();
-    hoveredRabbit = nullptr;
+    queryCentersDirty = true;
 }
 
 void RabbitManager::spawnRandomRabbits(int count, const sf::Vector2i& mapSize, int tileSize) {
     (void)tileSize;
     
-    std::uniform_int_distribution<int> xDist(100, mapSize.x - 100);
-    std::uniform_int_distribution<int> yDist(100, mapSize.y - 100);
+    Rng& rng = RandomService::getInstance().stream(RngStream::MonsterSpawn);
     
     for (int i = 0; i < count; i++) {
-        float x = static_cast<float>(xDist(rng));
-        float y = static_cast<float>(yDist(rng));
+        float x = static_cast<float>(rng.range(100, mapSize.x - 100));
+        float y = static_cast<float>(rng.range(100, mapSize.y - 100));
         addRabbit(x, y);
     }
     
-    std::cout << "[RabbitManager] Spawned " << count << " rabbits in area " 
-              << mapSize.x << "x" << mapSize.y << std::endl;
+    LOG_INFO("[RabbitManager] Spawned " << count << " rabbits in area " 
+          << mapSize.x << "x" << mapSize.y);
 }
 
 Rabbit* RabbitManager::getRabbitAt(const sf::Vector2f& position) {
@@ -654,61 +627,77 @@ Rabbit* RabbitManager::getRabbitInRect(const sf::FloatRect& rect) {
     return nullptr;
 }
 
-std::vector<Rabbit*> RabbitManager::damageRabbitsInRange(const sf::Vector2f& center,
+FrameVector<Rabbit*> RabbitManager::damageRabbitsInRange(const sf::Vector2f& center,
                                                          float radius, float damage,
-                                                         bool ignoreDefense) {
-    std::vector<Rabbit*> hitRabbits;
+                                                         bool ignoreDefense, KillSource source) {
+    FrameVector<Rabbit*> hitRabbits;
     
-    for (auto& rabbit : rabbits) {
-        sf::Vector2f rabbitCenter = rabbit->getPosition() + 
-                                    sf::Vector2f(rabbit->getSize().x, rabbit->getSize().y);
-        
-        float dist = std::sqrt(
-            std::pow(center.x - rabbitCenter.x, 2) +
-            std::pow(center.y - rabbitCenter.y, 2)
-        );
-        
-        if (dist <= radius) {
-            rabbit->takeDamage(damage, ignoreDefense);
-            hitRabbits.push_back(rabbit.get());
+    ensureQueryCenters();
+    size_t hitCount = CollisionSystem::circleMask(queryCenters, center, radius, queryMask);
+    if (hitCount == 0) {
+        return hitRabbits;
+    }
+    hitRabbits.reserve(hitCount);
+    
+    for (size_t i = 0; i < rabbits.size(); i++) {
+        if (queryMask[i] && !rabbits[i]->isDead()) {
+            // 只在这一击致死时压入击杀事件（同帧再被击中的尸体不重复结算）
+            if (rabbits[i]->takeDamage(damage, ignoreDefense)) {
+                EventBus::getInstance().push(RabbitKilledEvent{rabbits.handleAt(i), source});
+            }
+            hitRabbits.push_back(rabbits[i].get());
         }
     }
     
     return hitRabbits;
 }
 
-std::vector<Rabbit*> RabbitManager::getAttackingRabbitsInRange(const sf::Vector2f& center, float radius) {
-    std::vector<Rabbit*> attackingRabbits;
+FrameVector<Rabbit*> RabbitManager::getAttackingRabbitsInRange(const sf::Vector2f& center, float radius) {
+    FrameVector<Rabbit*> attackingRabbits;
     
-    for (auto& rabbit : rabbits) {
-        if (!rabbit->isAttacking()) continue;
-        
-        sf::Vector2f rabbitCenter = rabbit->getPosition() + 
-                                    sf::Vector2f(rabbit->getSize().x, rabbit->getSize().y);
-        
-        float dist = std::sqrt(
-            std::pow(center.x - rabbitCenter.x, 2) +
-            std::pow(center.y - rabbitCenter.y, 2)
-        );
-        
-        if (dist <= radius) {
-            attackingRabbits.push_back(rabbit.get());
+    ensureQueryCenters();
+    size_t inRange = CollisionSystem::circleMask(queryCenters, center, radius, queryMask);
+    if (inRange == 0) {
+        return attackingRabbits;
+    }
+    attackingRabbits.reserve(inRange);
+    
+    for (size_t i = 0; i < rabbits.size(); i++) {
+        if (queryMask[i] && !rabbits[i]->isDead() && rabbits[i]->isAttacking()) {
+            attackingRabbits.push_back(rabbits[i].get());
         }
     }
     
     return attackingRabbits;
 }
 
+// 兔子中心（精灵 2 倍缩放，中心在 position + size）收集成 SoA，供批量圆形测试
+void RabbitManager::refreshQueryCenters() {
+    queryCenters.clear();
+    queryCenters.reserve(rabbits.size());
+    for (const auto& rabbit : rabbits) {
+        queryCenters.add(rabbit->getPosition() + rabbit->getSize());
+    }
+    queryCentersDirty = false;
+}
+
+// 查询直接用本帧已收集的中心；只有增删或管理器内推挤之后才补收集
+void RabbitManager::ensureQueryCenters() {
+    if (queryCentersDirty || queryCenters.size() != rabbits.size()) {
+        refreshQueryCenters();
+    }
+}
+
 void RabbitManager::updateHover(const sf::Vector2f& mouseWorldPos) {
-    if (hoveredRabbit) {
-        hoveredRabbit->setHovered(false);
-        hoveredRabbit = nullptr;
+    if (Rabbit* hovered = getRabbit(hoveredRabbit)) {
+        hovered->setHovered(false);
     }
+    hoveredRabbit = RabbitHandle{};
     
-    for (auto& rabbit : rabbits) {
-        if (rabbit->containsPoint(mouseWorldPos)) {
-            hoveredRabbit = rabbit.get();
-            hoveredRabbit->setHovered(true);
+    for (size_t i = 0; i < rabbits.size(); i++) {
+        if (rabbits[i]->containsPoint(mouseWorldPos)) {
+            hoveredRabbit = rabbits.handleAt(i);
+            rabbits[i]->setHovered(true);
             break;
         }
     }
@@ -723,8 +712,8 @@ bool RabbitManager::isCollidingWithAnyRabbit(const sf::FloatRect& rect) const {
     return false;
 }
 
-std::vector<Rabbit*> RabbitManager::pushRabbitsFromRect(const sf::FloatRect& moverBox, float pushStrength) {
-    std::vector<Rabbit*> pushedRabbits;
+FrameVector<Rabbit*> RabbitManager::pushRabbitsFromRect(const sf::FloatRect& moverBox, float pushStrength) {
+    FrameVector<Rabbit*> pushedRabbits;
     
     for (auto& rabbit : rabbits) {
         sf::FloatRect rabbitBox = rabbit->getCollisionBox();
@@ -758,6 +747,7 @@ std::vector<Rabbit*> RabbitManager::pushRabbitsFromRect(const sf::FloatRect& mov
             
             sf::Vector2f pushVector = pushDir * pushDistance * pushStrength;
             rabbit->applyPush(pushVector);
+            queryCentersDirty = true;
             
             pushedRabbits.push_back(rabbit.get());
         }
@@ -766,8 +756,8 @@ std::vector<Rabbit*> RabbitManager::pushRabbitsFromRect(const sf::FloatRect& mov
     return pushedRabbits;
 }
 
-std::vector<Rabbit*> RabbitManager::getRabbitsCollidingWith(const sf::FloatRect& rect) const {
-    std::vector<Rabbit*> result;
+FrameVector<Rabbit*> RabbitManager::getRabbitsCollidingWith(const sf::FloatRect& rect) const {
+    FrameVector<Rabbit*> result;
     for (const auto& rabbit : rabbits) {
         if (rabbit->getCollisionBox().intersects(rect)) {
             result.push_back(rabbit.get());
@@ -776,8 +766,8 @@ std::vector<Rabbit*> RabbitManager::getRabbitsCollidingWith(const sf::FloatRect&
     return result;
 }
 
-std::vector<Rabbit*> RabbitManager::getMovingRabbitsCollidingWith(const sf::FloatRect& rect) const {
-    std::vector<Rabbit*> result;
+FrameVector<Rabbit*> RabbitManager::getMovingRabbitsCollidingWith(const sf::FloatRect& rect) const {
+    FrameVector<Rabbit*> result;
     for (const auto& rabbit : rabbits) {
         if (rabbit->isMoving() && rabbit->getCollisionBox().intersects(rect)) {
             result.push_back(rabbit.get());
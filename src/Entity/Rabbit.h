@@ -1,10 +1,12 @@
 #pragma once
 #include "Monster.h"
+#include "../Systems/CollisionSystem.h"
+#include "../Systems/EventBus.h"
+#include "../Systems/SlotMap.h"
+#include "../Systems/FrameArena.h"
 #include <SFML/Graphics.hpp>
 #include <string>
 #include <vector>
-#include <functional>
-#include <random>
 #include <memory>
 
 // ============================================================================
@@ -16,6 +18,7 @@
 //   - AI：被攻击后会在一定范围内追击玩家（类似饥荒）
 //   - 掉落：兔毛、胡萝卜、兔肉
 //   - 碰撞：有碰撞体积
+//   - 数据：属性范围、掉落、技能、AI参数来自 MonsterSpeciesRegistry::RABBIT
 // ============================================================================
 
 // 兔子动画状态
@@ -30,39 +33,17 @@ enum class RabbitAnimState {
     AttackRight
 };
 
-// 兔子掉落物品（为了向后兼容保留）
-struct RabbitDrop {
-    std::string itemId;
-    std::string name;
-    int minCount;
-    int maxCount;
-    float dropChance;  // 0-1
-    
-    RabbitDrop(const std::string& id = "", const std::string& n = "",
-               int min = 1, int max = 1, float chance = 1.0f)
-        : itemId(id), name(n), minCount(min), maxCount(max), dropChance(chance) {}
-};
-
-// 兔子技能（为了向后兼容保留）
-struct RabbitSkill {
-    std::string id;
-    std::string name;
-    std::string description;
-    float damageMultiplier;  // 伤害倍率
-    float triggerChance;     // 触发概率 0-1
-    sf::Color iconColor;     // 技能图标颜色
-    
-    RabbitSkill(const std::string& skillId = "", const std::string& n = "",
-                const std::string& desc = "", float mult = 1.0f, 
-                float chance = 0.0f, sf::Color color = sf::Color::White)
-        : id(skillId), name(n), description(desc), 
-          damageMultiplier(mult), triggerChance(chance), iconColor(color) {}
-};
-
-// 为了向后兼容保留这些枚举别名
+// 为了向后兼容保留这些别名（掉落和技能数据在物种配置里）
+using RabbitDrop = MonsterDrop;
+using RabbitSkill = MonsterSkill;
 using RabbitAIState = MonsterAIState;
 using RabbitDirection = MonsterDirection;
 
+class Rabbit;
+
+// 跨帧保存兔子用句柄（兔子被删除后查找返回 nullptr）
+using RabbitHandle = Handle<Rabbit>;
+
 // ============================================================================
 // 兔子类（继承自Monster）
 // ============================================================================
@@ -76,14 +57,12 @@ public:
     // ========================================
     void update(float dt, const sf::Vector2f& playerPos) override;
     void render(sf::RenderWindow& window) override;
-    std::string getName() const override { return "兔子"; }
-    std::string getTypeName() const override { return "兔子"; }
     
     // ========================================
     // 初始化
     // ========================================
     void init(float x, float y) override;
-    bool loadTexture(const std::string& texturePath) override;
+    void setTexture(const sf::Texture& texture) override;
     void randomizeStats() override;
     
     // ========================================
@@ -96,31 +75,23 @@ public:
     // ========================================
     
     // 获取兔子技能信息
-    const RabbitSkill& getRabbitSkill() const { return rabbitSkill; }
+    const RabbitSkill& getRabbitSkill() const { return getSkill(); }
     
     // 获取兔子掉落
-    const std::vector<RabbitDrop>& getRabbitDrops() const { return rabbitDrops; }
+    const std::vector<RabbitDrop>& getRabbitDrops() const { return getDrops(); }
     
-    // 回调（使用父类类型但保留别名）
-    using RabbitCallback = std::function<void(Rabbit&)>;
-    void setOnDeathRabbit(RabbitCallback cb) { onDeathRabbit = cb; }
-    void setOnAttackRabbit(RabbitCallback cb) { onAttackRabbit = cb; }
+    // 攻击玩家时压入 RabbitAttackEvent（句柄由 RabbitManager 添加时设置）
+    void setHandle(RabbitHandle h) { handle = h; }
+    RabbitHandle getHandle() const { return handle; }
 
 private:
     void updateAnimation(float dt);
     void updateAI(float dt, const sf::Vector2f& playerPos);
     void setAnimState(RabbitAnimState state);
     void updateSprite() override;
-    sf::IntRect getFrameRect(int row, int col) const;
     void updateDirectionFromVelocityRabbit();
     
 private:
-    // === 兔子特有掉落 ===
-    std::vector<RabbitDrop> rabbitDrops;
-    
-    // === 兔子特有技能 ===
-    RabbitSkill rabbitSkill;
-    
     // === 游荡计时 ===
     float wanderTimer;
     float wanderDuration;
@@ -131,38 +102,14 @@ private:
     RabbitAnimState lastAnimState;
     int currentFrame;
     float animTimer;
-    float frameTime;
     bool animationLocked;
     float animLockTimer;
     
-    // 精灵表参数（128x256，每帧32x32，每行4帧，共8行）
-    static constexpr int FRAME_WIDTH = 32;
-    static constexpr int FRAME_HEIGHT = 32;
-    static constexpr int FRAMES_PER_ROW = 4;
-    
-    // 行定义（精灵表布局）
-    static constexpr int ROW_MOVE_DOWN = 0;
-    static constexpr int ROW_MOVE_UP = 1;
-    static constexpr int ROW_MOVE_LEFT = 2;
-    static constexpr int ROW_MOVE_RIGHT = 3;
-    static constexpr int ROW_ATTACK_DOWN = 4;
-    static constexpr int ROW_ATTACK_UP = 5;
-    static constexpr int ROW_ATTACK_LEFT = 6;
-    static constexpr int ROW_ATTACK_RIGHT = 7;
-    
-    // === 兔子特有回调 ===
-    RabbitCallback onDeathRabbit;
-    RabbitCallback onAttackRabbit;
-    
-    // === 常量（覆盖父类默认值）===
-    static constexpr float RABBIT_MOVE_SPEED = 40.0f;
-    static constexpr float RABBIT_CHASE_SPEED = 70.0f;
-    static constexpr float RABBIT_RETURN_SPEED = 50.0f;
-    static constexpr float RABBIT_AGGRO_DURATION = 8.0f;
-    static constexpr float RABBIT_ATTACK_RANGE = 35.0f;
-    static constexpr float RABBIT_ATTACK_COOLDOWN = 1.2f;
-    static constexpr float RABBIT_CHASE_RANGE = 200.0f;
-    static constexpr float RABBIT_LEASH_RANGE = 300.0f;
+    // === 事件 ===
+    RabbitHandle handle;
+    
+    // === 常量 ===
+    static constexpr float FLOW_FIELD_MIN_DISTANCE = 48.0f;     // 约一个图块内直线追击
     static constexpr float MIN_ANIM_DURATION = 0.2f;
 };
 
@@ -174,7 +121,7 @@ class RabbitManager {
 public:
     RabbitManager();
     
-    // 初始化
+    // 初始化（加载所有兔子共享的贴图）
     bool init(const std::string& texturePath);
     
     // 更新所有兔子
@@ -191,8 +138,16 @@ public:
     // ========================================
     Rabbit* addRabbit(float x, float y);
     void removeRabbit(Rabbit* rabbit);
+    void removeRabbit(RabbitHandle handle);
     void clearAllRabbits();
     
+    // 句柄查找（失效时返回 nullptr）和指针换句柄（线性查找，未找到返回空句柄）
+    Rabbit* getRabbit(RabbitHandle handle) const;
+    RabbitHandle getHandle(const Rabbit* rabbit) const;
+    
+    // 追击用的共享流场（应用到现有和之后新增的兔子）
+    void setFlowField(const FlowField* field);
+    
     // 在地图上随机生成兔子
     void spawnRandomRabbits(int count, const sf::Vector2i& mapSize, int tileSize);
     
@@ -206,36 +161,44 @@ public:
     // 获取与矩形碰撞的兔子
     Rabbit* getRabbitInRect(const sf::FloatRect& rect);
     
-    // 对范围内的兔子造成伤害
-    std::vector<Rabbit*> damageRabbitsInRange(const sf::Vector2f& center,
+    // 对范围内存活的兔子造成伤害；被击杀的压入 RabbitKilledEvent（奖励在事件处理时结算）
+    FrameVector<Rabbit*> damageRabbitsInRange(const sf::Vector2f& center,
                                               float radius, float damage,
-                                              bool ignoreDefense = false);
+                                              bool ignoreDefense = false,
+                                              KillSource source = KillSource::Player);
+    
+    // 移除死亡的兔子（击杀事件处理之后调用，保证处理时句柄仍有效）
+    void removeDeadRabbits();
     
     // 获取范围内正在攻击的兔子（用于检测玩家是否被攻击）
-    std::vector<Rabbit*> getAttackingRabbitsInRange(const sf::Vector2f& center, float radius);
+    FrameVector<Rabbit*> getAttackingRabbitsInRange(const sf::Vector2f& center, float radius);
     
     // 更新悬浮状态
     void updateHover(const sf::Vector2f& mouseWorldPos);
     
+    // 重新收集范围查询用的兔子中心（update 末尾自动调用；
+    // 外部推挤解算移动兔子之后再调用一次，本帧后续查询直接复用）
+    void refreshQueryCenters();
+    
     // ========================================
     // 碰撞检测
     // ========================================
     bool isCollidingWithAnyRabbit(const sf::FloatRect& rect) const;
     
     // 碰撞推挤：当玩家主动移动碰到兔子时，推开兔子
-    std::vector<Rabbit*> pushRabbitsFromRect(const sf::FloatRect& moverBox, float pushStrength = 1.0f);
+    FrameVector<Rabbit*> pushRabbitsFromRect(const sf::FloatRect& moverBox, float pushStrength = 1.0f);
     
     // 获取与矩形碰撞的所有兔子
-    std::vector<Rabbit*> getRabbitsCollidingWith(const sf::FloatRect& rect) const;
+    FrameVector<Rabbit*> getRabbitsCollidingWith(const sf::FloatRect& rect) const;
     
     // 获取正在移动的兔子中碰撞到指定矩形的（用于判断兔子是否主动撞玩家）
-    std::vector<Rabbit*> getMovingRabbitsCollidingWith(const sf::FloatRect& rect) const;
+    FrameVector<Rabbit*> getMovingRabbitsCollidingWith(const sf::FloatRect& rect) const;
     
     // ========================================
     // 获取器
     // ========================================
     size_t getRabbitCount() const { return rabbits.size(); }
-    const std::vector<std::unique_ptr<Rabbit>>& getRabbits() const { return rabbits; }
+    const std::vector<std::unique_ptr<Rabbit>>& getRabbits() const { return rabbits.values(); }
     
     // ========================================
     // 字体设置
@@ -244,18 +207,26 @@ public:
 
 private:
     void renderTooltip(sf::RenderWindow& window, Rabbit* rabbit);
+    void ensureQueryCenters();
     
 private:
-    std::vector<std::unique_ptr<Rabbit>> rabbits;
+    SlotMap<std::unique_ptr<Rabbit>, Rabbit> rabbits;
     std::string texturePath;
     
+    // 共享贴图（所有兔子的精灵都引用它）
+    sf::Texture texture;
+    bool textureLoaded;
+    const FlowField* flowField = nullptr;
+    
+    // 范围查询用的 SoA 缓冲（每帧移动后收集一次，查询之间共用）
+    CollisionSystem::PointBatch queryCenters;
+    std::vector<std::uint8_t> queryMask;
+    bool queryCentersDirty = true;      // 增删兔子、管理器内推挤后置位
+    
     // 字体
     sf::Font font;
     bool fontLoaded;
     
     // 当前悬浮的兔子
-    Rabbit* hoveredRabbit;
-    
-    // 随机数生成器
-    std::mt19937 rng;
+    RabbitHandle hoveredRabbit;
 };
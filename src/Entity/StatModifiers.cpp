@@ -0,0 +1,75 @@
+#include "StatModifiers.h"
+#include <algorithm>
+
+StatModifierStack::StatModifierStack(PlayerStats* target)
+    : target(target) {
+}
+
+void StatModifierStack::setTarget(PlayerStats* stats) {
+    target = stats;
+    recompute();
+}
+
+void StatModifierStack::setSource(ModifierSource source, const StatModifier& modifier) {
+    sources[static_cast<size_t>(source)] = modifier;
+    recompute();
+}
+
+void StatModifierStack::addBuff(const std::string& id, const StatModifier& modifier, float duration) {
+    auto it = std::find_if(buffs.begin(), buffs.end(),
+                           [&id](const TimedBuff& buff) { return buff.id == id; });
+    if (it != buffs.end()) {
+        it->modifier = modifier;
+        it->remaining = duration;
+    } else {
+        buffs.push_back({id, modifier, duration});
+    }
+    recompute();
+}
+
+void StatModifierStack::clearBuffs() {
+    if (buffs.empty()) return;
+    buffs.clear();
+    recompute();
+}
+
+bool StatModifierStack::hasBuff(const std::string& id) const {
+    return std::any_of(buffs.begin(), buffs.end(),
+                       [&id](const TimedBuff& buff) { return buff.id == id; });
+}
+
+void StatModifierStack::update(float dt) {
+    if (buffs.empty()) return;
+
+    bool expired = false;
+    for (auto& buff : buffs) {
+        buff.remaining -= dt;
+        if (buff.remaining <= 0) expired = true;
+    }
+
+    if (expired) {
+        buffs.erase(std::remove_if(buffs.begin(), buffs.end(),
+                                   [](const TimedBuff& buff) { return buff.remaining <= 0; }),
+                    buffs.end());
+        recompute();
+    }
+}
+
+void StatModifierStack::recompute() {
+    total = StatModifier();
+    for (const auto& modifier : sources) {
+        total += modifier;
+    }
+    for (const auto& buff : buffs) {
+        total += buff.modifier;
+    }
+
+    if (!target) return;
+
+    float flatAttack = total.attack;
+    float percentAttack = (target->getBaseAttack() + flatAttack) * total.attackPercent;
+    target->setBonusAttack(flatAttack + percentAttack);
+    target->setBonusDefense(total.defense);
+    target->setBonusSpeed(total.speed);
+    target->setBonusDodge(total.dodge);
+}
@@ -0,0 +1,83 @@
+#pragma once
+#include "PlayerStats.h"
+#include <array>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// 属性加成栈 (Stat Modifier Stack)
+//
+// 装备、宠物、限时 Buff 各自提供一份加成，汇总后写入 PlayerStats 的
+// bonus 字段。只有加成来源变化（穿脱装备、切换宠物、Buff 添加/过期）
+// 时才重新汇总，战斗中读取攻击力等属性不再需要遍历装备栏。
+//
+// 使用方式：
+//   statModifiers.setSource(ModifierSource::Equipment, modifierFromEquipment);
+//   statModifiers.addBuff("buff_attack", modifier, 60.0f);
+//   statModifiers.update(dt);               // 每帧推进 Buff 计时
+//   player.getStats().getAttack();          // 直接读取最终值
+// ============================================================================
+
+// 一份属性加成
+struct StatModifier {
+    float attack = 0;
+    float defense = 0;
+    float speed = 0;
+    float dodge = 0;
+    float attackPercent = 0;    // 攻击力百分比加成（0.03 = 3%，作用于基础+固定加成）
+
+    StatModifier& operator+=(const StatModifier& other) {
+        attack += other.attack;
+        defense += other.defense;
+        speed += other.speed;
+        dodge += other.dodge;
+        attackPercent += other.attackPercent;
+        return *this;
+    }
+};
+
+// 常驻加成来源（整体替换）
+enum class ModifierSource {
+    Equipment,      // 装备
+    Pet,            // 出战宠物
+    Count
+};
+
+class StatModifierStack {
+public:
+    explicit StatModifierStack(PlayerStats* target = nullptr);
+
+    // 设置写入目标（立即重新汇总）
+    void setTarget(PlayerStats* stats);
+
+    // 替换某个常驻来源的加成
+    void setSource(ModifierSource source, const StatModifier& modifier);
+
+    // 限时 Buff：同 id 的 Buff 刷新数值和持续时间
+    void addBuff(const std::string& id, const StatModifier& modifier, float duration);
+    void clearBuffs();
+    bool hasBuff(const std::string& id) const;
+
+    // 推进 Buff 计时，有 Buff 过期时才重新汇总
+    void update(float dt);
+
+    // 基础属性变化（如升级）后重新计算百分比加成
+    void refresh() { recompute(); }
+
+    const StatModifier& getTotal() const { return total; }
+
+private:
+    struct TimedBuff {
+        std::string id;
+        StatModifier modifier;
+        float remaining;
+    };
+
+    void recompute();
+
+private:
+    PlayerStats* target;
+    std::array<StatModifier, static_cast<size_t>(ModifierSource::Count)> sources;
+    std::vector<TimedBuff> buffs;
+    StatModifier total;
+};
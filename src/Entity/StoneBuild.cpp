@@ -1,7 +1,9 @@
 #include "StoneBuild.h"
 #include "../World/TileMap.h"
-#include <iostream>
-#include <cstdlib>
+#include "../Systems/Random.h"
+#include "../Systems/InputSystem.h"
+#include "../Systems/Logger.h"
+#include "../Systems/RenderStats.h"
 #include <cmath>
 #include <algorithm>
 #include <sstream>
@@ -9,108 +11,57 @@
 #define U8(str) (const char*)u8##str
 
 // ============================================================================
-// StoneBuild 构造函数
+// 石头原型
 // ============================================================================
 
-StoneBuild::StoneBuild()
-    : stoneType("stone_build")
-    , name("石头")
-    , health(30.0f)
-    , maxHealth(30.0f)
-    , defense(5.0f)
-    , position(0, 0)
-    , size(32, 32)
-    , textureLoaded(false)
-    , expMin(5)
-    , expMax(12)
-    , goldMin(10)
-    , goldMax(30)
-    , dropMax(3)
-    , isHovered(false)
-    , shakeTimer(0.0f)
-    , shakeIntensity(0.0f)
-    , onDestroyed(nullptr)
-{
-    // 默认掉落物品
-    dropItems.push_back(StoneDropItem("stone", "石头", 1, 3, 0.75f));
-}
-
-StoneBuild::StoneBuild(float x, float y, const std::string& type)
-    : StoneBuild()
-{
-    init(x, y, type);
-}
-
-void StoneBuild::init(float x, float y, const std::string& type) {
-    position = sf::Vector2f(x, y);
-    stoneType = type;
+std::unique_ptr<StoneArchetype> StoneArchetype::fromType(const std::string& type) {
+    auto archetype = std::make_unique<StoneArchetype>();
+    archetype->stoneType = type;
+    archetype->name = "石头";
     
     // 根据类型设置属性
-    if (type == "stone_build" || type == "stone_build2") {
-        name = "石头";
-        maxHealth = 30.0f;
-        defense = 5.0f;
-        size = sf::Vector2f(32, 32);
-    } else if (type == "ore_stone") {
-        name = "矿石";
-        maxHealth = 50.0f;
-        defense = 10.0f;
-        size = sf::Vector2f(32, 32);
-        dropItems.clear();
-        dropItems.push_back(StoneDropItem("ore", "矿石", 1, 2, 0.8f));
-        dropItems.push_back(StoneDropItem("stone", "石头", 1, 2, 0.5f));
+    if (type == "ore_stone") {
+        archetype->name = "矿石";
+        archetype->maxHealth = 50.0f;
+        archetype->defense = 10.0f;
+        archetype->dropItems.push_back(StoneDropItem("ore", "矿石", 1, 2, 0.8f));
+        archetype->dropItems.push_back(StoneDropItem("stone", "石头", 1, 2, 0.5f));
+    } else {
+        // stone_build, stone_build2 等普通石头：默认掉落
+        archetype->dropItems.push_back(StoneDropItem("stone", "石头", 1, 3, 0.75f));
     }
     
-    health = maxHealth;
-    updateSprite();
+    return archetype;
 }
 
-// ============================================================================
-// 从 TileProperty 动态初始化（推荐使用）
-// ============================================================================
-
-void StoneBuild::initFromTileProperty(float x, float y, const TileProperty* prop) {
-    position = sf::Vector2f(x, y);
-    
-    if (!prop) {
-        stoneType = "stone_build";
-        name = "石头";
-        maxHealth = 30.0f;
-        defense = 5.0f;
-        size = sf::Vector2f(32, 32);
-        health = maxHealth;
-        updateSprite();
-        return;
-    }
+std::unique_ptr<StoneArchetype> StoneArchetype::fromTileProperty(const TileProperty& prop) {
+    auto archetype = std::make_unique<StoneArchetype>();
+    archetype->source = &prop;
     
     // 从 TileProperty 设置属性
-    stoneType = prop->name;
-    name = prop->name;
+    archetype->stoneType = prop.name;
+    archetype->name = prop.name;
     
     // 设置中文名
-    if (prop->name.find("stone") != std::string::npos) {
-        name = "石头";
+    if (prop.name.find("stone") != std::string::npos) {
+        archetype->name = "石头";
     }
     
-    maxHealth = (float)prop->hp;
-    defense = (float)prop->defense;
-    size = sf::Vector2f(32, 32);  // 默认尺寸
+    archetype->maxHealth = (float)prop.hp;
+    archetype->defense = (float)prop.defense;
     
     // 解析经验和金币奖励
-    expMin = prop->expMin > 0 ? prop->expMin : 5;
-    expMax = prop->expMax > 0 ? prop->expMax : 12;
-    goldMin = prop->goldMin > 0 ? prop->goldMin : 10;
-    goldMax = prop->goldMax > 0 ? prop->goldMax : 30;
-    dropMax = prop->dropMax > 0 ? prop->dropMax : 3;
+    archetype->expMin = prop.expMin > 0 ? prop.expMin : 5;
+    archetype->expMax = prop.expMax > 0 ? prop.expMax : 12;
+    archetype->goldMin = prop.goldMin > 0 ? prop.goldMin : 10;
+    archetype->goldMax = prop.goldMax > 0 ? prop.goldMax : 30;
+    archetype->dropMax = prop.dropMax > 0 ? prop.dropMax : 3;
     
-    // 清空并设置掉落物品
-    dropItems.clear();
-    
-    if (!prop->dropTypes.empty()) {
+    if (!prop.dropTypes.empty()) {
         // 使用 TSX 配置的掉落
-        for (size_t i = 0; i < prop->dropTypes.size(); i++) {
-            std::string itemId = prop->dropTypes[i];
-            float prob = (i < prop->dropProbabilities.size()) ? prop->dropProbabilities[i] : 0.5f;
+        for (size_t i = 0; i < prop.dropTypes.size(); i++) {
+            std::string itemId = prop.dropTypes[i];
+            float prob = (i < prop.dropProbabilities.size()) ? prop.dropProbabilities[i] : 0.5f;
             
             // 移除引号
             if (itemId.size() >= 2 && itemId.front() == '"' && itemId.back() == '"') {
@@ -124,39 +75,35 @@ void StoneBuild::initFromTileProperty(float x, float y, const TileProperty* prop
             else if (itemId == "iron_ore") itemName = "铁矿";
             else if (itemId == "coal") itemName = "�ite煤炭";
             
-            dropItems.push_back(StoneDropItem(itemId, itemName, 1, dropMax, prob));
+            archetype->dropItems.push_back(StoneDropItem(itemId, itemName, 1, archetype->dropMax, prob));
         }
     } else {
         // 默认掉落
-        dropItems.push_back(StoneDropItem("stone", "石头", 1, 3, 0.75f));
+        archetype->dropItems.push_back(StoneDropItem("stone", "石头", 1, 3, 0.75f));
     }
     
-    health = maxHealth;
-    updateSprite();
-}
-
-void StoneBuild::setTextureFromProperty(const TileProperty* prop) {
-    if (!prop || !prop->hasTexture || !prop->texture) {
-        return;
+    // 贴图与地图共享，不复制
+    if (prop.hasTexture && prop.texture) {
+        archetype->texture = prop.texture;
+        LOG_INFO("[StoneBuild] Loaded texture: " << prop.name);
     }
     
-    texture = *prop->texture;
-    sprite.setTexture(texture);
-    textureLoaded = true;
-    std::cout << "[StoneBuild] Loaded texture: " << prop->name << std::endl;
-    updateSprite();
+    return archetype;
 }
 
-bool StoneBuild::loadTexture(const std::string& texturePath) {
-    if (!texture.loadFromFile(texturePath)) {
-        std::cerr << "StoneBuild: 无法加载贴图 " << texturePath << std::endl;
-        textureLoaded = false;
-        return false;
-    }
-    sprite.setTexture(texture);
-    textureLoaded = true;
-    updateSprite();
-    return true;
+// ============================================================================
+// StoneBuild 构造函数
+// ============================================================================
+
+StoneBuild::StoneBuild(const StoneArchetype& archetype, float x, float y)
+    : archetype(&archetype)
+    , position(x, y)
+    , size(archetype.defaultSize)
+    , health(archetype.maxHealth)
+    , isHovered(false)
+    , shakeTimer(0.0f)
+    , shakeIntensity(0.0f)
+{
 }
 
 // ============================================================================
@@ -187,9 +134,14 @@ void StoneBuild::render(sf::RenderWindow& window) {
         renderPos.x += offset;
     }
     
-    if (textureLoaded) {
+    const sf::Texture* texture = archetype->texture.get();
+    if (texture && texture->getSize().x > 0 && texture->getSize().y > 0) {
+        // 精灵在绘制时现建：贴图属于原型，实例不保存 sf::Sprite
+        sf::Sprite sprite(*texture);
+        sf::Vector2u texSize = texture->getSize();
+        sprite.setScale(size.x / texSize.x, size.y / texSize.y);
         sprite.setPosition(renderPos.x, renderPos.y - size.y);
-        window.draw(sprite);
+        RenderStats::draw(window, sprite);
     } else {
         // 没有贴图时画一个灰色块
         sf::RectangleShape placeholder(size);
@@ -202,10 +154,11 @@ void StoneBuild::render(sf::RenderWindow& window) {
             placeholder.setOutlineColor(sf::Color::Yellow);
         }
         
-        window.draw(placeholder);
+        RenderStats::draw(window, placeholder);
     }
     
     // 显示血条（受损时）
+    const float maxHealth = archetype->maxHealth;
     if (health < maxHealth && health > 0) {
         float barWidth = size.x * 0.8f;
         float barHeight = 4.0f;
@@ -216,28 +169,14 @@ void StoneBuild::render(sf::RenderWindow& window) {
         sf::RectangleShape bgBar(sf::Vector2f(barWidth, barHeight));
         bgBar.setPosition(barX, barY);
         bgBar.setFillColor(sf::Color(50, 50, 50));
-        window.draw(bgBar);
+        RenderStats::draw(window, bgBar);
         
         // 血条
         float healthRatio = health / maxHealth;
         sf::RectangleShape hpBar(sf::Vector2f(barWidth * healthRatio, barHeight));
         hpBar.setPosition(barX, barY);
         hpBar.setFillColor(sf::Color(100, 180, 100));
-        window.draw(hpBar);
-    }
-}
-
-void StoneBuild::updateSprite() {
-    if (!textureLoaded) return;
-    
-    sprite.setPosition(position.x, position.y - size.y);
-    
-    // 根据贴图大小调整缩放
-    sf::Vector2u texSize = texture.getSize();
-    if (texSize.x > 0 && texSize.y > 0) {
-        float scaleX = size.x / texSize.x;
-        float scaleY = size.y / texSize.y;
-        sprite.setScale(scaleX, scaleY);
+        RenderStats::draw(window, hpBar);
     }
 }
 
@@ -246,20 +185,17 @@ void StoneBuild::updateSprite() {
 // ============================================================================
 
 bool StoneBuild::takeDamage(float damage) {
-    float actualDamage = std::max(1.0f, damage - defense);
+    float actualDamage = std::max(1.0f, damage - archetype->defense);
     health -= actualDamage;
     
     // 触发震动
     shakeTimer = 0.3f;
     shakeIntensity = 3.0f;
     
-    std::cout << name << " 受到 " << actualDamage << " 点伤害，剩余 " << health << "/" << maxHealth << std::endl;
+    LOG_INFO(archetype->name << " 受到 " << actualDamage << " 点伤害，剩余 " << health << "/" << archetype->maxHealth);
     
     if (health <= 0) {
         health = 0;
-        if (onDestroyed) {
-            onDestroyed(*this);
-        }
         return true;  // 被摧毁
     }
     return false;
@@ -293,21 +229,16 @@ sf::FloatRect StoneBuild::getCollisionBox() const {
 // 掉落物品
 // ============================================================================
 
-void StoneBuild::addDropItem(const StoneDropItem& item) {
-    dropItems.push_back(item);
-}
-
-void StoneBuild::clearDropItems() {
-    dropItems.clear();
-}
-
-std::vector<std::pair<std::string, int>> StoneBuild::generateDrops() {
-    std::vector<std::pair<std::string, int>> drops;
+FrameVector<std::pair<std::string, int>> StoneBuild::generateDrops() {
+    const std::vector<StoneDropItem>& dropItems = archetype->dropItems;
+    FrameVector<std::pair<std::string, int>> drops;
+    drops.reserve(dropItems.size());
+    Rng& rng = RandomService::getInstance().stream(RngStream::Stone);
     
     for (const auto& item : dropItems) {
-        float roll = static_cast<float>(rand()) / RAND_MAX;
+        float roll = rng.nextFloat();
         if (roll <= item.dropChance) {
-            int count = item.minCount + rand() % (item.maxCount - item.minCount + 1);
+            int count = rng.range(item.minCount, item.maxCount);
             if (count > 0) {
                 drops.push_back({item.itemId, count});
             }
@@ -318,13 +249,13 @@ std::vector<std::pair<std::string, int>> StoneBuild::generateDrops() {
 }
 
 int StoneBuild::getExpReward() const {
-    if (expMax <= expMin) return expMin;
-    return expMin + rand() % (expMax - expMin + 1);
+    if (archetype->expMax <= archetype->expMin) return archetype->expMin;
+    return RandomService::getInstance().stream(RngStream::Stone).range(archetype->expMin, archetype->expMax);
 }
 
 int StoneBuild::getGoldReward() const {
-    if (goldMax <= goldMin) return goldMin;
-    return goldMin + rand() % (goldMax - goldMin + 1);
+    if (archetype->goldMax <= archetype->goldMin) return archetype->goldMin;
+    return RandomService::getInstance().stream(RngStream::Stone).range(archetype->goldMin, archetype->goldMax);
 }
 
 // ============================================================================
@@ -333,7 +264,6 @@ int StoneBuild::getGoldReward() const {
 
 StoneBuildManager::StoneBuildManager()
     : fontLoaded(false)
-    , hoveredStone(nullptr)
 {
 }
 
@@ -359,7 +289,7 @@ bool StoneBuildManager::init(const std::string& assetsPath) {
 bool StoneBuildManager::loadFont(const std::string& fontPath) {
     if (font.loadFromFile(fontPath)) {
         fontLoaded = true;
-        std::cout << "[StoneBuildManager] Font loaded: " << fontPath << std::endl;
+        LOG_INFO("[StoneBuildManager] Font loaded: " << fontPath);
         return true;
     }
     return false;
@@ -373,11 +303,7 @@ void StoneBuildManager::update(float dt) {
     }
     
     // 移除已摧毁的石头
-    stones.erase(
-        std::remove_if(stones.begin(), stones.end(),
-            [](const std::unique_ptr<StoneBuild>& s) { return s && s->isDead(); }),
-        stones.end()
-    );
+    stones.removeIf([](const std::unique_ptr<StoneBuild>& s) { return s && s->isDead(); });
 }
 
 void StoneBuildManager::render(sf::RenderWindow& window, const sf::View& view) {
@@ -401,8 +327,9 @@ void StoneBuildManager::render(sf::RenderWindow& window, const sf::View& view) {
 void StoneBuildManager::renderTooltips(sf::RenderWindow& window, const sf::Vector2f& mouseWorldPos) {
     updateHover(mouseWorldPos);
     
-    if (hoveredStone && fontLoaded) {
-        renderTooltip(window, hoveredStone);
+    StoneBuild* hovered = getStone(hoveredStone);
+    if (hovered && fontLoaded) {
+        renderTooltip(window, hovered);
     }
 }
 
@@ -410,11 +337,11 @@ void StoneBuildManager::renderTooltip(sf::RenderWindow& window, StoneBuild* ston
     if (!stone || !fontLoaded) return;
     
     // 获取鼠标屏幕位置
-    sf::Vector2i mouseScreenPos = sf::Mouse::getPosition(window);
+    sf::Vector2i mouseScreenPos = InputSystem::getInstance().getMousePosition();
     float tooltipX = mouseScreenPos.x + 20.0f;
     float tooltipY = mouseScreenPos.y + 20.0f;
     
-    std::vector<sf::String> lines;
+    FrameVector<sf::String> lines;
     
     // 标题（名称）
     lines.push_back(sf::String::fromUtf8(stone->getName().begin(), stone->getName().end()));
@@ -492,13 +419,13 @@ void StoneBuildManager::renderTooltip(sf::RenderWindow& window, StoneBuild* ston
     bg.setFillColor(sf::Color(20, 20, 30, 240));
     bg.setOutlineThickness(3);
     bg.setOutlineColor(sf::Color(100, 80, 60));
-    window.draw(bg);
+    RenderStats::draw(window, bg);
     
     // 绘制标题栏
     sf::RectangleShape titleBar(sf::Vector2f(tooltipWidth, lineHeight + 8));
     titleBar.setPosition(tooltipX, tooltipY);
     titleBar.setFillColor(sf::Color(60, 50, 40, 200));
-    window.draw(titleBar);
+    RenderStats::draw(window, titleBar);
     
     // 绘制文本
     float currentY = tooltipY + padding;
@@ -532,7 +459,7 @@ void StoneBuildManager::renderTooltip(sf::RenderWindow& window, StoneBuild* ston
             text.setFillColor(sf::Color(180, 180, 180));  // 默认灰色
         }
         
-        window.draw(text);
+        RenderStats::draw(window, text);
         currentY += lineHeight;
     }
     
@@ -541,36 +468,63 @@ void StoneBuildManager::renderTooltip(sf::RenderWindow& window, StoneBuild* ston
 }
 
 StoneBuild* StoneBuildManager::addStone(float x, float y, const std::string& type) {
-    auto stone = std::make_unique<StoneBuild>(x, y, type);
+    auto stone = std::make_unique<StoneBuild>(getArchetype(type), x, y);
     StoneBuild* ptr = stone.get();
-    stones.push_back(std::move(stone));
+    stones.insert(std::move(stone));
     return ptr;
 }
 
 StoneBuild* StoneBuildManager::addStoneFromProperty(float x, float y, const TileProperty* prop) {
-    auto stone = std::make_unique<StoneBuild>();
-    stone->initFromTileProperty(x, y, prop);
-    
-    if (prop) {
-        stone->setTextureFromProperty(prop);
-    }
+    // 没有属性信息时按默认类型创建
+    if (!prop) return addStone(x, y, "stone_build");
     
+    auto stone = std::make_unique<StoneBuild>(getArchetype(*prop), x, y);
     StoneBuild* ptr = stone.get();
-    stones.push_back(std::move(stone));
+    stones.insert(std::move(stone));
     return ptr;
 }
 
-void StoneBuildManager::removeStone(StoneBuild* stone) {
-    auto it = std::find_if(stones.begin(), stones.end(),
-        [stone](const std::unique_ptr<StoneBuild>& s) { return s.get() == stone; });
-    if (it != stones.end()) {
-        stones.erase(it);
+const StoneArchetype& StoneBuildManager::getArchetype(const std::string& type) {
+    for (const auto& archetype : archetypes) {
+        if (!archetype->source && archetype->stoneType == type) return *archetype;
+    }
+    archetypes.push_back(StoneArchetype::fromType(type));
+    return *archetypes.back();
+}
+
+const StoneArchetype& StoneBuildManager::getArchetype(const TileProperty& prop) {
+    for (const auto& archetype : archetypes) {
+        if (archetype->source == &prop) return *archetype;
     }
+    archetypes.push_back(StoneArchetype::fromTileProperty(prop));
+    return *archetypes.back();
+}
+
+void StoneBuildManager::removeStone(StoneBuild* stone) {
+    stones.removeIf([stone](const std::unique_ptr<StoneBuild>& s) { return s.get() == stone; });
+}
+
+void StoneBuildManager::removeStone(StoneHandle handle) {
+    stones.remove(handle);
 }
 
 void StoneBuildManager::clearAllStones() {
     stones.clear();
-    hoveredStone = nullptr;
+    archetypes.clear();     // 换地图后旧 TileProperty 地址可能被复用
+}
+
+StoneBuild* StoneBuildManager::getStone(StoneHandle handle) const {
+    const auto* slot = stones.get(handle);
+    return slot ? slot->get() : nullptr;
+}
+
+StoneHandle StoneBuildManager::getHandle(const StoneBuild* stone) const {
+    for (size_t i = 0; i < stones.size(); i++) {
+        if (stones[i].get() == stone) {
+            return stones.handleAt(i);
+        }
+    }
+    return StoneHandle{};
 }
 
 void StoneBuildManager::loadFromMapObjects(const std::vector<MapObject>& objects, float displayScale) {
@@ -591,7 +545,7 @@ void StoneBuildManager::loadFromMapObjects(const std::vector<MapObject>& objects
         }
     }
     
-    std::cout << "[StoneBuildManager] Loaded " << stones.size() << " stones from map" << std::endl;
+    LOG_INFO("[StoneBuildManager] Loaded " << stones.size() << " stones from map");
 }
 
 StoneBuild* StoneBuildManager::getStoneAt(const sf::Vector2f& position) {
@@ -612,9 +566,9 @@ StoneBuild* StoneBuildManager::getStoneInRect(const sf::FloatRect& rect) {
     return nullptr;
 }
 
-std::vector<StoneBuild*> StoneBuildManager::damageStonesInRange(const sf::Vector2f& center, 
+FrameVector<StoneBuild*> StoneBuildManager::damageStonesInRange(const sf::Vector2f& center, 
                                                                  float radius, float damage) {
-    std::vector<StoneBuild*> hitStones;
+    FrameVector<StoneBuild*> hitStones;
     
     for (auto& stone : stones) {
         if (!stone || stone->isDead()) continue;
@@ -636,14 +590,15 @@ std::vector<StoneBuild*> StoneBuildManager::damageStonesInRange(const sf::Vector
 }
 
 void StoneBuildManager::updateHover(const sf::Vector2f& mouseWorldPos) {
-    hoveredStone = nullptr;
+    hoveredStone = StoneHandle{};
     
-    for (auto& stone : stones) {
+    for (size_t i = 0; i < stones.size(); i++) {
+        StoneBuild* stone = stones[i].get();
         if (stone && !stone->isDead()) {
             bool hovered = stone->containsPoint(mouseWorldPos);
             stone->setHovered(hovered);
             if (hovered) {
-                hoveredStone = stone.get();
+                hoveredStone = stones.handleAt(i);
             }
         }
     }
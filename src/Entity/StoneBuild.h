@@ -2,8 +2,9 @@
 #include <SFML/Graphics.hpp>
 #include <string>
 #include <vector>
-#include <functional>
 #include <memory>
+#include "../Systems/SlotMap.h"
+#include "../Systems/FrameArena.h"
 
 // ============================================================================
 // 石头建筑系统 (Stone Build System)
@@ -30,23 +31,46 @@ struct StoneDropItem {
         : itemId(id), name(n), minCount(min), maxCount(max), dropChance(chance) {}
 };
 
-class StoneBuild {
-public:
-    StoneBuild();
-    StoneBuild(float x, float y, const std::string& stoneType = "stone_build");
+struct TileProperty;
+
+// ============================================================================
+// 石头原型 (Flyweight)
+//
+// 同一个 TileProperty（或同一个类型名）的石头共享名称、属性、掉落表、
+// 奖励范围和贴图；由 StoneBuildManager 创建并持有。
+// ============================================================================
+
+struct StoneArchetype {
+    std::string stoneType;          // 石头类型
+    std::string name;               // 显示名称
+    float maxHealth = 30.0f;
+    float defense = 5.0f;
+    sf::Vector2f defaultSize = sf::Vector2f(32, 32);
     
-    // ========================================
-    // 初始化
-    // ========================================
-    void init(float x, float y, const std::string& stoneType);
+    // === 掉落物品 ===
+    std::vector<StoneDropItem> dropItems;
+    
+    // === 击杀奖励 ===
+    int expMin = 5;
+    int expMax = 12;
+    int goldMin = 10;
+    int goldMax = 30;
+    int dropMax = 3;                // 单个物品最大掉落数量
     
-    // 从地图对象的TileProperty动态初始化（推荐使用）
-    void initFromTileProperty(float x, float y, const struct TileProperty* prop);
+    // === 渲染（与地图的 TileProperty 共享；为空时画灰色块）===
+    std::shared_ptr<sf::Texture> texture;
     
-    // 设置贴图（用于collection of images类型的tileset）
-    void setTextureFromProperty(const struct TileProperty* prop);
+    const TileProperty* source = nullptr;   // 按类型名创建时为空
     
-    bool loadTexture(const std::string& texturePath);
+    static std::unique_ptr<StoneArchetype> fromType(const std::string& stoneType);
+    static std::unique_ptr<StoneArchetype> fromTileProperty(const TileProperty& prop);
+};
+
+class StoneBuild {
+public:
+    StoneBuild(const StoneArchetype& archetype, float x, float y);
+    
+    const StoneArchetype& getArchetype() const { return *archetype; }
     
     // ========================================
     // 更新
@@ -75,27 +99,24 @@ public:
     // 属性 Getters
     // ========================================
     float getHealth() const { return health; }
-    float getMaxHealth() const { return maxHealth; }
-    float getHealthPercent() const { return health / maxHealth; }
-    float getDefense() const { return defense; }
-    const std::string& getStoneType() const { return stoneType; }
-    const std::string& getName() const { return name; }
+    float getMaxHealth() const { return archetype->maxHealth; }
+    float getHealthPercent() const { return health / archetype->maxHealth; }
+    float getDefense() const { return archetype->defense; }
+    const std::string& getStoneType() const { return archetype->stoneType; }
+    const std::string& getName() const { return archetype->name; }
     bool isDead() const { return health <= 0; }
     
     // ========================================
     // 属性 Setters
     // ========================================
-    void setHealth(float hp) { health = std::max(0.0f, std::min(hp, maxHealth)); }
-    void setMaxHealth(float hp) { maxHealth = hp; health = std::min(health, maxHealth); }
-    void setDefense(float def) { defense = def; }
-    void setName(const std::string& n) { name = n; }
+    void setHealth(float hp) { health = std::max(0.0f, std::min(hp, archetype->maxHealth)); }
     
     // ========================================
     // 位置和碰撞
     // ========================================
     sf::Vector2f getPosition() const { return position; }
-    void setPosition(float x, float y) { position = sf::Vector2f(x, y); updateSprite(); }
-    void setSize(float w, float h) { size = sf::Vector2f(w, h); updateSprite(); }
+    void setPosition(float x, float y) { position = sf::Vector2f(x, y); }
+    void setSize(float w, float h) { size = sf::Vector2f(w, h); }
     sf::Vector2f getSize() const { return size; }
     sf::FloatRect getBounds() const;
     sf::FloatRect getCollisionBox() const;  // 碰撞盒
@@ -103,77 +124,50 @@ public:
     // ========================================
     // 掉落物品
     // ========================================
-    void addDropItem(const StoneDropItem& item);
-    void clearDropItems();
-    const std::vector<StoneDropItem>& getDropItems() const { return dropItems; }
+    const std::vector<StoneDropItem>& getDropItems() const { return archetype->dropItems; }
     
     // 生成掉落（返回实际掉落的物品列表）
-    std::vector<std::pair<std::string, int>> generateDrops();
+    FrameVector<std::pair<std::string, int>> generateDrops();
     
     // 获取击杀奖励（随机范围内）
     int getExpReward() const;
     int getGoldReward() const;
-    int getExpMin() const { return expMin; }
-    int getExpMax() const { return expMax; }
-    int getGoldMin() const { return goldMin; }
-    int getGoldMax() const { return goldMax; }
-    int getDropMax() const { return dropMax; }
+    int getExpMin() const { return archetype->expMin; }
+    int getExpMax() const { return archetype->expMax; }
+    int getGoldMin() const { return archetype->goldMin; }
+    int getGoldMax() const { return archetype->goldMax; }
+    int getDropMax() const { return archetype->dropMax; }
     
     // ========================================
     // 悬浮提示
     // ========================================
     void setHovered(bool hovered) { isHovered = hovered; }
     bool getHovered() const { return isHovered; }
-    
-    // ========================================
-    // 回调
-    // ========================================
-    using StoneCallback = std::function<void(StoneBuild&)>;
-    void setOnDestroyed(StoneCallback cb) { onDestroyed = cb; }
 
 private:
-    void updateSprite();
-    
-private:
-    // === 基础属性 ===
-    std::string stoneType;      // 石头类型
-    std::string name;           // 显示名称
-    float health;
-    float maxHealth;
-    float defense;
+    // === 石头种类（共享，只读）===
+    const StoneArchetype* archetype;
     
     // === 位置 ===
     sf::Vector2f position;
     sf::Vector2f size;          // 尺寸
     
-    // === 渲染 ===
-    sf::Sprite sprite;
-    sf::Texture texture;
-    bool textureLoaded;
-    
-    // === 掉落物品 ===
-    std::vector<StoneDropItem> dropItems;
-    
-    // === 击杀奖励 ===
-    int expMin;                 // 最小经验
-    int expMax;                 // 最大经验
-    int goldMin;                // 最小金币
-    int goldMax;                // 最大金币
-    int dropMax;                // 单个物品最大掉落数量
+    // === 状态 ===
+    float health;
     
     // === 交互状态 ===
     bool isHovered;
     float shakeTimer;           // 被敲击时的震动
     float shakeIntensity;
-    
-    // === 回调 ===
-    StoneCallback onDestroyed;
 };
 
 // ============================================================================
 // 石头建筑管理器
 // ============================================================================
 
+// 跨帧保存石头用句柄（石头被删除后查找返回 nullptr）
+using StoneHandle = Handle<StoneBuild>;
+
 class StoneBuildManager {
 public:
     StoneBuildManager();
@@ -198,9 +192,19 @@ public:
     // 从TileProperty动态创建石头（推荐使用）
     StoneBuild* addStoneFromProperty(float x, float y, const struct TileProperty* prop);
     
+    // 石头原型：同一类型名 / 同一 TileProperty 只创建一次（清空石头时一并释放）
+    const StoneArchetype& getArchetype(const std::string& type);
+    const StoneArchetype& getArchetype(const TileProperty& prop);
+    size_t getArchetypeCount() const { return archetypes.size(); }
+    
     void removeStone(StoneBuild* stone);
+    void removeStone(StoneHandle handle);
     void clearAllStones();
     
+    // 句柄查找（失效时返回 nullptr）和指针换句柄（线性查找，未找到返回空句柄）
+    StoneBuild* getStone(StoneHandle handle) const;
+    StoneHandle getHandle(const StoneBuild* stone) const;
+    
     // 从地图对象加载石头
     void loadFromMapObjects(const std::vector<struct MapObject>& objects, 
                             float displayScale);
@@ -216,7 +220,7 @@ public:
     StoneBuild* getStoneInRect(const sf::FloatRect& rect);
     
     // 对范围内的石头造成伤害
-    std::vector<StoneBuild*> damageStonesInRange(const sf::Vector2f& center, 
+    FrameVector<StoneBuild*> damageStonesInRange(const sf::Vector2f& center, 
                                                   float radius, float damage);
     
     // 更新悬浮状态
@@ -231,7 +235,7 @@ public:
     // 获取器
     // ========================================
     size_t getStoneCount() const { return stones.size(); }
-    const std::vector<std::unique_ptr<StoneBuild>>& getStones() const { return stones; }
+    const std::vector<std::unique_ptr<StoneBuild>>& getStones() const { return stones.values(); }
     
     // ========================================
     // 字体设置（用于提示框）
@@ -242,7 +246,8 @@ private:
     void renderTooltip(sf::RenderWindow& window, StoneBuild* stone);
     
 private:
-    std::vector<std::unique_ptr<StoneBuild>> stones;
+    SlotMap<std::unique_ptr<StoneBuild>, StoneBuild> stones;
+    std::vector<std::unique_ptr<StoneArchetype>> archetypes;
     std::string assetsBasePath;
     
     // 字体（用于悬浮提示）
@@ -250,5 +255,5 @@ private:
     bool fontLoaded;
     
     // 当前悬浮的石头
-    StoneBuild* hoveredStone;
+    StoneHandle hoveredStone;
 };
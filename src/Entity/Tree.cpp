@@ -1,132 +1,77 @@
 ﻿#include "Tree.h"
 #include "../World/TileMap.h"
-#include <iostream>
-#include <cstdlib>
+#include "../Systems/Random.h"
+#include "../Systems/InputSystem.h"
+#include "../Systems/Logger.h"
+#include "../Systems/EventBus.h"
+#include "../Systems/RenderStats.h"
 #include <cmath>
 #include <algorithm>
 #include <sstream>
+#include <unordered_map>
 #define U8(str) (const char*)u8##str
 // ============================================================================
-// Tree 构造函数
+// 树种原型
 // ============================================================================
 
-Tree::Tree()
-    : treeType("oak")
-    , name("橡树")
-    , health(30.0f)
-    , maxHealth(30.0f)
-    , defense(5.0f)
-    , position(0, 0)
-    , size(64, 64)
-    , growthStage(TreeGrowthStage::Mature)
-    , growthTimer(0.0f)
-    , seedlingTime(60.0f)       // 1分钟
-    , growingTime(120.0f)       // 2分钟
-    , matureTime(180.0f)        // 3分钟结果
-    , fruitRegrowTime(60.0f)    // 1分钟果实再生
-    , currentTexture(nullptr)
-    , texturesLoaded(false)
-    , expMin(5)                 // 默认经验范围
-    , expMax(12)
-    , goldMin(10)               // 默认金币范围
-    , goldMax(30)
-    , dropMax(3)                // 默认最大掉落数量
-    , isHovered(false)
-    , shakeTimer(0.0f)
-    , shakeIntensity(0.0f)
-    , canTransform(false)       // 是否可以变换
-    , hasTransformed(false)     // 是否已经变换过
-    , onDestroyed(nullptr)
-    , onFruitHarvested(nullptr)
-    , onGrowthStageChanged(nullptr)
-{
-    // 默认掉落物品
-    dropItems.push_back(DropItem("wood", "木材", 1, 3, 0.75f));
-    dropItems.push_back(DropItem("seed", "种子", 1, 2, 0.5f));
-    dropItems.push_back(DropItem("stick", "树枝", 1, 2, 0.4f));
-}
-
-Tree::Tree(float x, float y, const std::string& type)
-    : Tree()
-{
-    init(x, y, type);
+namespace {
+    // 默认砍伐掉落（类型名创建、tsx 没有设置 drop_type 时）
+    std::vector<DropItem> defaultDropItems(int dropMax, float prob1, float prob2, float prob3) {
+        return {
+            DropItem("wood", "木材", 1, dropMax, prob1),
+            DropItem("seed", "种子", 1, dropMax, prob2),
+            DropItem("stick", "树枝", 1, dropMax, prob3)
+        };
+    }
 }
 
-void Tree::init(float x, float y, const std::string& type) {
-    position = sf::Vector2f(x, y);
-    treeType = type;
+std::unique_ptr<TreeArchetype> TreeArchetype::fromType(const std::string& type) {
+    auto archetype = std::make_unique<TreeArchetype>();
+    archetype->treeType = type;
+    archetype->name = "橡树";
+    archetype->dropItems = defaultDropItems(3, 0.75f, 0.5f, 0.4f);
     
     // 根据类型设置属性
     if (type == "oak" || type == "tree1") {
-        name = "橡树";
-        maxHealth = 30.0f;
-        defense = 5.0f;
-        size = sf::Vector2f(64, 64);
-        canTransform = true;  // 普通树可以变换成果树
-        hasTransformed = false;
+        archetype->canTransform = true;  // 普通树可以变换成果树
     } else if (type == "pine") {
-        name = "松树";
-        maxHealth = 40.0f;
-        defense = 8.0f;
-        size = sf::Vector2f(64, 96);
-        canTransform = false;
+        archetype->name = "松树";
+        archetype->maxHealth = 40.0f;
+        archetype->defense = 8.0f;
+        archetype->defaultSize = sf::Vector2f(64, 96);
     } else if (type == "apple_tree") {
-        name = "苹果树";
-        maxHealth = 25.0f;
-        defense = 3.0f;
-        size = sf::Vector2f(64, 64);
-        canTransform = false;
+        archetype->name = "苹果树";
+        archetype->maxHealth = 25.0f;
+        archetype->defense = 3.0f;
         // 苹果树的果实掉落
-        fruitDropItems.push_back(DropItem("apple", "苹果", 1, 3, 1.0f));
+        archetype->fruitDropItems.push_back(DropItem("apple", "苹果", 1, 3, 1.0f));
     } else if (type == "cherry_tree") {
-        name = "樱桃树";
-        maxHealth = 20.0f;
-        defense = 2.0f;
-        size = sf::Vector2f(64, 64);
-        canTransform = false;
-        fruitDropItems.push_back(DropItem("cherry", "樱桃", 2, 5, 1.0f));
+        archetype->name = "樱桃树";
+        archetype->maxHealth = 20.0f;
+        archetype->defense = 2.0f;
+        archetype->fruitDropItems.push_back(DropItem("cherry", "樱桃", 2, 5, 1.0f));
     }
     
-    health = maxHealth;
-    updateSprite();
+    return archetype;
 }
 
-// ============================================================================
-// 从 TileProperty 动态初始化（推荐使用）
-// ============================================================================
-
-void Tree::initFromTileProperty(float x, float y, const TileProperty* prop) {
-    position = sf::Vector2f(x, y);
-    
-    if (!prop) {
-        // 如果没有属性信息，使用默认值
-        treeType = "tree1";
-        name = "树木";
-        maxHealth = 30.0f;
-        defense = 5.0f;
-        size = sf::Vector2f(64, 64);
-        health = maxHealth;
-        updateSprite();
-        return;
-    }
+std::unique_ptr<TreeArchetype> TreeArchetype::fromTileProperty(const TileProperty& prop) {
+    auto archetype = std::make_unique<TreeArchetype>();
+    archetype->source = &prop;
     
     // 从 TileProperty 设置属性
-    treeType = prop->name;
-    name = prop->name;  // 可以后续添加中文名映射
-    maxHealth = (float)prop->hp;
-    defense = (float)prop->defense;
-    size = sf::Vector2f(64, 64);  // 默认尺寸，可从外部设置
+    archetype->treeType = prop.name;
+    archetype->name = prop.name;  // 可以后续添加中文名映射
+    archetype->maxHealth = (float)prop.hp;
+    archetype->defense = (float)prop.defense;
     
     // 解析经验和金币奖励
-    expMin = prop->expMin > 0 ? prop->expMin : 5;
-    expMax = prop->expMax > 0 ? prop->expMax : 12;
-    goldMin = prop->goldMin > 0 ? prop->goldMin : 10;
-    goldMax = prop->goldMax > 0 ? prop->goldMax : 30;
-    dropMax = prop->dropMax > 0 ? prop->dropMax : 3;
-    
-    // 清空并设置掉落物品
-    dropItems.clear();
-    fruitDropItems.clear();
+    archetype->expMin = prop.expMin > 0 ? prop.expMin : 5;
+    archetype->expMax = prop.expMax > 0 ? prop.expMax : 12;
+    archetype->goldMin = prop.goldMin > 0 ? prop.goldMin : 10;
+    archetype->goldMax = prop.goldMax > 0 ? prop.goldMax : 30;
+    archetype->dropMax = prop.dropMax > 0 ? prop.dropMax : 3;
+    const int dropMax = archetype->dropMax;
     
     // ========================================
     // 掉落规则：
@@ -136,11 +81,11 @@ void Tree::initFromTileProperty(float x, float y, const TileProperty* prop) {
     //   实际掉落数量使用递减概率计算（见 generateDrops）
     // ========================================
     
-    if (!prop->dropTypes.empty()) {
+    if (!prop.dropTypes.empty()) {
         // 使用 TSX 配置的掉落
-        for (size_t i = 0; i < prop->dropTypes.size(); i++) {
-            const std::string& itemId = prop->dropTypes[i];
-            float prob = (i < prop->dropProbabilities.size()) ? prop->dropProbabilities[i] : 0.5f;
+        for (size_t i = 0; i < prop.dropTypes.size(); i++) {
+            const std::string& itemId = prop.dropTypes[i];
+            float prob = (i < prop.dropProbabilities.size()) ? prop.dropProbabilities[i] : 0.5f;
             
             // 创建中文名映射
             std::string itemName = itemId;
@@ -154,9 +99,9 @@ void Tree::initFromTileProperty(float x, float y, const TileProperty* prop) {
             // 判断是砍伐掉落还是果实掉落
             if (itemId == "apple" || itemId == "cherry" || 
                 itemId.find("fruit") != std::string::npos) {
-                fruitDropItems.push_back(DropItem(itemId, itemName, 1, dropMax, prob));
+                archetype->fruitDropItems.push_back(DropItem(itemId, itemName, 1, dropMax, prob));
             } else {
-                dropItems.push_back(DropItem(itemId, itemName, 1, dropMax, prob));
+                archetype->dropItems.push_back(DropItem(itemId, itemName, 1, dropMax, prob));
             }
         }
     } else {
@@ -165,72 +110,59 @@ void Tree::initFromTileProperty(float x, float y, const TileProperty* prop) {
         float defaultProb2 = 0.5f;
         float defaultProb3 = 0.4f;
         
-        if (prop->dropProbabilities.size() >= 1) defaultProb1 = prop->dropProbabilities[0];
-        if (prop->dropProbabilities.size() >= 2) defaultProb2 = prop->dropProbabilities[1];
-        if (prop->dropProbabilities.size() >= 3) defaultProb3 = prop->dropProbabilities[2];
+        if (prop.dropProbabilities.size() >= 1) defaultProb1 = prop.dropProbabilities[0];
+        if (prop.dropProbabilities.size() >= 2) defaultProb2 = prop.dropProbabilities[1];
+        if (prop.dropProbabilities.size() >= 3) defaultProb3 = prop.dropProbabilities[2];
         
-        dropItems.push_back(DropItem("wood", "木材", 1, dropMax, defaultProb1));
-        dropItems.push_back(DropItem("seed", "种子", 1, dropMax, defaultProb2));
-        dropItems.push_back(DropItem("stick", "树枝", 1, dropMax, defaultProb3));
+        archetype->dropItems = defaultDropItems(dropMax, defaultProb1, defaultProb2, defaultProb3);
     }
     
     // 设置中文显示名
+    const std::string& treeType = archetype->treeType;
     if (treeType == "tree1") {
-        name = "橡树";
-        // 不再默认设置 canTransform，由外部控制
+        archetype->name = "橡树";
+        // 地图上的树不变换
     } else if (treeType == "apple_tree") {
-        name = "苹果树";
+        archetype->name = "苹果树";
     } else if (treeType == "cherry_tree") {
-        name = "樱桃树";
+        archetype->name = "樱桃树";
     } else if (treeType == "cherry_blossom_tree" || treeType == "cherry_blossom_tree.png") {
-        name = "樱花树";
+        archetype->name = "樱花树";
     } else {
         // 未知类型，使用原始名称
     }
-    canTransform = false;  // 默认不变换，由外部设置
-    
-    health = maxHealth;
-    
-    std::cout << "[Tree] Initialized from TileProperty: " << name 
-              << " HP=" << maxHealth << " DEF=" << defense 
-              << " drops=" << dropItems.size() 
-              << " fruits=" << fruitDropItems.size() << std::endl;
-    
-    updateSprite();
-}
-
-void Tree::setTextureFromProperty(const TileProperty* prop) {
-    if (!prop || !prop->hasTexture || !prop->texture) return;
     
-    // 从 shared_ptr 复制贴图（这会创建独立的副本，避免引用失效）
-    textureMature = *prop->texture;
-    textureSeedling = textureMature;
-    textureGrowing = textureMature;
-    textureFruiting = textureMature;
+    // 优先使用 TileProperty 中的独立贴图（与地图共享，不复制）
+    if (prop.hasTexture && prop.texture) {
+        archetype->texture = prop.texture;
+    }
     
-    texturesLoaded = true;
-    updateSprite();
+    LOG_DEBUG("[Tree] Archetype from TileProperty: " << archetype->name 
+          << " HP=" << archetype->maxHealth << " DEF=" << archetype->defense 
+          << " drops=" << archetype->dropItems.size() 
+          << " fruits=" << archetype->fruitDropItems.size());
     
-    std::cout << "[Tree] Texture set from TileProperty for: " << treeType << std::endl;
+    return archetype;
 }
 
-bool Tree::loadTextures(const std::string& basePath) {
-    std::cout << "[Tree] loadTextures called for type: " << treeType 
-              << " basePath: " << basePath << std::endl;
+bool TreeArchetype::loadTextures(const std::string& basePath) {
+    LOG_DEBUG("[Tree] loadTextures called for type: " << treeType 
+          << " basePath: " << basePath);
     
-    bool loaded = false;
+    const bool isApple = (treeType == "apple" || treeType == "apple_tree");
+    const bool isCherry = (treeType == "cherry" || treeType == "cherry_tree");
     
     // 根据树类型构建贴图路径
     std::vector<std::string> texturePaths;
     
-    if (treeType == "apple") {
+    if (isApple) {
         texturePaths = {
             basePath + "/apple_tree.png",
             basePath + "/apple.png",
             "../../assets/game_source/tree/apple_tree.png",
             "assets/game_source/tree/apple_tree.png"
         };
-    } else if (treeType == "cherry") {
+    } else if (isCherry) {
         texturePaths = {
             basePath + "/cherry_tree.png",
             basePath + "/cherry.png",
@@ -248,11 +180,14 @@ bool Tree::loadTextures(const std::string& basePath) {
         };
     }
     
+    texture = std::make_shared<sf::Texture>();
+    
     // 尝试加载贴图
+    bool loaded = false;
     for (const auto& path : texturePaths) {
-        if (textureMature.loadFromFile(path)) {
+        if (texture->loadFromFile(path)) {
             loaded = true;
-            std::cout << "[Tree] Loaded texture: " << path << std::endl;
+            LOG_DEBUG("[Tree] Loaded texture: " << path);
             break;
         }
     }
@@ -260,77 +195,64 @@ bool Tree::loadTextures(const std::string& basePath) {
     if (!loaded) {
         // 创建占位贴图
         sf::Image placeholder;
-        if (treeType == "apple_tree") {
+        if (isApple) {
             placeholder.create(64, 64, sf::Color(255, 100, 100));  // 红色代表苹果树
-        } else if (treeType == "cherry_tree") {
+        } else if (isCherry) {
             placeholder.create(64, 64, sf::Color(255, 150, 200));  // 粉色代表樱桃树
         } else {
             placeholder.create(64, 64, sf::Color(34, 139, 34));    // 绿色代表普通树
         }
-        textureMature.loadFromImage(placeholder);
-        std::cout << "[Tree] Using placeholder texture for: " << treeType << std::endl;
+        texture->loadFromImage(placeholder);
+        LOG_INFO("[Tree] Using placeholder texture for: " << treeType);
     }
     
-    // 其他阶段贴图使用成熟贴图
-    textureSeedling = textureMature;
-    textureGrowing = textureMature;
-    textureFruiting = textureMature;
-    
-    texturesLoaded = true;
-    updateSprite();
-    
     return loaded;
 }
 
+// ============================================================================
+// Tree 构造函数
+// ============================================================================
+
+Tree::Tree(const TreeArchetype& archetype, float x, float y)
+    : archetype(&archetype)
+    , position(x, y)
+    , size(archetype.defaultSize)
+    , health(archetype.maxHealth)
+    , growthStage(TreeGrowthStage::Mature)
+    , growthTimer(0.0f)
+    , hasTransformed(false)
+    , isHovered(false)
+    , shakeTimer(0.0f)
+    , shakeIntensity(0.0f)
+{
+}
+
+void Tree::setArchetype(const TreeArchetype& newArchetype) {
+    archetype = &newArchetype;
+    health = std::min(health, archetype->maxHealth);
+}
+
 // ============================================================================
 // 变换树类型（普通树变成果树）
 // ============================================================================
 
 void Tree::transformToFruitTree() {
-    if (!canTransform || hasTransformed) return;
+    if (!canBeTransformed()) return;
     
     // 随机选择变成苹果树或樱桃树
-    int choice = rand() % 2;
-    std::string newType = (choice == 0) ? "apple" : "cherry";
-    
-    std::cout << "[Tree] " << name << " transforms to " << newType << " tree!" << std::endl;
-    
-    // 保存位置和尺寸
-    sf::Vector2f savedPos = position;
-    sf::Vector2f savedSize = size;
-    
-    // 重新初始化为新类型
-    treeType = newType;
-    
-    if (newType == "apple_tree") {
-        name = "苹果树";
-        maxHealth = 25.0f;
-        defense = 3.0f;
-        fruitDropItems.clear();
-        fruitDropItems.push_back(DropItem("apple", "苹果", 1, 3, 1.0f));
-    } else if (newType == "cherry_tree"){
-        name = "樱桃树";
-        maxHealth = 20.0f;
-        defense = 2.0f;
-        fruitDropItems.clear();
-        fruitDropItems.push_back(DropItem("cherry", "樱桃", 2, 5, 1.0f));
-    }
-    
-    health = maxHealth;
-    hasTransformed = true;
-    canTransform = false;
+    int choice = RandomService::getInstance().stream(RngStream::Tree).range(0, 1);
+    const TreeArchetype* fruitTree = archetype->fruitVariants[choice];
+    if (!fruitTree) return;
     
-    // 恢复位置和尺寸
-    position = savedPos;
-    size = savedSize;
+    LOG_INFO("[Tree] " << archetype->name << " transforms to " << fruitTree->name << "!");
     
-    // 重新加载贴图
-    // 注意：这里需要知道 basePath，我们用一个常用路径
-    loadTextures("../../assets/game_source/tree");
+    // 换成果树原型（位置和尺寸不变）
+    archetype = fruitTree;
+    health = archetype->maxHealth;
+    hasTransformed = true;
     
     // 设置为结果阶段
     growthStage = TreeGrowthStage::Fruiting;
-    updateSprite();
 }
 
 // ============================================================================
@@ -361,14 +283,14 @@ void Tree::grow(float dt) {
     
     switch (growthStage) {
         case TreeGrowthStage::Seedling:
-            if (growthTimer >= seedlingTime) {
+            if (growthTimer >= archetype->seedlingTime) {
                 growthTimer = 0;
                 growthStage = TreeGrowthStage::Growing;
             }
             break;
             
         case TreeGrowthStage::Growing:
-            if (growthTimer >= growingTime) {
+            if (growthTimer >= archetype->growingTime) {
                 growthTimer = 0;
                 growthStage = TreeGrowthStage::Mature;
             }
@@ -376,13 +298,13 @@ void Tree::grow(float dt) {
             
         case TreeGrowthStage::Mature:
             // 普通树成熟后可以变换成果树
-            if (canTransform && !hasTransformed && growthTimer >= matureTime) {
+            if (canBeTransformed() && growthTimer >= archetype->matureTime) {
                 growthTimer = 0;
                 transformToFruitTree();  // 变换成苹果树或樱桃树
                 return;  // 变换后直接返回，避免重复处理
             }
             // 如果是果树，检查是否应该结果
-            else if (!fruitDropItems.empty() && growthTimer >= matureTime) {
+            else if (!archetype->fruitDropItems.empty() && growthTimer >= archetype->matureTime) {
                 growthTimer = 0;
                 growthStage = TreeGrowthStage::Fruiting;
             }
@@ -393,34 +315,55 @@ void Tree::grow(float dt) {
             break;
     }
     
-    // 阶段变化回调
+    // 阶段变化事件
     if (oldStage != growthStage) {
-        updateSprite();
-        if (onGrowthStageChanged) {
-            onGrowthStageChanged(*this);
-        }
+        EventBus::getInstance().push(TreeGrowthChangedEvent{handle});
     }
 }
 
+// ============================================================================
+// 存档
+// ============================================================================
+
+TreeSaveData Tree::captureSaveData() const {
+    TreeSaveData data;
+    data.treeType = archetype->treeType;
+    data.position = position;
+    data.size = size;
+    data.growthStage = growthStage;
+    data.growthTimer = growthTimer;
+    data.health = health;
+    data.hasTransformed = hasTransformed;
+    return data;
+}
+
+void Tree::applySaveData(const TreeSaveData& data) {
+    // 原型由 TreeManager 先按存档还原；变换标记同样以存档为准（读档可以撤销存档后的变换）
+    hasTransformed = data.hasTransformed;
+    
+    position = data.position;
+    size = data.size;
+    growthStage = data.growthStage;
+    growthTimer = data.growthTimer;
+    health = data.health;
+}
+
 void Tree::setGrowthStage(TreeGrowthStage stage) {
     if (growthStage != stage) {
         growthStage = stage;
         growthTimer = 0;
-        updateSprite();
-        if (onGrowthStageChanged) {
-            onGrowthStageChanged(*this);
-        }
+        EventBus::getInstance().push(TreeGrowthChangedEvent{handle});
     }
 }
 
 float Tree::getGrowthProgress() const {
     switch (growthStage) {
         case TreeGrowthStage::Seedling:
-            return seedlingTime > 0 ? growthTimer / seedlingTime : 1.0f;
+            return archetype->seedlingTime > 0 ? growthTimer / archetype->seedlingTime : 1.0f;
         case TreeGrowthStage::Growing:
-            return growingTime > 0 ? growthTimer / growingTime : 1.0f;
+            return archetype->growingTime > 0 ? growthTimer / archetype->growingTime : 1.0f;
         case TreeGrowthStage::Mature:
-            return matureTime > 0 ? growthTimer / matureTime : 1.0f;
+            return archetype->matureTime > 0 ? growthTimer / archetype->matureTime : 1.0f;
         case TreeGrowthStage::Fruiting:
             return 1.0f;
     }
@@ -442,7 +385,8 @@ std::string Tree::getGrowthStageName() const {
 // ============================================================================
 
 void Tree::render(sf::RenderWindow& window) {
-    if (!texturesLoaded) return;
+    const sf::Texture* texture = archetype->texture.get();
+    if (!texture || texture->getSize().x == 0) return;
     
     sf::Vector2f renderPos = position;
     
@@ -452,6 +396,10 @@ void Tree::render(sf::RenderWindow& window) {
         renderPos.x += shake;
     }
     
+    // 精灵在绘制时现建：贴图属于原型，实例不保存 sf::Sprite
+    sf::Sprite sprite(*texture);
+    sf::Vector2u texSize = texture->getSize();
+    sprite.setScale(size.x / texSize.x, size.y / texSize.y);
     sprite.setPosition(renderPos.x, renderPos.y - size.y);
     
     // 悬浮高亮效果
@@ -461,7 +409,7 @@ void Tree::render(sf::RenderWindow& window) {
         sprite.setColor(sf::Color::White);
     }
     
-    window.draw(sprite);
+    RenderStats::draw(window, sprite);
 }
 
 void Tree::renderDropParticles(sf::RenderWindow& window) {
@@ -473,27 +421,7 @@ void Tree::renderDropParticles(sf::RenderWindow& window) {
         shape.setPosition(particle.position);
         shape.setFillColor(sf::Color(139, 90, 43, 
             static_cast<sf::Uint8>(255 * (particle.lifetime / particle.maxLifetime))));
-        window.draw(shape);
-    }
-}
-
-void Tree::updateSprite() {
-    sf::Texture* tex = nullptr;
-    
-    switch (growthStage) {
-        case TreeGrowthStage::Seedling: tex = &textureSeedling; break;
-        case TreeGrowthStage::Growing:  tex = &textureGrowing; break;
-        case TreeGrowthStage::Mature:   tex = &textureMature; break;
-        case TreeGrowthStage::Fruiting: tex = &textureFruiting; break;
-    }
-    
-    if (tex && tex->getSize().x > 0) {
-        currentTexture = tex;
-        sprite.setTexture(*currentTexture);
-        
-        // 根据尺寸缩放
-        sf::Vector2u texSize = currentTexture->getSize();
-        sprite.setScale(size.x / texSize.x, size.y / texSize.y);
+        RenderStats::draw(window, shape);
     }
 }
 
@@ -503,24 +431,22 @@ void Tree::updateSprite() {
 
 bool Tree::takeDamage(float damage) {
     // 计算实际伤害
-    float actualDamage = std::max(1.0f, damage - defense);
+    float actualDamage = std::max(1.0f, damage - archetype->defense);
     health -= actualDamage;
     
     // 触发震动效果
     shakeTimer = 0.3f;
     shakeIntensity = 3.0f;
     
-    std::cout << "[Tree] " << name << " took " << actualDamage 
-              << " damage, HP: " << health << "/" << maxHealth << std::endl;
+    LOG_DEBUG("[Tree] " << archetype->name << " took " << actualDamage 
+          << " damage, HP: " << health << "/" << archetype->maxHealth);
     
     if (health <= 0) {
         health = 0;
         // 生成掉落粒子
         spawnDropParticles(position, 5);
         
-        if (onDestroyed) {
-            onDestroyed(*this);
-        }
+        EventBus::getInstance().push(TreeDestroyedEvent{handle});
         return true;  // 树木被砍倒
     }
     
@@ -538,13 +464,10 @@ bool Tree::harvestFruit() {
     // 回到成熟阶段，开始重新结果
     growthStage = TreeGrowthStage::Mature;
     growthTimer = 0;
-    updateSprite();
     
-    if (onFruitHarvested) {
-        onFruitHarvested(*this);
-    }
+    EventBus::getInstance().push(TreeFruitHarvestedEvent{handle});
     
-    std::cout << "[Tree] Harvested fruit from " << name << std::endl;
+    LOG_DEBUG("[Tree] Harvested fruit from " << archetype->name);
     return true;
 }
 
@@ -577,20 +500,12 @@ sf::FloatRect Tree::getCollisionBox() const {
 // 掉落物品
 // ============================================================================
 
-void Tree::addDropItem(const DropItem& item) {
-    dropItems.push_back(item);
-}
-
-void Tree::clearDropItems() {
-    dropItems.clear();
-}
-
-void Tree::addFruitDropItem(const DropItem& item) {
-    fruitDropItems.push_back(item);
-}
-
-std::vector<std::pair<std::string, int>> Tree::generateDrops() {
-    std::vector<std::pair<std::string, int>> result;
+FrameVector<std::pair<std::string, int>> Tree::generateDrops() {
+    const std::vector<DropItem>& dropItems = archetype->dropItems;
+    const int dropMax = archetype->dropMax;
+    FrameVector<std::pair<std::string, int>> result;
+    result.reserve(dropItems.size());
+    Rng& rng = RandomService::getInstance().stream(RngStream::Tree);
     
     // ========================================
     // 递减概率掉落计算规则：
@@ -607,7 +522,7 @@ std::vector<std::pair<std::string, int>> Tree::generateDrops() {
         
         // 递减概率计算
         for (int i = 0; i < dropMax; i++) {
-            float roll = static_cast<float>(rand()) / RAND_MAX;
+            float roll = rng.nextFloat();
             if (roll < currentProbability) {
                 count++;
                 currentProbability *= item.dropChance;  // 概率递减
@@ -618,24 +533,27 @@ std::vector<std::pair<std::string, int>> Tree::generateDrops() {
         
         if (count > 0) {
             result.push_back({item.itemId, count});
-            std::cout << "[Tree] Dropped: " << item.name << " x" << count 
-                      << " (prob=" << (int)(item.dropChance * 100) << "%)" << std::endl;
+            LOG_DEBUG("[Tree] Dropped: " << item.name << " x" << count 
+                  << " (prob=" << (int)(item.dropChance * 100) << "%)");
         }
     }
     
     return result;
 }
 
-std::vector<std::pair<std::string, int>> Tree::generateFruitDrops() {
-    std::vector<std::pair<std::string, int>> result;
+FrameVector<std::pair<std::string, int>> Tree::generateFruitDrops() {
+    const std::vector<DropItem>& fruitDropItems = archetype->fruitDropItems;
+    FrameVector<std::pair<std::string, int>> result;
+    result.reserve(fruitDropItems.size());
+    Rng& rng = RandomService::getInstance().stream(RngStream::Tree);
     
     for (const auto& item : fruitDropItems) {
-        float roll = static_cast<float>(rand()) / RAND_MAX;
+        float roll = rng.nextFloat();
         if (roll <= item.dropChance) {
-            int count = item.minCount + rand() % (item.maxCount - item.minCount + 1);
+            int count = rng.range(item.minCount, item.maxCount);
             if (count > 0) {
                 result.push_back({item.itemId, count});
-                std::cout << "[Tree] Fruit dropped: " << item.name << " x" << count << std::endl;
+                LOG_DEBUG("[Tree] Fruit dropped: " << item.name << " x" << count);
             }
         }
     }
@@ -644,13 +562,13 @@ std::vector<std::pair<std::string, int>> Tree::generateFruitDrops() {
 }
 
 int Tree::getExpReward() const {
-    if (expMax <= expMin) return expMin;
-    return expMin + rand() % (expMax - expMin + 1);
+    if (archetype->expMax <= archetype->expMin) return archetype->expMin;
+    return RandomService::getInstance().stream(RngStream::Tree).range(archetype->expMin, archetype->expMax);
 }
 
 int Tree::getGoldReward() const {
-    if (goldMax <= goldMin) return goldMin;
-    return goldMin + rand() % (goldMax - goldMin + 1);
+    if (archetype->goldMax <= archetype->goldMin) return archetype->goldMin;
+    return RandomService::getInstance().stream(RngStream::Tree).range(archetype->goldMin, archetype->goldMax);
 }
 
 // ============================================================================
@@ -658,12 +576,14 @@ int Tree::getGoldReward() const {
 // ============================================================================
 
 void Tree::spawnDropParticles(const sf::Vector2f& pos, int count) {
+    Rng& rng = RandomService::getInstance().stream(RngStream::Particles);
+    
     for (int i = 0; i < count; i++) {
         DropParticle particle;
         particle.position = pos;
         particle.velocity = sf::Vector2f(
-            (rand() % 100 - 50) * 2.0f,  // -100 to 100
-            -150.0f - rand() % 100       // -150 to -250 (向上)
+            (rng.range(0, 99) - 50) * 2.0f,  // -100 to 100
+            -150.0f - rng.range(0, 99)       // -150 to -250 (向上)
         );
         particle.lifetime = 1.0f;
         particle.maxLifetime = 1.0f;
@@ -701,7 +621,6 @@ void Tree::updateDropParticles(float dt) {
 
 TreeManager::TreeManager()
     : fontLoaded(false)
-    , hoveredTree(nullptr)
 {
 }
 
@@ -722,7 +641,7 @@ bool TreeManager::init(const std::string& assetsPath) {
     for (const auto& path : fontPaths) {
         if (font.loadFromFile(path)) {
             fontLoaded = true;
-            std::cout << "[TreeManager] Font loaded: " << path << std::endl;
+            LOG_INFO("[TreeManager] Font loaded: " << path);
             break;
         }
     }
@@ -740,10 +659,18 @@ bool TreeManager::loadFont(const std::string& fontPath) {
 
 void TreeManager::update(float dt) {
     // 更新所有树木
+    size_t alive = 0;
     for (auto it = trees.begin(); it != trees.end(); ) {
         (*it)->update(dt);
+        if (!(*it)->isDead()) alive++;
         ++it;
     }
+    
+    // 树木被砍倒或重新长出：碰撞布局变了
+    if (alive != aliveCount) {
+        aliveCount = alive;
+        layoutVersion++;
+    }
 }
 
 void TreeManager::render(sf::RenderWindow& window, const sf::View& view) {
@@ -772,8 +699,9 @@ void TreeManager::renderTooltips(sf::RenderWindow& window, const sf::Vector2f& m
     updateHover(mouseWorldPos);
     
     // 渲染悬浮提示
-    if (hoveredTree && !hoveredTree->isDead()) {
-        renderTooltip(window, hoveredTree);
+    Tree* hovered = getTree(hoveredTree);
+    if (hovered && !hovered->isDead()) {
+        renderTooltip(window, hovered);
     }
 }
 
@@ -781,11 +709,11 @@ void TreeManager::renderTooltip(sf::RenderWindow& window, Tree* tree) {
     if (!fontLoaded || !tree) return;
     
     // 获取鼠标屏幕位置
-    sf::Vector2i mouseScreenPos = sf::Mouse::getPosition(window);
+    sf::Vector2i mouseScreenPos = InputSystem::getInstance().getMousePosition();
     float tooltipX = mouseScreenPos.x + 20.0f;
     float tooltipY = mouseScreenPos.y + 20.0f;
     
-    std::vector<sf::String> lines;
+    FrameVector<sf::String> lines;
     
     // 标题（树木名称）
     lines.push_back(sf::String::fromUtf8(tree->getName().begin(), tree->getName().end()));
@@ -880,13 +808,13 @@ void TreeManager::renderTooltip(sf::RenderWindow& window, Tree* tree) {
     bg.setFillColor(sf::Color(25, 25, 35, 240));
     bg.setOutlineThickness(3.0f);
     bg.setOutlineColor(sf::Color(139, 90, 43));
-    window.draw(bg);
+    RenderStats::draw(window, bg);
     
     // 绘制标题背景条
     sf::RectangleShape titleBg(sf::Vector2f(tooltipWidth - 6, lineHeight + 4));
     titleBg.setPosition(tooltipX + 3, tooltipY + 3);
     titleBg.setFillColor(sf::Color(60, 45, 30, 200));
-    window.draw(titleBg);
+    RenderStats::draw(window, titleBg);
     
     // 绘制文字
     sf::Text text;
@@ -921,7 +849,7 @@ void TreeManager::renderTooltip(sf::RenderWindow& window, Tree* tree) {
             text.setStyle(sf::Text::Regular);
         }
         
-        window.draw(text);
+        RenderStats::draw(window, text);
         y += lineHeight;
     }
     
@@ -937,7 +865,7 @@ void TreeManager::renderTooltip(sf::RenderWindow& window, Tree* tree) {
     barBg.setFillColor(sf::Color(50, 50, 50));
     barBg.setOutlineThickness(1.0f);
     barBg.setOutlineColor(sf::Color(80, 80, 80));
-    window.draw(barBg);
+    RenderStats::draw(window, barBg);
     
     // 血条填充
     float healthPercent = tree->getHealthPercent();
@@ -953,50 +881,106 @@ void TreeManager::renderTooltip(sf::RenderWindow& window, Tree* tree) {
     sf::RectangleShape barFill(sf::Vector2f(barWidth * healthPercent, barHeight));
     barFill.setPosition(barX, barY);
     barFill.setFillColor(barColor);
-    window.draw(barFill);
+    RenderStats::draw(window, barFill);
 }
 
 Tree* TreeManager::addTree(float x, float y, const std::string& type) {
-    auto tree = std::make_unique<Tree>(x, y, type);
-    tree->loadTextures(assetsBasePath + "/game_source/tree");
+    auto tree = std::make_unique<Tree>(getArchetype(type), x, y);
     
     Tree* ptr = tree.get();
-    trees.push_back(std::move(tree));
+    ptr->setHandle(trees.insert(std::move(tree)));
+    layoutVersion++;
     
-    std::cout << "[TreeManager] Added " << type << " tree at (" << x << ", " << y << ")" << std::endl;
+    LOG_DEBUG("[TreeManager] Added " << type << " tree at (" << x << ", " << y << ")");
     return ptr;
 }
 
 Tree* TreeManager::addTreeFromProperty(float x, float y, const TileProperty* prop) {
-    auto tree = std::make_unique<Tree>();
-    tree->initFromTileProperty(x, y, prop);
+    // 没有属性信息时按默认类型创建
+    if (!prop) return addTree(x, y, "tree1");
     
-    // 优先使用 TileProperty 中的独立贴图
-    if (prop && prop->hasTexture) {
-        tree->setTextureFromProperty(prop);
-    } else {
-        // 后备：从文件加载
-        tree->loadTextures(assetsBasePath + "/game_source/tree");
-    }
+    auto tree = std::make_unique<Tree>(getArchetype(*prop), x, y);
     
     Tree* ptr = tree.get();
-    trees.push_back(std::move(tree));
+    ptr->setHandle(trees.insert(std::move(tree)));
+    layoutVersion++;
     
-    std::string treeName = prop ? prop->name : "unknown";
-    std::cout << "[TreeManager] Added " << treeName << " tree from property at (" << x << ", " << y << ")" << std::endl;
+    LOG_DEBUG("[TreeManager] Added " << prop->name << " tree from property at (" << x << ", " << y << ")");
     return ptr;
 }
 
+const TreeArchetype& TreeManager::getArchetype(const std::string& type) {
+    // 旧存档里变换后的果树类型名是 apple / cherry
+    std::string key = type;
+    if (key == "apple") key = "apple_tree";
+    else if (key == "cherry") key = "cherry_tree";
+    
+    for (const auto& archetype : archetypes) {
+        if (!archetype->source && archetype->treeType == key) return *archetype;
+    }
+    
+    auto archetype = TreeArchetype::fromType(key);
+    archetype->loadTextures(assetsBasePath + "/game_source/tree");
+    archetypes.push_back(std::move(archetype));
+    TreeArchetype& created = *archetypes.back();
+    
+    // 可变换的树：成熟后随机变成其中一种果树
+    if (created.canTransform) {
+        created.fruitVariants[0] = &getArchetype("apple_tree");
+        created.fruitVariants[1] = &getArchetype("cherry_tree");
+    }
+    
+    LOG_DEBUG("[TreeManager] New archetype: " << key << " (" << archetypes.size() << " total)");
+    return created;
+}
+
+const TreeArchetype& TreeManager::getArchetype(const TileProperty& prop) {
+    for (const auto& archetype : archetypes) {
+        if (archetype->source == &prop) return *archetype;
+    }
+    
+    auto archetype = TreeArchetype::fromTileProperty(prop);
+    if (!archetype->texture) {
+        // 后备：从文件加载
+        archetype->loadTextures(assetsBasePath + "/game_source/tree");
+    }
+    archetypes.push_back(std::move(archetype));
+    
+    LOG_DEBUG("[TreeManager] New archetype from property: " << prop.name 
+          << " (" << archetypes.size() << " total)");
+    return *archetypes.back();
+}
+
 void TreeManager::removeTree(Tree* tree) {
-    trees.erase(
-        std::remove_if(trees.begin(), trees.end(),
-            [tree](const std::unique_ptr<Tree>& t) { return t.get() == tree; }),
-        trees.end()
-    );
+    trees.removeIf([tree](const std::unique_ptr<Tree>& t) { return t.get() == tree; });
+    layoutVersion++;
+}
+
+void TreeManager::removeTree(TreeHandle handle) {
+    if (trees.remove(handle)) {
+        layoutVersion++;
+    }
+}
+
+Tree* TreeManager::getTree(TreeHandle handle) const {
+    const auto* slot = trees.get(handle);
+    return slot ? slot->get() : nullptr;
+}
+
+TreeHandle TreeManager::getHandle(const Tree* tree) const {
+    for (size_t i = 0; i < trees.size(); i++) {
+        if (trees[i].get() == tree) {
+            return trees.handleAt(i);
+        }
+    }
+    return TreeHandle{};
 }
 
 void TreeManager::clearAllTrees() {
     trees.clear();
+    // 原型按 TileProperty 地址查找：换地图后旧地址可能被复用，一起清掉
+    archetypes.clear();
+    layoutVersion++;
 }
 
 void TreeManager::loadFromMapObjects(const std::vector<MapObject>& objects, float displayScale) {
@@ -1024,6 +1008,86 @@ void TreeManager::loadFromMapObjects(const std::vector<MapObject>& objects, floa
     }
 }
 
+// ============================================================================
+// 存档
+// ============================================================================
+
+std::vector<TreeSaveData> TreeManager::captureSaveData() const {
+    std::vector<TreeSaveData> data;
+    data.reserve(trees.size());
+    for (const auto& tree : trees) {
+        data.push_back(tree->captureSaveData());
+    }
+    return data;
+}
+
+std::vector<Tree*> TreeManager::applySaveData(const std::vector<TreeSaveData>& data) {
+    std::vector<bool> matched(data.size(), false);
+    
+    // 存档记录按整像素格建索引：容差 0.5 像素内的位置最多差一格，查 3x3 格即可
+    auto cellKey = [](int cx, int cy) {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(cx)) << 32) |
+               static_cast<std::uint32_t>(cy);
+    };
+    std::unordered_multimap<std::uint64_t, size_t> recordsByCell;
+    recordsByCell.reserve(data.size());
+    for (size_t i = 0; i < data.size(); i++) {
+        recordsByCell.emplace(cellKey((int)std::floor(data[i].position.x),
+                                      (int)std::floor(data[i].position.y)), i);
+    }
+    
+    // 地图上的树：按位置匹配存档记录（树不会移动），没匹配上的删除
+    trees.removeIf([&](const std::unique_ptr<Tree>& tree) {
+        sf::Vector2f pos = tree->getPosition();
+        int cx = (int)std::floor(pos.x);
+        int cy = (int)std::floor(pos.y);
+        
+        // 多条记录都在容差内时取下标最小的（与逐条扫描的结果一致）
+        size_t best = data.size();
+        for (int dy = -1; dy <= 1; dy++) {
+            for (int dx = -1; dx <= 1; dx++) {
+                auto range = recordsByCell.equal_range(cellKey(cx + dx, cy + dy));
+                for (auto it = range.first; it != range.second; ++it) {
+                    size_t i = it->second;
+                    if (matched[i] || i >= best) continue;
+                    if (std::abs(data[i].position.x - pos.x) < 0.5f &&
+                        std::abs(data[i].position.y - pos.y) < 0.5f) {
+                        best = i;
+                    }
+                }
+            }
+        }
+        if (best == data.size()) return true;
+        
+        matched[best] = true;
+        tree->setArchetype(findSavedArchetype(*tree, data[best].treeType));
+        tree->applySaveData(data[best]);
+        return false;
+    });
+    layoutVersion++;
+    
+    // 存档中多出的树（玩家种植）
+    std::vector<Tree*> created;
+    for (size_t i = 0; i < data.size(); i++) {
+        if (matched[i]) continue;
+        Tree* tree = addTree(data[i].position.x, data[i].position.y, data[i].treeType);
+        tree->applySaveData(data[i]);
+        created.push_back(tree);
+    }
+    
+    return created;
+}
+
+const TreeArchetype& TreeManager::findSavedArchetype(const Tree& tree, const std::string& type) {
+    if (tree.getArchetype().treeType == type) return tree.getArchetype();
+    
+    // 存档后才变换的地图树：换回地图上同类型的原型（带 TileProperty 来源）
+    for (const auto& archetype : archetypes) {
+        if (archetype->treeType == type) return *archetype;
+    }
+    return getArchetype(type);
+}
+
 Tree* TreeManager::getTreeAt(const sf::Vector2f& position) {
     for (auto& tree : trees) {
         if (!tree->isDead() && tree->containsPoint(position)) {
@@ -1042,9 +1106,9 @@ Tree* TreeManager::getTreeInRect(const sf::FloatRect& rect) {
     return nullptr;
 }
 
-std::vector<Tree*> TreeManager::damageTreesInRange(const sf::Vector2f& center, 
+FrameVector<Tree*> TreeManager::damageTreesInRange(const sf::Vector2f& center, 
                                                     float radius, float damage) {
-    std::vector<Tree*> hitTrees;
+    FrameVector<Tree*> hitTrees;
     
     for (auto& tree : trees) {
         if (tree->isDead()) continue;
@@ -1066,23 +1130,23 @@ std::vector<Tree*> TreeManager::damageTreesInRange(const sf::Vector2f& center,
 }
 
 void TreeManager::updateHover(const sf::Vector2f& mouseWorldPos) {
-    Tree* newHovered = nullptr;
+    TreeHandle newHovered;
     
-    for (auto& tree : trees) {
-        if (!tree->isDead() && tree->containsPoint(mouseWorldPos)) {
-            newHovered = tree.get();
+    for (size_t i = 0; i < trees.size(); i++) {
+        if (!trees[i]->isDead() && trees[i]->containsPoint(mouseWorldPos)) {
+            newHovered = trees.handleAt(i);
             break;
         }
     }
     
-    // 更新悬浮状态
+    // 更新悬浮状态（旧句柄失效说明那棵树已被删除，无需清除标记）
     if (hoveredTree != newHovered) {
-        if (hoveredTree) {
-            hoveredTree->setHovered(false);
+        if (Tree* old = getTree(hoveredTree)) {
+            old->setHovered(false);
         }
         hoveredTree = newHovered;
-        if (hoveredTree) {
-            hoveredTree->setHovered(true);
+        if (Tree* hovered = getTree(hoveredTree)) {
+            hovered->setHovered(true);
         }
     }
 }
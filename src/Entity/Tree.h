@@ -2,8 +2,10 @@
 #include <SFML/Graphics.hpp>
 #include <string>
 #include <vector>
-#include <functional>
 #include <memory>
+#include <cstdint>
+#include "../Systems/SlotMap.h"
+#include "../Systems/FrameArena.h"
 
 // ============================================================================
 // 树木系统
@@ -36,6 +38,17 @@ struct DropItem {
         : itemId(id), name(n), minCount(min), maxCount(max), dropChance(chance) {}
 };
 
+// 存档数据（只包含运行时会变化的状态，其余属性由地图/类型决定）
+struct TreeSaveData {
+    std::string treeType;
+    sf::Vector2f position;
+    sf::Vector2f size;
+    TreeGrowthStage growthStage = TreeGrowthStage::Seedling;
+    float growthTimer = 0.0f;
+    float health = 0.0f;
+    bool hasTransformed = false;
+};
+
 // 掉落动画粒子
 struct DropParticle {
     sf::Vector2f position;
@@ -48,23 +61,70 @@ struct DropParticle {
     DropParticle() : lifetime(0), maxLifetime(1.0f), active(false) {}
 };
 
-class Tree {
-public:
-    Tree();
-    Tree(float x, float y, const std::string& treeType = "oak");
+class Tree;
+struct TileProperty;
+
+// 跨帧保存树木用句柄（树被删除后查找返回 nullptr）
+using TreeHandle = Handle<Tree>;
+
+// ============================================================================
+// 树种原型 (Flyweight)
+//
+// 同一个 TileProperty（或同一个类型名）的树共享一份只读原型：名称、属性、
+// 生长时间、掉落表、奖励范围和贴图。原型由 TreeManager 创建并持有，
+// Tree 只保存原型指针和自身状态（位置、生命值、生长阶段、计时器）。
+// ============================================================================
+
+struct TreeArchetype {
+    std::string treeType;           // 树木类型 (oak, pine, apple_tree, etc.)
+    std::string name;               // 显示名称
+    float maxHealth = 30.0f;
+    float defense = 5.0f;
+    sf::Vector2f defaultSize = sf::Vector2f(64, 64);
     
-    // ========================================
-    // 初始化
-    // ========================================
-    void init(float x, float y, const std::string& treeType);
+    // === 生长 ===
+    float seedlingTime = 60.0f;     // 幼苗阶段所需时间（1分钟）
+    float growingTime = 120.0f;     // 成长阶段所需时间（2分钟）
+    float matureTime = 180.0f;      // 成熟到结果所需时间（3分钟）
+    float fruitRegrowTime = 60.0f;  // 果实再生时间（1分钟）
     
-    // 从地图对象的TileProperty动态初始化（推荐使用）
-    void initFromTileProperty(float x, float y, const struct TileProperty* prop);
+    // === 变换 ===
+    bool canTransform = false;      // 成熟后是否变换成果树
+    const TreeArchetype* fruitVariants[2] = {nullptr, nullptr};  // 苹果树 / 樱桃树（TreeManager 填入）
     
-    // 设置贴图（用于collection of images类型的tileset）
-    void setTextureFromProperty(const struct TileProperty* prop);
+    // === 掉落物品 ===
+    std::vector<DropItem> dropItems;        // 砍伐掉落
+    std::vector<DropItem> fruitDropItems;   // 果实掉落
+    
+    // === 击杀奖励 ===
+    int expMin = 5;
+    int expMax = 12;
+    int goldMin = 10;
+    int goldMax = 30;
+    int dropMax = 3;                // 单个物品最大掉落数量
+    
+    // === 渲染（各生长阶段共用一张贴图；来自 TileProperty 时与地图共享）===
+    std::shared_ptr<sf::Texture> texture;
+    
+    const TileProperty* source = nullptr;   // 按类型名创建时为空
     
+    // 按类型名创建（种植、无 TileProperty 的地图对象、存档新建）
+    static std::unique_ptr<TreeArchetype> fromType(const std::string& treeType);
+    
+    // 从地图对象的 TileProperty 创建
+    static std::unique_ptr<TreeArchetype> fromTileProperty(const TileProperty& prop);
+    
+    // 从文件加载贴图，找不到时使用占位贴图
     bool loadTextures(const std::string& basePath);
+};
+
+class Tree {
+public:
+    Tree(const TreeArchetype& archetype, float x, float y);
+    
+    // 换原型（读档恢复已变换的果树）
+    void setArchetype(const TreeArchetype& newArchetype);
+    const TreeArchetype& getArchetype() const { return *archetype; }
     
     // ========================================
     // 更新
@@ -106,35 +166,31 @@ public:
     // 变换系统（普通树变成果树）
     // ========================================
     void transformToFruitTree();
-    bool canBeTransformed() const { return canTransform && !hasTransformed; }
-    void setCanTransform(bool can) { canTransform = can; }
+    bool canBeTransformed() const { return archetype->canTransform && !hasTransformed; }
     
     // ========================================
     // 属性 Getters
     // ========================================
     float getHealth() const { return health; }
-    float getMaxHealth() const { return maxHealth; }
-    float getHealthPercent() const { return health / maxHealth; }
-    float getDefense() const { return defense; }
-    const std::string& getTreeType() const { return treeType; }
-    const std::string& getName() const { return name; }
+    float getMaxHealth() const { return archetype->maxHealth; }
+    float getHealthPercent() const { return health / archetype->maxHealth; }
+    float getDefense() const { return archetype->defense; }
+    const std::string& getTreeType() const { return archetype->treeType; }
+    const std::string& getName() const { return archetype->name; }
     bool isDead() const { return health <= 0; }
     bool hasFruit() const { return growthStage == TreeGrowthStage::Fruiting; }
     
     // ========================================
     // 属性 Setters
     // ========================================
-    void setHealth(float hp) { health = std::max(0.0f, std::min(hp, maxHealth)); }
-    void setMaxHealth(float hp) { maxHealth = hp; health = std::min(health, maxHealth); }
-    void setDefense(float def) { defense = def; }
-    void setName(const std::string& n) { name = n; }
+    void setHealth(float hp) { health = std::max(0.0f, std::min(hp, archetype->maxHealth)); }
     
     // ========================================
     // 位置和碰撞
     // ========================================
     sf::Vector2f getPosition() const { return position; }
-    void setPosition(float x, float y) { position = sf::Vector2f(x, y); updateSprite(); }
-    void setSize(float w, float h) { size = sf::Vector2f(w, h); updateSprite(); }
+    void setPosition(float x, float y) { position = sf::Vector2f(x, y); }
+    void setSize(float w, float h) { size = sf::Vector2f(w, h); }
     sf::Vector2f getSize() const { return size; }
     sf::FloatRect getBounds() const;
     sf::FloatRect getCollisionBox() const;  // 碰撞盒（通常比视觉范围小）
@@ -142,24 +198,27 @@ public:
     // ========================================
     // 掉落物品
     // ========================================
-    void addDropItem(const DropItem& item);
-    void clearDropItems();
-    const std::vector<DropItem>& getDropItems() const { return dropItems; }
-    const std::vector<DropItem>& getFruitDropItems() const { return fruitDropItems; }
-    void addFruitDropItem(const DropItem& item);
+    const std::vector<DropItem>& getDropItems() const { return archetype->dropItems; }
+    const std::vector<DropItem>& getFruitDropItems() const { return archetype->fruitDropItems; }
     
     // 生成掉落（返回实际掉落的物品列表）
-    std::vector<std::pair<std::string, int>> generateDrops();
-    std::vector<std::pair<std::string, int>> generateFruitDrops();
+    FrameVector<std::pair<std::string, int>> generateDrops();
+    FrameVector<std::pair<std::string, int>> generateFruitDrops();
     
     // 获取击杀奖励（随机范围内）
     int getExpReward() const;
     int getGoldReward() const;
-    int getExpMin() const { return expMin; }
-    int getExpMax() const { return expMax; }
-    int getGoldMin() const { return goldMin; }
-    int getGoldMax() const { return goldMax; }
-    int getDropMax() const { return dropMax; }
+    int getExpMin() const { return archetype->expMin; }
+    int getExpMax() const { return archetype->expMax; }
+    int getGoldMin() const { return archetype->goldMin; }
+    int getGoldMax() const { return archetype->goldMax; }
+    int getDropMax() const { return archetype->dropMax; }
+    
+    // ========================================
+    // 存档
+    // ========================================
+    TreeSaveData captureSaveData() const;
+    void applySaveData(const TreeSaveData& data);
     
     // ========================================
     // 悬浮提示
@@ -168,72 +227,44 @@ public:
     bool getHovered() const { return isHovered; }
     
     // ========================================
-    // 回调
+    // 事件（砍倒、采摘、生长变化压入 EventBus）
     // ========================================
-    using TreeCallback = std::function<void(Tree&)>;
-    void setOnDestroyed(TreeCallback cb) { onDestroyed = cb; }
-    void setOnFruitHarvested(TreeCallback cb) { onFruitHarvested = cb; }
-    void setOnGrowthStageChanged(TreeCallback cb) { onGrowthStageChanged = cb; }
+    void setHandle(TreeHandle h) { handle = h; }
+    TreeHandle getHandle() const { return handle; }
+    
+    // 玩家种下的树（砍伐不加农耕经验，采摘不加经验）
+    void setPlanted(bool value) { planted = value; }
+    bool isPlanted() const { return planted; }
 
 private:
-    void updateSprite();
     void spawnDropParticles(const sf::Vector2f& pos, int count);
     void updateDropParticles(float dt);
     
 private:
-    // === 基础属性 ===
-    std::string treeType;       // 树木类型 (oak, pine, apple, etc.)
-    std::string name;           // 显示名称
-    float health;
-    float maxHealth;
-    float defense;
+    // === 树种（共享，只读）===
+    const TreeArchetype* archetype;
     
     // === 位置 ===
     sf::Vector2f position;
     sf::Vector2f size;          // 树木尺寸
     
-    // === 生长 ===
+    // === 状态 ===
+    float health;
     TreeGrowthStage growthStage;
     float growthTimer;          // 当前阶段已生长时间
-    float seedlingTime;         // 幼苗阶段所需时间
-    float growingTime;          // 成长阶段所需时间
-    float matureTime;           // 成熟到结果所需时间
-    float fruitRegrowTime;      // 果实再生时间
-    
-    // === 变换 ===
-    bool canTransform;          // 是否可以变换成果树
     bool hasTransformed;        // 是否已经变换过
     
-    // === 渲染 ===
-    sf::Sprite sprite;
-    sf::Texture textureSeedling;
-    sf::Texture textureGrowing;
-    sf::Texture textureMature;
-    sf::Texture textureFruiting;
-    sf::Texture* currentTexture;
-    bool texturesLoaded;
-    
-    // === 掉落物品 ===
-    std::vector<DropItem> dropItems;        // 砍伐掉落
-    std::vector<DropItem> fruitDropItems;   // 果实掉落
-    std::vector<DropParticle> dropParticles;
-    
-    // === 击杀奖励 ===
-    int expMin;                 // 最小经验
-    int expMax;                 // 最大经验
-    int goldMin;                // 最小金币
-    int goldMax;                // 最大金币
-    int dropMax;                // 单个物品最大掉落数量
-    
     // === 交互状态 ===
     bool isHovered;
     float shakeTimer;           // 被砍时的震动
     float shakeIntensity;
     
-    // === 回调 ===
-    TreeCallback onDestroyed;
-    TreeCallback onFruitHarvested;
-    TreeCallback onGrowthStageChanged;
+    // === 掉落动画 ===
+    std::vector<DropParticle> dropParticles;
+    
+    // === 事件 ===
+    TreeHandle handle;          // 由 TreeManager 添加时设置
+    bool planted = false;
 };
 
 // ============================================================================
@@ -264,13 +295,33 @@ public:
     // 从TileProperty动态创建树（推荐使用）
     Tree* addTreeFromProperty(float x, float y, const struct TileProperty* prop);
     
+    // 树种原型：同一类型名 / 同一 TileProperty 只创建一次（清空树木时一并释放）
+    const TreeArchetype& getArchetype(const std::string& type);
+    const TreeArchetype& getArchetype(const TileProperty& prop);
+    size_t getArchetypeCount() const { return archetypes.size(); }
+    
     void removeTree(Tree* tree);
+    void removeTree(TreeHandle handle);
     void clearAllTrees();
     
+    // 句柄查找（失效时返回 nullptr）和指针换句柄（线性查找，未找到返回空句柄）
+    Tree* getTree(TreeHandle handle) const;
+    TreeHandle getHandle(const Tree* tree) const;
+    
     // 从地图对象加载树木
     void loadFromMapObjects(const std::vector<struct MapObject>& objects, 
                            float displayScale);
     
+    // ========================================
+    // 存档
+    // ========================================
+    std::vector<TreeSaveData> captureSaveData() const;
+    
+    // 恢复存档：按位置匹配地图上已有的树木并覆盖状态，
+    // 存档中不存在的（已被砍倒）移除，多出来的（玩家种植）新建。
+    // 返回新建的树木，由调用方标记为玩家种植。
+    std::vector<Tree*> applySaveData(const std::vector<TreeSaveData>& data);
+    
     // ========================================
     // 交互
     // ========================================
@@ -282,7 +333,7 @@ public:
     Tree* getTreeInRect(const sf::FloatRect& rect);
     
     // 对范围内的树木造成伤害
-    std::vector<Tree*> damageTreesInRange(const sf::Vector2f& center, 
+    FrameVector<Tree*> damageTreesInRange(const sf::Vector2f& center, 
                                           float radius, float damage);
     
     // 更新悬浮状态
@@ -293,11 +344,14 @@ public:
     // ========================================
     bool isCollidingWithAnyTree(const sf::FloatRect& rect) const;
     
+    // 障碍布局版本：增删树木、树木倒下或重生时递增（寻路流场据此重建障碍）
+    std::uint32_t getLayoutVersion() const { return layoutVersion; }
+    
     // ========================================
     // 获取器
     // ========================================
     size_t getTreeCount() const { return trees.size(); }
-    const std::vector<std::unique_ptr<Tree>>& getTrees() const { return trees; }
+    const std::vector<std::unique_ptr<Tree>>& getTrees() const { return trees.values(); }
     
     // ========================================
     // 字体设置（用于提示框）
@@ -307,8 +361,12 @@ public:
 private:
     void renderTooltip(sf::RenderWindow& window, Tree* tree);
     
+    // 读档时按存档里的类型名找回原型（优先保留地图原型，变换前后都能还原）
+    const TreeArchetype& findSavedArchetype(const Tree& tree, const std::string& type);
+    
 private:
-    std::vector<std::unique_ptr<Tree>> trees;
+    SlotMap<std::unique_ptr<Tree>, Tree> trees;
+    std::vector<std::unique_ptr<TreeArchetype>> archetypes;
     std::string assetsBasePath;
     
     // 字体（用于悬浮提示）
@@ -316,5 +374,9 @@ private:
     bool fontLoaded;
     
     // 当前悬浮的树木
-    Tree* hoveredTree;
+    TreeHandle hoveredTree;
+    
+    // 障碍布局版本和上次统计的存活树木数
+    std::uint32_t layoutVersion = 0;
+    size_t aliveCount = 0;
 };
\ No newline at end of file
@@ -1,105 +1,58 @@
 #include "WildPlant.h"
 #include "../World/TileMap.h"
-#include <iostream>
+#include "../Systems/InputSystem.h"
+#include "../Systems/Logger.h"
+#include "../Systems/RenderStats.h"
+#include "../Systems/FrameArena.h"
 #include <algorithm>
+#include <cmath>
 #include <sstream>
 
 #define U8(str) (const char*)u8##str
 
 // ============================================================================
-// WildPlant 构造函数
+// 植物原型
 // ============================================================================
 
-WildPlant::WildPlant()
-    : plantType("carrot")
-    , name("胡萝卜")
-    , type(WildPlantType::Carrot)
-    , allowPickup(true)
-    , dropInfo("carrot", "胡萝卜", 1, 2)
-    , probability(0.4f)
-    , isPickedUp(false)
-    , position(0, 0)
-    , size(32, 32)
-    , hasCustomCollision(false)
-    , textureLoaded(false)
-    , isHovered(false)
-    , onPickup(nullptr)
-{
-    rng.seed(std::random_device{}());
-}
-
-WildPlant::WildPlant(float x, float y, const std::string& plantTypeStr)
-    : WildPlant()
-{
-    init(x, y, plantTypeStr);
-}
-
-void WildPlant::init(float x, float y, const std::string& plantTypeStr) {
-    position = sf::Vector2f(x, y);
-    plantType = plantTypeStr;
-    type = parseType(plantTypeStr);
+std::unique_ptr<PlantArchetype> PlantArchetype::fromType(const std::string& plantTypeStr) {
+    auto archetype = std::make_unique<PlantArchetype>();
+    archetype->plantType = plantTypeStr;
+    archetype->name = "胡萝卜";
     
     // 根据类型设置属性
     if (plantTypeStr == "carrot" || plantTypeStr == "carrot_plant") {
-        name = "胡萝卜";
-        type = WildPlantType::Carrot;
-        dropInfo = PlantDropInfo("carrot", "胡萝卜", 1, 2);
-        size = sf::Vector2f(32, 32);
+        archetype->type = WildPlantType::Carrot;
+        archetype->dropInfo = PlantDropInfo("carrot", "胡萝卜", 1, 2);
     } else if (plantTypeStr == "bean" || plantTypeStr == "bean_plant") {
-        name = "豆子";
-        type = WildPlantType::Bean;
-        dropInfo = PlantDropInfo("bean", "豆子", 1, 3);
-        size = sf::Vector2f(32, 32);
+        archetype->name = "豆子";
+        archetype->type = WildPlantType::Bean;
+        archetype->dropInfo = PlantDropInfo("bean", "豆子", 1, 3);
     }
     
-    updateSprite();
-}
-
-WildPlantType WildPlant::parseType(const std::string& typeStr) {
-    if (typeStr == "carrot" || typeStr == "carrot_plant") {
-        return WildPlantType::Carrot;
-    } else if (typeStr == "bean" || typeStr == "bean_plant") {
-        return WildPlantType::Bean;
-    }
-    return WildPlantType::Unknown;
+    return archetype;
 }
 
-// ============================================================================
-// 从 TileProperty 动态初始化（推荐使用）
-// ============================================================================
-
-void WildPlant::initFromTileProperty(float x, float y, const TileProperty* prop) {
-    position = sf::Vector2f(x, y);
-    
-    if (!prop) {
-        plantType = "carrot";
-        name = "野生植物";
-        type = WildPlantType::Unknown;
-        size = sf::Vector2f(32, 32);
-        allowPickup = true;  // 默认允许拾取
-        updateSprite();
-        return;
-    }
+std::unique_ptr<PlantArchetype> PlantArchetype::fromTileProperty(const TileProperty& prop) {
+    auto archetype = std::make_unique<PlantArchetype>();
+    archetype->source = &prop;
     
     // 从 TileProperty 设置属性
-    plantType = prop->name;
-    name = prop->name;
+    archetype->plantType = prop.name;
+    archetype->name = prop.name;
     
     // 解析植物类型名以确定类型
-    if (prop->name.find("carrot") != std::string::npos) {
-        type = WildPlantType::Carrot;
-        name = "胡萝卜";
-    } else if (prop->name.find("bean") != std::string::npos) {
-        type = WildPlantType::Bean;
-        name = "豆子";
-    } else {
-        type = WildPlantType::Unknown;
+    if (prop.name.find("carrot") != std::string::npos) {
+        archetype->type = WildPlantType::Carrot;
+        archetype->name = "胡萝卜";
+    } else if (prop.name.find("bean") != std::string::npos) {
+        archetype->type = WildPlantType::Bean;
+        archetype->name = "豆子";
     }
     
     // 设置掉落物品 - 优先使用 pickupObject
-    std::string itemId = prop->pickupObject;
-    if (itemId.empty() && !prop->dropTypes.empty()) {
-        itemId = prop->dropTypes[0];
+    std::string itemId = prop.pickupObject;
+    if (itemId.empty() && !prop.dropTypes.empty()) {
+        itemId = prop.dropTypes[0];
     }
     
     // 移除引号
@@ -109,9 +62,9 @@ void WildPlant::initFromTileProperty(float x, float y, const TileProperty* prop)
     
     // 如果没有设置itemId，根据植物类型自动设置
     if (itemId.empty()) {
-        if (type == WildPlantType::Carrot) {
+        if (archetype->type == WildPlantType::Carrot) {
             itemId = "carrot";
-        } else if (type == WildPlantType::Bean) {
+        } else if (archetype->type == WildPlantType::Bean) {
             itemId = "bean";
         }
     }
@@ -122,51 +75,44 @@ void WildPlant::initFromTileProperty(float x, float y, const TileProperty* prop)
         else if (itemId == "bean") itemName = "豆子";
         
         // 从 prop 读取 count_min 和 count_max
-        int minCount = prop->countMin > 0 ? prop->countMin : 1;
-        int maxCount = prop->countMax > 0 ? prop->countMax : 2;
+        int minCount = prop.countMin > 0 ? prop.countMin : 1;
+        int maxCount = prop.countMax > 0 ? prop.countMax : 2;
         
-        dropInfo = PlantDropInfo(itemId, itemName, minCount, maxCount);
+        archetype->dropInfo = PlantDropInfo(itemId, itemName, minCount, maxCount);
         
-        std::cout << "[WildPlant] Drop info set: " << itemId << " x" << minCount << "-" << maxCount << std::endl;
+        LOG_DEBUG("[WildPlant] Drop info set: " << itemId << " x" << minCount << "-" << maxCount);
     }
     
     // 设置允许拾取 - 如果有掉落物品或显式设置了allow_pick，就允许拾取
-    allowPickup = prop->allowPickup || !dropInfo.itemId.empty();
+    archetype->allowPickup = prop.allowPickup || !archetype->dropInfo.itemId.empty();
     
-    std::cout << "[WildPlant] " << name << " allowPickup=" << (allowPickup ? "true" : "false") 
-              << " itemId=" << dropInfo.itemId << std::endl;
+    LOG_DEBUG("[WildPlant] " << archetype->name << " allowPickup=" << (archetype->allowPickup ? "true" : "false") 
+          << " itemId=" << archetype->dropInfo.itemId);
     
     // 设置生成概率
-    probability = prop->probability;
+    archetype->probability = prop.probability;
     
-    // 设置大小
-    size = sf::Vector2f(32, 32);  // 默认32x32
-    
-    updateSprite();
-}
-
-void WildPlant::setTextureFromProperty(const TileProperty* prop) {
-    if (!prop || !prop->hasTexture || !prop->texture) {
-        return;
+    // 贴图与地图共享，不复制
+    if (prop.hasTexture && prop.texture) {
+        archetype->texture = prop.texture;
+        LOG_INFO("[WildPlant] Loaded texture: " << prop.name);
     }
     
-    texture = *prop->texture;
-    sprite.setTexture(texture);
-    textureLoaded = true;
-    std::cout << "[WildPlant] Loaded texture: " << prop->name << std::endl;
-    updateSprite();
+    return archetype;
 }
 
-bool WildPlant::loadTexture(const std::string& texturePath) {
-    if (!texture.loadFromFile(texturePath)) {
-        std::cerr << "WildPlant: 无法加载贴图 " << texturePath << std::endl;
-        textureLoaded = false;
-        return false;
-    }
-    sprite.setTexture(texture);
-    textureLoaded = true;
-    updateSprite();
-    return true;
+// ============================================================================
+// WildPlant 构造函数
+// ============================================================================
+
+WildPlant::WildPlant(const PlantArchetype& archetype, float x, float y)
+    : archetype(&archetype)
+    , position(x, y)
+    , size(archetype.defaultSize)
+    , isPickedUp(false)
+    , isHovered(false)
+    , rng(RandomService::getInstance().makeEntityStream(RngStream::WildPlant))
+{
 }
 
 // ============================================================================
@@ -180,15 +126,21 @@ void WildPlant::update(float dt) {
 void WildPlant::render(sf::RenderWindow& window) {
     if (isPickedUp) return;  // 已被拾取则不渲染
     
-    if (textureLoaded) {
-        window.draw(sprite);
+    const sf::Texture* texture = archetype->texture.get();
+    if (texture && texture->getSize().x > 0 && texture->getSize().y > 0) {
+        // 精灵在绘制时现建（底部对齐）：贴图属于原型，实例不保存 sf::Sprite
+        sf::Sprite sprite(*texture);
+        sf::Vector2u texSize = texture->getSize();
+        sprite.setScale(size.x / texSize.x, size.y / texSize.y);
+        sprite.setPosition(position.x, position.y - size.y);
+        RenderStats::draw(window, sprite);
     } else {
         // 没有贴图时画一个颜色块
         sf::RectangleShape placeholder(size);
         placeholder.setPosition(position.x, position.y - size.y);
         
         // 根据类型设置颜色
-        switch (type) {
+        switch (archetype->type) {
             case WildPlantType::Carrot:
                 placeholder.setFillColor(sf::Color(255, 140, 0));  // 橙色
                 break;
@@ -206,22 +158,7 @@ void WildPlant::render(sf::RenderWindow& window) {
             placeholder.setOutlineColor(sf::Color::Yellow);
         }
         
-        window.draw(placeholder);
-    }
-}
-
-void WildPlant::updateSprite() {
-    if (!textureLoaded) return;
-    
-    // 设置精灵位置（底部对齐）
-    sprite.setPosition(position.x, position.y - size.y);
-    
-    // 根据贴图大小调整缩放
-    sf::Vector2u texSize = texture.getSize();
-    if (texSize.x > 0 && texSize.y > 0) {
-        float scaleX = size.x / texSize.x;
-        float scaleY = size.y / texSize.y;
-        sprite.setScale(scaleX, scaleY);
+        RenderStats::draw(window, placeholder);
     }
 }
 
@@ -231,60 +168,47 @@ void WildPlant::updateSprite() {
 
 std::vector<std::pair<std::string, int>> WildPlant::pickup() {
     std::vector<std::pair<std::string, int>> drops;
+    const PlantDropInfo& dropInfo = archetype->dropInfo;
     
-    std::cout << "[WildPlant::pickup] Attempting pickup: " << name 
-              << " canPickup=" << (canPickup() ? "true" : "false")
-              << " allowPickup=" << (allowPickup ? "true" : "false")
-              << " isPickedUp=" << (isPickedUp ? "true" : "false")
-              << " itemId=" << dropInfo.itemId << std::endl;
+    LOG_DEBUG("[WildPlant::pickup] Attempting pickup: " << archetype->name 
+          << " canPickup=" << (canPickup() ? "true" : "false")
+          << " allowPickup=" << (archetype->allowPickup ? "true" : "false")
+          << " isPickedUp=" << (isPickedUp ? "true" : "false")
+          << " itemId=" << dropInfo.itemId);
     
     if (!canPickup()) {
-        std::cout << "[WildPlant::pickup] Cannot pickup!" << std::endl;
+        LOG_DEBUG("[WildPlant::pickup] Cannot pickup!");
         return drops;
     }
     
     // 随机数量
-    std::uniform_int_distribution<int> dist(dropInfo.countMin, dropInfo.countMax);
-    int count = dist(rng);
+    int count = rng.range(dropInfo.countMin, dropInfo.countMax);
     
     if (count > 0 && !dropInfo.itemId.empty()) {
         drops.push_back({dropInfo.itemId, count});
-        std::cout << "[WildPlant::pickup] Generated drop: " << dropInfo.itemId << " x" << count << std::endl;
+        LOG_DEBUG("[WildPlant::pickup] Generated drop: " << dropInfo.itemId << " x" << count);
     } else {
-        std::cout << "[WildPlant::pickup] No drops generated! count=" << count << " itemId=" << dropInfo.itemId << std::endl;
+        LOG_INFO("[WildPlant::pickup] No drops generated! count=" << count << " itemId=" << dropInfo.itemId);
     }
     
     // 标记为已拾取
     isPickedUp = true;
     
-    // 触发回调
-    if (onPickup) {
-        onPickup(*this);
-    }
-    
-    std::cout << "拾取了 " << name << " x" << count << std::endl;
+    LOG_DEBUG("拾取了 " << archetype->name << " x" << count);
     
     return drops;
 }
 
-void WildPlant::setPickupItem(const std::string& itemId, int minCount, int maxCount) {
-    dropInfo.itemId = itemId;
-    dropInfo.countMin = minCount;
-    dropInfo.countMax = maxCount;
-}
-
 // ============================================================================
 // 位置和碰撞
 // ============================================================================
 
 void WildPlant::setPosition(float x, float y) {
     position = sf::Vector2f(x, y);
-    updateSprite();
 }
 
 void WildPlant::setPosition(const sf::Vector2f& pos) {
     position = pos;
-    updateSprite();
 }
 
 sf::FloatRect WildPlant::getBounds() const {
@@ -292,7 +216,8 @@ sf::FloatRect WildPlant::getBounds() const {
 }
 
 sf::FloatRect WildPlant::getCollisionBox() const {
-    if (hasCustomCollision) {
+    if (archetype->hasCustomCollision) {
+        const sf::FloatRect& collisionBox = archetype->collisionBox;
         return sf::FloatRect(
             position.x + collisionBox.left,
             position.y - size.y + collisionBox.top,
@@ -326,7 +251,6 @@ bool WildPlant::intersects(const sf::FloatRect& rect) const {
 
 WildPlantManager::WildPlantManager()
     : fontLoaded(false)
-    , hoveredPlant(nullptr)
 {
 }
 
@@ -352,7 +276,7 @@ bool WildPlantManager::init(const std::string& assetsPath) {
 bool WildPlantManager::loadFont(const std::string& fontPath) {
     if (font.loadFromFile(fontPath)) {
         fontLoaded = true;
-        std::cout << "[WildPlantManager] Font loaded: " << fontPath << std::endl;
+        LOG_INFO("[WildPlantManager] Font loaded: " << fontPath);
         return true;
     }
     return false;
@@ -387,8 +311,9 @@ void WildPlantManager::render(sf::RenderWindow& window, const sf::View& view) {
 void WildPlantManager::renderTooltips(sf::RenderWindow& window, const sf::Vector2f& mouseWorldPos) {
     updateHover(mouseWorldPos);
     
-    if (hoveredPlant && fontLoaded) {
-        renderTooltip(window, hoveredPlant);
+    WildPlant* hovered = getPlant(hoveredPlant);
+    if (hovered && fontLoaded) {
+        renderTooltip(window, hovered);
     }
 }
 
@@ -396,11 +321,11 @@ void WildPlantManager::renderTooltip(sf::RenderWindow& window, WildPlant* plant)
     if (!plant || !fontLoaded) return;
     
     // 获取鼠标屏幕位置
-    sf::Vector2i mouseScreenPos = sf::Mouse::getPosition(window);
+    sf::Vector2i mouseScreenPos = InputSystem::getInstance().getMousePosition();
     float tooltipX = mouseScreenPos.x + 20.0f;
     float tooltipY = mouseScreenPos.y + 20.0f;
     
-    std::vector<sf::String> lines;
+    FrameVector<sf::String> lines;
     
     // 标题（名称）
     lines.push_back(sf::String::fromUtf8(plant->getName().begin(), plant->getName().end()));
@@ -470,13 +395,13 @@ void WildPlantManager::renderTooltip(sf::RenderWindow& window, WildPlant* plant)
     bg.setFillColor(sf::Color(20, 30, 20, 240));
     bg.setOutlineThickness(3);
     bg.setOutlineColor(sf::Color(80, 140, 80));
-    window.draw(bg);
+    RenderStats::draw(window, bg);
     
     // 绘制标题栏
     sf::RectangleShape titleBar(sf::Vector2f(tooltipWidth, lineHeight + 8));
     titleBar.setPosition(tooltipX, tooltipY);
     titleBar.setFillColor(sf::Color(40, 70, 40, 200));
-    window.draw(titleBar);
+    RenderStats::draw(window, titleBar);
     
     // 绘制文本
     float currentY = tooltipY + padding;
@@ -506,7 +431,7 @@ void WildPlantManager::renderTooltip(sf::RenderWindow& window, WildPlant* plant)
             text.setFillColor(sf::Color(180, 180, 180));  // 默认灰色
         }
         
-        window.draw(text);
+        RenderStats::draw(window, text);
         currentY += lineHeight;
     }
     
@@ -515,36 +440,63 @@ void WildPlantManager::renderTooltip(sf::RenderWindow& window, WildPlant* plant)
 }
 
 WildPlant* WildPlantManager::addPlant(float x, float y, const std::string& type) {
-    auto plant = std::make_unique<WildPlant>(x, y, type);
+    auto plant = std::make_unique<WildPlant>(getArchetype(type), x, y);
     WildPlant* ptr = plant.get();
-    plants.push_back(std::move(plant));
+    plants.insert(std::move(plant));
     return ptr;
 }
 
 WildPlant* WildPlantManager::addPlantFromProperty(float x, float y, const TileProperty* prop) {
-    auto plant = std::make_unique<WildPlant>();
-    plant->initFromTileProperty(x, y, prop);
-    
-    if (prop) {
-        plant->setTextureFromProperty(prop);
-    }
+    // 没有属性信息时按默认类型创建
+    if (!prop) return addPlant(x, y, "carrot");
     
+    auto plant = std::make_unique<WildPlant>(getArchetype(*prop), x, y);
     WildPlant* ptr = plant.get();
-    plants.push_back(std::move(plant));
+    plants.insert(std::move(plant));
     return ptr;
 }
 
-void WildPlantManager::removePlant(WildPlant* plant) {
-    auto it = std::find_if(plants.begin(), plants.end(),
-        [plant](const std::unique_ptr<WildPlant>& p) { return p.get() == plant; });
-    if (it != plants.end()) {
-        plants.erase(it);
+const PlantArchetype& WildPlantManager::getArchetype(const std::string& type) {
+    for (const auto& archetype : archetypes) {
+        if (!archetype->source && archetype->plantType == type) return *archetype;
+    }
+    archetypes.push_back(PlantArchetype::fromType(type));
+    return *archetypes.back();
+}
+
+const PlantArchetype& WildPlantManager::getArchetype(const TileProperty& prop) {
+    for (const auto& archetype : archetypes) {
+        if (archetype->source == &prop) return *archetype;
     }
+    archetypes.push_back(PlantArchetype::fromTileProperty(prop));
+    return *archetypes.back();
+}
+
+void WildPlantManager::removePlant(WildPlant* plant) {
+    plants.removeIf([plant](const std::unique_ptr<WildPlant>& p) { return p.get() == plant; });
+}
+
+void WildPlantManager::removePlant(PlantHandle handle) {
+    plants.remove(handle);
 }
 
 void WildPlantManager::clearAllPlants() {
     plants.clear();
-    hoveredPlant = nullptr;
+    archetypes.clear();     // 换地图后旧 TileProperty 地址可能被复用
+}
+
+WildPlant* WildPlantManager::getPlant(PlantHandle handle) const {
+    const auto* slot = plants.get(handle);
+    return slot ? slot->get() : nullptr;
+}
+
+PlantHandle WildPlantManager::getHandle(const WildPlant* plant) const {
+    for (size_t i = 0; i < plants.size(); i++) {
+        if (plants[i].get() == plant) {
+            return plants.handleAt(i);
+        }
+    }
+    return PlantHandle{};
 }
 
 void WildPlantManager::loadFromMapObjects(const std::vector<MapObject>& objects, float displayScale) {
@@ -567,7 +519,7 @@ void WildPlantManager::loadFromMapObjects(const std::vector<MapObject>& objects,
         }
     }
     
-    std::cout << "[WildPlantManager] Loaded " << plants.size() << " wild plants from map" << std::endl;
+    LOG_INFO("[WildPlantManager] Loaded " << plants.size() << " wild plants from map");
 }
 
 WildPlant* WildPlantManager::getPlantAt(const sf::Vector2f& position) {
@@ -592,7 +544,7 @@ WildPlant* WildPlantManager::getPickablePlantInRange(const sf::Vector2f& center,
     WildPlant* closest = nullptr;
     float closestDist = range * range;
     
-    std::cout << "[DEBUG] getPickablePlantInRange: checking " << plants.size() << " plants" << std::endl;
+    LOG_DEBUG("[DEBUG] getPickablePlantInRange: checking " << plants.size() << " plants");
     
     for (auto& plant : plants) {
         if (plant) {
@@ -601,10 +553,10 @@ WildPlant* WildPlantManager::getPickablePlantInRange(const sf::Vector2f& center,
             float dy = plantPos.y - center.y;
             float distSq = dx * dx + dy * dy;
             
-            std::cout << "[DEBUG] Plant '" << plant->getName() 
-                      << "' collected=" << (plant->isCollected() ? "true" : "false")
-                      << " canPickup=" << (plant->canPickup() ? "true" : "false")
-                      << " dist=" << std::sqrt(distSq) << std::endl;
+            LOG_DEBUG("[DEBUG] Plant '" << plant->getName() 
+                   << "' collected=" << (plant->isCollected() ? "true" : "false")
+                   << " canPickup=" << (plant->canPickup() ? "true" : "false")
+                   << " dist=" << std::sqrt(distSq));
             
             if (!plant->isCollected() && plant->canPickup()) {
                 if (distSq < closestDist) {
@@ -626,14 +578,15 @@ std::vector<std::pair<std::string, int>> WildPlantManager::pickupPlant(WildPlant
 }
 
 void WildPlantManager::updateHover(const sf::Vector2f& mouseWorldPos) {
-    hoveredPlant = nullptr;
+    hoveredPlant = PlantHandle{};
     
-    for (auto& plant : plants) {
+    for (size_t i = 0; i < plants.size(); i++) {
+        WildPlant* plant = plants[i].get();
         if (plant && !plant->isCollected()) {
             bool hovered = plant->containsPoint(mouseWorldPos);
             plant->setHovered(hovered);
             if (hovered) {
-                hoveredPlant = plant.get();
+                hoveredPlant = plants.handleAt(i);
             }
         }
     }
@@ -651,15 +604,8 @@ bool WildPlantManager::isCollidingWithAnyPlant(const sf::FloatRect& rect) const
 }
 
 void WildPlantManager::removePickedPlants() {
-    plants.erase(
-        std::remove_if(plants.begin(), plants.end(),
-            [](const std::unique_ptr<WildPlant>& p) { 
-                return p && p->isCollected(); 
-            }),
-        plants.end()
-    );
-    
-    if (hoveredPlant && hoveredPlant->isCollected()) {
-        hoveredPlant = nullptr;
-    }
+    // 被删除植物的句柄随之失效，hoveredPlant 无需单独处理
+    plants.removeIf([](const std::unique_ptr<WildPlant>& p) {
+        return p && p->isCollected();
+    });
 }
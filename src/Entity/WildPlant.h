@@ -2,9 +2,9 @@
 #include <SFML/Graphics.hpp>
 #include <string>
 #include <vector>
-#include <functional>
 #include <memory>
-#include <random>
+#include "../Systems/Random.h"
+#include "../Systems/SlotMap.h"
 
 // ============================================================================
 // 野生植物系统 (Wild Plant System)
@@ -39,23 +39,45 @@ struct PlantDropInfo {
         : itemId(id), name(n), countMin(min), countMax(max) {}
 };
 
+struct TileProperty;
+
+// ============================================================================
+// 植物原型 (Flyweight)
+//
+// 同一个 TileProperty（或同一个类型名）的植物共享名称、掉落信息、生成概率
+// 和贴图；由 WildPlantManager 创建并持有。
+// ============================================================================
+
+struct PlantArchetype {
+    std::string plantType;          // 植物类型名 (carrot, bean)
+    std::string name;               // 显示名称
+    WildPlantType type = WildPlantType::Unknown;
+    
+    // === 拾取属性 ===
+    bool allowPickup = true;        // 是否允许拾取
+    PlantDropInfo dropInfo = PlantDropInfo("carrot", "胡萝卜", 1, 2);
+    float probability = 0.4f;       // 生成概率 (0-1)
+    
+    // === 大小和碰撞 ===
+    sf::Vector2f defaultSize = sf::Vector2f(32, 32);
+    sf::FloatRect collisionBox;     // 自定义碰撞盒（从tsx读取）
+    bool hasCustomCollision = false;
+    
+    // === 渲染（与地图的 TileProperty 共享；为空时画颜色块）===
+    std::shared_ptr<sf::Texture> texture;
+    
+    const TileProperty* source = nullptr;   // 按类型名创建时为空
+    
+    static std::unique_ptr<PlantArchetype> fromType(const std::string& plantType);
+    static std::unique_ptr<PlantArchetype> fromTileProperty(const TileProperty& prop);
+};
+
 class WildPlant {
 public:
-    WildPlant();
-    WildPlant(float x, float y, const std::string& plantType = "carrot");
+    WildPlant(const PlantArchetype& archetype, float x, float y);
     virtual ~WildPlant() = default;
     
-    // ========================================
-    // 初始化
-    // ========================================
-    void init(float x, float y, const std::string& plantType);
-    
-    // 从地图对象的TileProperty动态初始化（推荐使用）
-    void initFromTileProperty(float x, float y, const struct TileProperty* prop);
-    
-    // 设置贴图
-    void setTextureFromProperty(const struct TileProperty* prop);
-    bool loadTexture(const std::string& texturePath);
+    const PlantArchetype& getArchetype() const { return *archetype; }
     
     // ========================================
     // 更新和渲染
@@ -68,7 +90,7 @@ public:
     // ========================================
     
     // 检查是否可以拾取
-    bool canPickup() const { return allowPickup && !isPickedUp; }
+    bool canPickup() const { return archetype->allowPickup && !isPickedUp; }
     
     // 执行拾取，返回获得的物品列表 (itemId, count)
     std::vector<std::pair<std::string, int>> pickup();
@@ -89,76 +111,48 @@ public:
     // ========================================
     sf::Vector2f getPosition() const { return position; }
     sf::Vector2f getSize() const { return size; }
-    const std::string& getPlantType() const { return plantType; }
-    const std::string& getName() const { return name; }
-    float getProbability() const { return probability; }
-    WildPlantType getType() const { return type; }
-    const PlantDropInfo& getDropInfo() const { return dropInfo; }
+    const std::string& getPlantType() const { return archetype->plantType; }
+    const std::string& getName() const { return archetype->name; }
+    float getProbability() const { return archetype->probability; }
+    WildPlantType getType() const { return archetype->type; }
+    const PlantDropInfo& getDropInfo() const { return archetype->dropInfo; }
     
     // ========================================
     // 属性 Setters
     // ========================================
     void setPosition(float x, float y);
     void setPosition(const sf::Vector2f& pos);
-    void setSize(float w, float h) { size = sf::Vector2f(w, h); updateSprite(); }
-    void setName(const std::string& n) { name = n; }
-    void setAllowPickup(bool allow) { allowPickup = allow; }
-    void setProbability(float prob) { probability = prob; }
-    void setPickupItem(const std::string& itemId, int minCount, int maxCount);
+    void setSize(float w, float h) { size = sf::Vector2f(w, h); }
     
     // ========================================
     // 悬浮提示
     // ========================================
     void setHovered(bool hovered) { isHovered = hovered; }
     bool getHovered() const { return isHovered; }
-    
-    // ========================================
-    // 回调
-    // ========================================
-    using PlantCallback = std::function<void(WildPlant&)>;
-    void setOnPickup(PlantCallback cb) { onPickup = cb; }
-
-private:
-    void updateSprite();
-    WildPlantType parseType(const std::string& typeStr);
 
 private:
-    // === 基础属性 ===
-    std::string plantType;      // 植物类型名 (carrot, bean)
-    std::string name;           // 显示名称
-    WildPlantType type;         // 植物类型枚举
-    
-    // === 拾取属性 ===
-    bool allowPickup;           // 是否允许拾取
-    PlantDropInfo dropInfo;     // 掉落物品信息
-    float probability;          // 生成概率 (0-1)
-    bool isPickedUp;            // 是否已被拾取
+    // === 植物种类（共享，只读）===
+    const PlantArchetype* archetype;
     
     // === 位置和大小 ===
     sf::Vector2f position;
     sf::Vector2f size;
-    sf::FloatRect collisionBox; // 自定义碰撞盒（从tsx读取）
-    bool hasCustomCollision;    // 是否有自定义碰撞盒
     
-    // === 渲染 ===
-    sf::Sprite sprite;
-    sf::Texture texture;
-    bool textureLoaded;
-    
-    // === 交互状态 ===
+    // === 状态 ===
+    bool isPickedUp;            // 是否已被拾取
     bool isHovered;
     
-    // === 随机数生成 ===
-    mutable std::mt19937 rng;
-    
-    // === 回调 ===
-    PlantCallback onPickup;
+    // === 随机数生成（实体独立流）===
+    mutable Rng rng;
 };
 
 // ============================================================================
 // 野生植物管理器
 // ============================================================================
 
+// 跨帧保存植物用句柄（植物被删除后查找返回 nullptr）
+using PlantHandle = Handle<WildPlant>;
+
 class WildPlantManager {
 public:
     WildPlantManager();
@@ -183,9 +177,19 @@ public:
     // 从TileProperty动态创建植物（推荐使用）
     WildPlant* addPlantFromProperty(float x, float y, const struct TileProperty* prop);
     
+    // 植物原型：同一类型名 / 同一 TileProperty 只创建一次（清空植物时一并释放）
+    const PlantArchetype& getArchetype(const std::string& type);
+    const PlantArchetype& getArchetype(const TileProperty& prop);
+    size_t getArchetypeCount() const { return archetypes.size(); }
+    
     void removePlant(WildPlant* plant);
+    void removePlant(PlantHandle handle);
     void clearAllPlants();
     
+    // 句柄查找（失效时返回 nullptr）和指针换句柄（线性查找，未找到返回空句柄）
+    WildPlant* getPlant(PlantHandle handle) const;
+    PlantHandle getHandle(const WildPlant* plant) const;
+    
     // 从地图对象加载植物
     void loadFromMapObjects(const std::vector<struct MapObject>& objects, 
                             float displayScale);
@@ -218,7 +222,7 @@ public:
     // 获取器
     // ========================================
     size_t getPlantCount() const { return plants.size(); }
-    const std::vector<std::unique_ptr<WildPlant>>& getPlants() const { return plants; }
+    const std::vector<std::unique_ptr<WildPlant>>& getPlants() const { return plants.values(); }
     
     // ========================================
     // 移除已拾取的植物
@@ -234,7 +238,8 @@ private:
     void renderTooltip(sf::RenderWindow& window, WildPlant* plant);
     
 private:
-    std::vector<std::unique_ptr<WildPlant>> plants;
+    SlotMap<std::unique_ptr<WildPlant>, WildPlant> plants;
+    std::vector<std::unique_ptr<PlantArchetype>> archetypes;
     std::string assetsBasePath;
     
     // 字体（用于悬浮提示）
@@ -242,5 +247,5 @@ private:
     bool fontLoaded;
     
     // 当前悬浮的植物
-    WildPlant* hoveredPlant;
+    PlantHandle hoveredPlant;
 };
@@ -1,6 +1,7 @@
 #include "CategoryInventory.h"
+#include "../Systems/Logger.h"
+#include "../Systems/EventBus.h"
 #include <algorithm>
-#include <iostream>
 
 CategoryInventory::CategoryInventory() {
     // 初始化所有格子为空
@@ -33,11 +34,20 @@ std::array<ItemStack, CATEGORY_SLOTS>& getCategoryArray(
 // ============================================================================
 
 int CategoryInventory::addItem(const std::string& itemId, int count) {
-    if (itemId.empty() || count <= 0) return 0;
+    ItemId id = ItemDatabase::getInstance().getItemId(itemId);
+    if (id == INVALID_ITEM_ID) {
+        LOG_INFO("[CategoryInventory] Unknown item : " << itemId);
+        return 0;
+    }
+    return addItem(id, count);
+}
+
+int CategoryInventory::addItem(ItemId itemId, int count) {
+    if (itemId == INVALID_ITEM_ID || count <= 0) return 0;
     
     const ItemData* data = ItemDatabase::getInstance().getItemData(itemId);
     if (!data) {
-        std::cout << "[CategoryInventory] Unknown item : " << itemId << std::endl;
+        LOG_INFO("[CategoryInventory] Unknown item : " << itemId);
         return 0;
     }
     
@@ -66,11 +76,10 @@ int CategoryInventory::addItem(const std::string& itemId, int count) {
         int slotIndex = findStackableSlot(category, itemId);
         if (slotIndex < 0) break;
         
-        ItemStack& slot = (*slots)[slotIndex];
-        int canAdd = data->maxStack - slot.count;
+        int canAdd = data->maxStack - (*slots)[slotIndex].count;
         int toAdd = std::min(canAdd, remaining);
         
-        slot.count += toAdd;
+        changeSlotCount(category, slotIndex, toAdd);
         remaining -= toAdd;
         totalAdded += toAdd;
         
@@ -83,7 +92,7 @@ int CategoryInventory::addItem(const std::string& itemId, int count) {
         if (slotIndex < 0) break;
         
         int toAdd = std::min(data->maxStack, remaining);
-        (*slots)[slotIndex] = ItemStack(itemId, toAdd);
+        setSlot(category, slotIndex, ItemStack(itemId, toAdd));
         remaining -= toAdd;
         totalAdded += toAdd;
         
@@ -92,13 +101,13 @@ int CategoryInventory::addItem(const std::string& itemId, int count) {
     
     if (totalAdded > 0) {
         notifyInventoryChanged();
-        std::cout << "[CategoryInventory] Added " << totalAdded << "x " << data->name 
-                  << " to " << getCategoryName(category) << std::endl;
+        LOG_DEBUG("[CategoryInventory] Added " << totalAdded << "x " << data->name 
+              << " to " << getCategoryName(category));
     }
     
     if (remaining > 0) {
-        std::cout << "[CategoryInventory] Could not add " << remaining << "x " << itemId 
-                  << " (" << getCategoryName(category) << " full)" << std::endl;
+        LOG_INFO("[CategoryInventory] Could not add " << remaining << "x " << data->id 
+              << " (" << getCategoryName(category) << " full)");
     }
     
     return totalAdded;
@@ -109,38 +118,32 @@ int CategoryInventory::addItemStack(const ItemStack& stack) {
 }
 
 int CategoryInventory::removeItem(const std::string& itemId, int count) {
-    if (itemId.empty() || count <= 0) return 0;
+    return removeItem(ItemDatabase::getInstance().getItemId(itemId), count);
+}
+
+int CategoryInventory::removeItem(ItemId itemId, int count) {
+    if (itemId == INVALID_ITEM_ID || count <= 0) return 0;
     
     const ItemData* data = ItemDatabase::getInstance().getItemData(itemId);
     if (!data) return 0;
     
-    InventoryCategory category = getItemCategory(data->type);
-    if (isSeed(itemId)) category = InventoryCategory::Consumables;
-    
-    std::array<ItemStack, CATEGORY_SLOTS>* slots = nullptr;
-    switch (category) {
-        case InventoryCategory::Materials:   slots = &materialSlots; break;
-        case InventoryCategory::Consumables: slots = &consumableSlots; break;
-        case InventoryCategory::Equipment:   slots = &equipmentSlots; break;
-        default: return 0;
-    }
+    if (itemId >= itemSlotIndex.size() || itemSlotIndex[itemId].empty()) return 0;
     
     int remaining = count;
     int totalRemoved = 0;
     
-    for (int i = CATEGORY_SLOTS - 1; i >= 0 && remaining > 0; i--) {
-        if ((*slots)[i].itemId == itemId) {
-            int toRemove = std::min((*slots)[i].count, remaining);
-            (*slots)[i].count -= toRemove;
-            remaining -= toRemove;
-            totalRemoved += toRemove;
-            
-            notifyItemRemoved(ItemStack(itemId, toRemove), i, category);
-            
-            if ((*slots)[i].count <= 0) {
-                (*slots)[i].clear();
-            }
-        }
+    // 从后往前移除（保持前面的物品）；拷贝一份，移除过程中索引会变化
+    std::vector<std::uint16_t> occupied = itemSlotIndex[itemId];
+    for (auto it = occupied.rbegin(); it != occupied.rend() && remaining > 0; ++it) {
+        InventoryCategory category = static_cast<InventoryCategory>(*it / CATEGORY_SLOTS);
+        int i = *it % CATEGORY_SLOTS;
+        
+        int toRemove = std::min(getSlot(category, i).count, remaining);
+        changeSlotCount(category, i, -toRemove);
+        remaining -= toRemove;
+        totalRemoved += toRemove;
+        
+        notifyItemRemoved(ItemStack(itemId, toRemove), i, category);
     }
     
     if (totalRemoved > 0) {
@@ -164,16 +167,12 @@ int CategoryInventory::removeItemFromSlot(InventoryCategory category, int slotIn
     if ((*slots)[slotIndex].isEmpty()) return 0;
     
     int toRemove = (count <= 0) ? (*slots)[slotIndex].count : std::min(count, (*slots)[slotIndex].count);
-    std::string itemId = (*slots)[slotIndex].itemId;
+    ItemId itemId = (*slots)[slotIndex].itemId;
     
-    (*slots)[slotIndex].count -= toRemove;
+    changeSlotCount(category, slotIndex, -toRemove);
     
     notifyItemRemoved(ItemStack(itemId, toRemove), slotIndex, category);
     
-    if ((*slots)[slotIndex].count <= 0) {
-        (*slots)[slotIndex].clear();
-    }
-    
     notifyInventoryChanged();
     return toRemove;
 }
@@ -188,7 +187,7 @@ bool CategoryInventory::useItem(InventoryCategory category, int slotIndex) {
     
     // 种子不能直接使用，需要种下
     if (isSeed(consumableSlots[slotIndex].itemId)) {
-        std::cout << "[CategoryInventory] Seeds must be planted, not used directly" << std::endl;
+        LOG_INFO("[CategoryInventory] Seeds must be planted, not used directly");
         return false;
     }
     
@@ -203,15 +202,12 @@ bool CategoryInventory::useItem(InventoryCategory category, int slotIndex) {
     ItemStack usedItem = consumableSlots[slotIndex];
     usedItem.count = 1;
     
-    consumableSlots[slotIndex].count--;
-    if (consumableSlots[slotIndex].count <= 0) {
-        consumableSlots[slotIndex].clear();
-    }
+    changeSlotCount(InventoryCategory::Consumables, slotIndex, -1);
     
     notifyItemUsed(usedItem, slotIndex, category);
     notifyInventoryChanged();
     
-    std::cout << "[CategoryInventory] Used: " << data->name << std::endl;
+    LOG_INFO("[CategoryInventory] Used: " << data->name);
     return true;
 }
 
@@ -225,19 +221,16 @@ bool CategoryInventory::equipItem(int slotIndex) {
     // 调用装备回调
     if (onEquipItemCallback) {
         if (!onEquipItemCallback(equipmentSlots[slotIndex])) {
-            std::cout << "[CategoryInventory] Failed to equip: " << data->name << std::endl;
+            LOG_WARN("[CategoryInventory] Failed to equip: " << data->name);
             return false;
         }
     }
     
     // 成功装备后从背包移除
-    std::cout << "[CategoryInventory] Equipped: " << data->name << std::endl;
+    LOG_INFO("[CategoryInventory] Equipped: " << data->name);
     
     // 移除装备的物品
-    equipmentSlots[slotIndex].count--;
-    if (equipmentSlots[slotIndex].count <= 0) {
-        equipmentSlots[slotIndex].clear();
-    }
+    changeSlotCount(InventoryCategory::Equipment, slotIndex, -1);
     
     notifyInventoryChanged();
     return true;
@@ -248,7 +241,7 @@ bool CategoryInventory::plantSeed(int slotIndex) {
     if (consumableSlots[slotIndex].isEmpty()) return false;
     
     if (!isSeed(consumableSlots[slotIndex].itemId)) {
-        std::cout << "[CategoryInventory] This item is not a seed" << std::endl;
+        LOG_INFO("[CategoryInventory] This item is not a seed");
         return false;
     }
     
@@ -260,13 +253,10 @@ bool CategoryInventory::plantSeed(int slotIndex) {
     }
     
     // 消耗种子
-    consumableSlots[slotIndex].count--;
-    if (consumableSlots[slotIndex].count <= 0) {
-        consumableSlots[slotIndex].clear();
-    }
+    changeSlotCount(InventoryCategory::Consumables, slotIndex, -1);
     
     notifyInventoryChanged();
-    std::cout << "[CategoryInventory] Planted seed" << std::endl;
+    LOG_INFO("[CategoryInventory] Planted seed");
     return true;
 }
 
@@ -285,19 +275,16 @@ bool CategoryInventory::destroyItem(InventoryCategory category, int slotIndex, i
     
     const ItemData* data = ItemDatabase::getInstance().getItemData((*slots)[slotIndex].itemId);
     if (data && data->type == ItemType::Quest) {
-        std::cout << "[CategoryInventory] Cannot destroy quest item" << std::endl;
+        LOG_INFO("[CategoryInventory] Cannot destroy quest item");
         return false;
     }
     
     int toDestroy = (count < 0) ? (*slots)[slotIndex].count : std::min(count, (*slots)[slotIndex].count);
     
-    std::cout << "[CategoryInventory] Destroyed " << toDestroy << "x " 
-              << (data ? data->name : (*slots)[slotIndex].itemId) << std::endl;
+    LOG_INFO("[CategoryInventory] Destroyed " << toDestroy << "x " 
+          << (data ? data->name : (*slots)[slotIndex].getStringId()));
     
-    (*slots)[slotIndex].count -= toDestroy;
-    if ((*slots)[slotIndex].count <= 0) {
-        (*slots)[slotIndex].clear();
-    }
+    changeSlotCount(category, slotIndex, -toDestroy);
     
     notifyInventoryChanged();
     return true;
@@ -320,7 +307,7 @@ int CategoryInventory::sellItem(InventoryCategory category, int slotIndex, int c
     if (!data) return 0;
     
     if (data->type == ItemType::Quest) {
-        std::cout << "[CategoryInventory] Cannot sell quest item" << std::endl;
+        LOG_INFO("[CategoryInventory] Cannot sell quest item");
         return 0;
     }
     
@@ -332,13 +319,10 @@ int CategoryInventory::sellItem(InventoryCategory category, int slotIndex, int c
         onSellItemCallback(ItemStack((*slots)[slotIndex].itemId, toSell), goldValue);
     }
     
-    std::cout << "[CategoryInventory] Sold " << toSell << "x " << data->name 
-              << " for " << goldValue << " gold" << std::endl;
+    LOG_INFO("[CategoryInventory] Sold " << toSell << "x " << data->name 
+          << " for " << goldValue << " gold");
     
-    (*slots)[slotIndex].count -= toSell;
-    if ((*slots)[slotIndex].count <= 0) {
-        (*slots)[slotIndex].clear();
-    }
+    changeSlotCount(category, slotIndex, -toSell);
     
     notifyInventoryChanged();
     return goldValue;
@@ -359,17 +343,14 @@ ItemStack CategoryInventory::dropItem(InventoryCategory category, int slotIndex,
     
     const ItemData* data = ItemDatabase::getInstance().getItemData((*slots)[slotIndex].itemId);
     if (data && data->type == ItemType::Quest) {
-        std::cout << "[CategoryInventory] Cannot drop quest item" << std::endl;
+        LOG_INFO("[CategoryInventory] Cannot drop quest item");
         return ItemStack();
     }
     
     int toDrop = (count < 0) ? (*slots)[slotIndex].count : std::min(count, (*slots)[slotIndex].count);
     ItemStack dropped((*slots)[slotIndex].itemId, toDrop);
     
-    (*slots)[slotIndex].count -= toDrop;
-    if ((*slots)[slotIndex].count <= 0) {
-        (*slots)[slotIndex].clear();
-    }
+    changeSlotCount(category, slotIndex, -toDrop);
     
     notifyItemRemoved(dropped, slotIndex, category);
     notifyInventoryChanged();
@@ -390,7 +371,9 @@ void CategoryInventory::swapSlots(InventoryCategory category, int index1, int in
         default: return;
     }
     
-    std::swap((*slots)[index1], (*slots)[index2]);
+    ItemStack first = (*slots)[index1];
+    setSlot(category, index1, (*slots)[index2]);
+    setSlot(category, index2, first);
     notifyInventoryChanged();
 }
 
@@ -436,8 +419,10 @@ void CategoryInventory::sortCategory(InventoryCategory category) {
         }
     }
     
+    // 整理会整体搬动格子，直接重建索引
+    rebuildIndex();
     notifyInventoryChanged();
-    std::cout << "[CategoryInventory] Sorted " << getCategoryName(category) << std::endl;
+    LOG_INFO("[CategoryInventory] Sorted " << getCategoryName(category));
 }
 
 void CategoryInventory::sortAll() {
@@ -462,7 +447,7 @@ const ItemStack& CategoryInventory::getSlot(InventoryCategory category, int inde
     }
 }
 
-ItemStack& CategoryInventory::getSlot(InventoryCategory category, int index) {
+ItemStack& CategoryInventory::getSlotRef(InventoryCategory category, int index) {
     static ItemStack emptySlot;
     if (index < 0 || index >= CATEGORY_SLOTS) return emptySlot;
     
@@ -474,24 +459,20 @@ ItemStack& CategoryInventory::getSlot(InventoryCategory category, int index) {
     }
 }
 
+bool CategoryInventory::hasItem(ItemId itemId, int count) const {
+    return getItemCount(itemId) >= count;
+}
+
 bool CategoryInventory::hasItem(const std::string& itemId, int count) const {
     return getItemCount(itemId) >= count;
 }
 
 int CategoryInventory::getItemCount(const std::string& itemId) const {
-    int total = 0;
-    
-    for (const auto& slot : materialSlots) {
-        if (slot.itemId == itemId) total += slot.count;
-    }
-    for (const auto& slot : consumableSlots) {
-        if (slot.itemId == itemId) total += slot.count;
-    }
-    for (const auto& slot : equipmentSlots) {
-        if (slot.itemId == itemId) total += slot.count;
-    }
-    
-    return total;
+    return getItemCount(ItemDatabase::getInstance().getItemId(itemId));
+}
+
+int CategoryInventory::getItemCount(ItemId itemId) const {
+    return itemId < itemCounts.size() ? itemCounts[itemId] : 0;
 }
 
 int CategoryInventory::getEmptySlotCount(InventoryCategory category) const {
@@ -536,6 +517,10 @@ InventoryCategory CategoryInventory::getItemCategory(ItemType type) {
     }
 }
 
+bool CategoryInventory::isSeed(ItemId itemId) {
+    return isSeed(ItemDatabase::getInstance().getStringId(itemId));
+}
+
 bool CategoryInventory::isSeed(const std::string& itemId) {
     return itemId == "seed" || 
            itemId.find("seed") != std::string::npos ||
@@ -583,24 +568,39 @@ std::vector<ContextMenuOption> CategoryInventory::getContextMenuOptions(const It
     return options;
 }
 
+// ============================================================================
+// 存档
+// ============================================================================
+
+InventorySaveData CategoryInventory::captureSaveData() const {
+    InventorySaveData data;
+    data.categories[static_cast<size_t>(InventoryCategory::Materials)] = materialSlots;
+    data.categories[static_cast<size_t>(InventoryCategory::Consumables)] = consumableSlots;
+    data.categories[static_cast<size_t>(InventoryCategory::Equipment)] = equipmentSlots;
+    return data;
+}
+
+void CategoryInventory::applySaveData(const InventorySaveData& data) {
+    materialSlots = data.categories[static_cast<size_t>(InventoryCategory::Materials)];
+    consumableSlots = data.categories[static_cast<size_t>(InventoryCategory::Consumables)];
+    equipmentSlots = data.categories[static_cast<size_t>(InventoryCategory::Equipment)];
+    rebuildIndex();
+    notifyInventoryChanged();
+}
+
 // ============================================================================
 // 私有方法
 // ============================================================================
 
-int CategoryInventory::findStackableSlot(InventoryCategory category, const std::string& itemId) const {
+int CategoryInventory::findStackableSlot(InventoryCategory category, ItemId itemId) const {
     const ItemData* data = ItemDatabase::getInstance().getItemData(itemId);
-    if (!data) return -1;
-    
-    const std::array<ItemStack, CATEGORY_SLOTS>* slots = nullptr;
-    switch (category) {
-        case InventoryCategory::Materials:   slots = &materialSlots; break;
-        case InventoryCategory::Consumables: slots = &consumableSlots; break;
-        case InventoryCategory::Equipment:   slots = &equipmentSlots; break;
-        default: return -1;
-    }
+    if (!data || itemId >= itemSlotIndex.size()) return -1;
     
-    for (int i = 0; i < CATEGORY_SLOTS; i++) {
-        if ((*slots)[i].itemId == itemId && (*slots)[i].count < data->maxStack) {
+    // 只检查该物品占用的格子（升序，保持"优先堆到靠前格子"的规则）
+    for (std::uint16_t key : itemSlotIndex[itemId]) {
+        if (key / CATEGORY_SLOTS != static_cast<int>(category)) continue;
+        int i = key % CATEGORY_SLOTS;
+        if (getSlot(category, i).count < data->maxStack) {
             return i;
         }
     }
@@ -624,8 +624,77 @@ int CategoryInventory::findEmptySlot(InventoryCategory category) const {
     return -1;
 }
 
+// ============================================================================
+// 物品索引
+// ============================================================================
+
+void CategoryInventory::setSlot(InventoryCategory category, int index, const ItemStack& stack) {
+    ItemStack& slot = getSlotRef(category, index);
+    ItemId oldId = slot.itemId;
+    
+    unindexSlot(category, index);
+    slot = stack.isEmpty() ? ItemStack() : stack;
+    indexSlot(category, index);
+    revision++;
+    
+    if (onItemCountChanged) {
+        if (oldId != INVALID_ITEM_ID) onItemCountChanged(oldId);
+        if (slot.itemId != INVALID_ITEM_ID && slot.itemId != oldId) onItemCountChanged(slot.itemId);
+    }
+}
+
+void CategoryInventory::changeSlotCount(InventoryCategory category, int index, int delta) {
+    const ItemStack& slot = getSlotRef(category, index);
+    setSlot(category, index, ItemStack(slot.itemId, slot.count + delta));
+}
+
+void CategoryInventory::indexSlot(InventoryCategory category, int index) {
+    const ItemStack& slot = getSlotRef(category, index);
+    if (slot.isEmpty()) return;
+    
+    if (slot.itemId >= itemCounts.size()) {
+        itemCounts.resize(slot.itemId + 1, 0);
+        itemSlotIndex.resize(slot.itemId + 1);
+    }
+    
+    itemCounts[slot.itemId] += slot.count;
+    
+    auto& occupied = itemSlotIndex[slot.itemId];
+    std::uint16_t key = slotKey(category, index);
+    occupied.insert(std::lower_bound(occupied.begin(), occupied.end(), key), key);
+}
+
+void CategoryInventory::unindexSlot(InventoryCategory category, int index) {
+    const ItemStack& slot = getSlotRef(category, index);
+    if (slot.isEmpty() || slot.itemId >= itemCounts.size()) return;
+    
+    itemCounts[slot.itemId] -= slot.count;
+    
+    auto& occupied = itemSlotIndex[slot.itemId];
+    std::uint16_t key = slotKey(category, index);
+    auto it = std::lower_bound(occupied.begin(), occupied.end(), key);
+    if (it != occupied.end() && *it == key) {
+        occupied.erase(it);
+    }
+}
+
+void CategoryInventory::rebuildIndex() {
+    itemCounts.assign(ItemDatabase::getInstance().getItemCount() + 1, 0);
+    itemSlotIndex.assign(itemCounts.size(), {});
+    
+    for (int c = 0; c < static_cast<int>(InventoryCategory::Count); c++) {
+        InventoryCategory category = static_cast<InventoryCategory>(c);
+        for (int i = 0; i < CATEGORY_SLOTS; i++) {
+            indexSlot(category, i);
+        }
+    }
+    
+    revision++;
+    if (onItemCountChanged) onItemCountChanged(INVALID_ITEM_ID);
+}
+
 void CategoryInventory::notifyItemAdded(const ItemStack& item, int slotIndex, InventoryCategory category) {
-    if (onItemAdded) onItemAdded(item, slotIndex, category);
+    EventBus::getInstance().push(ItemAddedEvent{item.itemId, item.count, slotIndex, category});
 }
 
 void CategoryInventory::notifyItemRemoved(const ItemStack& item, int slotIndex, InventoryCategory category) {
@@ -2,7 +2,9 @@
 #include "Item.h"
 #include "Inventory.h"
 #include <array>
+#include <cstdint>
 #include <functional>
+#include <vector>
 
 // ============================================================================
 // 分类背包系统 (Category Inventory System)
@@ -27,6 +29,11 @@
 //     - 双击：装备
 //     - 右键菜单：装备、销毁、卖出
 //
+// 【物品索引】
+//   每种物品（按 ItemId）维护总数量和占用的格子列表，
+//   getItemCount/hasItem 为 O(1)，堆叠查找只检查该物品自己的格子。
+//   所有修改格子的操作都必须经过 setSlot/changeSlotCount 以保持索引同步。
+//
 // ============================================================================
 
 // 背包分类枚举
@@ -43,6 +50,14 @@ constexpr int CATEGORY_SLOTS_PER_PAGE = 30;
 constexpr int CATEGORY_COLUMNS = 6;
 constexpr int CATEGORY_ROWS = 5;
 
+// 单个分类的全部格子
+using CategorySlots = std::array<ItemStack, CATEGORY_SLOTS>;
+
+// 存档数据（按 InventoryCategory 顺序）
+struct InventorySaveData {
+    std::array<CategorySlots, static_cast<size_t>(InventoryCategory::Count)> categories;
+};
+
 // 右键菜单选项
 enum class ContextMenuOption {
     None,
@@ -61,6 +76,7 @@ public:
     using SellItemCallback = std::function<void(const ItemStack&, int goldValue)>;
     using PlantSeedCallback = std::function<bool(const ItemStack&)>;
     using EquipItemCallback = std::function<bool(const ItemStack&)>;  // Returns old equipped item or empty
+    using ItemCountCallback = std::function<void(ItemId)>;  // INVALID_ITEM_ID 表示全部物品都可能变化
     
     CategoryInventory();
     
@@ -69,10 +85,12 @@ public:
     // ========================================
     
     // 添加物品（自动分类到对应栏位）
+    int addItem(ItemId itemId, int count = 1);
     int addItem(const std::string& itemId, int count = 1);
     int addItemStack(const ItemStack& stack);
     
     // 从指定分类移除物品
+    int removeItem(ItemId itemId, int count = 1);
     int removeItem(const std::string& itemId, int count = 1);
     int removeItemFromSlot(InventoryCategory category, int slotIndex, int count = 1);
     
@@ -107,16 +125,20 @@ public:
     // 查询功能
     // ========================================
     
-    // 获取指定分类的格子
+    // 获取指定分类的格子（只读，修改请使用物品操作接口）
     const ItemStack& getSlot(InventoryCategory category, int index) const;
-    ItemStack& getSlot(InventoryCategory category, int index);
     
     // 检查是否拥有物品
+    bool hasItem(ItemId itemId, int count = 1) const;
     bool hasItem(const std::string& itemId, int count = 1) const;
     
     // 获取物品总数量
+    int getItemCount(ItemId itemId) const;
     int getItemCount(const std::string& itemId) const;
     
+    // 背包版本号（任何格子变化都会递增，用于缓存失效）
+    std::uint32_t getRevision() const { return revision; }
+    
     // 获取分类的空格子数
     int getEmptySlotCount(InventoryCategory category) const;
     
@@ -133,16 +155,23 @@ public:
     static InventoryCategory getItemCategory(ItemType type);
     
     // 判断物品是否为种子
+    static bool isSeed(ItemId itemId);
     static bool isSeed(const std::string& itemId);
     
     // 获取物品的右键菜单选项
     static std::vector<ContextMenuOption> getContextMenuOptions(const ItemData* data);
     
     // ========================================
-    // 回调设置
+    // 存档
+    // ========================================
+    
+    InventorySaveData captureSaveData() const;
+    void applySaveData(const InventorySaveData& data);
+    
+    // ========================================
+    // 回调设置（物品添加改为压入 EventBus 的 ItemAddedEvent）
     // ========================================
     
-    void setOnItemAdded(ItemCallback cb) { onItemAdded = cb; }
     void setOnItemRemoved(ItemCallback cb) { onItemRemoved = cb; }
     void setOnItemUsed(ItemCallback cb) { onItemUsed = cb; }
     void setOnInventoryChanged(std::function<void()> cb) { onInventoryChanged = cb; }
@@ -150,10 +179,24 @@ public:
     void setOnSellItem(SellItemCallback cb) { onSellItemCallback = cb; }
     void setOnPlantSeed(PlantSeedCallback cb) { onPlantSeedCallback = cb; }
     void setOnEquipItem(EquipItemCallback cb) { onEquipItemCallback = cb; }
+    void setOnItemCountChanged(ItemCountCallback cb) { onItemCountChanged = cb; }
 
 private:
     // 在指定分类中查找可堆叠的格子
-    int findStackableSlot(InventoryCategory category, const std::string& itemId) const;
+    int findStackableSlot(InventoryCategory category, ItemId itemId) const;
+    
+    // 格子写入（同步更新物品索引）
+    ItemStack& getSlotRef(InventoryCategory category, int index);
+    void setSlot(InventoryCategory category, int index, const ItemStack& stack);
+    void changeSlotCount(InventoryCategory category, int index, int delta);
+    
+    // 物品索引维护
+    static std::uint16_t slotKey(InventoryCategory category, int index) {
+        return static_cast<std::uint16_t>(static_cast<int>(category) * CATEGORY_SLOTS + index);
+    }
+    void indexSlot(InventoryCategory category, int index);
+    void unindexSlot(InventoryCategory category, int index);
+    void rebuildIndex();
     
     // 在指定分类中查找空格子
     int findEmptySlot(InventoryCategory category) const;
@@ -170,8 +213,12 @@ private:
     std::array<ItemStack, CATEGORY_SLOTS> consumableSlots;
     std::array<ItemStack, CATEGORY_SLOTS> equipmentSlots;
     
+    // 物品索引（下标为 ItemId）：总数量、占用的格子（slotKey 升序）
+    std::vector<int> itemCounts;
+    std::vector<std::vector<std::uint16_t>> itemSlotIndex;
+    std::uint32_t revision = 0;
+    
     // 回调函数
-    ItemCallback onItemAdded;
     ItemCallback onItemRemoved;
     ItemCallback onItemUsed;
     std::function<void()> onInventoryChanged;
@@ -179,6 +226,7 @@ private:
     SellItemCallback onSellItemCallback;
     PlantSeedCallback onPlantSeedCallback;
     EquipItemCallback onEquipItemCallback;
+    ItemCountCallback onItemCountChanged;
 };
 
 // ============================================================================
@@ -1,6 +1,9 @@
 #include "Crafting.h"
 #include "Equipment.h"
-#include <iostream>
+#include "../Systems/InputSystem.h"
+#include "../Systems/Logger.h"
+#include "../Systems/RenderStats.h"
+#include <algorithm>
 #include <sstream>
 
 // ============================================================================
@@ -24,245 +27,320 @@ CraftingManager& CraftingManager::getInstance() {
     return instance;
 }
 
-void CraftingManager::initialize() {
+void CraftingManager::initialize(const std::vector<CraftingRecipe>& definitions) {
     if (initialized) return;
     
-    std::cout << "[CraftingManager] Initializing crafting recipes..." << std::endl;
-    
-    // ========================================
-    // 工具配方
-    // ========================================
-    
-    // 木斧 - 1石头 + 2树枝 = 1木斧（无视防御）
-    {
-        CraftingRecipe recipe;
-        recipe.id = "craft_wooden_axe";
-        recipe.name = "木斧";
-        recipe.description = "合成一把木斧，可以无视树木的防御值";
-        recipe.ingredients.push_back(RecipeIngredient("stone", 1));
-        recipe.ingredients.push_back(RecipeIngredient("stick", 2));
-        recipe.resultItemId = "wooden_axe";
-        recipe.resultCount = 1;
-        recipe.isEquipment = true;
+    // 定义来自 assets/data/recipes.json（见 ItemDefinitions）
+    recipes.reserve(definitions.size());
+    for (const auto& recipe : definitions) {
         registerRecipe(recipe);
     }
     
-    // 铁斧 - 3石头 + 2树枝 + 2木材 = 1铁斧
-    {
-        CraftingRecipe recipe;
-        recipe.id = "craft_iron_axe";
-        recipe.name = "铁斧";
-        recipe.description = "合成一把更强力的铁斧";
-        recipe.ingredients.push_back(RecipeIngredient("stone", 3));
-        recipe.ingredients.push_back(RecipeIngredient("stick", 2));
-        recipe.ingredients.push_back(RecipeIngredient("wood", 2));
-        recipe.resultItemId = "iron_axe";
-        recipe.resultCount = 1;
-        recipe.isEquipment = true;
-        registerRecipe(recipe);
+    initialized = true;
+    LOG_INFO("[CraftingManager] Registered " << recipes.size() << " recipes");
+}
+
+const CraftingRecipe* CraftingManager::getRecipe(const std::string& recipeId) const {
+    int index = getRecipeIndex(recipeId);
+    return index >= 0 ? &recipes[index] : nullptr;
+}
+
+int CraftingManager::getRecipeIndex(const std::string& recipeId) const {
+    auto it = recipeLookup.find(recipeId);
+    return it != recipeLookup.end() ? static_cast<int>(it->second) : -1;
+}
+
+const std::vector<std::uint16_t>& CraftingManager::getRecipesUsing(ItemId itemId) const {
+    static const std::vector<std::uint16_t> none;
+    return itemId < recipesByIngredient.size() ? recipesByIngredient[itemId] : none;
+}
+
+const std::vector<std::uint16_t>& CraftingManager::getRecipesProducing(ItemId itemId) const {
+    static const std::vector<std::uint16_t> none;
+    return itemId < recipesByResult.size() ? recipesByResult[itemId] : none;
+}
+
+void CraftingManager::registerRecipe(const CraftingRecipe& recipe) {
+    // 物品ID在注册时驻留（ItemDatabase 必须先初始化）
+    const ItemDatabase& db = ItemDatabase::getInstance();
+    ResolvedRecipe r;
+    r.result = db.getItemId(recipe.resultItemId);
+    r.resultCount = std::max(1, recipe.resultCount);
+    for (const auto& ing : recipe.ingredients) {
+        r.ingredients.emplace_back(db.getItemId(ing.itemId), ing.count);
     }
     
-    // ========================================
-    // 武器配方
-    // ========================================
-    
-    // 木剑 - 2木材 + 1树枝 = 1木剑
-    {
-        CraftingRecipe recipe;
-        recipe.id = "craft_wooden_sword";
-        recipe.name = "木剑";
-        recipe.description = "合成一把简单的木剑";
-        recipe.ingredients.push_back(RecipeIngredient("wood", 2));
-        recipe.ingredients.push_back(RecipeIngredient("stick", 1));
-        recipe.resultItemId = "wooden_sword";
-        recipe.resultCount = 1;
-        recipe.isEquipment = true;
-        registerRecipe(recipe);
-    }
+    auto index = static_cast<std::uint16_t>(recipes.size());
+    auto addTo = [index](std::vector<std::vector<std::uint16_t>>& table, ItemId itemId) {
+        if (itemId == INVALID_ITEM_ID) return;
+        if (itemId >= table.size()) table.resize(itemId + 1);
+        if (table[itemId].empty() || table[itemId].back() != index) table[itemId].push_back(index);
+    };
+    for (const auto& ing : r.ingredients) addTo(recipesByIngredient, ing.first);
+    addTo(recipesByResult, r.result);
     
-    // 铁剑 - 3石头 + 2木材 = 1铁剑
-    {
-        CraftingRecipe recipe;
-        recipe.id = "craft_iron_sword";
-        recipe.name = "铁剑";
-        recipe.description = "合成一把锋利的铁剑";
-        recipe.ingredients.push_back(RecipeIngredient("stone", 3));
-        recipe.ingredients.push_back(RecipeIngredient("wood", 2));
-        recipe.resultItemId = "iron_sword";
-        recipe.resultCount = 1;
-        recipe.isEquipment = true;
-        registerRecipe(recipe);
-    }
+    recipeLookup[recipe.id] = recipes.size();
+    recipes.push_back(recipe);
+    resolved.push_back(std::move(r));
+    planCache.clear();
+    maxCraftableCache.clear();
+}
+
+bool CraftingManager::canCraft(const CraftingRecipe& recipe, CategoryInventory* inventory) const {
+    if (!inventory) return false;
     
-    // ========================================
-    // 防具配方
-    // ========================================
-    
-    // 木盾 - 3木材 = 1木盾
-    {
-        CraftingRecipe recipe;
-        recipe.id = "craft_wooden_shield";
-        recipe.name = "木盾";
-        recipe.description = "合成一面简单的木盾";
-        recipe.ingredients.push_back(RecipeIngredient("wood", 3));
-        recipe.resultItemId = "wooden_shield";
-        recipe.resultCount = 1;
-        recipe.isEquipment = true;
-        registerRecipe(recipe);
+    int index = getRecipeIndex(recipe.id);
+    return index >= 0 && canCraftDirect(index, *inventory);
+}
+
+bool CraftingManager::canCraftDirect(size_t index, const CategoryInventory& inventory) const {
+    for (const auto& ing : resolved[index].ingredients) {
+        if (ing.first == INVALID_ITEM_ID || !inventory.hasItem(ing.first, ing.second)) {
+            return false;
+        }
     }
-    
-    // 皮帽 - 2木材 = 1皮帽
-    {
-        CraftingRecipe recipe;
-        recipe.id = "craft_leather_cap";
-        recipe.name = "皮帽";
-        recipe.description = "合成一顶简单的帽子";
-        recipe.ingredients.push_back(RecipeIngredient("wood", 2));
-        recipe.resultItemId = "leather_cap";
-        recipe.resultCount = 1;
-        recipe.isEquipment = true;
-        registerRecipe(recipe);
+    return true;
+}
+
+// ============================================================================
+// 多级合成规划
+// ============================================================================
+
+struct CraftingManager::PlanState {
+    const CategoryInventory* inventory = nullptr;
+    std::unordered_map<ItemId, int> available;      // 模拟中的物品数量（按需从背包读取）
+    std::vector<std::pair<size_t, int>> steps;
+    std::vector<size_t> visiting;                   // 当前递归链上的配方（防止循环配方）
+    
+    int& count(ItemId itemId) {
+        auto it = available.find(itemId);
+        if (it == available.end()) {
+            it = available.emplace(itemId, inventory->getItemCount(itemId)).first;
+        }
+        return it->second;
     }
+};
+
+bool CraftingManager::planRecipe(size_t index, int times, PlanState& state, int depth) const {
+    if (depth > MAX_PLAN_DEPTH) return false;
+    if (std::find(state.visiting.begin(), state.visiting.end(), index) != state.visiting.end()) return false;
     
-    // 皮甲 - 4木材 + 1石头 = 1皮甲
-    {
-        CraftingRecipe recipe;
-        recipe.id = "craft_leather_armor";
-        recipe.name = "皮甲";
-        recipe.description = "合成一件简单的护甲";
-        recipe.ingredients.push_back(RecipeIngredient("wood", 4));
-        recipe.ingredients.push_back(RecipeIngredient("stone", 1));
-        recipe.resultItemId = "leather_armor";
-        recipe.resultCount = 1;
-        recipe.isEquipment = true;
-        registerRecipe(recipe);
-    }
+    const ResolvedRecipe& r = resolved[index];
+    if (r.result == INVALID_ITEM_ID) return false;
     
-    // 皮裤 - 3木材 = 1皮裤
-    {
-        CraftingRecipe recipe;
-        recipe.id = "craft_leather_pants";
-        recipe.name = "皮裤";
-        recipe.description = "合成一条简单的裤子";
-        recipe.ingredients.push_back(RecipeIngredient("wood", 3));
-        recipe.resultItemId = "leather_pants";
-        recipe.resultCount = 1;
-        recipe.isEquipment = true;
-        registerRecipe(recipe);
+    state.visiting.push_back(index);
+    for (const auto& ing : r.ingredients) {
+        if (!planItem(ing.first, ing.second * times, state, depth)) {
+            state.visiting.pop_back();
+            return false;
+        }
     }
+    state.visiting.pop_back();
     
-    // 皮手套 - 2木材 = 1皮手套
-    {
-        CraftingRecipe recipe;
-        recipe.id = "craft_leather_gloves";
-        recipe.name = "皮手套";
-        recipe.description = "合成一双简单的手套";
-        recipe.ingredients.push_back(RecipeIngredient("wood", 2));
-        recipe.resultItemId = "leather_gloves";
-        recipe.resultCount = 1;
-        recipe.isEquipment = true;
-        registerRecipe(recipe);
+    state.count(r.result) += r.resultCount * times;
+    state.steps.emplace_back(index, times);
+    return true;
+}
+
+bool CraftingManager::planItem(ItemId itemId, int needed, PlanState& state, int depth) const {
+    if (itemId == INVALID_ITEM_ID) return false;
+    
+    int have = state.count(itemId);
+    int shortfall = needed - have;
+    
+    // 材料不足：尝试用能产出它的配方先合成中间品
+    if (shortfall > 0) {
+        bool produced = false;
+        for (std::uint16_t producer : getRecipesProducing(itemId)) {
+            int crafts = (shortfall + resolved[producer].resultCount - 1) / resolved[producer].resultCount;
+            PlanState attempt = state;
+            if (planRecipe(producer, crafts, attempt, depth + 1)) {
+                state = std::move(attempt);
+                produced = true;
+                break;
+            }
+        }
+        if (!produced) return false;
     }
     
-    // 皮靴 - 2木材 + 1树枝 = 1皮靴
-    {
-        CraftingRecipe recipe;
-        recipe.id = "craft_leather_boots";
-        recipe.name = "皮靴";
-        recipe.description = "合成一双简单的靴子";
-        recipe.ingredients.push_back(RecipeIngredient("wood", 2));
-        recipe.ingredients.push_back(RecipeIngredient("stick", 1));
-        recipe.resultItemId = "leather_boots";
-        recipe.resultCount = 1;
-        recipe.isEquipment = true;
-        registerRecipe(recipe);
+    state.count(itemId) -= needed;
+    return true;
+}
+
+void CraftingManager::validatePlanCache(const CategoryInventory& inventory) const {
+    if (planCacheInventory != &inventory || planCacheRevision != inventory.getRevision()) {
+        planCache.clear();
+        maxCraftableCache.clear();
+        planCacheInventory = &inventory;
+        planCacheRevision = inventory.getRevision();
     }
-    
-    // 简易披风 - 3木材 = 1简易披风
-    {
-        CraftingRecipe recipe;
-        recipe.id = "craft_simple_cape";
-        recipe.name = "简易披风";
-        recipe.description = "合成一件简单的披风";
-        recipe.ingredients.push_back(RecipeIngredient("wood", 3));
-        recipe.resultItemId = "simple_cape";
-        recipe.resultCount = 1;
-        recipe.isEquipment = true;
-        registerRecipe(recipe);
+}
+
+const CraftPlan& CraftingManager::plan(size_t index, int times, const CategoryInventory& inventory) const {
+    validatePlanCache(inventory);
+    
+    std::uint64_t key = (static_cast<std::uint64_t>(index) << 32) | static_cast<std::uint32_t>(times);
+    auto cached = planCache.find(key);
+    if (cached != planCache.end()) return cached->second;
+    
+    CraftPlan result;
+    result.times = times;
+    
+    PlanState state;
+    state.inventory = &inventory;
+    if (index < resolved.size() && times > 0 && planRecipe(index, times, state, 0)) {
+        result.feasible = true;
+        result.steps = std::move(state.steps);
+        for (const auto& entry : state.available) {
+            int change = entry.second - inventory.getItemCount(entry.first);
+            if (change != 0) result.delta.emplace_back(entry.first, change);
+        }
+        // 先消耗后产出，保证批量执行时背包格子够用
+        std::sort(result.delta.begin(), result.delta.end(),
+                  [](const auto& a, const auto& b) { return a.second < b.second; });
     }
     
-    // ========================================
-    // 消耗品配方
-    // ========================================
-    
-    // 生命药水 - 3苹果 + 2樱桃 = 1生命药水
-    {
-        CraftingRecipe recipe;
-        recipe.id = "craft_health_potion";
-        recipe.name = "生命药水";
-        recipe.description = "将水果酿成药水";
-        recipe.ingredients.push_back(RecipeIngredient("apple", 3));
-        recipe.ingredients.push_back(RecipeIngredient("cherry", 2));
-        recipe.resultItemId = "health_potion";
-        recipe.resultCount = 1;
-        recipe.isEquipment = false;
-        registerRecipe(recipe);
+    return planCache.emplace(key, std::move(result)).first->second;
+}
+
+int CraftingManager::getMaxCraftable(size_t index, const CategoryInventory& inventory) const {
+    validatePlanCache(inventory);
+    
+    auto cached = maxCraftableCache.find(index);
+    if (cached != maxCraftableCache.end()) return cached->second;
+    
+    // 倍增找上界，再二分
+    int low = 0;
+    int high = 1;
+    while (high <= MAX_BATCH && plan(index, high, inventory).feasible) {
+        low = high;
+        high *= 2;
+    }
+    high = std::min(high, MAX_BATCH + 1);
+    while (high - low > 1) {
+        int mid = (low + high) / 2;
+        if (plan(index, mid, inventory).feasible) low = mid;
+        else high = mid;
     }
     
-    initialized = true;
-    std::cout << "[CraftingManager] Registered " << recipes.size() << " recipes" << std::endl;
+    maxCraftableCache[index] = low;
+    return low;
 }
 
-const CraftingRecipe* CraftingManager::getRecipe(const std::string& recipeId) const {
-    for (const auto& recipe : recipes) {
-        if (recipe.id == recipeId) {
-            return &recipe;
+int CraftingManager::craftBatch(size_t index, int times, CategoryInventory* inventory) {
+    if (!inventory || index >= recipes.size() || times <= 0) return 0;
+    
+    const CraftingRecipe& recipe = recipes[index];
+    
+    // 拷贝一份：执行过程中背包变化会使缓存失效
+    CraftPlan craftPlan = plan(index, times, *inventory);
+    if (!craftPlan.feasible) {
+        LOG_INFO("[CraftingManager] Cannot craft " << recipe.name << " - insufficient materials");
+        return 0;
+    }
+    
+    // 一次性应用净变化（中间品产出又消耗，不会进出背包）
+    // 产物放不下时按相反顺序撤销已执行的变化，背包恢复原样，整批不合成
+    int resultAdded = 0;
+    ItemId resultId = resolved[index].result;
+    std::vector<std::pair<ItemId, int>> applied;
+    applied.reserve(craftPlan.delta.size());
+    for (const auto& change : craftPlan.delta) {
+        if (change.second < 0) {
+            int removed = inventory->removeItem(change.first, -change.second);
+            applied.emplace_back(change.first, -removed);
+            continue;
+        }
+        
+        int added = inventory->addItem(change.first, change.second);
+        applied.emplace_back(change.first, added);
+        if (change.first == resultId) resultAdded = added;
+        if (added < change.second) {
+            for (auto it = applied.rbegin(); it != applied.rend(); ++it) {
+                if (it->second > 0) inventory->removeItem(it->first, it->second);
+                else if (it->second < 0) inventory->addItem(it->first, -it->second);
+            }
+            LOG_WARN("[CraftingManager] Inventory full, cannot craft " << times << "x " << recipe.name);
+            return 0;
         }
     }
-    return nullptr;
+    
+    if (craftPlan.steps.size() > 1) {
+        LOG_INFO("[CraftingManager] Crafted " << craftPlan.steps.size() - 1 << " intermediate step(s) for "
+              << recipe.name);
+    }
+    LOG_INFO("[CraftingManager] Crafted " << resultAdded << "x " << recipe.name);
+    return resultAdded;
 }
 
-void CraftingManager::registerRecipe(const CraftingRecipe& recipe) {
-    recipes.push_back(recipe);
-    std::cout << "[CraftingManager] Registered: " << recipe.id << " (" << recipe.name << ")" << std::endl;
+bool CraftingManager::craft(const CraftingRecipe& recipe, CategoryInventory* inventory) {
+    int index = getRecipeIndex(recipe.id);
+    return index >= 0 && craftBatch(index, 1, inventory) > 0;
 }
 
-bool CraftingManager::canCraft(const CraftingRecipe& recipe, CategoryInventory* inventory) const {
-    if (!inventory) return false;
-    
-    for (const auto& ing : recipe.ingredients) {
-        if (!inventory->hasItem(ing.itemId, ing.count)) {
-            return false;
+// ============================================================================
+// CraftabilityTracker 实现
+// ============================================================================
+
+void CraftabilityTracker::attach(CategoryInventory* inv) {
+    detach();
+    inventory = inv;
+    if (!inventory) return;
+    
+    inventory->setOnItemCountChanged([this](ItemId itemId) {
+        if (itemId == INVALID_ITEM_ID) markAllDirty();
+        else markItemChanged(itemId);
+    });
+    markAllDirty();
+}
+
+void CraftabilityTracker::detach() {
+    if (inventory) {
+        inventory->setOnItemCountChanged(nullptr);
+        inventory = nullptr;
+    }
+}
+
+void CraftabilityTracker::markItemChanged(ItemId itemId) {
+    // 可合成性按规划器判断（含中间品），所以要沿 材料 -> 产物 -> 用到产物的配方 向上标记
+    const CraftingManager& manager = CraftingManager::getInstance();
+    std::vector<ItemId> pending = { itemId };
+    std::vector<ItemId> visited = { itemId };
+    while (!pending.empty()) {
+        ItemId item = pending.back();
+        pending.pop_back();
+        for (std::uint16_t index : manager.getRecipesUsing(item)) {
+            if (index / 64 >= dirty.size()) continue;
+            setBit(dirty, index, true);
+            
+            ItemId result = manager.getResolved(index).result;
+            if (std::find(visited.begin(), visited.end(), result) == visited.end()) {
+                visited.push_back(result);
+                pending.push_back(result);
+            }
         }
     }
-    return true;
 }
 
-bool CraftingManager::craft(const CraftingRecipe& recipe, CategoryInventory* inventory) {
+void CraftabilityTracker::markAllDirty() {
+    size_t words = (CraftingManager::getInstance().getAllRecipes().size() + 63) / 64;
+    craftable.assign(words, 0);
+    dirty.assign(words, ~std::uint64_t(0));
+}
+
+bool CraftabilityTracker::isCraftable(size_t recipeIndex) {
     if (!inventory) return false;
     
-    // 检查材料
-    if (!canCraft(recipe, inventory)) {
-        std::cout << "[CraftingManager] Cannot craft " << recipe.name << " - insufficient materials" << std::endl;
-        return false;
-    }
+    // 配方表在绑定后才加载时，扩容并全部重新检查
+    if (recipeIndex / 64 >= craftable.size()) markAllDirty();
+    if (recipeIndex / 64 >= craftable.size()) return false;
     
-    // 消耗材料
-    for (const auto& ing : recipe.ingredients) {
-        inventory->removeItem(ing.itemId, ing.count);
-    }
-    
-    // 添加产物
-    int added = inventory->addItem(recipe.resultItemId, recipe.resultCount);
-    
-    if (added > 0) {
-        std::cout << "[CraftingManager] Crafted " << added << "x " << recipe.name << std::endl;
-        return true;
-    } else {
-        std::cout << "[CraftingManager] Failed to add crafted item - inventory full?" << std::endl;
-        // TODO: 返还材料
-        return false;
+    if (testBit(dirty, recipeIndex)) {
+        // 与合成按钮同一判断：规划器认为可行（必要时自动合成中间品）
+        setBit(craftable, recipeIndex, CraftingManager::getInstance().plan(recipeIndex, 1, *inventory).feasible);
+        setBit(dirty, recipeIndex, false);
     }
+    return testBit(craftable, recipeIndex);
 }
 
 // ============================================================================
@@ -291,14 +369,14 @@ bool CraftingPanel::init(const std::string& iconPath) {
         iconSprite.setTexture(iconTexture);
         iconSprite.setScale(0.8f, 0.8f);
         iconLoaded = true;
-        std::cout << "[CraftingPanel] Icon loaded: " << iconPath << std::endl;
+        LOG_INFO("[CraftingPanel] Icon loaded: " << iconPath);
     } else {
         sf::Image placeholder;
         placeholder.create(64, 64, sf::Color(100, 80, 40, 200));
         iconTexture.loadFromImage(placeholder);
         iconSprite.setTexture(iconTexture);
         iconLoaded = true;
-        std::cout << "[CraftingPanel] Using placeholder icon" << std::endl;
+        LOG_INFO("[CraftingPanel] Using placeholder icon");
     }
     
     std::vector<std::string> fontPaths = {
@@ -318,7 +396,7 @@ bool CraftingPanel::init(const std::string& iconPath) {
 bool CraftingPanel::loadFont(const std::string& fontPath) {
     if (font.loadFromFile(fontPath)) {
         fontLoaded = true;
-        std::cout << "[CraftingPanel] Font loaded: " << fontPath << std::endl;
+        LOG_INFO("[CraftingPanel] Font loaded: " << fontPath);
         return true;
     }
     return false;
@@ -346,8 +424,8 @@ void CraftingPanel::update(float dt) {
     );
 }
 
-void CraftingPanel::handleEvent(const sf::Event& event, sf::RenderWindow& window) {
-    sf::Vector2i mousePos = sf::Mouse::getPosition(window);
+void CraftingPanel::handleEvent(const sf::Event& event, sf::RenderWindow& /*window*/) {
+    sf::Vector2i mousePos = InputSystem::getInstance().getMousePosition();
     sf::Vector2f mousePosF(static_cast<float>(mousePos.x), static_cast<float>(mousePos.y));
     
     // 检查图标悬浮
@@ -436,16 +514,27 @@ void CraftingPanel::handleEvent(const sf::Event& event, sf::RenderWindow& window
                     100, 35
                 );
                 
-                if (craftButton.contains(mousePosF)) {
-                    const auto& recipes = CraftingManager::getInstance().getAllRecipes();
+                sf::FloatRect craftMaxButton(
+                    panelPosition.x + LIST_WIDTH + 140,
+                    panelPosition.y + panelSize.y - 50,
+                    100, 35
+                );
+                
+                bool craftOne = craftButton.contains(mousePosF);
+                bool craftMax = craftMaxButton.contains(mousePosF);
+                if ((craftOne || craftMax) && inventory) {
+                    CraftingManager& manager = CraftingManager::getInstance();
+                    const auto& recipes = manager.getAllRecipes();
                     if (selectedRecipe < static_cast<int>(recipes.size())) {
                         const CraftingRecipe& recipe = recipes[selectedRecipe];
-                        if (CraftingManager::getInstance().craft(recipe, inventory)) {
+                        int times = craftMax ? manager.getMaxCraftable(selectedRecipe, *inventory) : 1;
+                        int crafted = manager.craftBatch(selectedRecipe, times, inventory);
+                        if (crafted > 0) {
                             if (onCraft) {
                                 onCraft(recipe);
                             }
                             if (onCraftSuccess) {
-                                onCraftSuccess(recipe.resultItemId, recipe.resultCount);
+                                onCraftSuccess(recipe.resultItemId, crafted);
                             }
                         }
                     }
@@ -463,8 +552,8 @@ void CraftingPanel::render(sf::RenderWindow& window) {
         iconBg.setFillColor(sf::Color(30, 30, 40, 200));
         iconBg.setOutlineThickness(2);
         iconBg.setOutlineColor(BORDER_COLOR);
-        window.draw(iconBg);
-        window.draw(iconSprite);
+        RenderStats::draw(window, iconBg);
+        RenderStats::draw(window, iconSprite);
     }
     
     if (!panelOpen) return;
@@ -480,13 +569,13 @@ void CraftingPanel::render(sf::RenderWindow& window) {
     bg.setFillColor(BG_COLOR);
     bg.setOutlineThickness(3);
     bg.setOutlineColor(BORDER_COLOR);
-    window.draw(bg);
+    RenderStats::draw(window, bg);
     
     // 标题栏
     sf::RectangleShape titleBar(sf::Vector2f(panelSize.x - 6, 30));
     titleBar.setPosition(panelPosition.x + 3, panelPosition.y + 3);
     titleBar.setFillColor(sf::Color(60, 45, 30, 200));
-    window.draw(titleBar);
+    RenderStats::draw(window, titleBar);
     
     if (fontLoaded) {
         sf::Text title;
@@ -496,7 +585,7 @@ void CraftingPanel::render(sf::RenderWindow& window) {
         title.setCharacterSize(20);
         title.setFillColor(sf::Color(255, 220, 150));
         title.setPosition(panelPosition.x + 15, panelPosition.y + 5);
-        window.draw(title);
+        RenderStats::draw(window, title);
     }
     
     // 关闭按钮
@@ -505,7 +594,7 @@ void CraftingPanel::render(sf::RenderWindow& window) {
     closeBtn.setFillColor(sf::Color(150, 50, 50, 200));
     closeBtn.setOutlineThickness(1);
     closeBtn.setOutlineColor(sf::Color::White);
-    window.draw(closeBtn);
+    RenderStats::draw(window, closeBtn);
     
     if (fontLoaded) {
         sf::Text closeText;
@@ -514,14 +603,14 @@ void CraftingPanel::render(sf::RenderWindow& window) {
         closeText.setCharacterSize(14);
         closeText.setFillColor(sf::Color::White);
         closeText.setPosition(panelPosition.x + panelSize.x - 21, panelPosition.y + 7);
-        window.draw(closeText);
+        RenderStats::draw(window, closeText);
     }
     
     // 分隔线
     sf::RectangleShape divider(sf::Vector2f(2, panelSize.y - 50));
     divider.setPosition(panelPosition.x + LIST_WIDTH, panelPosition.y + 40);
     divider.setFillColor(sf::Color(80, 80, 80));
-    window.draw(divider);
+    RenderStats::draw(window, divider);
     
     // 渲染配方列表
     renderRecipeList(window);
@@ -541,7 +630,7 @@ void CraftingPanel::renderRecipeList(sf::RenderWindow& window) {
     sf::RectangleShape listBg(sf::Vector2f(LIST_WIDTH - 20, listHeight));
     listBg.setPosition(listX, listY);
     listBg.setFillColor(sf::Color(20, 20, 25, 200));
-    window.draw(listBg);
+    RenderStats::draw(window, listBg);
     
     // 渲染可见的配方
     int visibleRecipes = static_cast<int>(listHeight / RECIPE_HEIGHT);
@@ -556,7 +645,7 @@ void CraftingPanel::renderRecipeList(sf::RenderWindow& window) {
         sf::RectangleShape itemBg(sf::Vector2f(LIST_WIDTH - 24, RECIPE_HEIGHT - 4));
         itemBg.setPosition(listX + 2, itemY + 2);
         
-        bool canCraft = CraftingManager::getInstance().canCraft(recipe, inventory);
+        bool canCraft = craftability.isCraftable(recipeIndex);
         bool isSelected = (recipeIndex == selectedRecipe);
         bool isHovered = (recipeIndex == hoveredRecipe);
         
@@ -570,7 +659,7 @@ void CraftingPanel::renderRecipeList(sf::RenderWindow& window) {
         
         itemBg.setOutlineThickness(1);
         itemBg.setOutlineColor(canCraft ? sf::Color(100, 200, 100) : sf::Color(80, 80, 80));
-        window.draw(itemBg);
+        RenderStats::draw(window, itemBg);
         
         // 配方名称
         if (fontLoaded) {
@@ -580,7 +669,7 @@ void CraftingPanel::renderRecipeList(sf::RenderWindow& window) {
             nameText.setCharacterSize(14);
             nameText.setFillColor(canCraft ? sf::Color(150, 255, 150) : sf::Color(180, 180, 180));
             nameText.setPosition(listX + 10, itemY + 8);
-            window.draw(nameText);
+            RenderStats::draw(window, nameText);
             
             // 产物信息
             std::stringstream ss;
@@ -591,7 +680,7 @@ void CraftingPanel::renderRecipeList(sf::RenderWindow& window) {
             resultText.setCharacterSize(12);
             resultText.setFillColor(sf::Color(200, 200, 100));
             resultText.setPosition(listX + 10, itemY + 30);
-            window.draw(resultText);
+            RenderStats::draw(window, resultText);
         }
         
         // 可合成标记
@@ -599,7 +688,7 @@ void CraftingPanel::renderRecipeList(sf::RenderWindow& window) {
             sf::CircleShape indicator(5);
             indicator.setFillColor(sf::Color(100, 255, 100));
             indicator.setPosition(listX + LIST_WIDTH - 40, itemY + 25);
-            window.draw(indicator);
+            RenderStats::draw(window, indicator);
         }
     }
 }
@@ -617,7 +706,7 @@ void CraftingPanel::renderRecipeDetail(sf::RenderWindow& window) {
             hintText.setCharacterSize(14);
             hintText.setFillColor(sf::Color(150, 150, 150));
             hintText.setPosition(panelPosition.x + LIST_WIDTH + 30, panelPosition.y + 150);
-            window.draw(hintText);
+            RenderStats::draw(window, hintText);
         }
         return;
     }
@@ -635,7 +724,7 @@ void CraftingPanel::renderRecipeDetail(sf::RenderWindow& window) {
         nameText.setCharacterSize(18);
         nameText.setFillColor(sf::Color(255, 220, 150));
         nameText.setPosition(detailX, detailY);
-        window.draw(nameText);
+        RenderStats::draw(window, nameText);
         
         // 描述
         sf::Text descText;
@@ -644,7 +733,7 @@ void CraftingPanel::renderRecipeDetail(sf::RenderWindow& window) {
         descText.setCharacterSize(12);
         descText.setFillColor(sf::Color(180, 180, 180));
         descText.setPosition(detailX, detailY + 30);
-        window.draw(descText);
+        RenderStats::draw(window, descText);
         
         // 所需材料标题
         std::string ingTitle = "所需材料:";
@@ -654,7 +743,7 @@ void CraftingPanel::renderRecipeDetail(sf::RenderWindow& window) {
         ingTitleText.setCharacterSize(14);
         ingTitleText.setFillColor(sf::Color(200, 200, 200));
         ingTitleText.setPosition(detailX, detailY + 60);
-        window.draw(ingTitleText);
+        RenderStats::draw(window, ingTitleText);
         
         // 渲染所需材料
         float ingY = detailY + 85;
@@ -672,7 +761,7 @@ void CraftingPanel::renderRecipeDetail(sf::RenderWindow& window) {
         resultTitleText.setCharacterSize(14);
         resultTitleText.setFillColor(sf::Color(200, 200, 200));
         resultTitleText.setPosition(detailX, ingY + 10);
-        window.draw(resultTitleText);
+        RenderStats::draw(window, resultTitleText);
         
         // 产出物品
         const ItemData* resultData = ItemDatabase::getInstance().getItemData(recipe.resultItemId);
@@ -687,7 +776,7 @@ void CraftingPanel::renderRecipeDetail(sf::RenderWindow& window) {
         resultText.setCharacterSize(14);
         resultText.setFillColor(sf::Color(100, 255, 100));
         resultText.setPosition(detailX + 20, ingY + 35);
-        window.draw(resultText);
+        RenderStats::draw(window, resultText);
         
         // 如果是装备，显示特殊效果
         if (recipe.isEquipment) {
@@ -700,20 +789,21 @@ void CraftingPanel::renderRecipeDetail(sf::RenderWindow& window) {
                 effectText.setCharacterSize(12);
                 effectText.setFillColor(sf::Color(255, 200, 100));
                 effectText.setPosition(detailX + 20, ingY + 55);
-                window.draw(effectText);
+                RenderStats::draw(window, effectText);
             }
         }
     }
     
-    // 合成按钮
-    bool canCraft = CraftingManager::getInstance().canCraft(recipe, inventory);
+    // 合成按钮（可行性由规划器判断，材料不足时会自动合成中间品）
+    CraftingManager& manager = CraftingManager::getInstance();
+    bool canCraft = inventory && manager.plan(selectedRecipe, 1, *inventory).feasible;
     
     sf::RectangleShape craftBtn(sf::Vector2f(100, 35));
     craftBtn.setPosition(detailX + 10, panelPosition.y + panelSize.y - 50);
     craftBtn.setFillColor(canCraft ? CRAFTABLE_COLOR : NOT_CRAFTABLE_COLOR);
     craftBtn.setOutlineThickness(2);
     craftBtn.setOutlineColor(canCraft ? sf::Color(100, 200, 100) : sf::Color(150, 100, 100));
-    window.draw(craftBtn);
+    RenderStats::draw(window, craftBtn);
     
     if (fontLoaded) {
         sf::Text btnText;
@@ -728,7 +818,36 @@ void CraftingPanel::renderRecipeDetail(sf::RenderWindow& window) {
             detailX + 10 + (100 - bounds.width) / 2,
             panelPosition.y + panelSize.y - 45
         );
-        window.draw(btnText);
+        RenderStats::draw(window, btnText);
+    }
+    
+    // 全部合成按钮
+    int maxCraftable = canCraft ? manager.getMaxCraftable(selectedRecipe, *inventory) : 0;
+    
+    sf::RectangleShape craftMaxBtn(sf::Vector2f(100, 35));
+    craftMaxBtn.setPosition(detailX + 120, panelPosition.y + panelSize.y - 50);
+    craftMaxBtn.setFillColor(maxCraftable > 0 ? CRAFTABLE_COLOR : NOT_CRAFTABLE_COLOR);
+    craftMaxBtn.setOutlineThickness(2);
+    craftMaxBtn.setOutlineColor(maxCraftable > 0 ? sf::Color(100, 200, 100) : sf::Color(150, 100, 100));
+    RenderStats::draw(window, craftMaxBtn);
+    
+    if (fontLoaded) {
+        sf::Text btnText;
+        btnText.setFont(font);
+        std::string btnStr = "全部合成";
+        if (maxCraftable > 0) {
+            btnStr += " x" + std::to_string(maxCraftable);
+        }
+        btnText.setString(sf::String::fromUtf8(btnStr.begin(), btnStr.end()));
+        btnText.setCharacterSize(14);
+        btnText.setFillColor(sf::Color::White);
+        
+        sf::FloatRect bounds = btnText.getLocalBounds();
+        btnText.setPosition(
+            detailX + 120 + (100 - bounds.width) / 2,
+            panelPosition.y + panelSize.y - 45
+        );
+        RenderStats::draw(window, btnText);
     }
 }
 
@@ -751,13 +870,13 @@ void CraftingPanel::renderIngredient(sf::RenderWindow& window, const RecipeIngre
     text.setCharacterSize(13);
     text.setFillColor(hasEnough ? sf::Color(150, 255, 150) : sf::Color(255, 150, 150));
     text.setPosition(pos);
-    window.draw(text);
+    RenderStats::draw(window, text);
     
     // 状态指示
     sf::CircleShape indicator(4);
     indicator.setFillColor(hasEnough ? sf::Color(100, 255, 100) : sf::Color(255, 100, 100));
     indicator.setPosition(pos.x, pos.y + 5);
-    window.draw(indicator);
+    RenderStats::draw(window, indicator);
 }
 
 int CraftingPanel::getRecipeAtPosition(const sf::Vector2f& pos) const {
@@ -783,12 +902,12 @@ void CraftingPanel::open() {
     selectedRecipe = -1;
     hoveredRecipe = -1;
     scrollOffset = 0;
-    std::cout << "[CraftingPanel] Opened" << std::endl;
+    LOG_INFO("[CraftingPanel] Opened");
 }
 
 void CraftingPanel::close() {
     panelOpen = false;
-    std::cout << "[CraftingPanel] Closed" << std::endl;
+    LOG_INFO("[CraftingPanel] Closed");
 }
 
 void CraftingPanel::toggle() {
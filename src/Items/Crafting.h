@@ -4,6 +4,8 @@
 #include <SFML/Graphics.hpp>
 #include <vector>
 #include <map>
+#include <unordered_map>
+#include <cstdint>
 #include <functional>
 
 // ============================================================================
@@ -22,6 +24,16 @@
 //   - 3 木材 = 1 木盾
 //   - 2 木材 + 1 石头 = 1 木剑
 //
+// 【索引与缓存】
+//   - 配方按 ID、按材料、按产物建立索引，getRecipe 为哈希查找
+//   - CraftabilityTracker 以位集记录每个配方是否可合成；背包某种物品
+//     数量变化时，只把用到该物品的配方标记为待检查，查询时再重新计算
+//
+// 【多级合成规划】
+//   - 材料不足时，若有配方能产出该材料，自动先合成中间品（可多级嵌套）
+//   - 规划结果按 (配方, 次数) 缓存，背包版本号变化后失效
+//   - 批量合成（全部合成）只对背包做一次净增减，而不是循环调用 craft
+//
 // ============================================================================
 
 // 配方材料
@@ -48,6 +60,21 @@ struct CraftingRecipe {
         , isEquipment(false) {}
 };
 
+// 已解析的配方（物品ID已驻留为 ItemId，运行时使用）
+struct ResolvedRecipe {
+    ItemId result = INVALID_ITEM_ID;
+    int resultCount = 1;
+    std::vector<std::pair<ItemId, int>> ingredients;
+};
+
+// 合成规划结果
+struct CraftPlan {
+    bool feasible = false;
+    int times = 0;                                  // 目标配方合成次数
+    std::vector<std::pair<size_t, int>> steps;      // (配方下标, 次数)，中间品在前
+    std::vector<std::pair<ItemId, int>> delta;      // 背包净变化（负数为消耗）
+};
+
 // ============================================================================
 // 合成管理器（单例）
 // ============================================================================
@@ -56,28 +83,103 @@ class CraftingManager {
 public:
     static CraftingManager& getInstance();
     
-    // 初始化配方
-    void initialize();
+    // 初始化配方（由 ItemDefinitions 从数据文件加载）
+    void initialize(const std::vector<CraftingRecipe>& definitions);
     
     // 获取配方
     const CraftingRecipe* getRecipe(const std::string& recipeId) const;
+    int getRecipeIndex(const std::string& recipeId) const;
     
     // 获取所有配方
     const std::vector<CraftingRecipe>& getAllRecipes() const { return recipes; }
+    const ResolvedRecipe& getResolved(size_t index) const { return resolved[index]; }
+    
+    // 用到/产出某物品的配方下标
+    const std::vector<std::uint16_t>& getRecipesUsing(ItemId itemId) const;
+    const std::vector<std::uint16_t>& getRecipesProducing(ItemId itemId) const;
     
     // 注册配方
     void registerRecipe(const CraftingRecipe& recipe);
     
-    // 检查是否可以合成（材料是否足够）
+    // 检查是否可以直接合成（材料是否足够，不含中间品）
     bool canCraft(const CraftingRecipe& recipe, CategoryInventory* inventory) const;
+    bool canCraftDirect(size_t index, const CategoryInventory& inventory) const;
     
-    // 执行合成
+    // ========================================
+    // 多级合成
+    // ========================================
+    
+    // 规划合成 times 次（材料不足时自动安排中间品）
+    const CraftPlan& plan(size_t index, int times, const CategoryInventory& inventory) const;
+    
+    // 最多可以合成多少次（含中间品）
+    int getMaxCraftable(size_t index, const CategoryInventory& inventory) const;
+    
+    // 按规划批量合成，返回实际产出数量
+    int craftBatch(size_t index, int times, CategoryInventory* inventory);
+    
+    // 执行合成（一次）
     bool craft(const CraftingRecipe& recipe, CategoryInventory* inventory);
 
 private:
     CraftingManager() = default;
+    
+    // 规划时的背包模拟状态
+    struct PlanState;
+    bool planRecipe(size_t index, int times, PlanState& state, int depth) const;
+    bool planItem(ItemId itemId, int needed, PlanState& state, int depth) const;
+    
+    // 背包变化后清空规划缓存
+    void validatePlanCache(const CategoryInventory& inventory) const;
+    
+    static constexpr int MAX_PLAN_DEPTH = 8;
+    static constexpr int MAX_BATCH = 999;
+    
     std::vector<CraftingRecipe> recipes;
+    std::vector<ResolvedRecipe> resolved;
+    std::unordered_map<std::string, size_t> recipeLookup;
+    std::vector<std::vector<std::uint16_t>> recipesByIngredient;   // 下标为 ItemId
+    std::vector<std::vector<std::uint16_t>> recipesByResult;       // 下标为 ItemId
     bool initialized = false;
+    
+    // 规划缓存（键：配方下标 << 32 | 次数）
+    mutable std::unordered_map<std::uint64_t, CraftPlan> planCache;
+    mutable std::unordered_map<size_t, int> maxCraftableCache;
+    mutable const CategoryInventory* planCacheInventory = nullptr;
+    mutable std::uint32_t planCacheRevision = 0;
+};
+
+// ============================================================================
+// 可合成状态跟踪（位集，按材料增量更新）
+// ============================================================================
+
+class CraftabilityTracker {
+public:
+    ~CraftabilityTracker() { detach(); }
+    
+    // 绑定背包（注册数量变化回调，全部标记为待检查）
+    void attach(CategoryInventory* inv);
+    void detach();
+    
+    // 某物品数量变化：标记直接或经由中间品用到它的配方
+    void markItemChanged(ItemId itemId);
+    void markAllDirty();
+    
+    // 查询（待检查的配方在此时按规划器重新计算，与合成按钮一致）
+    bool isCraftable(size_t recipeIndex);
+
+private:
+    static bool testBit(const std::vector<std::uint64_t>& bits, size_t i) {
+        return (bits[i / 64] >> (i % 64)) & 1u;
+    }
+    static void setBit(std::vector<std::uint64_t>& bits, size_t i, bool value) {
+        if (value) bits[i / 64] |= (std::uint64_t(1) << (i % 64));
+        else       bits[i / 64] &= ~(std::uint64_t(1) << (i % 64));
+    }
+    
+    CategoryInventory* inventory = nullptr;
+    std::vector<std::uint64_t> craftable;
+    std::vector<std::uint64_t> dirty;
 };
 
 // ============================================================================
@@ -96,7 +198,10 @@ public:
     bool loadFont(const std::string& fontPath);
     
     // 设置关联的背包
-    void setInventory(CategoryInventory* inv) { inventory = inv; }
+    void setInventory(CategoryInventory* inv) {
+        inventory = inv;
+        craftability.attach(inv);
+    }
     
     // 设置图标位置
     void setIconPosition(float x, float y);
@@ -129,6 +234,7 @@ private:
 
 private:
     CategoryInventory* inventory;
+    CraftabilityTracker craftability;
     
     // UI状态
     bool panelOpen;
@@ -1,7 +1,8 @@
 #include "DroppedItem.h"
-#include <iostream>
 #include <cmath>
-#include <cstdlib>
+#include "../Systems/Random.h"
+#include "../Systems/Logger.h"
+#include "../Systems/RenderStats.h"
 #include <algorithm>
 
 // 静态字体指针
@@ -31,17 +32,18 @@ DroppedItem::DroppedItem(const std::string& id, int cnt, float x, float y)
     , groundY(y)                // 记录初始Y位置作为地面
     , onGround(false)
     , lifetime(300.0f)
-    , floatTimer((float)(rand() % 100) / 100.0f * 3.14159f * 2)  // 随机初始相位
+    , floatTimer(RandomService::getInstance().stream(RngStream::Particles).nextFloat() * 3.14159f * 2)  // 随机初始相位
     , floatOffset(0)
     , pickedUp(false)
     , texture(nullptr)
     , hasTexture(false)
 {
     // 随机初始速度（散开效果）
-    float angle = (float)(rand() % 360) * 3.14159f / 180.0f;
-    float speed = 30.0f + (float)(rand() % 30);
+    Rng& rng = RandomService::getInstance().stream(RngStream::Particles);
+    float angle = (float)rng.range(0, 359) * 3.14159f / 180.0f;
+    float speed = 30.0f + (float)rng.range(0, 29);
     velocity.x = std::cos(angle) * speed;
-    velocity.y = -80.0f - (float)(rand() % 40);  // 向上抛出
+    velocity.y = -80.0f - (float)rng.range(0, 39);  // 向上抛出
     
     // 设置数量文字
     if (sharedFont) {
@@ -120,7 +122,7 @@ void DroppedItem::render(sf::RenderWindow& window) {
     if (!visible) return;
     
     if (hasTexture) {
-        window.draw(sprite);
+        RenderStats::draw(window, sprite);
     } else {
         // 绘制占位符（2倍大小）
         sf::RectangleShape placeholder(sf::Vector2f(64, 64));
@@ -128,12 +130,12 @@ void DroppedItem::render(sf::RenderWindow& window) {
         placeholder.setFillColor(sf::Color(150, 100, 50, 200));
         placeholder.setOutlineThickness(2);
         placeholder.setOutlineColor(sf::Color::White);
-        window.draw(placeholder);
+        RenderStats::draw(window, placeholder);
     }
     
     // 绘制数量
     if (count > 1 && sharedFont) {
-        window.draw(countText);
+        RenderStats::draw(window, countText);
     }
 }
 
@@ -165,6 +167,25 @@ void DroppedItem::setTexture(const sf::Texture* tex) {
     }
 }
 
+DroppedItemSaveData DroppedItem::captureSaveData() const {
+    DroppedItemSaveData data;
+    data.itemId = itemId;
+    data.count = count;
+    // 空中的物品按落地位置保存
+    data.position = sf::Vector2f(position.x, onGround ? position.y : groundY);
+    data.lifetime = lifetime;
+    return data;
+}
+
+void DroppedItem::applySaveData(const DroppedItemSaveData& data) {
+    position = data.position;
+    groundY = data.position.y;
+    velocity = sf::Vector2f(0, 0);
+    onGround = true;
+    lifetime = data.lifetime;
+    sprite.setPosition(position);
+}
+
 // ============================================================================
 // DroppedItemManager 实现
 // ============================================================================
@@ -190,7 +211,7 @@ bool DroppedItemManager::init(const std::string& assetsPath) {
         if (loadFont(path)) break;
     }
     
-    std::cout << "[DroppedItemManager] Initialized" << std::endl;
+    LOG_INFO("[DroppedItemManager] Initialized");
     return true;
 }
 
@@ -198,7 +219,7 @@ bool DroppedItemManager::loadFont(const std::string& fontPath) {
     if (font.loadFromFile(fontPath)) {
         fontLoaded = true;
         DroppedItem::setSharedFont(&font);
-        std::cout << "[DroppedItemManager] Font loaded: " << fontPath << std::endl;
+        LOG_INFO("[DroppedItemManager] Font loaded: " << fontPath);
         return true;
     }
     return false;
@@ -247,11 +268,11 @@ void DroppedItemManager::spawnItem(const std::string& itemId, int count, float x
     
     const ItemData* data = ItemDatabase::getInstance().getItemData(itemId);
     std::string name = data ? data->name : itemId;
-    std::cout << "[DroppedItemManager] Spawned " << count << "x " << name 
-              << " at (" << x << ", " << y << ")" << std::endl;
+    LOG_DEBUG("[DroppedItemManager] Spawned " << count << "x " << name 
+          << " at (" << x << ", " << y << ")");
 }
 
-void DroppedItemManager::spawnItems(const std::vector<std::pair<std::string, int>>& items, 
+void DroppedItemManager::spawnItems(const FrameVector<std::pair<std::string, int>>& items, 
                                      float x, float y) {
     float spacing = 40.0f;  // 物品之间的间距
     
@@ -265,12 +286,14 @@ void DroppedItemManager::spawnItems(const std::vector<std::pair<std::string, int
     }
 }
 
-std::vector<std::pair<std::string, int>> DroppedItemManager::calculateDrops(
+FrameVector<std::pair<std::string, int>> DroppedItemManager::calculateDrops(
     const std::vector<std::string>& dropTypes,
     const std::vector<float>& dropProbabilities,
     int dropMax) {
     
-    std::vector<std::pair<std::string, int>> result;
+    FrameVector<std::pair<std::string, int>> result;
+    result.reserve(dropTypes.size());
+    Rng& rng = RandomService::getInstance().stream(RngStream::Drops);
     
     for (size_t i = 0; i < dropTypes.size(); i++) {
         const std::string& itemId = dropTypes[i];
@@ -288,7 +311,7 @@ std::vector<std::pair<std::string, int>> DroppedItemManager::calculateDrops(
         float currentProbability = baseProbability;
         
         for (int j = 0; j < dropMax; j++) {
-            float roll = (float)(rand() % 1000) / 1000.0f;
+            float roll = rng.nextFloat();
             if (roll < currentProbability) {
                 count++;
                 currentProbability *= baseProbability;  // 递减概率
@@ -339,3 +362,35 @@ void DroppedItemManager::cleanup() {
 void DroppedItemManager::clearAll() {
     droppedItems.clear();
 }
+
+// ============================================================================
+// 存档
+// ============================================================================
+
+std::vector<DroppedItemSaveData> DroppedItemManager::captureSaveData() const {
+    std::vector<DroppedItemSaveData> data;
+    data.reserve(droppedItems.size());
+    for (const auto& item : droppedItems) {
+        if (!item->isPickedUp() && !item->isExpired()) {
+            data.push_back(item->captureSaveData());
+        }
+    }
+    return data;
+}
+
+void DroppedItemManager::applySaveData(const std::vector<DroppedItemSaveData>& data) {
+    clearAll();
+    droppedItems.reserve(data.size());
+    
+    for (const auto& entry : data) {
+        if (entry.itemId.empty() || entry.count <= 0) continue;
+        
+        auto item = std::make_unique<DroppedItem>(entry.itemId, entry.count, entry.position.x, entry.position.y);
+        const sf::Texture* tex = ItemDatabase::getInstance().getTexture(entry.itemId);
+        if (tex) {
+            item->setTexture(tex);
+        }
+        item->applySaveData(entry);
+        droppedItems.push_back(std::move(item));
+    }
+}
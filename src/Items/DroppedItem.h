@@ -1,5 +1,6 @@
 #pragma once
 #include "Item.h"
+#include "../Systems/FrameArena.h"
 #include <SFML/Graphics.hpp>
 #include <vector>
 #include <memory>
@@ -38,6 +39,14 @@
 //
 // ============================================================================
 
+// 存档数据
+struct DroppedItemSaveData {
+    std::string itemId;
+    int count = 0;
+    sf::Vector2f position;      // 落地位置
+    float lifetime = 0.0f;      // 剩余存活时间
+};
+
 // 单个掉落物品实体
 class DroppedItem {
 public:
@@ -63,6 +72,10 @@ public:
     // 标记为已拾取
     void markPickedUp() { pickedUp = true; }
     
+    // 存档
+    DroppedItemSaveData captureSaveData() const;
+    void applySaveData(const DroppedItemSaveData& data);
+    
     // 设置贴图
     void setTexture(const sf::Texture* tex);
     
@@ -116,7 +129,7 @@ public:
     void spawnItem(const std::string& itemId, int count, float x, float y);
     
     // 在指定位置生成多个物品（散开显示）
-    void spawnItems(const std::vector<std::pair<std::string, int>>& items, float x, float y);
+    void spawnItems(const FrameVector<std::pair<std::string, int>>& items, float x, float y);
     
     // ========================================
     // 掉落计算
@@ -127,7 +140,7 @@ public:
     // dropProbabilities: 对应的掉落概率
     // dropMax: 单个物品最大数量
     // 返回: (物品ID, 数量) 列表
-    static std::vector<std::pair<std::string, int>> calculateDrops(
+    static FrameVector<std::pair<std::string, int>> calculateDrops(
         const std::vector<std::string>& dropTypes,
         const std::vector<float>& dropProbabilities,
         int dropMax);
@@ -154,6 +167,12 @@ public:
     
     // 获取掉落物品数量
     size_t getDroppedItemCount() const { return droppedItems.size(); }
+    
+    // ========================================
+    // 存档
+    // ========================================
+    std::vector<DroppedItemSaveData> captureSaveData() const;
+    void applySaveData(const std::vector<DroppedItemSaveData>& data);
 
 private:
     std::vector<std::unique_ptr<DroppedItem>> droppedItems;
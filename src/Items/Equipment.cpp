@@ -1,5 +1,7 @@
 #include "Equipment.h"
-#include <iostream>
+#include "../Systems/InputSystem.h"
+#include "../Systems/Logger.h"
+#include "../Systems/RenderStats.h"
 #include <algorithm>
 
 // ============================================================================
@@ -21,264 +23,16 @@ EquipmentManager& EquipmentManager::getInstance() {
     return instance;
 }
 
-void EquipmentManager::initialize() {
+void EquipmentManager::initialize(const std::vector<EquipmentData>& definitions) {
     if (initialized) return;
     
-    std::cout << "[EquipmentManager] Initializing equipment definitions..." << std::endl;
-    
-    // ========================================
-    // 武器 - 斧头系列（无视防御）
-    // ========================================
-    {
-        EquipmentData axe;
-        axe.id = "wooden_axe";
-        axe.name = "木斧";
-        axe.description = "简单的木制斧头，可以无视目标的防御";
-        axe.slot = EquipmentSlot::Weapon;
-        axe.weaponType = WeaponType::Axe;
-        axe.rarity = ItemRarity::Common;
-        axe.requiredLevel = 1;
-        axe.stats.attack = 8;
-        axe.stats.ignoreDefense = true;
-        axe.stats.ignoreDefenseRate = 1.0f;  // 完全无视防御
-        axe.texturePath = "assets/equipment/wooden_axe.png";
-        registerEquipment(axe);
-    }
-    
-    {
-        EquipmentData axe;
-        axe.id = "iron_axe";
-        axe.name = "铁斧";
-        axe.description = "坚固的铁制斧头，可以无视目标的防御";
-        axe.slot = EquipmentSlot::Weapon;
-        axe.weaponType = WeaponType::Axe;
-        axe.rarity = ItemRarity::Uncommon;
-        axe.requiredLevel = 10;
-        axe.requiredStrength = 15;
-        axe.stats.attack = 18;
-        axe.stats.strength = 2;
-        axe.stats.ignoreDefense = true;
-        axe.stats.ignoreDefenseRate = 1.0f;
-        axe.texturePath = "assets/equipment/iron_axe.png";
-        registerEquipment(axe);
-    }
-    
-    // ========================================
-    // 武器 - 剑系列
-    // ========================================
-    {
-        EquipmentData sword;
-        sword.id = "wooden_sword";
-        sword.name = "木剑";
-        sword.description = "新手战士的第一把武器";
-        sword.slot = EquipmentSlot::Weapon;
-        sword.weaponType = WeaponType::Sword;
-        sword.rarity = ItemRarity::Common;
-        sword.requiredLevel = 1;
-        sword.stats.attack = 5;
-        sword.texturePath = "assets/equipment/wooden_sword.png";
-        registerEquipment(sword);
-    }
-    
-    {
-        EquipmentData sword;
-        sword.id = "iron_sword";
-        sword.name = "铁剑";
-        sword.description = "标准的铁制长剑";
-        sword.slot = EquipmentSlot::Weapon;
-        sword.weaponType = WeaponType::Sword;
-        sword.rarity = ItemRarity::Uncommon;
-        sword.requiredLevel = 10;
-        sword.requiredStrength = 10;
-        sword.stats.attack = 15;
-        sword.stats.strength = 1;
-        sword.texturePath = "assets/equipment/iron_sword.png";
-        registerEquipment(sword);
-    }
-    
-    // ========================================
-    // 防具 - 头盔
-    // ========================================
-    {
-        EquipmentData helmet;
-        helmet.id = "leather_cap";
-        helmet.name = "皮帽";
-        helmet.description = "简单的皮制帽子";
-        helmet.slot = EquipmentSlot::Helmet;
-        helmet.rarity = ItemRarity::Common;
-        helmet.requiredLevel = 1;
-        helmet.stats.defense = 2;
-        helmet.stats.hp = 10;
-        helmet.texturePath = "assets/equipment/leather_cap.png";
-        registerEquipment(helmet);
-    }
-    
-    {
-        EquipmentData helmet;
-        helmet.id = "iron_helmet";
-        helmet.name = "铁盔";
-        helmet.description = "坚固的铁制头盔";
-        helmet.slot = EquipmentSlot::Helmet;
-        helmet.rarity = ItemRarity::Uncommon;
-        helmet.requiredLevel = 10;
-        helmet.requiredStrength = 5;
-        helmet.stats.defense = 8;
-        helmet.stats.hp = 30;
-        helmet.stats.strength = 1;
-        helmet.texturePath = "assets/equipment/iron_helmet.png";
-        registerEquipment(helmet);
-    }
-    
-    // ========================================
-    // 防具 - 铠甲
-    // ========================================
-    {
-        EquipmentData armor;
-        armor.id = "leather_armor";
-        armor.name = "皮甲";
-        armor.description = "轻便的皮制护甲";
-        armor.slot = EquipmentSlot::Armor;
-        armor.rarity = ItemRarity::Common;
-        armor.requiredLevel = 1;
-        armor.stats.defense = 5;
-        armor.stats.hp = 20;
-        armor.texturePath = "assets/equipment/leather_armor.png";
-        registerEquipment(armor);
-    }
-    
-    {
-        EquipmentData armor;
-        armor.id = "iron_armor";
-        armor.name = "铁甲";
-        armor.description = "厚重的铁制铠甲";
-        armor.slot = EquipmentSlot::Armor;
-        armor.rarity = ItemRarity::Uncommon;
-        armor.requiredLevel = 10;
-        armor.requiredStrength = 20;
-        armor.stats.defense = 15;
-        armor.stats.hp = 50;
-        armor.stats.strength = 2;
-        armor.texturePath = "assets/equipment/iron_armor.png";
-        registerEquipment(armor);
-    }
-    
-    // ========================================
-    // 防具 - 裤子
-    // ========================================
-    {
-        EquipmentData pants;
-        pants.id = "leather_pants";
-        pants.name = "皮裤";
-        pants.description = "简单的皮制裤子";
-        pants.slot = EquipmentSlot::Pants;
-        pants.rarity = ItemRarity::Common;
-        pants.requiredLevel = 1;
-        pants.stats.defense = 3;
-        pants.stats.hp = 10;
-        pants.texturePath = "assets/equipment/leather_pants.png";
-        registerEquipment(pants);
-    }
-    
-    // ========================================
-    // 防具 - 手套
-    // ========================================
-    {
-        EquipmentData gloves;
-        gloves.id = "leather_gloves";
-        gloves.name = "皮手套";
-        gloves.description = "简单的皮制手套";
-        gloves.slot = EquipmentSlot::Gloves;
-        gloves.rarity = ItemRarity::Common;
-        gloves.requiredLevel = 1;
-        gloves.stats.defense = 1;
-        gloves.stats.attack = 1;
-        gloves.texturePath = "assets/equipment/leather_gloves.png";
-        registerEquipment(gloves);
-    }
-    
-    {
-        EquipmentData gloves;
-        gloves.id = "warrior_gloves";
-        gloves.name = "战士手套";
-        gloves.description = "战士专用的强化手套";
-        gloves.slot = EquipmentSlot::Gloves;
-        gloves.rarity = ItemRarity::Uncommon;
-        gloves.requiredLevel = 10;
-        gloves.requiredStrength = 8;
-        gloves.stats.defense = 3;
-        gloves.stats.attack = 3;
-        gloves.stats.strength = 1;
-        gloves.texturePath = "assets/equipment/warrior_gloves.png";
-        registerEquipment(gloves);
-    }
-    
-    // ========================================
-    // 防具 - 鞋子
-    // ========================================
-    {
-        EquipmentData boots;
-        boots.id = "leather_boots";
-        boots.name = "皮靴";
-        boots.description = "简单的皮制靴子";
-        boots.slot = EquipmentSlot::Boots;
-        boots.rarity = ItemRarity::Common;
-        boots.requiredLevel = 1;
-        boots.stats.defense = 2;
-        boots.stats.speed = 5;
-        boots.texturePath = "assets/equipment/leather_boots.png";
-        registerEquipment(boots);
-    }
-    
-    // ========================================
-    // 饰品 - 披风
-    // ========================================
-    {
-        EquipmentData cape;
-        cape.id = "simple_cape";
-        cape.name = "简易披风";
-        cape.description = "一件普通的披风";
-        cape.slot = EquipmentSlot::Cape;
-        cape.rarity = ItemRarity::Common;
-        cape.requiredLevel = 1;
-        cape.stats.defense = 1;
-        cape.stats.hp = 5;
-        cape.texturePath = "assets/equipment/simple_cape.png";
-        registerEquipment(cape);
-    }
-    
-    // ========================================
-    // 饰品 - 副手盾牌
-    // ========================================
-    {
-        EquipmentData shield;
-        shield.id = "wooden_shield";
-        shield.name = "木盾";
-        shield.description = "简单的木制盾牌";
-        shield.slot = EquipmentSlot::SecondHand;
-        shield.rarity = ItemRarity::Common;
-        shield.requiredLevel = 1;
-        shield.stats.defense = 5;
-        shield.texturePath = "assets/equipment/wooden_shield.png";
-        registerEquipment(shield);
-    }
-    
-    {
-        EquipmentData shield;
-        shield.id = "iron_shield";
-        shield.name = "铁盾";
-        shield.description = "坚固的铁制盾牌";
-        shield.slot = EquipmentSlot::SecondHand;
-        shield.rarity = ItemRarity::Uncommon;
-        shield.requiredLevel = 10;
-        shield.requiredStrength = 15;
-        shield.stats.defense = 12;
-        shield.stats.hp = 20;
-        shield.texturePath = "assets/equipment/iron_shield.png";
-        registerEquipment(shield);
+    // 定义来自 assets/data/equipment.json（见 ItemDefinitions）
+    for (const auto& data : definitions) {
+        registerEquipment(data);
     }
     
     initialized = true;
-    std::cout << "[EquipmentManager] Registered " << equipments.size() << " equipments" << std::endl;
+    LOG_INFO("[EquipmentManager] Registered " << equipments.size() << " equipments");
 }
 
 const EquipmentData* EquipmentManager::getEquipmentData(const std::string& equipId) const {
@@ -291,7 +45,6 @@ const EquipmentData* EquipmentManager::getEquipmentData(const std::string& equip
 
 void EquipmentManager::registerEquipment(const EquipmentData& data) {
     equipments[data.id] = data;
-    std::cout << "[EquipmentManager] Registered: " << data.id << " (" << data.name << ")" << std::endl;
 }
 
 std::string EquipmentManager::getSlotName(EquipmentSlot slot) {
@@ -341,21 +94,21 @@ PlayerEquipment::PlayerEquipment() {
 std::string PlayerEquipment::equip(const std::string& equipId) {
     const EquipmentData* data = EquipmentManager::getInstance().getEquipmentData(equipId);
     if (!data) {
-        std::cout << "[PlayerEquipment] Unknown equipment: " << equipId << std::endl;
+        LOG_INFO("[PlayerEquipment] Unknown equipment: " << equipId);
         return "";
     }
     
     size_t slotIndex = static_cast<size_t>(data->slot);
     std::string replaced = equippedItems[slotIndex];
     
-    equippedItems[slotIndex] = equipId;
+    setSlot(slotIndex, equipId);
     
     if (onEquip) {
         onEquip(data->slot, equipId);
     }
     
-    std::cout << "[PlayerEquipment] Equipped: " << data->name << " -> " 
-              << EquipmentManager::getSlotName(data->slot) << std::endl;
+    LOG_INFO("[PlayerEquipment] Equipped: " << data->name << " -> " 
+          << EquipmentManager::getSlotName(data->slot));
     
     return replaced;
 }
@@ -364,14 +117,14 @@ ItemStack PlayerEquipment::equip(const EquipmentData& equipData) {
     size_t slotIndex = static_cast<size_t>(equipData.slot);
     std::string replaced = equippedItems[slotIndex];
     
-    equippedItems[slotIndex] = equipData.id;
+    setSlot(slotIndex, equipData.id);
     
     if (onEquip) {
         onEquip(equipData.slot, equipData.id);
     }
     
-    std::cout << "[PlayerEquipment] Equipped: " << equipData.name << " -> " 
-              << EquipmentManager::getSlotName(equipData.slot) << std::endl;
+    LOG_INFO("[PlayerEquipment] Equipped: " << equipData.name << " -> " 
+          << EquipmentManager::getSlotName(equipData.slot));
     
     // 返回被替换的装备作为ItemStack
     if (!replaced.empty()) {
@@ -385,15 +138,15 @@ std::string PlayerEquipment::unequip(EquipmentSlot slot) {
     std::string removed = equippedItems[slotIndex];
     
     if (!removed.empty()) {
-        equippedItems[slotIndex].clear();
+        setSlot(slotIndex, "");
         
         if (onUnequip) {
             onUnequip(slot, removed);
         }
         
         const EquipmentData* data = EquipmentManager::getInstance().getEquipmentData(removed);
-        std::cout << "[PlayerEquipment] Unequipped: " 
-                  << (data ? data->name : removed) << std::endl;
+        LOG_INFO("[PlayerEquipment] Unequipped: " 
+              << (data ? data->name : removed));
     }
     
     return removed;
@@ -420,34 +173,34 @@ bool PlayerEquipment::hasEquipment(EquipmentSlot slot) const {
     return !getEquippedItem(slot).empty();
 }
 
-EquipmentStats PlayerEquipment::getTotalStats() const {
-    EquipmentStats total;
-    
-    for (size_t i = 0; i < equippedItems.size(); i++) {
-        if (!equippedItems[i].empty()) {
-            const EquipmentData* data = EquipmentManager::getInstance().getEquipmentData(equippedItems[i]);
-            if (data) {
-                total = total + data->stats;
-            }
-        }
-    }
-    
-    return total;
+void PlayerEquipment::setSlot(size_t slotIndex, const std::string& equipId) {
+    equippedItems[slotIndex] = equipId;
+    equippedData[slotIndex] = equipId.empty() ? nullptr
+        : EquipmentManager::getInstance().getEquipmentData(equipId);
+    statsDirty = true;
 }
 
-bool PlayerEquipment::hasIgnoreDefense() const {
-    return getTotalStats().ignoreDefense;
+void PlayerEquipment::restoreEquippedItems(const EquippedArray& items) {
+    for (size_t i = 0; i < items.size(); i++) {
+        setSlot(i, items[i]);
+    }
 }
 
-float PlayerEquipment::getIgnoreDefenseRate() const {
-    return getTotalStats().ignoreDefenseRate;
+const EquipmentStats& PlayerEquipment::getTotalStats() const {
+    if (statsDirty) {
+        totalStats = EquipmentStats();
+        for (const EquipmentData* data : equippedData) {
+            if (data) {
+                totalStats = totalStats + data->stats;
+            }
+        }
+        statsDirty = false;
+    }
+    return totalStats;
 }
 
 WeaponType PlayerEquipment::getCurrentWeaponType() const {
-    const std::string& weaponId = getEquippedItem(EquipmentSlot::Weapon);
-    if (weaponId.empty()) return WeaponType::None;
-    
-    const EquipmentData* data = EquipmentManager::getInstance().getEquipmentData(weaponId);
+    const EquipmentData* data = equippedData[static_cast<size_t>(EquipmentSlot::Weapon)];
     return data ? data->weaponType : WeaponType::None;
 }
 
@@ -476,14 +229,14 @@ bool EquipmentPanel::init(const std::string& iconPath) {
         iconSprite.setTexture(iconTexture);
         iconSprite.setScale(0.8f, 0.8f);
         iconLoaded = true;
-        std::cout << "[EquipmentPanel] Icon loaded: " << iconPath << std::endl;
+        LOG_INFO("[EquipmentPanel] Icon loaded: " << iconPath);
     } else {
         sf::Image placeholder;
         placeholder.create(64, 64, sf::Color(80, 60, 100, 200));
         iconTexture.loadFromImage(placeholder);
         iconSprite.setTexture(iconTexture);
         iconLoaded = true;
-        std::cout << "[EquipmentPanel] Using placeholder icon" << std::endl;
+        LOG_INFO("[EquipmentPanel] Using placeholder icon");
     }
     
     std::vector<std::string> fontPaths = {
@@ -503,7 +256,7 @@ bool EquipmentPanel::init(const std::string& iconPath) {
 bool EquipmentPanel::loadFont(const std::string& fontPath) {
     if (font.loadFromFile(fontPath)) {
         fontLoaded = true;
-        std::cout << "[EquipmentPanel] Font loaded: " << fontPath << std::endl;
+        LOG_INFO("[EquipmentPanel] Font loaded: " << fontPath);
         return true;
     }
     return false;
@@ -531,8 +284,8 @@ void EquipmentPanel::update(float dt) {
     );
 }
 
-void EquipmentPanel::handleEvent(const sf::Event& event, sf::RenderWindow& window) {
-    sf::Vector2i mousePos = sf::Mouse::getPosition(window);
+void EquipmentPanel::handleEvent(const sf::Event& event, sf::RenderWindow& /*window*/) {
+    sf::Vector2i mousePos = InputSystem::getInstance().getMousePosition();
     sf::Vector2f mousePosF(static_cast<float>(mousePos.x), static_cast<float>(mousePos.y));
     
     // 检查图标悬浮
@@ -626,8 +379,8 @@ void EquipmentPanel::render(sf::RenderWindow& window) {
         iconBg.setFillColor(sf::Color(30, 30, 40, 200));
         iconBg.setOutlineThickness(2);
         iconBg.setOutlineColor(BORDER_COLOR);
-        window.draw(iconBg);
-        window.draw(iconSprite);
+        RenderStats::draw(window, iconBg);
+        RenderStats::draw(window, iconSprite);
     }
     
     if (!panelOpen || !equipment) return;
@@ -643,13 +396,13 @@ void EquipmentPanel::render(sf::RenderWindow& window) {
     bg.setFillColor(BG_COLOR);
     bg.setOutlineThickness(3);
     bg.setOutlineColor(BORDER_COLOR);
-    window.draw(bg);
+    RenderStats::draw(window, bg);
     
     // 标题栏
     sf::RectangleShape titleBar(sf::Vector2f(panelSize.x - 6, 30));
     titleBar.setPosition(panelPosition.x + 3, panelPosition.y + 3);
     titleBar.setFillColor(sf::Color(60, 45, 30, 200));
-    window.draw(titleBar);
+    RenderStats::draw(window, titleBar);
     
     if (fontLoaded) {
         sf::Text title;
@@ -659,7 +412,7 @@ void EquipmentPanel::render(sf::RenderWindow& window) {
         title.setCharacterSize(20);
         title.setFillColor(sf::Color(255, 220, 150));
         title.setPosition(panelPosition.x + 15, panelPosition.y + 5);
-        window.draw(title);
+        RenderStats::draw(window, title);
     }
     
     // 关闭按钮
@@ -668,7 +421,7 @@ void EquipmentPanel::render(sf::RenderWindow& window) {
     closeBtn.setFillColor(sf::Color(150, 50, 50, 200));
     closeBtn.setOutlineThickness(1);
     closeBtn.setOutlineColor(sf::Color::White);
-    window.draw(closeBtn);
+    RenderStats::draw(window, closeBtn);
     
     if (fontLoaded) {
         sf::Text closeText;
@@ -677,7 +430,7 @@ void EquipmentPanel::render(sf::RenderWindow& window) {
         closeText.setCharacterSize(14);
         closeText.setFillColor(sf::Color::White);
         closeText.setPosition(panelPosition.x + panelSize.x - 21, panelPosition.y + 7);
-        window.draw(closeText);
+        RenderStats::draw(window, closeText);
     }
     
     // 绘制角色轮廓（简化版）
@@ -690,14 +443,14 @@ void EquipmentPanel::render(sf::RenderWindow& window) {
     head.setOutlineThickness(2);
     head.setOutlineColor(sf::Color(100, 100, 110));
     head.setPosition(centerX - 25, centerY - 80);
-    window.draw(head);
+    RenderStats::draw(window, head);
     
     sf::RectangleShape body(sf::Vector2f(60, 80));
     body.setFillColor(sf::Color(80, 80, 90, 150));
     body.setOutlineThickness(2);
     body.setOutlineColor(sf::Color(100, 100, 110));
     body.setPosition(centerX - 30, centerY - 30);
-    window.draw(body);
+    RenderStats::draw(window, body);
     
     // 槽位尺寸
     sf::Vector2f slotSize(50, 50);
@@ -754,7 +507,7 @@ void EquipmentPanel::render(sf::RenderWindow& window) {
     
     // 显示总属性
     if (fontLoaded) {
-        EquipmentStats stats = equipment->getTotalStats();
+        const EquipmentStats& stats = equipment->getTotalStats();
         
         float statsX = panelPosition.x + 15;
         float statsY = panelPosition.y + panelSize.y - 80;
@@ -766,7 +519,7 @@ void EquipmentPanel::render(sf::RenderWindow& window) {
         statsTitle.setCharacterSize(14);
         statsTitle.setFillColor(sf::Color(200, 200, 200));
         statsTitle.setPosition(statsX, statsY);
-        window.draw(statsTitle);
+        RenderStats::draw(window, statsTitle);
         
         std::stringstream ss;
         ss << "ATK+" << stats.attack << "  DEF+" << stats.defense 
@@ -778,7 +531,7 @@ void EquipmentPanel::render(sf::RenderWindow& window) {
         statsText.setCharacterSize(12);
         statsText.setFillColor(sf::Color(150, 255, 150));
         statsText.setPosition(statsX, statsY + 20);
-        window.draw(statsText);
+        RenderStats::draw(window, statsText);
         
         if (stats.ignoreDefense) {
             std::string ignoreStr = "特效: 无视防御";
@@ -788,7 +541,7 @@ void EquipmentPanel::render(sf::RenderWindow& window) {
             ignoreText.setCharacterSize(12);
             ignoreText.setFillColor(sf::Color(255, 200, 100));
             ignoreText.setPosition(statsX, statsY + 40);
-            window.draw(ignoreText);
+            RenderStats::draw(window, ignoreText);
         }
     }
     
@@ -814,7 +567,7 @@ void EquipmentPanel::renderSlot(sf::RenderWindow& window, EquipmentSlot slot,
     
     slotBg.setOutlineThickness(2);
     slotBg.setOutlineColor(isHovered ? sf::Color::White : sf::Color(80, 80, 80));
-    window.draw(slotBg);
+    RenderStats::draw(window, slotBg);
     
     // 绘制槽位名称
     if (fontLoaded && !hasEquip) {
@@ -830,7 +583,7 @@ void EquipmentPanel::renderSlot(sf::RenderWindow& window, EquipmentSlot slot,
             pos.x + (size.x - bounds.width) / 2,
             pos.y + (size.y - bounds.height) / 2 - 2
         );
-        window.draw(nameText);
+        RenderStats::draw(window, nameText);
     }
     
     // TODO: 绘制装备图标
@@ -845,7 +598,7 @@ void EquipmentPanel::renderTooltip(sf::RenderWindow& window) {
     const EquipmentData* data = EquipmentManager::getInstance().getEquipmentData(equipId);
     if (!data) return;
     
-    sf::Vector2i mousePos = sf::Mouse::getPosition(window);
+    sf::Vector2i mousePos = InputSystem::getInstance().getMousePosition();
     float tooltipX = mousePos.x + 15.0f;
     float tooltipY = mousePos.y + 15.0f;
     
@@ -913,7 +666,7 @@ void EquipmentPanel::renderTooltip(sf::RenderWindow& window) {
     bg.setFillColor(sf::Color(20, 20, 30, 245));
     bg.setOutlineThickness(2);
     bg.setOutlineColor(ItemDatabase::getRarityColor(data->rarity));
-    window.draw(bg);
+    RenderStats::draw(window, bg);
     
     // 绘制文字
     float y = tooltipY + padding;
@@ -929,7 +682,7 @@ void EquipmentPanel::renderTooltip(sf::RenderWindow& window) {
         text.setCharacterSize(i == 0 ? 16 : 14);
         text.setFillColor(lines[i].second);
         text.setPosition(tooltipX + padding, y);
-        window.draw(text);
+        RenderStats::draw(window, text);
         
         y += lineHeight;
     }
@@ -985,12 +738,12 @@ void EquipmentPanel::open() {
     panelOpen = true;
     hoveredSlot = EquipmentSlot::Count;
     selectedSlot = EquipmentSlot::Count;
-    std::cout << "[EquipmentPanel] Opened" << std::endl;
+    LOG_INFO("[EquipmentPanel] Opened");
 }
 
 void EquipmentPanel::close() {
     panelOpen = false;
-    std::cout << "[EquipmentPanel] Closed" << std::endl;
+    LOG_INFO("[EquipmentPanel] Closed");
 }
 
 void EquipmentPanel::toggle() {
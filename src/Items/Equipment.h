@@ -149,8 +149,8 @@ class EquipmentManager {
 public:
     static EquipmentManager& getInstance();
     
-    // 初始化装备定义
-    void initialize();
+    // 初始化装备定义（由 ItemDefinitions 从数据文件加载）
+    void initialize(const std::vector<EquipmentData>& definitions);
     
     // 获取装备数据
     const EquipmentData* getEquipmentData(const std::string& equipId) const;
@@ -201,22 +201,36 @@ public:
     // 检查槽位是否有装备
     bool hasEquipment(EquipmentSlot slot) const;
     
-    // 获取总属性加成
-    EquipmentStats getTotalStats() const;
+    // 获取总属性加成（缓存，仅在穿脱装备后重新累加）
+    const EquipmentStats& getTotalStats() const;
     
     // 检查是否有无视防御效果
-    bool hasIgnoreDefense() const;
-    float getIgnoreDefenseRate() const;
+    bool hasIgnoreDefense() const { return getTotalStats().ignoreDefense; }
+    float getIgnoreDefenseRate() const { return getTotalStats().ignoreDefenseRate; }
     
     // 获取当前武器类型
     WeaponType getCurrentWeaponType() const;
     
+    // 存档：直接读写槽位（不触发回调，读档后由调用方刷新属性加成）
+    using EquippedArray = std::array<std::string, static_cast<size_t>(EquipmentSlot::Count)>;
+    const EquippedArray& getEquippedItems() const { return equippedItems; }
+    void restoreEquippedItems(const EquippedArray& items);
+    
     // 回调设置
     void setOnEquip(EquipCallback cb) { onEquip = cb; }
     void setOnUnequip(EquipCallback cb) { onUnequip = cb; }
 
 private:
-    std::array<std::string, static_cast<size_t>(EquipmentSlot::Count)> equippedItems;
+    void setSlot(size_t slotIndex, const std::string& equipId);
+    
+private:
+    EquippedArray equippedItems;
+    
+    // 每个槽位的装备数据（穿戴时查一次，EquipmentManager 的 map 节点地址稳定）
+    std::array<const EquipmentData*, static_cast<size_t>(EquipmentSlot::Count)> equippedData{};
+    mutable EquipmentStats totalStats;
+    mutable bool statsDirty = true;
+    
     EquipCallback onEquip;
     EquipCallback onUnequip;
 };
@@ -1,6 +1,6 @@
 #include "Inventory.h"
+#include "../Systems/Logger.h"
 #include <algorithm>
-#include <iostream>
 
 Inventory::Inventory() {
     // 所有格子初始化为空
@@ -14,11 +14,20 @@ Inventory::Inventory() {
 // ============================================================================
 
 int Inventory::addItem(const std::string& itemId, int count) {
-    if (itemId.empty() || count <= 0) return 0;
+    ItemId id = ItemDatabase::getInstance().getItemId(itemId);
+    if (id == INVALID_ITEM_ID) {
+        LOG_INFO("[Inventory] Unknown item: " << itemId);
+        return 0;
+    }
+    return addItem(id, count);
+}
+
+int Inventory::addItem(ItemId itemId, int count) {
+    if (itemId == INVALID_ITEM_ID || count <= 0) return 0;
     
     const ItemData* data = ItemDatabase::getInstance().getItemData(itemId);
     if (!data) {
-        std::cout << "[Inventory] Unknown item: " << itemId << std::endl;
+        LOG_INFO("[Inventory] Unknown item: " << itemId);
         return 0;
     }
     
@@ -56,12 +65,12 @@ int Inventory::addItem(const std::string& itemId, int count) {
     
     if (totalAdded > 0) {
         notifyInventoryChanged();
-        std::cout << "[Inventory] Added " << totalAdded << "x " << data->name << std::endl;
+        LOG_DEBUG("[Inventory] Added " << totalAdded << "x " << data->name);
     }
     
     if (remaining > 0) {
-        std::cout << "[Inventory] Could not add " << remaining << "x " << itemId 
-                  << " (inventory full)" << std::endl;
+        LOG_INFO("[Inventory] Could not add " << remaining << "x " << data->id 
+              << " (inventory full)");
     }
     
     return totalAdded;
@@ -72,7 +81,11 @@ int Inventory::addItemStack(const ItemStack& stack) {
 }
 
 int Inventory::removeItem(const std::string& itemId, int count) {
-    if (itemId.empty() || count <= 0) return 0;
+    return removeItem(ItemDatabase::getInstance().getItemId(itemId), count);
+}
+
+int Inventory::removeItem(ItemId itemId, int count) {
+    if (itemId == INVALID_ITEM_ID || count <= 0) return 0;
     
     int remaining = count;
     int totalRemoved = 0;
@@ -105,7 +118,7 @@ int Inventory::removeItemFromSlot(int slotIndex, int count) {
     if (slots[slotIndex].isEmpty()) return 0;
     
     int toRemove = (count <= 0) ? slots[slotIndex].count : std::min(count, slots[slotIndex].count);
-    std::string itemId = slots[slotIndex].itemId;
+    ItemId itemId = slots[slotIndex].itemId;
     
     slots[slotIndex].count -= toRemove;
     
@@ -128,7 +141,7 @@ bool Inventory::useItem(int slotIndex) {
     
     // 只有消耗品可以使用
     if (data->type != ItemType::Consumable) {
-        std::cout << "[Inventory] Cannot use non-consumable item: " << data->name << std::endl;
+        LOG_INFO("[Inventory] Cannot use non-consumable item: " << data->name);
         return false;
     }
     
@@ -151,7 +164,7 @@ bool Inventory::useItem(int slotIndex) {
     notifyItemUsed(usedItem, slotIndex);
     notifyInventoryChanged();
     
-    std::cout << "[Inventory] Used: " << data->name << std::endl;
+    LOG_INFO("[Inventory] Used: " << data->name);
     return true;
 }
 
@@ -163,7 +176,7 @@ ItemStack Inventory::dropItem(int slotIndex, int count) {
     
     // 任务物品不可丢弃
     if (data && data->type == ItemType::Quest) {
-        std::cout << "[Inventory] Cannot drop quest item: " << data->name << std::endl;
+        LOG_INFO("[Inventory] Cannot drop quest item: " << data->name);
         return ItemStack();
     }
     
@@ -180,7 +193,7 @@ ItemStack Inventory::dropItem(int slotIndex, int count) {
     notifyInventoryChanged();
     
     if (data) {
-        std::cout << "[Inventory] Dropped " << toDrop << "x " << data->name << std::endl;
+        LOG_INFO("[Inventory] Dropped " << toDrop << "x " << data->name);
     }
     
     return dropped;
@@ -225,7 +238,7 @@ void Inventory::sortInventory() {
     }
     
     notifyInventoryChanged();
-    std::cout << "[Inventory] Sorted and organized" << std::endl;
+    LOG_INFO("[Inventory] Sorted and organized");
 }
 
 // ============================================================================
@@ -244,11 +257,21 @@ ItemStack& Inventory::getSlot(int index) {
     return slots[index];
 }
 
+bool Inventory::hasItem(ItemId itemId, int count) const {
+    return getItemCount(itemId) >= count;
+}
+
 bool Inventory::hasItem(const std::string& itemId, int count) const {
     return getItemCount(itemId) >= count;
 }
 
 int Inventory::getItemCount(const std::string& itemId) const {
+    return getItemCount(ItemDatabase::getInstance().getItemId(itemId));
+}
+
+int Inventory::getItemCount(ItemId itemId) const {
+    if (itemId == INVALID_ITEM_ID) return 0;
+    
     int total = 0;
     for (const auto& slot : slots) {
         if (slot.itemId == itemId) {
@@ -278,7 +301,7 @@ int Inventory::getTotalPages() const {
 // 私有方法
 // ============================================================================
 
-int Inventory::findStackableSlot(const std::string& itemId) const {
+int Inventory::findStackableSlot(ItemId itemId) const {
     const ItemData* data = ItemDatabase::getInstance().getItemData(itemId);
     if (!data) return -1;
     
@@ -55,6 +55,7 @@ public:
     
     // 添加物品到背包（自动堆叠和寻找空位）
     // 返回实际添加的数量
+    int addItem(ItemId itemId, int count = 1);
     int addItem(const std::string& itemId, int count = 1);
     
     // 添加ItemStack到背包
@@ -62,6 +63,7 @@ public:
     
     // 从背包移除指定数量的物品
     // 返回实际移除的数量
+    int removeItem(ItemId itemId, int count = 1);
     int removeItem(const std::string& itemId, int count = 1);
     
     // 从指定格子移除物品
@@ -90,9 +92,11 @@ public:
     ItemStack& getSlot(int index);
     
     // 检查是否拥有指定物品
+    bool hasItem(ItemId itemId, int count = 1) const;
     bool hasItem(const std::string& itemId, int count = 1) const;
     
     // 获取指定物品的总数量
+    int getItemCount(ItemId itemId) const;
     int getItemCount(const std::string& itemId) const;
     
     // 获取空格子数量
@@ -122,7 +126,7 @@ public:
 
 private:
     // 查找可以堆叠的格子
-    int findStackableSlot(const std::string& itemId) const;
+    int findStackableSlot(ItemId itemId) const;
     
     // 查找空格子
     int findEmptySlot() const;
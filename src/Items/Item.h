@@ -2,8 +2,9 @@
 #include <SFML/Graphics.hpp>
 #include <string>
 #include <vector>
-#include <map>
+#include <unordered_map>
 #include <memory>
+#include <cstdint>
 
 // ============================================================================
 // 物品系统 (Item System)
@@ -19,7 +20,8 @@
 //   - Misc:        杂物
 //
 // 【物品属性】
-//   - id:          唯一标识符（如 "wood", "apple"）
+//   - id:          唯一标识符（如 "wood", "apple"），仅在加载/存档/显示时使用
+//   - numericId:   注册时分配的紧凑整数ID（ItemId），运行时一律用它比较和查表
 //   - name:        显示名称（如 "木材", "苹果"）
 //   - type:        物品类型
 //   - maxStack:    最大堆叠数量（材料通常99，消耗品通常20）
@@ -81,12 +83,20 @@ struct ConsumableEffect {
         : type(t), value(v), duration(d) {}
 };
 
+// ============================================================================
+// 物品ID（注册时由字符串ID驻留得到的紧凑整数，0 表示空）
+// ============================================================================
+
+using ItemId = std::uint16_t;
+constexpr ItemId INVALID_ITEM_ID = 0;
+
 // ============================================================================
 // 物品数据定义（静态数据，定义物品的基本属性）
 // ============================================================================
 
 struct ItemData {
-    std::string id;             // 唯一ID
+    std::string id;             // 唯一ID（字符串）
+    ItemId numericId;           // 整数ID（注册时分配）
     std::string name;           // 显示名称
     std::string description;    // 物品描述
     ItemType type;              // 物品类型
@@ -100,7 +110,8 @@ struct ItemData {
     std::vector<ConsumableEffect> effects;
     
     ItemData() 
-        : type(ItemType::Misc)
+        : numericId(INVALID_ITEM_ID)
+        , type(ItemType::Misc)
         , rarity(ItemRarity::Common)
         , maxStack(99)
         , sellPrice(1)
@@ -112,14 +123,20 @@ struct ItemData {
 // ============================================================================
 
 struct ItemStack {
-    std::string itemId;         // 物品ID
+    ItemId itemId;              // 物品ID
     int count;                  // 数量
     
-    ItemStack() : count(0) {}
-    ItemStack(const std::string& id, int c) : itemId(id), count(c) {}
+    ItemStack() : itemId(INVALID_ITEM_ID), count(0) {}
+    ItemStack(ItemId id, int c) : itemId(id), count(c) {}
+    
+    // 由字符串ID构造（需要查表，仅用于加载/配置）
+    ItemStack(const std::string& id, int c);
+    
+    bool isEmpty() const { return itemId == INVALID_ITEM_ID || count <= 0; }
+    void clear() { itemId = INVALID_ITEM_ID; count = 0; }
     
-    bool isEmpty() const { return itemId.empty() || count <= 0; }
-    void clear() { itemId.clear(); count = 0; }
+    // 字符串ID（用于日志/存档）
+    const std::string& getStringId() const;
 };
 
 // ============================================================================
@@ -130,20 +147,35 @@ class ItemDatabase {
 public:
     static ItemDatabase& getInstance();
     
-    // 初始化所有物品定义
-    void initialize();
+    // 初始化所有物品定义（由 ItemDefinitions 从数据文件加载）
+    void initialize(const std::vector<ItemData>& definitions);
     
     // 加载物品贴图
     bool loadTextures(const std::string& basePath);
     
-    // 获取物品数据
-    const ItemData* getItemData(const std::string& itemId) const;
+    // 获取物品数据（按下标直接取，运行时使用）
+    const ItemData* getItemData(ItemId itemId) const {
+        return (itemId != INVALID_ITEM_ID && itemId < items.size()) ? &items[itemId] : nullptr;
+    }
     
     // 获取物品贴图
+    const sf::Texture* getTexture(ItemId itemId) const {
+        return (itemId < textureLoaded.size() && textureLoaded[itemId]) ? &textures[itemId] : nullptr;
+    }
+    
+    // 字符串ID版本（需要查哈希表，仅用于加载/配置）
+    const ItemData* getItemData(const std::string& itemId) const;
     const sf::Texture* getTexture(const std::string& itemId) const;
     
-    // 注册新物品
-    void registerItem(const ItemData& data);
+    // 字符串ID <-> 整数ID
+    ItemId getItemId(const std::string& itemId) const;
+    const std::string& getStringId(ItemId itemId) const;
+    
+    // 已注册物品数量
+    size_t getItemCount() const { return items.size() - 1; }
+    
+    // 注册新物品（返回分配的整数ID；重复注册同一字符串ID会覆盖数据并沿用原ID）
+    ItemId registerItem(const ItemData& data);
     
     // 获取稀有度对应的颜色
     static sf::Color getRarityColor(ItemRarity rarity);
@@ -152,12 +184,17 @@ public:
     static std::string getTypeName(ItemType type);
 
 private:
-    ItemDatabase() = default;
+    ItemDatabase();
     ItemDatabase(const ItemDatabase&) = delete;
     ItemDatabase& operator=(const ItemDatabase&) = delete;
     
-    std::map<std::string, ItemData> items;
-    std::map<std::string, sf::Texture> textures;
+    // 平铺表：下标即 ItemId，0 号为空占位
+    std::vector<ItemData> items;
+    std::vector<sf::Texture> textures;
+    std::vector<std::uint8_t> textureLoaded;
+    
+    // 字符串ID -> 整数ID（只在注册和加载时查询）
+    std::unordered_map<std::string, ItemId> idLookup;
     bool initialized = false;
 };
 
@@ -166,6 +203,7 @@ private:
 // ============================================================================
 
 // 创建物品堆叠
+ItemStack createItemStack(ItemId itemId, int count = 1);
 ItemStack createItemStack(const std::string& itemId, int count = 1);
 
 // 检查物品是否可以堆叠
@@ -0,0 +1,538 @@
+#include "ItemDefinitions.h"
+#include "../Systems/BinaryStream.h"
+#include "../Systems/Json.h"
+#include "../Systems/Logger.h"
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <set>
+
+namespace {
+
+const char BLOB_MAGIC[4] = { 'P', 'F', 'D', 'F' };
+
+const char* const SOURCE_FILES[] = { "items.json", "equipment.json", "recipes.json" };
+
+constexpr std::uint32_t TAG_ITEMS      = makeTag('I', 'T', 'E', 'M');
+constexpr std::uint32_t TAG_EQUIPMENTS = makeTag('E', 'Q', 'U', 'P');
+constexpr std::uint32_t TAG_RECIPES    = makeTag('R', 'C', 'P', 'E');
+
+// ============================================================================
+// 枚举名称（顺序必须与枚举定义一致）
+// ============================================================================
+
+const char* const ITEM_TYPE_NAMES[] = {
+    "Material", "Consumable", "Equipment", "Quest", "Misc"
+};
+
+const char* const RARITY_NAMES[] = {
+    "Common", "Uncommon", "Rare", "Epic", "Legendary"
+};
+
+const char* const EFFECT_TYPE_NAMES[] = {
+    "None", "RestoreHealth", "RestoreStamina", "RestoreMana",
+    "BuffAttack", "BuffDefense", "BuffSpeed", "BuffExp"
+};
+
+const char* const SLOT_NAMES[] = {
+    "Weapon", "SecondHand", "Helmet", "Armor", "Pants", "Gloves", "Boots",
+    "Cape", "Necklace", "Ring1", "Ring2", "Earring", "Belt", "Shoulder"
+};
+
+const char* const WEAPON_TYPE_NAMES[] = {
+    "None", "Sword", "TwoHandSword", "Axe", "TwoHandAxe",
+    "Mace", "TwoHandMace", "Spear", "Polearm"
+};
+
+// 字段缺失时保留默认值；写了但不认识则报错
+template <typename E, size_t N>
+bool parseEnum(const JsonValue& obj, const std::string& key, const char* const (&names)[N],
+               E& out, const std::string& owner, std::string& error) {
+    const JsonValue& v = obj[key];
+    if (v.isNull()) return true;
+
+    for (size_t i = 0; i < N; i++) {
+        if (v.asString() == names[i]) {
+            out = static_cast<E>(i);
+            return true;
+        }
+    }
+    error = owner + ": 未知的 " + key + " \"" + v.asString() + "\"";
+    return false;
+}
+
+template <typename E, size_t N>
+bool enumInRange(E value, const char* const (&)[N]) {
+    return static_cast<size_t>(value) < N;
+}
+
+// ============================================================================
+// JSON -> 定义
+// ============================================================================
+
+bool parseItem(const JsonValue& obj, ItemData& item, std::string& error) {
+    item.id = obj.getString("id");
+    if (item.id.empty()) {
+        error = "物品缺少 id";
+        return false;
+    }
+
+    item.name = obj.getString("name", item.id);
+    item.description = obj.getString("description");
+    item.maxStack = obj.getInt("maxStack", item.maxStack);
+    item.sellPrice = obj.getInt("sellPrice", item.sellPrice);
+    item.buyPrice = obj.getInt("buyPrice", item.buyPrice);
+    item.texturePath = obj.getString("texturePath");
+
+    if (!parseEnum(obj, "type", ITEM_TYPE_NAMES, item.type, item.id, error) ||
+        !parseEnum(obj, "rarity", RARITY_NAMES, item.rarity, item.id, error)) {
+        return false;
+    }
+
+    for (const auto& e : obj["effects"].asArray()) {
+        ConsumableEffect effect;
+        if (!parseEnum(e, "type", EFFECT_TYPE_NAMES, effect.type, item.id, error)) return false;
+        effect.value = e.getFloat("value");
+        effect.duration = e.getFloat("duration");
+        item.effects.push_back(effect);
+    }
+    return true;
+}
+
+bool parseEquipment(const JsonValue& obj, EquipmentData& equip, std::string& error) {
+    equip.id = obj.getString("id");
+    if (equip.id.empty()) {
+        error = "装备缺少 id";
+        return false;
+    }
+
+    equip.name = obj.getString("name", equip.id);
+    equip.description = obj.getString("description");
+    equip.requiredLevel = obj.getInt("requiredLevel");
+    equip.requiredStrength = obj.getInt("requiredStrength");
+    equip.requiredDexterity = obj.getInt("requiredDexterity");
+    equip.texturePath = obj.getString("texturePath");
+
+    if (!parseEnum(obj, "slot", SLOT_NAMES, equip.slot, equip.id, error) ||
+        !parseEnum(obj, "weaponType", WEAPON_TYPE_NAMES, equip.weaponType, equip.id, error) ||
+        !parseEnum(obj, "rarity", RARITY_NAMES, equip.rarity, equip.id, error)) {
+        return false;
+    }
+
+    const JsonValue& s = obj["stats"];
+    EquipmentStats& stats = equip.stats;
+    stats.attack = s.getInt("attack");
+    stats.defense = s.getInt("defense");
+    stats.strength = s.getInt("strength");
+    stats.dexterity = s.getInt("dexterity");
+    stats.intelligence = s.getInt("intelligence");
+    stats.luck = s.getInt("luck");
+    stats.hp = s.getInt("hp");
+    stats.mp = s.getInt("mp");
+    stats.speed = s.getFloat("speed");
+    stats.jump = s.getFloat("jump");
+    stats.ignoreDefense = s.getBool("ignoreDefense");
+    stats.ignoreDefenseRate = s.getFloat("ignoreDefenseRate");
+    stats.critRate = s.getFloat("critRate");
+    stats.critDamage = s.getFloat("critDamage");
+    return true;
+}
+
+bool parseRecipe(const JsonValue& obj, CraftingRecipe& recipe, std::string& error) {
+    recipe.id = obj.getString("id");
+    if (recipe.id.empty()) {
+        error = "配方缺少 id";
+        return false;
+    }
+
+    recipe.name = obj.getString("name", recipe.id);
+    recipe.description = obj.getString("description");
+    recipe.resultItemId = obj.getString("result");
+    recipe.resultCount = obj.getInt("resultCount", 1);
+    recipe.isEquipment = obj.getBool("isEquipment");
+
+    for (const auto& ing : obj["ingredients"].asArray()) {
+        recipe.ingredients.push_back(RecipeIngredient(ing.getString("item"), ing.getInt("count", 1)));
+    }
+    return true;
+}
+
+// 读取一个定义文件中的数组并逐条解析
+template <typename T, typename ParseFn>
+bool parseFile(const std::string& path, const std::string& key, std::vector<T>& out,
+               ParseFn parse, std::string& error) {
+    JsonValue root;
+    if (!JsonValue::parseFile(path, root, error)) return false;
+
+    for (const auto& entry : root[key].asArray()) {
+        T def;
+        if (!parse(entry, def, error)) {
+            error = path + ": " + error;
+            return false;
+        }
+        out.push_back(std::move(def));
+    }
+    return true;
+}
+
+// ============================================================================
+// 定义 <-> 二进制
+// ============================================================================
+
+void writeItem(BinaryWriter& w, const ItemData& item) {
+    w.str(item.id);
+    w.str(item.name);
+    w.str(item.description);
+    w.pod(static_cast<std::uint8_t>(item.type));
+    w.pod(static_cast<std::uint8_t>(item.rarity));
+    w.pod(static_cast<std::int32_t>(item.maxStack));
+    w.pod(static_cast<std::int32_t>(item.sellPrice));
+    w.pod(static_cast<std::int32_t>(item.buyPrice));
+    w.str(item.texturePath);
+    w.pod(static_cast<std::uint8_t>(item.effects.size()));
+    for (const auto& e : item.effects) {
+        w.pod(static_cast<std::uint8_t>(e.type));
+        w.pod(e.value);
+        w.pod(e.duration);
+    }
+}
+
+bool readItem(BinaryReader& r, ItemData& item) {
+    std::uint8_t type = 0, rarity = 0, effectCount = 0;
+    std::int32_t maxStack = 0, sellPrice = 0, buyPrice = 0;
+    if (!r.str(item.id) || !r.str(item.name) || !r.str(item.description) ||
+        !r.pod(type) || !r.pod(rarity) ||
+        !r.pod(maxStack) || !r.pod(sellPrice) || !r.pod(buyPrice) ||
+        !r.str(item.texturePath) || !r.pod(effectCount)) {
+        return false;
+    }
+
+    item.type = static_cast<ItemType>(type);
+    item.rarity = static_cast<ItemRarity>(rarity);
+    item.maxStack = maxStack;
+    item.sellPrice = sellPrice;
+    item.buyPrice = buyPrice;
+    if (!enumInRange(item.type, ITEM_TYPE_NAMES) || !enumInRange(item.rarity, RARITY_NAMES)) return false;
+
+    item.effects.resize(effectCount);
+    for (auto& e : item.effects) {
+        std::uint8_t effectType = 0;
+        if (!r.pod(effectType) || !r.pod(e.value) || !r.pod(e.duration)) return false;
+        e.type = static_cast<EffectType>(effectType);
+        if (!enumInRange(e.type, EFFECT_TYPE_NAMES)) return false;
+    }
+    return true;
+}
+
+void writeEquipment(BinaryWriter& w, const EquipmentData& equip) {
+    w.str(equip.id);
+    w.str(equip.name);
+    w.str(equip.description);
+    w.pod(static_cast<std::uint8_t>(equip.slot));
+    w.pod(static_cast<std::uint8_t>(equip.weaponType));
+    w.pod(static_cast<std::uint8_t>(equip.rarity));
+    w.pod(static_cast<std::int32_t>(equip.requiredLevel));
+    w.pod(static_cast<std::int32_t>(equip.requiredStrength));
+    w.pod(static_cast<std::int32_t>(equip.requiredDexterity));
+    w.str(equip.texturePath);
+
+    const EquipmentStats& s = equip.stats;
+    for (int v : { s.attack, s.defense, s.strength, s.dexterity, s.intelligence, s.luck, s.hp, s.mp }) {
+        w.pod(static_cast<std::int32_t>(v));
+    }
+    w.pod(s.speed);
+    w.pod(s.jump);
+    w.pod(static_cast<std::uint8_t>(s.ignoreDefense ? 1 : 0));
+    w.pod(s.ignoreDefenseRate);
+    w.pod(s.critRate);
+    w.pod(s.critDamage);
+}
+
+bool readEquipment(BinaryReader& r, EquipmentData& equip) {
+    std::uint8_t slot = 0, weaponType = 0, rarity = 0, ignoreDefense = 0;
+    std::int32_t level = 0, strength = 0, dexterity = 0;
+    if (!r.str(equip.id) || !r.str(equip.name) || !r.str(equip.description) ||
+        !r.pod(slot) || !r.pod(weaponType) || !r.pod(rarity) ||
+        !r.pod(level) || !r.pod(strength) || !r.pod(dexterity) ||
+        !r.str(equip.texturePath)) {
+        return false;
+    }
+
+    equip.slot = static_cast<EquipmentSlot>(slot);
+    equip.weaponType = static_cast<WeaponType>(weaponType);
+    equip.rarity = static_cast<ItemRarity>(rarity);
+    equip.requiredLevel = level;
+    equip.requiredStrength = strength;
+    equip.requiredDexterity = dexterity;
+    if (!enumInRange(equip.slot, SLOT_NAMES) || !enumInRange(equip.weaponType, WEAPON_TYPE_NAMES) ||
+        !enumInRange(equip.rarity, RARITY_NAMES)) {
+        return false;
+    }
+
+    EquipmentStats& s = equip.stats;
+    for (int* v : { &s.attack, &s.defense, &s.strength, &s.dexterity, &s.intelligence, &s.luck, &s.hp, &s.mp }) {
+        std::int32_t value = 0;
+        if (!r.pod(value)) return false;
+        *v = value;
+    }
+    if (!r.pod(s.speed) || !r.pod(s.jump) || !r.pod(ignoreDefense) ||
+        !r.pod(s.ignoreDefenseRate) || !r.pod(s.critRate) || !r.pod(s.critDamage)) {
+        return false;
+    }
+    s.ignoreDefense = ignoreDefense != 0;
+    return true;
+}
+
+void writeRecipe(BinaryWriter& w, const CraftingRecipe& recipe) {
+    w.str(recipe.id);
+    w.str(recipe.name);
+    w.str(recipe.description);
+    w.str(recipe.resultItemId);
+    w.pod(static_cast<std::int32_t>(recipe.resultCount));
+    w.pod(static_cast<std::uint8_t>(recipe.isEquipment ? 1 : 0));
+    w.pod(static_cast<std::uint8_t>(recipe.ingredients.size()));
+    for (const auto& ing : recipe.ingredients) {
+        w.str(ing.itemId);
+        w.pod(static_cast<std::int32_t>(ing.count));
+    }
+}
+
+bool readRecipe(BinaryReader& r, CraftingRecipe& recipe) {
+    std::int32_t resultCount = 0;
+    std::uint8_t isEquipment = 0, ingredientCount = 0;
+    if (!r.str(recipe.id) || !r.str(recipe.name) || !r.str(recipe.description) ||
+        !r.str(recipe.resultItemId) || !r.pod(resultCount) ||
+        !r.pod(isEquipment) || !r.pod(ingredientCount)) {
+        return false;
+    }
+
+    recipe.resultCount = resultCount;
+    recipe.isEquipment = isEquipment != 0;
+    recipe.ingredients.resize(ingredientCount);
+    for (auto& ing : recipe.ingredients) {
+        std::int32_t count = 0;
+        if (!r.str(ing.itemId) || !r.pod(count)) return false;
+        ing.count = count;
+    }
+    return true;
+}
+
+template <typename T, typename WriteFn>
+void writeSection(BinaryWriter& w, std::uint32_t tag, const std::vector<T>& defs, WriteFn write) {
+    std::size_t section = w.beginSection(tag);
+    w.pod(static_cast<std::uint16_t>(defs.size()));
+    for (const auto& def : defs) {
+        write(w, def);
+    }
+    w.endSection(section);
+}
+
+template <typename T, typename ReadFn>
+bool readSection(BinaryReader& r, std::vector<T>& out, ReadFn read) {
+    std::uint16_t count = 0;
+    if (!r.pod(count)) return false;
+    out.resize(count);
+    for (auto& def : out) {
+        if (!read(r, def)) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+// ============================================================================
+// 启动加载
+// ============================================================================
+
+bool ItemDefinitions::load(ItemDefinitionSet& out) {
+    // 与物品贴图相同的查找顺序（工作目录 / 构建输出目录）
+    const std::vector<std::string> dataDirs = { "assets/data", "../../assets/data" };
+
+    for (const auto& dir : dataDirs) {
+        const std::string blobPath = dir + "/defs.bin";
+        if (loadBlob(blobPath, out) != DefLoadStatus::Ok) continue;
+
+        // 同目录的 JSON 在烘焙后被修改过：改用 JSON，避免静默使用旧数据
+        if (!sourcesNewerThan(dir, blobPath)) {
+            LOG_INFO("[ItemDefinitions] Loaded " << dir << "/defs.bin");
+            return true;
+        }
+
+        LOG_WARN("[ItemDefinitions] " << dir << "/defs.bin is out of date with the JSON sources, "
+                 << "parsing JSON instead (re-run DefBaker to refresh it)");
+        ItemDefinitionSet fresh;
+        std::string error;
+        if (loadJson(dir, fresh, error) == DefLoadStatus::Ok) {
+            out = std::move(fresh);
+        } else {
+            LOG_WARN("[ItemDefinitions] " << error << ", keeping defs.bin");
+        }
+        return true;
+    }
+
+    for (const auto& dir : dataDirs) {
+        std::string error;
+        DefLoadStatus status = loadJson(dir, out, error);
+        if (status == DefLoadStatus::Ok) {
+            LOG_INFO("[ItemDefinitions] defs.bin unavailable, parsed JSON from " << dir);
+            return true;
+        }
+        if (status != DefLoadStatus::Missing) {
+            // 文件存在但内容有误，不再尝试其他目录
+            LOG_ERROR("[ItemDefinitions] " << error);
+            return false;
+        }
+    }
+
+    LOG_ERROR("[ItemDefinitions] No item definitions found");
+    return false;
+}
+
+// ============================================================================
+// JSON
+// ============================================================================
+
+DefLoadStatus ItemDefinitions::loadJson(const std::string& dataDir, ItemDefinitionSet& out, std::string& error) {
+    for (const char* name : SOURCE_FILES) {
+        std::ifstream file(dataDir + "/" + name);
+        if (!file.is_open()) {
+            error = "无法打开文件: " + dataDir + "/" + name;
+            return DefLoadStatus::Missing;
+        }
+    }
+
+    ItemDefinitionSet defs;
+    if (!parseFile(dataDir + "/items.json", "items", defs.items, parseItem, error) ||
+        !parseFile(dataDir + "/equipment.json", "equipment", defs.equipments, parseEquipment, error) ||
+        !parseFile(dataDir + "/recipes.json", "recipes", defs.recipes, parseRecipe, error)) {
+        return DefLoadStatus::Corrupt;
+    }
+
+    out = std::move(defs);
+    return DefLoadStatus::Ok;
+}
+
+bool ItemDefinitions::sourcesNewerThan(const std::string& dataDir, const std::string& blobPath) {
+    std::error_code ec;
+    const auto blobTime = std::filesystem::last_write_time(blobPath, ec);
+    if (ec) return false;
+
+    for (const char* name : SOURCE_FILES) {
+        const auto sourceTime = std::filesystem::last_write_time(dataDir + "/" + name, ec);
+        if (!ec && sourceTime > blobTime) return true;
+    }
+    return false;
+}
+
+// ============================================================================
+// 二进制定义表
+// ============================================================================
+
+DefLoadStatus ItemDefinitions::loadBlob(const std::string& path, ItemDefinitionSet& out) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) return DefLoadStatus::Missing;
+
+    // 一次性读入内存再解码
+    std::vector<std::uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    BinaryReader r(data.data(), data.size());
+    char magic[4] = {};
+    std::uint32_t version = 0;
+    bool headerOk = true;
+    for (char& c : magic) {
+        headerOk = headerOk && r.pod(c);
+    }
+    if (!headerOk || std::string(magic, 4) != std::string(BLOB_MAGIC, 4) || !r.pod(version)) {
+        LOG_WARN("[ItemDefinitions] Invalid definition table: " << path);
+        return DefLoadStatus::Corrupt;
+    }
+    if (version != BLOB_VERSION) {
+        LOG_WARN("[ItemDefinitions] Definition table version " << version
+                 << " != " << BLOB_VERSION << ", ignoring " << path);
+        return DefLoadStatus::VersionMismatch;
+    }
+
+    ItemDefinitionSet defs;
+    while (!r.atEnd()) {
+        std::uint32_t tag = 0, length = 0;
+        if (!r.pod(tag) || !r.pod(length)) {
+            LOG_WARN("[ItemDefinitions] Corrupted definition table: " << path);
+            return DefLoadStatus::Corrupt;
+        }
+
+        BinaryReader section(r.current(), length);
+        bool ok = true;
+        if (tag == TAG_ITEMS) ok = readSection(section, defs.items, readItem);
+        else if (tag == TAG_EQUIPMENTS) ok = readSection(section, defs.equipments, readEquipment);
+        else if (tag == TAG_RECIPES) ok = readSection(section, defs.recipes, readRecipe);
+
+        if (!ok || !r.skip(length)) {
+            LOG_WARN("[ItemDefinitions] Corrupted definition table: " << path);
+            return DefLoadStatus::Corrupt;
+        }
+    }
+
+    out = std::move(defs);
+    return DefLoadStatus::Ok;
+}
+
+bool ItemDefinitions::writeBlob(const std::string& path, const ItemDefinitionSet& defs) {
+    std::vector<std::uint8_t> data;
+    BinaryWriter w(data);
+
+    for (char c : BLOB_MAGIC) w.pod(c);
+    w.pod(BLOB_VERSION);
+    writeSection(w, TAG_ITEMS, defs.items, writeItem);
+    writeSection(w, TAG_EQUIPMENTS, defs.equipments, writeEquipment);
+    writeSection(w, TAG_RECIPES, defs.recipes, writeRecipe);
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) return false;
+    file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    return static_cast<bool>(file);
+}
+
+// ============================================================================
+// 校验
+// ============================================================================
+
+std::vector<std::string> ItemDefinitions::validate(const ItemDefinitionSet& defs) {
+    std::vector<std::string> problems;
+    std::set<std::string> itemIds;
+
+    for (const auto& item : defs.items) {
+        if (!itemIds.insert(item.id).second) {
+            problems.push_back("重复的物品 id: " + item.id);
+        }
+        if (item.maxStack <= 0) {
+            problems.push_back(item.id + ": maxStack 必须大于 0");
+        }
+    }
+
+    std::set<std::string> equipIds;
+    for (const auto& equip : defs.equipments) {
+        if (!equipIds.insert(equip.id).second) {
+            problems.push_back("重复的装备 id: " + equip.id);
+        }
+        if (!itemIds.count(equip.id)) {
+            problems.push_back("装备 " + equip.id + " 没有对应的物品定义");
+        }
+    }
+
+    std::set<std::string> recipeIds;
+    for (const auto& recipe : defs.recipes) {
+        if (!recipeIds.insert(recipe.id).second) {
+            problems.push_back("重复的配方 id: " + recipe.id);
+        }
+        if (!itemIds.count(recipe.resultItemId)) {
+            problems.push_back("配方 " + recipe.id + " 的产物未定义: " + recipe.resultItemId);
+        }
+        for (const auto& ing : recipe.ingredients) {
+            if (!itemIds.count(ing.itemId)) {
+                problems.push_back("配方 " + recipe.id + " 的材料未定义: " + ing.itemId);
+            }
+        }
+    }
+
+    return problems;
+}
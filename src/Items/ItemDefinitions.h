@@ -0,0 +1,60 @@
+#pragma once
+#include "Item.h"
+#include "Equipment.h"
+#include "Crafting.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// 物品定义表 (Item Definitions)
+//
+// 物品/装备/配方的定义不再写在 C++ 里，而是：
+//   1. 源文件 - assets/data/items.json, equipment.json, recipes.json（策划编辑）
+//   2. 定义表 - 构建时由 DefBaker 烘焙为 assets/data/defs.bin（版本化二进制）
+//   3. 启动   - 游戏一次性读入 defs.bin 并直接解码，不再解析 JSON
+//
+// 找不到 defs.bin（或版本不符、已损坏）时回退为直接解析 JSON。
+// 构建时 JSON 改动会触发重新烘焙；同目录下的 JSON 比 defs.bin 新（烘焙后被直接
+// 修改过）时，启动会警告并改用 JSON。这里只比较文件修改时间，不读取 JSON 内容，
+// 因此修改 JSON 后不需要重新编译游戏，也不会读到旧数据。
+//
+// 文件格式：
+//   "PFDF" | uint32 版本 | 分段(ITEM / EQUP / RCPE)
+//   分段：  uint32 标签 | uint32 长度 | uint16 条目数 | 条目...
+// ============================================================================
+
+// 读取定义文件的结果（回退逻辑按状态判断，不匹配错误文本）
+enum class DefLoadStatus {
+    Ok,
+    Missing,            // 文件不存在
+    Corrupt,            // 存在但内容有误
+    VersionMismatch     // defs.bin 格式版本不符
+};
+
+struct ItemDefinitionSet {
+    std::vector<ItemData> items;
+    std::vector<EquipmentData> equipments;
+    std::vector<CraftingRecipe> recipes;
+};
+
+class ItemDefinitions {
+public:
+    static constexpr std::uint32_t BLOB_VERSION = 3;   // v3: 去掉源文件哈希，改为比较修改时间
+
+    // 游戏启动时调用：依次尝试各资源目录，优先读取 defs.bin，失败则解析 JSON
+    static bool load(ItemDefinitionSet& out);
+
+    // 解析 JSON 源文件（dataDir 下的 items/equipment/recipes.json）
+    static DefLoadStatus loadJson(const std::string& dataDir, ItemDefinitionSet& out, std::string& error);
+
+    // dataDir 下是否有 JSON 源文件比 blobPath 新（只取文件修改时间；缺失的文件不算）
+    static bool sourcesNewerThan(const std::string& dataDir, const std::string& blobPath);
+
+    // 读取/写入二进制定义表
+    static DefLoadStatus loadBlob(const std::string& path, ItemDefinitionSet& out);
+    static bool writeBlob(const std::string& path, const ItemDefinitionSet& defs);
+
+    // 检查交叉引用（配方材料/产物、装备是否都是已定义的物品），返回问题列表
+    static std::vector<std::string> validate(const ItemDefinitionSet& defs);
+};
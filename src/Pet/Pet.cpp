@@ -1,12 +1,15 @@
 #include "Pet.h"
+#include "../Systems/Logger.h"
+#include "../Systems/RenderStats.h"
+#include "../World/FlowField.h"
 #include <algorithm>
-#include <iostream>
 
 // ============================================================================
 // 构造函数
 // ============================================================================
-Pet::Pet()
-    : name("宠物")
+Pet::Pet(const PetSpecies& species_)
+    : species(&species_)
+    , name(species_.defaultName)
     , quality(PetQuality::Mediocre)
     , level(1)
     , exp(0)
@@ -19,7 +22,7 @@ Pet::Pet()
     , dodge(0)
     , lastTriggeredSkillIndex(-1)
     , position(0, 0)
-    , size(32, 32)
+    , size(species_.size)
     , velocity(0, 0)
     , targetOffset(-40, 0)
     , followDistance(DEFAULT_FOLLOW_DISTANCE)
@@ -30,8 +33,8 @@ Pet::Pet()
     , attackCooldown(0)
     , lastAttackTime(0)
     , hasAttackedThisCycle(false)
+    , rng(RandomService::getInstance().makeEntityStream(RngStream::Pet))
 {
-    rng.seed(std::random_device{}());
 }
 
 // ============================================================================
@@ -40,28 +43,27 @@ Pet::Pet()
 void Pet::init(float x, float y) {
     position = sf::Vector2f(x, y);
     sprite.setPosition(position);
+    currentFrame = 0;
+    animTimer = 0;
 }
 
 bool Pet::loadTexture(const std::string& texturePath) {
     if (!texture.loadFromFile(texturePath)) {
-        std::cerr << "Pet: 无法加载贴图 " << texturePath << std::endl;
+        LOG_ERROR("Pet: 无法加载贴图 " << texturePath);
         texture.create(32, 32);
         textureLoaded = false;
         return false;
     }
     sprite.setTexture(texture);
     textureLoaded = true;
+    
+    // 设置初始帧
+    const SpriteSheetLayout& sheet = species->sheet;
+    sprite.setTextureRect(sheet.frameRect(sheet.moveRow, 0));
+    sprite.setScale(sheet.scale, sheet.scale);
     return true;
 }
 
-void Pet::setHatchConfig(PetQuality q, const HatchConfig& config) {
-    hatchConfigs[q] = config;
-}
-
-void Pet::setLevelUpConfig(PetQuality q, const LevelUpConfig& config) {
-    levelUpConfigs[q] = config;
-}
-
 // ============================================================================
 // 孵化
 // ============================================================================
@@ -70,37 +72,34 @@ void Pet::hatch(PetQuality q, int enhancerCount) {
     level = 1;
     exp = 0;
     
-    auto it = hatchConfigs.find(quality);
-    if (it != hatchConfigs.end()) {
-        const HatchConfig& config = it->second;
-        
-        // 随机属性
-        maxHealth = config.health.roll(rng);
-        health = maxHealth;
-        attack = config.attack.roll(rng);
-        defense = config.defense.roll(rng);
-        dodge = config.dodge.roll(rng);
-        
-        // 随机技能
-        skills.clear();
-        rollSkills();
-    }
+    const HatchConfig& config = species->getHatchConfig(quality);
+    
+    // 随机属性
+    maxHealth = config.health.roll(rng);
+    health = maxHealth;
+    attack = config.attack.roll(rng);
+    defense = config.defense.roll(rng);
+    dodge = config.dodge.roll(rng);
     
-    std::cout << "宠物孵化成功! 资质: " << getQualityName(quality) << std::endl;
-    std::cout << "  生命: " << maxHealth << " 攻击: " << attack 
-              << " 防御: " << defense << " 闪避: " << dodge << std::endl;
+    // 随机技能
+    skills.clear();
+    rollSkills();
+    
+    LOG_INFO("宠物孵化成功! 资质: " << getQualityName(quality));
+    LOG_INFO("  生命: " << maxHealth << " 攻击: " << attack 
+          << " 防御: " << defense << " 闪避: " << dodge);
 }
 
 void Pet::rollSkills() {
-    auto it = hatchConfigs.find(quality);
-    if (it == hatchConfigs.end()) return;
-    
-    const HatchConfig& config = it->second;
+    const HatchConfig& config = species->getHatchConfig(quality);
     
     for (const auto& skillChance : config.skillChances) {
-        std::uniform_real_distribution<float> dist(0.0f, 1.0f);
-        if (dist(rng) < skillChance.second) {
-            // 子类应该重写此方法以添加具体技能
+        if (rng.nextFloat() < skillChance.second) {
+            const PetSkill* skill = species->findSkill(skillChance.first);
+            if (skill) {
+                skills.push_back(*skill);
+                LOG_INFO("  获得技能: " << skill->name);
+            }
         }
     }
 }
@@ -130,7 +129,7 @@ void Pet::levelUp() {
     level++;
     applyLevelUpStats();
     
-    std::cout << name << " 升级了! 当前等级: " << level << std::endl;
+    LOG_INFO(name << " 升级了! 当前等级: " << level);
     
     if (onLevelUp) {
         onLevelUp(*this);
@@ -138,26 +137,23 @@ void Pet::levelUp() {
 }
 
 void Pet::applyLevelUpStats() {
-    auto it = levelUpConfigs.find(quality);
-    if (it != levelUpConfigs.end()) {
-        const LevelUpConfig& config = it->second;
-        
-        float healthIncrease = config.health.roll(rng);
-        float attackIncrease = config.attack.roll(rng);
-        float defenseIncrease = config.defense.roll(rng);
-        float dodgeIncrease = config.dodge.roll(rng);
-        
-        maxHealth += healthIncrease;
-        health += healthIncrease;
-        attack += attackIncrease;
-        defense += defenseIncrease;
-        dodge += dodgeIncrease;
-        
-        std::cout << "  属性增加 - 生命: +" << healthIncrease 
-                  << " 攻击: +" << attackIncrease
-                  << " 防御: +" << defenseIncrease
-                  << " 闪避: +" << dodgeIncrease << std::endl;
-    }
+    const LevelUpConfig& config = species->getLevelUpConfig(quality);
+    
+    float healthIncrease = config.health.roll(rng);
+    float attackIncrease = config.attack.roll(rng);
+    float defenseIncrease = config.defense.roll(rng);
+    float dodgeIncrease = config.dodge.roll(rng);
+    
+    maxHealth += healthIncrease;
+    health += healthIncrease;
+    attack += attackIncrease;
+    defense += defenseIncrease;
+    dodge += dodgeIncrease;
+    
+    LOG_INFO("  属性增加 - 生命: +" << healthIncrease 
+          << " 攻击: +" << attackIncrease
+          << " 防御: +" << defenseIncrease
+          << " 闪避: +" << dodgeIncrease);
 }
 
 // ============================================================================
@@ -172,7 +168,7 @@ float Pet::performAttack() {
             damage *= skills[i].damageMultiplier;
             lastTriggeredSkillIndex = i;
             
-            std::cout << name << " 触发技能: " << skills[i].name << std::endl;
+            LOG_DEBUG(name << " 触发技能: " << skills[i].name);
             
             if (onSkillTrigger) {
                 onSkillTrigger(*this);
@@ -187,8 +183,7 @@ float Pet::performAttack() {
 bool Pet::rollSkill(int skillIndex) const {
     if (skillIndex < 0 || skillIndex >= (int)skills.size()) return false;
     
-    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
-    return dist(rng) < skills[skillIndex].triggerChance;
+    return rng.nextFloat() < skills[skillIndex].triggerChance;
 }
 
 void Pet::takeDamage(float damage) {
@@ -196,7 +191,7 @@ void Pet::takeDamage(float damage) {
     health = std::max(0.0f, health - actualDamage);
     
     if (isDead()) {
-        std::cout << name << " 倒下了!" << std::endl;
+        LOG_INFO(name << " 倒下了!");
     }
 }
 
@@ -247,6 +242,46 @@ void Pet::updateSprite() {
     sprite.setPosition(position);
 }
 
+// ============================================================================
+// 更新和渲染
+// ============================================================================
+void Pet::update(float dt, const sf::Vector2f& ownerPos, bool ownerAttacking) {
+    // 更新跟随AI
+    updateFollowAI(dt, ownerPos);
+    
+    // 更新攻击AI
+    updateAttackAI(dt, ownerAttacking);
+    
+    // 更新动画
+    updateAnimation(dt);
+    
+    // 更新精灵位置
+    updateSprite();
+}
+
+void Pet::updateAnimation(float dt) {
+    const SpriteSheetLayout& sheet = species->sheet;
+    animTimer += dt;
+    
+    if (animTimer >= sheet.frameTime) {
+        animTimer = 0;
+        currentFrame = (currentFrame + 1) % sheet.framesPerRow;
+    }
+    
+    // 攻击用攻击行，跟随和待机用移动行（待机固定第一帧）
+    int dir = static_cast<int>(direction);
+    int row = (animState == PetAnimState::Attack ? sheet.attackRow : sheet.moveRow) + dir;
+    
+    sprite.setTextureRect(sheet.frameRect(row, animState == PetAnimState::Idle ? 0 : currentFrame));
+}
+
+void Pet::render(sf::RenderWindow& window) {
+    if (!textureLoaded) return;
+    
+    // 绘制宠物精灵
+    RenderStats::draw(window, sprite);
+}
+
 // ============================================================================
 // AI更新
 // ============================================================================
@@ -262,8 +297,16 @@ void Pet::updateFollowAI(float dt, const sf::Vector2f& ownerPos) {
         // 需要移动
         animState = PetAnimState::Follow;
         
-        // 归一化方向
+        // 归一化方向（离得远时沿流场绕开障碍）
         sf::Vector2f dir = diff / distance;
+        if (flowField && distance > followDistance * 2.0f) {
+            sf::FloatRect box = getCollisionBox();
+            sf::Vector2f flowDir = flowField->sampleDirection(
+                sf::Vector2f(box.left + box.width / 2, box.top + box.height / 2));
+            if (flowDir.x != 0 || flowDir.y != 0) {
+                dir = flowDir;
+            }
+        }
         
         // 计算速度（距离越远速度越快）
         float speedMult = std::min(2.0f, distance / followDistance);
@@ -273,10 +316,10 @@ void Pet::updateFollowAI(float dt, const sf::Vector2f& ownerPos) {
         position += velocity * dt;
         
         // 更新朝向
-        if (std::abs(diff.x) > std::abs(diff.y)) {
-            direction = diff.x > 0 ? PetDirection::Right : PetDirection::Left;
+        if (std::abs(dir.x) > std::abs(dir.y)) {
+            direction = dir.x > 0 ? PetDirection::Right : PetDirection::Left;
         } else {
-            direction = diff.y > 0 ? PetDirection::Down : PetDirection::Up;
+            direction = dir.y > 0 ? PetDirection::Down : PetDirection::Up;
         }
     } else {
         // 在跟随范围内，保持空闲
@@ -321,7 +364,7 @@ void Pet::updateAttackAI(float dt, bool ownerAttacking) {
             attackCooldown = ATTACK_COOLDOWN_TIME;
             
             float damage = performAttack();
-            std::cout << name << " 指挥攻击! 造成 " << damage << " 点伤害" << std::endl;
+            LOG_DEBUG(name << " 指挥攻击! 造成 " << damage << " 点伤害");
             
             // 攻击完成后清除指挥目标
             hasCommandTarget = false;
@@ -340,7 +383,7 @@ void Pet::updateAttackAI(float dt, bool ownerAttacking) {
         
         // 执行攻击
         float damage = performAttack();
-        std::cout << name << " 攻击! 造成 " << damage << " 点伤害" << std::endl;
+        LOG_DEBUG(name << " 攻击! 造成 " << damage << " 点伤害");
     }
     
     // 主人不再攻击且没有目标时重置
@@ -361,13 +404,12 @@ void Pet::updateAttackAI(float dt, bool ownerAttacking) {
 void Pet::commandAttack(const sf::Vector2f& targetPos) {
     hasCommandTarget = true;
     commandTargetPos = targetPos;
-    std::cout << name << " 收到攻击指令，目标位置: (" << targetPos.x << ", " << targetPos.y << ")" << std::endl;
+    LOG_DEBUG(name << " 收到攻击指令，目标位置: (" << targetPos.x << ", " << targetPos.y << ")");
 }
 
-// 获取宠物图标矩形（精灵表第一帧）
+// 获取宠物图标矩形（精灵表第一帧 - 面朝下站立）
 sf::IntRect Pet::getIconRect() const {
-    // 默认返回32x32的第一帧
-    return sf::IntRect(0, 0, 32, 32);
+    return species->sheet.frameRect(species->sheet.moveRow, 0);
 }
 
 // ============================================================================
@@ -381,13 +423,51 @@ void Pet::wash(float playerLuck) {
     // 根据幸运值随机新资质
     PetQuality newQuality = rollWashQuality(rng, playerLuck);
     
-    std::cout << "宠物洗点! 原资质: " << getQualityName(quality) 
-              << " -> 新资质: " << getQualityName(newQuality) << std::endl;
+    LOG_INFO("宠物洗点! 原资质: " << getQualityName(quality) 
+          << " -> 新资质: " << getQualityName(newQuality));
     
     // 重新孵化（使用新资质）
     hatch(newQuality, 0);
 }
 
+// ============================================================================
+// 存档
+// ============================================================================
+PetSaveData Pet::captureSaveData() const {
+    PetSaveData data;
+    data.petTypeId = getPetTypeId();
+    data.name = name;
+    data.quality = quality;
+    data.level = level;
+    data.exp = exp;
+    data.health = health;
+    data.maxHealth = maxHealth;
+    data.sp = sp;
+    data.maxSP = maxSP;
+    data.attack = attack;
+    data.defense = defense;
+    data.dodge = dodge;
+    data.skills = skills;
+    data.position = position;
+    return data;
+}
+
+void Pet::applySaveData(const PetSaveData& data) {
+    name = data.name;
+    quality = data.quality;
+    level = data.level;
+    exp = data.exp;
+    health = data.health;
+    maxHealth = data.maxHealth;
+    sp = data.sp;
+    maxSP = data.maxSP;
+    attack = data.attack;
+    defense = data.defense;
+    dodge = data.dodge;
+    skills = data.skills;
+    setPosition(data.position);
+}
+
 // ============================================================================
 // 静态工具函数
 // ============================================================================
@@ -453,12 +533,11 @@ void Pet::getLuckWashProbabilities(float luck,
     rare = 0.03f + (0.12f * L / 300.0f);
 }
 
-PetQuality Pet::rollHatchQuality(std::mt19937& rng, int enhancerCount) {
+PetQuality Pet::rollHatchQuality(Rng& rng, int enhancerCount) {
     float mediocre, good, excellent, outstanding, rare;
     getEnhancerProbabilities(enhancerCount, mediocre, good, excellent, outstanding, rare);
     
-    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
-    float roll = dist(rng);
+    float roll = rng.nextFloat();
     
     if (roll < rare) return PetQuality::Rare;
     roll -= rare;
@@ -470,12 +549,11 @@ PetQuality Pet::rollHatchQuality(std::mt19937& rng, int enhancerCount) {
     return PetQuality::Mediocre;
 }
 
-PetQuality Pet::rollWashQuality(std::mt19937& rng, float playerLuck) {
+PetQuality Pet::rollWashQuality(Rng& rng, float playerLuck) {
     float mediocre, good, excellent, outstanding, rare;
     getLuckWashProbabilities(playerLuck, mediocre, good, excellent, outstanding, rare);
     
-    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
-    float roll = dist(rng);
+    float roll = rng.nextFloat();
     
     if (roll < rare) return PetQuality::Rare;
     roll -= rare;
@@ -1,11 +1,15 @@
 #pragma once
 #include <SFML/Graphics.hpp>
+#include <array>
 #include <string>
 #include <vector>
-#include <random>
 #include <functional>
 #include <memory>
 #include <cmath>
+#include "../Systems/Random.h"
+#include "../Systems/SpriteSheet.h"
+
+class FlowField;
 
 // ============================================================================
 // 宠物系统 (Pet System)
@@ -55,6 +59,8 @@ enum class PetQuality {
     Rare            // 稀有 2%
 };
 
+constexpr size_t PET_QUALITY_COUNT = 5;
+
 // 宠物动画状态
 enum class PetAnimState {
     Idle,
@@ -95,12 +101,25 @@ struct PetStatRange {
     
     PetStatRange(float min = 0, float max = 0) : minValue(min), maxValue(max) {}
     
-    float roll(std::mt19937& rng) const {
-        std::uniform_real_distribution<float> dist(minValue, maxValue);
-        return dist(rng);
+    float roll(Rng& rng) const {
+        return rng.range(minValue, maxValue);
     }
 };
 
+// 存档数据（单只宠物）
+struct PetSaveData {
+    int petTypeId = 0;
+    std::string name;
+    PetQuality quality = PetQuality::Mediocre;
+    int level = 1;
+    int exp = 0;
+    float health = 0, maxHealth = 0;
+    float sp = 0, maxSP = 0;
+    float attack = 0, defense = 0, dodge = 0;
+    std::vector<PetSkill> skills;
+    sf::Vector2f position;
+};
+
 // 孵化属性配置（按资质）
 struct HatchConfig {
     PetStatRange health;
@@ -120,6 +139,38 @@ struct LevelUpConfig {
     PetStatRange dodge;
 };
 
+// 宠物物种（同类宠物共享的只读配置，由 PetSpeciesRegistry 持有）
+// 新宠物类型只需注册一份数据；只有带专属行为的物种才需要子类
+struct PetSpecies {
+    int typeId = 0;                 // 宠物类型ID（存档用，1=兔子）
+    std::string typeName;           // 类型名（如"兔子"）
+    std::string defaultName;        // 孵化后的默认名字
+    std::string textureFile;        // 精灵表文件名（相对资源目录）
+    sf::Vector2f size{32.0f, 32.0f};
+    
+    // 按资质下标（static_cast<size_t>(PetQuality)）
+    std::array<HatchConfig, PET_QUALITY_COUNT> hatchConfigs;
+    std::array<LevelUpConfig, PET_QUALITY_COUNT> levelUpConfigs;
+    
+    // 技能表（HatchConfig::skillChances 按 id 引用）
+    std::vector<PetSkill> skillTable;
+    
+    SpriteSheetLayout sheet;
+    
+    const HatchConfig& getHatchConfig(PetQuality q) const {
+        return hatchConfigs[static_cast<size_t>(q)];
+    }
+    const LevelUpConfig& getLevelUpConfig(PetQuality q) const {
+        return levelUpConfigs[static_cast<size_t>(q)];
+    }
+    const PetSkill* findSkill(const std::string& skillId) const {
+        for (const auto& skill : skillTable) {
+            if (skill.id == skillId) return &skill;
+        }
+        return nullptr;
+    }
+};
+
 // ============================================================================
 // 宠物基类
 // ============================================================================
@@ -127,16 +178,17 @@ class Pet {
 public:
     using PetCallback = std::function<void(Pet&)>;
     
-    Pet();
+    explicit Pet(const PetSpecies& species);
     virtual ~Pet() = default;
     
     // ========================================
-    // 核心接口（子类必须实现）
+    // 核心接口（默认按物种的精灵表布局跟随、攻击和播放动画）
     // ========================================
-    virtual void update(float dt, const sf::Vector2f& ownerPos, bool ownerAttacking) = 0;
-    virtual void render(sf::RenderWindow& window) = 0;
-    virtual std::string getPetTypeName() const = 0;  // 宠物类型名（如"兔子"）
-    virtual int getPetTypeId() const = 0;            // 宠物类型ID
+    virtual void update(float dt, const sf::Vector2f& ownerPos, bool ownerAttacking);
+    virtual void render(sf::RenderWindow& window);
+    const std::string& getPetTypeName() const { return species->typeName; }  // 宠物类型名（如"兔子"）
+    int getPetTypeId() const { return species->typeId; }                     // 宠物类型ID
+    const PetSpecies& getSpecies() const { return *species; }
     
     // ========================================
     // 初始化
@@ -147,10 +199,6 @@ public:
     // 孵化宠物（根据资质初始化属性）
     virtual void hatch(PetQuality quality, int enhancerCount = 0);
     
-    // 设置资质配置（子类调用）
-    void setHatchConfig(PetQuality quality, const HatchConfig& config);
-    void setLevelUpConfig(PetQuality quality, const LevelUpConfig& config);
-    
     // ========================================
     // 等级经验系统
     // ========================================
@@ -233,6 +281,9 @@ public:
     void setPosition(float x, float y);
     void setPosition(const sf::Vector2f& pos);
     
+    // 跟随时使用的共享流场（为空时直线跟随）
+    void setFlowField(const FlowField* field) { flowField = field; }
+    
     // ========================================
     // 碰撞检测
     // ========================================
@@ -247,6 +298,12 @@ public:
     // playerLuck: 玩家幸运值 0-300
     void wash(float playerLuck);
     
+    // ========================================
+    // 存档
+    // ========================================
+    PetSaveData captureSaveData() const;
+    void applySaveData(const PetSaveData& data);
+    
     // ========================================
     // 回调
     // ========================================
@@ -264,10 +321,10 @@ public:
     static sf::Color getQualityColor(PetQuality quality);
     
     // 随机孵化资质（基础概率）
-    static PetQuality rollHatchQuality(std::mt19937& rng, int enhancerCount = 0);
+    static PetQuality rollHatchQuality(Rng& rng, int enhancerCount = 0);
     
     // 随机洗点资质（受幸运值影响）
-    static PetQuality rollWashQuality(std::mt19937& rng, float playerLuck);
+    static PetQuality rollWashQuality(Rng& rng, float playerLuck);
     
     // 计算升级所需经验（分段指数型）
     static int calculateExpForLevel(int level);
@@ -292,13 +349,19 @@ protected:
     // 更新攻击AI
     virtual void updateAttackAI(float dt, bool ownerAttacking);
     
+    // 按动画状态和朝向切换精灵表帧
+    void updateAnimation(float dt);
+    
     // 应用升级属性增加
     virtual void applyLevelUpStats();
     
-    // 随机获取技能
+    // 随机获取技能（按资质的技能概率，从物种技能表取）
     virtual void rollSkills();
 
 protected:
+    // === 物种（共享配置）===
+    const PetSpecies* species;
+    
     // === 基础属性 ===
     std::string name;
     PetQuality quality;
@@ -322,6 +385,7 @@ protected:
     sf::Vector2f size;
     sf::Vector2f velocity;
     sf::Vector2f targetOffset;      // 相对主人的目标偏移
+    const FlowField* flowField = nullptr;
     
     // === 跟随参数 ===
     float followDistance;           // 跟随距离
@@ -330,6 +394,8 @@ protected:
     // === 动画状态 ===
     PetAnimState animState;
     PetDirection direction;
+    int currentFrame = 0;
+    float animTimer = 0;
     
     // === 渲染 ===
     sf::Sprite sprite;
@@ -348,16 +414,12 @@ protected:
     bool hasCommandTarget = false;       // 是否有玩家指定的攻击目标
     sf::Vector2f commandTargetPos;       // 玩家指定的目标位置
     
-    // === 配置 ===
-    std::map<PetQuality, HatchConfig> hatchConfigs;
-    std::map<PetQuality, LevelUpConfig> levelUpConfigs;
-    
     // === 回调 ===
     PetCallback onLevelUp;
     PetCallback onSkillTrigger;
     
-    // === 随机数生成 ===
-    mutable std::mt19937 rng;
+    // === 随机数生成（实体独立流）===
+    mutable Rng rng;
     
     // === 常量 ===
     static constexpr float DEFAULT_FOLLOW_DISTANCE = 50.0f;
@@ -1,5 +1,6 @@
 #include "PetManager.h"
-#include <iostream>
+#include "PetSpecies.h"
+#include "../Systems/Logger.h"
 #include <algorithm>
 
 // ============================================================================
@@ -10,12 +11,6 @@ PetManager::PetManager()
 {
     // 初始化宠物槽位
     petSlots.resize(MAX_PET_SLOTS);
-    
-    // 注册宠物类型
-    petTypeNames[1] = "兔子";
-    // 后续可以添加更多宠物类型
-    // petTypeNames[2] = "史莱姆";
-    // petTypeNames[3] = "小鸡";
 }
 
 // ============================================================================
@@ -32,6 +27,7 @@ bool PetManager::init(const std::string& path) {
 void PetManager::update(float dt, const sf::Vector2f& ownerPos, bool ownerAttacking) {
     Pet* currentPet = getCurrentPet();
     if (currentPet) {
+        currentPet->setFlowField(flowField);
         currentPet->update(dt, ownerPos, ownerAttacking);
     }
 }
@@ -88,7 +84,7 @@ bool PetManager::switchPet(int slotIndex) {
     }
     
     currentPetIndex = slotIndex;
-    std::cout << "切换到宠物: " << petSlots[slotIndex].pet->getName() << std::endl;
+    LOG_INFO("切换到宠物: " << petSlots[slotIndex].pet->getName());
     return true;
 }
 
@@ -99,30 +95,26 @@ bool PetManager::hatchPet(int petTypeId, int enhancerCount) {
     // 检查是否有空槽位
     int emptySlot = findEmptySlot();
     if (emptySlot < 0) {
-        std::cout << "没有空闲的宠物槽位!" << std::endl;
+        LOG_INFO("没有空闲的宠物槽位!");
         return false;
     }
     
     // 创建宠物
     auto pet = createPet(petTypeId);
     if (!pet) {
-        std::cout << "未知的宠物类型: " << petTypeId << std::endl;
+        LOG_INFO("未知的宠物类型: " << petTypeId);
         return false;
     }
     
     // 随机资质（受强化剂影响）
-    std::mt19937 rng(std::random_device{}());
+    Rng& rng = RandomService::getInstance().stream(RngStream::PetHatch);
     PetQuality quality = Pet::rollHatchQuality(rng, enhancerCount);
     
     // 孵化
     pet->hatch(quality, enhancerCount);
     
     // 加载贴图
-    std::string texturePath = resourcePath;
-    if (petTypeId == 1) {
-        texturePath += "/assets_rabbit_spritesheet.png";
-    }
-    pet->loadTexture(texturePath);
+    pet->loadTexture(getPetTexturePath(petTypeId));
     
     // 放入槽位
     petSlots[emptySlot].pet = std::move(pet);
@@ -132,7 +124,7 @@ bool PetManager::hatchPet(int petTypeId, int enhancerCount) {
         currentPetIndex = emptySlot;
     }
     
-    std::cout << "成功孵化宠物! 槽位: " << emptySlot << std::endl;
+    LOG_INFO("成功孵化宠物! 槽位: " << emptySlot);
     return true;
 }
 
@@ -155,12 +147,64 @@ int PetManager::findEmptySlot() const {
 }
 
 std::unique_ptr<Pet> PetManager::createPet(int petTypeId) {
+    const PetSpecies* species = PetSpeciesRegistry::getInstance().find(petTypeId);
+    if (!species) {
+        return nullptr;
+    }
+    
+    // 只有带专属技能效果的物种需要子类，其余物种直接用 Pet
     switch (petTypeId) {
-        case 1:  // 兔子
-            return std::make_unique<PetRabbit>();
+        case PetSpeciesRegistry::RABBIT:
+            return std::make_unique<PetRabbit>(*species);
         default:
-            return nullptr;
+            return std::make_unique<Pet>(*species);
+    }
+}
+
+std::string PetManager::getPetTexturePath(int petTypeId) const {
+    std::string texturePath = resourcePath;
+    const PetSpecies* species = PetSpeciesRegistry::getInstance().find(petTypeId);
+    if (species) {
+        texturePath += "/" + species->textureFile;
     }
+    return texturePath;
+}
+
+// ============================================================================
+// 存档
+// ============================================================================
+PetManagerSaveData PetManager::captureSaveData() const {
+    PetManagerSaveData data;
+    data.currentPetIndex = currentPetIndex;
+    
+    for (size_t i = 0; i < petSlots.size(); i++) {
+        if (!petSlots[i].isEmpty()) {
+            PetSlotSaveData slot;
+            slot.slotIndex = static_cast<int>(i);
+            slot.pet = petSlots[i].pet->captureSaveData();
+            data.slots.push_back(std::move(slot));
+        }
+    }
+    return data;
+}
+
+void PetManager::applySaveData(const PetManagerSaveData& data) {
+    for (auto& slot : petSlots) {
+        slot.pet.reset();
+    }
+    
+    for (const auto& slot : data.slots) {
+        if (slot.slotIndex < 0 || slot.slotIndex >= static_cast<int>(petSlots.size())) continue;
+        
+        auto pet = createPet(slot.pet.petTypeId);
+        if (!pet) continue;
+        
+        pet->applySaveData(slot.pet);
+        pet->loadTexture(getPetTexturePath(slot.pet.petTypeId));
+        petSlots[slot.slotIndex].pet = std::move(pet);
+    }
+    
+    currentPetIndex = (getPetAt(data.currentPetIndex) != nullptr) ? data.currentPetIndex : -1;
 }
 
 // ============================================================================
@@ -173,7 +217,7 @@ bool PetManager::washCurrentPet(float playerLuck) {
 bool PetManager::washPet(int slotIndex, float playerLuck) {
     Pet* pet = getPetAt(slotIndex);
     if (!pet) {
-        std::cout << "指定槽位没有宠物!" << std::endl;
+        LOG_INFO("指定槽位没有宠物!");
         return false;
     }
     
@@ -193,7 +237,7 @@ bool PetManager::releasePet(int slotIndex) {
         return false;
     }
     
-    std::cout << "释放宠物: " << petSlots[slotIndex].pet->getName() << std::endl;
+    LOG_INFO("释放宠物: " << petSlots[slotIndex].pet->getName());
     petSlots[slotIndex].pet.reset();
     
     // 如果释放的是当前宠物，切换到其他宠物
@@ -254,17 +298,13 @@ std::string PetManager::checkPetItemDrop(float dt) {
 // 宠物类型注册
 // ============================================================================
 std::vector<int> PetManager::getRegisteredPetTypes() const {
-    std::vector<int> types;
-    for (const auto& pair : petTypeNames) {
-        types.push_back(pair.first);
-    }
-    return types;
+    return PetSpeciesRegistry::getInstance().getTypeIds();
 }
 
 std::string PetManager::getPetTypeName(int petTypeId) const {
-    auto it = petTypeNames.find(petTypeId);
-    if (it != petTypeNames.end()) {
-        return it->second;
+    const PetSpecies* species = PetSpeciesRegistry::getInstance().find(petTypeId);
+    if (species) {
+        return species->typeName;
     }
     return "未知";
 }
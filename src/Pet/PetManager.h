@@ -3,7 +3,6 @@
 #include "PetRabbit.h"
 #include <memory>
 #include <vector>
-#include <map>
 
 // ============================================================================
 // 宠物管理器 (Pet Manager)
@@ -22,6 +21,17 @@ struct PetSlot {
     bool isEmpty() const { return pet == nullptr; }
 };
 
+// 存档数据（只记录非空槽位）
+struct PetSlotSaveData {
+    int slotIndex = 0;
+    PetSaveData pet;
+};
+
+struct PetManagerSaveData {
+    int currentPetIndex = -1;
+    std::vector<PetSlotSaveData> slots;
+};
+
 class PetManager : public PetManagerBase {
 public:
     PetManager();
@@ -38,6 +48,9 @@ public:
     void update(float dt, const sf::Vector2f& ownerPos, bool ownerAttacking) override;
     void render(sf::RenderWindow& window) override;
     
+    // 跟随用的共享流场（每帧交给当前宠物）
+    void setFlowField(const FlowField* field) { flowField = field; }
+    
     // ========================================
     // 宠物管理
     // ========================================
@@ -111,7 +124,7 @@ public:
     std::string checkPetItemDrop(float dt);
     
     // ========================================
-    // 宠物类型注册
+    // 宠物类型注册（数据在 PetSpeciesRegistry）
     // ========================================
     
     // 获取已注册的宠物类型ID列表
@@ -119,11 +132,20 @@ public:
     
     // 获取宠物类型名称
     std::string getPetTypeName(int petTypeId) const;
+    
+    // ========================================
+    // 存档
+    // ========================================
+    PetManagerSaveData captureSaveData() const;
+    void applySaveData(const PetManagerSaveData& data);
 
 private:
     // 创建指定类型的宠物
     std::unique_ptr<Pet> createPet(int petTypeId);
     
+    // 获取宠物类型对应的贴图路径
+    std::string getPetTexturePath(int petTypeId) const;
+    
     // 查找空槽位
     int findEmptySlot() const;
 
@@ -134,12 +156,11 @@ private:
     // 当前使用的宠物索引
     int currentPetIndex;
     
+    const FlowField* flowField = nullptr;
+    
     // 资源路径
     std::string resourcePath;
     
-    // 宠物类型名称映射
-    std::map<int, std::string> petTypeNames;
-    
     // 最大宠物数量
     static constexpr int MAX_PET_SLOTS = 6;
 };
@@ -0,0 +1,188 @@
+#include "PetSpecies.h"
+#include "PetRabbit.h"
+#include "../Systems/Logger.h"
+
+PetSpeciesRegistry& PetSpeciesRegistry::getInstance() {
+    static PetSpeciesRegistry instance;
+    return instance;
+}
+
+PetSpeciesRegistry::PetSpeciesRegistry() {
+    registerBuiltins();
+}
+
+const PetSpecies& PetSpeciesRegistry::add(PetSpecies species) {
+    if (const PetSpecies* existing = find(species.typeId)) {
+        LOG_WARN("[PetSpeciesRegistry] Duplicate pet type id: " << species.typeId);
+        return *existing;
+    }
+    entries.push_back(std::move(species));
+    return entries.back();
+}
+
+const PetSpecies* PetSpeciesRegistry::find(int typeId) const {
+    for (const auto& species : entries) {
+        if (species.typeId == typeId) {
+            return &species;
+        }
+    }
+    return nullptr;
+}
+
+std::vector<int> PetSpeciesRegistry::getTypeIds() const {
+    std::vector<int> ids;
+    ids.reserve(entries.size());
+    for (const auto& species : entries) {
+        ids.push_back(species.typeId);
+    }
+    return ids;
+}
+
+// ============================================================================
+// 内置物种
+// ============================================================================
+
+namespace {
+
+// 资质配置下标
+size_t q(PetQuality quality) { return static_cast<size_t>(quality); }
+
+PetSpecies makeRabbit() {
+    PetSpecies rabbit;
+    rabbit.typeId = PetSpeciesRegistry::RABBIT;
+    rabbit.typeName = "兔子";
+    rabbit.defaultName = "宠物兔";
+    rabbit.textureFile = "assets_rabbit_spritesheet.png";   // 与兔子怪物相同的精灵表
+    rabbit.size = sf::Vector2f(32, 32);
+    rabbit.sheet.scale = 1.5f;  // 放大一点使宠物更明显
+    
+    // 技能表
+    rabbit.skillTable = {
+        PetSkill(PetRabbit::SKILL_BITE,
+                 "撕咬",
+                 "30%触发双倍普通攻击伤害",
+                 0.30f,      // 触发概率
+                 2.0f,       // 伤害倍率
+                 0,
+                 false),     // 主动技能
+        PetSkill(PetRabbit::SKILL_SHEDDING,
+                 "脱毛",
+                 "每20分钟掉落一个兔毛",
+                 1.0f,       // 100%触发（被动）
+                 1.0f,
+                 1,          // 掉落1个
+                 true),      // 被动技能
+        PetSkill(PetRabbit::SKILL_CHEER,
+                 "兔子助威",
+                 "增加主人3%最大攻击力",
+                 1.0f,       // 100%触发（被动）
+                 1.0f,
+                 0.03f,      // 3%加成
+                 true)       // 被动技能
+    };
+    
+    // 平庸资质配置
+    {
+        HatchConfig& config = rabbit.hatchConfigs[q(PetQuality::Mediocre)];
+        config.health = PetStatRange(10, 20);
+        config.attack = PetStatRange(2, 3);
+        config.defense = PetStatRange(1, 2);
+        config.dodge = PetStatRange(0, 1);
+        config.skillChances = {
+            {PetRabbit::SKILL_BITE, 0.20f},
+            {PetRabbit::SKILL_SHEDDING, 0.05f}
+        };
+        
+        LevelUpConfig& lvlConfig = rabbit.levelUpConfigs[q(PetQuality::Mediocre)];
+        lvlConfig.health = PetStatRange(3, 5);
+        lvlConfig.attack = PetStatRange(1, 3);
+        lvlConfig.defense = PetStatRange(1, 2);
+        lvlConfig.dodge = PetStatRange(0, 1);
+    }
+    
+    // 良好资质配置
+    {
+        HatchConfig& config = rabbit.hatchConfigs[q(PetQuality::Good)];
+        config.health = PetStatRange(15, 30);
+        config.attack = PetStatRange(3, 5);
+        config.defense = PetStatRange(1, 3);
+        config.dodge = PetStatRange(0, 1);
+        config.skillChances = {
+            {PetRabbit::SKILL_BITE, 0.30f},
+            {PetRabbit::SKILL_SHEDDING, 0.08f}
+        };
+        
+        LevelUpConfig& lvlConfig = rabbit.levelUpConfigs[q(PetQuality::Good)];
+        lvlConfig.health = PetStatRange(4, 7);
+        lvlConfig.attack = PetStatRange(2, 4);
+        lvlConfig.defense = PetStatRange(1, 3);
+        lvlConfig.dodge = PetStatRange(0, 1);
+    }
+    
+    // 优秀资质配置
+    {
+        HatchConfig& config = rabbit.hatchConfigs[q(PetQuality::Excellent)];
+        config.health = PetStatRange(30, 60);
+        config.attack = PetStatRange(5, 8);
+        config.defense = PetStatRange(3, 6);
+        config.dodge = PetStatRange(1, 3);
+        config.skillChances = {
+            {PetRabbit::SKILL_BITE, 0.50f},
+            {PetRabbit::SKILL_SHEDDING, 0.20f}
+        };
+        
+        LevelUpConfig& lvlConfig = rabbit.levelUpConfigs[q(PetQuality::Excellent)];
+        lvlConfig.health = PetStatRange(8, 13);
+        lvlConfig.attack = PetStatRange(4, 8);
+        lvlConfig.defense = PetStatRange(2, 4);
+        lvlConfig.dodge = PetStatRange(1, 2);
+    }
+    
+    // 卓越资质配置
+    {
+        HatchConfig& config = rabbit.hatchConfigs[q(PetQuality::Outstanding)];
+        config.health = PetStatRange(50, 80);
+        config.attack = PetStatRange(8, 15);
+        config.defense = PetStatRange(6, 10);
+        config.dodge = PetStatRange(2, 5);
+        config.skillChances = {
+            {PetRabbit::SKILL_BITE, 0.70f},
+            {PetRabbit::SKILL_SHEDDING, 0.35f}
+        };
+        
+        LevelUpConfig& lvlConfig = rabbit.levelUpConfigs[q(PetQuality::Outstanding)];
+        lvlConfig.health = PetStatRange(12, 20);
+        lvlConfig.attack = PetStatRange(8, 12);
+        lvlConfig.defense = PetStatRange(5, 8);
+        lvlConfig.dodge = PetStatRange(2, 5);
+    }
+    
+    // 稀有资质配置
+    {
+        HatchConfig& config = rabbit.hatchConfigs[q(PetQuality::Rare)];
+        config.health = PetStatRange(100, 150);
+        config.attack = PetStatRange(15, 30);
+        config.defense = PetStatRange(10, 17);
+        config.dodge = PetStatRange(4, 8);
+        config.skillChances = {
+            {PetRabbit::SKILL_BITE, 1.0f},      // 100%
+            {PetRabbit::SKILL_SHEDDING, 1.0f},  // 100%
+            {PetRabbit::SKILL_CHEER, 1.0f}      // 100%
+        };
+        
+        LevelUpConfig& lvlConfig = rabbit.levelUpConfigs[q(PetQuality::Rare)];
+        lvlConfig.health = PetStatRange(20, 35);
+        lvlConfig.attack = PetStatRange(12, 20);
+        lvlConfig.defense = PetStatRange(8, 12);
+        lvlConfig.dodge = PetStatRange(4, 6);
+    }
+    
+    return rabbit;
+}
+
+} // namespace
+
+void PetSpeciesRegistry::registerBuiltins() {
+    add(makeRabbit());
+    // 后续可以添加更多宠物类型（史莱姆、小鸡……）
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include "Pet.h"
+#include <deque>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// 宠物物种注册表 (Pet Species Registry)
+//
+// 每种宠物一份只读的 PetSpecies（资质配置、技能表、动画布局、贴图文件），
+// PetManager 按类型ID取出物种后创建宠物，宠物实例只保存自己的属性和状态：
+//   const PetSpecies* species = PetSpeciesRegistry::getInstance().find(typeId);
+//
+//   - 类型ID写进存档，注册后不能改
+//   - 已注册物种的地址不会变化，宠物实例可以长期持有引用
+// ============================================================================
+
+class PetSpeciesRegistry {
+public:
+    // 内置物种类型ID
+    static constexpr int RABBIT = 1;
+
+    static PetSpeciesRegistry& getInstance();
+
+    // 注册新物种（类型ID重复时忽略并返回已有物种）
+    const PetSpecies& add(PetSpecies species);
+
+    // 按类型ID查找（未找到返回 nullptr）
+    const PetSpecies* find(int typeId) const;
+
+    // 已注册的类型ID（按注册顺序）
+    std::vector<int> getTypeIds() const;
+
+    size_t size() const { return entries.size(); }
+
+private:
+    PetSpeciesRegistry();
+    PetSpeciesRegistry(const PetSpeciesRegistry&) = delete;
+    PetSpeciesRegistry& operator=(const PetSpeciesRegistry&) = delete;
+
+    void registerBuiltins();
+
+    // deque：追加时已有元素不搬家
+    std::deque<PetSpecies> entries;
+};
@@ -1,26 +1,39 @@
 ﻿#include "GameState.h"
 #include "../Core/Game.h"
-#include <iostream>
 #include <filesystem>  // For path debugging
 #include <cmath>       // For sqrt in collision
+#include <cstring>     // For memcpy in state hash
+#include <stdexcept>   // Missing item definitions abort construction
 #include "../Entity/Rabbit.h"
+#include "../Systems/Random.h"
+#include "../Systems/InputSystem.h"
+#include "../Items/ItemDefinitions.h"
+#include "../Systems/Logger.h"
+#include "../Systems/Profiler.h"
+#include "../Systems/RenderStats.h"
+#include "../Systems/CollisionSystem.h"
+#include "../Systems/EventBus.h"
 
-GameState::GameState(Game* game, MapType mapType) 
+GameState::GameState(Game* game, MapType mapType, const StressSceneConfig* stressScene) 
     : State(game)
     , currentMap(mapType)
     , wasAttacking(false)
-    , rng(std::random_device{}())
 {
+    PROFILE_SCOPE("GameState::GameState");
+    
+    // 实体事件（砍树、采摘、兔子攻击、物品入包）在 update 中成批处理
+    EventBus::getInstance().setActive(true);
+    
     // Initialize available tree types from tree.tsx
     availableTreeTypes = {"tree1", "apple_tree", "cherry_tree", "cherry_blossom_tree"};
     
-    std::cout << "========================================" << std::endl;
-    std::cout << "  Pixel Farm RPG - Scene Initialization" << std::endl;
-    std::cout << "========================================" << std::endl;
+    LOG_INFO("========================================");
+    LOG_INFO("  Pixel Farm RPG - Scene Initialization");
+    LOG_INFO("========================================");
 
     // Debug: Print current working directory
-    std::cout << "[DEBUG] Working directory: " 
-              << std::filesystem::current_path().string() << std::endl;
+    LOG_DEBUG("[DEBUG] Working directory: " 
+           << std::filesystem::current_path().string());
 
     // ========================================
     // 初始化物品系统（必须在其他系统之前）
@@ -38,6 +51,22 @@ GameState::GameState(Game* game, MapType mapType)
     rabbitManager = std::make_unique<RabbitManager>();
     rabbitManager->init("../../assets/rabbit_spritesheet.png");
     
+    // Create shared flow field (obstacles are built on the first update)
+    flowField = std::make_unique<FlowField>();
+    rabbitManager->setFlowField(flowField.get());
+    
+    // 压力测试场景：生成地图代替 mapType 对应的地图
+    if (stressScene) {
+        StressSceneConfig config = *stressScene;
+        config.resolveCounts();
+        std::string path = StressScene::defaultPath(config);
+        if (StressScene::writeMap(config, path)) {
+            stressMapPath = path;
+            stressMapType = mapType;
+            rabbitSpawnCount = config.rabbitCount;
+        }
+    }
+    
     // Load map
     loadMap(mapType);
     
@@ -78,42 +107,80 @@ GameState::GameState(Game* game, MapType mapType)
     // Initialize Pet System
     initPetSystem();
     
-    std::cout << "[OK] Player Position: (" << player->getPosition().x 
-              << ", " << player->getPosition().y << ")" << std::endl;
-    std::cout << "\nControls:" << std::endl;
-    std::cout << "  WASD/Arrows - Move" << std::endl;
-    std::cout << "  Space       - Attack (chop trees, mine stones!)" << std::endl;
-    std::cout << "  V           - Pickup wild plants" << std::endl;
-    std::cout << "  Tab         - Toggle Stats Panel" << std::endl;
-    std::cout << "  I/B         - Toggle Inventory (3 categories)" << std::endl;
-    std::cout << "  1/2/3       - Switch inventory category" << std::endl;
-    std::cout << "  E           - Toggle Equipment Panel" << std::endl;
-    std::cout << "  C           - Toggle Crafting Workshop" << std::endl;
-    std::cout << "  P           - Toggle Pet Panel" << std::endl;
-    std::cout << "  H           - Toggle Hatch Panel" << std::endl;
-    std::cout << "  F1 - Farm Map | F2 - Forest Map | F3 - Reload" << std::endl;
-    std::cout << "  ESC - Exit" << std::endl;
-    std::cout << "========================================\n" << std::endl;
+    // 属性加成栈：装备/宠物/Buff 汇总后写入玩家属性
+    statModifiers = std::make_unique<StatModifierStack>(&player->getStats());
+    player->getStats().setOnLevelUp([this]() { statModifiers->refresh(); });
+    refreshEquipmentModifiers();
+    refreshPetModifiers();
+    
+    LOG_INFO("[OK] Player Position: (" << player->getPosition().x 
+          << ", " << player->getPosition().y << ")");
+    LOG_INFO("\nControls:");
+    LOG_INFO("  WASD/Arrows - Move");
+    LOG_INFO("  Space       - Attack (chop trees, mine stones!)");
+    LOG_INFO("  V           - Pickup wild plants");
+    LOG_INFO("  Tab         - Toggle Stats Panel");
+    LOG_INFO("  I/B         - Toggle Inventory (3 categories)");
+    LOG_INFO("  1/2/3       - Switch inventory category");
+    LOG_INFO("  E           - Toggle Equipment Panel");
+    LOG_INFO("  C           - Toggle Crafting Workshop");
+    LOG_INFO("  P           - Toggle Pet Panel");
+    LOG_INFO("  H           - Toggle Hatch Panel");
+    LOG_INFO("  F1 - Farm Map | F2 - Forest Map | F3 - Reload");
+    LOG_INFO("  F5 - Save | F9 - Load");
+    LOG_INFO("  F10 - Profiler | F11 - Capture trace");
+    LOG_INFO("  ESC - Exit");
+    LOG_INFO("========================================\n");
+    
+    // 读取存档（回放模式下保持初始状态，保证可复现；压力测试场景不混入真实存档）
+    if (persistenceEnabled() && SaveSystem::exists(SAVE_PATH)) {
+        loadGame();
+    }
+}
+
+GameState::~GameState() {
+    // 退出时同步保存一次
+    if (persistenceEnabled()) {
+        saveGame(false);
+    }
+    EventBus::getInstance().setActive(false);
 }
 
 void GameState::initItemSystem() {
-    std::cout << "[ItemSystem] Initializing..." << std::endl;
+    PROFILE_SCOPE("GameState::initItemSystem");
+    
+    LOG_INFO("[ItemSystem] Initializing...");
+    
+    // 加载物品/装备/配方定义（defs.bin，缺失时回退到 JSON）
+    // 定义表缺失或损坏时不能带着空表进入游戏
+    ItemDefinitionSet definitions;
+    if (!ItemDefinitions::load(definitions)) {
+        LOG_ERROR("[ItemSystem] Failed to load item definitions (defs.bin and JSON)");
+        EventBus::getInstance().setActive(false);
+        throw std::runtime_error("item definitions unavailable");
+    }
     
     // 初始化物品数据库
-    ItemDatabase::getInstance().initialize();
+    ItemDatabase::getInstance().initialize(definitions.items);
     ItemDatabase::getInstance().loadTextures("");
     
     // 初始化装备管理器
-    EquipmentManager::getInstance().initialize();
+    EquipmentManager::getInstance().initialize(definitions.equipments);
     
     // 初始化合成管理器
-    CraftingManager::getInstance().initialize();
+    CraftingManager::getInstance().initialize(definitions.recipes);
     
     // 创建分类背包
     categoryInventory = std::make_unique<CategoryInventory>();
     
-    // 创建玩家装备栏
+    // 创建玩家装备栏（穿脱装备时刷新属性加成）
     playerEquipment = std::make_unique<PlayerEquipment>();
+    playerEquipment->setOnEquip([this](EquipmentSlot, const std::string&) {
+        refreshEquipmentModifiers();
+    });
+    playerEquipment->setOnUnequip([this](EquipmentSlot, const std::string&) {
+        refreshEquipmentModifiers();
+    });
     
     // 设置使用物品回调
     categoryInventory->setOnUseItem([this](const ItemStack& item, const ItemData* data) {
@@ -134,7 +201,7 @@ void GameState::initItemSystem() {
     categoryInventory->setOnEquipItem([this](const ItemStack& item) {
         if (!playerEquipment) return false;
         
-        const EquipmentData* equipData = EquipmentManager::getInstance().getEquipmentData(item.itemId);
+        const EquipmentData* equipData = EquipmentManager::getInstance().getEquipmentData(item.getStringId());
         if (!equipData) return false;
         
         // 检查等级需求
@@ -163,20 +230,10 @@ void GameState::initItemSystem() {
             categoryInventory->addItem(oldItem.itemId, oldItem.count);
         }
         
-        std::cout << "[Equip] Equipped " << item.itemId << std::endl;
+        LOG_INFO("[Equip] Equipped " << item.getStringId());
         return true;
     });
     
-    // 设置物品添加回调（用于显示提示）
-    categoryInventory->setOnItemAdded([](const ItemStack& item, int slotIndex, InventoryCategory category) {
-        (void)slotIndex;  // 未使用参数
-        (void)category;   // 未使用参数
-        const ItemData* data = ItemDatabase::getInstance().getItemData(item.itemId);
-        if (data) {
-            std::cout << "[Inventory] +" << item.count << " " << data->name << std::endl;
-        }
-    });
-    
     // 创建掉落物品管理器
     droppedItemManager = std::make_unique<DroppedItemManager>();
     droppedItemManager->init("../../assets");
@@ -190,7 +247,7 @@ void GameState::initItemSystem() {
         if (added > 0 && eventLogPanel) {
             const ItemData* data = ItemDatabase::getInstance().getItemData(item.itemId);
             if (data) {
-                eventLogPanel->addItemObtained(data->name, added, item.itemId);
+                eventLogPanel->addItemObtained(data->numericId, added);
             }
         }
         
@@ -198,7 +255,7 @@ void GameState::initItemSystem() {
             // 背包已满，重新掉落未能拾取的物品
             if (player) {
                 sf::Vector2f pos = player->getPosition();
-                droppedItemManager->spawnItem(item.itemId, item.count - added, pos.x, pos.y);
+                droppedItemManager->spawnItem(item.getStringId(), item.count - added, pos.x, pos.y);
             }
             // 警告背包已满
             if (eventLogPanel) {
@@ -218,10 +275,12 @@ void GameState::initItemSystem() {
     categoryInventory->addItem("rabbit_essence", 1);  // 初始赠送一个兔子精元
     categoryInventory->addItem("rabbit_fur", 10);     // 初始赠送一些兔毛作为强化剂
     
-    std::cout << "[ItemSystem] Initialized successfully" << std::endl;
+    LOG_INFO("[ItemSystem] Initialized successfully");
 }
 
 void GameState::initUI(sf::RenderWindow& window) {
+    PROFILE_SCOPE("GameState::initUI");
+    
     // Create stats panel
     statsPanel = std::make_unique<StatsPanel>();
     
@@ -241,14 +300,14 @@ void GameState::initUI(sf::RenderWindow& window) {
         if (std::filesystem::exists(path)) {
             statsPanel->init(path);
             iconLoaded = true;
-            std::cout << "[OK] Stats icon loaded: " << path << std::endl;
+            LOG_INFO("[OK] Stats icon loaded: " << path);
             break;
         }
     }
     
     if (!iconLoaded) {
         statsPanel->init("../../assets/ui/icon1.png");
-        std::cout << "[WARNING] Stats icon not found, using placeholder" << std::endl;
+        LOG_WARN("[WARNING] Stats icon not found, using placeholder");
     }
     
     // Position icon at bottom-left of screen
@@ -268,7 +327,7 @@ void GameState::initUI(sf::RenderWindow& window) {
     categoryInventoryPanel->setOnDropItem([this](const ItemStack& item, sf::Vector2f pos) {
         if (player && droppedItemManager) {
             sf::Vector2f playerPos = player->getPosition();
-            droppedItemManager->spawnItem(item.itemId, item.count, playerPos.x + 30, playerPos.y);
+            droppedItemManager->spawnItem(item.getStringId(), item.count, playerPos.x + 30, playerPos.y);
         }
     });
     
@@ -324,15 +383,17 @@ void GameState::initUI(sf::RenderWindow& window) {
     eventLogPanel->addMessage("按 E 打开装备栏", EventType::System);
     eventLogPanel->addMessage("按 C 打开工作台", EventType::System);
     
-    std::cout << "[OK] UI initialized" << std::endl;
-    std::cout << "  - I/B: 分类背包 (材料/消耗品/装备)" << std::endl;
-    std::cout << "  - E: 装备栏" << std::endl;
-    std::cout << "  - C: 工作台/合成" << std::endl;
-    std::cout << "  - P: 宠物栏" << std::endl;
-    std::cout << "  - H: 孵化栏" << std::endl;
+    LOG_INFO("[OK] UI initialized");
+    LOG_INFO("  - I/B: 分类背包 (材料/消耗品/装备)");
+    LOG_INFO("  - E: 装备栏");
+    LOG_INFO("  - C: 工作台/合成");
+    LOG_INFO("  - P: 宠物栏");
+    LOG_INFO("  - H: 孵化栏");
 }
 
 void GameState::loadMap(MapType mapType) {
+    PROFILE_SCOPE("GameState::loadMap");
+    
     std::string mapPath;
     
     switch (mapType) {
@@ -345,24 +406,182 @@ void GameState::loadMap(MapType mapType) {
             break;
     }
     
+    if (!stressMapPath.empty() && mapType == stressMapType) {
+        mapPath = stressMapPath;
+    }
+    
     if (std::filesystem::exists(mapPath)) {
-        std::cout << "[OK] Map file found: " << mapPath << std::endl;
+        LOG_INFO("[OK] Map file found: " << mapPath);
     } else {
-        std::cerr << "[ERROR] Map file NOT found: " << mapPath << std::endl;
-        std::cerr << "[ERROR] Full path would be: " 
-                  << std::filesystem::absolute(mapPath).string() << std::endl;
+        LOG_ERROR("[ERROR] Map file NOT found: " << mapPath);
+        LOG_ERROR("[ERROR] Full path would be: " 
+               << std::filesystem::absolute(mapPath).string());
         
         if (std::filesystem::exists("assets")) {
-            std::cout << "[DEBUG] Contents of 'assets' directory:" << std::endl;
+            LOG_DEBUG("[DEBUG] Contents of 'assets' directory:");
             for (const auto& entry : std::filesystem::recursive_directory_iterator("assets")) {
-                std::cout << "  " << entry.path().string() << std::endl;
+                LOG_INFO("  " << entry.path().string());
             }
         } else {
-            std::cerr << "[ERROR] 'assets' directory does not exist!" << std::endl;
+            LOG_ERROR("[ERROR] 'assets' directory does not exist!");
         }
     }
     
     tileMap->loadFromTiled(mapPath, 48);
+    flowFieldStaticDirty = true;
+}
+
+void GameState::updateFlowField() {
+    if (!flowField || !tileMap || !player) return;
+    
+    // 地图图块和地图对象：只在换地图后重建
+    // （要等各管理器从对象层接管树木、石头等之后，所以放到第一次更新时）
+    bool rebuildTrees = flowFieldStaticDirty;
+    if (flowFieldStaticDirty) {
+        flowField->reset(tileMap->getWidth(), tileMap->getHeight(),
+                         static_cast<float>(tileMap->getTileSize()));
+        for (int y = 0; y < tileMap->getHeight(); y++) {
+            for (int x = 0; x < tileMap->getWidth(); x++) {
+                if (tileMap->isTileBlocked(x, y)) {
+                    flowField->blockTile(x, y, ObstacleLayer::Static);
+                }
+            }
+        }
+        for (const auto& obj : tileMap->getObjects()) {
+            if (obj.gid <= 0) continue;
+            flowField->blockRect(tileMap->getObjectBounds(obj), ObstacleLayer::Static);
+        }
+        flowFieldStaticDirty = false;
+    }
+    
+    // 树木：增删、砍倒或重生时重建
+    if (treeManager && (rebuildTrees || treeManager->getLayoutVersion() != flowFieldTreeVersion)) {
+        flowField->clearLayer(ObstacleLayer::Dynamic);
+        for (const auto& tree : treeManager->getTrees()) {
+            if (!tree->isDead()) {
+                flowField->blockRect(tree->getCollisionBox(), ObstacleLayer::Dynamic);
+            }
+        }
+        flowFieldTreeVersion = treeManager->getLayoutVersion();
+    }
+    
+    // 玩家换了图块或障碍变了才重算
+    sf::FloatRect box = player->getCollisionBox();
+    flowField->update(sf::Vector2f(box.left + box.width / 2, box.top + box.height / 2));
+}
+
+// ============================================================================
+// 推挤碰撞：谁移动谁推开对方
+//
+// 玩家、当前宠物和所有兔子一起进宽阶段，一次得到全部重叠对，
+// 推挤量先累加、最后统一应用，结果与处理顺序无关：
+//   - 玩家移动时推开兔子；玩家站着时，主动移动的兔子推开玩家
+//   - 宠物推开兔子，兔子也轻微推回宠物
+//   - 兔子之间互相分开（各退一半）
+// ============================================================================
+void GameState::resolveDynamicCollisions(bool playerMoving) {
+    PROFILE_SCOPE("GameState::resolveDynamicCollisions");
+    if (!player) return;
+    
+    Pet* pet = petManager ? petManager->getCurrentPet() : nullptr;
+    
+    // id 即添加顺序：玩家 < 宠物 < 兔子，重叠对 (a, b) 中 a 的种类不大于 b
+    dynamicBroadphase.clear();
+    dynamicBodies.clear();
+    dynamicBroadphase.add(player->getCollisionBox());
+    dynamicBodies.push_back({DynamicBodyKind::Player, nullptr, playerMoving});
+    if (pet) {
+        dynamicBroadphase.add(pet->getCollisionBox());
+        dynamicBodies.push_back({DynamicBodyKind::Pet, nullptr, false});
+    }
+    if (rabbitManager) {
+        for (const auto& rabbit : rabbitManager->getRabbits()) {
+            if (rabbit->isDead()) continue;     // 尸体在本帧事件处理后移除
+            dynamicBroadphase.add(rabbit->getCollisionBox());
+            dynamicBodies.push_back({DynamicBodyKind::Rabbit, rabbit.get(), rabbit->isMoving()});
+        }
+    }
+    
+    dynamicPushes.assign(dynamicBodies.size(), sf::Vector2f(0, 0));
+    
+    for (const BroadphasePair& pair : dynamicBroadphase.findPairs()) {
+        const DynamicBody& a = dynamicBodies[pair.a];
+        const DynamicBody& b = dynamicBodies[pair.b];
+        const sf::FloatRect& boxA = dynamicBroadphase.getBox(pair.a);
+        const sf::FloatRect& boxB = dynamicBroadphase.getBox(pair.b);
+        
+        if (b.kind != DynamicBodyKind::Rabbit) continue;   // 玩家与宠物不互推
+        
+        switch (a.kind) {
+            case DynamicBodyKind::Player:
+                if (playerMoving) {
+                    dynamicPushes[pair.b] += CollisionSystem::calculatePushVector(boxA, boxB, PLAYER_PUSH_STRENGTH);
+                } else if (b.moving) {
+                    dynamicPushes[pair.a] += CollisionSystem::calculatePushVector(boxB, boxA, RABBIT_PUSH_STRENGTH);
+                }
+                break;
+                
+            case DynamicBodyKind::Pet: {
+                dynamicPushes[pair.b] += CollisionSystem::calculatePushVector(boxA, boxB, PET_PUSH_STRENGTH);
+                
+                // 兔子也推开宠物：沿兔子指向宠物的方向，推回最小重叠量的一半
+                sf::Vector2f petCenter(boxA.left + boxA.width / 2.0f, boxA.top + boxA.height / 2.0f);
+                sf::Vector2f rabbitCenter(boxB.left + boxB.width / 2.0f, boxB.top + boxB.height / 2.0f);
+                sf::Vector2f pushDir = petCenter - rabbitCenter;
+                float length = std::sqrt(pushDir.x * pushDir.x + pushDir.y * pushDir.y);
+                if (length > 0.001f) {
+                    float overlapX = (boxA.width + boxB.width) / 2.0f - std::abs(pushDir.x);
+                    float overlapY = (boxA.height + boxB.height) / 2.0f - std::abs(pushDir.y);
+                    dynamicPushes[pair.a] += pushDir / length * (std::min(overlapX, overlapY) * PET_PUSHBACK_RATIO);
+                }
+                break;
+            }
+                
+            case DynamicBodyKind::Rabbit: {
+                sf::Vector2f separation = CollisionSystem::calculateSeparationVector(boxA, boxB) * 0.5f;
+                dynamicPushes[pair.a] -= separation;
+                dynamicPushes[pair.b] += separation;
+                break;
+            }
+        }
+    }
+    
+    for (size_t i = 0; i < dynamicBodies.size(); i++) {
+        const sf::Vector2f& push = dynamicPushes[i];
+        if (push.x == 0 && push.y == 0) continue;
+        
+        switch (dynamicBodies[i].kind) {
+            case DynamicBodyKind::Player: {
+                // 被推时不能穿进墙和树
+                sf::Vector2f oldPos = player->getPosition();
+                player->applyPush(push);
+                sf::FloatRect box = player->getCollisionBox();
+                if (tileMap->isColliding(box) ||
+                    (treeManager && treeManager->isCollidingWithAnyTree(box))) {
+                    player->setPosition(oldPos);
+                }
+                // 推挤在移动阶段的边界限制之后执行，需要再限制一次
+                clampPlayerToMap();
+                break;
+            }
+            case DynamicBodyKind::Pet:
+                pet->setPosition(pet->getPosition() + push);
+                break;
+            case DynamicBodyKind::Rabbit:
+                dynamicBodies[i].rabbit->applyPush(push);
+                break;
+        }
+    }
+}
+
+void GameState::clampPlayerToMap() {
+    sf::Vector2f pos = player->getPosition();
+    sf::Vector2i mapSize = tileMap->getMapSize();
+    
+    float margin = (float)tileMap->getTileSize();
+    pos.x = std::max(margin, std::min(pos.x, mapSize.x - margin));
+    pos.y = std::max(margin, std::min(pos.y, mapSize.y - margin));
+    player->setPosition(pos);
 }
 
 void GameState::handleInput(const sf::Event& event) {
@@ -449,8 +668,22 @@ void GameState::handleInput(const sf::Event& event) {
                 switchMap(MapType::Forest);
                 break;
                 
+            case sf::Keyboard::F5:
+                if (!persistenceEnabled()) break;
+                saveGame(true);
+                if (eventLogPanel) {
+                    eventLogPanel->addMessage("游戏已保存", EventType::System);
+                }
+                break;
+                
+            case sf::Keyboard::F9:
+                if (persistenceEnabled() && loadGame() && eventLogPanel) {
+                    eventLogPanel->addMessage("已读取存档", EventType::System);
+                }
+                break;
+                
             case sf::Keyboard::F3: {
-                std::cout << "Reloading map..." << std::endl;
+                LOG_INFO("Reloading map...");
                 loadMap(currentMap);
                 sf::Vector2i mapSize = tileMap->getMapSize();
                 player->setPosition(mapSize.x / 2.0f, mapSize.y / 2.0f);
@@ -496,7 +729,7 @@ void GameState::handleInput(const sf::Event& event) {
                     if (eventLogPanel) {
                         eventLogPanel->addGoldObtained(100);
                     }
-                    std::cout << "[DEBUG] +100 Gold" << std::endl;
+                    LOG_DEBUG("[DEBUG] +100 Gold");
                 }
                 break;
                 
@@ -513,7 +746,7 @@ void GameState::handleInput(const sf::Event& event) {
                         eventLogPanel->addItemObtained("石头", 5, "stone");
                         eventLogPanel->addItemObtained("树枝", 10, "stick");
                     }
-                    std::cout << "[DEBUG] Added test items" << std::endl;
+                    LOG_DEBUG("[DEBUG] Added test items");
                 }
                 break;
                 
@@ -524,6 +757,8 @@ void GameState::handleInput(const sf::Event& event) {
 }
 
 void GameState::update(float dt) {
+    PROFILE_SCOPE("GameState::update");
+    
     // 检查任何面板是否打开
     bool anyPanelOpen = (categoryInventoryPanel && categoryInventoryPanel->isOpen()) ||
                         (equipmentPanel && equipmentPanel->isOpen()) ||
@@ -533,6 +768,7 @@ void GameState::update(float dt) {
     
     // 如果任何面板打开，更新面板但暂停游戏逻辑
     if (anyPanelOpen) {
+        PROFILE_SCOPE("UI::update");
         if (categoryInventoryPanel) categoryInventoryPanel->update(dt);
         if (equipmentPanel) equipmentPanel->update(dt);
         if (craftingPanel) craftingPanel->update(dt);
@@ -541,9 +777,14 @@ void GameState::update(float dt) {
         return;
     }
     
+    if (statModifiers) statModifiers->update(dt);
+    
+    bool playerWasMoving = false;   // 玩家是否在主动移动（推挤解算用）
+    
     if (player) {
+        PROFILE_SCOPE("Player::update");
         sf::Vector2f oldPos = player->getPosition();
-        bool playerWasMoving = player->isMoving();  // 记录玩家是否在主动移动
+        playerWasMoving = player->isMoving();
         
         player->update(dt);
         
@@ -557,62 +798,14 @@ void GameState::update(float dt) {
             player->setPosition(oldPos);
         }
         
-        // ====================================================
-        // 推挤碰撞处理：谁移动谁推开对方
-        // ====================================================
-        if (rabbitManager) {
-            sf::FloatRect playerBox = player->getCollisionBox();
-            
-            if (playerWasMoving) {
-                // 玩家主动移动 → 推开碰到的兔子
-                rabbitManager->pushRabbitsFromRect(playerBox, 1.0f);
-            } else {
-                // 玩家没有移动 → 检查是否有兔子主动撞过来
-                auto movingRabbits = rabbitManager->getMovingRabbitsCollidingWith(playerBox);
-                
-                for (Rabbit* rabbit : movingRabbits) {
-                    // 兔子主动移动碰到玩家 → 推开玩家
-                    sf::FloatRect rabbitBox = rabbit->getCollisionBox();
-                    
-                    sf::Vector2f playerCenter(
-                        playerBox.left + playerBox.width / 2.0f,
-                        playerBox.top + playerBox.height / 2.0f
-                    );
-                    sf::Vector2f rabbitCenter(
-                        rabbitBox.left + rabbitBox.width / 2.0f,
-                        rabbitBox.top + rabbitBox.height / 2.0f
-                    );
-                    
-                    // 推挤方向：从兔子指向玩家
-                    sf::Vector2f pushDir = playerCenter - rabbitCenter;
-                    float length = std::sqrt(pushDir.x * pushDir.x + pushDir.y * pushDir.y);
-                    
-                    if (length > 0.001f) {
-                        pushDir /= length;
-                        
-                        float overlapX = (playerBox.width + rabbitBox.width) / 2.0f - 
-                                        std::abs(playerCenter.x - rabbitCenter.x);
-                        float overlapY = (playerBox.height + rabbitBox.height) / 2.0f - 
-                                        std::abs(playerCenter.y - rabbitCenter.y);
-                        
-                        float pushDistance = std::min(overlapX, overlapY) + 2.0f;
-                        player->applyPush(pushDir * pushDistance);
-                    }
-                }
-            }
-        }
-        
         // Boundary detection
-        sf::Vector2f pos = player->getPosition();
-        sf::Vector2i mapSize = tileMap->getMapSize();
-        
-        float margin = (float)tileMap->getTileSize();
-        pos.x = std::max(margin, std::min(pos.x, mapSize.x - margin));
-        pos.y = std::max(margin, std::min(pos.y, mapSize.y - margin));
-        player->setPosition(pos);
+        clampPlayerToMap();
         
         // Handle attack - check for tree hits
-        handlePlayerAttack();
+        {
+            PROFILE_SCOPE("GameState::handlePlayerAttack");
+            handlePlayerAttack();
+        }
         
         // Handle item pickup
         handleItemPickup();
@@ -638,75 +831,60 @@ void GameState::update(float dt) {
         timeSystem->update(dt);
     }
     
+    // Autosave (snapshot on main thread, write on background thread)
+    autosaveTimer += dt;
+    if (autosaveTimer >= AUTOSAVE_INTERVAL) {
+        autosaveTimer = 0.0f;
+        if (persistenceEnabled()) {
+            saveGame(true);
+        }
+    }
+    
+    // Advance animated tiles (water etc.)
+    if (tileMap) {
+        PROFILE_SCOPE("TileMap::update");
+        tileMap->update(dt);
+    }
+    
     // Update trees
     if (treeManager) {
+        PROFILE_SCOPE("TreeManager::update");
         treeManager->update(dt);
     }
     
     // Update stone builds
     if (stoneBuildManager) {
+        PROFILE_SCOPE("StoneBuildManager::update");
         stoneBuildManager->update(dt);
     }
     
     // Update wild plants
     if (wildPlantManager) {
+        PROFILE_SCOPE("WildPlantManager::update");
         wildPlantManager->update(dt);
     }
     
     // Handle wild plant pickup (F key)
     handlePlantPickup();
     
+    // Update flow field (shared by chasing rabbits and the following pet)
+    {
+        PROFILE_SCOPE("FlowField::update");
+        updateFlowField();
+    }
+    
     // Update rabbits
     if (rabbitManager && player) {
+        PROFILE_SCOPE("RabbitManager::update");
         rabbitManager->update(dt, player->getPosition());
     }
     
     // Update pet system
     if (petManager && player) {
+        PROFILE_SCOPE("PetManager::update");
         bool playerAttacking = player->isAttacking();
         petManager->update(dt, player->getPosition(), playerAttacking);
         
-        // 宠物碰撞处理（与兔子的推挤碰撞）
-        Pet* pet = petManager->getCurrentPet();
-        if (pet && rabbitManager) {
-            sf::FloatRect petBox = pet->getCollisionBox();
-            
-            // 宠物推开兔子
-            rabbitManager->pushRabbitsFromRect(petBox, 0.8f);
-            
-            // 兔子也可能推开宠物（互相推挤）
-            auto collidingRabbits = rabbitManager->getRabbitsCollidingWith(petBox);
-            for (Rabbit* rabbit : collidingRabbits) {
-                sf::FloatRect rabbitBox = rabbit->getCollisionBox();
-                
-                sf::Vector2f petCenter(
-                    petBox.left + petBox.width / 2.0f,
-                    petBox.top + petBox.height / 2.0f
-                );
-                sf::Vector2f rabbitCenter(
-                    rabbitBox.left + rabbitBox.width / 2.0f,
-                    rabbitBox.top + rabbitBox.height / 2.0f
-                );
-                
-                // 推挤方向：从兔子指向宠物
-                sf::Vector2f pushDir = petCenter - rabbitCenter;
-                float length = std::sqrt(pushDir.x * pushDir.x + pushDir.y * pushDir.y);
-                
-                if (length > 0.001f) {
-                    pushDir /= length;
-                    
-                    float overlapX = (petBox.width + rabbitBox.width) / 2.0f - 
-                                    std::abs(petCenter.x - rabbitCenter.x);
-                    float overlapY = (petBox.height + rabbitBox.height) / 2.0f - 
-                                    std::abs(petCenter.y - rabbitCenter.y);
-                    
-                    float pushDistance = std::min(overlapX, overlapY) * 0.5f;
-                    sf::Vector2f newPos = pet->getPosition() + pushDir * pushDistance;
-                    pet->setPosition(newPos);
-                }
-            }
-        }
-        
         // 检查宠物物品掉落（如兔毛）
         std::string dropItem = petManager->checkPetItemDrop(dt);
         if (!dropItem.empty() && categoryInventory) {
@@ -714,18 +892,33 @@ void GameState::update(float dt) {
             if (added > 0 && eventLogPanel) {
                 const ItemData* data = ItemDatabase::getInstance().getItemData(dropItem);
                 if (data) {
-                    eventLogPanel->addItemObtained(data->name, 1, dropItem);
+                    eventLogPanel->addItemObtained(data->numericId, 1);
                 }
             }
         }
     }
     
+    // Push collisions among player, pet and rabbits (one broadphase pass)
+    resolveDynamicCollisions(playerWasMoving);
+    if (rabbitManager) {
+        // 推挤后兔子位置已定，本帧后续的范围查询复用这份中心
+        rabbitManager->refreshQueryCenters();
+    }
+    
+    // Handle queued entity events (tree drops/rewards, rabbit kills/attacks, inventory)
+    dispatchGameEvents();
+    if (rabbitManager) {
+        rabbitManager->removeDeadRabbits();
+    }
+    
     // Update dropped items
     if (droppedItemManager) {
+        PROFILE_SCOPE("DroppedItemManager::update");
         droppedItemManager->update(dt);
     }
     
     // Update UI
+    PROFILE_SCOPE("UI::update");
     if (statsPanel) {
         statsPanel->update(dt);
     }
@@ -750,6 +943,8 @@ void GameState::update(float dt) {
 }
 
 void GameState::render(sf::RenderWindow& window) {
+    PROFILE_SCOPE("GameState::render");
+    
     // Apply camera view
     if (camera) {
         window.setView(camera->getView());
@@ -757,41 +952,49 @@ void GameState::render(sf::RenderWindow& window) {
     
     // Render tile map
     if (tileMap && camera) {
+        PROFILE_SCOPE("TileMap::render");
         tileMap->render(window, camera->getView());
     }
     
     // Render dropped items (below trees)
     if (droppedItemManager && camera) {
+        PROFILE_SCOPE("DroppedItemManager::render");
         droppedItemManager->render(window, camera->getView());
     }
     
     // Render trees
     if (treeManager && camera) {
+        PROFILE_SCOPE("TreeManager::render");
         treeManager->render(window, camera->getView());
     }
     
     // Render stone builds
     if (stoneBuildManager && camera) {
+        PROFILE_SCOPE("StoneBuildManager::render");
         stoneBuildManager->render(window, camera->getView());
     }
     
     // Render wild plants
     if (wildPlantManager && camera) {
+        PROFILE_SCOPE("WildPlantManager::render");
         wildPlantManager->render(window, camera->getView());
     }
     
     // Render rabbits
     if (rabbitManager && camera) {
+        PROFILE_SCOPE("RabbitManager::render");
         rabbitManager->render(window, camera->getView());
     }
     
     // Render player
     if (player) {
+        PROFILE_SCOPE("Player::render");
         player->render(window);
     }
     
     // Render pet (follows player)
     if (petManager && camera) {
+        PROFILE_SCOPE("PetManager::render");
         petManager->render(window);
     }
     
@@ -808,7 +1011,8 @@ void GameState::render(sf::RenderWindow& window) {
                         (petPanel && petPanel->isOpen()) ||
                         (hatchPanel && hatchPanel->isOpen());
     if (camera && !anyPanelOpen) {
-        sf::Vector2i mouseScreenPos = sf::Mouse::getPosition(window);
+        PROFILE_SCOPE("GameState::renderTooltips");
+        sf::Vector2i mouseScreenPos = InputSystem::getInstance().getMousePosition();
         sf::Vector2f mouseWorldPos = window.mapPixelToCoords(mouseScreenPos, camera->getView());
         
         if (treeManager) {
@@ -827,53 +1031,64 @@ void GameState::render(sf::RenderWindow& window) {
 }
 
 void GameState::renderUI(sf::RenderWindow& window) {
+    PROFILE_SCOPE("GameState::renderUI");
+    
     // UI background panel (top-left info)
     sf::RectangleShape uiBackground(sf::Vector2f(300, 60));
     uiBackground.setPosition(20, 20);
     uiBackground.setFillColor(sf::Color(0, 0, 0, 150));
-    window.draw(uiBackground);
+    RenderStats::draw(window, uiBackground);
     
     // Render stats panel (bottom-left)
     if (statsPanel) {
+        PROFILE_SCOPE("StatsPanel::render");
         statsPanel->render(window);
     }
     
     // Render category inventory panel
     if (categoryInventoryPanel) {
+        PROFILE_SCOPE("CategoryInventoryPanel::render");
         categoryInventoryPanel->render(window);
     }
     
     // Render equipment panel
     if (equipmentPanel) {
+        PROFILE_SCOPE("EquipmentPanel::render");
         equipmentPanel->render(window);
     }
     
     // Render crafting panel
     if (craftingPanel) {
+        PROFILE_SCOPE("CraftingPanel::render");
         craftingPanel->render(window);
     }
     
     // Render event log panel (top-right)
     if (eventLogPanel) {
+        PROFILE_SCOPE("EventLogPanel::render");
         eventLogPanel->render(window);
     }
     
     // Render pet panel
     if (petPanel) {
+        PROFILE_SCOPE("PetPanel::render");
         petPanel->render(window);
     }
     
     // Render hatch panel
     if (hatchPanel) {
+        PROFILE_SCOPE("HatchPanel::render");
         hatchPanel->render(window);
     }
 }
 
 void GameState::switchMap(MapType newMap) {
+    PROFILE_SCOPE("GameState::switchMap");
+    
     if (newMap != currentMap) {
-        std::cout << "\n------------------------------------" << std::endl;
-        std::cout << "Switching Map: " << getMapName(currentMap) 
-                  << " -> " << getMapName(newMap) << std::endl;
+        LOG_INFO("\n------------------------------------");
+        LOG_INFO("Switching Map: " << getMapName(currentMap) 
+              << " -> " << getMapName(newMap));
         
         currentMap = newMap;
         loadMap(newMap);
@@ -915,8 +1130,8 @@ void GameState::switchMap(MapType newMap) {
             camera->snapTo(player->getPosition());
         }
         
-        std::cout << "[OK] Map switch complete" << std::endl;
-        std::cout << "------------------------------------\n" << std::endl;
+        LOG_INFO("[OK] Map switch complete");
+        LOG_INFO("------------------------------------\n");
         
         // 添加地图切换提示到事件日志
         if (eventLogPanel) {
@@ -927,12 +1142,14 @@ void GameState::switchMap(MapType newMap) {
 }
 
 void GameState::initTrees() {
+    PROFILE_SCOPE("GameState::initTrees");
+    
     if (!treeManager || !tileMap) return;
     
     const auto& objects = tileMap->getObjects();
     float displayScale = (float)tileMap->getTileSize() / 32.0f;
     
-    std::cout << "[Trees] Loading trees from " << objects.size() << " map objects..." << std::endl;
+    LOG_INFO("[Trees] Loading trees from " << objects.size() << " map objects...");
     
     for (const auto& obj : objects) {
         if (obj.gid <= 0) continue;
@@ -955,8 +1172,8 @@ void GameState::initTrees() {
         }
         
         if (!isTree) {
-            std::cout << "[Objects] Skipping non-tree object: " << objName 
-                      << " (type=" << objType << ")" << std::endl;
+            LOG_DEBUG("[Objects] Skipping non-tree object: " << objName 
+                  << " (type=" << objType << ")");
             continue;
         }
         
@@ -969,12 +1186,12 @@ void GameState::initTrees() {
         
         if (obj.tileProperty) {
             tree = treeManager->addTreeFromProperty(x, y, obj.tileProperty);
-            std::cout << "[Trees] Created from TileProperty: " << obj.tileProperty->name 
-                      << " HP=" << obj.tileProperty->hp << std::endl;
+            LOG_DEBUG("[Trees] Created from TileProperty: " << obj.tileProperty->name 
+                  << " HP=" << obj.tileProperty->hp);
         } else {
             std::string treeType = obj.name.empty() ? "tree1" : obj.name;
             tree = treeManager->addTree(x, y, treeType);
-            std::cout << "[Trees] Created from name: " << treeType << std::endl;
+            LOG_DEBUG("[Trees] Created from name: " << treeType);
         }
         
         if (tree) {
@@ -985,202 +1202,40 @@ void GameState::initTrees() {
             // if (tree->getTreeType() == "tree1") {
             //     tree->setCanTransform(true);
             // }
-            
-            // ========================================
-            // 设置销毁回调 - 生成掉落物品和奖励
-            // ========================================
-            tree->setOnDestroyed([this](Tree& t) {
-                // 使用递减概率计算掉落
-                auto drops = t.generateDrops();
-                
-                if (!drops.empty() && droppedItemManager) {
-                    sf::Vector2f treePos = t.getPosition();
-                    // 在树的位置生成掉落物品
-                    droppedItemManager->spawnItems(drops, treePos.x, treePos.y - 20);
-                    
-                    // 添加掉落物品到事件日志
-                    if (eventLogPanel) {
-                        for (const auto& drop : drops) {
-                            const ItemData* data = ItemDatabase::getInstance().getItemData(drop.first);
-                            if (data) {
-                                eventLogPanel->addItemObtained(data->name, drop.second, drop.first);
-                            }
-                        }
-                    }
-                }
-                
-                // 添加经验和金币奖励（从 tsx 配置读取）
-                if (player) {
-                    int exp = t.getExpReward();
-                    int gold = t.getGoldReward();
-                    
-                    // 检查是否升级
-                    int oldLevel = player->getStats().getLevel();
-                    player->getStats().addExp(exp);
-                    int newLevel = player->getStats().getLevel();
-                    
-                    player->getStats().addGold(gold);
-                    player->getStats().addSkillExp(LifeSkill::Farming, exp / 2);
-                    
-                    // 添加到事件日志
-                    if (eventLogPanel) {
-                        eventLogPanel->addTreeChopped(t.getName());
-                        if (exp > 0) {
-                            eventLogPanel->addExpObtained(exp, "砍伐");
-                        }
-                        if (gold > 0) {
-                            eventLogPanel->addGoldObtained(gold);
-                        }
-                        if (newLevel > oldLevel) {
-                            eventLogPanel->addLevelUp(newLevel);
-                        }
-                    }
-                    
-                    std::cout << "[Reward] +" << exp << " EXP, +" << gold << " Gold" << std::endl;
-                }
-            });
-            
-            // ========================================
-            // 设置果实采摘回调 - 生成果实掉落
-            // ========================================
-            tree->setOnFruitHarvested([this](Tree& t) {
-                auto drops = t.generateFruitDrops();
-                
-                if (!drops.empty() && droppedItemManager) {
-                    sf::Vector2f treePos = t.getPosition();
-                    droppedItemManager->spawnItems(drops, treePos.x, treePos.y - 20);
-                    
-                    // 添加到事件日志
-                    if (eventLogPanel) {
-                        for (const auto& drop : drops) {
-                            const ItemData* data = ItemDatabase::getInstance().getItemData(drop.first);
-                            if (data) {
-                                eventLogPanel->addFruitHarvested(data->name, drop.second);
-                            }
-                        }
-                    }
-                }
-                
-                if (player) {
-                    int exp = t.getExpReward() / 2;  // 采摘经验减半
-                    int oldLevel = player->getStats().getLevel();
-                    player->getStats().addExp(exp);
-                    int newLevel = player->getStats().getLevel();
-                    
-                    if (eventLogPanel && exp > 0) {
-                        eventLogPanel->addExpObtained(exp, "采摘");
-                        if (newLevel > oldLevel) {
-                            eventLogPanel->addLevelUp(newLevel);
-                        }
-                    }
-                }
-            });
-            
-            tree->setOnGrowthStageChanged([this](Tree& t) {
-                std::cout << "[Tree] " << t.getName() << " changed to: " 
-                          << t.getGrowthStageName() << std::endl;
-                
-                // 如果树木成熟，添加事件日志
-                if (eventLogPanel && t.getGrowthStageName() == "Mature") {
-                    eventLogPanel->addTreeMature(t.getName());
-                }
-            });
         }
     }
     
     tileMap->removeTreeObjects();
     
-    std::cout << "[Trees] Total trees loaded: " << treeManager->getTreeCount() << std::endl;
+    LOG_INFO("[Trees] Total trees loaded: " << treeManager->getTreeCount());
 }
 
 void GameState::initRabbits() {
+    PROFILE_SCOPE("GameState::initRabbits");
+    
     if (!rabbitManager || !tileMap) return;
     
-    // 在当前地图随机生成20只兔子
+    // 在当前地图随机生成兔子（默认 20 只，压力测试场景按配置）
     sf::Vector2i mapSize = tileMap->getMapSize();
     int tileSize = tileMap->getTileSize();
     
-    rabbitManager->spawnRandomRabbits(20, mapSize, tileSize);
+    rabbitManager->spawnRandomRabbits(rabbitSpawnCount, mapSize, tileSize);
     
-    // 设置兔子攻击玩家的回调
-    for (auto& rabbit : rabbitManager->getRabbits()) {
-        rabbit->setOnAttackRabbit([this](Rabbit& r){
-            if (!player) return;
-            
-            float damage = r.performAttack();
-            bool usedSkill = r.hasTriggeredSkill();
-            
-            // 玩家闪避判定
-            if (player->getStats().rollDodge(0)) {
-                if (eventLogPanel) {
-                    eventLogPanel->addMessage("闪避了 " + r.getName() + " 的攻击!", EventType::Combat);
-                }
-                std::cout << "[Combat] Player dodged rabbit attack!" << std::endl;
-                return;
-            }
-            
-            // 计算实际伤害
-            float actualDamage = player->getStats().calculateDamageTaken(damage);
-            
-            // 获取兔子位置用于击退计算
-            sf::Vector2f rabbitPos = r.getPosition();
-            sf::FloatRect rabbitBounds = r.getBounds();
-            sf::Vector2f rabbitCenter(rabbitPos.x + rabbitBounds.width / 2.0f, 
-                                      rabbitPos.y + rabbitBounds.height / 2.0f);
-            
-            // 受伤并击退（传入攻击者位置）
-            player->receiveDamage(actualDamage, rabbitCenter);
-            
-            if (eventLogPanel) {
-                std::string attackMsg;
-                if (usedSkill) {
-                    const RabbitSkill& skill = r.getRabbitSkill();
-                    attackMsg = r.getName() + " 使用了 [" + skill.name + "]! -" + 
-                               std::to_string(static_cast<int>(actualDamage)) + " HP";
-                } else {
-                    attackMsg = r.getName() + " 攻击了你! -" + 
-                               std::to_string(static_cast<int>(actualDamage)) + " HP";
-                }
-                eventLogPanel->addMessage(attackMsg, EventType::Combat);
-            }
-            
-            std::cout << "[Combat] Rabbit attacked player for " << actualDamage << " damage"
-                      << (usedSkill ? " (SKILL!)" : "") << std::endl;
-            
-            // 宠物帮忙反击
-            if (petManager) {
-                Pet* pet = petManager->getCurrentPet();
-                if (pet && !pet->isDead()) {
-                    // 设置攻击目标为攻击玩家的兔子
-                    pet->setAttackTarget(rabbitPos);
-                    
-                    if (eventLogPanel) {
-                        eventLogPanel->addMessage(pet->getName() + " 帮你反击!", EventType::Combat);
-                    }
-                }
-            }
-            
-            if (player->isDead()) {
-                if (eventLogPanel) {
-                    eventLogPanel->addMessage("你被击败了...", EventType::Combat);
-                }
-            }
-        });
-    }
-    
-    std::cout << "[Rabbits] Spawned " << rabbitManager->getRabbitCount() << " rabbits" << std::endl;
+    LOG_INFO("[Rabbits] Spawned " << rabbitManager->getRabbitCount() << " rabbits");
 }
 
 // ============================================================================
 // 初始化石头建筑
 // ============================================================================
 void GameState::initStoneBuilds() {
+    PROFILE_SCOPE("GameState::initStoneBuilds");
+    
     if (!stoneBuildManager || !tileMap) return;
     
     const auto& objects = tileMap->getObjects();
     float displayScale = (float)tileMap->getTileSize() / 32.0f;
     
-    std::cout << "[StoneBuilds] Loading stone builds from " << objects.size() << " map objects..." << std::endl;
+    LOG_INFO("[StoneBuilds] Loading stone builds from " << objects.size() << " map objects...");
     
     int stoneCount = 0;
     for (const auto& obj : objects) {
@@ -1207,25 +1262,27 @@ void GameState::initStoneBuilds() {
             stone->setSize(width, height);
             stoneCount++;
             
-            std::cout << "[StoneBuilds] Created: " << obj.tileProperty->name 
-                      << " HP=" << obj.tileProperty->hp 
-                      << " DEF=" << obj.tileProperty->defense << std::endl;
+            LOG_DEBUG("[StoneBuilds] Created: " << obj.tileProperty->name 
+                  << " HP=" << obj.tileProperty->hp 
+                  << " DEF=" << obj.tileProperty->defense);
         }
     }
     
-    std::cout << "[StoneBuilds] Loaded " << stoneCount << " stone builds" << std::endl;
+    LOG_INFO("[StoneBuilds] Loaded " << stoneCount << " stone builds");
 }
 
 // ============================================================================
 // 初始化野生植物
 // ============================================================================
 void GameState::initWildPlants() {
+    PROFILE_SCOPE("GameState::initWildPlants");
+    
     if (!wildPlantManager || !tileMap) return;
     
     const auto& objects = tileMap->getObjects();
     float displayScale = (float)tileMap->getTileSize() / 32.0f;
     
-    std::cout << "[WildPlants] Loading wild plants from " << objects.size() << " map objects..." << std::endl;
+    LOG_INFO("[WildPlants] Loading wild plants from " << objects.size() << " map objects...");
     
     int plantCount = 0;
     for (const auto& obj : objects) {
@@ -1253,13 +1310,13 @@ void GameState::initWildPlants() {
             plant->setSize(width, height);
             plantCount++;
             
-            std::cout << "[WildPlants] Created: " << obj.tileProperty->name 
-                      << " pickup=" << (obj.tileProperty->allowPickup ? "yes" : "no")
-                      << " item=" << obj.tileProperty->pickupObject << std::endl;
+            LOG_DEBUG("[WildPlants] Created: " << obj.tileProperty->name 
+                  << " pickup=" << (obj.tileProperty->allowPickup ? "yes" : "no")
+                  << " item=" << obj.tileProperty->pickupObject);
         }
     }
     
-    std::cout << "[WildPlants] Loaded " << plantCount << " wild plants" << std::endl;
+    LOG_INFO("[WildPlants] Loaded " << plantCount << " wild plants");
 }
 
 // ============================================================================
@@ -1269,22 +1326,22 @@ void GameState::handlePlantPickup() {
     if (!player || !wildPlantManager) return;
     
     // 检查 V 键按下
-    bool pickupPressed = sf::Keyboard::isKeyPressed(sf::Keyboard::V);
+    bool pickupPressed = InputSystem::getInstance().isDown(InputAction::Pickup);
     
     if (pickupPressed && !pickupKeyPressed) {
         // V 键刚按下
         sf::Vector2f playerPos = player->getPosition();
         
-        std::cout << "[DEBUG] V key pressed, player at (" << playerPos.x << ", " << playerPos.y << ")" << std::endl;
-        std::cout << "[DEBUG] Plant count: " << wildPlantManager->getPlantCount() << std::endl;
+        LOG_DEBUG("[DEBUG] V key pressed, player at (" << playerPos.x << ", " << playerPos.y << ")");
+        LOG_DEBUG("[DEBUG] Plant count: " << wildPlantManager->getPlantCount());
         
         // 查找范围内可拾取的植物
         WildPlant* plant = wildPlantManager->getPickablePlantInRange(
             playerPos, PLANT_PICKUP_RANGE);
         
         if (plant) {
-            std::cout << "[DEBUG] Found plant: " << plant->getName() << " at (" 
-                      << plant->getPosition().x << ", " << plant->getPosition().y << ")" << std::endl;
+            LOG_DEBUG("[DEBUG] Found plant: " << plant->getName() << " at (" 
+                   << plant->getPosition().x << ", " << plant->getPosition().y << ")");
             
             // 播放拾取动画
             player->startPickup();
@@ -1292,22 +1349,22 @@ void GameState::handlePlantPickup() {
             // 执行拾取
             auto drops = wildPlantManager->pickupPlant(plant);
             
-            std::cout << "[DEBUG] Plant pickup drops count: " << drops.size() << std::endl;
+            LOG_DEBUG("[DEBUG] Plant pickup drops count: " << drops.size());
             
             // 添加物品到背包
             for (const auto& drop : drops) {
-                std::cout << "[DEBUG] Trying to add item: '" << drop.first << "' x" << drop.second << std::endl;
+                LOG_DEBUG("[DEBUG] Trying to add item: '" << drop.first << "' x" << drop.second);
                 
                 if (categoryInventory) {
                     int added = categoryInventory->addItem(drop.first, drop.second);
                     
-                    std::cout << "[DEBUG] Actually added: " << added << std::endl;
+                    LOG_DEBUG("[DEBUG] Actually added: " << added);
                     
                     // 记录到事件日志
                     if (added > 0 && eventLogPanel) {
                         const ItemData* data = ItemDatabase::getInstance().getItemData(drop.first);
                         if (data) {
-                            eventLogPanel->addItemObtained(data->name, added, drop.first);
+                            eventLogPanel->addItemObtained(data->numericId, added);
                         }
                     }
                     
@@ -1315,13 +1372,13 @@ void GameState::handlePlantPickup() {
                         eventLogPanel->addWarning("背包已满!");
                     }
                 } else {
-                    std::cout << "[DEBUG] categoryInventory is NULL!" << std::endl;
+                    LOG_DEBUG("[DEBUG] categoryInventory is NULL!");
                 }
                 
-                std::cout << "[Pickup] 获得 " << drop.first << " x" << drop.second << std::endl;
+                LOG_DEBUG("[Pickup] 获得 " << drop.first << " x" << drop.second);
             }
         } else {
-            std::cout << "[DEBUG] No pickable plant found in range " << PLANT_PICKUP_RANGE << std::endl;
+            LOG_DEBUG("[DEBUG] No pickable plant found in range " << PLANT_PICKUP_RANGE);
         }
     }
     
@@ -1352,8 +1409,8 @@ void GameState::handlePlayerAttack() {
             auto hitTrees = treeManager->damageTreesInRange(attackCenter, attackRadius, damage);
             
             if (!hitTrees.empty()) {
-                std::cout << "[Attack] Hit " << hitTrees.size() << " tree(s) for " 
-                          << damage << " damage" << (ignoreDefense ? " (ignore defense)" : "") << std::endl;
+                LOG_DEBUG("[Attack] Hit " << hitTrees.size() << " tree(s) for " 
+                      << damage << " damage" << (ignoreDefense ? " (ignore defense)" : ""));
             }
         }
         
@@ -1376,7 +1433,7 @@ void GameState::handlePlayerAttack() {
                             for (const auto& drop : drops) {
                                 const ItemData* data = ItemDatabase::getInstance().getItemData(drop.first);
                                 if (data) {
-                                    eventLogPanel->addItemObtained(data->name, drop.second, drop.first);
+                                    eventLogPanel->addItemObtained(data->numericId, drop.second);
                                 }
                             }
                         }
@@ -1397,63 +1454,24 @@ void GameState::handlePlayerAttack() {
                         if (newLevel > oldLevel) eventLogPanel->addLevelUp(newLevel);
                     }
                     
-                    std::cout << "[Stone] Destroyed! +" << exp << " EXP, +" << gold << " Gold" << std::endl;
+                    LOG_DEBUG("[Stone] Destroyed! +" << exp << " EXP, +" << gold << " Gold");
                 }
             }
             
             if (!hitStones.empty()) {
-                std::cout << "[Attack] Hit " << hitStones.size() << " stone(s) for " 
-                          << damage << " damage" << std::endl;
+                LOG_DEBUG("[Attack] Hit " << hitStones.size() << " stone(s) for " 
+                      << damage << " damage");
             }
         }
         
         // 攻击兔子
         if (rabbitManager) {
+            // 击杀的掉落和奖励由 RabbitKilledEvent 在事件阶段结算
             auto hitRabbits = rabbitManager->damageRabbitsInRange(attackCenter, attackRadius, damage, ignoreDefense);
             
-            for (auto* rabbit : hitRabbits) {
-                if (rabbit->isDead()) {
-                    // 兔子死亡，生成掉落物
-                    auto drops = rabbit->generateDrops();
-                    
-                    if (!drops.empty() && droppedItemManager) {
-                        sf::Vector2f rabbitPos = rabbit->getPosition();
-                        droppedItemManager->spawnItems(drops, rabbitPos.x, rabbitPos.y);
-                        
-                        // 添加到事件日志
-                        if (eventLogPanel) {
-                            eventLogPanel->addMessage("击杀了 " + rabbit->getName(), EventType::Combat);
-                            for (const auto& drop : drops) {
-                                const ItemData* data = ItemDatabase::getInstance().getItemData(drop.first);
-                                if (data) {
-                                    eventLogPanel->addItemObtained(data->name, drop.second, drop.first);
-                                }
-                            }
-                        }
-                    }
-                    
-                    // 获得经验和金币
-                    int exp = rabbit->getExpReward();
-                    int gold = rabbit->getGoldReward();
-                    
-                    int oldLevel = player->getStats().getLevel();
-                    player->getStats().addExp(exp);
-                    int newLevel = player->getStats().getLevel();
-                    player->getStats().addGold(gold);
-                    
-                    if (eventLogPanel) {
-                        if (exp > 0) eventLogPanel->addExpObtained(exp, "击杀");
-                        if (gold > 0) eventLogPanel->addGoldObtained(gold);
-                        if (newLevel > oldLevel) eventLogPanel->addLevelUp(newLevel);
-                    }
-                    
-                    std::cout << "[Rabbit] Killed! +" << exp << " EXP, +" << gold << " Gold" << std::endl;
-                }
-            }
-            
             if (!hitRabbits.empty()) {
-                std::cout << "[Attack] Hit " << hitRabbits.size() << " rabbit(s) for " 
-                          << damage << " damage" << std::endl;
+                LOG_DEBUG("[Attack] Hit " << hitRabbits.size() << " rabbit(s) for " 
+                      << damage << " damage");
             }
         }
         
@@ -1466,53 +1484,12 @@ void GameState::handlePlayerAttack() {
                 float petAttackRange = pet->getAttackRange();
                 
                 // 宠物攻击范围内的兔子
-                auto petHitRabbits = rabbitManager->damageRabbitsInRange(petPos, petAttackRange, petDamage, false);
-                
-                for (auto* rabbit : petHitRabbits) {
-                    if (rabbit->isDead()) {
-                        // 兔子死亡，生成掉落物
-                        auto drops = rabbit->generateDrops();
-                        
-                        if (!drops.empty() && droppedItemManager) {
-                            sf::Vector2f rabbitPos = rabbit->getPosition();
-                            droppedItemManager->spawnItems(drops, rabbitPos.x, rabbitPos.y);
-                            
-                            if (eventLogPanel) {
-                                eventLogPanel->addMessage(pet->getName() + " 击杀了 " + rabbit->getName(), EventType::Combat);
-                                for (const auto& drop : drops) {
-                                    const ItemData* data = ItemDatabase::getInstance().getItemData(drop.first);
-                                    if (data) {
-                                        eventLogPanel->addItemObtained(data->name, drop.second, drop.first);
-                                    }
-                                }
-                            }
-                        }
-                        
-                        // 获得经验和金币（宠物击杀也有奖励）
-                        int exp = rabbit->getExpReward();
-                        int gold = rabbit->getGoldReward();
-                        
-                        int oldLevel = player->getStats().getLevel();
-                        player->getStats().addExp(exp);
-                        int newLevel = player->getStats().getLevel();
-                        player->getStats().addGold(gold);
-                        
-                        // 宠物也获得经验
-                        pet->addExp(exp / 2);
-                        
-                        if (eventLogPanel) {
-                            if (exp > 0) eventLogPanel->addExpObtained(exp, "宠物击杀");
-                            if (gold > 0) eventLogPanel->addGoldObtained(gold);
-                            if (newLevel > oldLevel) eventLogPanel->addLevelUp(newLevel);
-                        }
-                        
-                        std::cout << "[Pet Attack] " << pet->getName() << " killed rabbit! +" << exp << " EXP" << std::endl;
-                    }
-                }
+                auto petHitRabbits = rabbitManager->damageRabbitsInRange(petPos, petAttackRange, petDamage,
+                                                                         false, KillSource::Pet);
                 
                 if (!petHitRabbits.empty()) {
-                    std::cout << "[Pet Attack] " << pet->getName() << " hit " << petHitRabbits.size() 
-                              << " rabbit(s) for " << petDamage << " damage" << std::endl;
+                    LOG_DEBUG("[Pet Attack] " << pet->getName() << " hit " << petHitRabbits.size() 
+                          << " rabbit(s) for " << petDamage << " damage");
                 }
                 
                 pet->clearJustAttacked();
@@ -1545,7 +1522,7 @@ bool GameState::onUseItem(const ItemStack& item, const ItemData* data) {
                 if (eventLogPanel) {
                     eventLogPanel->addMessage("恢复 " + std::to_string((int)effect.value) + " 生命值", EventType::System);
                 }
-                std::cout << "[Effect] Restored " << effect.value << " HP" << std::endl;
+                LOG_INFO("[Effect] Restored " << effect.value << " HP");
                 break;
                 
             case EffectType::RestoreStamina:
@@ -1553,16 +1530,39 @@ bool GameState::onUseItem(const ItemStack& item, const ItemData* data) {
                 if (eventLogPanel) {
                     eventLogPanel->addMessage("恢复 " + std::to_string((int)effect.value) + " 体力", EventType::System);
                 }
-                std::cout << "[Effect] Restored " << effect.value << " Stamina" << std::endl;
+                LOG_INFO("[Effect] Restored " << effect.value << " Stamina");
                 break;
                 
             case EffectType::BuffAttack:
-                // TODO: 实现增益效果
+            case EffectType::BuffDefense:
+            case EffectType::BuffSpeed: {
+                // 同类 Buff 重复使用时刷新持续时间，不叠加
+                StatModifier modifier;
+                std::string buffId;
+                std::string buffName;
+                if (effect.type == EffectType::BuffAttack) {
+                    modifier.attack = effect.value;
+                    buffId = "buff_attack";
+                    buffName = "攻击力";
+                } else if (effect.type == EffectType::BuffDefense) {
+                    modifier.defense = effect.value;
+                    buffId = "buff_defense";
+                    buffName = "防御力";
+                } else {
+                    modifier.speed = effect.value;
+                    buffId = "buff_speed";
+                    buffName = "移动速度";
+                }
+                float duration = effect.duration > 0 ? effect.duration : DEFAULT_BUFF_DURATION;
+                if (statModifiers) {
+                    statModifiers->addBuff(buffId, modifier, duration);
+                }
                 if (eventLogPanel) {
-                    eventLogPanel->addMessage("攻击力提升 +" + std::to_string((int)effect.value), EventType::Combat);
+                    eventLogPanel->addMessage(buffName + "提升 +" + std::to_string((int)effect.value), EventType::Combat);
                 }
-                std::cout << "[Effect] Attack buff +" << effect.value << std::endl;
+                LOG_INFO("[Effect] Buff +" << effect.value << " for " << duration << "s");
                 break;
+            }
                 
             default:
                 break;
@@ -1580,6 +1580,54 @@ std::string GameState::getMapName(MapType mapType) const {
     }
 }
 
+// ============================================================================
+// 状态哈希（FNV-1a，用于对比不同版本的回放结果）
+// ============================================================================
+std::uint64_t GameState::computeStateHash() const {
+    std::uint64_t hash = 1469598103934665603ULL;
+    auto mix = [&hash](std::uint64_t value) {
+        for (int i = 0; i < 8; i++) {
+            hash ^= (value >> (i * 8)) & 0xFF;
+            hash *= 1099511628211ULL;
+        }
+    };
+    auto mixFloat = [&mix](float value) {
+        std::uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        mix(bits);
+    };
+    
+    mix(static_cast<std::uint64_t>(currentMap));
+    
+    if (player) {
+        const PlayerStats& stats = player->getStats();
+        mixFloat(player->getPosition().x);
+        mixFloat(player->getPosition().y);
+        mixFloat(stats.getHealth());
+        mixFloat(stats.getStamina());
+        mix(static_cast<std::uint64_t>(stats.getLevel()));
+        mix(static_cast<std::uint64_t>(stats.getExp()));
+        mix(static_cast<std::uint64_t>(stats.getGold()));
+    }
+    
+    if (rabbitManager) {
+        mix(rabbitManager->getRabbitCount());
+        for (const auto& rabbit : rabbitManager->getRabbits()) {
+            mixFloat(rabbit->getPosition().x);
+            mixFloat(rabbit->getPosition().y);
+            mixFloat(rabbit->getHealth());
+        }
+    }
+    
+    if (treeManager) mix(treeManager->getTreeCount());
+    if (stoneBuildManager) mix(stoneBuildManager->getStoneCount());
+    if (wildPlantManager) mix(wildPlantManager->getPlantCount());
+    if (droppedItemManager) mix(droppedItemManager->getDroppedItemCount());
+    if (petManager) mix(petManager->getPetCount());
+    
+    return hash;
+}
+
 // ============================================================================
 // 卖出物品回调
 // ============================================================================
@@ -1597,8 +1645,8 @@ void GameState::onSellItem(const ItemStack& item, int sellPrice) {
         eventLogPanel->addGoldObtained(sellPrice);
     }
     
-    std::cout << "[Sell] Sold " << item.itemId << " x" << item.count 
-              << " for " << sellPrice << " gold" << std::endl;
+    LOG_INFO("[Sell] Sold " << item.getStringId() << " x" << item.count 
+          << " for " << sellPrice << " gold");
 }
 
 // ============================================================================
@@ -1613,8 +1661,9 @@ bool GameState::onPlantSeed(const ItemStack& seed) {
     // TODO: 更复杂的地形检测
     
     // 随机选择树木类型
-    std::uniform_int_distribution<int> dist(0, availableTreeTypes.size() - 1);
-    std::string treeType = availableTreeTypes[dist(rng)];
+    Rng& rng = RandomService::getInstance().stream(RngStream::Planting);
+    int typeIndex = rng.range(0, static_cast<int>(availableTreeTypes.size()) - 1);
+    std::string treeType = availableTreeTypes[typeIndex];
     
     // 在玩家前方种植
     float plantX = playerPos.x + 50;
@@ -1626,73 +1675,365 @@ bool GameState::onPlantSeed(const ItemStack& seed) {
     if (newTree) {
         newTree->setSize(64, 64);
         
-        // 设置销毁回调
-        newTree->setOnDestroyed([this](Tree& t) {
-            auto drops = t.generateDrops();
-            
-            if (!drops.empty() && droppedItemManager) {
-                sf::Vector2f treePos = t.getPosition();
-                droppedItemManager->spawnItems(drops, treePos.x, treePos.y - 20);
-                
-                if (eventLogPanel) {
-                    for (const auto& drop : drops) {
-                        const ItemData* data = ItemDatabase::getInstance().getItemData(drop.first);
-                        if (data) {
-                            eventLogPanel->addItemObtained(data->name, drop.second, drop.first);
-                        }
-                    }
-                }
-            }
-            
-            if (player) {
-                int exp = t.getExpReward();
-                int gold = t.getGoldReward();
-                
-                int oldLevel = player->getStats().getLevel();
-                player->getStats().addExp(exp);
-                int newLevel = player->getStats().getLevel();
-                
-                player->getStats().addGold(gold);
-                
-                if (eventLogPanel) {
-                    eventLogPanel->addTreeChopped(t.getName());
-                    if (exp > 0) eventLogPanel->addExpObtained(exp, "砍伐");
-                    if (gold > 0) eventLogPanel->addGoldObtained(gold);
-                    if (newLevel > oldLevel) eventLogPanel->addLevelUp(newLevel);
+        // 设置销毁/采摘回调
+        setupPlantedTree(newTree);
+        
+        if (eventLogPanel) {
+            eventLogPanel->addMessage("种下了种子，长出了 " + newTree->getName(), EventType::System);
+        }
+        
+        LOG_INFO("[Plant] Planted seed, grew into " << treeType << " at (" 
+              << plantX << ", " << plantY << ")");
+        
+        return true;
+    }
+    
+    return false;
+}
+
+// ============================================================================
+// 存档：拷贝世界快照 / 恢复世界快照
+// ============================================================================
+WorldSnapshot GameState::captureSnapshot() const {
+    WorldSnapshot snapshot;
+    snapshot.worldSeed = RandomService::getInstance().getWorldSeed();
+    snapshot.mapType = static_cast<int>(currentMap);
+    
+    if (player) {
+        snapshot.playerPosition = player->getPosition();
+        snapshot.playerStats = player->getStats().captureSaveData();
+    }
+    if (categoryInventory) snapshot.inventory = categoryInventory->captureSaveData();
+    if (playerEquipment) snapshot.equipment = playerEquipment->getEquippedItems();
+    if (droppedItemManager) snapshot.droppedItems = droppedItemManager->captureSaveData();
+    if (petManager) snapshot.pets = petManager->captureSaveData();
+    if (treeManager) snapshot.trees = treeManager->captureSaveData();
+    
+    return snapshot;
+}
+
+void GameState::applySnapshot(const WorldSnapshot& snapshot) {
+    // 存档在另一张地图时先切换（只有这种情况才会重新加载地图）
+    MapType savedMap = static_cast<MapType>(snapshot.mapType);
+    if (savedMap != currentMap) {
+        switchMap(savedMap);
+    }
+    
+    if (player) {
+        player->getStats().applySaveData(snapshot.playerStats);
+        player->setPosition(snapshot.playerPosition);
+        if (camera) camera->snapTo(player->getPosition());
+    }
+    if (categoryInventory) categoryInventory->applySaveData(snapshot.inventory);
+    if (playerEquipment) playerEquipment->restoreEquippedItems(snapshot.equipment);
+    if (droppedItemManager) droppedItemManager->applySaveData(snapshot.droppedItems);
+    if (petManager) petManager->applySaveData(snapshot.pets);
+    
+    // 加成由装备/宠物重新推导（限时 Buff 不存档）
+    if (statModifiers) statModifiers->clearBuffs();
+    refreshEquipmentModifiers();
+    refreshPetModifiers();
+    
+    if (treeManager) {
+        for (Tree* tree : treeManager->applySaveData(snapshot.trees)) {
+            setupPlantedTree(tree);
+        }
+    }
+}
+
+void GameState::saveGame(bool async) {
+    PROFILE_SCOPE("GameState::saveGame");
+    
+    sf::Clock captureClock;
+    WorldSnapshot snapshot = captureSnapshot();
+    float captureMs = captureClock.getElapsedTime().asSeconds() * 1000.0f;
+    
+    if (async) {
+        SaveSystem::getInstance().saveAsync(std::move(snapshot), SAVE_PATH);
+    } else {
+        SaveSystem::getInstance().saveNow(snapshot, SAVE_PATH);
+    }
+    
+    if (captureMs > 1.0f) {
+        LOG_INFO("[Save] Snapshot capture took " << captureMs << " ms");
+    }
+}
+
+bool GameState::persistenceEnabled() const {
+    return !InputSystem::getInstance().isReplaying() && stressMapPath.empty();
+}
+
+bool GameState::loadGame() {
+    PROFILE_SCOPE("GameState::loadGame");
+    
+    WorldSnapshot snapshot;
+    if (!SaveSystem::getInstance().load(SAVE_PATH, snapshot)) {
+        return false;
+    }
+    applySnapshot(snapshot);
+    return true;
+}
+
+// ============================================================================
+// 标记玩家种植的树木（种下种子和读档恢复共用）
+// ============================================================================
+void GameState::setupPlantedTree(Tree* tree) {
+    if (!tree) return;
+    tree->setPlanted(true);
+}
+
+// ============================================================================
+// 游戏事件：实体在更新/交互中压入 EventBus，这里每帧按类型成批处理
+// ============================================================================
+void GameState::dispatchGameEvents() {
+    PROFILE_SCOPE("GameState::dispatchGameEvents");
+    
+    EventBus& bus = EventBus::getInstance();
+    
+    bus.drain<TreeDestroyedEvent>([this](const TreeDestroyedEvent& e) {
+        if (Tree* tree = treeManager ? treeManager->getTree(e.tree) : nullptr) {
+            onTreeDestroyed(*tree);
+        }
+    });
+    bus.drain<TreeFruitHarvestedEvent>([this](const TreeFruitHarvestedEvent& e) {
+        if (Tree* tree = treeManager ? treeManager->getTree(e.tree) : nullptr) {
+            onTreeFruitHarvested(*tree);
+        }
+    });
+    bus.drain<TreeGrowthChangedEvent>([this](const TreeGrowthChangedEvent& e) {
+        if (Tree* tree = treeManager ? treeManager->getTree(e.tree) : nullptr) {
+            onTreeGrowthChanged(*tree);
+        }
+    });
+    bus.drain<RabbitKilledEvent>([this](const RabbitKilledEvent& e) {
+        if (Rabbit* rabbit = rabbitManager ? rabbitManager->getRabbit(e.rabbit) : nullptr) {
+            onRabbitKilled(*rabbit, e.source);
+        }
+    });
+    bus.drain<RabbitAttackEvent>([this](const RabbitAttackEvent& e) {
+        if (Rabbit* rabbit = rabbitManager ? rabbitManager->getRabbit(e.rabbit) : nullptr) {
+            onRabbitAttack(*rabbit);
+        }
+    });
+    bus.drain<ItemAddedEvent>([](const ItemAddedEvent& e) {
+        const ItemData* data = ItemDatabase::getInstance().getItemData(e.itemId);
+        if (data) {
+            LOG_DEBUG("[Inventory] +" << e.count << " " << data->name);
+        }
+    });
+}
+
+// 树被砍倒 - 生成掉落物品和奖励
+void GameState::onTreeDestroyed(Tree& t) {
+    // 使用递减概率计算掉落
+    auto drops = t.generateDrops();
+    
+    if (!drops.empty() && droppedItemManager) {
+        sf::Vector2f treePos = t.getPosition();
+        // 在树的位置生成掉落物品
+        droppedItemManager->spawnItems(drops, treePos.x, treePos.y - 20);
+        
+        // 添加掉落物品到事件日志
+        if (eventLogPanel) {
+            for (const auto& drop : drops) {
+                const ItemData* data = ItemDatabase::getInstance().getItemData(drop.first);
+                if (data) {
+                    eventLogPanel->addItemObtained(data->numericId, drop.second);
                 }
             }
-        });
+        }
+    }
+    
+    // 添加经验和金币奖励（从 tsx 配置读取）
+    if (player) {
+        int exp = t.getExpReward();
+        int gold = t.getGoldReward();
         
-        // 设置果实采摘回调
-        newTree->setOnFruitHarvested([this](Tree& t) {
-            auto drops = t.generateFruitDrops();
-            
-            if (!drops.empty() && droppedItemManager) {
-                sf::Vector2f treePos = t.getPosition();
-                droppedItemManager->spawnItems(drops, treePos.x, treePos.y - 20);
-                
-                if (eventLogPanel) {
-                    for (const auto& drop : drops) {
-                        const ItemData* data = ItemDatabase::getInstance().getItemData(drop.first);
-                        if (data) {
-                            eventLogPanel->addFruitHarvested(data->name, drop.second);
-                        }
-                    }
-                }
+        // 检查是否升级
+        int oldLevel = player->getStats().getLevel();
+        player->getStats().addExp(exp);
+        int newLevel = player->getStats().getLevel();
+        
+        player->getStats().addGold(gold);
+        if (!t.isPlanted()) {
+            player->getStats().addSkillExp(LifeSkill::Farming, exp / 2);
+        }
+        
+        // 添加到事件日志
+        if (eventLogPanel) {
+            eventLogPanel->addTreeChopped(t.getName());
+            if (exp > 0) {
+                eventLogPanel->addExpObtained(exp, "砍伐");
+            }
+            if (gold > 0) {
+                eventLogPanel->addGoldObtained(gold);
             }
-        });
+            if (newLevel > oldLevel) {
+                eventLogPanel->addLevelUp(newLevel);
+            }
+        }
+        
+        LOG_DEBUG("[Reward] +" << exp << " EXP, +" << gold << " Gold");
+    }
+}
+
+// 果实被采摘 - 生成果实掉落
+void GameState::onTreeFruitHarvested(Tree& t) {
+    auto drops = t.generateFruitDrops();
+    
+    if (!drops.empty() && droppedItemManager) {
+        sf::Vector2f treePos = t.getPosition();
+        droppedItemManager->spawnItems(drops, treePos.x, treePos.y - 20);
         
+        // 添加到事件日志
         if (eventLogPanel) {
-            eventLogPanel->addMessage("种下了种子，长出了 " + newTree->getName(), EventType::System);
+            for (const auto& drop : drops) {
+                const ItemData* data = ItemDatabase::getInstance().getItemData(drop.first);
+                if (data) {
+                    eventLogPanel->addFruitHarvested(data->name, drop.second);
+                }
+            }
         }
+    }
+    
+    // 种植的树采摘不加经验
+    if (player && !t.isPlanted()) {
+        int exp = t.getExpReward() / 2;  // 采摘经验减半
+        int oldLevel = player->getStats().getLevel();
+        player->getStats().addExp(exp);
+        int newLevel = player->getStats().getLevel();
         
-        std::cout << "[Plant] Planted seed, grew into " << treeType << " at (" 
-                  << plantX << ", " << plantY << ")" << std::endl;
+        if (eventLogPanel && exp > 0) {
+            eventLogPanel->addExpObtained(exp, "采摘");
+            if (newLevel > oldLevel) {
+                eventLogPanel->addLevelUp(newLevel);
+            }
+        }
+    }
+}
+
+void GameState::onTreeGrowthChanged(Tree& t) {
+    if (t.isPlanted()) return;
+    
+    LOG_DEBUG("[Tree] " << t.getName() << " changed to: " 
+          << t.getGrowthStageName());
+    
+    // 如果树木成熟，添加事件日志
+    if (eventLogPanel && t.getGrowthStageName() == "Mature") {
+        eventLogPanel->addTreeMature(t.getName());
+    }
+}
+
+// 兔子被击杀 - 生成掉落物品和奖励（宠物击杀时宠物也获得经验）
+void GameState::onRabbitKilled(Rabbit& rabbit, KillSource source) {
+    if (!player) return;
+    
+    Pet* pet = (source == KillSource::Pet && petManager) ? petManager->getCurrentPet() : nullptr;
+    
+    auto drops = rabbit.generateDrops();
+    
+    if (!drops.empty() && droppedItemManager) {
+        sf::Vector2f rabbitPos = rabbit.getPosition();
+        droppedItemManager->spawnItems(drops, rabbitPos.x, rabbitPos.y);
         
-        return true;
+        // 添加到事件日志
+        if (eventLogPanel) {
+            std::string killer = pet ? pet->getName() + " " : "";
+            eventLogPanel->addMessage(killer + "击杀了 " + rabbit.getName(), EventType::Combat);
+            for (const auto& drop : drops) {
+                const ItemData* data = ItemDatabase::getInstance().getItemData(drop.first);
+                if (data) {
+                    eventLogPanel->addItemObtained(data->numericId, drop.second);
+                }
+            }
+        }
     }
     
-    return false;
+    // 获得经验和金币
+    int exp = rabbit.getExpReward();
+    int gold = rabbit.getGoldReward();
+    
+    int oldLevel = player->getStats().getLevel();
+    player->getStats().addExp(exp);
+    int newLevel = player->getStats().getLevel();
+    player->getStats().addGold(gold);
+    
+    if (pet) {
+        pet->addExp(exp / 2);
+    }
+    
+    if (eventLogPanel) {
+        if (exp > 0) eventLogPanel->addExpObtained(exp, pet ? "宠物击杀" : "击杀");
+        if (gold > 0) eventLogPanel->addGoldObtained(gold);
+        if (newLevel > oldLevel) eventLogPanel->addLevelUp(newLevel);
+    }
+    
+    LOG_DEBUG("[Rabbit] Killed" << (pet ? " by " + pet->getName() : std::string()) 
+          << "! +" << exp << " EXP, +" << gold << " Gold");
+}
+
+// 兔子攻击玩家 - 闪避、伤害、击退、宠物反击
+void GameState::onRabbitAttack(Rabbit& r) {
+    if (!player) return;
+    
+    float damage = r.performAttack();
+    bool usedSkill = r.hasTriggeredSkill();
+    
+    // 玩家闪避判定
+    if (player->getStats().rollDodge(0)) {
+        if (eventLogPanel) {
+            eventLogPanel->addMessage("闪避了 " + r.getName() + " 的攻击!", EventType::Combat);
+        }
+        LOG_DEBUG("[Combat] Player dodged rabbit attack!");
+        return;
+    }
+    
+    // 计算实际伤害
+    float actualDamage = player->getStats().calculateDamageTaken(damage);
+    
+    // 获取兔子位置用于击退计算
+    sf::Vector2f rabbitPos = r.getPosition();
+    sf::FloatRect rabbitBounds = r.getBounds();
+    sf::Vector2f rabbitCenter(rabbitPos.x + rabbitBounds.width / 2.0f, 
+                              rabbitPos.y + rabbitBounds.height / 2.0f);
+    
+    // 受伤并击退（传入攻击者位置）
+    player->receiveDamage(actualDamage, rabbitCenter);
+    
+    if (eventLogPanel) {
+        std::string attackMsg;
+        if (usedSkill) {
+            const RabbitSkill& skill = r.getRabbitSkill();
+            attackMsg = r.getName() + " 使用了 [" + skill.name + "]! -" + 
+                       std::to_string(static_cast<int>(actualDamage)) + " HP";
+        } else {
+            attackMsg = r.getName() + " 攻击了你! -" + 
+                       std::to_string(static_cast<int>(actualDamage)) + " HP";
+        }
+        eventLogPanel->addMessage(attackMsg, EventType::Combat);
+    }
+    
+    LOG_DEBUG("[Combat] Rabbit attacked player for " << actualDamage << " damage"
+          << (usedSkill ? " (SKILL!)" : ""));
+    
+    // 宠物帮忙反击
+    if (petManager) {
+        Pet* pet = petManager->getCurrentPet();
+        if (pet && !pet->isDead()) {
+            // 设置攻击目标为攻击玩家的兔子
+            pet->setAttackTarget(rabbitPos);
+            
+            if (eventLogPanel) {
+                eventLogPanel->addMessage(pet->getName() + " 帮你反击!", EventType::Combat);
+            }
+        }
+    }
+    
+    if (player->isDead()) {
+        if (eventLogPanel) {
+            eventLogPanel->addMessage("你被击败了...", EventType::Combat);
+        }
+    }
 }
 
 // ============================================================================
@@ -1701,7 +2042,7 @@ bool GameState::onPlantSeed(const ItemStack& seed) {
 void GameState::onEquipItem(const ItemStack& item) {
     if (!playerEquipment) return;
     
-    const EquipmentData* equipData = EquipmentManager::getInstance().getEquipmentData(item.itemId);
+    const EquipmentData* equipData = EquipmentManager::getInstance().getEquipmentData(item.getStringId());
     if (!equipData) return;
     
     // 检查等级需求
@@ -1728,7 +2069,7 @@ void GameState::onEquipItem(const ItemStack& item) {
         }
     }
     
-    std::cout << "[Equip] Equipped " << item.itemId << std::endl;
+    LOG_INFO("[Equip] Equipped " << item.getStringId());
 }
 
 // ============================================================================
@@ -1754,7 +2095,7 @@ void GameState::onUnequipItem(EquipmentSlot slot) {
             }
         }
         
-        std::cout << "[Unequip] Unequipped " << unequipped.itemId << std::endl;
+        LOG_INFO("[Unequip] Unequipped " << unequipped.getStringId());
     }
 }
 
@@ -1762,11 +2103,14 @@ void GameState::onUnequipItem(EquipmentSlot slot) {
 // 初始化宠物系统
 // ============================================================================
 void GameState::initPetSystem() {
-    std::cout << "[PetSystem] Initializing..." << std::endl;
+    PROFILE_SCOPE("GameState::initPetSystem");
+    
+    LOG_INFO("[PetSystem] Initializing...");
     
     // 创建宠物管理器
     petManager = std::make_unique<PetManager>();
     petManager->init("../../assets");
+    petManager->setFlowField(flowField.get());
     
     sf::Vector2u windowSize = game->getWindow().getSize();
     
@@ -1800,9 +2144,9 @@ void GameState::initPetSystem() {
     // 初始化时更新物品数量
     updatePetPanelItemCounts();
     
-    std::cout << "[PetSystem] Initialized successfully" << std::endl;
-    std::cout << "  - P: 宠物栏" << std::endl;
-    std::cout << "  - H: 孵化栏" << std::endl;
+    LOG_INFO("[PetSystem] Initialized successfully");
+    LOG_INFO("  - P: 宠物栏");
+    LOG_INFO("  - H: 孵化栏");
 }
 
 // ============================================================================
@@ -1872,6 +2216,7 @@ bool GameState::onHatchPet(int petTypeId, int enhancerCount) {
         
         // 更新面板物品数量显示
         updatePetPanelItemCounts();
+        refreshPetModifiers();
         return true;
     }
     
@@ -1913,6 +2258,7 @@ bool GameState::onWashPet(int slotIndex, float playerLuck) {
         
         // 更新面板物品数量显示
         updatePetPanelItemCounts();
+        refreshPetModifiers();
         return true;
     }
     
@@ -1930,18 +2276,42 @@ bool GameState::onSwitchPet(int slotIndex) {
         if (pet && eventLogPanel) {
             eventLogPanel->addMessage("切换到宠物: " + pet->getName(), EventType::System);
         }
+        refreshPetModifiers();
         return true;
     }
     
     return false;
 }
 
+// ============================================================================
+// 属性加成来源
+// ============================================================================
+void GameState::refreshEquipmentModifiers() {
+    if (!statModifiers || !playerEquipment) return;
+    
+    const EquipmentStats& stats = playerEquipment->getTotalStats();
+    StatModifier modifier;
+    modifier.attack = static_cast<float>(stats.attack);
+    modifier.defense = static_cast<float>(stats.defense);
+    modifier.speed = stats.speed;
+    statModifiers->setSource(ModifierSource::Equipment, modifier);
+}
+
+void GameState::refreshPetModifiers() {
+    if (!statModifiers || !petManager) return;
+    
+    // 兔子助威：按百分比提升主人攻击力
+    StatModifier modifier;
+    modifier.attackPercent = petManager->getOwnerAttackBonus();
+    statModifiers->setSource(ModifierSource::Pet, modifier);
+}
+
 // ============================================================================
 // 更新宠物面板物品数量
 // ============================================================================
 void GameState::updatePetPanelItemCounts() {
     if (!categoryInventory) {
-        std::cout << "[PetSystem] Error: categoryInventory is null!" << std::endl;
+        LOG_ERROR("[PetSystem] Error: categoryInventory is null!");
         return;
     }
     
@@ -1949,9 +2319,9 @@ void GameState::updatePetPanelItemCounts() {
     int rabbitFur = categoryInventory->getItemCount("rabbit_fur");  // 兔毛作为兔子精元的强化剂
     int cleansers = categoryInventory->getItemCount("pet_cleanser");
     
-    std::cout << "[PetSystem] Updating counts - Essence: " << rabbitEssence 
-              << ", RabbitFur(Enhancer): " << rabbitFur 
-              << ", Cleansers: " << cleansers << std::endl;
+    LOG_DEBUG("[PetSystem] Updating counts - Essence: " << rabbitEssence 
+          << ", RabbitFur(Enhancer): " << rabbitFur 
+          << ", Cleansers: " << cleansers);
     
     // 更新宠物栏面板
     if (petPanel) {
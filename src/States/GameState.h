@@ -5,8 +5,11 @@
 #include "../Entity/Rabbit.h"
 #include "../Entity/StoneBuild.h"
 #include "../Entity/WildPlant.h"
+#include "../Entity/StatModifiers.h"
 #include "../World/TileMap.h"
 #include "../World/Camera.h"
+#include "../World/StressScene.h"
+#include "../World/FlowField.h"
 #include "../Systems/TimeSystem.h"
 #include "../UI/StatsPanel.h"
 #include "../UI/InventoryPanel.h"
@@ -20,9 +23,10 @@
 #include "../Items/Crafting.h"
 #include "../Items/DroppedItem.h"
 #include "../Pet/PetManager.h"
+#include "../Systems/SaveSystem.h"
+#include "../Systems/Broadphase.h"
 #include <memory>
 #include <string>
-#include <random>
 
 // Map type enumeration
 enum class MapType {
@@ -33,7 +37,10 @@ enum class MapType {
 class GameState : public State {
 public:
     // Constructor - can specify initial map type
-    GameState(Game* game, MapType mapType = MapType::Farm);
+    // stressScene: generate a synthetic map that stands in for mapType (see StressScene.h)
+    GameState(Game* game, MapType mapType = MapType::Farm,
+              const StressSceneConfig* stressScene = nullptr);
+    ~GameState() override;
     
     // Event handling
     void handleInput(const sf::Event& event) override;
@@ -43,6 +50,9 @@ public:
     
     // Render
     void render(sf::RenderWindow& window) override;
+    
+    // Simulation state hash (replay comparison)
+    std::uint64_t computeStateHash() const override;
 
 private:
     // Load specified map
@@ -69,6 +79,13 @@ private:
     // Initialize rabbits
     void initRabbits();
     
+    // Rebuild flow-field obstacles if needed and retarget it at the player
+    void updateFlowField();
+    
+    // Push collisions among player, pet and rabbits (batched)
+    void resolveDynamicCollisions(bool playerMoving);
+    void clampPlayerToMap();
+    
     // Initialize item system
     void initItemSystem();
     
@@ -111,8 +128,31 @@ private:
     // Update pet panel item counts
     void updatePetPanelItemCounts();
     
+    // Push equipment / pet bonuses into the stat modifier stack
+    void refreshEquipmentModifiers();
+    void refreshPetModifiers();
+    
     // Get map name string
     std::string getMapName(MapType mapType) const;
+    
+    // Mark a player-planted tree (seed planting and save restore)
+    void setupPlantedTree(Tree* tree);
+    
+    // Drain EventBus queues once per frame (after entity updates)
+    void dispatchGameEvents();
+    void onTreeDestroyed(Tree& tree);
+    void onTreeFruitHarvested(Tree& tree);
+    void onTreeGrowthChanged(Tree& tree);
+    void onRabbitKilled(Rabbit& rabbit, KillSource source);
+    void onRabbitAttack(Rabbit& rabbit);
+    
+    // Save / load
+    WorldSnapshot captureSnapshot() const;
+    void applySnapshot(const WorldSnapshot& snapshot);
+    void saveGame(bool async);
+    bool loadGame();
+    // 回放和压力测试场景不读写玩家存档
+    bool persistenceEnabled() const;
 
 private:
     // Game objects
@@ -131,6 +171,22 @@ private:
     // Rabbit system
     std::unique_ptr<RabbitManager> rabbitManager;
     
+    // Shared flow field toward the player (chasing rabbits, following pet)
+    std::unique_ptr<FlowField> flowField;
+    bool flowFieldStaticDirty = true;       // map (re)loaded: rebuild tile/object obstacles
+    std::uint32_t flowFieldTreeVersion = 0;
+    
+    // Dynamic-body broadphase (player, pet, rabbits); buffers reused every frame
+    enum class DynamicBodyKind { Player, Pet, Rabbit };
+    struct DynamicBody {
+        DynamicBodyKind kind;
+        Rabbit* rabbit;             // kind == Rabbit
+        bool moving;                // 本帧在主动移动（兔子撞玩家的判定）
+    };
+    SweepAndPrune dynamicBroadphase;
+    std::vector<DynamicBody> dynamicBodies;
+    std::vector<sf::Vector2f> dynamicPushes;
+    
     // Item system - new categorized inventory
     std::unique_ptr<CategoryInventory> categoryInventory;
     std::unique_ptr<DroppedItemManager> droppedItemManager;
@@ -138,6 +194,9 @@ private:
     // Equipment system
     std::unique_ptr<PlayerEquipment> playerEquipment;
     
+    // Derived stats (equipment + pet + timed buffs -> PlayerStats bonuses)
+    std::unique_ptr<StatModifierStack> statModifiers;
+    
     // UI panels
     std::unique_ptr<StatsPanel> statsPanel;
     std::unique_ptr<CategoryInventoryPanel> categoryInventoryPanel;
@@ -153,21 +212,40 @@ private:
     // Current map type
     MapType currentMap;
     
+    // Stress scene: generated map used in place of stressMapType (empty = none)
+    std::string stressMapPath;
+    MapType stressMapType = MapType::Farm;
+    
+    // Rabbits spawned per map load
+    static constexpr int DEFAULT_RABBIT_COUNT = 20;
+    int rabbitSpawnCount = DEFAULT_RABBIT_COUNT;
+    
     // Attack state tracking
     bool wasAttacking;
     
+    // Push strengths (see resolveDynamicCollisions)
+    static constexpr float PLAYER_PUSH_STRENGTH = 1.0f;
+    static constexpr float RABBIT_PUSH_STRENGTH = 1.0f;
+    static constexpr float PET_PUSH_STRENGTH = 0.8f;
+    static constexpr float PET_PUSHBACK_RATIO = 0.5f;     // 兔子把宠物推回重叠量的一半
+    
     // Item pickup range
     static constexpr float PICKUP_RANGE = 50.0f;
     
     // Plant pickup range
     static constexpr float PLANT_PICKUP_RANGE = 60.0f;
     
+    // Consumable buffs without an explicit duration
+    static constexpr float DEFAULT_BUFF_DURATION = 60.0f;
+    
     // Plant pickup key state
     bool pickupKeyPressed = false;
     
-    // Random number generator for seed planting
-    std::mt19937 rng;
-    
     // Tree types available for seed planting (from tree.tsx)
     std::vector<std::string> availableTreeTypes;
+    
+    // Autosave
+    float autosaveTimer = 0.0f;
+    static constexpr float AUTOSAVE_INTERVAL = 60.0f;
+    static constexpr const char* SAVE_PATH = "save/world.sav";
 };
\ No newline at end of file
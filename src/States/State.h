@@ -1,5 +1,6 @@
 #pragma once
 #include <SFML/Graphics.hpp>
+#include <cstdint>
 
 class Game;
 
@@ -14,6 +15,9 @@ public:
     virtual void update(float dt) = 0;
     virtual void render(sf::RenderWindow& window) = 0;
     
+    // Hash of the simulation state (used to compare replay results across builds)
+    virtual std::uint64_t computeStateHash() const { return 0; }
+    
     // State management
     bool shouldPop() const { return popRequested; }
     void requestPop() { popRequested = true; }
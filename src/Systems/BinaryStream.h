@@ -0,0 +1,96 @@
+#pragma once
+#include <SFML/System.hpp>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// 二进制读写辅助 (Binary Stream)
+//
+// 存档和物品定义表共用的紧凑二进制编码：
+//   - pod:  按本机字节序直接拷贝（仅支持小端平台）
+//   - str:  uint16 长度 + UTF-8 字节
+//   - 分段: uint32 标签 | uint32 长度 | 数据，读取方可以跳过不认识的分段
+// ============================================================================
+
+// 分段标签
+constexpr std::uint32_t makeTag(char a, char b, char c, char d) {
+    return static_cast<std::uint32_t>(a) | (static_cast<std::uint32_t>(b) << 8) |
+           (static_cast<std::uint32_t>(c) << 16) | (static_cast<std::uint32_t>(d) << 24);
+}
+
+class BinaryWriter {
+public:
+    explicit BinaryWriter(std::vector<std::uint8_t>& out) : buffer(out) {}
+
+    template <typename T>
+    void pod(T value) {
+        const auto* bytes = reinterpret_cast<const std::uint8_t*>(&value);
+        buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+    }
+
+    void str(const std::string& s) {
+        pod(static_cast<std::uint16_t>(s.size()));
+        buffer.insert(buffer.end(), s.begin(), s.end());
+    }
+
+    void vec2(const sf::Vector2f& v) { pod(v.x); pod(v.y); }
+
+    // 分段：先写标签和占位长度，结束时回填
+    std::size_t beginSection(std::uint32_t tag) {
+        pod(tag);
+        pod(std::uint32_t(0));
+        return buffer.size();
+    }
+
+    void endSection(std::size_t start) {
+        std::uint32_t length = static_cast<std::uint32_t>(buffer.size() - start);
+        std::memcpy(&buffer[start - sizeof(std::uint32_t)], &length, sizeof(length));
+    }
+
+private:
+    std::vector<std::uint8_t>& buffer;
+};
+
+class BinaryReader {
+public:
+    BinaryReader(const std::uint8_t* data, std::size_t size) : data(data), size(size) {}
+
+    template <typename T>
+    bool pod(T& value) {
+        if (pos + sizeof(T) > size) return fail();
+        std::memcpy(&value, data + pos, sizeof(T));
+        pos += sizeof(T);
+        return true;
+    }
+
+    bool str(std::string& s) {
+        std::uint16_t length = 0;
+        if (!pod(length) || pos + length > size) return fail();
+        s.assign(reinterpret_cast<const char*>(data + pos), length);
+        pos += length;
+        return true;
+    }
+
+    bool vec2(sf::Vector2f& v) { return pod(v.x) && pod(v.y); }
+
+    bool skip(std::size_t n) {
+        if (pos + n > size) return fail();
+        pos += n;
+        return true;
+    }
+
+    bool atEnd() const { return pos >= size; }
+    bool ok() const { return good; }
+    std::size_t position() const { return pos; }
+    const std::uint8_t* current() const { return data + pos; }
+
+private:
+    bool fail() { good = false; return false; }
+
+    const std::uint8_t* data;
+    std::size_t size;
+    std::size_t pos = 0;
+    bool good = true;
+};
@@ -0,0 +1,69 @@
+#include "Broadphase.h"
+#include <algorithm>
+
+std::uint32_t SweepAndPrune::add(const sf::FloatRect& box) {
+    boxes.push_back(box);
+    return static_cast<std::uint32_t>(boxes.size() - 1);
+}
+
+// 上一帧的顺序去掉已不存在的 id，再补上新 id
+void SweepAndPrune::syncOrder() {
+    const std::uint32_t count = static_cast<std::uint32_t>(boxes.size());
+    if (order.size() == count) return;
+
+    const std::uint32_t previous = static_cast<std::uint32_t>(order.size());
+    order.erase(std::remove_if(order.begin(), order.end(),
+                               [count](std::uint32_t id) { return id >= count; }),
+                order.end());
+    for (std::uint32_t id = previous; id < count; id++) {
+        order.push_back(id);
+    }
+}
+
+// 插入排序：输入几乎有序时只做少量交换
+void SweepAndPrune::sortOrder() {
+    lastSwapCount = 0;
+    for (size_t i = 1; i < order.size(); i++) {
+        const std::uint32_t id = order[i];
+        const float left = boxes[id].left;
+        size_t j = i;
+        while (j > 0 && boxes[order[j - 1]].left > left) {
+            order[j] = order[j - 1];
+            j--;
+            lastSwapCount++;
+        }
+        order[j] = id;
+    }
+}
+
+const std::vector<BroadphasePair>& SweepAndPrune::findPairs() {
+    pairs.clear();
+    syncOrder();
+    sortOrder();
+
+    sorted.clear();
+    sorted.reserve(order.size());
+    for (std::uint32_t id : order) {
+        sorted.add(boxes[id]);
+    }
+    mask.resize(order.size());
+
+    for (size_t i = 0; i < order.size(); i++) {
+        // 后面的物体左边界越过 a 的右边界就不可能再和 a 重叠
+        auto first = sorted.minX.begin() + static_cast<std::ptrdiff_t>(i + 1);
+        size_t end = static_cast<size_t>(std::lower_bound(first, sorted.minX.end(), sorted.maxX[i]) -
+                                         sorted.minX.begin());
+        if (end <= i + 1) continue;
+
+        if (CollisionSystem::overlapMask(sorted, i + 1, end, boxes[order[i]], mask.data()) == 0) continue;
+        for (size_t j = i + 1; j < end; j++) {
+            if (!mask[j - i - 1]) continue;
+            pairs.push_back({std::min(order[i], order[j]), std::max(order[i], order[j])});
+        }
+    }
+
+    std::sort(pairs.begin(), pairs.end(), [](const BroadphasePair& x, const BroadphasePair& y) {
+        return x.a != y.a ? x.a < y.a : x.b < y.b;
+    });
+    return pairs;
+}
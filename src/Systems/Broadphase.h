@@ -0,0 +1,53 @@
+#pragma once
+#include "CollisionSystem.h"
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+
+// ============================================================================
+// 动态物体宽阶段 (Broadphase) —— 排序扫掠 (Sort and Sweep / Sweep and Prune)
+//
+// 用法（每帧）：
+//   broadphase.clear();
+//   for (...) broadphase.add(box);          // 返回的 id 就是添加顺序
+//   for (const auto& pair : broadphase.findPairs()) { ... }
+//
+//   - 物体按碰撞盒左边界沿 x 轴排序，扫一遍得到所有重叠对
+//   - 排序结果跨帧保留：物体每帧只移动几个像素，插入排序接近 O(n)
+//   - 物体数量变化时旧顺序照样可用（多出的 id 追加到末尾再排）
+//   - 窄阶段：候选区间按排序后的 SoA 批一次测试（CollisionSystem::overlapMask）
+//   - 重叠对按 (a, b) 排序且 a < b，结果与物体的扫掠顺序无关，迭代顺序稳定
+// ============================================================================
+
+struct BroadphasePair {
+    std::uint32_t a;
+    std::uint32_t b;
+};
+
+class SweepAndPrune {
+public:
+    // 清空本帧物体（保留上一帧的排序）
+    void clear() { boxes.clear(); }
+
+    std::uint32_t add(const sf::FloatRect& box);
+
+    // 排序并扫掠，返回所有碰撞盒重叠的物体对
+    const std::vector<BroadphasePair>& findPairs();
+
+    size_t size() const { return boxes.size(); }
+    const sf::FloatRect& getBox(std::uint32_t id) const { return boxes[id]; }
+
+    // 上一次 findPairs 插入排序的交换次数（衡量跨帧相干性）
+    size_t getLastSwapCount() const { return lastSwapCount; }
+
+private:
+    void syncOrder();
+    void sortOrder();
+
+    std::vector<sf::FloatRect> boxes;
+    std::vector<std::uint32_t> order;       // 按 boxes[id].left 升序的 id
+    CollisionSystem::AABBBatch sorted;      // 按 order 排列的碰撞盒
+    std::vector<std::uint8_t> mask;
+    std::vector<BroadphasePair> pairs;
+    size_t lastSwapCount = 0;
+};
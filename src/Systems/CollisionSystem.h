@@ -1,6 +1,18 @@
 #pragma once
 #include <SFML/Graphics.hpp>
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <vector>
+
+// 批量内核的指令集：AVX2（编译时开启，见 CMake 的 PF_ENABLE_AVX2）> SSE2（x64 基线）> 标量
+#if defined(__AVX2__)
+    #include <immintrin.h>
+    #define PF_COLLISION_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define PF_COLLISION_SSE2 1
+#endif
 
 // ============================================================================
 // 碰撞系统
@@ -13,6 +25,9 @@
 //   - 谁在移动（主动方），谁就把对方（被动方）推开
 //   - 玩家主动撞兔子 → 兔子被推开
 //   - 兔子主动撞玩家 → 玩家被推开
+//
+// 批量接口（文件末尾）：碰撞盒按 SoA 存放，一个矩形 / 圆对 N 个物体一次测试，
+// 每条指令处理 8 个（AVX2）或 4 个（SSE2）候选，结果写成逐元素掩码。
 // ============================================================================
 
 namespace CollisionSystem {
@@ -140,4 +155,223 @@ inline CollisionResult detectAndRespond(const sf::FloatRect& moverBox,
     return result;
 }
 
+// ============================================================================
+// 批量碰撞检测 (SoA)
+// ============================================================================
+
+// 碰撞盒批：四条边分开存放，便于向量加载
+struct AABBBatch {
+    std::vector<float> minX, minY, maxX, maxY;
+    
+    void clear() { minX.clear(); minY.clear(); maxX.clear(); maxY.clear(); }
+    void reserve(size_t n) { minX.reserve(n); minY.reserve(n); maxX.reserve(n); maxY.reserve(n); }
+    size_t size() const { return minX.size(); }
+    
+    // 宽高为负时与 sf::FloatRect::intersects 一样按绝对范围处理
+    void add(const sf::FloatRect& box) {
+        minX.push_back(std::min(box.left, box.left + box.width));
+        minY.push_back(std::min(box.top, box.top + box.height));
+        maxX.push_back(std::max(box.left, box.left + box.width));
+        maxY.push_back(std::max(box.top, box.top + box.height));
+    }
+    
+    sf::FloatRect get(size_t i) const {
+        return sf::FloatRect(minX[i], minY[i], maxX[i] - minX[i], maxY[i] - minY[i]);
+    }
+};
+
+// 点批（圆心）
+struct PointBatch {
+    std::vector<float> x, y;
+    
+    void clear() { x.clear(); y.clear(); }
+    void reserve(size_t n) { x.reserve(n); y.reserve(n); }
+    size_t size() const { return x.size(); }
+    void add(const sf::Vector2f& p) { x.push_back(p.x); y.push_back(p.y); }
+};
+
+// 当前编译使用的批量内核（日志 / 基准测试）
+inline const char* getBatchKernelName() {
+#if defined(PF_COLLISION_AVX2)
+    return "AVX2";
+#elif defined(PF_COLLISION_SSE2)
+    return "SSE2";
+#else
+    return "scalar";
+#endif
+}
+
+namespace detail {
+    // 把比较结果的位掩码展开成逐元素 0/1，返回命中数
+    inline size_t expandMask(int bits, int lanes, std::uint8_t* out) {
+        size_t hits = 0;
+        for (int k = 0; k < lanes; k++) {
+            std::uint8_t hit = static_cast<std::uint8_t>((bits >> k) & 1);
+            out[k] = hit;
+            hits += hit;
+        }
+        return hits;
+    }
+}
+
+// 矩形对批中 [begin, end) 的碰撞盒逐个测试（与 sf::FloatRect::intersects 一致：
+// 边界恰好相接不算碰撞）。mask[k] 对应第 begin + k 个，返回命中数
+inline size_t overlapMask(const AABBBatch& batch, size_t begin, size_t end,
+                          const sf::FloatRect& box, std::uint8_t* mask)
+{
+    const float qMinX = std::min(box.left, box.left + box.width);
+    const float qMinY = std::min(box.top, box.top + box.height);
+    const float qMaxX = std::max(box.left, box.left + box.width);
+    const float qMaxY = std::max(box.top, box.top + box.height);
+    
+    size_t hits = 0;
+    size_t i = begin;
+    
+#if defined(PF_COLLISION_AVX2)
+    const __m256 minX8 = _mm256_set1_ps(qMinX), minY8 = _mm256_set1_ps(qMinY);
+    const __m256 maxX8 = _mm256_set1_ps(qMaxX), maxY8 = _mm256_set1_ps(qMaxY);
+    for (; i + 8 <= end; i += 8) {
+        __m256 hitX = _mm256_and_ps(
+            _mm256_cmp_ps(minX8, _mm256_loadu_ps(batch.maxX.data() + i), _CMP_LT_OQ),
+            _mm256_cmp_ps(_mm256_loadu_ps(batch.minX.data() + i), maxX8, _CMP_LT_OQ));
+        __m256 hitY = _mm256_and_ps(
+            _mm256_cmp_ps(minY8, _mm256_loadu_ps(batch.maxY.data() + i), _CMP_LT_OQ),
+            _mm256_cmp_ps(_mm256_loadu_ps(batch.minY.data() + i), maxY8, _CMP_LT_OQ));
+        hits += detail::expandMask(_mm256_movemask_ps(_mm256_and_ps(hitX, hitY)), 8, mask + (i - begin));
+    }
+#elif defined(PF_COLLISION_SSE2)
+    const __m128 minX4 = _mm_set1_ps(qMinX), minY4 = _mm_set1_ps(qMinY);
+    const __m128 maxX4 = _mm_set1_ps(qMaxX), maxY4 = _mm_set1_ps(qMaxY);
+    for (; i + 4 <= end; i += 4) {
+        __m128 hitX = _mm_and_ps(_mm_cmplt_ps(minX4, _mm_loadu_ps(batch.maxX.data() + i)),
+                                 _mm_cmplt_ps(_mm_loadu_ps(batch.minX.data() + i), maxX4));
+        __m128 hitY = _mm_and_ps(_mm_cmplt_ps(minY4, _mm_loadu_ps(batch.maxY.data() + i)),
+                                 _mm_cmplt_ps(_mm_loadu_ps(batch.minY.data() + i), maxY4));
+        hits += detail::expandMask(_mm_movemask_ps(_mm_and_ps(hitX, hitY)), 4, mask + (i - begin));
+    }
+#endif
+    
+    for (; i < end; i++) {
+        bool hit = qMinX < batch.maxX[i] && batch.minX[i] < qMaxX &&
+                   qMinY < batch.maxY[i] && batch.minY[i] < qMaxY;
+        mask[i - begin] = hit ? 1 : 0;
+        hits += hit ? 1 : 0;
+    }
+    return hits;
+}
+
+inline size_t overlapMask(const AABBBatch& batch, const sf::FloatRect& box, std::vector<std::uint8_t>& mask) {
+    mask.resize(batch.size());
+    return overlapMask(batch, 0, batch.size(), box, mask.data());
+}
+
+// 圆对 N 个点：距离 <= radius 记为命中，返回命中数
+inline size_t circleMask(const PointBatch& points, const sf::Vector2f& center, float radius,
+                         std::vector<std::uint8_t>& mask)
+{
+    const size_t count = points.size();
+    mask.resize(count);
+    const float radiusSq = radius * radius;
+    
+    size_t hits = 0;
+    size_t i = 0;
+    
+#if defined(PF_COLLISION_AVX2)
+    const __m256 cx8 = _mm256_set1_ps(center.x), cy8 = _mm256_set1_ps(center.y);
+    const __m256 r8 = _mm256_set1_ps(radiusSq);
+    for (; i + 8 <= count; i += 8) {
+        __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(points.x.data() + i), cx8);
+        __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(points.y.data() + i), cy8);
+        __m256 distSq = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+        hits += detail::expandMask(_mm256_movemask_ps(_mm256_cmp_ps(distSq, r8, _CMP_LE_OQ)), 8, mask.data() + i);
+    }
+#elif defined(PF_COLLISION_SSE2)
+    const __m128 cx4 = _mm_set1_ps(center.x), cy4 = _mm_set1_ps(center.y);
+    const __m128 r4 = _mm_set1_ps(radiusSq);
+    for (; i + 4 <= count; i += 4) {
+        __m128 dx = _mm_sub_ps(_mm_loadu_ps(points.x.data() + i), cx4);
+        __m128 dy = _mm_sub_ps(_mm_loadu_ps(points.y.data() + i), cy4);
+        __m128 distSq = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+        hits += detail::expandMask(_mm_movemask_ps(_mm_cmple_ps(distSq, r4)), 4, mask.data() + i);
+    }
+#endif
+    
+    for (; i < count; i++) {
+        float dx = points.x[i] - center.x;
+        float dy = points.y[i] - center.y;
+        bool hit = dx * dx + dy * dy <= radiusSq;
+        mask[i] = hit ? 1 : 0;
+        hits += hit ? 1 : 0;
+    }
+    return hits;
+}
+
+// 批量分离向量：对每个 i 等同于 calculateSeparationVector(box, batch.get(i))
+// （批中物体应移动的向量）。未重叠的元素结果无意义，配合 overlapMask 使用
+inline void separationVectors(const sf::FloatRect& box, const AABBBatch& batch,
+                              std::vector<float>& outX, std::vector<float>& outY)
+{
+    const size_t count = batch.size();
+    outX.resize(count);
+    outY.resize(count);
+    
+    const float centerX = box.left + box.width / 2.0f;
+    const float centerY = box.top + box.height / 2.0f;
+    const float halfW = box.width / 2.0f;
+    const float halfH = box.height / 2.0f;
+    
+    size_t i = 0;
+    
+#if defined(PF_COLLISION_AVX2)
+    const __m256 half = _mm256_set1_ps(0.5f), zero = _mm256_setzero_ps();
+    const __m256 signBit = _mm256_set1_ps(-0.0f);
+    const __m256 cx = _mm256_set1_ps(centerX), cy = _mm256_set1_ps(centerY);
+    const __m256 hw = _mm256_set1_ps(halfW), hh = _mm256_set1_ps(halfH);
+    for (; i + 8 <= count; i += 8) {
+        __m256 minX = _mm256_loadu_ps(batch.minX.data() + i), maxX = _mm256_loadu_ps(batch.maxX.data() + i);
+        __m256 minY = _mm256_loadu_ps(batch.minY.data() + i), maxY = _mm256_loadu_ps(batch.maxY.data() + i);
+        __m256 dx = _mm256_sub_ps(_mm256_mul_ps(_mm256_add_ps(minX, maxX), half), cx);
+        __m256 dy = _mm256_sub_ps(_mm256_mul_ps(_mm256_add_ps(minY, maxY), half), cy);
+        __m256 overlapX = _mm256_sub_ps(_mm256_add_ps(hw, _mm256_mul_ps(_mm256_sub_ps(maxX, minX), half)),
+                                        _mm256_andnot_ps(signBit, dx));
+        __m256 overlapY = _mm256_sub_ps(_mm256_add_ps(hh, _mm256_mul_ps(_mm256_sub_ps(maxY, minY), half)),
+                                        _mm256_andnot_ps(signBit, dy));
+        // dx > 0 取正，否则取负（与标量版一致：dx == 0 时向负方向）
+        __m256 signedX = _mm256_blendv_ps(_mm256_xor_ps(overlapX, signBit), overlapX, _mm256_cmp_ps(dx, zero, _CMP_GT_OQ));
+        __m256 signedY = _mm256_blendv_ps(_mm256_xor_ps(overlapY, signBit), overlapY, _mm256_cmp_ps(dy, zero, _CMP_GT_OQ));
+        __m256 useX = _mm256_cmp_ps(overlapX, overlapY, _CMP_LT_OQ);
+        _mm256_storeu_ps(outX.data() + i, _mm256_and_ps(useX, signedX));
+        _mm256_storeu_ps(outY.data() + i, _mm256_andnot_ps(useX, signedY));
+    }
+#elif defined(PF_COLLISION_SSE2)
+    const __m128 half = _mm_set1_ps(0.5f), zero = _mm_setzero_ps();
+    const __m128 signBit = _mm_set1_ps(-0.0f);
+    const __m128 cx = _mm_set1_ps(centerX), cy = _mm_set1_ps(centerY);
+    const __m128 hw = _mm_set1_ps(halfW), hh = _mm_set1_ps(halfH);
+    for (; i + 4 <= count; i += 4) {
+        __m128 minX = _mm_loadu_ps(batch.minX.data() + i), maxX = _mm_loadu_ps(batch.maxX.data() + i);
+        __m128 minY = _mm_loadu_ps(batch.minY.data() + i), maxY = _mm_loadu_ps(batch.maxY.data() + i);
+        __m128 dx = _mm_sub_ps(_mm_mul_ps(_mm_add_ps(minX, maxX), half), cx);
+        __m128 dy = _mm_sub_ps(_mm_mul_ps(_mm_add_ps(minY, maxY), half), cy);
+        __m128 overlapX = _mm_sub_ps(_mm_add_ps(hw, _mm_mul_ps(_mm_sub_ps(maxX, minX), half)),
+                                     _mm_andnot_ps(signBit, dx));
+        __m128 overlapY = _mm_sub_ps(_mm_add_ps(hh, _mm_mul_ps(_mm_sub_ps(maxY, minY), half)),
+                                     _mm_andnot_ps(signBit, dy));
+        // SSE2 没有 blendv：用与/非与/或选择符号
+        __m128 posX = _mm_cmpgt_ps(dx, zero), posY = _mm_cmpgt_ps(dy, zero);
+        __m128 signedX = _mm_or_ps(_mm_and_ps(posX, overlapX), _mm_andnot_ps(posX, _mm_xor_ps(overlapX, signBit)));
+        __m128 signedY = _mm_or_ps(_mm_and_ps(posY, overlapY), _mm_andnot_ps(posY, _mm_xor_ps(overlapY, signBit)));
+        __m128 useX = _mm_cmplt_ps(overlapX, overlapY);
+        _mm_storeu_ps(outX.data() + i, _mm_and_ps(useX, signedX));
+        _mm_storeu_ps(outY.data() + i, _mm_andnot_ps(useX, signedY));
+    }
+#endif
+    
+    for (; i < count; i++) {
+        sf::Vector2f separation = calculateSeparationVector(box, batch.get(i));
+        outX[i] = separation.x;
+        outY[i] = separation.y;
+    }
+}
+
 } // namespace CollisionSystem
@@ -0,0 +1,15 @@
+#include "EventBus.h"
+
+EventBus& EventBus::getInstance() {
+    static EventBus instance;
+    return instance;
+}
+
+void EventBus::setActive(bool value) {
+    active = value;
+    if (!active) clear();
+}
+
+void EventBus::clear() {
+    std::apply([](auto&... events) { (events.clear(), ...); }, queues);
+}
@@ -0,0 +1,125 @@
+#pragma once
+#include "SlotMap.h"
+#include "../Items/Item.h"
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+// ============================================================================
+// 游戏事件总线 (Event Bus)
+//
+// 实体不再各自持有 std::function 回调，而是把紧凑的 POD 事件压入按类型分开的队列：
+//   EventBus::getInstance().push(TreeDestroyedEvent{handle});
+//
+// GameState 在每帧固定阶段（实体更新和推挤解算之后）按类型成批处理：
+//   bus.drain<TreeDestroyedEvent>([&](const TreeDestroyedEvent& e) { ... });
+//
+//   - 事件只带句柄和少量数值；处理时用句柄查实体，实体已删除则跳过
+//   - 处理函数里再 push 的同类事件在同一次 drain 中处理
+//   - 未激活（没有 GameState 消费）时 push 直接丢弃，基准测试等场景不会积压
+//   - 队列容量跨帧保留，稳定后每帧不再分配
+// ============================================================================
+
+class Tree;
+class Rabbit;
+enum class InventoryCategory;
+
+// ========================================
+// 事件
+// ========================================
+
+// 树被砍倒（掉落、经验、金币）
+struct TreeDestroyedEvent {
+    Handle<Tree> tree;
+};
+
+// 果实被采摘
+struct TreeFruitHarvestedEvent {
+    Handle<Tree> tree;
+};
+
+// 生长阶段变化
+struct TreeGrowthChangedEvent {
+    Handle<Tree> tree;
+};
+
+// 兔子攻击玩家（伤害在处理时结算）
+struct RabbitAttackEvent {
+    Handle<Rabbit> rabbit;
+};
+
+// 击杀来源（决定日志文字和宠物经验）
+enum class KillSource : std::uint8_t {
+    Player,
+    Pet
+};
+
+// 兔子被击杀（掉落、经验、金币在处理时结算）
+struct RabbitKilledEvent {
+    Handle<Rabbit> rabbit;
+    KillSource source;
+};
+
+// 物品进入分类背包
+struct ItemAddedEvent {
+    ItemId itemId;
+    std::int32_t count;
+    std::int32_t slotIndex;
+    InventoryCategory category;
+};
+
+// ========================================
+// 总线
+// ========================================
+
+class EventBus {
+public:
+    static EventBus& getInstance();
+
+    // 激活后才接收事件；关闭时清空所有队列（旧句柄不会留到下一局）
+    void setActive(bool value);
+    bool isActive() const { return active; }
+
+    template<typename E>
+    void push(const E& event) {
+        static_assert(std::is_trivially_copyable<E>::value, "events must be POD");
+        if (active) queue<E>().push_back(event);
+    }
+
+    // 按压入顺序处理并清空 E 类型的队列，返回处理的事件数
+    template<typename E, typename Handler>
+    size_t drain(Handler&& handler) {
+        std::vector<E>& events = queue<E>();
+        size_t i = 0;
+        for (; i < events.size(); i++) {
+            const E event = events[i];      // 处理中可能 push，先拷出来
+            handler(event);
+        }
+        events.clear();
+        return i;
+    }
+
+    template<typename E>
+    size_t pending() const { return std::get<std::vector<E>>(queues).size(); }
+
+    void clear();
+
+private:
+    EventBus() = default;
+    EventBus(const EventBus&) = delete;
+    EventBus& operator=(const EventBus&) = delete;
+
+    template<typename E>
+    std::vector<E>& queue() { return std::get<std::vector<E>>(queues); }
+
+    std::tuple<
+        std::vector<TreeDestroyedEvent>,
+        std::vector<TreeFruitHarvestedEvent>,
+        std::vector<TreeGrowthChangedEvent>,
+        std::vector<RabbitAttackEvent>,
+        std::vector<RabbitKilledEvent>,
+        std::vector<ItemAddedEvent>
+    > queues;
+    bool active = false;
+};
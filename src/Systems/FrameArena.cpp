@@ -0,0 +1,49 @@
+#include "FrameArena.h"
+#include <algorithm>
+#include <cstdint>
+
+FrameArena& FrameArena::getInstance() {
+    static FrameArena instance;
+    return instance;
+}
+
+FrameArena::FrameArena()
+    : buffer(new unsigned char[DEFAULT_CAPACITY])
+    , capacity(DEFAULT_CAPACITY)
+{
+}
+
+void* FrameArena::allocate(size_t bytes, size_t alignment) {
+    if (bytes == 0) bytes = 1;
+
+    const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(buffer.get());
+    const std::uintptr_t aligned = (base + offset + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+    const size_t start = static_cast<size_t>(aligned - base);
+    if (start + bytes <= capacity) {
+        offset = start + bytes;
+        return buffer.get() + start;
+    }
+
+    // 主块用完：单独申请，reset 时并入主块
+    const size_t size = bytes + alignment;
+    overflow.emplace_back(new unsigned char[size]);
+    overflowBytes += size;
+    const std::uintptr_t block = reinterpret_cast<std::uintptr_t>(overflow.back().get());
+    return reinterpret_cast<void*>((block + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1));
+}
+
+void FrameArena::reset() {
+    lastFramePeak = offset + overflowBytes;
+
+    if (!overflow.empty()) {
+        // 扩到峰值再留一半余量，避免负载稍有波动又溢出
+        size_t newCapacity = std::max(capacity * 2, lastFramePeak + lastFramePeak / 2);
+        overflow.clear();
+        buffer.reset(new unsigned char[newCapacity]);
+        capacity = newCapacity;
+        growCount++;
+    }
+
+    offset = 0;
+    overflowBytes = 0;
+}
@@ -0,0 +1,94 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// ============================================================================
+// 帧内存池 (Frame Arena)
+//
+// 每帧只活一帧的临时容器（查询结果、掉落列表、提示文字行）从这里线性分配，
+// 主循环在帧末尾 reset 一次，整帧的临时内存一起归还：
+//   FrameVector<Rabbit*> hit = rabbitManager->damageRabbitsInRange(...);
+//
+//   - 分配只是指针前移；deallocate 为空操作，帧末统一回收
+//   - 本帧用量超出容量时溢出部分单独向堆申请，下一次 reset 把主块扩大到
+//     本帧峰值，之后同样的负载每帧不再有堆分配
+//   - 帧外使用（基准测试、工具）用 FrameArena::Scope 在作用域结束时回退
+//
+// 注意：只能在主线程使用；FrameVector 不能保存到下一帧。
+// ============================================================================
+
+class FrameArena {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 64 * 1024;
+
+    static FrameArena& getInstance();
+
+    void* allocate(size_t bytes, size_t alignment);
+
+    // 帧末调用：回退到起点，并按本帧峰值扩容
+    void reset();
+
+    size_t getUsed() const { return offset + overflowBytes; }
+    size_t getCapacity() const { return capacity; }
+    size_t getLastFramePeak() const { return lastFramePeak; }
+    size_t getGrowCount() const { return growCount; }
+
+    // 作用域结束时回退到进入时的位置（溢出块留到 reset 回收）
+    class Scope {
+    public:
+        Scope() : arena(FrameArena::getInstance()), marker(arena.offset),
+                  overflowMarker(arena.overflow.size()) {}
+        ~Scope() {
+            if (arena.overflow.size() == overflowMarker) arena.offset = marker;
+        }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        FrameArena& arena;
+        size_t marker;
+        size_t overflowMarker;
+    };
+
+private:
+    FrameArena();
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    std::unique_ptr<unsigned char[]> buffer;
+    size_t capacity = 0;
+    size_t offset = 0;
+
+    std::vector<std::unique_ptr<unsigned char[]>> overflow;
+    size_t overflowBytes = 0;
+
+    size_t lastFramePeak = 0;
+    size_t growCount = 0;
+};
+
+// ============================================================================
+// 标准容器适配：FrameVector<T> 就是分配在帧内存池上的 std::vector
+// ============================================================================
+
+template<typename T>
+struct FrameAllocator {
+    using value_type = T;
+
+    FrameAllocator() noexcept = default;
+    template<typename U>
+    FrameAllocator(const FrameAllocator<U>&) noexcept {}
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(FrameArena::getInstance().allocate(n * sizeof(T), alignof(T)));
+    }
+    void deallocate(T*, size_t) noexcept {}
+
+    template<typename U>
+    bool operator==(const FrameAllocator<U>&) const noexcept { return true; }
+    template<typename U>
+    bool operator!=(const FrameAllocator<U>&) const noexcept { return false; }
+};
+
+template<typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
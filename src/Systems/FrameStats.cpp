@@ -0,0 +1,111 @@
+#include "FrameStats.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+std::uint64_t FrameStats::drawCalls = 0;
+std::uint64_t FrameStats::vertices = 0;
+
+namespace {
+    // 每线程分配计数（POD，无析构，线程退出时也能安全访问）
+    struct ThreadAllocCounters {
+        std::uint64_t allocations;
+        std::uint64_t bytes;
+    };
+
+    thread_local ThreadAllocCounters threadCounters = {0, 0};
+    std::atomic<AllocationHook> allocationHook{nullptr};
+}
+
+FrameCounters FrameStats::current() {
+    FrameCounters counters;
+    counters.drawCalls = drawCalls;
+    counters.vertices = vertices;
+    counters.allocations = threadCounters.allocations;
+    counters.allocatedBytes = threadCounters.bytes;
+    return counters;
+}
+
+std::uint64_t FrameStats::getThreadAllocations() {
+    return threadCounters.allocations;
+}
+
+std::uint64_t FrameStats::getThreadAllocatedBytes() {
+    return threadCounters.bytes;
+}
+
+void FrameStats::setAllocationHook(AllocationHook hook) {
+    allocationHook.store(hook, std::memory_order_release);
+}
+
+// ============================================================================
+// 全局 operator new / delete 替换
+// ============================================================================
+
+#if PF_TRACK_ALLOCATIONS
+
+namespace {
+    void* trackedAlloc(std::size_t size) {
+        if (size == 0) size = 1;
+        void* ptr = std::malloc(size);
+        if (ptr) {
+            threadCounters.allocations++;
+            threadCounters.bytes += size;
+            if (AllocationHook hook = allocationHook.load(std::memory_order_relaxed)) {
+                hook(ptr, size);
+            }
+        }
+        return ptr;
+    }
+
+    void* trackedAllocOrThrow(std::size_t size) {
+        while (true) {
+            if (void* ptr = trackedAlloc(size)) return ptr;
+            std::new_handler handler = std::get_new_handler();
+            if (!handler) throw std::bad_alloc();
+            handler();
+        }
+    }
+}
+
+void* operator new(std::size_t size) {
+    return trackedAllocOrThrow(size);
+}
+
+void* operator new[](std::size_t size) {
+    return trackedAllocOrThrow(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return trackedAlloc(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return trackedAlloc(size);
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+    std::free(ptr);
+}
+
+#endif
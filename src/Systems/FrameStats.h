@@ -0,0 +1,75 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// ============================================================================
+// 帧计数器 (Frame Stats)
+//
+// 两类计数，和 Profiler 的计时标记配合使用：
+//   - 绘制：RenderStats::draw(window, drawable) 代替 window.draw(drawable)，
+//           统计 draw call 次数和顶点数（见 RenderStats.h）
+//   - 堆分配：替换全局 operator new/delete，按线程统计分配次数和字节数；
+//             可以挂一个回调 (AllocationHook) 做更细的追踪
+//
+// ProfileScope 在进入/离开时各取一次 FrameStats::current()，差值就是该
+// 作用域（渲染 pass / 子系统）的计数，性能面板和回放报告直接显示。
+//
+// 编译开关：PF_TRACK_ALLOCATIONS=0 时不替换 operator new，分配计数恒为 0
+// （CMake 选项 PF_ENABLE_ALLOC_TRACKING 控制）。绘制计数始终开启。
+// ============================================================================
+
+#ifndef PF_TRACK_ALLOCATIONS
+#define PF_TRACK_ALLOCATIONS 1
+#endif
+
+// 一组计数（某个时间点的累计值，或两个时间点之间的差）
+struct FrameCounters {
+    std::uint64_t drawCalls = 0;
+    std::uint64_t vertices = 0;
+    std::uint64_t allocations = 0;
+    std::uint64_t allocatedBytes = 0;
+
+    FrameCounters& operator+=(const FrameCounters& other) {
+        drawCalls += other.drawCalls;
+        vertices += other.vertices;
+        allocations += other.allocations;
+        allocatedBytes += other.allocatedBytes;
+        return *this;
+    }
+
+    FrameCounters operator-(const FrameCounters& other) const {
+        FrameCounters result;
+        result.drawCalls = drawCalls - other.drawCalls;
+        result.vertices = vertices - other.vertices;
+        result.allocations = allocations - other.allocations;
+        result.allocatedBytes = allocatedBytes - other.allocatedBytes;
+        return result;
+    }
+};
+
+// 分配回调：每次 operator new 成功后调用（在分配它的线程上）
+// 回调内部不能再分配堆内存
+using AllocationHook = void (*)(void* ptr, std::size_t size);
+
+class FrameStats {
+public:
+    // 当前线程的累计分配 + 全局累计绘制
+    static FrameCounters current();
+
+    // 绘制计数（只在主线程调用）
+    static void addDraw(std::size_t vertexCount, std::size_t callCount = 1) {
+        drawCalls += callCount;
+        vertices += vertexCount;
+    }
+
+    // 当前线程的累计分配
+    static std::uint64_t getThreadAllocations();
+    static std::uint64_t getThreadAllocatedBytes();
+
+    static void setAllocationHook(AllocationHook hook);
+    static bool isAllocationTrackingEnabled() { return PF_TRACK_ALLOCATIONS != 0; }
+
+private:
+    static std::uint64_t drawCalls;
+    static std::uint64_t vertices;
+};
@@ -0,0 +1,306 @@
+#include "InputSystem.h"
+#include "Logger.h"
+#include <algorithm>
+
+// ============================================================================
+// 回放文件格式（小端，紧凑二进制）
+//
+//   文件头: "PFIR" | uint32 版本 | uint64 世界种子
+//   每帧:   float dt | uint16 动作 | int16 鼠标x | int16 鼠标y | uint16 事件数 | 事件...
+//   事件:   uint8 类型 | 按类型的负载（见 writeFrame）
+// ============================================================================
+
+namespace {
+
+const char REPLAY_MAGIC[4] = { 'P', 'F', 'I', 'R' };
+const std::uint32_t REPLAY_VERSION = 2;   // v2: 每帧事件数改为 uint16
+
+template <typename T>
+void writePod(std::ostream& out, T value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool readPod(std::istream& in, T& value) {
+    in.read(reinterpret_cast<char*>(&value), sizeof(T));
+    return static_cast<bool>(in);
+}
+
+std::uint16_t actionBit(InputAction action) {
+    return static_cast<std::uint16_t>(1u << static_cast<unsigned>(action));
+}
+
+} // namespace
+
+// ============================================================================
+// 单例
+// ============================================================================
+
+InputSystem& InputSystem::getInstance() {
+    static InputSystem instance;
+    return instance;
+}
+
+InputSystem::~InputSystem() {
+    stopRecording();
+}
+
+// ============================================================================
+// 每帧流程
+// ============================================================================
+
+void InputSystem::beginFrame(float dt, const sf::RenderWindow& window) {
+    current.dt = dt;
+    current.events.clear();
+    current.actions = 0;
+
+    auto sample = [this](InputAction action, sf::Keyboard::Key a, sf::Keyboard::Key b) {
+        if (sf::Keyboard::isKeyPressed(a) || (b != sf::Keyboard::Unknown && sf::Keyboard::isKeyPressed(b))) {
+            current.actions |= actionBit(action);
+        }
+    };
+
+    sample(InputAction::MoveUp,    sf::Keyboard::W,      sf::Keyboard::Up);
+    sample(InputAction::MoveDown,  sf::Keyboard::S,      sf::Keyboard::Down);
+    sample(InputAction::MoveLeft,  sf::Keyboard::A,      sf::Keyboard::Left);
+    sample(InputAction::MoveRight, sf::Keyboard::D,      sf::Keyboard::Right);
+    sample(InputAction::Attack,    sf::Keyboard::Space,  sf::Keyboard::Unknown);
+    sample(InputAction::Pickup,    sf::Keyboard::V,      sf::Keyboard::Unknown);
+    sample(InputAction::Modifier,  sf::Keyboard::LShift, sf::Keyboard::Unknown);
+
+    current.mousePosition = sf::Mouse::getPosition(window);
+}
+
+void InputSystem::recordEvent(const sf::Event& event) {
+    if (isRecording() && isRecordable(event)) {
+        current.events.push_back(event);
+    }
+}
+
+void InputSystem::endFrame() {
+    if (isRecording()) {
+        writeFrame(recordFile, current);
+    }
+}
+
+// ============================================================================
+// 查询
+// ============================================================================
+
+bool InputSystem::isDown(InputAction action) const {
+    return (current.actions & actionBit(action)) != 0;
+}
+
+bool InputSystem::isAnyMoveDown() const {
+    return isDown(InputAction::MoveUp) || isDown(InputAction::MoveDown) ||
+           isDown(InputAction::MoveLeft) || isDown(InputAction::MoveRight);
+}
+
+// ============================================================================
+// 录制
+// ============================================================================
+
+bool InputSystem::startRecording(const std::string& path, std::uint64_t worldSeed) {
+    stopRecording();
+
+    recordFile.open(path, std::ios::binary | std::ios::trunc);
+    if (!recordFile.is_open()) {
+        LOG_ERROR("[Input] 无法创建录制文件: " << path);
+        return false;
+    }
+
+    recordFile.write(REPLAY_MAGIC, sizeof(REPLAY_MAGIC));
+    writePod(recordFile, REPLAY_VERSION);
+    writePod(recordFile, worldSeed);
+
+    LOG_INFO("[Input] 开始录制: " << path);
+    return true;
+}
+
+void InputSystem::stopRecording() {
+    if (recordFile.is_open()) {
+        recordFile.close();
+        LOG_INFO("[Input] 录制结束");
+    }
+}
+
+// ============================================================================
+// 回放
+// ============================================================================
+
+bool InputSystem::loadReplay(const std::string& path, std::uint64_t& outSeed) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) {
+        LOG_ERROR("[Input] 无法打开回放文件: " << path);
+        return false;
+    }
+
+    char magic[4];
+    std::uint32_t version = 0;
+    in.read(magic, sizeof(magic));
+    if (!in || std::string(magic, 4) != std::string(REPLAY_MAGIC, 4) ||
+        !readPod(in, version) || version != REPLAY_VERSION ||
+        !readPod(in, outSeed)) {
+        LOG_ERROR("[Input] 回放文件格式错误或版本不符（需要 v" << REPLAY_VERSION << "）: " << path);
+        return false;
+    }
+
+    replayFrames.clear();
+    InputFrame frame;
+    while (readFrame(in, frame)) {
+        replayFrames.push_back(frame);
+    }
+
+    replaying = true;
+    replayCursor = 0;
+
+    LOG_INFO("[Input] 回放已加载: " << replayFrames.size() << " 帧");
+    return true;
+}
+
+void InputSystem::loadFrames(std::vector<InputFrame> frames) {
+    replayFrames = std::move(frames);
+    replaying = true;
+    replayCursor = 0;
+
+    LOG_INFO("[Input] 脚本输入已加载: " << replayFrames.size() << " 帧");
+}
+
+const InputFrame& InputSystem::advanceReplay() {
+    current = replayFrames[replayCursor++];
+    return current;
+}
+
+// ============================================================================
+// 序列化
+// ============================================================================
+
+bool InputSystem::isRecordable(const sf::Event& event) {
+    switch (event.type) {
+        case sf::Event::KeyPressed:
+        case sf::Event::KeyReleased:
+        case sf::Event::MouseButtonPressed:
+        case sf::Event::MouseButtonReleased:
+        case sf::Event::MouseMoved:
+        case sf::Event::MouseWheelScrolled:
+            return true;
+        default:
+            return false;
+    }
+}
+
+void InputSystem::writeFrame(std::ostream& out, const InputFrame& frame) {
+    writePod(out, frame.dt);
+    writePod(out, frame.actions);
+    writePod(out, static_cast<std::int16_t>(frame.mousePosition.x));
+    writePod(out, static_cast<std::int16_t>(frame.mousePosition.y));
+
+    // 超出上限的事件无法回放，录制会与实际输入分叉，必须报错
+    if (frame.events.size() > 0xFFFF) {
+        LOG_ERROR("[Input] 单帧事件数 " << frame.events.size()
+                  << " 超过上限 65535，多余事件未录制，回放将不一致");
+    }
+    std::uint16_t count = static_cast<std::uint16_t>(std::min<size_t>(frame.events.size(), 0xFFFF));
+    writePod(out, count);
+
+    for (std::uint16_t i = 0; i < count; i++) {
+        const sf::Event& e = frame.events[i];
+        writePod(out, static_cast<std::uint8_t>(e.type));
+
+        switch (e.type) {
+            case sf::Event::KeyPressed:
+            case sf::Event::KeyReleased: {
+                std::uint8_t mods = (e.key.alt ? 1 : 0) | (e.key.control ? 2 : 0) |
+                                    (e.key.shift ? 4 : 0) | (e.key.system ? 8 : 0);
+                writePod(out, static_cast<std::int16_t>(e.key.code));
+                writePod(out, mods);
+                break;
+            }
+            case sf::Event::MouseButtonPressed:
+            case sf::Event::MouseButtonReleased:
+                writePod(out, static_cast<std::uint8_t>(e.mouseButton.button));
+                writePod(out, static_cast<std::int16_t>(e.mouseButton.x));
+                writePod(out, static_cast<std::int16_t>(e.mouseButton.y));
+                break;
+            case sf::Event::MouseMoved:
+                writePod(out, static_cast<std::int16_t>(e.mouseMove.x));
+                writePod(out, static_cast<std::int16_t>(e.mouseMove.y));
+                break;
+            case sf::Event::MouseWheelScrolled:
+                writePod(out, static_cast<std::uint8_t>(e.mouseWheelScroll.wheel));
+                writePod(out, e.mouseWheelScroll.delta);
+                writePod(out, static_cast<std::int16_t>(e.mouseWheelScroll.x));
+                writePod(out, static_cast<std::int16_t>(e.mouseWheelScroll.y));
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+bool InputSystem::readFrame(std::istream& in, InputFrame& frame) {
+    std::int16_t mx = 0, my = 0;
+    std::uint16_t count = 0;
+
+    if (!readPod(in, frame.dt) || !readPod(in, frame.actions) ||
+        !readPod(in, mx) || !readPod(in, my) || !readPod(in, count)) {
+        return false;
+    }
+    frame.mousePosition = sf::Vector2i(mx, my);
+    frame.events.clear();
+
+    for (std::uint16_t i = 0; i < count; i++) {
+        std::uint8_t type = 0;
+        if (!readPod(in, type)) return false;
+
+        sf::Event e;
+        e.type = static_cast<sf::Event::EventType>(type);
+
+        std::int16_t x = 0, y = 0;
+        switch (e.type) {
+            case sf::Event::KeyPressed:
+            case sf::Event::KeyReleased: {
+                std::int16_t code = 0;
+                std::uint8_t mods = 0;
+                if (!readPod(in, code) || !readPod(in, mods)) return false;
+                e.key.code = static_cast<sf::Keyboard::Key>(code);
+                e.key.alt = (mods & 1) != 0;
+                e.key.control = (mods & 2) != 0;
+                e.key.shift = (mods & 4) != 0;
+                e.key.system = (mods & 8) != 0;
+                break;
+            }
+            case sf::Event::MouseButtonPressed:
+            case sf::Event::MouseButtonReleased: {
+                std::uint8_t button = 0;
+                if (!readPod(in, button) || !readPod(in, x) || !readPod(in, y)) return false;
+                e.mouseButton.button = static_cast<sf::Mouse::Button>(button);
+                e.mouseButton.x = x;
+                e.mouseButton.y = y;
+                break;
+            }
+            case sf::Event::MouseMoved:
+                if (!readPod(in, x) || !readPod(in, y)) return false;
+                e.mouseMove.x = x;
+                e.mouseMove.y = y;
+                break;
+            case sf::Event::MouseWheelScrolled: {
+                std::uint8_t wheel = 0;
+                float delta = 0.0f;
+                if (!readPod(in, wheel) || !readPod(in, delta) ||
+                    !readPod(in, x) || !readPod(in, y)) return false;
+                e.mouseWheelScroll.wheel = static_cast<sf::Mouse::Wheel>(wheel);
+                e.mouseWheelScroll.delta = delta;
+                e.mouseWheelScroll.x = x;
+                e.mouseWheelScroll.y = y;
+                break;
+            }
+            default:
+                return false;
+        }
+
+        frame.events.push_back(e);
+    }
+
+    return true;
+}
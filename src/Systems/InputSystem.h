@@ -0,0 +1,117 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// 输入系统 (Input System)
+//
+// 核心概念：
+//   1. 动作 (InputAction) - 游戏逻辑只查询"动作"，不直接查询键盘
+//   2. 输入帧 (InputFrame) - 每帧的 dt + 动作位掩码 + 鼠标位置 + 事件列表
+//   3. 录制 (Record) - 实时游戏时把每一帧写入文件（附带世界种子）
+//   4. 回放 (Replay) - 从文件读取输入帧，无渲染、不限帧率地重跑模拟
+//
+// 动作状态与鼠标位置在每帧开始时采样一次，整帧内保持不变，
+// 因此实时运行与回放看到的输入完全一致。
+//
+// 使用方式：
+//   - 移动/攻击：InputSystem::getInstance().isDown(InputAction::MoveUp)
+//   - 鼠标悬停：InputSystem::getInstance().getMousePosition()
+//   - 启动参数：--record <file> 录制，--replay <file> 回放
+// ============================================================================
+
+// 输入动作
+enum class InputAction : std::uint8_t {
+    MoveUp,     // W / ↑
+    MoveDown,   // S / ↓
+    MoveLeft,   // A / ←
+    MoveRight,  // D / →
+    Attack,     // 空格
+    Pickup,     // V
+    Modifier,   // 左Shift（快捷操作）
+    Count
+};
+
+// 单帧输入
+struct InputFrame {
+    float dt = 0.0f;
+    std::uint16_t actions = 0;          // 按位对应 InputAction
+    sf::Vector2i mousePosition;         // 窗口坐标
+    std::vector<sf::Event> events;      // 本帧需要分发给状态的事件
+
+    void setDown(InputAction action) {
+        actions = static_cast<std::uint16_t>(actions | (1u << static_cast<unsigned>(action)));
+    }
+};
+
+class InputSystem {
+public:
+    static InputSystem& getInstance();
+
+    // ========================================
+    // 每帧流程（实时模式）
+    // ========================================
+
+    // 帧开始：采样键盘和鼠标
+    void beginFrame(float dt, const sf::RenderWindow& window);
+
+    // 记录本帧的事件（仅录制时写入）
+    void recordEvent(const sf::Event& event);
+
+    // 帧结束：录制时写入文件
+    void endFrame();
+
+    // ========================================
+    // 查询接口（实时/回放通用）
+    // ========================================
+    bool isDown(InputAction action) const;
+    bool isAnyMoveDown() const;
+    sf::Vector2i getMousePosition() const { return current.mousePosition; }
+
+    // ========================================
+    // 录制
+    // ========================================
+    bool startRecording(const std::string& path, std::uint64_t worldSeed);
+    void stopRecording();
+    bool isRecording() const { return recordFile.is_open(); }
+
+    // ========================================
+    // 回放
+    // ========================================
+
+    // 加载回放文件（outSeed 返回录制时的世界种子）
+    bool loadReplay(const std::string& path, std::uint64_t& outSeed);
+    bool isReplaying() const { return replaying; }
+    bool hasReplayFrames() const { return replayCursor < replayFrames.size(); }
+    size_t getReplayFrameCount() const { return replayFrames.size(); }
+
+    // 直接使用程序生成的输入帧（脚本输入，基准测试用）
+    void loadFrames(std::vector<InputFrame> frames);
+
+    // 前进到下一帧回放输入（返回该帧，供分发事件和取 dt）
+    const InputFrame& advanceReplay();
+
+private:
+    InputSystem() = default;
+    InputSystem(const InputSystem&) = delete;
+    InputSystem& operator=(const InputSystem&) = delete;
+    ~InputSystem();
+
+    // 是否需要录制该事件（只保留游戏逻辑用到的类型）
+    static bool isRecordable(const sf::Event& event);
+
+    static void writeFrame(std::ostream& out, const InputFrame& frame);
+    static bool readFrame(std::istream& in, InputFrame& frame);
+
+private:
+    InputFrame current;
+
+    std::ofstream recordFile;
+
+    bool replaying = false;
+    std::vector<InputFrame> replayFrames;
+    size_t replayCursor = 0;
+};
@@ -0,0 +1,290 @@
+#include "Json.h"
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+// ============================================================================
+// 解析器
+// ============================================================================
+
+class JsonParser {
+public:
+    explicit JsonParser(const std::string& text) : text(text) {}
+
+    bool parseDocument(JsonValue& out) {
+        skipWhitespace();
+        if (!parseValue(out, 0)) return false;
+        skipWhitespace();
+        if (pos != text.size()) return fail("多余的内容");
+        return true;
+    }
+
+    std::string getError() const {
+        return "第 " + std::to_string(line) + " 行: " + error;
+    }
+
+private:
+    static constexpr int MAX_DEPTH = 64;
+
+    bool parseValue(JsonValue& out, int depth) {
+        if (depth > MAX_DEPTH) return fail("嵌套过深");
+        if (pos >= text.size()) return fail("意外的文件结尾");
+
+        char c = text[pos];
+        switch (c) {
+            case '{': return parseObject(out, depth);
+            case '[': return parseArray(out, depth);
+            case '"':
+                out.type = JsonValue::Type::String;
+                return parseString(out.stringValue);
+            case 't': return parseLiteral("true", out, JsonValue::Type::Bool, true);
+            case 'f': return parseLiteral("false", out, JsonValue::Type::Bool, false);
+            case 'n': return parseLiteral("null", out, JsonValue::Type::Null, false);
+            default:
+                if (c == '-' || (c >= '0' && c <= '9')) return parseNumber(out);
+                return fail(std::string("无法识别的字符 '") + c + "'");
+        }
+    }
+
+    bool parseObject(JsonValue& out, int depth) {
+        out.type = JsonValue::Type::Object;
+        pos++;  // '{'
+        skipWhitespace();
+        if (consume('}')) return true;
+
+        while (true) {
+            skipWhitespace();
+            std::string key;
+            if (pos >= text.size() || text[pos] != '"') return fail("对象字段名必须是字符串");
+            if (!parseString(key)) return false;
+
+            skipWhitespace();
+            if (!consume(':')) return fail("缺少 ':'");
+            skipWhitespace();
+
+            out.objectValue.emplace_back(std::move(key), JsonValue());
+            if (!parseValue(out.objectValue.back().second, depth + 1)) return false;
+
+            skipWhitespace();
+            if (consume('}')) return true;
+            if (!consume(',')) return fail("缺少 ',' 或 '}'");
+        }
+    }
+
+    bool parseArray(JsonValue& out, int depth) {
+        out.type = JsonValue::Type::Array;
+        pos++;  // '['
+        skipWhitespace();
+        if (consume(']')) return true;
+
+        while (true) {
+            skipWhitespace();
+            out.arrayValue.emplace_back();
+            if (!parseValue(out.arrayValue.back(), depth + 1)) return false;
+
+            skipWhitespace();
+            if (consume(']')) return true;
+            if (!consume(',')) return fail("缺少 ',' 或 ']'");
+        }
+    }
+
+    bool parseString(std::string& out) {
+        pos++;  // '"'
+        while (pos < text.size()) {
+            char c = text[pos++];
+            if (c == '"') return true;
+            if (c == '\n') return fail("字符串未闭合");
+            if (c != '\\') {
+                out += c;
+                continue;
+            }
+
+            if (pos >= text.size()) break;
+            char e = text[pos++];
+            switch (e) {
+                case '"':  out += '"'; break;
+                case '\\': out += '\\'; break;
+                case '/':  out += '/'; break;
+                case 'b':  out += '\b'; break;
+                case 'f':  out += '\f'; break;
+                case 'n':  out += '\n'; break;
+                case 'r':  out += '\r'; break;
+                case 't':  out += '\t'; break;
+                case 'u': {
+                    unsigned codepoint = 0;
+                    if (!parseHex4(codepoint)) return false;
+                    // 代理对
+                    if (codepoint >= 0xD800 && codepoint <= 0xDBFF &&
+                        pos + 1 < text.size() && text[pos] == '\\' && text[pos + 1] == 'u') {
+                        pos += 2;
+                        unsigned low = 0;
+                        if (!parseHex4(low)) return false;
+                        codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (low - 0xDC00);
+                    }
+                    appendUtf8(out, codepoint);
+                    break;
+                }
+                default:
+                    return fail(std::string("无效的转义 '\\") + e + "'");
+            }
+        }
+        return fail("字符串未闭合");
+    }
+
+    bool parseHex4(unsigned& out) {
+        if (pos + 4 > text.size()) return fail("\\u 转义不完整");
+        out = 0;
+        for (int i = 0; i < 4; i++) {
+            char h = text[pos++];
+            out <<= 4;
+            if (h >= '0' && h <= '9') out |= static_cast<unsigned>(h - '0');
+            else if (h >= 'a' && h <= 'f') out |= static_cast<unsigned>(h - 'a' + 10);
+            else if (h >= 'A' && h <= 'F') out |= static_cast<unsigned>(h - 'A' + 10);
+            else return fail("\\u 转义包含非十六进制字符");
+        }
+        return true;
+    }
+
+    static void appendUtf8(std::string& out, unsigned cp) {
+        if (cp < 0x80) {
+            out += static_cast<char>(cp);
+        } else if (cp < 0x800) {
+            out += static_cast<char>(0xC0 | (cp >> 6));
+            out += static_cast<char>(0x80 | (cp & 0x3F));
+        } else if (cp < 0x10000) {
+            out += static_cast<char>(0xE0 | (cp >> 12));
+            out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (cp & 0x3F));
+        } else {
+            out += static_cast<char>(0xF0 | (cp >> 18));
+            out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (cp & 0x3F));
+        }
+    }
+
+    bool parseNumber(JsonValue& out) {
+        const char* begin = text.c_str() + pos;
+        char* end = nullptr;
+        double value = std::strtod(begin, &end);
+        if (end == begin) return fail("无效的数字");
+        pos += static_cast<size_t>(end - begin);
+        out.type = JsonValue::Type::Number;
+        out.numberValue = value;
+        return true;
+    }
+
+    bool parseLiteral(const char* literal, JsonValue& out, JsonValue::Type t, bool value) {
+        size_t length = std::char_traits<char>::length(literal);
+        if (text.compare(pos, length, literal) != 0) return fail("无法识别的字面量");
+        pos += length;
+        out.type = t;
+        out.boolValue = value;
+        return true;
+    }
+
+    void skipWhitespace() {
+        while (pos < text.size()) {
+            char c = text[pos];
+            if (c == '\n') line++;
+            else if (c != ' ' && c != '\t' && c != '\r') break;
+            pos++;
+        }
+    }
+
+    bool consume(char c) {
+        if (pos < text.size() && text[pos] == c) {
+            pos++;
+            return true;
+        }
+        return false;
+    }
+
+    bool fail(const std::string& message) {
+        if (error.empty()) error = message;
+        return false;
+    }
+
+private:
+    const std::string& text;
+    size_t pos = 0;
+    int line = 1;
+    std::string error;
+};
+
+// ============================================================================
+// JsonValue
+// ============================================================================
+
+bool JsonValue::parse(const std::string& text, JsonValue& out, std::string& error) {
+    out = JsonValue();
+    JsonParser parser(text);
+    if (!parser.parseDocument(out)) {
+        error = parser.getError();
+        return false;
+    }
+    return true;
+}
+
+bool JsonValue::parseFile(const std::string& path, JsonValue& out, std::string& error) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        error = "无法打开文件: " + path;
+        return false;
+    }
+
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    if (!parse(buffer.str(), out, error)) {
+        error = path + " " + error;
+        return false;
+    }
+    return true;
+}
+
+namespace {
+const std::string EMPTY_STRING;
+const JsonValue::Array EMPTY_ARRAY;
+const JsonValue::Object EMPTY_OBJECT;
+const JsonValue NULL_VALUE;
+}
+
+const std::string& JsonValue::asString() const {
+    return type == Type::String ? stringValue : EMPTY_STRING;
+}
+
+const JsonValue::Array& JsonValue::asArray() const {
+    return type == Type::Array ? arrayValue : EMPTY_ARRAY;
+}
+
+const JsonValue::Object& JsonValue::asObject() const {
+    return type == Type::Object ? objectValue : EMPTY_OBJECT;
+}
+
+const JsonValue& JsonValue::operator[](const std::string& key) const {
+    for (const auto& field : asObject()) {
+        if (field.first == key) return field.second;
+    }
+    return NULL_VALUE;
+}
+
+bool JsonValue::has(const std::string& key) const {
+    return !(*this)[key].isNull();
+}
+
+std::string JsonValue::getString(const std::string& key, const std::string& def) const {
+    const JsonValue& v = (*this)[key];
+    return v.isString() ? v.stringValue : def;
+}
+
+int JsonValue::getInt(const std::string& key, int def) const {
+    return (*this)[key].asInt(def);
+}
+
+float JsonValue::getFloat(const std::string& key, float def) const {
+    return (*this)[key].asFloat(def);
+}
+
+bool JsonValue::getBool(const std::string& key, bool def) const {
+    return (*this)[key].asBool(def);
+}
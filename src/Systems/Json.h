@@ -0,0 +1,84 @@
+#pragma once
+#include <string>
+#include <utility>
+#include <vector>
+
+// ============================================================================
+// JSON 读取 (Json)
+//
+// 只用于读取数据定义文件（assets/data/*.json），不追求性能：
+//   - 支持对象、数组、字符串（含 \uXXXX 转义）、数字、true/false/null
+//   - 对象保持文件中的字段顺序
+//   - 取值接口带默认值，缺失字段直接返回默认值
+//
+// 使用方式：
+//   JsonValue root;
+//   std::string error;
+//   if (JsonValue::parse(text, root, error)) {
+//       for (const auto& item : root["items"].asArray()) { ... }
+//   }
+// ============================================================================
+
+class JsonValue {
+public:
+    enum class Type {
+        Null,
+        Bool,
+        Number,
+        String,
+        Array,
+        Object
+    };
+
+    using Array = std::vector<JsonValue>;
+    using Object = std::vector<std::pair<std::string, JsonValue>>;
+
+    JsonValue() = default;
+
+    // 解析文本（失败时 error 包含行号和原因）
+    static bool parse(const std::string& text, JsonValue& out, std::string& error);
+
+    // 读取文件并解析
+    static bool parseFile(const std::string& path, JsonValue& out, std::string& error);
+
+    // ========================================
+    // 类型查询
+    // ========================================
+    Type getType() const { return type; }
+    bool isNull() const { return type == Type::Null; }
+    bool isObject() const { return type == Type::Object; }
+    bool isArray() const { return type == Type::Array; }
+    bool isString() const { return type == Type::String; }
+    bool isNumber() const { return type == Type::Number; }
+
+    // ========================================
+    // 取值（类型不符时返回默认值）
+    // ========================================
+    bool asBool(bool def = false) const { return type == Type::Bool ? boolValue : def; }
+    double asNumber(double def = 0.0) const { return type == Type::Number ? numberValue : def; }
+    int asInt(int def = 0) const { return type == Type::Number ? static_cast<int>(numberValue) : def; }
+    float asFloat(float def = 0.0f) const { return type == Type::Number ? static_cast<float>(numberValue) : def; }
+    const std::string& asString() const;
+    const Array& asArray() const;
+    const Object& asObject() const;
+
+    // 对象字段（不存在时返回 null 值）
+    const JsonValue& operator[](const std::string& key) const;
+    bool has(const std::string& key) const;
+
+    // 便捷取值
+    std::string getString(const std::string& key, const std::string& def = "") const;
+    int getInt(const std::string& key, int def = 0) const;
+    float getFloat(const std::string& key, float def = 0.0f) const;
+    bool getBool(const std::string& key, bool def = false) const;
+
+private:
+    friend class JsonParser;
+
+    Type type = Type::Null;
+    bool boolValue = false;
+    double numberValue = 0.0;
+    std::string stringValue;
+    Array arrayValue;
+    Object objectValue;
+};
@@ -0,0 +1,311 @@
+#include "Logger.h"
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+
+namespace {
+    std::uint64_t steadyMicros() {
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    const char* levelTag(LogLevel level) {
+        switch (level) {
+            case LogLevel::Debug: return "DEBUG";
+            case LogLevel::Info:  return "INFO ";
+            case LogLevel::Warn:  return "WARN ";
+            case LogLevel::Error: return "ERROR";
+            default:              return "?    ";
+        }
+    }
+
+    std::terminate_handler previousTerminate = nullptr;
+
+    void onTerminate() {
+        Logger::getInstance().crashFlush();
+        if (previousTerminate) previousTerminate();
+        std::abort();
+    }
+
+    void onCrashSignal(int sig) {
+        Logger::getInstance().crashFlush();
+        std::signal(sig, SIG_DFL);
+        std::raise(sig);
+    }
+}
+
+// ============================================================================
+// LogLine
+// ============================================================================
+
+LogLine::LogLine(LogLevel level) {
+    record.timestampUs = Logger::getInstance().now();
+    record.level = level;
+    record.length = 0;
+}
+
+LogLine::~LogLine() {
+    Logger::getInstance().submit(record);
+}
+
+void LogLine::append(const char* data, size_t n) {
+    size_t room = LogRecord::MAX_TEXT - record.length;
+    if (n > room) n = room;
+    std::memcpy(record.text + record.length, data, n);
+    record.length = static_cast<std::uint16_t>(record.length + n);
+}
+
+LogLine& LogLine::operator<<(const char* s) {
+    if (s) append(s, std::strlen(s));
+    return *this;
+}
+
+LogLine& LogLine::operator<<(const std::string& s) {
+    append(s.data(), s.size());
+    return *this;
+}
+
+LogLine& LogLine::operator<<(char c) {
+    append(&c, 1);
+    return *this;
+}
+
+LogLine& LogLine::operator<<(bool b) {
+    return *this << (b ? "true" : "false");
+}
+
+LogLine& LogLine::operator<<(double v) {
+    char buf[32];
+    int n = std::snprintf(buf, sizeof(buf), "%g", v);
+    if (n > 0) append(buf, static_cast<size_t>(n));
+    return *this;
+}
+
+void LogLine::appendSigned(long long v) {
+    if (v < 0) {
+        append("-", 1);
+        appendUnsigned(0ULL - static_cast<unsigned long long>(v));
+    } else {
+        appendUnsigned(static_cast<unsigned long long>(v));
+    }
+}
+
+void LogLine::appendUnsigned(unsigned long long v) {
+    char buf[24];
+    char* p = buf + sizeof(buf);
+    do {
+        *--p = static_cast<char>('0' + v % 10);
+        v /= 10;
+    } while (v != 0);
+    append(p, static_cast<size_t>(buf + sizeof(buf) - p));
+}
+
+// ============================================================================
+// Logger
+// ============================================================================
+
+Logger& Logger::getInstance() {
+    static Logger instance;
+    return instance;
+}
+
+Logger::~Logger() {
+    stop();
+}
+
+std::uint64_t Logger::now() const {
+    return steadyMicros() - startTicks;
+}
+
+bool Logger::start(const std::string& filePath, bool toConsole) {
+    if (running.load()) return true;
+
+    console = toConsole;
+    if (!filePath.empty()) {
+        file.open(filePath);
+    }
+    startTicks = steadyMicros();
+    batch.reserve(16 * 1024);
+
+    stopRequested = false;
+    running = true;
+    writer = std::thread(&Logger::writerLoop, this);
+    return filePath.empty() || file.is_open();
+}
+
+void Logger::stop() {
+    if (!running.load()) return;
+
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        stopRequested = true;
+    }
+    wakeCv.notify_one();
+    if (writer.joinable()) writer.join();
+    running = false;
+
+    // 写线程退出后仍可能有极少量新提交，同步写出
+    drainAll();
+
+    std::lock_guard<std::mutex> lock(outputMutex);
+    if (dropped.load() > 0) {
+        std::fprintf(stderr, "[Logger] %llu 条日志因缓冲区已满被丢弃\n",
+                     static_cast<unsigned long long>(dropped.load()));
+    }
+    if (file.is_open()) file.close();
+}
+
+void Logger::flush() {
+    if (!running.load()) return;
+
+    // submitted 只统计真正进入缓冲区的记录；被丢弃的不计入，不能用来凑数提前返回
+    std::uint64_t target = submitted.load(std::memory_order_acquire);
+    std::unique_lock<std::mutex> lock(wakeMutex);
+    wakeCv.notify_one();
+    flushedCv.wait(lock, [this, target] {
+        return written.load(std::memory_order_acquire) >= target || !running.load();
+    });
+}
+
+void Logger::installCrashHandlers() {
+    previousTerminate = std::set_terminate(onTerminate);
+    std::signal(SIGSEGV, onCrashSignal);
+    std::signal(SIGABRT, onCrashSignal);
+    std::signal(SIGFPE, onCrashSignal);
+    std::signal(SIGILL, onCrashSignal);
+}
+
+Logger::ThreadBuffer* Logger::localBuffer() {
+    thread_local ThreadBuffer* buffer = nullptr;
+    if (!buffer) {
+        auto owned = std::make_unique<ThreadBuffer>();
+        buffer = owned.get();
+        std::lock_guard<std::mutex> lock(buffersMutex);
+        buffers.push_back(std::move(owned));
+    }
+    return buffer;
+}
+
+void Logger::submit(const LogRecord& record) {
+    if (!running.load(std::memory_order_acquire)) {
+        writeDirect(record);
+        return;
+    }
+
+    ThreadBuffer* buffer = localBuffer();
+    std::uint32_t tail = buffer->tail.load(std::memory_order_relaxed);
+    std::uint32_t head = buffer->head.load(std::memory_order_acquire);
+    if (tail - head >= ThreadBuffer::CAPACITY) {
+        // 写线程跟不上：宁可丢日志也不阻塞游戏线程（错误日志除外，等缓冲区腾出再写）
+        if (record.level < LogLevel::Error) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        flush();
+        head = buffer->head.load(std::memory_order_acquire);
+        if (tail - head >= ThreadBuffer::CAPACITY) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    }
+
+    buffer->slots[tail % ThreadBuffer::CAPACITY] = record;
+    buffer->tail.store(tail + 1, std::memory_order_release);
+    submitted.fetch_add(1, std::memory_order_release);
+
+    // 错误日志：等待落盘后再返回，保证崩溃前的最后几行不丢
+    if (record.level >= LogLevel::Error) {
+        flush();
+    }
+}
+
+void Logger::writerLoop() {
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(wakeMutex);
+            wakeCv.wait_for(lock, std::chrono::milliseconds(WRITER_INTERVAL_MS));
+        }
+
+        drainAll();
+        flushedCv.notify_all();
+
+        if (stopRequested.load()) {
+            drainAll();
+            flushedCv.notify_all();
+            break;
+        }
+    }
+}
+
+size_t Logger::drainAll() {
+    std::lock_guard<std::mutex> outputLock(outputMutex);
+    return drainLocked();
+}
+
+size_t Logger::drainLocked() {
+    std::vector<ThreadBuffer*> snapshot;
+    {
+        std::lock_guard<std::mutex> lock(buffersMutex);
+        snapshot.reserve(buffers.size());
+        for (auto& buffer : buffers) snapshot.push_back(buffer.get());
+    }
+
+    // 各线程缓冲区内部有序；跨线程按时间戳归并意义不大，逐个写出
+    size_t count = 0;
+    batch.clear();
+    for (ThreadBuffer* buffer : snapshot) {
+        std::uint32_t head = buffer->head.load(std::memory_order_relaxed);
+        std::uint32_t tail = buffer->tail.load(std::memory_order_acquire);
+        for (; head != tail; head++) {
+            writeRecord(buffer->slots[head % ThreadBuffer::CAPACITY], batch);
+            count++;
+        }
+        buffer->head.store(head, std::memory_order_release);
+    }
+
+    if (count > 0) {
+        if (console) {
+            std::fwrite(batch.data(), 1, batch.size(), stdout);
+            std::fflush(stdout);
+        }
+        if (file.is_open()) {
+            file.write(batch.data(), static_cast<std::streamsize>(batch.size()));
+            file.flush();
+        }
+        written.fetch_add(count, std::memory_order_release);
+    }
+    return count;
+}
+
+void Logger::writeRecord(const LogRecord& record, std::string& out) const {
+    char prefix[32];
+    unsigned long long ms = static_cast<unsigned long long>(record.timestampUs / 1000);
+    int n = std::snprintf(prefix, sizeof(prefix), "[%6llu.%03llu] %s ",
+                          ms / 1000, ms % 1000, levelTag(record.level));
+    if (n > 0) out.append(prefix, static_cast<size_t>(n));
+    out.append(record.text, record.length);
+    out += '\n';
+}
+
+void Logger::writeDirect(const LogRecord& record) {
+    std::lock_guard<std::mutex> lock(outputMutex);
+    std::FILE* stream = record.level >= LogLevel::Warn ? stderr : stdout;
+    std::fwrite(record.text, 1, record.length, stream);
+    std::fputc('\n', stream);
+}
+
+void Logger::crashFlush() {
+    if (!running.load()) return;
+
+    // 写线程可能正在输出，稍等；若崩溃的正是持锁线程则放弃以免死锁
+    for (int attempt = 0; attempt < CRASH_LOCK_ATTEMPTS; attempt++) {
+        if (outputMutex.try_lock()) {
+            drainLocked();
+            outputMutex.unlock();
+            return;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
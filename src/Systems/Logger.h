@@ -0,0 +1,185 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// ============================================================================
+// 日志系统 (Logger)
+//
+// 替代散落在各处的 std::cout：
+//   - 分级：Debug / Info / Warn / Error
+//   - 编译期过滤：低于 PF_LOG_LEVEL 的日志整条语句被编译掉
+//     （Debug 构建默认 0 全部保留，Release 构建默认 1 去掉 Debug）
+//   - 调用线程只把文本拼进栈上的定长记录，再放入本线程的无锁环形缓冲区
+//   - 后台写线程加时间戳/级别前缀，批量写入控制台和日志文件
+//
+// 崩溃保护（保持旧 log() "不丢最后几行" 的保证）：
+//   - Error 级别的日志会等待写线程落盘后才返回
+//   - installCrashHandlers() 注册 terminate/信号处理，崩溃时同步写出所有缓冲
+//
+// 使用方式：
+//   LOG_INFO("[Tree] " << name << " took " << damage << " damage");
+//   LOG_DEBUG("[Attack] Hit " << count << " tree(s)");
+//
+// Logger 未启动时（如 DefBaker 等工具）日志直接同步输出到控制台。
+// ============================================================================
+
+#ifndef PF_LOG_LEVEL
+#define PF_LOG_LEVEL 0
+#endif
+
+enum class LogLevel : std::uint8_t {
+    Debug = 0,
+    Info = 1,
+    Warn = 2,
+    Error = 3
+};
+
+// 单条日志记录（POD，定长，超长部分截断）
+struct LogRecord {
+    static constexpr size_t MAX_TEXT = 240;
+
+    std::uint64_t timestampUs;      // 自 Logger 启动以来的微秒数
+    LogLevel level;
+    std::uint16_t length;
+    char text[MAX_TEXT];
+};
+
+// ============================================================================
+// 日志行构造器（栈上对象，析构时提交）
+// ============================================================================
+
+class LogLine {
+public:
+    explicit LogLine(LogLevel level);
+    ~LogLine();
+
+    LogLine(const LogLine&) = delete;
+    LogLine& operator=(const LogLine&) = delete;
+
+    LogLine& operator<<(const char* s);
+    LogLine& operator<<(const std::string& s);
+    LogLine& operator<<(char c);
+    LogLine& operator<<(bool b);
+    LogLine& operator<<(double v);
+
+    template<typename T, typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
+    LogLine& operator<<(T v) {
+        if (std::is_signed<T>::value) appendSigned(static_cast<long long>(v));
+        else appendUnsigned(static_cast<unsigned long long>(v));
+        return *this;
+    }
+
+private:
+    void append(const char* data, size_t n);
+    void appendSigned(long long v);
+    void appendUnsigned(unsigned long long v);
+
+    LogRecord record;
+};
+
+// ============================================================================
+// 日志管理器（单例）
+// ============================================================================
+
+class Logger {
+public:
+    static Logger& getInstance();
+
+    // 启动后台写线程（filePath 为空则只输出到控制台）
+    bool start(const std::string& filePath, bool console = true);
+
+    // 写出剩余日志并停止写线程
+    void stop();
+
+    // 阻塞直到此前提交的日志全部写出
+    void flush();
+
+    // 注册崩溃时的同步写出（std::terminate、SIGSEGV、SIGABRT 等）
+    void installCrashHandlers();
+
+    // 提交一条记录（LogLine 析构时调用）
+    void submit(const LogRecord& record);
+
+    bool isRunning() const { return running.load(std::memory_order_acquire); }
+    std::uint64_t getDroppedCount() const { return dropped.load(std::memory_order_relaxed); }
+    std::uint64_t now() const;
+
+    // 崩溃路径：在当前线程同步写出所有缓冲（尽力而为）
+    void crashFlush();
+
+private:
+    Logger() = default;
+    ~Logger();
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    // 每个线程一个单生产者/单消费者环形缓冲区
+    struct ThreadBuffer {
+        static constexpr std::uint32_t CAPACITY = 1024;
+        std::array<LogRecord, CAPACITY> slots;
+        std::atomic<std::uint32_t> head{0};     // 写线程读取位置
+        std::atomic<std::uint32_t> tail{0};     // 生产线程写入位置
+    };
+
+    ThreadBuffer* localBuffer();
+    void writerLoop();
+    size_t drainAll();
+    size_t drainLocked();
+    void writeRecord(const LogRecord& record, std::string& out) const;
+    void writeDirect(const LogRecord& record);
+
+private:
+    std::mutex buffersMutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+
+    std::thread writer;
+    std::atomic<bool> running{false};
+    std::atomic<bool> stopRequested{false};
+    std::mutex wakeMutex;
+    std::condition_variable wakeCv;
+    std::condition_variable flushedCv;
+
+    std::atomic<std::uint64_t> submitted{0};
+    std::atomic<std::uint64_t> written{0};
+    std::atomic<std::uint64_t> dropped{0};
+
+    std::mutex outputMutex;         // 写线程与崩溃路径互斥
+    std::ofstream file;
+    bool console = true;
+    std::string batch;              // 写线程复用的输出缓冲
+
+    std::uint64_t startTicks = 0;
+
+    static constexpr int WRITER_INTERVAL_MS = 5;
+    static constexpr int CRASH_LOCK_ATTEMPTS = 50;
+};
+
+// ============================================================================
+// 日志宏
+// ============================================================================
+
+constexpr bool isLogLevelCompiled(int level) {
+    return level >= PF_LOG_LEVEL;
+}
+
+#define PF_LOG(level, expr)                                                 \
+    do {                                                                    \
+        if constexpr (isLogLevelCompiled(static_cast<int>(level))) {        \
+            LogLine pfLogLine_(level);                                      \
+            pfLogLine_ << expr;                                             \
+        }                                                                   \
+    } while (0)
+
+#define LOG_DEBUG(expr) PF_LOG(LogLevel::Debug, expr)
+#define LOG_INFO(expr)  PF_LOG(LogLevel::Info, expr)
+#define LOG_WARN(expr)  PF_LOG(LogLevel::Warn, expr)
+#define LOG_ERROR(expr) PF_LOG(LogLevel::Error, expr)
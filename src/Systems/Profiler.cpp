@@ -0,0 +1,230 @@
+#include "Profiler.h"
+#include "Logger.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+
+namespace {
+    // 直方图区间上限（ms），最后一档为无穷
+    constexpr std::array<float, Profiler::HISTOGRAM_BUCKETS> BUCKET_LIMITS = {
+        4.0f, 8.0f, 12.0f, 16.7f, 20.0f, 33.3f, 50.0f, 1.0e9f
+    };
+
+    float toMs(std::uint64_t ns) {
+        return static_cast<float>(static_cast<double>(ns) / 1.0e6);
+    }
+
+    void writeJsonString(std::ofstream& out, const char* s) {
+        out << '"';
+        for (; *s; s++) {
+            if (*s == '"' || *s == '\\') out << '\\';
+            out << *s;
+        }
+        out << '"';
+    }
+}
+
+Profiler& Profiler::getInstance() {
+    static Profiler instance;
+    return instance;
+}
+
+Profiler::Profiler() {
+    frameEvents.reserve(1024);
+    sections.reserve(64);
+    frameStartNs = now();
+    frameStartCounters = FrameStats::current();
+}
+
+std::uint64_t Profiler::now() {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void Profiler::leaveScope(const char* name, std::uint64_t startNs,
+                          const FrameCounters& startCounters, std::uint16_t scopeDepth) {
+    std::uint64_t endNs = now();
+    frameEvents.push_back({name, startNs, endNs, scopeDepth, FrameStats::current() - startCounters});
+    depth = scopeDepth;
+}
+
+Profiler::Section& Profiler::findSection(const char* name, std::uint16_t sectionDepth) {
+    auto it = sectionIndex.find(name);
+    if (it != sectionIndex.end()) {
+        return sections[it->second];
+    }
+
+    sectionIndex.emplace(name, sections.size());
+    Section section;
+    section.name = name;
+    section.depth = sectionDepth;
+    sections.push_back(section);
+    return sections.back();
+}
+
+// ============================================================================
+// 帧汇总
+// ============================================================================
+
+void Profiler::endFrame() {
+    std::uint64_t frameEndNs = now();
+    FrameCounters frameEndCounters = FrameStats::current();
+
+    // 按开始时间排序：新出现的标记按调用顺序（父在子前）加入列表
+    std::sort(frameEvents.begin(), frameEvents.end(),
+              [](const ProfileEvent& a, const ProfileEvent& b) {
+                  return a.startNs != b.startNs ? a.startNs < b.startNs : a.depth < b.depth;
+              });
+
+    for (const auto& event : frameEvents) {
+        Section& section = findSection(event.name, event.depth);
+        section.frameMs += toMs(event.endNs - event.startNs);
+        section.frameCalls++;
+        section.frameCounters += event.counters;
+    }
+
+    for (auto& section : sections) {
+        section.samples[historyHead] = section.frameMs;
+        section.lastCalls = section.frameCalls;
+        section.lastCounters = section.frameCounters;
+        section.frameMs = 0;
+        section.frameCalls = 0;
+        section.frameCounters = FrameCounters();
+    }
+    lastFrameCounters = frameEndCounters - frameStartCounters;
+    frameSamples[historyHead] = toMs(frameEndNs - frameStartNs);
+    frameCounterSamples[historyHead] = lastFrameCounters;
+    historyHead = (historyHead + 1) % HISTORY;
+    historyCount = std::min(historyCount + 1, HISTORY);
+
+    // 录制
+    if (capture.frameCount > 0 && frameIndex >= capture.firstFrame) {
+        capture.events.push_back({"Frame", frameStartNs, frameEndNs, 0, lastFrameCounters});
+        capture.events.insert(capture.events.end(), frameEvents.begin(), frameEvents.end());
+        if (frameIndex + 1 >= capture.firstFrame + capture.frameCount) {
+            writeCapture();
+        }
+    }
+
+    frameEvents.clear();
+    depth = 0;
+    frameIndex++;
+    frameStartNs = now();
+    frameStartCounters = FrameStats::current();
+}
+
+// ============================================================================
+// 统计
+// ============================================================================
+
+ProfileStats Profiler::computeRingStats(const std::array<float, HISTORY>& samples) const {
+    ProfileStats stats;
+    if (historyCount == 0) return stats;
+
+    std::array<float, HISTORY> sorted;
+    float sum = 0;
+    for (size_t i = 0; i < historyCount; i++) {
+        size_t index = (historyHead + HISTORY - 1 - i) % HISTORY;
+        sorted[i] = samples[index];
+        sum += samples[index];
+        stats.maxMs = std::max(stats.maxMs, samples[index]);
+    }
+    stats.lastMs = sorted[0];
+    stats.avgMs = sum / static_cast<float>(historyCount);
+
+    size_t p95Index = (historyCount * 95) / 100;
+    if (p95Index >= historyCount) p95Index = historyCount - 1;
+    std::nth_element(sorted.begin(), sorted.begin() + p95Index, sorted.begin() + historyCount);
+    stats.p95Ms = sorted[p95Index];
+    return stats;
+}
+
+ProfileStats Profiler::computeStats(const Section& section) const {
+    return computeRingStats(section.samples);
+}
+
+ProfileStats Profiler::computeFrameStats() const {
+    return computeRingStats(frameSamples);
+}
+
+FrameCounters Profiler::computeAverageFrameCounters() const {
+    FrameCounters total;
+    if (historyCount == 0) return total;
+
+    for (size_t i = 0; i < historyCount; i++) {
+        total += frameCounterSamples[(historyHead + HISTORY - 1 - i) % HISTORY];
+    }
+    total.drawCalls /= historyCount;
+    total.vertices /= historyCount;
+    total.allocations /= historyCount;
+    total.allocatedBytes /= historyCount;
+    return total;
+}
+
+std::array<std::uint32_t, Profiler::HISTOGRAM_BUCKETS> Profiler::computeFrameHistogram() const {
+    std::array<std::uint32_t, HISTOGRAM_BUCKETS> histogram{};
+    for (size_t i = 0; i < historyCount; i++) {
+        float ms = getFrameMs(i);
+        size_t bucket = 0;
+        while (bucket + 1 < HISTOGRAM_BUCKETS && ms > BUCKET_LIMITS[bucket]) bucket++;
+        histogram[bucket]++;
+    }
+    return histogram;
+}
+
+float Profiler::getBucketLimitMs(size_t bucket) {
+    return bucket < HISTOGRAM_BUCKETS ? BUCKET_LIMITS[bucket] : BUCKET_LIMITS.back();
+}
+
+// ============================================================================
+// Chrome Trace 导出
+// ============================================================================
+
+void Profiler::requestCapture(std::uint64_t firstFrame, std::uint32_t frameCount, const std::string& path) {
+#if !PF_PROFILE
+    LOG_WARN("[Profiler] 性能标记未编译（PF_PROFILE=0），录制结果将只有帧边界");
+#endif
+    capture.firstFrame = firstFrame;
+    capture.frameCount = frameCount;
+    capture.path = path;
+    capture.events.clear();
+    LOG_INFO("[Profiler] 将录制第 " << firstFrame << " 帧起的 " << frameCount << " 帧 -> " << path);
+}
+
+void Profiler::captureNextFrames(std::uint32_t frameCount, const std::string& path) {
+    requestCapture(frameIndex, frameCount, path);
+}
+
+void Profiler::writeCapture() {
+    std::ofstream out(capture.path, std::ios::trunc);
+    if (!out) {
+        LOG_ERROR("[Profiler] 无法写入: " << capture.path);
+    } else {
+        std::uint64_t originNs = capture.events.empty() ? 0 : capture.events.front().startNs;
+        char timeBuffer[64];
+
+        out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        for (size_t i = 0; i < capture.events.size(); i++) {
+            const ProfileEvent& event = capture.events[i];
+            std::snprintf(timeBuffer, sizeof(timeBuffer), "\"ts\":%.3f,\"dur\":%.3f",
+                          static_cast<double>(event.startNs - originNs) / 1000.0,
+                          static_cast<double>(event.endNs - event.startNs) / 1000.0);
+            out << "{\"name\":";
+            writeJsonString(out, event.name);
+            out << ",\"ph\":\"X\",\"pid\":1,\"tid\":1," << timeBuffer
+                << ",\"args\":{\"draws\":" << event.counters.drawCalls
+                << ",\"vertices\":" << event.counters.vertices
+                << ",\"allocs\":" << event.counters.allocations
+                << ",\"bytes\":" << event.counters.allocatedBytes << "}}";
+            out << (i + 1 < capture.events.size() ? ",\n" : "\n");
+        }
+        out << "]}\n";
+        LOG_INFO("[Profiler] 已导出 " << capture.frameCount << " 帧 ("
+                 << capture.events.size() << " 条记录) -> " << capture.path);
+    }
+
+    capture.frameCount = 0;
+    capture.events.clear();
+    capture.events.shrink_to_fit();
+}
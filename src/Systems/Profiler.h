@@ -0,0 +1,184 @@
+#pragma once
+#include "FrameStats.h"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// ============================================================================
+// 帧性能分析器 (Profiler)
+//
+// 在关键代码段放置作用域计时标记，每帧结束时汇总：
+//   - 每个标记保留最近 HISTORY 帧的耗时，用于计算 平均 / P95 / 最大值
+//   - 整帧耗时按区间统计成直方图，供性能面板 (ProfilerOverlay) 显示
+//   - 同时记录每个标记内的 draw call / 顶点 / 堆分配次数（见 FrameStats.h）
+//   - 可录制指定帧区间，导出 Chrome Trace JSON（chrome://tracing 或
+//     https://ui.perfetto.dev 打开）
+//
+// 使用方式：
+//   PROFILE_SCOPE("TreeManager::update");   // 到作用域结束为止计时
+//   PROFILE_FRAME_END();                    // 主循环每帧末尾调用一次
+//
+// 编译开关：PF_PROFILE=0 时所有宏展开为空，没有任何运行时开销
+// （CMake 选项 PF_ENABLE_PROFILER 控制）。
+//
+// 注意：标记只能在主线程使用；标记名必须是字符串字面量（按地址保存）。
+// 第 0 帧包含进入主循环前的全部加载过程。
+// ============================================================================
+
+#ifndef PF_PROFILE
+#define PF_PROFILE 1
+#endif
+
+// 一次计时记录
+struct ProfileEvent {
+    const char* name;
+    std::uint64_t startNs;
+    std::uint64_t endNs;
+    std::uint16_t depth;
+    FrameCounters counters;         // 作用域内（含子作用域）的绘制/分配计数
+};
+
+// 某个标记在历史窗口内的统计
+struct ProfileStats {
+    float lastMs = 0;
+    float avgMs = 0;
+    float p95Ms = 0;
+    float maxMs = 0;
+};
+
+class Profiler {
+public:
+    static constexpr size_t HISTORY = 240;             // 约 4 秒（60 FPS）
+    static constexpr size_t HISTOGRAM_BUCKETS = 8;
+
+    struct Section {
+        const char* name;
+        std::uint16_t depth;
+        std::array<float, HISTORY> samples{};           // 每帧累计耗时（ms，环形）
+        float frameMs = 0;                              // 当前帧累计
+        std::uint32_t frameCalls = 0;                   // 当前帧调用次数
+        std::uint32_t lastCalls = 0;                    // 上一帧调用次数
+        FrameCounters frameCounters;                    // 当前帧累计计数
+        FrameCounters lastCounters;                     // 上一帧计数
+    };
+
+    static Profiler& getInstance();
+
+    static std::uint64_t now();
+
+    // 作用域计时（由 ProfileScope 调用）
+    std::uint16_t enterScope() { return depth++; }
+    void leaveScope(const char* name, std::uint64_t startNs,
+                    const FrameCounters& startCounters, std::uint16_t scopeDepth);
+
+    // 结束当前帧：汇总统计、处理录制
+    void endFrame();
+
+    // 录制 [firstFrame, firstFrame + frameCount) 帧并写出 Chrome Trace
+    void requestCapture(std::uint64_t firstFrame, std::uint32_t frameCount, const std::string& path);
+    // 从当前帧开始录制
+    void captureNextFrames(std::uint32_t frameCount, const std::string& path);
+    bool isCapturing() const { return capture.frameCount > 0; }
+
+    // 查询
+    std::uint64_t getFrameIndex() const { return frameIndex; }
+    size_t getHistoryCount() const { return historyCount; }
+    const std::vector<Section>& getSections() const { return sections; }
+    ProfileStats computeStats(const Section& section) const;
+    ProfileStats computeFrameStats() const;
+
+    // 上一帧 / 历史窗口平均的整帧绘制与分配计数
+    const FrameCounters& getLastFrameCounters() const { return lastFrameCounters; }
+    FrameCounters computeAverageFrameCounters() const;
+
+    // 某个标记上一帧的累计耗时（不做排序，适合每帧调用）
+    float getLastMs(const Section& section) const {
+        return historyCount > 0 ? section.samples[(historyHead + HISTORY - 1) % HISTORY] : 0.0f;
+    }
+
+    // 第 age 帧前的整帧耗时（0 = 上一帧），age >= getHistoryCount() 时返回 0
+    float getFrameMs(size_t age) const {
+        return age < historyCount ? frameSamples[(historyHead + HISTORY - 1 - age) % HISTORY] : 0.0f;
+    }
+
+    // 整帧耗时直方图：bucket i 统计 (getBucketLimitMs(i-1), getBucketLimitMs(i)] 的帧数
+    std::array<std::uint32_t, HISTOGRAM_BUCKETS> computeFrameHistogram() const;
+    static float getBucketLimitMs(size_t bucket);
+
+private:
+    Profiler();
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    struct Capture {
+        std::uint64_t firstFrame = 0;
+        std::uint32_t frameCount = 0;
+        std::string path;
+        std::vector<ProfileEvent> events;
+    };
+
+    Section& findSection(const char* name, std::uint16_t sectionDepth);
+    ProfileStats computeRingStats(const std::array<float, HISTORY>& samples) const;
+    void writeCapture();
+
+private:
+    std::vector<ProfileEvent> frameEvents;
+    std::uint16_t depth = 0;
+    std::uint64_t frameStartNs = 0;
+    std::uint64_t frameIndex = 0;
+    FrameCounters frameStartCounters;
+    FrameCounters lastFrameCounters;
+
+    std::vector<Section> sections;
+    std::unordered_map<std::string_view, size_t> sectionIndex;
+    std::array<float, HISTORY> frameSamples{};
+    std::array<FrameCounters, HISTORY> frameCounterSamples{};
+    size_t historyHead = 0;
+    size_t historyCount = 0;
+
+    Capture capture;
+};
+
+// ============================================================================
+// 作用域计时器
+// ============================================================================
+
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name)
+        : name(name)
+        , depth(Profiler::getInstance().enterScope())
+        , startCounters(FrameStats::current())
+        , startNs(Profiler::now()) {
+    }
+
+    ~ProfileScope() {
+        Profiler::getInstance().leaveScope(name, startNs, startCounters, depth);
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* name;
+    std::uint16_t depth;
+    FrameCounters startCounters;
+    std::uint64_t startNs;
+};
+
+// ============================================================================
+// 计时宏
+// ============================================================================
+
+#if PF_PROFILE
+#define PF_PROFILE_CONCAT_(a, b) a##b
+#define PF_PROFILE_CONCAT(a, b) PF_PROFILE_CONCAT_(a, b)
+#define PROFILE_SCOPE(name) ProfileScope PF_PROFILE_CONCAT(pfProfileScope_, __LINE__)(name)
+#define PROFILE_FRAME_END() Profiler::getInstance().endFrame()
+#else
+#define PROFILE_SCOPE(name) ((void)0)
+#define PROFILE_FRAME_END() ((void)0)
+#endif
@@ -0,0 +1,64 @@
+#include "Random.h"
+#include "Logger.h"
+#include <random>
+
+namespace {
+
+// SplitMix64：把相邻的输入打散成互不相关的64位值
+std::uint64_t splitMix64(std::uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+Rng makeRng(std::uint64_t worldSeed, RngStream id, std::uint64_t key) {
+    std::uint64_t streamKey = splitMix64(worldSeed ^ splitMix64(static_cast<std::uint64_t>(id) + 1));
+    std::uint64_t seed = splitMix64(streamKey + key);
+    std::uint64_t sequence = splitMix64(seed ^ streamKey);
+    return Rng(seed, sequence);
+}
+
+} // namespace
+
+// ============================================================================
+// RandomService 单例实现
+// ============================================================================
+
+RandomService& RandomService::getInstance() {
+    static RandomService instance;
+    return instance;
+}
+
+RandomService::RandomService() {
+    // 未指定种子时随机选取一个，但仍然只有这一个随机源（日志中可查）
+    std::random_device rd;
+    std::uint64_t seed = (static_cast<std::uint64_t>(rd()) << 32) | rd();
+    setWorldSeed(seed);
+}
+
+void RandomService::setWorldSeed(std::uint64_t seed) {
+    worldSeed = seed;
+
+    for (std::size_t i = 0; i < STREAM_COUNT; i++) {
+        // key = 0 保留给系统流，实体流从 1 开始编号
+        systemStreams[i] = makeRng(worldSeed, static_cast<RngStream>(i), 0);
+        entityCounters[i] = 0;
+    }
+
+    LOG_INFO("[Random] World seed: " << worldSeed);
+}
+
+Rng& RandomService::stream(RngStream id) {
+    return systemStreams[static_cast<std::size_t>(id)];
+}
+
+Rng RandomService::makeEntityStream(RngStream id) {
+    std::uint64_t index = ++entityCounters[static_cast<std::size_t>(id)];
+    return makeRng(worldSeed, id, index);
+}
+
+Rng RandomService::deriveStream(RngStream id, std::uint64_t key) const {
+    // 最高位置1，与按序号派生的实体流区分开
+    return makeRng(worldSeed, id, key | 0x8000000000000000ULL);
+}
@@ -0,0 +1,136 @@
+#pragma once
+#include <cstdint>
+#include <array>
+#include <limits>
+
+// ============================================================================
+// 随机数系统 (Random System)
+//
+// 核心概念：
+//   1. 世界种子 (World Seed) - 整局游戏唯一的随机源，相同种子 = 相同的游戏过程
+//   2. 随机流 (Rng)          - PCG32 生成器，只有16字节状态（mt19937约5KB）
+//   3. 系统流 (System Stream) - 每个系统一条共享流（掉落、刷怪、粒子...）
+//   4. 实体流 (Entity Stream) - 每个实体独立一条流，由 世界种子+系统+序号 派生
+//
+// 使用方式：
+//   - 管理器/一次性逻辑：RandomService::getInstance().stream(RngStream::Drops)
+//   - 实体成员：rng(RandomService::getInstance().makeEntityStream(RngStream::Monster))
+//   - Rng 满足 UniformRandomBitGenerator，可直接配合 std::uniform_*_distribution
+//
+// 复现：启动时 --seed <n> 指定世界种子，日志中会打印本局实际使用的种子
+// ============================================================================
+
+// 随机流类别（每个类别派生出互不相关的序列）
+enum class RngStream : std::uint32_t {
+    World,          // 通用世界逻辑
+    MonsterSpawn,   // 怪物刷新位置
+    Monster,        // 怪物个体（属性、AI、掉落）
+    Pet,            // 宠物个体（属性、技能）
+    PetHatch,       // 孵化资质
+    Player,         // 玩家属性成长、闪避、暴击
+    Drops,          // 掉落计算
+    Tree,           // 树木（掉落、变换、奖励）
+    Stone,          // 石头建筑
+    WildPlant,      // 野生植物
+    Particles,      // 纯视觉效果（掉落物抛洒、粒子）
+    Planting,       // 种植
+    Count
+};
+
+// ============================================================================
+// PCG32 随机流（XSH-RR 变体）
+// ============================================================================
+class Rng {
+public:
+    using result_type = std::uint32_t;
+
+    Rng() : Rng(0x853c49e6748fea9bULL, 0xda3e39cb94b95bdbULL) {}
+    Rng(std::uint64_t seed, std::uint64_t sequence) { reseed(seed, sequence); }
+
+    void reseed(std::uint64_t seed, std::uint64_t sequence) {
+        state = 0;
+        inc = (sequence << 1u) | 1u;
+        next();
+        state += seed;
+        next();
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()() { return next(); }
+
+    // [0, 1) 浮点数（取高24位，跨平台结果一致）
+    float nextFloat() {
+        return static_cast<float>(next() >> 8) * (1.0f / 16777216.0f);
+    }
+
+    // [minValue, maxValue] 闭区间整数
+    int range(int minValue, int maxValue) {
+        if (maxValue <= minValue) return minValue;
+        std::uint32_t span = static_cast<std::uint32_t>(maxValue - minValue) + 1u;
+        // 乘法映射，避免取模偏差带来的低位相关性
+        std::uint64_t scaled = static_cast<std::uint64_t>(next()) * span;
+        return minValue + static_cast<int>(scaled >> 32);
+    }
+
+    // [minValue, maxValue) 浮点数
+    float range(float minValue, float maxValue) {
+        return minValue + (maxValue - minValue) * nextFloat();
+    }
+
+    // 以 probability 的概率返回 true
+    bool chance(float probability) {
+        return nextFloat() < probability;
+    }
+
+    // 状态访问（用于存档/回放）
+    std::uint64_t getState() const { return state; }
+    std::uint64_t getIncrement() const { return inc; }
+    void setState(std::uint64_t s, std::uint64_t i) { state = s; inc = i | 1u; }
+
+private:
+    result_type next() {
+        std::uint64_t old = state;
+        state = old * 6364136223846793005ULL + inc;
+        std::uint32_t xorshifted = static_cast<std::uint32_t>(((old >> 18u) ^ old) >> 27u);
+        std::uint32_t rot = static_cast<std::uint32_t>(old >> 59u);
+        return (xorshifted >> rot) | (xorshifted << ((32u - rot) & 31u));
+    }
+
+private:
+    std::uint64_t state;
+    std::uint64_t inc;
+};
+
+// ============================================================================
+// 随机数服务（单例模式，持有世界种子并派生所有随机流）
+// ============================================================================
+class RandomService {
+public:
+    static RandomService& getInstance();
+
+    // 设置世界种子（重置所有系统流和实体计数器）
+    void setWorldSeed(std::uint64_t seed);
+    std::uint64_t getWorldSeed() const { return worldSeed; }
+
+    // 获取系统共享流
+    Rng& stream(RngStream id);
+
+    // 派生新的实体流（按创建顺序编号，同种子同顺序 = 同结果）
+    Rng makeEntityStream(RngStream id);
+
+    // 由任意键派生独立流（不影响计数器，用于存档恢复等）
+    Rng deriveStream(RngStream id, std::uint64_t key) const;
+
+private:
+    RandomService();
+    RandomService(const RandomService&) = delete;
+    RandomService& operator=(const RandomService&) = delete;
+
+    static constexpr std::size_t STREAM_COUNT = static_cast<std::size_t>(RngStream::Count);
+
+    std::uint64_t worldSeed;
+    std::array<Rng, STREAM_COUNT> systemStreams;
+    std::array<std::uint64_t, STREAM_COUNT> entityCounters;
+};
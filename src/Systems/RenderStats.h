@@ -0,0 +1,51 @@
+#pragma once
+#include "FrameStats.h"
+#include <SFML/Graphics.hpp>
+
+// ============================================================================
+// 计数绘制 (Render Stats)
+//
+// 与 window.draw 用法相同，额外记录 draw call 次数和顶点数。
+// 顶点数按 SFML 各图元的实际构成估算：
+//   Sprite 4 个，Text 每字符 6 个，Shape 填充三角扇 + 描边三角带
+// ============================================================================
+
+class RenderStats {
+public:
+    static void draw(sf::RenderTarget& target, const sf::Sprite& sprite,
+                     const sf::RenderStates& states = sf::RenderStates::Default) {
+        FrameStats::addDraw(4);
+        target.draw(sprite, states);
+    }
+
+    static void draw(sf::RenderTarget& target, const sf::Text& text,
+                     const sf::RenderStates& states = sf::RenderStates::Default) {
+        // 每个字符两个三角形
+        FrameStats::addDraw(text.getString().getSize() * 6);
+        target.draw(text, states);
+    }
+
+    static void draw(sf::RenderTarget& target, const sf::Shape& shape,
+                     const sf::RenderStates& states = sf::RenderStates::Default) {
+        // 填充为三角扇（点数 + 2），有描边时再画一次三角带
+        std::size_t points = shape.getPointCount();
+        if (shape.getOutlineThickness() != 0) {
+            FrameStats::addDraw(points + 2 + (points + 1) * 2, 2);
+        } else {
+            FrameStats::addDraw(points + 2);
+        }
+        target.draw(shape, states);
+    }
+
+    static void draw(sf::RenderTarget& target, const sf::VertexArray& vertices,
+                     const sf::RenderStates& states = sf::RenderStates::Default) {
+        FrameStats::addDraw(vertices.getVertexCount());
+        target.draw(vertices, states);
+    }
+
+    static void draw(sf::RenderTarget& target, const sf::Drawable& drawable,
+                     const sf::RenderStates& states = sf::RenderStates::Default) {
+        FrameStats::addDraw(0);
+        target.draw(drawable, states);
+    }
+};
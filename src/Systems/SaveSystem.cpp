@@ -0,0 +1,568 @@
+#include "SaveSystem.h"
+#include "BinaryStream.h"
+#include "Logger.h"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+
+const char SAVE_MAGIC[4] = { 'P', 'F', 'S', 'V' };
+
+// 分段标签
+constexpr std::uint32_t TAG_META      = makeTag('M', 'E', 'T', 'A');
+constexpr std::uint32_t TAG_PLAYER    = makeTag('P', 'L', 'Y', 'R');
+constexpr std::uint32_t TAG_INVENTORY = makeTag('I', 'N', 'V', 'T');
+constexpr std::uint32_t TAG_EQUIPMENT = makeTag('E', 'Q', 'U', 'P');
+constexpr std::uint32_t TAG_DROPS     = makeTag('D', 'R', 'O', 'P');
+constexpr std::uint32_t TAG_PETS      = makeTag('P', 'E', 'T', 'S');
+constexpr std::uint32_t TAG_TREES     = makeTag('T', 'R', 'E', 'E');
+
+// ============================================================================
+// 各分段编码
+// ============================================================================
+
+void writeSkill(BinaryWriter& w, const SkillInfo& skill) {
+    w.pod(skill.level);
+    w.pod(skill.exp);
+    w.pod(skill.expToNext);
+}
+
+bool readSkill(BinaryReader& r, SkillInfo& skill) {
+    return r.pod(skill.level) && r.pod(skill.exp) && r.pod(skill.expToNext);
+}
+
+void writePlayer(BinaryWriter& w, const WorldSnapshot& s) {
+    const PlayerStatsSaveData& p = s.playerStats;
+    w.vec2(s.playerPosition);
+    w.pod(p.health); w.pod(p.maxHealth);
+    w.pod(p.stamina); w.pod(p.maxStamina);
+    w.pod(p.hunger); w.pod(p.maxHunger);
+    w.pod(p.level); w.pod(p.exp); w.pod(p.expToNextLevel);
+    w.pod(p.baseAttack); w.pod(p.baseDefense); w.pod(p.baseSpeed); w.pod(p.baseDodge);
+    w.pod(p.bonusAttack); w.pod(p.bonusDefense); w.pod(p.bonusSpeed); w.pod(p.bonusDodge);
+    w.pod(p.luck); w.pod(p.damageBonus); w.pod(p.dodgeReduction);
+    w.pod(p.gold);
+    writeSkill(w, p.farmingSkill);
+    writeSkill(w, p.fishingSkill);
+    writeSkill(w, p.miningSkill);
+    w.pod(p.hungerDecayTimer); w.pod(p.staminaRegenTimer); w.pod(p.healthRegenTimer);
+}
+
+bool readPlayer(BinaryReader& r, WorldSnapshot& s) {
+    PlayerStatsSaveData& p = s.playerStats;
+    return r.vec2(s.playerPosition) &&
+           r.pod(p.health) && r.pod(p.maxHealth) &&
+           r.pod(p.stamina) && r.pod(p.maxStamina) &&
+           r.pod(p.hunger) && r.pod(p.maxHunger) &&
+           r.pod(p.level) && r.pod(p.exp) && r.pod(p.expToNextLevel) &&
+           r.pod(p.baseAttack) && r.pod(p.baseDefense) && r.pod(p.baseSpeed) && r.pod(p.baseDodge) &&
+           r.pod(p.bonusAttack) && r.pod(p.bonusDefense) && r.pod(p.bonusSpeed) && r.pod(p.bonusDodge) &&
+           r.pod(p.luck) && r.pod(p.damageBonus) && r.pod(p.dodgeReduction) &&
+           r.pod(p.gold) &&
+           readSkill(r, p.farmingSkill) && readSkill(r, p.fishingSkill) && readSkill(r, p.miningSkill) &&
+           r.pod(p.hungerDecayTimer) && r.pod(p.staminaRegenTimer) && r.pod(p.healthRegenTimer);
+}
+
+void writeInventory(BinaryWriter& w, const InventorySaveData& inv) {
+    w.pod(static_cast<std::uint8_t>(inv.categories.size()));
+    w.pod(static_cast<std::uint16_t>(CATEGORY_SLOTS));
+    for (const auto& slots : inv.categories) {
+        for (const auto& stack : slots) {
+            // 存字符串ID：整数ID由注册顺序决定，不能跨版本保存
+            // （ItemDatabase 初始化后只读，后台线程查询是安全的）
+            w.str(stack.isEmpty() ? std::string() : stack.getStringId());
+            w.pod(static_cast<std::int32_t>(stack.count));
+        }
+    }
+}
+
+bool readInventory(BinaryReader& r, InventorySaveData& inv) {
+    std::uint8_t categoryCount = 0;
+    std::uint16_t slotCount = 0;
+    if (!r.pod(categoryCount) || !r.pod(slotCount)) return false;
+
+    for (std::size_t c = 0; c < categoryCount; c++) {
+        for (std::size_t i = 0; i < slotCount; i++) {
+            std::string itemId;
+            std::int32_t count = 0;
+            if (!r.str(itemId) || !r.pod(count)) return false;
+
+            // 容量变小时丢弃越界格子
+            // 已删除的物品查不到ID，按空格子处理
+            if (c < inv.categories.size() && i < CATEGORY_SLOTS) {
+                ItemStack stack(itemId, count);
+                inv.categories[c][i] = stack.isEmpty() ? ItemStack() : stack;
+            }
+        }
+    }
+    return true;
+}
+
+void writeEquipment(BinaryWriter& w, const PlayerEquipment::EquippedArray& eq) {
+    w.pod(static_cast<std::uint8_t>(eq.size()));
+    for (const auto& id : eq) {
+        w.str(id);
+    }
+}
+
+bool readEquipment(BinaryReader& r, PlayerEquipment::EquippedArray& eq) {
+    std::uint8_t count = 0;
+    if (!r.pod(count)) return false;
+    for (std::size_t i = 0; i < count; i++) {
+        std::string id;
+        if (!r.str(id)) return false;
+        if (i < eq.size()) eq[i] = id;
+    }
+    return true;
+}
+
+void writeDrops(BinaryWriter& w, const std::vector<DroppedItemSaveData>& drops) {
+    w.pod(static_cast<std::uint32_t>(drops.size()));
+    for (const auto& d : drops) {
+        w.str(d.itemId);
+        w.pod(static_cast<std::int32_t>(d.count));
+        w.vec2(d.position);
+        w.pod(d.lifetime);
+    }
+}
+
+bool readDrops(BinaryReader& r, std::vector<DroppedItemSaveData>& drops) {
+    std::uint32_t count = 0;
+    if (!r.pod(count)) return false;
+    drops.clear();
+    for (std::uint32_t i = 0; i < count; i++) {
+        DroppedItemSaveData d;
+        std::int32_t itemCount = 0;
+        if (!r.str(d.itemId) || !r.pod(itemCount) || !r.vec2(d.position) || !r.pod(d.lifetime)) {
+            return false;
+        }
+        d.count = itemCount;
+        drops.push_back(std::move(d));
+    }
+    return true;
+}
+
+void writePets(BinaryWriter& w, const PetManagerSaveData& pets) {
+    w.pod(static_cast<std::int32_t>(pets.currentPetIndex));
+    w.pod(static_cast<std::uint8_t>(pets.slots.size()));
+    for (const auto& slot : pets.slots) {
+        const PetSaveData& p = slot.pet;
+        w.pod(static_cast<std::uint8_t>(slot.slotIndex));
+        w.pod(static_cast<std::int32_t>(p.petTypeId));
+        w.str(p.name);
+        w.pod(static_cast<std::uint8_t>(p.quality));
+        w.pod(p.level); w.pod(p.exp);
+        w.pod(p.health); w.pod(p.maxHealth);
+        w.pod(p.sp); w.pod(p.maxSP);
+        w.pod(p.attack); w.pod(p.defense); w.pod(p.dodge);
+        w.vec2(p.position);
+
+        w.pod(static_cast<std::uint8_t>(p.skills.size()));
+        for (const auto& skill : p.skills) {
+            w.str(skill.id);
+            w.str(skill.name);
+            w.str(skill.description);
+            w.pod(skill.triggerChance);
+            w.pod(skill.damageMultiplier);
+            w.pod(skill.effectValue);
+            w.pod(static_cast<std::uint8_t>(skill.isPassive ? 1 : 0));
+        }
+    }
+}
+
+bool readPets(BinaryReader& r, PetManagerSaveData& pets) {
+    std::int32_t currentIndex = -1;
+    std::uint8_t slotCount = 0;
+    if (!r.pod(currentIndex) || !r.pod(slotCount)) return false;
+    pets.currentPetIndex = currentIndex;
+    pets.slots.clear();
+
+    for (std::uint8_t i = 0; i < slotCount; i++) {
+        PetSlotSaveData slot;
+        PetSaveData& p = slot.pet;
+        std::uint8_t slotIndex = 0, quality = 0, skillCount = 0;
+        std::int32_t typeId = 0;
+
+        if (!r.pod(slotIndex) || !r.pod(typeId) || !r.str(p.name) || !r.pod(quality) ||
+            !r.pod(p.level) || !r.pod(p.exp) ||
+            !r.pod(p.health) || !r.pod(p.maxHealth) ||
+            !r.pod(p.sp) || !r.pod(p.maxSP) ||
+            !r.pod(p.attack) || !r.pod(p.defense) || !r.pod(p.dodge) ||
+            !r.vec2(p.position) || !r.pod(skillCount)) {
+            return false;
+        }
+        slot.slotIndex = slotIndex;
+        p.petTypeId = typeId;
+        p.quality = static_cast<PetQuality>(quality);
+
+        for (std::uint8_t k = 0; k < skillCount; k++) {
+            PetSkill skill;
+            std::uint8_t passive = 0;
+            if (!r.str(skill.id) || !r.str(skill.name) || !r.str(skill.description) ||
+                !r.pod(skill.triggerChance) || !r.pod(skill.damageMultiplier) ||
+                !r.pod(skill.effectValue) || !r.pod(passive)) {
+                return false;
+            }
+            skill.isPassive = passive != 0;
+            p.skills.push_back(std::move(skill));
+        }
+        pets.slots.push_back(std::move(slot));
+    }
+    return true;
+}
+
+void writeTrees(BinaryWriter& w, const std::vector<TreeSaveData>& trees) {
+    w.pod(static_cast<std::uint32_t>(trees.size()));
+    for (const auto& t : trees) {
+        w.str(t.treeType);
+        w.vec2(t.position);
+        w.vec2(t.size);
+        w.pod(static_cast<std::uint8_t>(t.growthStage));
+        w.pod(t.growthTimer);
+        w.pod(t.health);
+        w.pod(static_cast<std::uint8_t>(t.hasTransformed ? 1 : 0));
+    }
+}
+
+bool readTrees(BinaryReader& r, std::vector<TreeSaveData>& trees) {
+    std::uint32_t count = 0;
+    if (!r.pod(count)) return false;
+    trees.clear();
+    for (std::uint32_t i = 0; i < count; i++) {
+        TreeSaveData t;
+        std::uint8_t stage = 0, transformed = 0;
+        if (!r.str(t.treeType) || !r.vec2(t.position) || !r.vec2(t.size) ||
+            !r.pod(stage) || !r.pod(t.growthTimer) || !r.pod(t.health) || !r.pod(transformed)) {
+            return false;
+        }
+        t.growthStage = static_cast<TreeGrowthStage>(stage);
+        t.hasTransformed = transformed != 0;
+        trees.push_back(std::move(t));
+    }
+    return true;
+}
+
+// 写入文件并刷到磁盘
+bool writeFileDurable(const std::string& path, const std::vector<std::uint8_t>& bytes) {
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) return false;
+
+    bool ok = std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+    ok = ok && std::fflush(file) == 0;
+#ifdef _WIN32
+    ok = ok && _commit(_fileno(file)) == 0;
+#else
+    ok = ok && fsync(fileno(file)) == 0;
+#endif
+    ok = (std::fclose(file) == 0) && ok;
+    return ok;
+}
+
+} // namespace
+
+// ============================================================================
+// 单例与后台线程
+// ============================================================================
+
+SaveSystem& SaveSystem::getInstance() {
+    static SaveSystem instance;
+    return instance;
+}
+
+SaveSystem::SaveSystem() {
+    worker = std::thread(&SaveSystem::workerLoop, this);
+}
+
+SaveSystem::~SaveSystem() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    workAvailable.notify_one();
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+void SaveSystem::workerLoop() {
+    for (;;) {
+        std::unique_ptr<WorldSnapshot> snapshot;
+        std::string path;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            workAvailable.wait(lock, [this] { return pending != nullptr || stopping; });
+            if (!pending && stopping) return;
+
+            snapshot = std::move(pending);
+            path = pendingPath;
+            busy = true;
+        }
+
+        writeSnapshot(*snapshot, path);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            busy = false;
+        }
+        workDone.notify_all();
+    }
+}
+
+// ============================================================================
+// 保存
+// ============================================================================
+
+void SaveSystem::saveAsync(WorldSnapshot snapshot, const std::string& path) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending = std::make_unique<WorldSnapshot>(std::move(snapshot));
+        pendingPath = path;
+    }
+    workAvailable.notify_one();
+}
+
+bool SaveSystem::saveNow(const WorldSnapshot& snapshot, const std::string& path) {
+    flush();
+    return writeSnapshot(snapshot, path);
+}
+
+void SaveSystem::flush() {
+    std::unique_lock<std::mutex> lock(mutex);
+    workDone.wait(lock, [this] { return pending == nullptr && !busy; });
+}
+
+bool SaveSystem::isSaving() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return pending != nullptr || busy;
+}
+
+bool SaveSystem::writeSnapshot(const WorldSnapshot& snapshot, const std::string& path) {
+    std::vector<std::uint8_t> raw = serialize(snapshot);
+    std::vector<std::uint8_t> packed = compress(raw);
+
+    std::vector<std::uint8_t> file;
+    file.reserve(packed.size() + 12);
+    file.insert(file.end(), SAVE_MAGIC, SAVE_MAGIC + sizeof(SAVE_MAGIC));
+    BinaryWriter header(file);
+    header.pod(SAVE_VERSION);
+    header.pod(static_cast<std::uint32_t>(raw.size()));
+    file.insert(file.end(), packed.begin(), packed.end());
+
+    // 先写临时文件，成功后再替换，避免写到一半崩溃损坏旧存档
+    std::filesystem::path target(path);
+    std::filesystem::path temp = target;
+    temp += ".tmp";
+
+    std::error_code ec;
+    if (target.has_parent_path()) {
+        std::filesystem::create_directories(target.parent_path(), ec);
+    }
+
+    if (!writeFileDurable(temp.string(), file)) {
+        LOG_ERROR("[Save] 写入失败: " << temp.string());
+        return false;
+    }
+
+    std::filesystem::rename(temp, target, ec);
+    if (ec) {
+        LOG_ERROR("[Save] 替换存档失败: " << ec.message());
+        return false;
+    }
+
+    LOG_INFO("[Save] 已保存: " << path << " (" << raw.size() << " -> "
+          << packed.size() << " 字节)");
+    return true;
+}
+
+// ============================================================================
+// 读取
+// ============================================================================
+
+bool SaveSystem::exists(const std::string& path) {
+    std::error_code ec;
+    return std::filesystem::exists(path, ec);
+}
+
+bool SaveSystem::load(const std::string& path, WorldSnapshot& outSnapshot) {
+    // 确保没有正在写入的同名存档
+    flush();
+
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) {
+        LOG_ERROR("[Save] 无法打开存档: " << path);
+        return false;
+    }
+
+    std::vector<std::uint8_t> file((std::istreambuf_iterator<char>(in)),
+                                   std::istreambuf_iterator<char>());
+
+    BinaryReader header(file.data(), file.size());
+    std::uint32_t version = 0, rawSize = 0;
+    if (file.size() < sizeof(SAVE_MAGIC) ||
+        std::memcmp(file.data(), SAVE_MAGIC, sizeof(SAVE_MAGIC)) != 0 ||
+        !header.skip(sizeof(SAVE_MAGIC)) || !header.pod(version) || !header.pod(rawSize)) {
+        LOG_ERROR("[Save] 存档格式错误: " << path);
+        return false;
+    }
+
+    if (version > SAVE_VERSION) {
+        LOG_ERROR("[Save] 存档版本过新: " << version);
+        return false;
+    }
+
+    std::vector<std::uint8_t> packed(file.begin() + header.position(), file.end());
+    std::vector<std::uint8_t> raw;
+    if (!decompress(packed, rawSize, raw) || !deserialize(raw, outSnapshot)) {
+        LOG_ERROR("[Save] 存档已损坏: " << path);
+        return false;
+    }
+
+    LOG_INFO("[Save] 已读取: " << path);
+    return true;
+}
+
+// ============================================================================
+// 序列化
+// ============================================================================
+
+std::vector<std::uint8_t> SaveSystem::serialize(const WorldSnapshot& snapshot) {
+    std::vector<std::uint8_t> out;
+    out.reserve(16 * 1024);
+    BinaryWriter w(out);
+
+    std::size_t section = w.beginSection(TAG_META);
+    w.pod(snapshot.worldSeed);
+    w.pod(static_cast<std::int32_t>(snapshot.mapType));
+    w.endSection(section);
+
+    section = w.beginSection(TAG_PLAYER);
+    writePlayer(w, snapshot);
+    w.endSection(section);
+
+    section = w.beginSection(TAG_INVENTORY);
+    writeInventory(w, snapshot.inventory);
+    w.endSection(section);
+
+    section = w.beginSection(TAG_EQUIPMENT);
+    writeEquipment(w, snapshot.equipment);
+    w.endSection(section);
+
+    section = w.beginSection(TAG_DROPS);
+    writeDrops(w, snapshot.droppedItems);
+    w.endSection(section);
+
+    section = w.beginSection(TAG_PETS);
+    writePets(w, snapshot.pets);
+    w.endSection(section);
+
+    section = w.beginSection(TAG_TREES);
+    writeTrees(w, snapshot.trees);
+    w.endSection(section);
+
+    return out;
+}
+
+bool SaveSystem::deserialize(const std::vector<std::uint8_t>& data, WorldSnapshot& outSnapshot) {
+    BinaryReader reader(data.data(), data.size());
+
+    while (!reader.atEnd()) {
+        std::uint32_t tag = 0, length = 0;
+        if (!reader.pod(tag) || !reader.pod(length)) return false;
+
+        BinaryReader r(reader.current(), length);
+        if (!reader.skip(length)) return false;
+
+        bool ok = true;
+        switch (tag) {
+            case TAG_META: {
+                std::int32_t mapType = 0;
+                ok = r.pod(outSnapshot.worldSeed) && r.pod(mapType);
+                outSnapshot.mapType = mapType;
+                break;
+            }
+            case TAG_PLAYER:    ok = readPlayer(r, outSnapshot); break;
+            case TAG_INVENTORY: ok = readInventory(r, outSnapshot.inventory); break;
+            case TAG_EQUIPMENT: ok = readEquipment(r, outSnapshot.equipment); break;
+            case TAG_DROPS:     ok = readDrops(r, outSnapshot.droppedItems); break;
+            case TAG_PETS:      ok = readPets(r, outSnapshot.pets); break;
+            case TAG_TREES:     ok = readTrees(r, outSnapshot.trees); break;
+            default:
+                // 未知分段（新版本写入），跳过
+                break;
+        }
+        if (!ok) return false;
+    }
+
+    return reader.ok();
+}
+
+// ============================================================================
+// 压缩（PackBits）
+//   控制字节 n < 128：后面跟 n+1 个原样字节
+//   控制字节 n > 128：下一个字节重复 257-n 次
+// ============================================================================
+
+std::vector<std::uint8_t> SaveSystem::compress(const std::vector<std::uint8_t>& data) {
+    std::vector<std::uint8_t> out;
+    out.reserve(data.size() / 2 + 16);
+
+    std::size_t i = 0;
+    const std::size_t n = data.size();
+    while (i < n) {
+        // 统计重复长度
+        std::size_t run = 1;
+        while (i + run < n && run < 128 && data[i + run] == data[i]) {
+            run++;
+        }
+
+        if (run >= 3) {
+            out.push_back(static_cast<std::uint8_t>(257 - run));
+            out.push_back(data[i]);
+            i += run;
+            continue;
+        }
+
+        // 原样段：直到遇到3个以上的重复或达到128字节
+        std::size_t start = i;
+        std::size_t literal = 0;
+        while (i < n && literal < 128) {
+            if (i + 2 < n && data[i] == data[i + 1] && data[i] == data[i + 2]) break;
+            i++;
+            literal++;
+        }
+        out.push_back(static_cast<std::uint8_t>(literal - 1));
+        out.insert(out.end(), data.begin() + start, data.begin() + start + literal);
+    }
+
+    return out;
+}
+
+bool SaveSystem::decompress(const std::vector<std::uint8_t>& data, std::size_t rawSize,
+                            std::vector<std::uint8_t>& out) {
+    out.clear();
+    out.reserve(rawSize);
+
+    std::size_t i = 0;
+    while (i < data.size()) {
+        std::uint8_t control = data[i++];
+        if (control < 128) {
+            std::size_t count = static_cast<std::size_t>(control) + 1;
+            if (i + count > data.size()) return false;
+            out.insert(out.end(), data.begin() + i, data.begin() + i + count);
+            i += count;
+        } else if (control > 128) {
+            if (i >= data.size()) return false;
+            out.insert(out.end(), static_cast<std::size_t>(257 - control), data[i++]);
+        }
+    }
+
+    return out.size() == rawSize;
+}
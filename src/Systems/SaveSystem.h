@@ -0,0 +1,117 @@
+#pragma once
+#include "../Entity/PlayerStats.h"
+#include "../Entity/Tree.h"
+#include "../Items/CategoryInventory.h"
+#include "../Items/Equipment.h"
+#include "../Items/DroppedItem.h"
+#include "../Pet/PetManager.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+// ============================================================================
+// 存档系统 (Save System)
+//
+// 核心概念：
+//   1. 世界快照 (WorldSnapshot) - 各管理器导出的纯数据副本，不含指针/贴图/回调
+//   2. 存档文件 - 版本化二进制格式，按分段(Section)存储，未知分段可跳过
+//   3. 异步保存 - 主线程只负责拷贝快照（几KB数据），序列化、压缩、
+//                 写盘和 fsync 都在后台线程完成，不会卡帧
+//   4. 读档 - 直接把快照写回各管理器，不重新解析 .tmj
+//
+// 使用方式：
+//   - 自动保存：SaveSystem::getInstance().saveAsync(snapshot, path)
+//   - 退出保存：SaveSystem::getInstance().saveNow(snapshot, path)
+//   - 读档：    SaveSystem::getInstance().load(path, snapshot)
+//
+// 文件格式：
+//   "PFSV" | uint32 版本 | uint32 原始长度 | RLE 压缩后的分段数据
+//   分段：  uint32 标签 | uint32 长度 | 数据
+// ============================================================================
+
+// 世界快照
+struct WorldSnapshot {
+    std::uint64_t worldSeed = 0;
+    int mapType = 0;
+
+    // 玩家
+    sf::Vector2f playerPosition;
+    PlayerStatsSaveData playerStats;
+
+    // 物品
+    InventorySaveData inventory;
+    PlayerEquipment::EquippedArray equipment;
+    std::vector<DroppedItemSaveData> droppedItems;
+
+    // 宠物
+    PetManagerSaveData pets;
+
+    // 世界
+    std::vector<TreeSaveData> trees;
+};
+
+class SaveSystem {
+public:
+    static SaveSystem& getInstance();
+
+    static constexpr std::uint32_t SAVE_VERSION = 1;
+
+    // ========================================
+    // 保存
+    // ========================================
+
+    // 异步保存（快照移交给后台线程；若上一次还没写完，只保留最新的快照）
+    void saveAsync(WorldSnapshot snapshot, const std::string& path);
+
+    // 同步保存（退出时使用）
+    bool saveNow(const WorldSnapshot& snapshot, const std::string& path);
+
+    // 等待后台保存完成
+    void flush();
+
+    bool isSaving() const;
+
+    // ========================================
+    // 读取
+    // ========================================
+    bool load(const std::string& path, WorldSnapshot& outSnapshot);
+
+    static bool exists(const std::string& path);
+
+    // ========================================
+    // 编码（公开便于工具/测试使用）
+    // ========================================
+    static std::vector<std::uint8_t> serialize(const WorldSnapshot& snapshot);
+    static bool deserialize(const std::vector<std::uint8_t>& data, WorldSnapshot& outSnapshot);
+
+    // PackBits 风格的游程编码（存档中大量空格子/零值，压缩效果好且足够快）
+    static std::vector<std::uint8_t> compress(const std::vector<std::uint8_t>& data);
+    static bool decompress(const std::vector<std::uint8_t>& data, std::size_t rawSize,
+                           std::vector<std::uint8_t>& out);
+
+private:
+    SaveSystem();
+    ~SaveSystem();
+    SaveSystem(const SaveSystem&) = delete;
+    SaveSystem& operator=(const SaveSystem&) = delete;
+
+    void workerLoop();
+
+    // 编码并写盘（先写临时文件并 fsync，再原子替换）
+    static bool writeSnapshot(const WorldSnapshot& snapshot, const std::string& path);
+
+private:
+    std::thread worker;
+    mutable std::mutex mutex;
+    std::condition_variable workAvailable;
+    std::condition_variable workDone;
+
+    std::unique_ptr<WorldSnapshot> pending;
+    std::string pendingPath;
+    bool busy = false;
+    bool stopping = false;
+};
@@ -0,0 +1,168 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// ============================================================================
+// 代际句柄 (Generational Handle) 和槽位表 (Slot Map)
+//
+// 管理器对外发放 Handle<T> 代替裸指针，跨帧保存也安全：
+//   - 句柄 = 槽位下标 + 代数；元素删除时槽位代数加一，旧句柄查找返回 nullptr
+//   - 元素在 values() 里连续存放；remove 与末尾交换（O(1)，顺序会变），
+//     removeIf 一次压实并保持剩余元素的顺序
+//   - 空出的槽位进入空闲链表，之后插入时复用
+//
+//   SlotMap<std::unique_ptr<Rabbit>, Rabbit> rabbits;
+//   RabbitHandle h = rabbits.insert(std::make_unique<Rabbit>());
+//   if (auto* rabbit = rabbits.get(h)) { ... }
+//   for (auto& rabbit : rabbits) { ... }        // 按存放顺序遍历
+// ============================================================================
+
+template<typename Tag>
+struct Handle {
+    static constexpr std::uint32_t INVALID_INDEX = 0xFFFFFFFFu;
+
+    std::uint32_t index = INVALID_INDEX;
+    std::uint32_t generation = 0;
+
+    bool isNull() const { return index == INVALID_INDEX; }
+    explicit operator bool() const { return !isNull(); }
+
+    bool operator==(const Handle& other) const {
+        return index == other.index && generation == other.generation;
+    }
+    bool operator!=(const Handle& other) const { return !(*this == other); }
+};
+
+template<typename T, typename Tag = T>
+class SlotMap {
+public:
+    using HandleType = Handle<Tag>;
+    using iterator = typename std::vector<T>::iterator;
+    using const_iterator = typename std::vector<T>::const_iterator;
+
+    HandleType insert(T value) {
+        std::uint32_t slotIndex;
+        if (freeHead != NO_SLOT) {
+            slotIndex = freeHead;
+            freeHead = slots[slotIndex].nextFree;
+        } else {
+            slotIndex = static_cast<std::uint32_t>(slots.size());
+            slots.push_back(Slot{});
+        }
+
+        Slot& slot = slots[slotIndex];
+        slot.dense = static_cast<std::uint32_t>(dense.size());
+        dense.push_back(std::move(value));
+        denseToSlot.push_back(slotIndex);
+        return HandleType{slotIndex, slot.generation};
+    }
+
+    bool contains(HandleType handle) const {
+        return handle.index < slots.size() &&
+               slots[handle.index].generation == handle.generation &&
+               slots[handle.index].dense != NO_SLOT;
+    }
+
+    // 句柄失效（元素已删除或从未存在）时返回 nullptr
+    T* get(HandleType handle) {
+        return contains(handle) ? &dense[slots[handle.index].dense] : nullptr;
+    }
+    const T* get(HandleType handle) const {
+        return contains(handle) ? &dense[slots[handle.index].dense] : nullptr;
+    }
+
+    bool remove(HandleType handle) {
+        if (!contains(handle)) return false;
+        removeAt(slots[handle.index].dense);
+        return true;
+    }
+
+    // 按存放下标删除：末尾元素移到该位置
+    void removeAt(size_t denseIndex) {
+        const std::uint32_t slotIndex = denseToSlot[denseIndex];
+        const size_t last = dense.size() - 1;
+        if (denseIndex != last) {
+            dense[denseIndex] = std::move(dense[last]);
+            denseToSlot[denseIndex] = denseToSlot[last];
+            slots[denseToSlot[denseIndex]].dense = static_cast<std::uint32_t>(denseIndex);
+        }
+        dense.pop_back();
+        denseToSlot.pop_back();
+        freeSlot(slotIndex);
+    }
+
+    // 删除所有满足条件的元素，返回删除数量
+    // 一次压实：剩余元素保持原有相对顺序（更新和绘制顺序不会因批量删除而打乱）
+    template<typename Pred>
+    size_t removeIf(Pred pred) {
+        size_t write = 0;
+        for (size_t read = 0; read < dense.size(); read++) {
+            const std::uint32_t slotIndex = denseToSlot[read];
+            if (pred(dense[read])) {
+                freeSlot(slotIndex);
+                continue;
+            }
+            if (write != read) {
+                dense[write] = std::move(dense[read]);
+                denseToSlot[write] = slotIndex;
+            }
+            slots[slotIndex].dense = static_cast<std::uint32_t>(write);
+            write++;
+        }
+        const size_t removed = dense.size() - write;
+        dense.erase(dense.begin() + static_cast<std::ptrdiff_t>(write), dense.end());
+        denseToSlot.resize(write);
+        return removed;
+    }
+
+    // 清空并让所有已发放的句柄失效
+    void clear() {
+        while (!dense.empty()) {
+            removeAt(dense.size() - 1);
+        }
+    }
+
+    HandleType handleAt(size_t denseIndex) const {
+        const std::uint32_t slotIndex = denseToSlot[denseIndex];
+        return HandleType{slotIndex, slots[slotIndex].generation};
+    }
+
+    size_t size() const { return dense.size(); }
+    bool empty() const { return dense.empty(); }
+    void reserve(size_t n) { dense.reserve(n); denseToSlot.reserve(n); slots.reserve(n); }
+
+    T& operator[](size_t denseIndex) { return dense[denseIndex]; }
+    const T& operator[](size_t denseIndex) const { return dense[denseIndex]; }
+
+    const std::vector<T>& values() const { return dense; }
+
+    iterator begin() { return dense.begin(); }
+    iterator end() { return dense.end(); }
+    const_iterator begin() const { return dense.begin(); }
+    const_iterator end() const { return dense.end(); }
+
+private:
+    static constexpr std::uint32_t NO_SLOT = 0xFFFFFFFFu;
+
+    // 代数加一（旧句柄失效）并放回空闲链表
+    void freeSlot(std::uint32_t slotIndex) {
+        Slot& slot = slots[slotIndex];
+        slot.generation++;
+        slot.dense = NO_SLOT;
+        slot.nextFree = freeHead;
+        freeHead = slotIndex;
+    }
+
+    struct Slot {
+        std::uint32_t generation = 1;       // 从 1 开始：默认构造的句柄永远无效
+        std::uint32_t dense = NO_SLOT;      // 元素在 dense 中的下标（空闲时为 NO_SLOT）
+        std::uint32_t nextFree = NO_SLOT;
+    };
+
+    std::vector<T> dense;
+    std::vector<std::uint32_t> denseToSlot;
+    std::vector<Slot> slots;
+    std::uint32_t freeHead = NO_SLOT;
+};
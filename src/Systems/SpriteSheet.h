@@ -0,0 +1,25 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+
+// ============================================================================
+// 方向精灵表布局 (Sprite Sheet Layout)
+//
+// 怪物和宠物共用的切帧方式：每行是一个动作的一个方向，按 下/上/左/右 排列
+//   移动行 = moveRow + 方向下标
+//   攻击行 = attackRow + 方向下标
+// 只描述布局，贴图由管理器加载一次后交给同类实体共享。
+// ============================================================================
+
+struct SpriteSheetLayout {
+    int frameWidth = 32;
+    int frameHeight = 32;
+    int framesPerRow = 4;
+    int moveRow = 0;
+    int attackRow = 4;
+    float frameTime = 0.15f;    // 每帧时长（秒）
+    float scale = 1.0f;         // 绘制缩放
+
+    sf::IntRect frameRect(int row, int col) const {
+        return sf::IntRect(col * frameWidth, row * frameHeight, frameWidth, frameHeight);
+    }
+};
@@ -1,5 +1,8 @@
 #include "CategoryInventoryPanel.h"
-#include <iostream>
+#include "../Systems/InputSystem.h"
+#include "../Systems/Logger.h"
+#include "../Systems/RenderStats.h"
+#include "../Systems/FrameArena.h"
 #include <sstream>
 
 // 颜色常量定义
@@ -45,14 +48,14 @@ bool CategoryInventoryPanel::init(const std::string& iconPath) {
         iconSprite.setTexture(iconTexture);
         iconSprite.setScale(0.8f, 0.8f);
         iconLoaded = true;
-        std::cout << "[CategoryInventoryPanel] Icon loaded: " << iconPath << std::endl;
+        LOG_INFO("[CategoryInventoryPanel] Icon loaded: " << iconPath);
     } else {
         sf::Image placeholder;
         placeholder.create(64, 64, sf::Color(100, 80, 60, 200));
         iconTexture.loadFromImage(placeholder);
         iconSprite.setTexture(iconTexture);
         iconLoaded = true;
-        std::cout << "[CategoryInventoryPanel] Using placeholder icon" << std::endl;
+        LOG_INFO("[CategoryInventoryPanel] Using placeholder icon");
     }
     
     std::vector<std::string> fontPaths = {
@@ -74,7 +77,7 @@ bool CategoryInventoryPanel::init(const std::string& iconPath) {
 bool CategoryInventoryPanel::loadFont(const std::string& fontPath) {
     if (font.loadFromFile(fontPath)) {
         fontLoaded = true;
-        std::cout << "[CategoryInventoryPanel] Font loaded: " << fontPath << std::endl;
+        LOG_INFO("[CategoryInventoryPanel] Font loaded: " << fontPath);
         return true;
     }
     return false;
@@ -102,8 +105,8 @@ void CategoryInventoryPanel::update(float dt) {
     );
 }
 
-void CategoryInventoryPanel::handleEvent(const sf::Event& event, sf::RenderWindow& window) {
-    sf::Vector2i mousePos = sf::Mouse::getPosition(window);
+void CategoryInventoryPanel::handleEvent(const sf::Event& event, sf::RenderWindow& /*window*/) {
+    sf::Vector2i mousePos = InputSystem::getInstance().getMousePosition();
     sf::Vector2f mousePosF(static_cast<float>(mousePos.x), static_cast<float>(mousePos.y));
     
     // 检查图标悬浮
@@ -375,8 +378,8 @@ void CategoryInventoryPanel::render(sf::RenderWindow& window) {
         iconBg.setFillColor(sf::Color(30, 30, 40, 200));
         iconBg.setOutlineThickness(2);
         iconBg.setOutlineColor(BORDER_COLOR);
-        window.draw(iconBg);
-        window.draw(iconSprite);
+        RenderStats::draw(window, iconBg);
+        RenderStats::draw(window, iconSprite);
     }
     
     if (!panelOpen || !inventory) return;
@@ -392,13 +395,13 @@ void CategoryInventoryPanel::render(sf::RenderWindow& window) {
     bg.setFillColor(BG_COLOR);
     bg.setOutlineThickness(3);
     bg.setOutlineColor(BORDER_COLOR);
-    window.draw(bg);
+    RenderStats::draw(window, bg);
     
     // 绘制标题栏
     sf::RectangleShape titleBar(sf::Vector2f(panelSize.x - 6, 30));
     titleBar.setPosition(panelPosition.x + 3, panelPosition.y + 3);
     titleBar.setFillColor(sf::Color(60, 45, 30, 200));
-    window.draw(titleBar);
+    RenderStats::draw(window, titleBar);
     
     if (fontLoaded) {
         sf::Text title;
@@ -408,7 +411,7 @@ void CategoryInventoryPanel::render(sf::RenderWindow& window) {
         title.setCharacterSize(20);
         title.setFillColor(sf::Color(255, 220, 150));
         title.setPosition(panelPosition.x + 15, panelPosition.y + 5);
-        window.draw(title);
+        RenderStats::draw(window, title);
     }
     
     // 关闭按钮
@@ -417,7 +420,7 @@ void CategoryInventoryPanel::render(sf::RenderWindow& window) {
     closeBtn.setFillColor(sf::Color(150, 50, 50, 200));
     closeBtn.setOutlineThickness(1);
     closeBtn.setOutlineColor(sf::Color::White);
-    window.draw(closeBtn);
+    RenderStats::draw(window, closeBtn);
     
     if (fontLoaded) {
         sf::Text closeText;
@@ -426,7 +429,7 @@ void CategoryInventoryPanel::render(sf::RenderWindow& window) {
         closeText.setCharacterSize(14);
         closeText.setFillColor(sf::Color::White);
         closeText.setPosition(panelPosition.x + panelSize.x - 21, panelPosition.y + 7);
-        window.draw(closeText);
+        RenderStats::draw(window, closeText);
     }
     
     // 渲染分类标签
@@ -444,7 +447,7 @@ void CategoryInventoryPanel::render(sf::RenderWindow& window) {
     prevBtn.setFillColor(currentPage > 0 ? sf::Color(60, 60, 70) : sf::Color(40, 40, 45));
     prevBtn.setOutlineThickness(1);
     prevBtn.setOutlineColor(sf::Color(80, 80, 80));
-    window.draw(prevBtn);
+    RenderStats::draw(window, prevBtn);
     
     sf::RectangleShape nextBtn(sf::Vector2f(30, 25));
     nextBtn.setPosition(panelPosition.x + panelSize.x - 80, bottomY);
@@ -452,7 +455,7 @@ void CategoryInventoryPanel::render(sf::RenderWindow& window) {
     nextBtn.setFillColor(currentPage < totalPages - 1 ? sf::Color(60, 60, 70) : sf::Color(40, 40, 45));
     nextBtn.setOutlineThickness(1);
     nextBtn.setOutlineColor(sf::Color(80, 80, 80));
-    window.draw(nextBtn);
+    RenderStats::draw(window, nextBtn);
     
     if (fontLoaded) {
         sf::Text prevText, nextText;
@@ -466,8 +469,8 @@ void CategoryInventoryPanel::render(sf::RenderWindow& window) {
         nextText.setFillColor(sf::Color::White);
         prevText.setPosition(panelPosition.x + 60, bottomY + 2);
         nextText.setPosition(panelPosition.x + panelSize.x - 70, bottomY + 2);
-        window.draw(prevText);
-        window.draw(nextText);
+        RenderStats::draw(window, prevText);
+        RenderStats::draw(window, nextText);
         
         // 页码
         std::stringstream ss;
@@ -479,7 +482,7 @@ void CategoryInventoryPanel::render(sf::RenderWindow& window) {
         pageText.setFillColor(sf::Color(200, 200, 200));
         sf::FloatRect bounds = pageText.getLocalBounds();
         pageText.setPosition(panelPosition.x + (panelSize.x - bounds.width) / 2, bottomY + 4);
-        window.draw(pageText);
+        RenderStats::draw(window, pageText);
     }
     
     // 整理按钮
@@ -488,7 +491,7 @@ void CategoryInventoryPanel::render(sf::RenderWindow& window) {
     sortBtn.setFillColor(sf::Color(60, 60, 70));
     sortBtn.setOutlineThickness(1);
     sortBtn.setOutlineColor(sf::Color(80, 80, 80));
-    window.draw(sortBtn);
+    RenderStats::draw(window, sortBtn);
     
     if (fontLoaded) {
         sf::Text sortText;
@@ -498,7 +501,7 @@ void CategoryInventoryPanel::render(sf::RenderWindow& window) {
         sortText.setCharacterSize(12);
         sortText.setFillColor(sf::Color::White);
         sortText.setPosition(panelPosition.x + panelSize.x - 132, bottomY + 5);
-        window.draw(sortText);
+        RenderStats::draw(window, sortText);
     }
     
     // 金币显示（移到标题栏右侧，避免与翻页按钮重叠）
@@ -514,7 +517,7 @@ void CategoryInventoryPanel::render(sf::RenderWindow& window) {
         // 将金币显示移到标题栏右侧（关闭按钮左边）
         sf::FloatRect goldBounds = goldText.getLocalBounds();
         goldText.setPosition(panelPosition.x + panelSize.x - goldBounds.width - 35, panelPosition.y + 8);
-        window.draw(goldText);
+        RenderStats::draw(window, goldText);
     }
     
     // 渲染提示框
@@ -528,7 +531,7 @@ void CategoryInventoryPanel::renderCategoryTabs(sf::RenderWindow& window) {
     float tabY = panelPosition.y + 35;
     float tabWidth = (panelSize.x - 20) / 3;
     
-    std::vector<std::string> tabNames = {"材料", "消耗品", "装备"};
+    static const std::string tabNames[] = {"材料", "消耗品", "装备"};
     
     for (int i = 0; i < 3; i++) {
         InventoryCategory cat = static_cast<InventoryCategory>(i);
@@ -539,7 +542,7 @@ void CategoryInventoryPanel::renderCategoryTabs(sf::RenderWindow& window) {
         tab.setFillColor(isActive ? TAB_ACTIVE_COLOR : TAB_COLOR);
         tab.setOutlineThickness(isActive ? 2 : 1);
         tab.setOutlineColor(isActive ? sf::Color(200, 150, 100) : sf::Color(80, 80, 80));
-        window.draw(tab);
+        RenderStats::draw(window, tab);
         
         if (fontLoaded) {
             sf::Text tabText;
@@ -553,7 +556,7 @@ void CategoryInventoryPanel::renderCategoryTabs(sf::RenderWindow& window) {
                 panelPosition.x + 12 + i * tabWidth + (tabWidth - 4 - bounds.width) / 2,
                 tabY + 8
             );
-            window.draw(tabText);
+            RenderStats::draw(window, tabText);
         }
     }
 }
@@ -584,7 +587,7 @@ void CategoryInventoryPanel::renderSlot(sf::RenderWindow& window, int index) {
     
     slotBg.setOutlineThickness(1);
     slotBg.setOutlineColor(isSelected ? sf::Color(200, 150, 100) : sf::Color(60, 60, 60));
-    window.draw(slotBg);
+    RenderStats::draw(window, slotBg);
     
     // 获取实际格子索引
     int actualSlot = currentPage * CATEGORY_SLOTS_PER_PAGE + index;
@@ -607,7 +610,7 @@ void CategoryInventoryPanel::renderSlot(sf::RenderWindow& window, int index) {
                 slotPos.y + (SLOT_SIZE - spriteBounds.height) / 2
             );
             
-            window.draw(itemSprite);
+            RenderStats::draw(window, itemSprite);
         }
         
         // 数量显示
@@ -625,7 +628,7 @@ void CategoryInventoryPanel::renderSlot(sf::RenderWindow& window, int index) {
                 slotPos.x + SLOT_SIZE - bounds.width - 4,
                 slotPos.y + SLOT_SIZE - bounds.height - 8
             );
-            window.draw(countText);
+            RenderStats::draw(window, countText);
         }
     }
 }
@@ -640,11 +643,11 @@ void CategoryInventoryPanel::renderTooltip(sf::RenderWindow& window) {
     const ItemData* data = ItemDatabase::getInstance().getItemData(stack.itemId);
     if (!data) return;
     
-    sf::Vector2i mousePos = sf::Mouse::getPosition(window);
+    sf::Vector2i mousePos = InputSystem::getInstance().getMousePosition();
     float tooltipX = mousePos.x + 15.0f;
     float tooltipY = mousePos.y + 15.0f;
     
-    std::vector<std::pair<sf::String, sf::Color>> lines;
+    FrameVector<std::pair<sf::String, sf::Color>> lines;
     
     // 名称
     lines.push_back({sf::String::fromUtf8(data->name.begin(), data->name.end()), 
@@ -747,7 +750,7 @@ void CategoryInventoryPanel::renderTooltip(sf::RenderWindow& window) {
     bg.setFillColor(sf::Color(20, 20, 30, 245));
     bg.setOutlineThickness(2);
     bg.setOutlineColor(ItemDatabase::getRarityColor(data->rarity));
-    window.draw(bg);
+    RenderStats::draw(window, bg);
     
     // 绘制文字
     float y = tooltipY + padding;
@@ -763,7 +766,7 @@ void CategoryInventoryPanel::renderTooltip(sf::RenderWindow& window) {
         text.setCharacterSize(i == 0 ? 16 : 14);
         text.setFillColor(lines[i].second);
         text.setPosition(tooltipX + padding, y);
-        window.draw(text);
+        RenderStats::draw(window, text);
         
         y += lineHeight;
     }
@@ -782,7 +785,7 @@ void CategoryInventoryPanel::renderContextMenu(sf::RenderWindow& window) {
     bg.setFillColor(MENU_BG_COLOR);
     bg.setOutlineThickness(2);
     bg.setOutlineColor(sf::Color(100, 100, 100));
-    window.draw(bg);
+    RenderStats::draw(window, bg);
     
     // 菜单项
     for (size_t i = 0; i < contextMenuOptions.size(); i++) {
@@ -792,7 +795,7 @@ void CategoryInventoryPanel::renderContextMenu(sf::RenderWindow& window) {
             sf::RectangleShape hoverBg(sf::Vector2f(menuWidth - 4, menuItemHeight - 2));
             hoverBg.setPosition(contextMenuPos.x + 2, contextMenuPos.y + i * menuItemHeight + 1);
             hoverBg.setFillColor(MENU_HOVER_COLOR);
-            window.draw(hoverBg);
+            RenderStats::draw(window, hoverBg);
         }
         
         std::string optionName = getContextMenuOptionName(contextMenuOptions[i]);
@@ -802,7 +805,7 @@ void CategoryInventoryPanel::renderContextMenu(sf::RenderWindow& window) {
         text.setCharacterSize(14);
         text.setFillColor(sf::Color::White);
         text.setPosition(contextMenuPos.x + 10, contextMenuPos.y + i * menuItemHeight + 5);
-        window.draw(text);
+        RenderStats::draw(window, text);
     }
 }
 
@@ -855,8 +858,8 @@ void CategoryInventoryPanel::switchCategory(InventoryCategory category) {
         currentPage = 0;
         selectedSlot = -1;
         showContextMenu = false;
-        std::cout << "[CategoryInventoryPanel] Switched to " 
-                  << CategoryInventory::getCategoryName(category) << std::endl;
+        LOG_INFO("[CategoryInventoryPanel] Switched to " 
+              << CategoryInventory::getCategoryName(category));
     }
 }
 
@@ -881,14 +884,14 @@ void CategoryInventoryPanel::open() {
     panelOpen = true;
     selectedSlot = -1;
     showContextMenu = false;
-    std::cout << "[CategoryInventoryPanel] Opened" << std::endl;
+    LOG_INFO("[CategoryInventoryPanel] Opened");
 }
 
 void CategoryInventoryPanel::close() {
     panelOpen = false;
     selectedSlot = -1;
     showContextMenu = false;
-    std::cout << "[CategoryInventoryPanel] Closed" << std::endl;
+    LOG_INFO("[CategoryInventoryPanel] Closed");
 }
 
 void CategoryInventoryPanel::toggle() {
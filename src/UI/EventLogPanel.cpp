@@ -1,7 +1,6 @@
 #include "EventLogPanel.h"
-#include <sstream>
-#include <iomanip>
-#include <iostream>
+#include "../Systems/Logger.h"
+#include "../Systems/RenderStats.h"
 #include <cmath>
 #include <algorithm>
 
@@ -19,7 +18,10 @@ namespace {
 // ============================================================================
 
 EventLogPanel::EventLogPanel()
-    : maxMessages(50)
+    : records{}
+    , head(0)
+    , count(0)
+    , maxMessages(50)
     , defaultDuration(6.0f)
     , position(0.0f, 0.0f)
     , size(320.0f, 300.0f)
@@ -77,13 +79,13 @@ bool EventLogPanel::init(const std::string& fontPath) {
     for (const auto& path : fontPaths) {
         if (!path.empty() && font.loadFromFile(path)) {
             fontLoaded = true;
-            std::cout << "[EventLogPanel] 字体加载成功: " << path << std::endl;
+            LOG_INFO("[EventLogPanel] 字体加载成功: " << path);
             break;
         }
     }
     
     if (!fontLoaded) {
-        std::cerr << "[EventLogPanel] 警告: 无法加载字体" << std::endl;
+        LOG_WARN("[EventLogPanel] 警告: 无法加载字体");
     }
     
     // 初始化背景
@@ -112,9 +114,15 @@ bool EventLogPanel::init(const std::string& fontPath) {
         collapseText.setString("[-]");
         collapseText.setCharacterSize(14);
         collapseText.setFillColor(sf::Color(200, 200, 200));
+        
+        rowText.setFont(font);
+        rowText.setCharacterSize(14);
     }
     
-    std::cout << "[EventLogPanel] 初始化完成" << std::endl;
+    rowBackground.setSize(sf::Vector2f(size.x - padding * 2, lineHeight - 2));
+    formatBuffer.reserve(128);
+    
+    LOG_INFO("[EventLogPanel] 初始化完成");
     return true;
 }
 
@@ -141,6 +149,7 @@ void EventLogPanel::setSize(float width, float height) {
     background.setSize(size);
     border.setSize(sf::Vector2f(size.x + 4, size.y + 4));
     header.setSize(sf::Vector2f(size.x, headerHeight));
+    rowBackground.setSize(sf::Vector2f(size.x - padding * 2, lineHeight - 2));
     
     // 更新位置
     setPosition(position.x, position.y);
@@ -156,11 +165,13 @@ void EventLogPanel::update(float dt) {
     collapseAnim += (targetCollapseAnim - collapseAnim) * 8.0f * dt;
     
     // 更新消息
-    for (auto it = messages.begin(); it != messages.end(); ) {
-        EventMessage& msg = *it;
+    bool anyExpired = false;
+    for (size_t i = 0; i < count; i++) {
+        EventRecord& msg = records[slotAt(i)];
         
         // 更新生命周期
         msg.lifetime -= dt;
+        msg.age += dt;
         
         // 新消息滑入动画
         if (msg.isNew) {
@@ -188,24 +199,36 @@ void EventLogPanel::update(float dt) {
             msg.alpha = std::min(1.0f, msg.alpha + flash);
         }
         
-        // 移除过期消息
         if (msg.lifetime <= 0.0f) {
-            it = messages.erase(it);
-        } else {
-            ++it;
+            anyExpired = true;
         }
     }
     
+    // 移除过期消息（原地压缩，保持顺序；文本槽交换而不是复制）
+    if (anyExpired) {
+        size_t kept = 0;
+        for (size_t i = 0; i < count; i++) {
+            size_t from = slotAt(i);
+            if (records[from].lifetime <= 0.0f) continue;
+            size_t to = slotAt(kept++);
+            if (to != from) {
+                records[to] = records[from];
+                texts[to].swap(texts[from]);
+            }
+        }
+        count = kept;
+    }
+    
     // 平滑滚动
     scrollOffset += (targetScrollOffset - scrollOffset) * 10.0f * dt;
     
     // 计算最大滚动范围
-    float contentHeight = messages.size() * lineHeight;
+    float contentHeight = count * lineHeight;
     float visibleHeight = size.y - headerHeight - padding * 2;
     maxScroll = std::max(0.0f, contentHeight - visibleHeight);
     
     // 自动滚动到最新消息
-    if (!messages.empty() && messages.back().isNew) {
+    if (count > 0 && records[slotAt(count - 1)].isNew) {
         targetScrollOffset = maxScroll;
     }
 }
@@ -228,16 +251,16 @@ void EventLogPanel::render(sf::RenderWindow& window) {
     animBorder.setSize(sf::Vector2f(size.x + 4, animatedHeight + 4));
     
     // 绘制背景
-    window.draw(animBorder);
-    window.draw(animBg);
+    RenderStats::draw(window, animBorder);
+    RenderStats::draw(window, animBg);
     
     // 绘制标题栏
-    window.draw(header);
-    window.draw(titleText);
+    RenderStats::draw(window, header);
+    RenderStats::draw(window, titleText);
     
     // 绘制折叠按钮
     collapseText.setString(collapsed ? "[+]" : "[-]");
-    window.draw(collapseText);
+    RenderStats::draw(window, collapseText);
     
     // 如果折叠，只显示标题
     if (collapseAnim < 0.1f) {
@@ -264,9 +287,10 @@ void EventLogPanel::render(sf::RenderWindow& window) {
     // 绘制消息（从底部向上）
     float y = messageAreaTop + messageAreaHeight;
     
-    // 从最新消息开始向上绘制
-    for (auto it = messages.rbegin(); it != messages.rend(); ++it) {
-        const EventMessage& msg = *it;
+    // 从最新消息开始向上绘制（只为可见行生成文本）
+    for (size_t i = count; i-- > 0; ) {
+        size_t slot = slotAt(i);
+        const EventRecord& msg = records[slot];
         
         y -= lineHeight;
         
@@ -279,28 +303,21 @@ void EventLogPanel::render(sf::RenderWindow& window) {
         float drawX = position.x + padding + msg.slideOffset;
         
         // 绘制消息背景（带透明度）
-        sf::RectangleShape msgBg;
-        msgBg.setSize(sf::Vector2f(size.x - padding * 2, lineHeight - 2));
-        msgBg.setPosition(position.x + padding, drawY);
-        msgBg.setFillColor(sf::Color(0, 0, 0, static_cast<sf::Uint8>(50 * msg.alpha * collapseAnim)));
-        window.draw(msgBg);
-        
-        // 绘制消息文字
-        sf::Text text;
-        text.setFont(font);
-        text.setCharacterSize(14);
+        rowBackground.setPosition(position.x + padding, drawY);
+        rowBackground.setFillColor(sf::Color(0, 0, 0, static_cast<sf::Uint8>(50 * msg.alpha * collapseAnim)));
+        RenderStats::draw(window, rowBackground);
         
         // 构建显示文本
-        std::string displayText = getEventPrefix(msg.type) + " " + msg.text;
-        text.setString(toSfString(displayText));
+        formatRecord(msg, texts[slot], formatBuffer);
+        rowText.setString(toSfString(formatBuffer));
         
         // 设置颜色（带透明度）
-        sf::Color color = msg.color;
+        sf::Color color = getEventColor(msg.type);
         color.a = static_cast<sf::Uint8>(255 * msg.alpha * collapseAnim);
-        text.setFillColor(color);
+        rowText.setFillColor(color);
         
-        text.setPosition(drawX, drawY + 2);
-        window.draw(text);
+        rowText.setPosition(drawX, drawY + 2);
+        RenderStats::draw(window, rowText);
     }
     
     // 绘制滚动条（如果需要）
@@ -312,7 +329,7 @@ void EventLogPanel::render(sf::RenderWindow& window) {
         scrollBar.setSize(sf::Vector2f(4.0f, scrollBarHeight));
         scrollBar.setPosition(position.x + size.x - 8.0f, scrollBarY);
         scrollBar.setFillColor(sf::Color(100, 100, 100, static_cast<sf::Uint8>(150 * collapseAnim)));
-        window.draw(scrollBar);
+        RenderStats::draw(window, scrollBar);
     }
     
     // 绘制分隔线
@@ -320,7 +337,7 @@ void EventLogPanel::render(sf::RenderWindow& window) {
     separator.setSize(sf::Vector2f(size.x - padding * 2, 1.0f));
     separator.setPosition(position.x + padding, position.y + headerHeight);
     separator.setFillColor(sf::Color(100, 90, 80, static_cast<sf::Uint8>(200 * collapseAnim)));
-    window.draw(separator);
+    RenderStats::draw(window, separator);
 }
 
 // ============================================================================
@@ -328,190 +345,74 @@ void EventLogPanel::render(sf::RenderWindow& window) {
 // ============================================================================
 
 void EventLogPanel::addMessage(const std::string& text, EventType type) {
-    EventMessage msg;
-    msg.text = text;
-    msg.type = type;
-    msg.color = getEventColor(type);
-    msg.lifetime = defaultDuration;
-    msg.maxLifetime = defaultDuration;
-    
-    pushMessage(msg);
+    pushRecord(type, INVALID_ITEM_ID, 0, defaultDuration, &text);
+}
+
+void EventLogPanel::addItemObtained(ItemId itemId, int count) {
+    pushRecord(EventType::ItemObtained, itemId, count, defaultDuration);
+    
+    const ItemData* data = ItemDatabase::getInstance().getItemData(itemId);
+    LOG_DEBUG("[EventLog] 获得物品: " << (data ? data->name : "?") << " x" << count);
 }
 
 void EventLogPanel::addItemObtained(const std::string& itemName, int count, const std::string& iconId) {
-    EventMessage msg;
-    msg.type = EventType::ItemObtained;
-    msg.color = itemColor;
-    msg.lifetime = defaultDuration;
-    msg.maxLifetime = defaultDuration;
-    msg.hasIcon = !iconId.empty();
-    msg.iconId = iconId;
-    msg.value = count;
-    
-    std::stringstream ss;
-    if (count > 1) {
-        ss << itemName << " x" << count;
-    } else {
-        ss << itemName;
+    ItemId itemId = iconId.empty() ? INVALID_ITEM_ID : ItemDatabase::getInstance().getItemId(iconId);
+    if (itemId != INVALID_ITEM_ID) {
+        addItemObtained(itemId, count);
+        return;
     }
-    msg.text = ss.str();
     
-    pushMessage(msg);
-    std::cout << "[EventLog] 获得物品: " << msg.text << std::endl;
+    pushRecord(EventType::ItemObtained, INVALID_ITEM_ID, count, defaultDuration, &itemName);
+    LOG_DEBUG("[EventLog] 获得物品: " << itemName << " x" << count);
 }
 
 void EventLogPanel::addGoldObtained(int amount) {
-    EventMessage msg;
-    msg.type = EventType::GoldObtained;
-    msg.color = goldColor;
-    msg.lifetime = defaultDuration;
-    msg.maxLifetime = defaultDuration;
-    msg.value = amount;
-    
-    std::stringstream ss;
-    ss << "+" << amount << " 金币";
-    msg.text = ss.str();
-    
-    pushMessage(msg);
-    std::cout << "[EventLog] 获得金币: " << amount << std::endl;
+    pushRecord(EventType::GoldObtained, INVALID_ITEM_ID, amount, defaultDuration);
+    LOG_DEBUG("[EventLog] 获得金币: " << amount);
 }
 
 void EventLogPanel::addExpObtained(int amount, const std::string& source) {
-    EventMessage msg;
-    msg.type = EventType::ExpObtained;
-    msg.color = expColor;
-    msg.lifetime = defaultDuration;
-    msg.maxLifetime = defaultDuration;
-    msg.value = amount;
-    
-    std::stringstream ss;
-    ss << "+" << amount << " 经验";
-    if (!source.empty()) {
-        ss << " (" << source << ")";
-    }
-    msg.text = ss.str();
-    
-    pushMessage(msg);
-    std::cout << "[EventLog] 获得经验: " << amount << std::endl;
+    pushRecord(EventType::ExpObtained, INVALID_ITEM_ID, amount, defaultDuration, source.empty() ? nullptr : &source);
+    LOG_DEBUG("[EventLog] 获得经验: " << amount);
 }
 
 void EventLogPanel::addLevelUp(int newLevel) {
-    EventMessage msg;
-    msg.type = EventType::LevelUp;
-    msg.color = levelUpColor;
-    msg.lifetime = defaultDuration * 1.5f;  // 升级消息显示更久
-    msg.maxLifetime = msg.lifetime;
-    msg.value = newLevel;
-    
-    std::stringstream ss;
-    ss << "恭喜升级！当前等级: Lv." << newLevel;
-    msg.text = ss.str();
-    
-    pushMessage(msg);
-    std::cout << "[EventLog] ★★★ 升级到 Lv." << newLevel << " ★★★" << std::endl;
+    pushRecord(EventType::LevelUp, INVALID_ITEM_ID, newLevel, defaultDuration * 1.5f);  // 升级消息显示更久
+    LOG_DEBUG("[EventLog] ★★★ 升级到 Lv." << newLevel << " ★★★");
 }
 
 void EventLogPanel::addSkillLevelUp(const std::string& skillName, int newLevel) {
-    EventMessage msg;
-    msg.type = EventType::SkillLevelUp;
-    msg.color = skillColor;
-    msg.lifetime = defaultDuration * 1.2f;
-    msg.maxLifetime = msg.lifetime;
-    msg.value = newLevel;
-    
-    std::stringstream ss;
-    ss << skillName << " 技能升级! Lv." << newLevel;
-    msg.text = ss.str();
-    
-    pushMessage(msg);
-    std::cout << "[EventLog] 技能升级: " << skillName << " -> Lv." << newLevel << std::endl;
+    pushRecord(EventType::SkillLevelUp, INVALID_ITEM_ID, newLevel, defaultDuration * 1.2f, &skillName);
+    LOG_DEBUG("[EventLog] 技能升级: " << skillName << " -> Lv." << newLevel);
 }
 
 void EventLogPanel::addTreeMature(const std::string& treeName) {
-    EventMessage msg;
-    msg.type = EventType::TreeMature;
-    msg.color = treeColor;
-    msg.lifetime = defaultDuration;
-    msg.maxLifetime = defaultDuration;
-    
-    std::stringstream ss;
-    ss << treeName << " 已成熟，可以收获了！";
-    msg.text = ss.str();
-    
-    pushMessage(msg);
-    std::cout << "[EventLog] 树木成熟: " << treeName << std::endl;
+    pushRecord(EventType::TreeMature, INVALID_ITEM_ID, 0, defaultDuration, &treeName);
+    LOG_DEBUG("[EventLog] 树木成熟: " << treeName);
 }
 
 void EventLogPanel::addTreeChopped(const std::string& treeName) {
-    EventMessage msg;
-    msg.type = EventType::TreeChopped;
-    msg.color = sf::Color(180, 140, 100);  // 棕色
-    msg.lifetime = defaultDuration;
-    msg.maxLifetime = defaultDuration;
-    
-    std::stringstream ss;
-    ss << "砍伐了 " << treeName;
-    msg.text = ss.str();
-    
-    pushMessage(msg);
-    std::cout << "[EventLog] 砍伐树木: " << treeName << std::endl;
+    pushRecord(EventType::TreeChopped, INVALID_ITEM_ID, 1, defaultDuration, &treeName);
+    LOG_DEBUG("[EventLog] 砍伐树木: " << treeName);
 }
 
 void EventLogPanel::addFruitHarvested(const std::string& fruitName, int count) {
-    EventMessage msg;
-    msg.type = EventType::FruitHarvested;
-    msg.color = sf::Color(255, 180, 100);  // 橙色
-    msg.lifetime = defaultDuration;
-    msg.maxLifetime = defaultDuration;
-    msg.value = count;
-    
-    std::stringstream ss;
-    ss << "采摘了 " << fruitName;
-    if (count > 1) {
-        ss << " x" << count;
-    }
-    msg.text = ss.str();
-    
-    pushMessage(msg);
-    std::cout << "[EventLog] 采摘果实: " << fruitName << " x" << count << std::endl;
+    pushRecord(EventType::FruitHarvested, INVALID_ITEM_ID, count, defaultDuration, &fruitName);
+    LOG_DEBUG("[EventLog] 采摘果实: " << fruitName << " x" << count);
 }
 
 void EventLogPanel::addCombatMessage(const std::string& text) {
-    EventMessage msg;
-    msg.type = EventType::Combat;
-    msg.color = combatColor;
-    msg.lifetime = defaultDuration * 0.8f;  // 战斗消息显示时间短些
-    msg.maxLifetime = msg.lifetime;
-    msg.text = text;
-    
-    pushMessage(msg);
+    pushRecord(EventType::Combat, INVALID_ITEM_ID, 0, defaultDuration * 0.8f, &text);  // 战斗消息显示时间短些
 }
 
 void EventLogPanel::addAchievement(const std::string& achievementName) {
-    EventMessage msg;
-    msg.type = EventType::Achievement;
-    msg.color = achievementColor;
-    msg.lifetime = defaultDuration * 2.0f;  // 成就消息显示更久
-    msg.maxLifetime = msg.lifetime;
-    
-    std::stringstream ss;
-    ss << "🏆 成就达成: " << achievementName;
-    msg.text = ss.str();
-    
-    pushMessage(msg);
-    std::cout << "[EventLog] ★ 成就达成: " << achievementName << std::endl;
+    pushRecord(EventType::Achievement, INVALID_ITEM_ID, 0, defaultDuration * 2.0f, &achievementName);  // 成就消息显示更久
+    LOG_DEBUG("[EventLog] ★ 成就达成: " << achievementName);
 }
 
 void EventLogPanel::addWarning(const std::string& text) {
-    EventMessage msg;
-    msg.type = EventType::Warning;
-    msg.color = warningColor;
-    msg.lifetime = defaultDuration;
-    msg.maxLifetime = defaultDuration;
-    msg.text = text;
-    
-    pushMessage(msg);
-    std::cout << "[EventLog] 警告: " << text << std::endl;
+    pushRecord(EventType::Warning, INVALID_ITEM_ID, 0, defaultDuration, &text);
+    LOG_WARN("[EventLog] 警告: " << text);
 }
 
 // ============================================================================
@@ -519,7 +420,8 @@ void EventLogPanel::addWarning(const std::string& text) {
 // ============================================================================
 
 void EventLogPanel::clearMessages() {
-    messages.clear();
+    head = 0;
+    count = 0;
     scrollOffset = 0.0f;
     targetScrollOffset = 0.0f;
 }
@@ -539,8 +441,8 @@ sf::Color EventLogPanel::getEventColor(EventType type) const {
         case EventType::LevelUp:        return levelUpColor;
         case EventType::SkillLevelUp:   return skillColor;
         case EventType::TreeMature:     return treeColor;
-        case EventType::TreeChopped:    return sf::Color(180, 140, 100);
-        case EventType::FruitHarvested: return sf::Color(255, 180, 100);
+        case EventType::TreeChopped:    return sf::Color(180, 140, 100);  // 棕色
+        case EventType::FruitHarvested: return sf::Color(255, 180, 100);  // 橙色
         case EventType::Combat:         return combatColor;
         case EventType::System:         return systemColor;
         case EventType::Achievement:    return achievementColor;
@@ -549,7 +451,7 @@ sf::Color EventLogPanel::getEventColor(EventType type) const {
     }
 }
 
-std::string EventLogPanel::getEventPrefix(EventType type) const {
+const char* EventLogPanel::getEventPrefix(EventType type) const {
     switch (type) {
         case EventType::ItemObtained:   return "📦";
         case EventType::GoldObtained:   return "💰";
@@ -567,21 +469,125 @@ std::string EventLogPanel::getEventPrefix(EventType type) const {
     }
 }
 
-void EventLogPanel::pushMessage(const EventMessage& msg) {
-    // 添加新消息
-    messages.push_back(msg);
+size_t EventLogPanel::pushRecord(EventType type, ItemId itemId, int value, float lifetime, const std::string* text) {
+    // 合并：近期同类记录（同物品/同来源）直接累加数量并重置显示时间
+    bool coalescable = type == EventType::ItemObtained || type == EventType::GoldObtained ||
+                       type == EventType::ExpObtained || type == EventType::FruitHarvested ||
+                       type == EventType::TreeChopped;
+    if (coalescable) {
+        size_t lookback = std::min(count, COALESCE_LOOKBACK);
+        for (size_t n = 0; n < lookback; n++) {
+            size_t slot = slotAt(count - 1 - n);
+            EventRecord& existing = records[slot];
+            // 合并会重置 age，记录不再按 age 有序，不能遇到旧记录就停
+            if (existing.age > COALESCE_WINDOW) continue;
+            if (existing.type != type || existing.itemId != itemId) continue;
+            if (existing.hasText != (text != nullptr)) continue;
+            if (text && texts[slot] != *text) continue;
+            
+            existing.value += value;
+            existing.age = 0.0f;        // 连续事件持续合并，窗口从最后一次算起
+            existing.lifetime = std::max(existing.lifetime, lifetime);
+            existing.maxLifetime = std::max(existing.maxLifetime, lifetime);
+            return slot;
+        }
+    }
     
-    // 限制消息数量
-    while (messages.size() > maxMessages) {
-        messages.pop_front();
+    // 已满时覆盖最旧的记录
+    size_t limit = std::min(maxMessages, CAPACITY);
+    while (count >= limit) {
+        head = (head + 1) % CAPACITY;
+        count--;
+    }
+    
+    size_t slot = slotAt(count++);
+    EventRecord& record = records[slot];
+    record.type = type;
+    record.itemId = itemId;
+    record.value = value;
+    record.age = 0.0f;
+    record.lifetime = lifetime;
+    record.maxLifetime = lifetime;
+    record.alpha = 1.0f;
+    record.flashTimer = 0.0f;
+    record.slideOffset = 100.0f;
+    record.isNew = true;
+    record.hasText = text != nullptr;
+    if (text) {
+        texts[slot].assign(*text);  // 复用槽位已有容量
     }
     
     // 自动滚动到底部
     targetScrollOffset = maxScroll;
+    return slot;
 }
 
-void EventLogPanel::drawMessage(sf::RenderWindow& window, const EventMessage& msg, float y, float panelWidth) {
-    // 此方法保留用于未来扩展（如绘制物品图标等）
+void EventLogPanel::formatRecord(const EventRecord& record, const std::string& text, std::string& out) const {
+    out.assign(getEventPrefix(record.type));
+    out += ' ';
+    
+    switch (record.type) {
+        case EventType::ItemObtained: {
+            const ItemData* data = ItemDatabase::getInstance().getItemData(record.itemId);
+            out += data ? data->name : text;
+            if (record.value > 1) {
+                out += " x";
+                out += std::to_string(record.value);
+            }
+            break;
+        }
+        case EventType::GoldObtained:
+            out += '+';
+            out += std::to_string(record.value);
+            out += " 金币";
+            break;
+        case EventType::ExpObtained:
+            out += '+';
+            out += std::to_string(record.value);
+            out += " 经验";
+            if (record.hasText) {
+                out += " (";
+                out += text;
+                out += ')';
+            }
+            break;
+        case EventType::LevelUp:
+            out += "恭喜升级！当前等级: Lv.";
+            out += std::to_string(record.value);
+            break;
+        case EventType::SkillLevelUp:
+            out += text;
+            out += " 技能升级! Lv.";
+            out += std::to_string(record.value);
+            break;
+        case EventType::TreeMature:
+            out += text;
+            out += " 已成熟，可以收获了！";
+            break;
+        case EventType::TreeChopped:
+            out += "砍伐了 ";
+            out += text;
+            if (record.value > 1) {
+                out += " x";
+                out += std::to_string(record.value);
+            }
+            break;
+        case EventType::FruitHarvested:
+            out += "采摘了 ";
+            out += text;
+            if (record.value > 1) {
+                out += " x";
+                out += std::to_string(record.value);
+            }
+            break;
+        case EventType::Achievement:
+            out += "🏆 成就达成: ";
+            out += text;
+            break;
+        default:
+            out += text;
+            break;
+    }
 }
 
 void EventLogPanel::drawCollapseButton(sf::RenderWindow& window) {
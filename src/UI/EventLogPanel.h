@@ -1,8 +1,11 @@
 #pragma once
+#include "../Items/Item.h"
 #include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <array>
+#include <cstdint>
 #include <string>
 #include <vector>
-#include <deque>
 #include <functional>
 
 // ============================================================================
@@ -14,6 +17,13 @@
 //   - 消息带有淡入淡出动画效果
 //   - 自动滚动显示最新消息
 //   - 可折叠/展开
+//
+// 存储：
+//   - 固定容量环形缓冲区，每条记录只存类型、物品ID、数量、计时等数值
+//   - 短时间内同类事件合并为一条（"木材 x12"），连续砍树/击杀不会刷屏
+//   - 文本在渲染时才按记录拼接，且只拼接可见的行
+//   - 自由文本（系统消息、经验来源等）存在与记录同下标的字符串槽中，
+//     槽位复用，不随每条消息分配
 // ============================================================================
 
 // 事件类型枚举
@@ -32,32 +42,19 @@ enum class EventType {
     Warning             // 警告信息（橙红色）
 };
 
-// 单条事件消息
-struct EventMessage {
-    std::string text;           // 消息文本
+// 单条事件记录（POD，文本在渲染时生成）
+struct EventRecord {
     EventType type;             // 事件类型
+    ItemId itemId;              // 物品ID（获得物品）
+    int value;                  // 数量/数值（合并时累加）
+    float age;                  // 已存在时间（秒）
     float lifetime;             // 剩余显示时间
     float maxLifetime;          // 最大显示时间
     float alpha;                // 当前透明度 (0-1)
-    sf::Color color;            // 文字颜色
-    bool hasIcon;               // 是否显示图标
-    std::string iconId;         // 图标ID（用于物品图标）
-    int value;                  // 数值（用于显示+XX）
     float flashTimer;           // 闪烁计时器（用于特殊效果）
-    bool isNew;                 // 是否是新消息（用于弹出动画）
     float slideOffset;          // 滑入偏移量
-    
-    EventMessage() 
-        : type(EventType::System)
-        , lifetime(5.0f)
-        , maxLifetime(5.0f)
-        , alpha(1.0f)
-        , hasIcon(false)
-        , value(0)
-        , flashTimer(0.0f)
-        , isNew(true)
-        , slideOffset(100.0f)
-    {}
+    bool isNew;                 // 是否是新消息（用于弹出动画）
+    bool hasText;               // 是否使用同下标的文本槽
 };
 
 class EventLogPanel {
@@ -86,7 +83,10 @@ public:
     // 通用添加消息
     void addMessage(const std::string& text, EventType type = EventType::System);
     
-    // 获得物品
+    // 获得物品（名称从 ItemDatabase 读取）
+    void addItemObtained(ItemId itemId, int count = 1);
+    
+    // 获得物品（iconId 为物品ID；未注册的物品按名称显示）
     void addItemObtained(const std::string& itemName, int count = 1, const std::string& iconId = "");
     
     // 获得金币
@@ -132,8 +132,11 @@ public:
     void expand() { collapsed = false; }
     bool isCollapsed() const { return collapsed; }
     
-    // 设置最大消息数量
-    void setMaxMessages(size_t max) { maxMessages = max; }
+    // 设置最大消息数量（不超过 CAPACITY）
+    void setMaxMessages(size_t max) { maxMessages = std::min(std::max<size_t>(max, 1), CAPACITY); }
+    
+    // 当前消息数量
+    size_t getMessageCount() const { return count; }
     
     // 设置消息默认持续时间
     void setMessageDuration(float seconds) { defaultDuration = seconds; }
@@ -149,23 +152,37 @@ private:
     sf::Color getEventColor(EventType type) const;
     
     // 获取事件类型对应的前缀图标
-    std::string getEventPrefix(EventType type) const;
+    const char* getEventPrefix(EventType type) const;
+    
+    // 添加一条记录（可合并时累加到已有记录），返回记录下标
+    size_t pushRecord(EventType type, ItemId itemId, int value, float lifetime, const std::string* text = nullptr);
     
-    // 添加消息到队列
-    void pushMessage(const EventMessage& msg);
+    // 按记录生成显示文本（写入 out，复用其容量）
+    void formatRecord(const EventRecord& record, const std::string& text, std::string& out) const;
     
-    // 绘制单条消息
-    void drawMessage(sf::RenderWindow& window, const EventMessage& msg, float y, float panelWidth);
+    // 环形缓冲区下标（i = 0 为最旧）
+    size_t slotAt(size_t i) const { return (head + i) % CAPACITY; }
     
     // 绘制折叠按钮
     void drawCollapseButton(sf::RenderWindow& window);
 
 private:
-    // === 消息队列 ===
-    std::deque<EventMessage> messages;
+    // === 消息环形缓冲区 ===
+    static constexpr size_t CAPACITY = 64;
+    static constexpr float COALESCE_WINDOW = 2.0f;      // 合并窗口（秒）
+    static constexpr size_t COALESCE_LOOKBACK = 8;      // 向前查找可合并记录的条数
+    std::array<EventRecord, CAPACITY> records;
+    std::array<std::string, CAPACITY> texts;            // 与 records 同下标的文本槽
+    size_t head;                                        // 最旧记录的下标
+    size_t count;                                       // 当前记录数
     size_t maxMessages;
     float defaultDuration;
     
+    // 渲染复用（避免每行构造 sf::Text / 字符串）
+    std::string formatBuffer;
+    sf::Text rowText;
+    sf::RectangleShape rowBackground;
+    
     // === 面板属性 ===
     sf::Vector2f position;          // 面板位置
     sf::Vector2f size;              // 面板大小
@@ -1,5 +1,8 @@
 #include "InventoryPanel.h"
-#include <iostream>
+#include "../Systems/InputSystem.h"
+#include "../Systems/Logger.h"
+#include "../Systems/RenderStats.h"
+#include "../Systems/FrameArena.h"
 #include <sstream>
 
 // 颜色常量定义
@@ -34,7 +37,7 @@ bool InventoryPanel::init(const std::string& iconPath) {
         iconSprite.setTexture(iconTexture);
         iconSprite.setScale(0.8f, 0.8f);
         iconLoaded = true;
-        std::cout << "[InventoryPanel] Icon loaded: " << iconPath << std::endl;
+        LOG_INFO("[InventoryPanel] Icon loaded: " << iconPath);
     } else {
         // 创建占位图标
         sf::Image placeholder;
@@ -42,7 +45,7 @@ bool InventoryPanel::init(const std::string& iconPath) {
         iconTexture.loadFromImage(placeholder);
         iconSprite.setTexture(iconTexture);
         iconLoaded = true;
-        std::cout << "[InventoryPanel] Using placeholder icon" << std::endl;
+        LOG_INFO("[InventoryPanel] Using placeholder icon");
     }
     
     // 尝试加载字体（优先使用系统中文字体）
@@ -65,7 +68,7 @@ bool InventoryPanel::init(const std::string& iconPath) {
 bool InventoryPanel::loadFont(const std::string& fontPath) {
     if (font.loadFromFile(fontPath)) {
         fontLoaded = true;
-        std::cout << "[InventoryPanel] Font loaded: " << fontPath << std::endl;
+        LOG_INFO("[InventoryPanel] Font loaded: " << fontPath);
         return true;
     }
     return false;
@@ -80,8 +83,8 @@ void InventoryPanel::update(float /*dt*/) {
     // 动画更新（如果需要）
 }
 
-void InventoryPanel::handleEvent(const sf::Event& event, sf::RenderWindow& window) {
-    sf::Vector2i mousePos = sf::Mouse::getPosition(window);
+void InventoryPanel::handleEvent(const sf::Event& event, sf::RenderWindow& /*window*/) {
+    sf::Vector2i mousePos = InputSystem::getInstance().getMousePosition();
     sf::Vector2f mousePosF(static_cast<float>(mousePos.x), static_cast<float>(mousePos.y));
     
     // 检查图标点击（打开背包）
@@ -172,7 +175,7 @@ void InventoryPanel::handleEvent(const sf::Event& event, sf::RenderWindow& windo
             int clickedSlot = getSlotAtPosition(mousePosF);
             if (clickedSlot >= 0) {
                 // Shift+点击 = 快速丢弃
-                if (sf::Keyboard::isKeyPressed(sf::Keyboard::LShift)) {
+                if (InputSystem::getInstance().isDown(InputAction::Modifier)) {
                     selectedSlot = clickedSlot;
                     dropSelectedItem();
                 } else {
@@ -213,8 +216,8 @@ void InventoryPanel::render(sf::RenderWindow& window) {
         iconBg.setFillColor(sf::Color(30, 30, 40, 200));
         iconBg.setOutlineThickness(2);
         iconBg.setOutlineColor(BORDER_COLOR);
-        window.draw(iconBg);
-        window.draw(iconSprite);
+        RenderStats::draw(window, iconBg);
+        RenderStats::draw(window, iconSprite);
     }
     
     if (!panelOpen || !inventory) return;
@@ -230,13 +233,13 @@ void InventoryPanel::render(sf::RenderWindow& window) {
     bg.setFillColor(BG_COLOR);
     bg.setOutlineThickness(3);
     bg.setOutlineColor(BORDER_COLOR);
-    window.draw(bg);
+    RenderStats::draw(window, bg);
     
     // 绘制标题栏
     sf::RectangleShape titleBar(sf::Vector2f(panelSize.x - 6, 30));
     titleBar.setPosition(panelPosition.x + 3, panelPosition.y + 3);
     titleBar.setFillColor(sf::Color(60, 45, 30, 200));
-    window.draw(titleBar);
+    RenderStats::draw(window, titleBar);
     
     if (fontLoaded) {
         sf::Text title;
@@ -246,7 +249,7 @@ void InventoryPanel::render(sf::RenderWindow& window) {
         title.setCharacterSize(20);
         title.setFillColor(sf::Color(255, 215, 0));
         title.setPosition(panelPosition.x + 15, panelPosition.y + 5);
-        window.draw(title);
+        RenderStats::draw(window, title);
     }
     
     // 绘制关闭按钮
@@ -255,7 +258,7 @@ void InventoryPanel::render(sf::RenderWindow& window) {
     closeBtn.setFillColor(sf::Color(150, 50, 50, 200));
     closeBtn.setOutlineThickness(1);
     closeBtn.setOutlineColor(sf::Color::White);
-    window.draw(closeBtn);
+    RenderStats::draw(window, closeBtn);
     
     if (fontLoaded) {
         sf::Text closeX;
@@ -264,7 +267,7 @@ void InventoryPanel::render(sf::RenderWindow& window) {
         closeX.setCharacterSize(16);
         closeX.setFillColor(sf::Color::White);
         closeX.setPosition(panelPosition.x + panelSize.x - 24, panelPosition.y + 6);
-        window.draw(closeX);
+        RenderStats::draw(window, closeX);
     }
     
     // 绘制格子
@@ -283,7 +286,7 @@ void InventoryPanel::render(sf::RenderWindow& window) {
         prevBtn.setFillColor(currentPage > 0 ? sf::Color(80, 80, 100) : sf::Color(50, 50, 60));
         prevBtn.setOutlineThickness(1);
         prevBtn.setOutlineColor(sf::Color::White);
-        window.draw(prevBtn);
+        RenderStats::draw(window, prevBtn);
         
         sf::Text prevText;
         prevText.setFont(font);
@@ -291,7 +294,7 @@ void InventoryPanel::render(sf::RenderWindow& window) {
         prevText.setCharacterSize(16);
         prevText.setFillColor(sf::Color::White);
         prevText.setPosition(panelPosition.x + 110, bottomY + 2);
-        window.draw(prevText);
+        RenderStats::draw(window, prevText);
         
         // 页码
         sf::Text pageText;
@@ -300,7 +303,7 @@ void InventoryPanel::render(sf::RenderWindow& window) {
         pageText.setCharacterSize(16);
         pageText.setFillColor(sf::Color::White);
         pageText.setPosition(panelPosition.x + panelSize.x / 2 - 20, bottomY + 2);
-        window.draw(pageText);
+        RenderStats::draw(window, pageText);
         
         // 下一页
         sf::RectangleShape nextBtn(sf::Vector2f(30, 25));
@@ -308,7 +311,7 @@ void InventoryPanel::render(sf::RenderWindow& window) {
         nextBtn.setFillColor(currentPage < inventory->getTotalPages() - 1 ? sf::Color(80, 80, 100) : sf::Color(50, 50, 60));
         nextBtn.setOutlineThickness(1);
         nextBtn.setOutlineColor(sf::Color::White);
-        window.draw(nextBtn);
+        RenderStats::draw(window, nextBtn);
         
         sf::Text nextText;
         nextText.setFont(font);
@@ -316,7 +319,7 @@ void InventoryPanel::render(sf::RenderWindow& window) {
         nextText.setCharacterSize(16);
         nextText.setFillColor(sf::Color::White);
         nextText.setPosition(panelPosition.x + panelSize.x - 70, bottomY + 2);
-        window.draw(nextText);
+        RenderStats::draw(window, nextText);
         
         // 整理按钮
         sf::RectangleShape sortBtn(sf::Vector2f(50, 25));
@@ -324,7 +327,7 @@ void InventoryPanel::render(sf::RenderWindow& window) {
         sortBtn.setFillColor(sf::Color(60, 100, 60));
         sortBtn.setOutlineThickness(1);
         sortBtn.setOutlineColor(sf::Color::White);
-        window.draw(sortBtn);
+        RenderStats::draw(window, sortBtn);
         
         sf::Text sortText;
         sortText.setFont(font);
@@ -333,7 +336,7 @@ void InventoryPanel::render(sf::RenderWindow& window) {
         sortText.setCharacterSize(14);
         sortText.setFillColor(sf::Color::White);
         sortText.setPosition(panelPosition.x + panelSize.x - 133, bottomY + 3);
-        window.draw(sortText);
+        RenderStats::draw(window, sortText);
         
         // 金币显示
         sf::Text goldText;
@@ -345,7 +348,7 @@ void InventoryPanel::render(sf::RenderWindow& window) {
         goldText.setCharacterSize(16);
         goldText.setFillColor(sf::Color(255, 215, 0));
         goldText.setPosition(panelPosition.x + 15, bottomY + 2);
-        window.draw(goldText);
+        RenderStats::draw(window, goldText);
     }
     
     // 绘制悬浮提示
@@ -375,7 +378,7 @@ void InventoryPanel::renderSlot(sf::RenderWindow& window, int index) {
     slot.setFillColor(slotColor);
     slot.setOutlineThickness(1);
     slot.setOutlineColor(sf::Color(80, 80, 80));
-    window.draw(slot);
+    RenderStats::draw(window, slot);
     
     // 绘制物品
     const ItemStack& stack = inventory->getSlot(actualSlot);
@@ -388,7 +391,7 @@ void InventoryPanel::renderSlot(sf::RenderWindow& window, int index) {
             float scale = (SLOT_SIZE - 8) / std::max(texSize.x, texSize.y);
             itemSprite.setScale(scale, scale);
             itemSprite.setPosition(slotPos.x + 4, slotPos.y + 4);
-            window.draw(itemSprite);
+            RenderStats::draw(window, itemSprite);
         }
         
         // 绘制数量
@@ -406,7 +409,7 @@ void InventoryPanel::renderSlot(sf::RenderWindow& window, int index) {
                 slotPos.x + SLOT_SIZE - bounds.width - 4,
                 slotPos.y + SLOT_SIZE - bounds.height - 8
             );
-            window.draw(countText);
+            RenderStats::draw(window, countText);
         }
     }
 }
@@ -422,14 +425,14 @@ void InventoryPanel::renderTooltip(sf::RenderWindow& window) {
     if (!data) return;
     
     // 获取鼠标位置
-    sf::Vector2i mousePos = sf::Mouse::getPosition(window);
+    sf::Vector2i mousePos = InputSystem::getInstance().getMousePosition();
     float tooltipX = mousePos.x + 15.0f;
     float tooltipY = mousePos.y + 15.0f;
     
     // ========================================
     // 使用 sf::String 正确显示 UTF-8 中文
     // ========================================
-    std::vector<std::pair<sf::String, sf::Color>> lines;
+    FrameVector<std::pair<sf::String, sf::Color>> lines;
     
     // 名称（带稀有度颜色）
     lines.push_back({sf::String::fromUtf8(data->name.begin(), data->name.end()), 
@@ -511,7 +514,7 @@ void InventoryPanel::renderTooltip(sf::RenderWindow& window) {
     bg.setFillColor(sf::Color(20, 20, 30, 245));
     bg.setOutlineThickness(2);
     bg.setOutlineColor(ItemDatabase::getRarityColor(data->rarity));
-    window.draw(bg);
+    RenderStats::draw(window, bg);
     
     // 绘制文字
     float y = tooltipY + padding;
@@ -527,7 +530,7 @@ void InventoryPanel::renderTooltip(sf::RenderWindow& window) {
         text.setCharacterSize(i == 0 ? 18 : 16);
         text.setFillColor(lines[i].second);
         text.setPosition(tooltipX + padding, y);
-        window.draw(text);
+        RenderStats::draw(window, text);
         
         y += lineHeight;
     }
@@ -546,7 +549,7 @@ void InventoryPanel::renderContextMenu(sf::RenderWindow& window) {
     bg.setFillColor(sf::Color(40, 40, 50, 240));
     bg.setOutlineThickness(1);
     bg.setOutlineColor(sf::Color::White);
-    window.draw(bg);
+    RenderStats::draw(window, bg);
     
     // 菜单项（使用 sf::String::fromUtf8）
     std::vector<sf::String> items;
@@ -562,7 +565,7 @@ void InventoryPanel::renderContextMenu(sf::RenderWindow& window) {
         text.setCharacterSize(14);
         text.setFillColor(sf::Color::White);
         text.setPosition(contextMenuPos.x + 10, contextMenuPos.y + 5 + i * itemHeight);
-        window.draw(text);
+        RenderStats::draw(window, text);
     }
 }
 
@@ -591,14 +594,14 @@ void InventoryPanel::open() {
     panelOpen = true;
     selectedSlot = -1;
     showContextMenu = false;
-    std::cout << "[InventoryPanel] Opened" << std::endl;
+    LOG_INFO("[InventoryPanel] Opened");
 }
 
 void InventoryPanel::close() {
     panelOpen = false;
     selectedSlot = -1;
     showContextMenu = false;
-    std::cout << "[InventoryPanel] Closed" << std::endl;
+    LOG_INFO("[InventoryPanel] Closed");
 }
 
 void InventoryPanel::toggle() {
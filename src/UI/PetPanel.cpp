@@ -1,5 +1,7 @@
 #include "PetPanel.h"
-#include <iostream>
+#include "../Systems/InputSystem.h"
+#include "../Systems/Logger.h"
+#include "../Systems/RenderStats.h"
 #include <sstream>
 #include <iomanip>
 
@@ -57,7 +59,7 @@ bool PetPanel::init(const std::string& iconPath) {
 bool PetPanel::loadFont(const std::string& fontPath) {
     if (font.loadFromFile(fontPath)) {
         fontLoaded = true;
-        std::cout << "[PetPanel] Font loaded: " << fontPath << std::endl;
+        LOG_INFO("[PetPanel] Font loaded: " << fontPath);
         return true;
     }
     return false;
@@ -76,8 +78,8 @@ void PetPanel::update(float dt) {
     (void)dt;
 }
 
-void PetPanel::handleEvent(const sf::Event& event, sf::RenderWindow& window) {
-    sf::Vector2i mouseScreenPos = sf::Mouse::getPosition(window);
+void PetPanel::handleEvent(const sf::Event& event, sf::RenderWindow& /*window*/) {
+    sf::Vector2i mouseScreenPos = InputSystem::getInstance().getMousePosition();
     sf::Vector2f mousePos(static_cast<float>(mouseScreenPos.x), static_cast<float>(mouseScreenPos.y));
     
     if (event.type == sf::Event::MouseButtonPressed && 
@@ -146,13 +148,13 @@ void PetPanel::renderIcon(sf::RenderWindow& window) {
     sf::RectangleShape shadow(sf::Vector2f(bgSize, bgSize));
     shadow.setPosition(iconPosition.x - 6 + 3, iconPosition.y - 6 + 3);
     shadow.setFillColor(sf::Color(20, 20, 20, 150));
-    window.draw(shadow);
+    RenderStats::draw(window, shadow);
     
     // 主背景
     sf::RectangleShape iconBg(sf::Vector2f(bgSize, bgSize));
     iconBg.setPosition(iconPosition.x - 6, iconPosition.y - 6);
     iconBg.setFillColor(panelOpen ? sf::Color(60, 90, 60, 240) : sf::Color(35, 35, 45, 240));
-    window.draw(iconBg);
+    RenderStats::draw(window, iconBg);
     
     // 像素风格边框 - 外层
     sf::RectangleShape outerBorder(sf::Vector2f(bgSize, bgSize));
@@ -160,7 +162,7 @@ void PetPanel::renderIcon(sf::RenderWindow& window) {
     outerBorder.setFillColor(sf::Color::Transparent);
     outerBorder.setOutlineThickness(3);
     outerBorder.setOutlineColor(panelOpen ? sf::Color(100, 160, 100) : sf::Color(70, 70, 90));
-    window.draw(outerBorder);
+    RenderStats::draw(window, outerBorder);
     
     // 内层高光边框
     sf::RectangleShape innerBorder(sf::Vector2f(bgSize - 6, bgSize - 6));
@@ -168,9 +170,9 @@ void PetPanel::renderIcon(sf::RenderWindow& window) {
     innerBorder.setFillColor(sf::Color::Transparent);
     innerBorder.setOutlineThickness(2);
     innerBorder.setOutlineColor(panelOpen ? sf::Color(140, 200, 140, 150) : sf::Color(100, 100, 120, 150));
-    window.draw(innerBorder);
+    RenderStats::draw(window, innerBorder);
     
-    window.draw(iconSprite);
+    RenderStats::draw(window, iconSprite);
     
     if (fontLoaded) {
         std::string labelStr = "宠物";
@@ -179,11 +181,11 @@ void PetPanel::renderIcon(sf::RenderWindow& window) {
         sf::Text labelShadow = label;
         labelShadow.setPosition(iconPosition.x + ICON_SIZE / 2 - 14 + 1, iconPosition.y + ICON_SIZE + 6 + 1);
         labelShadow.setFillColor(sf::Color(20, 20, 20, 200));
-        window.draw(labelShadow);
+        RenderStats::draw(window, labelShadow);
         
         label.setPosition(iconPosition.x + ICON_SIZE / 2 - 14, iconPosition.y + ICON_SIZE + 6);
         label.setFillColor(sf::Color::White);
-        window.draw(label);
+        RenderStats::draw(window, label);
     }
 }
 
@@ -192,13 +194,13 @@ void PetPanel::renderPanel(sf::RenderWindow& window) {
     sf::RectangleShape shadow(panelSize + sf::Vector2f(6, 6));
     shadow.setPosition(panelPos.x + 4, panelPos.y + 4);
     shadow.setFillColor(sf::Color(15, 15, 15, 180));
-    window.draw(shadow);
+    RenderStats::draw(window, shadow);
     
     // 主背景 - 像素风格深色
     sf::RectangleShape background(panelSize);
     background.setPosition(panelPos);
     background.setFillColor(sf::Color(35, 32, 28, 250));
-    window.draw(background);
+    RenderStats::draw(window, background);
     
     // 像素风格多层边框
     // 外层深色边框
@@ -207,7 +209,7 @@ void PetPanel::renderPanel(sf::RenderWindow& window) {
     outerBorder.setFillColor(sf::Color::Transparent);
     outerBorder.setOutlineThickness(4);
     outerBorder.setOutlineColor(sf::Color(90, 75, 55));
-    window.draw(outerBorder);
+    RenderStats::draw(window, outerBorder);
     
     // 中层边框
     sf::RectangleShape midBorder(panelSize - sf::Vector2f(8, 8));
@@ -215,7 +217,7 @@ void PetPanel::renderPanel(sf::RenderWindow& window) {
     midBorder.setFillColor(sf::Color::Transparent);
     midBorder.setOutlineThickness(2);
     midBorder.setOutlineColor(sf::Color(140, 120, 90));
-    window.draw(midBorder);
+    RenderStats::draw(window, midBorder);
     
     // 内层高光
     sf::RectangleShape innerHighlight(panelSize - sf::Vector2f(12, 12));
@@ -223,7 +225,7 @@ void PetPanel::renderPanel(sf::RenderWindow& window) {
     innerHighlight.setFillColor(sf::Color::Transparent);
     innerHighlight.setOutlineThickness(1);
     innerHighlight.setOutlineColor(sf::Color(180, 160, 120, 100));
-    window.draw(innerHighlight);
+    RenderStats::draw(window, innerHighlight);
     
     // 标题栏 - 像素风格
     sf::RectangleShape titleBar(sf::Vector2f(panelSize.x - 8, 44));
@@ -231,13 +233,13 @@ void PetPanel::renderPanel(sf::RenderWindow& window) {
     titleBar.setFillColor(sf::Color(55, 45, 38));
     titleBar.setOutlineThickness(2);
     titleBar.setOutlineColor(sf::Color(80, 65, 50));
-    window.draw(titleBar);
+    RenderStats::draw(window, titleBar);
     
     // 标题栏底部高光
     sf::RectangleShape titleHighlight(sf::Vector2f(panelSize.x - 12, 2));
     titleHighlight.setPosition(panelPos.x + 6, panelPos.y + 46);
     titleHighlight.setFillColor(sf::Color(120, 100, 75));
-    window.draw(titleHighlight);
+    RenderStats::draw(window, titleHighlight);
     
     if (fontLoaded) {
         std::string titleStr = "我的宠物";
@@ -246,11 +248,11 @@ void PetPanel::renderPanel(sf::RenderWindow& window) {
         sf::Text titleShadow = title;
         titleShadow.setPosition(panelPos.x + panelSize.x / 2 - 50 + 2, panelPos.y + 10 + 2);
         titleShadow.setFillColor(sf::Color(20, 20, 20, 200));
-        window.draw(titleShadow);
+        RenderStats::draw(window, titleShadow);
         
         title.setPosition(panelPos.x + panelSize.x / 2 - 50, panelPos.y + 10);
         title.setFillColor(sf::Color(230, 210, 170));
-        window.draw(title);
+        RenderStats::draw(window, title);
         
         // 关闭按钮 - 像素风格
         sf::FloatRect closeRect = getCloseButtonRect();
@@ -259,14 +261,14 @@ void PetPanel::renderPanel(sf::RenderWindow& window) {
         sf::RectangleShape closeShadow(sf::Vector2f(32, 32));
         closeShadow.setPosition(closeRect.left + 2, closeRect.top + 2);
         closeShadow.setFillColor(sf::Color(30, 15, 15, 180));
-        window.draw(closeShadow);
+        RenderStats::draw(window, closeShadow);
         
         sf::RectangleShape closeBtn(sf::Vector2f(32, 32));
         closeBtn.setPosition(closeRect.left, closeRect.top);
         closeBtn.setFillColor(sf::Color(140, 50, 50));
         closeBtn.setOutlineThickness(3);
         closeBtn.setOutlineColor(sf::Color(100, 35, 35));
-        window.draw(closeBtn);
+        RenderStats::draw(window, closeBtn);
         
         // 按钮内边框高光
         sf::RectangleShape closeHighlight(sf::Vector2f(26, 26));
@@ -274,12 +276,12 @@ void PetPanel::renderPanel(sf::RenderWindow& window) {
         closeHighlight.setFillColor(sf::Color::Transparent);
         closeHighlight.setOutlineThickness(1);
         closeHighlight.setOutlineColor(sf::Color(200, 100, 100, 150));
-        window.draw(closeHighlight);
+        RenderStats::draw(window, closeHighlight);
         
         sf::Text closeText("X", font, 20);
         closeText.setPosition(closeRect.left + 9, closeRect.top + 4);
         closeText.setFillColor(sf::Color::White);
-        window.draw(closeText);
+        RenderStats::draw(window, closeText);
     }
     
     // 左侧区域标题
@@ -291,19 +293,19 @@ void PetPanel::renderPanel(sf::RenderWindow& window) {
         sf::Text myPetTitle(toSfString(myPetStr), font, 18);
         myPetTitle.setPosition(leftX, leftY);
         myPetTitle.setFillColor(sf::Color(190, 170, 140));
-        window.draw(myPetTitle);
+        RenderStats::draw(window, myPetTitle);
     }
     
     // 左侧分隔线 - 像素风格双线
     sf::RectangleShape leftDivider(sf::Vector2f(150, 3));
     leftDivider.setPosition(leftX, leftY + 28);
     leftDivider.setFillColor(sf::Color(110, 90, 70));
-    window.draw(leftDivider);
+    RenderStats::draw(window, leftDivider);
     
     sf::RectangleShape leftDividerHighlight(sf::Vector2f(150, 1));
     leftDividerHighlight.setPosition(leftX, leftY + 31);
     leftDividerHighlight.setFillColor(sf::Color(70, 55, 45));
-    window.draw(leftDividerHighlight);
+    RenderStats::draw(window, leftDividerHighlight);
     
     // 渲染宠物列表（左侧）
     renderPetSlots(window);
@@ -312,12 +314,12 @@ void PetPanel::renderPanel(sf::RenderWindow& window) {
     sf::RectangleShape rightDivider(sf::Vector2f(3, panelSize.y - 70));
     rightDivider.setPosition(panelPos.x + 185, panelPos.y + 58);
     rightDivider.setFillColor(sf::Color(110, 90, 70));
-    window.draw(rightDivider);
+    RenderStats::draw(window, rightDivider);
     
     sf::RectangleShape rightDividerHighlight(sf::Vector2f(1, panelSize.y - 70));
     rightDividerHighlight.setPosition(panelPos.x + 188, panelPos.y + 58);
     rightDividerHighlight.setFillColor(sf::Color(70, 55, 45));
-    window.draw(rightDividerHighlight);
+    RenderStats::draw(window, rightDividerHighlight);
     
     // 渲染宠物详细信息（右侧）
     renderPetInfo(window);
@@ -356,7 +358,7 @@ void PetPanel::renderPetSlots(sf::RenderWindow& window) {
             slot.setOutlineColor(sf::Color(255, 215, 0));  // 金色边框
         }
         
-        window.draw(slot);
+        RenderStats::draw(window, slot);
         
         if (pet) {
             // 绘制宠物精灵表第一帧作为图标
@@ -373,7 +375,7 @@ void PetPanel::renderPetSlots(sf::RenderWindow& window) {
                 petIcon.setScale(iconScale, iconScale);
                 petIcon.setPosition(slotRect.left + 8, slotRect.top + 4);
                 
-                window.draw(petIcon);
+                RenderStats::draw(window, petIcon);
             }
             
             if (fontLoaded) {
@@ -382,7 +384,7 @@ void PetPanel::renderPetSlots(sf::RenderWindow& window) {
                 sf::Text levelText(lvStr, font, 10);
                 levelText.setPosition(slotRect.left + 8, slotRect.top + SLOT_SIZE - 18);
                 levelText.setFillColor(sf::Color(200, 200, 200));
-                window.draw(levelText);
+                RenderStats::draw(window, levelText);
             }
         } else if (fontLoaded) {
             // 空槽位显示"空"
@@ -390,7 +392,7 @@ void PetPanel::renderPetSlots(sf::RenderWindow& window) {
             sf::Text emptyText(toSfString(emptyStr), font, 14);
             emptyText.setPosition(slotRect.left + 25, slotRect.top + 25);
             emptyText.setFillColor(sf::Color(80, 80, 80));
-            window.draw(emptyText);
+            RenderStats::draw(window, emptyText);
         }
     }
 }
@@ -409,12 +411,12 @@ void PetPanel::renderPetInfo(sf::RenderWindow& window) {
     sf::Text infoTitle(toSfString(infoTitleStr), font, 16);
     infoTitle.setPosition(infoX, infoY);
     infoTitle.setFillColor(sf::Color(180, 160, 130));
-    window.draw(infoTitle);
+    RenderStats::draw(window, infoTitle);
     
     sf::RectangleShape infoDivider(sf::Vector2f(infoWidth - 20, 2));
     infoDivider.setPosition(infoX, infoY + 25);
     infoDivider.setFillColor(sf::Color(100, 80, 60));
-    window.draw(infoDivider);
+    RenderStats::draw(window, infoDivider);
     
     infoY += 35;
     
@@ -423,7 +425,7 @@ void PetPanel::renderPetInfo(sf::RenderWindow& window) {
         sf::Text noSelect(toSfString(noStr), font, 16);
         noSelect.setPosition(infoX + 100, infoY + 80);
         noSelect.setFillColor(sf::Color(120, 120, 120));
-        window.draw(noSelect);
+        RenderStats::draw(window, noSelect);
         return;
     }
     
@@ -433,14 +435,14 @@ void PetPanel::renderPetInfo(sf::RenderWindow& window) {
     avatar.setFillColor(sf::Color(60, 50, 45));
     avatar.setOutlineThickness(3);
     avatar.setOutlineColor(Pet::getQualityColor(pet->getQuality()));
-    window.draw(avatar);
+    RenderStats::draw(window, avatar);
     
     // 头像内显示类型名
     std::string avatarStr = pet->getPetTypeName();
     sf::Text avatarText(toSfString(avatarStr), font, 16);
     avatarText.setPosition(infoX + 15, infoY + 25);
     avatarText.setFillColor(Pet::getQualityColor(pet->getQuality()));
-    window.draw(avatarText);
+    RenderStats::draw(window, avatarText);
     
     // 名称和资质（头像右边）
     float detailX = infoX + 85;
@@ -448,20 +450,20 @@ void PetPanel::renderPetInfo(sf::RenderWindow& window) {
     sf::Text nameText(toSfString(nameStr), font, 18);
     nameText.setPosition(detailX, infoY);
     nameText.setFillColor(Pet::getQualityColor(pet->getQuality()));
-    window.draw(nameText);
+    RenderStats::draw(window, nameText);
     
     std::string qualityStr = "资质: " + Pet::getQualityName(pet->getQuality());
     sf::Text qualityText(toSfString(qualityStr), font, 14);
     qualityText.setPosition(detailX, infoY + 25);
     qualityText.setFillColor(sf::Color(200, 180, 140));
-    window.draw(qualityText);
+    RenderStats::draw(window, qualityText);
     
     std::stringstream ss;
     ss << "等级: " << pet->getLevel() << "   经验: " << pet->getExp() << "/" << pet->getExpToNextLevel();
     sf::Text levelText(toSfString(ss.str()), font, 13);
     levelText.setPosition(detailX, infoY + 48);
     levelText.setFillColor(sf::Color::White);
-    window.draw(levelText);
+    RenderStats::draw(window, levelText);
     
     infoY += 85;
     
@@ -475,7 +477,7 @@ void PetPanel::renderPetInfo(sf::RenderWindow& window) {
     sf::Text hpText(toSfString(ss.str()), font, 14);
     hpText.setPosition(attrX, infoY);
     hpText.setFillColor(sf::Color(255, 120, 120));
-    window.draw(hpText);
+    RenderStats::draw(window, hpText);
     
     // 攻击
     ss.str("");
@@ -483,7 +485,7 @@ void PetPanel::renderPetInfo(sf::RenderWindow& window) {
     sf::Text atkText(toSfString(ss.str()), font, 14);
     atkText.setPosition(attrX + attrWidth, infoY);
     atkText.setFillColor(sf::Color(255, 200, 100));
-    window.draw(atkText);
+    RenderStats::draw(window, atkText);
     
     infoY += lineHeight;
     
@@ -493,7 +495,7 @@ void PetPanel::renderPetInfo(sf::RenderWindow& window) {
     sf::Text defText(toSfString(ss.str()), font, 14);
     defText.setPosition(attrX, infoY);
     defText.setFillColor(sf::Color(100, 180, 255));
-    window.draw(defText);
+    RenderStats::draw(window, defText);
     
     // 闪避
     ss.str("");
@@ -501,7 +503,7 @@ void PetPanel::renderPetInfo(sf::RenderWindow& window) {
     sf::Text dodgeText(toSfString(ss.str()), font, 14);
     dodgeText.setPosition(attrX + attrWidth, infoY);
     dodgeText.setFillColor(sf::Color(150, 255, 150));
-    window.draw(dodgeText);
+    RenderStats::draw(window, dodgeText);
     
     infoY += lineHeight + 15;
     
@@ -510,12 +512,12 @@ void PetPanel::renderPetInfo(sf::RenderWindow& window) {
     sf::Text skillTitle(toSfString(skillTitleStr), font, 16);
     skillTitle.setPosition(infoX, infoY);
     skillTitle.setFillColor(sf::Color(180, 160, 130));
-    window.draw(skillTitle);
+    RenderStats::draw(window, skillTitle);
     
     sf::RectangleShape skillDivider(sf::Vector2f(infoWidth - 20, 2));
     skillDivider.setPosition(infoX, infoY + 22);
     skillDivider.setFillColor(sf::Color(100, 80, 60));
-    window.draw(skillDivider);
+    RenderStats::draw(window, skillDivider);
     
     infoY += 32;
     
@@ -533,7 +535,7 @@ void PetPanel::renderPetInfo(sf::RenderWindow& window) {
         skillSlot.setFillColor(sf::Color(50, 45, 40));
         skillSlot.setOutlineThickness(2);
         skillSlot.setOutlineColor(sf::Color(80, 70, 60));
-        window.draw(skillSlot);
+        RenderStats::draw(window, skillSlot);
         
         if (i < (int)skills.size()) {
             // 有技能 - 显示技能图标（用颜色代替）
@@ -546,21 +548,21 @@ void PetPanel::renderPetInfo(sf::RenderWindow& window) {
             } else {
                 skillIcon.setFillColor(sf::Color(150, 100, 100));  // 主动技能红色
             }
-            window.draw(skillIcon);
+            RenderStats::draw(window, skillIcon);
             
             // 技能名（缩写）
             std::string skillNameShort = skills[i].name.substr(0, 2);
             sf::Text skillNameText(toSfString(skillNameShort), font, 14);
             skillNameText.setPosition(slotX + 12, infoY + 18);
             skillNameText.setFillColor(sf::Color::White);
-            window.draw(skillNameText);
+            RenderStats::draw(window, skillNameText);
         } else {
             // 空技能槽 - 显示锁
             std::string lockStr = "空";
             sf::Text lockText(toSfString(lockStr), font, 14);
             lockText.setPosition(slotX + 18, infoY + 18);
             lockText.setFillColor(sf::Color(80, 80, 80));
-            window.draw(lockText);
+            RenderStats::draw(window, lockText);
         }
     }
     
@@ -573,7 +575,7 @@ void PetPanel::renderPetInfo(sf::RenderWindow& window) {
             sf::Text skillDesc(toSfString(skillDescStr), font, 11);
             skillDesc.setPosition(infoX, infoY);
             skillDesc.setFillColor(sf::Color(160, 160, 160));
-            window.draw(skillDesc);
+            RenderStats::draw(window, skillDesc);
             infoY += 18;
         }
     }
@@ -585,20 +587,20 @@ void PetPanel::renderPetInfo(sf::RenderWindow& window) {
     washBtn.setFillColor(cleanserCount > 0 ? sf::Color(100, 80, 50) : sf::Color(60, 55, 50));
     washBtn.setOutlineThickness(2);
     washBtn.setOutlineColor(cleanserCount > 0 ? sf::Color(160, 130, 80) : sf::Color(80, 70, 60));
-    window.draw(washBtn);
+    RenderStats::draw(window, washBtn);
     
     std::string washStr = "重置资质化点";
     sf::Text washText(toSfString(washStr), font, 14);
     washText.setPosition(washRect.left + 18, washRect.top + 8);
     washText.setFillColor(cleanserCount > 0 ? sf::Color::White : sf::Color(100, 100, 100));
-    window.draw(washText);
+    RenderStats::draw(window, washText);
     
     // 洗涤剂数量
     std::string cleanserStr = "(洗涤剂: " + std::to_string(cleanserCount) + ")";
     sf::Text cleanserText(toSfString(cleanserStr), font, 11);
     cleanserText.setPosition(washRect.left + washRect.width + 10, washRect.top + 10);
     cleanserText.setFillColor(sf::Color(150, 150, 150));
-    window.draw(cleanserText);
+    RenderStats::draw(window, cleanserText);
 }
 
 void PetPanel::toggle() { panelOpen = !panelOpen; }
@@ -672,7 +674,7 @@ bool HatchPanel::init(const std::string& iconPath) {
 bool HatchPanel::loadFont(const std::string& fontPath) {
     if (font.loadFromFile(fontPath)) {
         fontLoaded = true;
-        std::cout << "[HatchPanel] Font loaded: " << fontPath << std::endl;
+        LOG_INFO("[HatchPanel] Font loaded: " << fontPath);
         return true;
     }
     return false;
@@ -688,15 +690,15 @@ void HatchPanel::setIconPosition(float x, float y) {
 
 void HatchPanel::setEssenceCount(int petTypeId, int count) {
     essenceCounts[petTypeId] = count;
-    std::cout << "[HatchPanel] Set essence count for type " << petTypeId << " = " << count << std::endl;
+    LOG_INFO("[HatchPanel] Set essence count for type " << petTypeId << " = " << count);
 }
 
 void HatchPanel::update(float dt) {
     (void)dt;
 }
 
-void HatchPanel::handleEvent(const sf::Event& event, sf::RenderWindow& window) {
-    sf::Vector2i mouseScreenPos = sf::Mouse::getPosition(window);
+void HatchPanel::handleEvent(const sf::Event& event, sf::RenderWindow& /*window*/) {
+    sf::Vector2i mouseScreenPos = InputSystem::getInstance().getMousePosition();
     sf::Vector2f mousePos(static_cast<float>(mouseScreenPos.x), static_cast<float>(mouseScreenPos.y));
     
     if (event.type == sf::Event::MouseButtonPressed && 
@@ -732,8 +734,8 @@ void HatchPanel::handleEvent(const sf::Event& event, sf::RenderWindow& window) {
                 auto it = essenceCounts.find(selectedHatchType);
                 if (it != essenceCounts.end()) essenceCount = it->second;
                 
-                std::cout << "[HatchPanel] Hatch clicked, essence=" << essenceCount 
-                          << ", canHatch=" << (petManager ? petManager->canHatchNewPet() : false) << std::endl;
+                LOG_INFO("[HatchPanel] Hatch clicked, essence=" << essenceCount 
+                      << ", canHatch=" << (petManager ? petManager->canHatchNewPet() : false));
                 
                 if (essenceCount > 0 && petManager && petManager->canHatchNewPet() && onHatch) {
                     if (onHatch(selectedHatchType, selectedEnhancerCount)) {
@@ -759,13 +761,13 @@ void HatchPanel::renderIcon(sf::RenderWindow& window) {
     sf::RectangleShape shadow(sf::Vector2f(bgSize, bgSize));
     shadow.setPosition(iconPosition.x - 6 + 3, iconPosition.y - 6 + 3);
     shadow.setFillColor(sf::Color(20, 20, 20, 150));
-    window.draw(shadow);
+    RenderStats::draw(window, shadow);
     
     // 主背景
     sf::RectangleShape iconBg(sf::Vector2f(bgSize, bgSize));
     iconBg.setPosition(iconPosition.x - 6, iconPosition.y - 6);
     iconBg.setFillColor(panelOpen ? sf::Color(100, 60, 60, 240) : sf::Color(35, 35, 45, 240));
-    window.draw(iconBg);
+    RenderStats::draw(window, iconBg);
     
     // 像素风格边框 - 外层
     sf::RectangleShape outerBorder(sf::Vector2f(bgSize, bgSize));
@@ -773,7 +775,7 @@ void HatchPanel::renderIcon(sf::RenderWindow& window) {
     outerBorder.setFillColor(sf::Color::Transparent);
     outerBorder.setOutlineThickness(3);
     outerBorder.setOutlineColor(panelOpen ? sf::Color(180, 100, 100) : sf::Color(70, 70, 90));
-    window.draw(outerBorder);
+    RenderStats::draw(window, outerBorder);
     
     // 内层高光边框
     sf::RectangleShape innerBorder(sf::Vector2f(bgSize - 6, bgSize - 6));
@@ -781,9 +783,9 @@ void HatchPanel::renderIcon(sf::RenderWindow& window) {
     innerBorder.setFillColor(sf::Color::Transparent);
     innerBorder.setOutlineThickness(2);
     innerBorder.setOutlineColor(panelOpen ? sf::Color(220, 140, 140, 150) : sf::Color(100, 100, 120, 150));
-    window.draw(innerBorder);
+    RenderStats::draw(window, innerBorder);
     
-    window.draw(iconSprite);
+    RenderStats::draw(window, iconSprite);
     
     if (fontLoaded) {
         std::string labelStr = "孵化";
@@ -792,11 +794,11 @@ void HatchPanel::renderIcon(sf::RenderWindow& window) {
         sf::Text labelShadow = label;
         labelShadow.setPosition(iconPosition.x + ICON_SIZE / 2 - 14 + 1, iconPosition.y + ICON_SIZE + 6 + 1);
         labelShadow.setFillColor(sf::Color(20, 20, 20, 200));
-        window.draw(labelShadow);
+        RenderStats::draw(window, labelShadow);
         
         label.setPosition(iconPosition.x + ICON_SIZE / 2 - 14, iconPosition.y + ICON_SIZE + 6);
         label.setFillColor(sf::Color::White);
-        window.draw(label);
+        RenderStats::draw(window, label);
     }
 }
 
@@ -807,13 +809,13 @@ void HatchPanel::renderPanel(sf::RenderWindow& window) {
     background.setFillColor(sf::Color(45, 40, 35, 245));
     background.setOutlineThickness(3);
     background.setOutlineColor(sf::Color(140, 100, 80));
-    window.draw(background);
+    RenderStats::draw(window, background);
     
     // 标题栏
     sf::RectangleShape titleBar(sf::Vector2f(panelSize.x, 40));
     titleBar.setPosition(panelPos);
     titleBar.setFillColor(sf::Color(70, 50, 45));
-    window.draw(titleBar);
+    RenderStats::draw(window, titleBar);
     
     if (!fontLoaded) return;
     
@@ -821,7 +823,7 @@ void HatchPanel::renderPanel(sf::RenderWindow& window) {
     sf::Text title(toSfString(titleStr), font, 22);
     title.setPosition(panelPos.x + panelSize.x / 2 - 44, panelPos.y + 8);
     title.setFillColor(sf::Color(220, 180, 150));
-    window.draw(title);
+    RenderStats::draw(window, title);
     
     // 关闭按钮
     sf::FloatRect closeRect = getCloseButtonRect();
@@ -830,12 +832,12 @@ void HatchPanel::renderPanel(sf::RenderWindow& window) {
     closeBtn.setFillColor(sf::Color(120, 50, 50));
     closeBtn.setOutlineThickness(1);
     closeBtn.setOutlineColor(sf::Color(180, 80, 80));
-    window.draw(closeBtn);
+    RenderStats::draw(window, closeBtn);
     
     sf::Text closeText("X", font, 18);
     closeText.setPosition(closeRect.left + 8, closeRect.top + 3);
     closeText.setFillColor(sf::Color::White);
-    window.draw(closeText);
+    RenderStats::draw(window, closeText);
     
     float x = panelPos.x + 25;
     float y = panelPos.y + 55;
@@ -845,7 +847,7 @@ void HatchPanel::renderPanel(sf::RenderWindow& window) {
     sf::Text essenceTitle(toSfString(essenceTitleStr), font, 16);
     essenceTitle.setPosition(x, y);
     essenceTitle.setFillColor(sf::Color(180, 160, 130));
-    window.draw(essenceTitle);
+    RenderStats::draw(window, essenceTitle);
     
     y += 30;
     
@@ -862,27 +864,27 @@ void HatchPanel::renderPanel(sf::RenderWindow& window) {
     essenceSlot.setFillColor(sf::Color(60, 55, 50));
     essenceSlot.setOutlineThickness(3);
     essenceSlot.setOutlineColor(essenceCount > 0 ? sf::Color(150, 120, 80) : sf::Color(80, 70, 60));
-    window.draw(essenceSlot);
+    RenderStats::draw(window, essenceSlot);
     
     // 精元图标（用颜色块代替）
     if (essenceCount > 0) {
         sf::RectangleShape essenceIcon(sf::Vector2f(60, 60));
         essenceIcon.setPosition(x + 10, y + 10);
         essenceIcon.setFillColor(sf::Color(200, 150, 200));  // 紫色代表精元
-        window.draw(essenceIcon);
+        RenderStats::draw(window, essenceIcon);
     }
     
     // 精元名称和数量
     sf::Text essenceNameText(toSfString(petTypeName + "精元"), font, 14);
     essenceNameText.setPosition(x + 90, y + 20);
     essenceNameText.setFillColor(sf::Color::White);
-    window.draw(essenceNameText);
+    RenderStats::draw(window, essenceNameText);
     
     std::string countStr = "数量: " + std::to_string(essenceCount);
     sf::Text countText(toSfString(countStr), font, 14);
     countText.setPosition(x + 90, y + 45);
     countText.setFillColor(essenceCount > 0 ? sf::Color(100, 255, 100) : sf::Color(255, 100, 100));
-    window.draw(countText);
+    RenderStats::draw(window, countText);
     
     y += 100;
     
@@ -900,7 +902,7 @@ void HatchPanel::renderPanel(sf::RenderWindow& window) {
     sf::Text enhancerTitle(toSfString(enhancerTitleStr), font, 14);
     enhancerTitle.setPosition(x, y);
     enhancerTitle.setFillColor(sf::Color(180, 160, 130));
-    window.draw(enhancerTitle);
+    RenderStats::draw(window, enhancerTitle);
     
     y += 28;
     
@@ -908,7 +910,7 @@ void HatchPanel::renderPanel(sf::RenderWindow& window) {
     sf::Text enhancerText(toSfString(enhancerStr), font, 16);
     enhancerText.setPosition(x, y);
     enhancerText.setFillColor(sf::Color::White);
-    window.draw(enhancerText);
+    RenderStats::draw(window, enhancerText);
     
     // 加减按钮
     sf::FloatRect minusRect = getEnhancerMinusRect();
@@ -917,12 +919,12 @@ void HatchPanel::renderPanel(sf::RenderWindow& window) {
     minusBtn.setFillColor(sf::Color(80, 60, 55));
     minusBtn.setOutlineThickness(2);
     minusBtn.setOutlineColor(sf::Color(120, 100, 90));
-    window.draw(minusBtn);
+    RenderStats::draw(window, minusBtn);
     
     sf::Text minusText("-", font, 24);
     minusText.setPosition(minusRect.left + 12, minusRect.top + 2);
     minusText.setFillColor(sf::Color::White);
-    window.draw(minusText);
+    RenderStats::draw(window, minusText);
     
     sf::FloatRect plusRect = getEnhancerPlusRect();
     sf::RectangleShape plusBtn(sf::Vector2f(36, 36));
@@ -930,12 +932,12 @@ void HatchPanel::renderPanel(sf::RenderWindow& window) {
     plusBtn.setFillColor(sf::Color(55, 80, 55));
     plusBtn.setOutlineThickness(2);
     plusBtn.setOutlineColor(sf::Color(90, 120, 90));
-    window.draw(plusBtn);
+    RenderStats::draw(window, plusBtn);
     
     sf::Text plusText("+", font, 24);
     plusText.setPosition(plusRect.left + 10, plusRect.top + 2);
     plusText.setFillColor(sf::Color::White);
-    window.draw(plusText);
+    RenderStats::draw(window, plusText);
     
     y += 50;
     
@@ -944,7 +946,7 @@ void HatchPanel::renderPanel(sf::RenderWindow& window) {
     sf::Text probTitle(toSfString(probTitleStr), font, 14);
     probTitle.setPosition(x, y);
     probTitle.setFillColor(sf::Color(180, 180, 180));
-    window.draw(probTitle);
+    RenderStats::draw(window, probTitle);
     y += 25;
     
     // 概率条
@@ -965,12 +967,12 @@ void HatchPanel::renderPanel(sf::RenderWindow& window) {
         sf::RectangleShape colorBox(sf::Vector2f(16, 16));
         colorBox.setPosition(legendX, y);
         colorBox.setFillColor(Pet::getQualityColor(leg.second));
-        window.draw(colorBox);
+        RenderStats::draw(window, colorBox);
         
         sf::Text legText(toSfString(leg.first), font, 13);
         legText.setPosition(legendX + 20, y - 2);
         legText.setFillColor(sf::Color(180, 180, 180));
-        window.draw(legText);
+        RenderStats::draw(window, legText);
         
         legendX += 78;
     }
@@ -984,13 +986,13 @@ void HatchPanel::renderPanel(sf::RenderWindow& window) {
     hatchBtn.setFillColor(canHatch ? sf::Color(60, 100, 60) : sf::Color(60, 55, 50));
     hatchBtn.setOutlineThickness(3);
     hatchBtn.setOutlineColor(canHatch ? sf::Color(100, 160, 100) : sf::Color(80, 70, 60));
-    window.draw(hatchBtn);
+    RenderStats::draw(window, hatchBtn);
     
     std::string hatchStr = "确认孵化";
     sf::Text hatchText(toSfString(hatchStr), font, 20);
     hatchText.setPosition(hatchRect.left + 30, hatchRect.top + 12);
     hatchText.setFillColor(canHatch ? sf::Color::White : sf::Color(100, 100, 100));
-    window.draw(hatchText);
+    RenderStats::draw(window, hatchText);
     
     // 提示文字
     if (!canHatch) {
@@ -1005,7 +1007,7 @@ void HatchPanel::renderPanel(sf::RenderWindow& window) {
             sf::Text tipText(toSfString(tipStr), font, 13);
             tipText.setPosition(hatchRect.left, hatchRect.top + 55);
             tipText.setFillColor(sf::Color(255, 150, 100));
-            window.draw(tipText);
+            RenderStats::draw(window, tipText);
         }
     }
 }
@@ -1022,7 +1024,7 @@ void HatchPanel::renderProbabilityBar(sf::RenderWindow& window, float x, float y
             sf::RectangleShape bar(sf::Vector2f(w, height));
             bar.setPosition(currentX, y);
             bar.setFillColor(Pet::getQualityColor(q));
-            window.draw(bar);
+            RenderStats::draw(window, bar);
             currentX += w;
         }
     };
@@ -1038,7 +1040,7 @@ void HatchPanel::renderProbabilityBar(sf::RenderWindow& window, float x, float y
     border.setFillColor(sf::Color::Transparent);
     border.setOutlineThickness(2);
     border.setOutlineColor(sf::Color(100, 90, 80));
-    window.draw(border);
+    RenderStats::draw(window, border);
 }
 
 void HatchPanel::toggle() { panelOpen = !panelOpen; }
@@ -0,0 +1,181 @@
+#include "ProfilerOverlay.h"
+#include "../Systems/Profiler.h"
+#include "../Systems/Logger.h"
+#include "../Systems/RenderStats.h"
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+ProfilerOverlay::ProfilerOverlay()
+    : visible(false)
+    , refreshTimer(0.0f)
+    , fontLoaded(false)
+    , frameGraph(sf::Quads)
+    , position(20.0f, 100.0f)
+    , width(820.0f)
+    , graphHeight(80.0f)
+{
+}
+
+bool ProfilerOverlay::init(const std::string& fontPath) {
+    std::vector<std::string> fontPaths = {
+        fontPath,
+        "C:/Windows/Fonts/consola.ttf",     // 等宽字体，数字对齐
+        "C:/Windows/Fonts/msyh.ttc",
+        "assets/fonts/pixel.ttf",
+        "../../assets/fonts/pixel.ttf",
+        "/usr/share/fonts/truetype/dejavu/DejaVuSansMono.ttf",
+        "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf"
+    };
+
+    for (const auto& path : fontPaths) {
+        if (!path.empty() && font.loadFromFile(path)) {
+            fontLoaded = true;
+            break;
+        }
+    }
+
+    if (!fontLoaded) {
+        LOG_WARN("[ProfilerOverlay] 警告: 无法加载字体");
+        return false;
+    }
+
+    text.setFont(font);
+    text.setCharacterSize(14);
+    text.setFillColor(sf::Color(220, 255, 220));
+    text.setPosition(position.x + 8, position.y + graphHeight + 12);
+
+    background.setPosition(position);
+    background.setFillColor(sf::Color(0, 0, 0, 190));
+
+    budgetLine.setSize(sf::Vector2f(width - 16, 1));
+    budgetLine.setFillColor(sf::Color(255, 220, 100, 160));
+    budgetLine.setPosition(position.x + 8,
+                           position.y + 8 + graphHeight * (1.0f - 16.7f / GRAPH_SCALE_MS));
+
+    textBuffer.reserve(4096);
+    return true;
+}
+
+void ProfilerOverlay::update(float dt) {
+    if (!visible) return;
+    refreshTimer += dt;
+}
+
+// ============================================================================
+// 文字：帧统计 + 直方图 + 各标记耗时
+// ============================================================================
+void ProfilerOverlay::rebuildText() {
+    const Profiler& profiler = Profiler::getInstance();
+    char line[192];
+
+    textBuffer.clear();
+
+#if !PF_PROFILE
+    textBuffer += "Profiler markers compiled out (PF_PROFILE=0)\n";
+#endif
+
+    ProfileStats frame = profiler.computeFrameStats();
+    std::snprintf(line, sizeof(line),
+                  "Frame %llu   last %.2f  avg %.2f  p95 %.2f  max %.2f ms\n",
+                  static_cast<unsigned long long>(profiler.getFrameIndex()),
+                  frame.lastMs, frame.avgMs, frame.p95Ms, frame.maxMs);
+    textBuffer += line;
+
+    const FrameCounters& counters = profiler.getLastFrameCounters();
+    FrameCounters average = profiler.computeAverageFrameCounters();
+    std::snprintf(line, sizeof(line),
+                  "Draws %llu (avg %llu)  Verts %llu  Allocs %llu (avg %llu)  %.1f KB\n",
+                  static_cast<unsigned long long>(counters.drawCalls),
+                  static_cast<unsigned long long>(average.drawCalls),
+                  static_cast<unsigned long long>(counters.vertices),
+                  static_cast<unsigned long long>(counters.allocations),
+                  static_cast<unsigned long long>(average.allocations),
+                  static_cast<double>(counters.allocatedBytes) / 1024.0);
+    textBuffer += line;
+#if !PF_TRACK_ALLOCATIONS
+    textBuffer += "Allocation tracking disabled (PF_TRACK_ALLOCATIONS=0)\n";
+#endif
+
+    auto histogram = profiler.computeFrameHistogram();
+    textBuffer += "Hist";
+    for (size_t i = 0; i < histogram.size(); i++) {
+        if (i + 1 < histogram.size()) {
+            std::snprintf(line, sizeof(line), "  <%.0f:%u",
+                          Profiler::getBucketLimitMs(i), histogram[i]);
+        } else {
+            std::snprintf(line, sizeof(line), "  >%.0f:%u",
+                          Profiler::getBucketLimitMs(i - 1), histogram[i]);
+        }
+        textBuffer += line;
+    }
+    textBuffer += "\n\n";
+
+    std::snprintf(line, sizeof(line), "%-34s %6s %6s %6s %6s %5s %6s %7s %6s %8s\n",
+                  "Section", "last", "avg", "p95", "max", "calls",
+                  "draws", "verts", "allocs", "KB");
+    textBuffer += line;
+
+    for (const auto& section : profiler.getSections()) {
+        ProfileStats stats = profiler.computeStats(section);
+        std::string label(static_cast<size_t>(section.depth) * 2, ' ');
+        label += section.name;
+        const FrameCounters& sectionCounters = section.lastCounters;
+        std::snprintf(line, sizeof(line), "%-34.34s %6.2f %6.2f %6.2f %6.2f %5u %6llu %7llu %6llu %8.1f\n",
+                      label.c_str(), stats.lastMs, stats.avgMs, stats.p95Ms, stats.maxMs,
+                      section.lastCalls,
+                      static_cast<unsigned long long>(sectionCounters.drawCalls),
+                      static_cast<unsigned long long>(sectionCounters.vertices),
+                      static_cast<unsigned long long>(sectionCounters.allocations),
+                      static_cast<double>(sectionCounters.allocatedBytes) / 1024.0);
+        textBuffer += line;
+    }
+
+    if (profiler.isCapturing()) {
+        textBuffer += "\n[Recording trace...]";
+    }
+
+    text.setString(textBuffer);
+}
+
+// ============================================================================
+// 整帧耗时曲线（最新的在右侧）
+// ============================================================================
+void ProfilerOverlay::buildFrameGraph() {
+    const Profiler& profiler = Profiler::getInstance();
+    const size_t count = Profiler::HISTORY;
+    const float barWidth = (width - 16) / static_cast<float>(count);
+    const float baseY = position.y + 8 + graphHeight;
+
+    frameGraph.resize(count * 4);
+    for (size_t i = 0; i < count; i++) {
+        float frameMs = profiler.getFrameMs(count - 1 - i);
+        float h = graphHeight * std::min(frameMs, GRAPH_SCALE_MS) / GRAPH_SCALE_MS;
+        float x = position.x + 8 + barWidth * static_cast<float>(i);
+        sf::Color color = frameMs > 16.7f ? sf::Color(255, 90, 90) : sf::Color(90, 220, 120);
+
+        sf::Vertex* quad = &frameGraph[i * 4];
+        quad[0] = sf::Vertex(sf::Vector2f(x, baseY - h), color);
+        quad[1] = sf::Vertex(sf::Vector2f(x + barWidth, baseY - h), color);
+        quad[2] = sf::Vertex(sf::Vector2f(x + barWidth, baseY), color);
+        quad[3] = sf::Vertex(sf::Vector2f(x, baseY), color);
+    }
+}
+
+void ProfilerOverlay::render(sf::RenderWindow& window) {
+    if (!visible || !fontLoaded) return;
+
+    if (refreshTimer >= REFRESH_INTERVAL) {
+        refreshTimer = 0.0f;
+        rebuildText();
+        buildFrameGraph();
+
+        sf::FloatRect bounds = text.getLocalBounds();
+        background.setSize(sf::Vector2f(width, graphHeight + 24 + bounds.top + bounds.height));
+    }
+
+    RenderStats::draw(window, background);
+    RenderStats::draw(window, frameGraph);
+    RenderStats::draw(window, budgetLine);
+    RenderStats::draw(window, text);
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <string>
+
+// ============================================================================
+// 性能面板 (Profiler Overlay)
+//
+// 显示 Profiler 汇总的数据（F10 开关）：
+//   - 整帧耗时曲线（最近 Profiler::HISTORY 帧）和耗时区间直方图
+//   - 每个计时标记的 本帧 / 平均 / P95 / 最大 耗时，按调用层级缩进
+//   - 整帧和每个标记的 draw call / 顶点 / 堆分配次数和字节数
+//
+// 文字每 REFRESH_INTERVAL 秒重建一次，避免面板本身拖慢帧率。
+// ============================================================================
+
+class ProfilerOverlay {
+public:
+    ProfilerOverlay();
+
+    // 初始化（加载字体）
+    bool init(const std::string& fontPath = "");
+
+    void toggle() { visible = !visible; refreshTimer = REFRESH_INTERVAL; }
+    bool isVisible() const { return visible; }
+
+    void update(float dt);
+    void render(sf::RenderWindow& window);
+
+private:
+    void rebuildText();
+    void buildFrameGraph();
+
+private:
+    bool visible;
+    float refreshTimer;
+
+    sf::Font font;
+    bool fontLoaded;
+    sf::Text text;
+    std::string textBuffer;
+
+    sf::RectangleShape background;
+    sf::VertexArray frameGraph;
+    sf::RectangleShape budgetLine;      // 16.7ms 参考线
+
+    sf::Vector2f position;
+    float width;
+    float graphHeight;
+
+    static constexpr float REFRESH_INTERVAL = 0.25f;
+    static constexpr float GRAPH_SCALE_MS = 33.3f;  // 曲线顶部对应的耗时
+};
@@ -1,7 +1,9 @@
 #include "StatsPanel.h"
+#include "../Systems/InputSystem.h"
+#include "../Systems/Logger.h"
+#include "../Systems/RenderStats.h"
 #include <sstream>
 #include <iomanip>
-#include <iostream>
 
 // ============================================================================
 // UTF-8 字符串转换辅助函数
@@ -66,7 +68,7 @@ StatsPanel::StatsPanel()
 bool StatsPanel::init(const std::string& iconPath, const std::string& fontPath) {
     // 加载图标
     if (!iconTexture.loadFromFile(iconPath)) {
-        std::cerr << "[StatsPanel] 无法加载图标: " << iconPath << std::endl;
+        LOG_ERROR("[StatsPanel] 无法加载图标: " << iconPath);
         // 创建占位图标
         sf::Image placeholder;
         placeholder.create(32, 32, sf::Color(128, 0, 128));
@@ -91,13 +93,13 @@ bool StatsPanel::init(const std::string& iconPath, const std::string& fontPath)
     for (const auto& path : fontPaths) {
         if (!path.empty() && font.loadFromFile(path)) {
             fontLoaded = true;
-            std::cout << "[StatsPanel] 字体加载成功: " << path << std::endl;
+            LOG_INFO("[StatsPanel] 字体加载成功: " << path);
             break;
         }
     }
     
     if (!fontLoaded) {
-        std::cerr << "[StatsPanel] 警告: 无法加载字体，文字将不显示" << std::endl;
+        LOG_WARN("[StatsPanel] 警告: 无法加载字体，文字将不显示");
     }
     
     // 创建面板
@@ -208,7 +210,7 @@ void StatsPanel::update(float dt) {
 void StatsPanel::handleEvent(const sf::Event& event, const sf::RenderWindow& window) {
     // 获取鼠标位置（屏幕坐标）
     sf::Vector2f mousePos = window.mapPixelToCoords(
-        sf::Mouse::getPosition(window),
+        InputSystem::getInstance().getMousePosition(),
         window.getDefaultView()
     );
     
@@ -243,20 +245,20 @@ void StatsPanel::handleEvent(const sf::Event& event, const sf::RenderWindow& win
 
 void StatsPanel::render(sf::RenderWindow& window) {
     // 总是绘制图标
-    window.draw(iconSprite);
+    RenderStats::draw(window, iconSprite);
     
     // 只有面板打开且有透明度时才绘制
     if (panelAlpha > 0.01f) {
         // 绘制面板背景和边框
-        window.draw(panelBorder);
-        window.draw(panelBackground);
+        RenderStats::draw(window, panelBorder);
+        RenderStats::draw(window, panelBackground);
         
         if (fontLoaded) {
             // 设置文字透明度
             sf::Color titleCol = titleColor;
             titleCol.a = static_cast<sf::Uint8>(255 * panelAlpha);
             titleText.setFillColor(titleCol);
-            window.draw(titleText);
+            RenderStats::draw(window, titleText);
             
             // 绘制属性内容
             float startY = panelPosition.y + 50.0f;
@@ -284,11 +286,11 @@ void StatsPanel::render(sf::RenderWindow& window) {
             // === 等级 ===
             label.setString(toSfString("等级"));
             label.setPosition(labelX, y);
-            window.draw(label);
+            RenderStats::draw(window, label);
             value.setString("Lv." + std::to_string(cachedLevel));
             value.setFillColor(sf::Color(255, 215, 0, static_cast<sf::Uint8>(255 * panelAlpha)));
             value.setPosition(valueX, y);
-            window.draw(value);
+            RenderStats::draw(window, value);
             y += lineHeight;
             
             // === 经验条 ===
@@ -321,62 +323,62 @@ void StatsPanel::render(sf::RenderWindow& window) {
             // 攻击力
             label.setString(toSfString("攻击力"));
             label.setPosition(labelX, y);
-            window.draw(label);
+            RenderStats::draw(window, label);
             std::stringstream ss;
             ss << std::fixed << std::setprecision(0) << cachedAttack;
             value.setString(ss.str());
             value.setPosition(valueX, y);
-            window.draw(value);
+            RenderStats::draw(window, value);
             y += lineHeight;
             
             // 防御
             label.setString(toSfString("防御"));
             label.setPosition(labelX, y);
-            window.draw(label);
+            RenderStats::draw(window, label);
             ss.str(""); ss << std::fixed << std::setprecision(0) << cachedDefense;
             value.setString(ss.str());
             value.setPosition(valueX, y);
-            window.draw(value);
+            RenderStats::draw(window, value);
             y += lineHeight;
             
             // 速度
             label.setString(toSfString("速度"));
             label.setPosition(labelX, y);
-            window.draw(label);
+            RenderStats::draw(window, label);
             ss.str(""); ss << std::fixed << std::setprecision(0) << cachedSpeed;
             value.setString(ss.str());
             value.setPosition(valueX, y);
-            window.draw(value);
+            RenderStats::draw(window, value);
             y += lineHeight;
             
             // 闪避
             label.setString(toSfString("闪避"));
             label.setPosition(labelX, y);
-            window.draw(label);
+            RenderStats::draw(window, label);
             ss.str(""); ss << std::fixed << std::setprecision(1) << cachedDodge << "%";
             value.setString(ss.str());
             value.setPosition(valueX, y);
-            window.draw(value);
+            RenderStats::draw(window, value);
             y += lineHeight;
             
             // 幸运
             label.setString(toSfString("幸运"));
             label.setPosition(labelX, y);
-            window.draw(label);
+            RenderStats::draw(window, label);
             ss.str(""); ss << std::fixed << std::setprecision(0) << cachedLuck;
             value.setString(ss.str());
             value.setPosition(valueX, y);
-            window.draw(value);
+            RenderStats::draw(window, value);
             y += lineHeight + 12.0f;
             
             // === 财产 ===
             label.setString(toSfString("金币"));
             label.setPosition(labelX, y);
-            window.draw(label);
+            RenderStats::draw(window, label);
             value.setFillColor(sf::Color(255, 215, 0, static_cast<sf::Uint8>(255 * panelAlpha)));
             value.setString(std::to_string(cachedGold) + " G");
             value.setPosition(valueX, y);
-            window.draw(value);
+            RenderStats::draw(window, value);
             y += lineHeight + 12.0f;
             
             value.setFillColor(valCol);
@@ -384,26 +386,26 @@ void StatsPanel::render(sf::RenderWindow& window) {
             // === 生活技能 ===
             label.setString(toSfString("种植"));
             label.setPosition(labelX, y);
-            window.draw(label);
+            RenderStats::draw(window, label);
             value.setString("Lv." + std::to_string(cachedFarmingLv));
             value.setPosition(valueX, y);
-            window.draw(value);
+            RenderStats::draw(window, value);
             y += lineHeight;
             
             label.setString(toSfString("渔业"));
             label.setPosition(labelX, y);
-            window.draw(label);
+            RenderStats::draw(window, label);
             value.setString("Lv." + std::to_string(cachedFishingLv));
             value.setPosition(valueX, y);
-            window.draw(value);
+            RenderStats::draw(window, value);
             y += lineHeight;
             
             label.setString(toSfString("采矿"));
             label.setPosition(labelX, y);
-            window.draw(label);
+            RenderStats::draw(window, label);
             value.setString("Lv." + std::to_string(cachedMiningLv));
             value.setPosition(valueX, y);
-            window.draw(value);
+            RenderStats::draw(window, value);
         }
     }
 }
@@ -421,14 +423,14 @@ void StatsPanel::drawProgressBar(sf::RenderWindow& window, float x, float y,
     bg.setFillColor(sf::Color(40, 40, 40, static_cast<sf::Uint8>(200 * panelAlpha)));
     bg.setOutlineThickness(1.0f);
     bg.setOutlineColor(sf::Color(80, 80, 80, static_cast<sf::Uint8>(255 * panelAlpha)));
-    window.draw(bg);
+    RenderStats::draw(window, bg);
     
     // 填充
     if (percent > 0.0f) {
         sf::RectangleShape fill(sf::Vector2f(width * percent, height));
         fill.setPosition(x, y);
         fill.setFillColor(fillColor);
-        window.draw(fill);
+        RenderStats::draw(window, fill);
     }
     
     // 标签（使用 sf::String::fromUtf8 正确显示中文）
@@ -439,7 +441,7 @@ void StatsPanel::drawProgressBar(sf::RenderWindow& window, float x, float y,
         text.setCharacterSize(12);
         text.setFillColor(sf::Color(255, 255, 255, static_cast<sf::Uint8>(255 * panelAlpha)));
         text.setPosition(x + 5.0f, y + 1.0f);
-        window.draw(text);
+        RenderStats::draw(window, text);
     }
 }
 
@@ -453,14 +455,14 @@ void StatsPanel::drawProgressBar(sf::RenderWindow& window, float x, float y,
     bg.setFillColor(sf::Color(40, 40, 40, static_cast<sf::Uint8>(200 * panelAlpha)));
     bg.setOutlineThickness(1.0f);
     bg.setOutlineColor(sf::Color(80, 80, 80, static_cast<sf::Uint8>(255 * panelAlpha)));
-    window.draw(bg);
+    RenderStats::draw(window, bg);
     
     // 填充
     if (percent > 0.0f) {
         sf::RectangleShape fill(sf::Vector2f(width * percent, height));
         fill.setPosition(x, y);
         fill.setFillColor(fillColor);
-        window.draw(fill);
+        RenderStats::draw(window, fill);
     }
     
     // 标签
@@ -471,7 +473,7 @@ void StatsPanel::drawProgressBar(sf::RenderWindow& window, float x, float y,
         text.setCharacterSize(12);
         text.setFillColor(sf::Color(255, 255, 255, static_cast<sf::Uint8>(255 * panelAlpha)));
         text.setPosition(x + 5.0f, y + 1.0f);
-        window.draw(text);
+        RenderStats::draw(window, text);
     }
 }
 
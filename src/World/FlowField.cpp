@@ -0,0 +1,196 @@
+#include "FlowField.h"
+#include <algorithm>
+#include <cmath>
+
+FlowField::FlowField(int radius)
+    : radius(std::max(1, radius))
+    , windowSize(2 * std::max(1, radius) + 1)
+{
+    const size_t cells = static_cast<size_t>(windowSize) * windowSize;
+    cost.assign(cells, UNREACHABLE);
+    flow.assign(cells, NO_FLOW);
+}
+
+// ============================================================================
+// 障碍
+// ============================================================================
+
+void FlowField::reset(int width, int height, float tile) {
+    mapWidth = std::max(0, width);
+    mapHeight = std::max(0, height);
+    tileSize = tile > 0 ? tile : 1.0f;
+    obstacles.assign(static_cast<size_t>(mapWidth) * mapHeight, 0);
+    goalTile = sf::Vector2i(-1, -1);
+    dirty = true;
+}
+
+void FlowField::blockTile(int x, int y, ObstacleLayer layer) {
+    if (x < 0 || y < 0 || x >= mapWidth || y >= mapHeight) return;
+    obstacles[static_cast<size_t>(y) * mapWidth + x] |= static_cast<std::uint8_t>(layer);
+    dirty = true;
+}
+
+void FlowField::blockRect(const sf::FloatRect& rect, ObstacleLayer layer) {
+    if (rect.width <= 0 || rect.height <= 0) return;
+
+    // 右/下边界恰好落在图块边上时不算占用下一格
+    int left = std::max(0, static_cast<int>(std::floor(rect.left / tileSize)));
+    int top = std::max(0, static_cast<int>(std::floor(rect.top / tileSize)));
+    int right = std::min(mapWidth - 1, static_cast<int>(std::ceil((rect.left + rect.width) / tileSize)) - 1);
+    int bottom = std::min(mapHeight - 1, static_cast<int>(std::ceil((rect.top + rect.height) / tileSize)) - 1);
+
+    for (int y = top; y <= bottom; y++) {
+        for (int x = left; x <= right; x++) {
+            obstacles[static_cast<size_t>(y) * mapWidth + x] |= static_cast<std::uint8_t>(layer);
+        }
+    }
+    dirty = true;
+}
+
+void FlowField::clearLayer(ObstacleLayer layer) {
+    const std::uint8_t mask = static_cast<std::uint8_t>(~static_cast<std::uint8_t>(layer));
+    for (auto& cell : obstacles) {
+        cell &= mask;
+    }
+    dirty = true;
+}
+
+bool FlowField::isBlocked(int x, int y) const {
+    return !isWalkable(x, y);
+}
+
+bool FlowField::isWalkable(int x, int y) const {
+    if (x < 0 || y < 0 || x >= mapWidth || y >= mapHeight) return false;
+    return obstacles[static_cast<size_t>(y) * mapWidth + x] == 0;
+}
+
+// 对角移动要求两侧的正交邻格都可走（不斜穿墙角）
+bool FlowField::canStep(int x, int y, int dir) const {
+    int nx = x + DIR_X[dir];
+    int ny = y + DIR_Y[dir];
+    if (!isWalkable(nx, ny)) return false;
+    if (dir >= 4) {
+        return isWalkable(nx, y) && isWalkable(x, ny);
+    }
+    return true;
+}
+
+// ============================================================================
+// 目标和积分
+// ============================================================================
+
+sf::Vector2i FlowField::worldToTile(const sf::Vector2f& pos) const {
+    return sf::Vector2i(static_cast<int>(std::floor(pos.x / tileSize)),
+                        static_cast<int>(std::floor(pos.y / tileSize)));
+}
+
+bool FlowField::update(const sf::Vector2f& goalPos) {
+    if (obstacles.empty()) return false;
+
+    sf::Vector2i tile = worldToTile(goalPos);
+    if (!dirty && tile == goalTile) return false;
+
+    goalTile = tile;
+    origin = sf::Vector2i(tile.x - radius, tile.y - radius);
+    integrate();
+    dirty = false;
+    rebuildCount++;
+    return true;
+}
+
+void FlowField::integrate() {
+    std::fill(cost.begin(), cost.end(), UNREACHABLE);
+    std::fill(flow.begin(), flow.end(), NO_FLOW);
+    for (auto& bucket : buckets) bucket.clear();
+
+    auto inWindow = [&](int mapX, int mapY) {
+        int lx = mapX - origin.x;
+        int ly = mapY - origin.y;
+        return lx >= 0 && ly >= 0 && lx < windowSize && ly < windowSize;
+    };
+    auto localIndex = [&](int mapX, int mapY) {
+        return (mapY - origin.y) * windowSize + (mapX - origin.x);
+    };
+
+    // 目标图块即使被（保守标记的）障碍占着也作为起点，玩家贴着树站时怪物照样能追
+    const int goalIndex = localIndex(goalTile.x, goalTile.y);
+    cost[goalIndex] = 0;
+    buckets[0].push_back(goalIndex);
+    size_t pending = 1;
+
+    // 桶队列 Dijkstra：边权都小于 BUCKET_COUNT，循环使用桶即可
+    for (std::uint32_t current = 0; pending > 0; current++) {
+        auto& bucket = buckets[current % BUCKET_COUNT];
+        for (size_t i = 0; i < bucket.size(); i++) {
+            const int index = bucket[i];
+            pending--;
+            if (cost[index] != current) continue;       // 已被更短路径取代
+
+            const int x = origin.x + index % windowSize;
+            const int y = origin.y + index / windowSize;
+            for (int dir = 0; dir < 8; dir++) {
+                int nx = x + DIR_X[dir];
+                int ny = y + DIR_Y[dir];
+                if (!inWindow(nx, ny) || !canStep(x, y, dir)) continue;
+
+                std::uint32_t next = current + (dir < 4 ? ORTHOGONAL_COST : DIAGONAL_COST);
+                int neighbor = localIndex(nx, ny);
+                if (next < cost[neighbor]) {
+                    cost[neighbor] = next;
+                    buckets[next % BUCKET_COUNT].push_back(neighbor);
+                    pending++;
+                }
+            }
+        }
+        bucket.clear();
+    }
+
+    // 每个图块的下一步：代价最低的可达邻格
+    // 被障碍占着的图块（实体被推进去或碰撞盒保守覆盖）也给一个出路
+    for (int ly = 0; ly < windowSize; ly++) {
+        for (int lx = 0; lx < windowSize; lx++) {
+            const int index = ly * windowSize + lx;
+            if (cost[index] == 0) continue;
+
+            const int x = origin.x + lx;
+            const int y = origin.y + ly;
+            const bool walkable = isWalkable(x, y);
+
+            std::uint32_t best = cost[index];
+            std::int8_t bestDir = NO_FLOW;
+            for (int dir = 0; dir < 8; dir++) {
+                int nx = x + DIR_X[dir];
+                int ny = y + DIR_Y[dir];
+                if (!inWindow(nx, ny)) continue;
+                if (walkable ? !canStep(x, y, dir) : !isWalkable(nx, ny)) continue;
+
+                std::uint32_t c = cost[localIndex(nx, ny)];
+                if (c < best) {
+                    best = c;
+                    bestDir = static_cast<std::int8_t>(dir);
+                }
+            }
+            flow[index] = bestDir;
+        }
+    }
+}
+
+sf::Vector2f FlowField::sampleDirection(const sf::Vector2f& pos) const {
+    if (obstacles.empty() || goalTile.x < 0) return sf::Vector2f(0, 0);
+
+    sf::Vector2i tile = worldToTile(pos);
+    int lx = tile.x - origin.x;
+    int ly = tile.y - origin.y;
+    if (lx < 0 || ly < 0 || lx >= windowSize || ly >= windowSize) return sf::Vector2f(0, 0);
+
+    std::int8_t dir = flow[static_cast<size_t>(ly) * windowSize + lx];
+    if (dir == NO_FLOW) return sf::Vector2f(0, 0);
+
+    // 朝下一图块的中心走，拐角处比沿固定 8 方向更平滑
+    sf::Vector2f target((tile.x + DIR_X[dir] + 0.5f) * tileSize,
+                        (tile.y + DIR_Y[dir] + 0.5f) * tileSize);
+    sf::Vector2f diff = target - pos;
+    float length = std::sqrt(diff.x * diff.x + diff.y * diff.y);
+    if (length <= 0.0001f) return sf::Vector2f(0, 0);
+    return diff / length;
+}
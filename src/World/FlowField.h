@@ -0,0 +1,95 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// ============================================================================
+// 流场寻路 (Flow Field)
+//
+// 所有追击玩家的怪物和跟随玩家的宠物共用一张流场：
+//   - 障碍网格与地图图块一一对应，分两层：
+//       Static  —— 碰撞图块层和地图对象（换地图时重建）
+//       Dynamic —— 树木等会变化的障碍（布局版本变化时重建）
+//   - 以玩家所在图块为目标，在其周围 (2*radius+1)^2 的窗口内做
+//     8 方向 Dijkstra（桶队列，正交 10 / 对角 14，不允许斜穿墙角），
+//     再为每个图块记下"下一步"方向
+//   - 只有玩家换了图块或障碍变了才重算（update 返回是否重算）
+//   - sampleDirection 为 O(1)：查当前图块的下一步，返回朝下一图块中心的方向
+//
+// 在目标图块、窗口外或无路可走时返回零向量，调用方退回直线移动。
+// ============================================================================
+
+enum class ObstacleLayer : std::uint8_t {
+    Static = 1,
+    Dynamic = 2
+};
+
+class FlowField {
+public:
+    // 默认窗口半径（图块）：48px 图块时约 1500px，远大于追击和牵引范围
+    static constexpr int DEFAULT_RADIUS = 32;
+
+    explicit FlowField(int radius = DEFAULT_RADIUS);
+
+    // ========================================
+    // 障碍
+    // ========================================
+
+    // 按地图尺寸重置（清空两层障碍）
+    void reset(int mapWidth, int mapHeight, float tileSize);
+
+    void blockTile(int x, int y, ObstacleLayer layer);
+    // 标记与矩形（显示坐标）重叠的所有图块
+    void blockRect(const sf::FloatRect& rect, ObstacleLayer layer);
+    void clearLayer(ObstacleLayer layer);
+
+    bool isBlocked(int x, int y) const;
+
+    // ========================================
+    // 目标和查询
+    // ========================================
+
+    // 目标设为 goalPos 所在图块；图块没变且障碍没变时不重算
+    bool update(const sf::Vector2f& goalPos);
+
+    // 从 pos 出发沿流场前进的单位方向（零向量表示没有可用方向）
+    sf::Vector2f sampleDirection(const sf::Vector2f& pos) const;
+
+    sf::Vector2i worldToTile(const sf::Vector2f& pos) const;
+    sf::Vector2i getGoalTile() const { return goalTile; }
+    int getRadius() const { return radius; }
+    std::uint32_t getRebuildCount() const { return rebuildCount; }
+
+private:
+    void integrate();
+    bool isWalkable(int mapX, int mapY) const;
+    bool canStep(int mapX, int mapY, int dir) const;
+
+    static constexpr std::int8_t NO_FLOW = -1;
+    static constexpr std::uint32_t UNREACHABLE = 0xFFFFFFFFu;
+    static constexpr std::uint32_t ORTHOGONAL_COST = 10;
+    static constexpr std::uint32_t DIAGONAL_COST = 14;
+    static constexpr int BUCKET_COUNT = DIAGONAL_COST + 1;
+
+    // 8 个方向：前 4 个正交，后 4 个对角
+    static constexpr std::array<int, 8> DIR_X = { 1, -1, 0, 0, 1, -1, 1, -1 };
+    static constexpr std::array<int, 8> DIR_Y = { 0, 0, 1, -1, 1, 1, -1, -1 };
+
+    int radius;
+    int windowSize;
+
+    int mapWidth = 0;
+    int mapHeight = 0;
+    float tileSize = 1.0f;
+    std::vector<std::uint8_t> obstacles;        // 每图块的 ObstacleLayer 位
+
+    bool dirty = true;
+    sf::Vector2i goalTile{-1, -1};
+    sf::Vector2i origin{0, 0};                  // 窗口左上角（地图图块坐标）
+    std::vector<std::uint32_t> cost;            // 窗口内到目标的代价
+    std::vector<std::int8_t> flow;              // 窗口内的下一步方向（DIR_X/DIR_Y 下标）
+    std::array<std::vector<int>, BUCKET_COUNT> buckets;
+
+    std::uint32_t rebuildCount = 0;
+};
@@ -0,0 +1,340 @@
+#include "StressScene.h"
+#include "../Systems/Logger.h"
+#include "../Systems/Random.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+// ============================================================================
+// 与 part1.tmj 一致的图块集布局
+// ============================================================================
+
+namespace {
+    constexpr int SRC_TILE_SIZE = 32;
+
+    constexpr int FIRST_GID_PART1 = 1;      // part_1.tsx：地面
+    constexpr int FIRST_GID_TREE = 129;     // tree.tsx：4 种树（64x64）
+    constexpr int FIRST_GID_PART3 = 133;    // part_3.tsx：装饰、植物、石头
+    constexpr int FIRST_GID_WATER = 217;    // water_anim.tsx：动画水面（8 帧）
+
+    constexpr int TREE_VARIANTS = 4;
+    constexpr int GID_STONE = FIRST_GID_PART3 + 24;             // stone_build2
+    constexpr int GID_PLANTS[] = { FIRST_GID_PART3 + 18,        // carrot_plant
+                                   FIRST_GID_PART3 + 19 };      // bean_plant
+    constexpr int GID_WATER = FIRST_GID_WATER + 70;             // 带 <animation> 的开阔水面
+
+    // 水塘半径范围（图块）
+    constexpr int POOL_MIN_RADIUS = 2;
+    constexpr int POOL_MAX_RADIUS = 5;
+
+    // 地图中心（玩家出生点）周围留空的半径（图块）
+    constexpr int SPAWN_CLEAR_RADIUS = 4;
+    // 找不到空位时每个对象的最大尝试次数
+    constexpr int PLACE_ATTEMPTS = 8;
+
+    // 地面图块：大部分是草地，少量杂色（与 part1 的分布相近）
+    int pickGroundGid(Rng& rng) {
+        float r = rng.nextFloat();
+        if (r < 0.90f) return FIRST_GID_PART1;
+        if (r < 0.98f) return FIRST_GID_PART1 + 4;
+        return FIRST_GID_PART1 + rng.range(1, 2);
+    }
+
+    // 图块占用表：防止对象互相重叠，水塘也记在这里（对象不会放进水里）
+    class Occupancy {
+    public:
+        Occupancy(int w, int h) : width(w), height(h), cells(static_cast<size_t>(w) * h, 0) {
+            int cx = w / 2, cy = h / 2;
+            for (int y = std::max(0, cy - SPAWN_CLEAR_RADIUS); y < std::min(h, cy + SPAWN_CLEAR_RADIUS); y++) {
+                for (int x = std::max(0, cx - SPAWN_CLEAR_RADIUS); x < std::min(w, cx + SPAWN_CLEAR_RADIUS); x++) {
+                    cells[static_cast<size_t>(y) * w + x] = 1;
+                }
+            }
+        }
+
+        // 圆形水塘；出生点周围保持干地
+        int addPool(int cx, int cy, int radius) {
+            int painted = 0;
+            for (int y = std::max(0, cy - radius); y <= std::min(height - 1, cy + radius); y++) {
+                for (int x = std::max(0, cx - radius); x <= std::min(width - 1, cx + radius); x++) {
+                    int dx = x - cx, dy = y - cy;
+                    if (dx * dx + dy * dy > radius * radius) continue;
+                    std::uint8_t& cell = cells[static_cast<size_t>(y) * width + x];
+                    if (cell != 0) continue;
+                    cell = WATER;
+                    painted++;
+                }
+            }
+            return painted;
+        }
+
+        bool isWater(int x, int y) const {
+            return cells[static_cast<size_t>(y) * width + x] == WATER;
+        }
+
+        // 在随机位置放一个 size x size 的对象，返回左上角图块
+        bool place(Rng& rng, int size, int& outX, int& outY) {
+            if (width < size || height < size) return false;
+            for (int attempt = 0; attempt < PLACE_ATTEMPTS; attempt++) {
+                int x = rng.range(0, width - size);
+                int y = rng.range(0, height - size);
+                if (isFree(x, y, size)) {
+                    mark(x, y, size);
+                    outX = x;
+                    outY = y;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+    private:
+        static constexpr std::uint8_t WATER = 2;
+
+        bool isFree(int x, int y, int size) const {
+            for (int dy = 0; dy < size; dy++) {
+                for (int dx = 0; dx < size; dx++) {
+                    if (cells[static_cast<size_t>(y + dy) * width + (x + dx)]) return false;
+                }
+            }
+            return true;
+        }
+
+        void mark(int x, int y, int size) {
+            for (int dy = 0; dy < size; dy++) {
+                for (int dx = 0; dx < size; dx++) {
+                    cells[static_cast<size_t>(y + dy) * width + (x + dx)] = 1;
+                }
+            }
+        }
+
+        int width;
+        int height;
+        std::vector<std::uint8_t> cells;
+    };
+
+    // tsx 引用路径：尽量相对地图所在目录（Tiled 也能直接打开），否则用绝对路径
+    std::string tilesetReference(const std::filesystem::path& mapDir,
+                                 const std::string& tilesetDir, const char* file) {
+        std::error_code ec;
+        std::filesystem::path target = std::filesystem::absolute(std::filesystem::path(tilesetDir) / file, ec);
+        std::filesystem::path relative = std::filesystem::relative(target, mapDir, ec);
+        if (!ec && !relative.empty()) {
+            return relative.generic_string();
+        }
+        return target.generic_string();
+    }
+
+    std::string jsonEscape(const std::string& s) {
+        std::string out;
+        for (char c : s) {
+            if (c == '"' || c == '\\') out += '\\';
+            out += c;
+        }
+        return out;
+    }
+}
+
+// ============================================================================
+// 配置
+// ============================================================================
+
+void StressSceneConfig::resolveCounts() {
+    const int area = width * height;
+    if (treeCount < 0) treeCount = area / 64;
+    if (stoneCount < 0) stoneCount = area / 256;
+    if (plantCount < 0) plantCount = area / 128;
+    if (poolCount < 0) poolCount = area / 4096;
+    if (rabbitCount < 0) rabbitCount = std::max(20, area / 2048);
+}
+
+bool StressScene::parseSpec(const std::string& spec, StressSceneConfig& config) {
+    size_t start = 0;
+    bool first = true;
+
+    while (start <= spec.size()) {
+        size_t end = spec.find(',', start);
+        if (end == std::string::npos) end = spec.size();
+        std::string item = spec.substr(start, end - start);
+        start = end + 1;
+
+        try {
+            if (first) {
+                size_t x = item.find('x');
+                if (x == std::string::npos) return false;
+                config.width = std::stoi(item.substr(0, x));
+                config.height = std::stoi(item.substr(x + 1));
+                first = false;
+                continue;
+            }
+
+            size_t eq = item.find('=');
+            if (eq == std::string::npos) return false;
+            std::string key = item.substr(0, eq);
+            int value = std::stoi(item.substr(eq + 1));
+            if (value < 0) return false;
+
+            if (key == "trees") config.treeCount = value;
+            else if (key == "stones") config.stoneCount = value;
+            else if (key == "plants") config.plantCount = value;
+            else if (key == "rabbits") config.rabbitCount = value;
+            else if (key == "pools") config.poolCount = value;
+            else return false;
+        } catch (const std::exception&) {
+            return false;
+        }
+    }
+
+    return config.width >= 2 * SPAWN_CLEAR_RADIUS && config.width <= MAX_SIZE &&
+           config.height >= 2 * SPAWN_CLEAR_RADIUS && config.height <= MAX_SIZE;
+}
+
+std::string StressScene::defaultPath(const StressSceneConfig& config) {
+    std::error_code ec;
+    std::filesystem::path dir = std::filesystem::temp_directory_path(ec);
+    if (ec) dir = ".";
+    return (dir / ("pf_stress_" + std::to_string(config.width) + "x" + std::to_string(config.height) +
+                   "_" + std::to_string(config.seed) + ".tmj")).string();
+}
+
+std::string StressScene::describe(const StressSceneConfig& config) {
+    return std::to_string(config.width) + "x" + std::to_string(config.height) +
+           ",trees=" + std::to_string(config.treeCount) +
+           ",stones=" + std::to_string(config.stoneCount) +
+           ",plants=" + std::to_string(config.plantCount) +
+           ",rabbits=" + std::to_string(config.rabbitCount) +
+           ",pools=" + std::to_string(config.poolCount);
+}
+
+// ============================================================================
+// 生成
+// ============================================================================
+
+bool StressScene::writeMap(const StressSceneConfig& requested, const std::string& path,
+                           const std::string& tilesetDir, StressSceneStats* stats) {
+    StressSceneConfig config = requested;
+    config.resolveCounts();
+
+    std::filesystem::path mapPath(path);
+    std::filesystem::path mapDir = std::filesystem::absolute(mapPath).parent_path();
+    std::error_code ec;
+    std::filesystem::create_directories(mapDir, ec);
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        LOG_ERROR("[StressScene] 无法写入: " << path);
+        return false;
+    }
+
+    const int w = config.width;
+    const int h = config.height;
+
+    // 地面和对象使用不同的随机流：改对象数量不会改变地面
+    Rng groundRng(config.seed, 1);
+    Rng objectRng(config.seed, 2);
+    Rng poolRng(config.seed, 3);
+
+    Occupancy occupancy(w, h);
+    StressSceneStats written;
+
+    // 水塘先定下来：地面按它换成水面，对象放置时避开
+    for (int i = 0; i < config.poolCount; i++) {
+        int cx = poolRng.range(0, w - 1);
+        int cy = poolRng.range(0, h - 1);
+        written.waterTiles += occupancy.addPool(cx, cy, poolRng.range(POOL_MIN_RADIUS, POOL_MAX_RADIUS));
+    }
+
+    out << "{ \"compressionlevel\":-1,\n \"height\":" << h << ",\n \"infinite\":false,\n \"layers\":[\n";
+
+    // ---- 地面图块层（逐行写出，不在内存里拼整张图） ----
+    out << "        {\n         \"data\":[";
+    std::string row;
+    for (int y = 0; y < h; y++) {
+        row.clear();
+        for (int x = 0; x < w; x++) {
+            if (x > 0) row += ", ";
+            // 水面格子也照常抽一次，水塘数量不影响其余地面
+            int gid = pickGroundGid(groundRng);
+            row += std::to_string(occupancy.isWater(x, y) ? GID_WATER : gid);
+        }
+        out << row << (y + 1 < h ? ",\n            " : "");
+    }
+    out << "],\n         \"height\":" << h << ",\n         \"id\":1,\n"
+        << "         \"name\":\"ground\",\n         \"opacity\":1,\n"
+        << "         \"type\":\"tilelayer\",\n         \"visible\":true,\n"
+        << "         \"width\":" << w << ",\n         \"x\":0,\n         \"y\":0\n        }, \n";
+
+    // ---- 对象层 ----
+    out << "        {\n         \"draworder\":\"topdown\",\n         \"id\":2,\n"
+        << "         \"name\":\"objects\",\n         \"objects\":[";
+
+    int nextObjectId = 1;
+
+    // 对象坐标为左下角（Tiled 图块对象的约定）
+    auto writeObject = [&](int gid, int tileX, int tileY, int sizeTiles) {
+        int pixelSize = sizeTiles * SRC_TILE_SIZE;
+        out << (nextObjectId > 1 ? ",\n" : "\n")
+            << "                {\n                 \"gid\":" << gid
+            << ",\n                 \"height\":" << pixelSize
+            << ",\n                 \"id\":" << nextObjectId
+            << ",\n                 \"name\":\"\",\n                 \"rotation\":0,\n"
+            << "                 \"type\":\"\",\n                 \"visible\":true,\n"
+            << "                 \"width\":" << pixelSize
+            << ",\n                 \"x\":" << tileX * SRC_TILE_SIZE
+            << ",\n                 \"y\":" << (tileY + sizeTiles) * SRC_TILE_SIZE
+            << "\n                }";
+        nextObjectId++;
+    };
+
+    // 树先放（占 2x2，最难找空位），再放 1x1 的石头和植物
+    int tileX = 0, tileY = 0;
+    for (int i = 0; i < config.treeCount; i++) {
+        if (!occupancy.place(objectRng, 2, tileX, tileY)) continue;
+        writeObject(FIRST_GID_TREE + objectRng.range(0, TREE_VARIANTS - 1), tileX, tileY, 2);
+        written.trees++;
+    }
+    for (int i = 0; i < config.stoneCount; i++) {
+        if (!occupancy.place(objectRng, 1, tileX, tileY)) continue;
+        writeObject(GID_STONE, tileX, tileY, 1);
+        written.stones++;
+    }
+    for (int i = 0; i < config.plantCount; i++) {
+        if (!occupancy.place(objectRng, 1, tileX, tileY)) continue;
+        writeObject(GID_PLANTS[objectRng.range(0, 1)], tileX, tileY, 1);
+        written.plants++;
+    }
+
+    out << "],\n         \"opacity\":1,\n         \"type\":\"objectgroup\",\n"
+        << "         \"visible\":true,\n         \"x\":0,\n         \"y\":0\n        }],\n";
+
+    // ---- 地图属性和图块集 ----
+    out << " \"nextlayerid\":3,\n \"nextobjectid\":" << nextObjectId << ",\n"
+        << " \"orientation\":\"orthogonal\",\n \"renderorder\":\"right-down\",\n"
+        << " \"tiledversion\":\"1.11.2\",\n \"tileheight\":" << SRC_TILE_SIZE << ",\n"
+        << " \"tilesets\":[\n"
+        << "        {\n         \"firstgid\":" << FIRST_GID_PART1 << ",\n         \"source\":\""
+        << jsonEscape(tilesetReference(mapDir, tilesetDir, "part_1.tsx")) << "\"\n        }, \n"
+        << "        {\n         \"firstgid\":" << FIRST_GID_TREE << ",\n         \"source\":\""
+        << jsonEscape(tilesetReference(mapDir, tilesetDir, "tree.tsx")) << "\"\n        }, \n"
+        << "        {\n         \"firstgid\":" << FIRST_GID_PART3 << ",\n         \"source\":\""
+        << jsonEscape(tilesetReference(mapDir, tilesetDir, "part_3.tsx")) << "\"\n        }, \n"
+        << "        {\n         \"firstgid\":" << FIRST_GID_WATER << ",\n         \"source\":\""
+        << jsonEscape(tilesetReference(mapDir, tilesetDir, "water_anim.tsx")) << "\"\n        }],\n"
+        << " \"tilewidth\":" << SRC_TILE_SIZE << ",\n \"type\":\"map\",\n \"version\":\"1.10\",\n"
+        << " \"width\":" << w << "\n}";
+
+    out.flush();
+    if (!out) {
+        LOG_ERROR("[StressScene] 写入失败: " << path);
+        return false;
+    }
+    written.fileBytes = static_cast<std::uint64_t>(out.tellp());
+
+    LOG_INFO("[StressScene] " << path << ": " << w << "x" << h << " tiles, "
+             << written.trees << " trees, " << written.stones << " stones, "
+             << written.plants << " plants, " << written.waterTiles << " water tiles (" << written.fileBytes / 1024 << " KB)");
+
+    if (stats) *stats = written;
+    return true;
+}
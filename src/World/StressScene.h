@@ -0,0 +1,65 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+// ============================================================================
+// 压力测试场景 (Stress Scene)
+//
+// 生成任意尺寸的 Tiled 地图（.tmj），用于观察加载时间、内存和帧耗时随
+// 世界规模的变化。生成的地图和手工地图格式完全一致：
+//   - 一个地面图块层（part_1.tsx），其中散布水塘（water_anim.tsx，带
+//     <animation> 的水面，覆盖 TileMap 的动画 tile 路径）
+//   - 一个对象层：树木（tree.tsx）、石头和野生植物（part_3.tsx）
+//   - 图块集用相对路径引用 assets/game_source 下的 tsx，属性（HP、掉落等）
+//     全部来自 tsx，TreeManager / StoneBuildManager / WildPlantManager
+//     照常从对象层接管
+// 兔子数量由 GameState::initRabbits 交给 RabbitManager::spawnRandomRabbits。
+//
+// 同一组参数（含种子）生成的文件逐字节相同。
+//
+// 命令行写法（见 parseSpec）：
+//   1024x1024                           只给尺寸，对象数按面积推算
+//   2048x2048,trees=40000,rabbits=2000  指定部分数量
+// ============================================================================
+
+struct StressSceneConfig {
+    int width = 256;                // 图块数
+    int height = 256;
+    int treeCount = -1;             // < 0 表示按面积推算（见 resolveCounts）
+    int stoneCount = -1;
+    int plantCount = -1;
+    int rabbitCount = -1;
+    int poolCount = -1;             // 水塘数（半径 2~5 图块）
+    std::uint64_t seed = 1;
+
+    // 把未指定的数量按面积补全
+    void resolveCounts();
+};
+
+// 实际写出的内容（对象放不下时会少于请求数量）
+struct StressSceneStats {
+    int trees = 0;
+    int stones = 0;
+    int plants = 0;
+    int waterTiles = 0;
+    std::uint64_t fileBytes = 0;
+};
+
+class StressScene {
+public:
+    static constexpr int MAX_SIZE = 2048;
+
+    // 解析 "WxH[,trees=N][,stones=N][,plants=N][,rabbits=N][,pools=N]"
+    static bool parseSpec(const std::string& spec, StressSceneConfig& config);
+
+    // 生成地图文件；tilesetDir 为 tsx 所在目录（写入时转成相对地图文件的路径）
+    static bool writeMap(const StressSceneConfig& config, const std::string& path,
+                         const std::string& tilesetDir = "assets/game_source",
+                         StressSceneStats* stats = nullptr);
+
+    // 默认输出位置（系统临时目录，按参数命名）
+    static std::string defaultPath(const StressSceneConfig& config);
+
+    // 描述字符串（日志 / 基准测试参数）
+    static std::string describe(const StressSceneConfig& config);
+};
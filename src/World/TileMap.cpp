@@ -1,23 +1,28 @@
 #include "TileMap.h"
-#include <iostream>
+#include "../Systems/Logger.h"
+#include "../Systems/RenderStats.h"
 #include <fstream>
 #include <sstream>
 #include <algorithm>
+#include <cmath>
 
 // ============================================================================
 // Constructors
 // ============================================================================
 
 TileMap::TileMap() 
-    : width(0), height(0), tileSize(32), srcTileSize(32), tilesPerRow(16)
+    : width(0), height(0), tileSize(32), srcTileSize(32), tilesPerRow(16), texturesEnabled(true),
+      chunkTick(0), chunksX(0), chunksY(0), animationClock(0.0)
 {}
 
 TileMap::TileMap(int w, int h, int displayTileSize) 
-    : width(w), height(h), tileSize(displayTileSize), srcTileSize(32), tilesPerRow(16)
+    : width(w), height(h), tileSize(displayTileSize), srcTileSize(32), tilesPerRow(16), texturesEnabled(true),
+      chunkTick(0), chunksX(0), chunksY(0), animationClock(0.0)
 {
-    groundLayer.resize(width * height);
-    decorationLayer.resize(width * height);
+    groundLayer.resize(width * height, 0);
+    decorationLayer.resize(width * height, 0);
     collisionLayer.resize(width * height, false);
+    resetChunks();
 }
 
 // ============================================================================
@@ -25,38 +30,38 @@ TileMap::TileMap(int w, int h, int displayTileSize)
 // ============================================================================
 
 bool TileMap::loadFromTiled(const std::string& tmjPath, int displayTileSize) {
-    std::cout << "\n========================================" << std::endl;
-    std::cout << "  Loading Tiled map: " << tmjPath << std::endl;
-    std::cout << "========================================" << std::endl;
+    LOG_INFO("\n========================================");
+    LOG_INFO("  Loading Tiled map: " << tmjPath);
+    LOG_INFO("========================================");
     
     // Read file
     std::ifstream file(tmjPath);
     if (!file.is_open()) {
-        std::cerr << "[ERROR] Failed to open map file: " << tmjPath << std::endl;
-        std::cerr << "[DEBUG] Please check:" << std::endl;
-        std::cerr << "  1. File exists at this path" << std::endl;
-        std::cerr << "  2. Working directory is correct" << std::endl;
-        std::cerr << "  3. File has read permissions" << std::endl;
+        LOG_ERROR("[ERROR] Failed to open map file: " << tmjPath);
+        LOG_DEBUG("[DEBUG] Please check:");
+        LOG_ERROR("  1. File exists at this path");
+        LOG_ERROR("  2. Working directory is correct");
+        LOG_ERROR("  3. File has read permissions");
         return false;
     }
     
-    std::cout << "[OK] File opened successfully" << std::endl;
+    LOG_INFO("[OK] File opened successfully");
     
     std::stringstream buffer;
     buffer << file.rdbuf();
     std::string json = buffer.str();
     file.close();
     
-    std::cout << "[DEBUG] File size: " << json.size() << " bytes" << std::endl;
+    LOG_DEBUG("[DEBUG] File size: " << json.size() << " bytes");
     
     if (json.empty()) {
-        std::cerr << "[ERROR] File is empty!" << std::endl;
+        LOG_ERROR("[ERROR] File is empty!");
         return false;
     }
     
     // Get directory of .tmj file
     tmjBasePath = getDirectory(tmjPath);
-    std::cout << "[DEBUG] Base path: " << tmjBasePath << std::endl;
+    LOG_DEBUG("[DEBUG] Base path: " << tmjBasePath);
     
     // Parse basic map info
     width = getJsonInt(json, "width");
@@ -64,33 +69,33 @@ bool TileMap::loadFromTiled(const std::string& tmjPath, int displayTileSize) {
     srcTileSize = getJsonInt(json, "tilewidth");
     
     if (width == 0 || height == 0) {
-        std::cerr << "[ERROR] Failed to parse map dimensions!" << std::endl;
-        std::cerr << "[DEBUG] width=" << width << ", height=" << height << std::endl;
-        std::cerr << "[DEBUG] First 200 chars of file:" << std::endl;
-        std::cerr << json.substr(0, 200) << std::endl;
+        LOG_ERROR("[ERROR] Failed to parse map dimensions!");
+        LOG_DEBUG("[DEBUG] width=" << width << ", height=" << height);
+        LOG_DEBUG("[DEBUG] First 200 chars of file:");
+        LOG_ERROR(json.substr(0, 200));
         return false;
     }
     
     tileSize = (displayTileSize > 0) ? displayTileSize : srcTileSize;
     
-    std::cout << "[OK] Map size: " << width << "x" << height << " tiles" << std::endl;
-    std::cout << "[OK] Source tile size: " << srcTileSize << "x" << srcTileSize << std::endl;
-    std::cout << "[OK] Display tile size: " << tileSize << "x" << tileSize << std::endl;
+    LOG_INFO("[OK] Map size: " << width << "x" << height << " tiles");
+    LOG_INFO("[OK] Source tile size: " << srcTileSize << "x" << srcTileSize);
+    LOG_INFO("[OK] Display tile size: " << tileSize << "x" << tileSize);
     
     // Parse tilesets
     parseTilesets(json);
     
     // Parse tile layers
-    parseLayers(json);
+    std::vector<LayerInfo> layers = parseLayers(json);
     
     // Parse object groups (trees, buildings, etc.)
     parseObjectGroups(json);
     
-    // Initialize internal data
-    initializeFromLayers();
+    // Initialize internal data (raw layer data is dropped afterwards)
+    initializeFromLayers(layers);
     
-    std::cout << "[OK] Map pixel size: " << getMapSize().x << "x" << getMapSize().y << std::endl;
-    std::cout << "========================================\n" << std::endl;
+    LOG_INFO("[OK] Map pixel size: " << getMapSize().x << "x" << getMapSize().y);
+    LOG_INFO("========================================\n");
     
     return true;
 }
@@ -117,7 +122,7 @@ bool TileMap::loadTilesets() {
         if (ts.texture.loadFromFile(paths[i])) {
             ts.loaded = true;
         } else {
-            std::cerr << "Failed to load: " << paths[i] << std::endl;
+            LOG_ERROR("Failed to load: " << paths[i]);
         }
         tilesets.push_back(ts);
     }
@@ -128,39 +133,28 @@ void TileMap::setTile(int x, int y, int rawID, bool isGround) {
     if (x < 0 || x >= width || y < 0 || y >= height) return;
     
     int index = y * width + x;
-    Tile& tile = isGround ? groundLayer[index] : decorationLayer[index];
-    
-    tile.id = rawID;
-    
-    if (rawID >= 1000) {
-        tile.textureIndex = 1;
-        int localID = rawID - 1000;
-        tile.texCoords.x = (localID % 16) * 32;
-        tile.texCoords.y = (localID / 16) * 32;
-    } else {
-        tile.textureIndex = 0;
-        tile.texCoords.x = (rawID % 16) * 32;
-        tile.texCoords.y = (rawID / 16) * 32;
-    }
+    
+    // tileset 0 从 gid 0 开始、tileset 1 从 1000 开始（见 loadTilesets），查找表按 firstGid 推导
+    TileGid gid = (rawID > 0 && rawID <= MAX_TILE_GID) ? static_cast<TileGid>(rawID) : 0;
+    ensureTileInfos(gid);
+    (isGround ? groundLayer : decorationLayer)[index] = gid;
+    if (!chunks.empty()) releaseChunk((y / CHUNK_SIZE) * chunksX + x / CHUNK_SIZE);
     
     if (!isGround && rawID != -1) {
-        if (rawID == 67 || rawID == 68 || rawID == 48) {
-            tile.type = TileType::Ground;
-            collisionLayer[index] = false;
-        } else {
-            tile.type = TileType::Obstacle;
-            collisionLayer[index] = true;
-        }
+        // 可通行与否是格子的属性，只记在碰撞位层，不写进按 gid 共享的 TileInfo
+        bool walkable = (rawID == 67 || rawID == 68 || rawID == 48);
+        collisionLayer[index] = !walkable;
     }
 }
 
 void TileMap::initializeFromArray(const std::vector<std::vector<int>>& ground, 
                                   const std::vector<std::vector<int>>& decor) {
-    groundLayer.resize(width * height);
-    decorationLayer.resize(width * height);
+    groundLayer.resize(width * height, 0);
+    decorationLayer.resize(width * height, 0);
     collisionLayer.resize(width * height, false);
     
     loadTilesets();
+    resetChunks();
     
     for (int y = 0; y < height && y < (int)ground.size(); y++) {
         for (int x = 0; x < width && x < (int)ground[y].size(); x++) {
@@ -183,27 +177,20 @@ void TileMap::render(sf::RenderWindow& window, const sf::View& view) {
         view.getSize().x, view.getSize().y
     );
     
-    int startX = std::max(0, (int)(bounds.left / tileSize) - 1);
-    int startY = std::max(0, (int)(bounds.top / tileSize) - 1);
-    int endX = std::min(width, (int)((bounds.left + bounds.width) / tileSize) + 2);
-    int endY = std::min(height, (int)((bounds.top + bounds.height) / tileSize) + 2);
+    prepareChunks(bounds);
     
-    // Draw ground layer
-    for (int y = startY; y < endY; y++) {
-        for (int x = startX; x < endX; x++) {
-            int idx = y * width + x;
-            if (idx < (int)groundLayer.size() && groundLayer[idx].id > 0) {
-                drawTile(window, groundLayer[idx], x, y);
-            }
-        }
-    }
+    int startCX, startCY, endCX, endCY;
+    chunkRange(bounds, startCX, startCY, endCX, endCY);
     
-    // Draw decoration layer
-    for (int y = startY; y < endY; y++) {
-        for (int x = startX; x < endX; x++) {
-            int idx = y * width + x;
-            if (idx < (int)decorationLayer.size() && decorationLayer[idx].id > 0) {
-                drawTile(window, decorationLayer[idx], x, y);
+    // 先画完所有可见块的地面层，再画装饰层
+    for (int layer = 0; layer < 2; layer++) {
+        for (int cy = startCY; cy < endCY; cy++) {
+            for (int cx = startCX; cx < endCX; cx++) {
+                for (const TileBatch& batch : chunks[cy * chunksX + cx].layers[layer]) {
+                    sf::RenderStates states;
+                    states.texture = &tilesets[batch.tilesetIndex].texture;
+                    RenderStats::draw(window, batch.vertices, states);
+                }
             }
         }
     }
@@ -212,22 +199,225 @@ void TileMap::render(sf::RenderWindow& window, const sf::View& view) {
     renderObjects(window, view);
 }
 
-void TileMap::drawTile(sf::RenderWindow& window, const Tile& tile, int x, int y) {
-    if (tile.textureIndex < 0 || tile.textureIndex >= (int)tilesets.size()) return;
+// ============================================================================
+// 分块顶点缓存
+// ============================================================================
+
+void TileMap::resetChunks() {
+    chunksX = (width + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    chunksY = (height + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    chunks.assign(chunksX * chunksY, TileChunk());
+    builtChunks.clear();
+}
+
+void TileMap::chunkRange(const sf::FloatRect& bounds, int& startCX, int& startCY, int& endCX, int& endCY) const {
+    // 按块裁剪（外扩一格，和逐格绘制时的余量一致）
+    float chunkPixels = (float)(tileSize * CHUNK_SIZE);
+    startCX = std::max(0, (int)std::floor((bounds.left - tileSize) / chunkPixels));
+    startCY = std::max(0, (int)std::floor((bounds.top - tileSize) / chunkPixels));
+    endCX = std::min(chunksX, (int)std::floor((bounds.left + bounds.width + tileSize) / chunkPixels) + 1);
+    endCY = std::min(chunksY, (int)std::floor((bounds.top + bounds.height + tileSize) / chunkPixels) + 1);
+}
+
+void TileMap::prepareChunks(const sf::FloatRect& bounds) {
+    int startCX, startCY, endCX, endCY;
+    chunkRange(bounds, startCX, startCY, endCX, endCY);
+    
+    chunkTick++;
+    for (int cy = startCY; cy < endCY; cy++) {
+        for (int cx = startCX; cx < endCX; cx++) {
+            int chunkIndex = cy * chunksX + cx;
+            if (!chunks[chunkIndex].built) buildChunk(chunkIndex);
+            chunks[chunkIndex].lastUsed = chunkTick;
+        }
+    }
     
-    const TilesetInfo& ts = tilesets[tile.textureIndex];
-    if (!ts.loaded) return;
+    trimChunkCache();
+}
+
+void TileMap::buildChunk(int chunkIndex) {
+    TileChunk& chunk = chunks[chunkIndex];
+    chunk.built = true;
+    builtChunks.push_back(chunkIndex);
+    
+    int x0 = (chunkIndex % chunksX) * CHUNK_SIZE;
+    int y0 = (chunkIndex / chunksX) * CHUNK_SIZE;
+    int x1 = std::min(width, x0 + CHUNK_SIZE);
+    int y1 = std::min(height, y0 + CHUNK_SIZE);
+    
+    for (int y = y0; y < y1; y++) {
+        for (int x = x0; x < x1; x++) {
+            int idx = y * width + x;
+            if (groundLayer[idx] != 0) appendTileQuad(chunkIndex, 0, groundLayer[idx], x, y);
+            if (decorationLayer[idx] != 0) appendTileQuad(chunkIndex, 1, decorationLayer[idx], x, y);
+        }
+    }
+}
+
+void TileMap::releaseChunk(int chunkIndex) {
+    TileChunk& chunk = chunks[chunkIndex];
+    if (!chunk.built) return;
     
-    sf::Sprite s;
-    s.setTexture(ts.texture);
-    s.setTextureRect(sf::IntRect(tile.texCoords.x, tile.texCoords.y, 
-                                  ts.tileWidth, ts.tileHeight));
-    s.setPosition((float)(x * tileSize), (float)(y * tileSize));
+    // 换成空块才会真正归还顶点内存
+    chunk = TileChunk();
+    builtChunks.erase(std::find(builtChunks.begin(), builtChunks.end(), chunkIndex));
+}
+
+void TileMap::trimChunkCache() {
+    while (builtChunks.size() > MAX_CACHED_CHUNKS) {
+        // 淘汰最久未用的块；当前视野内的块（lastUsed == chunkTick）保留
+        int oldest = -1;
+        for (int chunkIndex : builtChunks) {
+            if (chunks[chunkIndex].lastUsed == chunkTick) continue;
+            if (oldest < 0 || chunks[chunkIndex].lastUsed < chunks[oldest].lastUsed) oldest = chunkIndex;
+        }
+        if (oldest < 0) return;
+        releaseChunk(oldest);
+    }
+}
+
+void TileMap::appendTileQuad(int chunkIndex, int layer, TileGid gid, int x, int y) {
+    const TileInfo& info = tileInfos[gid];
+    if (info.tilesetIndex < 0) return;
+    
+    const TilesetInfo& ts = tilesets[info.tilesetIndex];
+    
+    TileChunk& chunk = chunks[chunkIndex];
+    std::vector<TileBatch>& batches = chunk.layers[layer];
+    size_t b = 0;
+    while (b < batches.size() && batches[b].tilesetIndex != info.tilesetIndex) b++;
+    if (b == batches.size()) {
+        batches.push_back(TileBatch{info.tilesetIndex, sf::VertexArray(sf::Quads)});
+    }
+    sf::VertexArray& vertices = batches[b].vertices;
+    size_t first = vertices.getVertexCount();
     
     float scale = (float)tileSize / ts.tileWidth;
-    s.setScale(scale, scale);
+    float left = (float)(x * tileSize);
+    float top = (float)(y * tileSize);
+    float right = left + ts.tileWidth * scale;
+    float bottom = top + ts.tileHeight * scale;
+    float u = info.texX, v = info.texY;
+    if (info.animation >= 0) {
+        // 动画格子直接用当前帧，之后由 update 改写
+        u = animations[info.animation].texCoords.x;
+        v = animations[info.animation].texCoords.y;
+    }
+    float u2 = u + ts.tileWidth, v2 = v + ts.tileHeight;
+    
+    vertices.append(sf::Vertex(sf::Vector2f(left, top), sf::Vector2f(u, v)));
+    vertices.append(sf::Vertex(sf::Vector2f(right, top), sf::Vector2f(u2, v)));
+    vertices.append(sf::Vertex(sf::Vector2f(right, bottom), sf::Vector2f(u2, v2)));
+    vertices.append(sf::Vertex(sf::Vector2f(left, bottom), sf::Vector2f(u, v2)));
+    
+    if (info.animation >= 0) {
+        AnimatedCell cell;
+        cell.animation = static_cast<std::uint16_t>(info.animation);
+        cell.layer = static_cast<std::uint8_t>(layer);
+        cell.batch = static_cast<std::uint8_t>(b);
+        cell.vertex = static_cast<std::uint32_t>(first);
+        chunk.animatedCells.push_back(cell);
+    }
+}
+
+// ============================================================================
+// 动画 tile
+// ============================================================================
+
+void TileMap::buildAnimations() {
+    animations.clear();
     
-    window.draw(s);
+    for (size_t t = 0; t < tilesets.size(); t++) {
+        const TilesetInfo& ts = tilesets[t];
+        // collection 类型每个 tile 一张贴图，无法在同一批顶点里切帧
+        if (ts.collection) continue;
+        
+        for (const auto& prop : ts.tileProperties) {
+            if (prop.animation.empty()) continue;
+            
+            // 只登记地图里实际用到的 gid
+            int gid = ts.firstGid + prop.localId;
+            if (gid <= 0 || gid >= (int)tileInfos.size()) continue;
+            if (tileInfos[gid].tilesetIndex != (int)t) continue;
+            if (animations.size() >= 0x7FFF) {
+                LOG_WARN("[WARNING] Too many animated tiles, remaining animations ignored");
+                return;
+            }
+            
+            TileAnimation anim;
+            anim.tilesetIndex = static_cast<std::int16_t>(t);
+            anim.frames = prop.animation;
+            anim.totalDuration = 0.0f;
+            for (const auto& frame : anim.frames) anim.totalDuration += frame.duration;
+            if (anim.totalDuration <= 0.0f) continue;
+            anim.frameChanged = false;
+            
+            tileInfos[gid].animation = static_cast<std::int16_t>(animations.size());
+            animations.push_back(std::move(anim));
+            selectAnimationFrame(animations.size() - 1, 0);
+        }
+    }
+    
+    if (!animations.empty()) {
+        LOG_INFO("[OK] " << animations.size() << " animated tile(s)");
+    }
+}
+
+void TileMap::selectAnimationFrame(size_t animIndex, size_t frame) {
+    TileAnimation& anim = animations[animIndex];
+    anim.currentFrame = frame;
+    
+    const TilesetInfo& ts = tilesets[anim.tilesetIndex];
+    int cols = ts.columns > 0 ? ts.columns : 16;
+    int localId = anim.frames[frame].localId;
+    anim.texCoords = sf::Vector2f((float)((localId % cols) * ts.tileWidth),
+                                  (float)((localId / cols) * ts.tileHeight));
+}
+
+void TileMap::update(float dt) {
+    animationClock += dt;
+    
+    bool anyChanged = false;
+    for (size_t a = 0; a < animations.size(); a++) {
+        TileAnimation& anim = animations[a];
+        float t = (float)std::fmod(animationClock, (double)anim.totalDuration);
+        size_t frame = 0;
+        while (frame + 1 < anim.frames.size() && t >= anim.frames[frame].duration) {
+            t -= anim.frames[frame].duration;
+            frame++;
+        }
+        
+        anim.frameChanged = (frame != anim.currentFrame);
+        if (anim.frameChanged) {
+            selectAnimationFrame(a, frame);
+            anyChanged = true;
+        }
+    }
+    if (!anyChanged) return;
+    
+    // 只改写已生成块中换了帧的格子的贴图坐标，位置和其余顶点不动
+    for (int chunkIndex : builtChunks) {
+        TileChunk& chunk = chunks[chunkIndex];
+        for (const AnimatedCell& cell : chunk.animatedCells) {
+            const TileAnimation& anim = animations[cell.animation];
+            if (!anim.frameChanged) continue;
+            
+            const TilesetInfo& ts = tilesets[anim.tilesetIndex];
+            float u = anim.texCoords.x, v = anim.texCoords.y;
+            float u2 = u + ts.tileWidth, v2 = v + ts.tileHeight;
+            sf::Vertex* quad = &chunk.layers[cell.layer][cell.batch].vertices[cell.vertex];
+            quad[0].texCoords = sf::Vector2f(u, v);
+            quad[1].texCoords = sf::Vector2f(u2, v);
+            quad[2].texCoords = sf::Vector2f(u2, v2);
+            quad[3].texCoords = sf::Vector2f(u, v2);
+        }
+    }
+}
+
+size_t TileMap::getAnimatedCellCount() const {
+    size_t count = 0;
+    for (int chunkIndex : builtChunks) count += chunks[chunkIndex].animatedCells.size();
+    return count;
 }
 
 void TileMap::renderObjects(sf::RenderWindow& window, const sf::View& view) {
@@ -267,7 +457,7 @@ void TileMap::renderObjects(sf::RenderWindow& window, const sf::View& view) {
         sprite.setPosition(drawX, drawY);
         sprite.setScale(scale, scale);
         
-        window.draw(sprite);
+        RenderStats::draw(window, sprite);
     }
 }
 
@@ -291,19 +481,10 @@ bool TileMap::isColliding(const sf::FloatRect& box) const {
     }
     
     // Also check collision with objects
-    float scale = (float)tileSize / srcTileSize;
     for (const auto& obj : objects) {
         if (obj.gid <= 0) continue;
         
-        // Object collision box (in display coordinates)
-        sf::FloatRect objBox(
-            obj.x * scale,
-            (obj.y - obj.height) * scale,
-            obj.width * scale,
-            obj.height * scale
-        );
-        
-        if (box.intersects(objBox)) {
+        if (box.intersects(getObjectBounds(obj))) {
             return true;
         }
     }
@@ -311,6 +492,23 @@ bool TileMap::isColliding(const sf::FloatRect& box) const {
     return false;
 }
 
+bool TileMap::isTileBlocked(int x, int y) const {
+    if (x < 0 || y < 0 || x >= width || y >= height) return true;
+    size_t idx = static_cast<size_t>(y) * width + x;
+    return idx < collisionLayer.size() && collisionLayer[idx];
+}
+
+sf::FloatRect TileMap::getObjectBounds(const MapObject& obj) const {
+    // Object collision box (in display coordinates)
+    float scale = (float)tileSize / srcTileSize;
+    return sf::FloatRect(
+        obj.x * scale,
+        (obj.y - obj.height) * scale,
+        obj.width * scale,
+        obj.height * scale
+    );
+}
+
 // ============================================================================
 // Getters
 // ============================================================================
@@ -353,7 +551,8 @@ std::string TileMap::normalizePath(const std::string& basePath, const std::strin
     std::string cleanRelative = cleanPath(relativePath);
     
     // If absolute path or special path, return directly
-    if (cleanRelative.empty() || cleanRelative[0] == ':') {
+    if (cleanRelative.empty() || cleanRelative[0] == ':' || cleanRelative[0] == '/' ||
+        (cleanRelative.size() > 1 && cleanRelative[1] == ':')) {
         return cleanRelative;
     }
     
@@ -581,10 +780,10 @@ void TileMap::parseTilesets(const std::string& json) {
     tilesets.clear();
     
     auto tsObjects = getJsonObjectArray(json, "tilesets");
-    std::cout << "[DEBUG] Found " << tsObjects.size() << " tileset reference(s)" << std::endl;
+    LOG_DEBUG("[DEBUG] Found " << tsObjects.size() << " tileset reference(s)");
     
     if (tsObjects.empty()) {
-        std::cerr << "[WARNING] No tilesets found in map file!" << std::endl;
+        LOG_WARN("[WARNING] No tilesets found in map file!");
     }
     
     for (const auto& tsJson : tsObjects) {
@@ -596,12 +795,12 @@ void TileMap::parseTilesets(const std::string& json) {
         
         if (!source.empty()) {
             // External .tsx file
-            std::cout << "  -> External tileset: " << source << " (firstGid=" << ts.firstGid << ")" << std::endl;
+            LOG_INFO("  -> External tileset: " << source << " (firstGid=" << ts.firstGid << ")");
             
             // Skip Tiled built-in automap-tiles
             if (source.find("automap-tiles") != std::string::npos || 
                 source[0] == ':') {
-                std::cout << "     (Skipping built-in tileset)" << std::endl;
+                LOG_INFO("     (Skipping built-in tileset)");
                 ts.loaded = false;
                 tilesets.push_back(ts);
                 continue;
@@ -609,13 +808,13 @@ void TileMap::parseTilesets(const std::string& json) {
             
             // Build full .tsx file path
             std::string tsxPath = normalizePath(tmjBasePath, source);
-            std::cout << "     Resolved path: " << tsxPath << std::endl;
+            LOG_INFO("     Resolved path: " << tsxPath);
             
             // Load .tsx file
             if (loadTsxFile(tsxPath, ts)) {
-                std::cout << "     [OK] Loaded successfully" << std::endl;
+                LOG_INFO("     [OK] Loaded successfully");
             } else {
-                std::cout << "     [FAILED] Load failed" << std::endl;
+                LOG_INFO("     [FAILED] Load failed");
             }
         } else {
             // Embedded tileset
@@ -626,13 +825,15 @@ void TileMap::parseTilesets(const std::string& json) {
             ts.imagePath = getJsonString(tsJson, "image");
             
             std::string fullPath = normalizePath(tmjBasePath, ts.imagePath);
-            std::cout << "  -> Embedded tileset image: " << fullPath << std::endl;
+            LOG_INFO("  -> Embedded tileset image: " << fullPath);
             
-            if (ts.texture.loadFromFile(fullPath)) {
+            if (!texturesEnabled) {
+                ts.loaded = true;  // 无渲染模式：元数据就绪即可
+            } else if (ts.texture.loadFromFile(fullPath)) {
                 ts.loaded = true;
-                std::cout << "     [OK] Texture loaded" << std::endl;
+                LOG_INFO("     [OK] Texture loaded");
             } else {
-                std::cout << "     [FAILED] Texture load failed" << std::endl;
+                LOG_INFO("     [FAILED] Texture load failed");
             }
         }
         
@@ -654,11 +855,11 @@ void TileMap::parseTilesets(const std::string& json) {
     for (const auto& ts : tilesets) {
         if (ts.loaded) loadedCount++;
     }
-    std::cout << "[OK] Total " << tilesets.size() << " tileset(s), " 
-              << loadedCount << " loaded successfully" << std::endl;
+    LOG_INFO("[OK] Total " << tilesets.size() << " tileset(s), " 
+          << loadedCount << " loaded successfully");
               
     if (loadedCount == 0 && !tilesets.empty()) {
-        std::cerr << "[WARNING] No tilesets loaded! Map will appear blank." << std::endl;
+        LOG_WARN("[WARNING] No tilesets loaded! Map will appear blank.");
     }
 }
 
@@ -669,7 +870,7 @@ void TileMap::parseTilesets(const std::string& json) {
 bool TileMap::loadTsxFile(const std::string& tsxPath, TilesetInfo& ts) {
     std::ifstream file(tsxPath);
     if (!file.is_open()) {
-        std::cout << "     Cannot open: " << tsxPath << std::endl;
+        LOG_INFO("     Cannot open: " << tsxPath);
         return false;
     }
     
@@ -688,9 +889,9 @@ bool TileMap::loadTsxFile(const std::string& tsxPath, TilesetInfo& ts) {
     ts.tileCount = getXmlAttrInt(xml, "tilecount");
     ts.name = getXmlAttrStr(xml, "name");
     
-    std::cout << "     Tileset name: " << ts.name << std::endl;
-    std::cout << "     Tile: " << ts.tileWidth << "x" << ts.tileHeight 
-              << ", columns: " << ts.columns << ", count: " << ts.tileCount << std::endl;
+    LOG_INFO("     Tileset name: " << ts.name);
+    LOG_INFO("     Tile: " << ts.tileWidth << "x" << ts.tileHeight 
+          << ", columns: " << ts.columns << ", count: " << ts.tileCount);
     
     // ========================================
     // 解析所有 <tile> 元素及其属性
@@ -700,14 +901,22 @@ bool TileMap::loadTsxFile(const std::string& tsxPath, TilesetInfo& ts) {
         size_t tilePos = xml.find("<tile", searchPos);
         if (tilePos == std::string::npos) break;
         
-        // 找到这个tile的结束位置
-        size_t tileEnd = xml.find("</tile>", tilePos);
-        if (tileEnd == std::string::npos) {
-            // 可能是自闭合标签
-            tileEnd = xml.find("/>", tilePos);
-            if (tileEnd == std::string::npos) break;
-            tileEnd += 2;
+        // 跳过 <tileset>、<tileoffset> 等同前缀标签
+        char next = tilePos + 5 < xml.size() ? xml[tilePos + 5] : '>';
+        if (next != ' ' && next != '\t' && next != '\n' && next != '\r') {
+            searchPos = tilePos + 5;
+            continue;
+        }
+        
+        // 找到这个tile的结束位置（自闭合标签本身就是结尾，不能去找后面别的 </tile>）
+        size_t tagEnd = xml.find(">", tilePos);
+        if (tagEnd == std::string::npos) break;
+        size_t tileEnd;
+        if (xml[tagEnd - 1] == '/') {
+            tileEnd = tagEnd + 1;
         } else {
+            tileEnd = xml.find("</tile>", tagEnd);
+            if (tileEnd == std::string::npos) break;
             tileEnd += 7; // length of "</tile>"
         }
         
@@ -812,21 +1021,39 @@ bool TileMap::loadTsxFile(const std::string& tsxPath, TilesetInfo& ts) {
             prop.imagePath = getXmlAttrStr(imgTag, "source");
         }
         
+        // 解析这个tile的 <animation> 帧（duration 单位为毫秒）
+        size_t animPos = tileXml.find("<animation>");
+        if (animPos != std::string::npos) {
+            size_t animEnd = tileXml.find("</animation>", animPos);
+            size_t framePos = animPos;
+            while ((framePos = tileXml.find("<frame", framePos)) != std::string::npos && framePos < animEnd) {
+                size_t frameEnd = tileXml.find("/>", framePos);
+                if (frameEnd == std::string::npos) break;
+                std::string frameTag = tileXml.substr(framePos, frameEnd - framePos);
+                
+                TileAnimationFrame frame;
+                frame.localId = getXmlAttrInt(frameTag, "tileid");
+                frame.duration = getXmlAttrInt(frameTag, "duration") / 1000.0f;
+                prop.animation.push_back(frame);
+                framePos = frameEnd;
+            }
+        }
+        
         // 输出调试信息
         if (!prop.name.empty()) {
-            std::cout << "     [Tile " << prop.localId << "] name=" << prop.name 
-                      << ", type=" << prop.type << ", HP=" << prop.hp 
-                      << ", defense=" << prop.defense << std::endl;
+            LOG_INFO("     [Tile " << prop.localId << "] name=" << prop.name 
+                  << ", type=" << prop.type << ", HP=" << prop.hp 
+                  << ", defense=" << prop.defense);
             if (!prop.dropTypes.empty()) {
-                std::cout << "       drops: ";
+                std::string drops;
                 for (size_t i = 0; i < prop.dropTypes.size(); i++) {
-                    std::cout << prop.dropTypes[i];
+                    drops += prop.dropTypes[i];
                     if (i < prop.dropProbabilities.size()) {
-                        std::cout << "(" << (int)(prop.dropProbabilities[i] * 100) << "%)";
+                        drops += "(" + std::to_string((int)(prop.dropProbabilities[i] * 100)) + "%)";
                     }
-                    if (i < prop.dropTypes.size() - 1) std::cout << ", ";
+                    if (i < prop.dropTypes.size() - 1) drops += ", ";
                 }
-                std::cout << std::endl;
+                LOG_INFO("       drops: " << drops);
             }
         }
         
@@ -834,7 +1061,15 @@ bool TileMap::loadTsxFile(const std::string& tsxPath, TilesetInfo& ts) {
         searchPos = tileEnd;
     }
     
-    std::cout << "     Parsed " << ts.tileProperties.size() << " tile properties" << std::endl;
+    LOG_INFO("     Parsed " << ts.tileProperties.size() << " tile properties");
+    ts.collection = (ts.columns == 0);
+    
+    // 无渲染模式：只需要尺寸和属性
+    if (!texturesEnabled) {
+        if (ts.columns == 0) ts.columns = 1;
+        ts.loaded = true;
+        return true;
+    }
     
     // ========================================
     // 处理 "collection of images" tileset (columns == 0)
@@ -842,7 +1077,7 @@ bool TileMap::loadTsxFile(const std::string& tsxPath, TilesetInfo& ts) {
     // 使用 shared_ptr 避免 vector 重新分配时贴图失效
     // ========================================
     if (ts.columns == 0) {
-        std::cout << "     [INFO] Collection of images tileset detected" << std::endl;
+        LOG_INFO("     [INFO] Collection of images tileset detected");
         
         // 为每个 tile 加载独立的贴图
         bool anyLoaded = false;
@@ -858,7 +1093,7 @@ bool TileMap::loadTsxFile(const std::string& tsxPath, TilesetInfo& ts) {
             if (prop.texture->loadFromFile(imgFullPath)) {
                 prop.hasTexture = true;
                 anyLoaded = true;
-                std::cout << "     [Tile " << prop.localId << "] Loaded: " << imgFullPath << std::endl;
+                LOG_INFO("     [Tile " << prop.localId << "] Loaded: " << imgFullPath);
                 continue;
             }
             
@@ -873,14 +1108,14 @@ bool TileMap::loadTsxFile(const std::string& tsxPath, TilesetInfo& ts) {
                 if (prop.texture->loadFromFile(altPath)) {
                     prop.hasTexture = true;
                     anyLoaded = true;
-                    std::cout << "     [Tile " << prop.localId << "] Loaded: " << altPath << std::endl;
+                    LOG_INFO("     [Tile " << prop.localId << "] Loaded: " << altPath);
                     break;
                 }
             }
             
             if (!prop.hasTexture) {
                 prop.texture.reset();  // 释放未成功加载的贴图
-                std::cout << "     [Tile " << prop.localId << "] FAILED to load texture" << std::endl;
+                LOG_INFO("     [Tile " << prop.localId << "] FAILED to load texture");
             }
         }
         
@@ -900,7 +1135,7 @@ bool TileMap::loadTsxFile(const std::string& tsxPath, TilesetInfo& ts) {
     // ========================================
     size_t imgPos = xml.find("<image");
     if (imgPos == std::string::npos) {
-        std::cout << "     <image> tag not found" << std::endl;
+        LOG_INFO("     <image> tag not found");
         return false;
     }
     
@@ -910,12 +1145,12 @@ bool TileMap::loadTsxFile(const std::string& tsxPath, TilesetInfo& ts) {
     
     std::string imgSource = getXmlAttrStr(imgTag, "source");
     if (imgSource.empty()) {
-        std::cout << "     Image source not found" << std::endl;
+        LOG_INFO("     Image source not found");
         return false;
     }
     
     std::string imgFullPath = normalizePath(tsxDir, imgSource);
-    std::cout << "     Image path: " << imgFullPath << std::endl;
+    LOG_INFO("     Image path: " << imgFullPath);
     
     if (ts.texture.loadFromFile(imgFullPath)) {
         ts.loaded = true;
@@ -936,7 +1171,7 @@ bool TileMap::loadTsxFile(const std::string& tsxPath, TilesetInfo& ts) {
             // 检查边界
             if (texX + ts.tileWidth > (int)fullImage.getSize().x ||
                 texY + ts.tileHeight > (int)fullImage.getSize().y) {
-                std::cout << "     [Tile " << prop.localId << "] Out of bounds, skipped" << std::endl;
+                LOG_INFO("     [Tile " << prop.localId << "] Out of bounds, skipped");
                 continue;
             }
             
@@ -954,8 +1189,8 @@ bool TileMap::loadTsxFile(const std::string& tsxPath, TilesetInfo& ts) {
             prop.texture = std::make_shared<sf::Texture>();
             if (prop.texture->loadFromImage(subImg)) {
                 prop.hasTexture = true;
-                std::cout << "     [Tile " << prop.localId << "] Extracted from spritesheet: (" 
-                          << texX << ", " << texY << ", " << ts.tileWidth << ", " << ts.tileHeight << ")" << std::endl;
+                LOG_INFO("     [Tile " << prop.localId << "] Extracted from spritesheet: (" 
+                      << texX << ", " << texY << ", " << ts.tileWidth << ", " << ts.tileHeight << ")");
             }
         }
         
@@ -990,7 +1225,7 @@ bool TileMap::loadTsxFile(const std::string& tsxPath, TilesetInfo& ts) {
                 // 检查边界
                 if (texX + ts.tileWidth > (int)fullImage.getSize().x ||
                     texY + ts.tileHeight > (int)fullImage.getSize().y) {
-                    std::cout << "     [Tile " << prop.localId << "] Out of bounds, skipped" << std::endl;
+                    LOG_INFO("     [Tile " << prop.localId << "] Out of bounds, skipped");
                     continue;
                 }
                 
@@ -1008,8 +1243,8 @@ bool TileMap::loadTsxFile(const std::string& tsxPath, TilesetInfo& ts) {
                 prop.texture = std::make_shared<sf::Texture>();
                 if (prop.texture->loadFromImage(subImg)) {
                     prop.hasTexture = true;
-                    std::cout << "     [Tile " << prop.localId << "] Extracted from spritesheet: (" 
-                              << texX << ", " << texY << ", " << ts.tileWidth << ", " << ts.tileHeight << ")" << std::endl;
+                    LOG_INFO("     [Tile " << prop.localId << "] Extracted from spritesheet: (" 
+                          << texX << ", " << texY << ", " << ts.tileWidth << ", " << ts.tileHeight << ")");
                 }
             }
             
@@ -1017,7 +1252,7 @@ bool TileMap::loadTsxFile(const std::string& tsxPath, TilesetInfo& ts) {
         }
     }
     
-    std::cout << "     All paths failed" << std::endl;
+    LOG_INFO("     All paths failed");
     return false;
 }
 
@@ -1025,11 +1260,11 @@ bool TileMap::loadTsxFile(const std::string& tsxPath, TilesetInfo& ts) {
 // Parse Layers
 // ============================================================================
 
-void TileMap::parseLayers(const std::string& json) {
-    layers.clear();
+std::vector<LayerInfo> TileMap::parseLayers(const std::string& json) {
+    std::vector<LayerInfo> layers;
     
     auto layerObjects = getJsonObjectArray(json, "layers");
-    std::cout << "[DEBUG] Found " << layerObjects.size() << " layer(s)" << std::endl;
+    LOG_DEBUG("[DEBUG] Found " << layerObjects.size() << " layer(s)");
     
     for (const auto& layerJson : layerObjects) {
         std::string type = getJsonString(layerJson, "type");
@@ -1044,15 +1279,16 @@ void TileMap::parseLayers(const std::string& json) {
         layer.isCollision = (nameLower.find("collision") != std::string::npos ||
                              nameLower.find("obstacle") != std::string::npos);
         
-        std::cout << "[OK] Layer: \"" << layer.name << "\" (" << layer.data.size() << " tiles)"
-                  << (layer.isCollision ? " [Collision]" : "") << std::endl;
+        LOG_INFO("[OK] Layer: \"" << layer.name << "\" (" << layer.data.size() << " tiles)"
+              << (layer.isCollision ? " [Collision]" : ""));
         
-        layers.push_back(layer);
+        layers.push_back(std::move(layer));
     }
     
     if (layers.empty()) {
-        std::cerr << "[WARNING] No tile layers found!" << std::endl;
+        LOG_WARN("[WARNING] No tile layers found!");
     }
+    return layers;
 }
 
 // ============================================================================
@@ -1063,21 +1299,21 @@ void TileMap::parseObjectGroups(const std::string& json) {
     objects.clear();
     
     auto layerObjects = getJsonObjectArray(json, "layers");
-    std::cout << "[DEBUG] parseObjectGroups: checking " << layerObjects.size() << " layers" << std::endl;
+    LOG_DEBUG("[DEBUG] parseObjectGroups: checking " << layerObjects.size() << " layers");
     
     for (size_t idx = 0; idx < layerObjects.size(); idx++) {
         const auto& layerJson = layerObjects[idx];
         std::string type = getJsonString(layerJson, "type");
-        std::cout << "[DEBUG] Layer " << idx << " type: \"" << type << "\"" << std::endl;
+        LOG_DEBUG("[DEBUG] Layer " << idx << " type: \"" << type << "\"");
         
         if (type != "objectgroup") continue;
         
         std::string layerName = getJsonString(layerJson, "name");
-        std::cout << "[DEBUG] Parsing object layer: \"" << layerName << "\"" << std::endl;
+        LOG_DEBUG("[DEBUG] Parsing object layer: \"" << layerName << "\"");
         
         // Parse objects array
         auto objectsArray = getJsonObjectArray(layerJson, "objects");
-        std::cout << "[DEBUG] Found " << objectsArray.size() << " object(s)" << std::endl;
+        LOG_DEBUG("[DEBUG] Found " << objectsArray.size() << " object(s)");
         
         for (const auto& objJson : objectsArray) {
             MapObject obj;
@@ -1128,75 +1364,59 @@ void TileMap::parseObjectGroups(const std::string& json) {
                     if (obj.name.empty()) obj.name = obj.tileProperty->name;
                     if (obj.type.empty()) obj.type = obj.tileProperty->type;
                     
-                    std::cout << "[OK] Object: gid=" << obj.gid 
-                              << " (localId=" << localId << ")"
-                              << " -> " << obj.tileProperty->name
-                              << " [" << obj.tileProperty->type << "]"
-                              << " HP=" << obj.tileProperty->hp << std::endl;
+                    LOG_INFO("[OK] Object: gid=" << obj.gid 
+                          << " (localId=" << localId << ")"
+                          << " -> " << obj.tileProperty->name
+                          << " [" << obj.tileProperty->type << "]"
+                          << " HP=" << obj.tileProperty->hp);
                 } else {
-                    std::cout << "[OK] Object: gid=" << obj.gid 
-                              << " at (" << obj.x << ", " << obj.y << ")"
-                              << " (no tile properties)" << std::endl;
+                    LOG_INFO("[OK] Object: gid=" << obj.gid 
+                          << " at (" << obj.x << ", " << obj.y << ")"
+                          << " (no tile properties)");
                 }
                 
                 objects.push_back(obj);
             } else {
-                std::cerr << "[WARNING] No tileset found for object gid=" << obj.gid << std::endl;
+                LOG_WARN("[WARNING] No tileset found for object gid=" << obj.gid);
             }
         }
     }
     
-    std::cout << "[OK] Total " << objects.size() << " map object(s) loaded" << std::endl;
+    LOG_INFO("[OK] Total " << objects.size() << " map object(s) loaded");
 }
 
 // ============================================================================
 // Initialize internal structures from layer data
 // ============================================================================
 
-void TileMap::initializeFromLayers() {
-    groundLayer.resize(width * height);
-    decorationLayer.resize(width * height);
-    collisionLayer.resize(width * height, false);
+void TileMap::initializeFromLayers(const std::vector<LayerInfo>& layers) {
+    groundLayer.assign(width * height, 0);
+    decorationLayer.assign(width * height, 0);
+    collisionLayer.assign(width * height, false);
     
     bool groundFilled = false;
-    int totalTilesPlaced = 0;
+    TileGid maxGid = 0;
+    int skippedTiles = 0;
     
     for (const auto& layer : layers) {
         for (size_t i = 0; i < layer.data.size() && i < (size_t)(width * height); i++) {
             int gid = layer.data[i];
             if (gid <= 0) continue;
             
-            Tile tile;
-            tile.id = gid;
-            
-            // Find corresponding tileset (search from back since sorted by firstGid)
-            int tsIndex = -1;
-            for (int t = (int)tilesets.size() - 1; t >= 0; t--) {
-                if (gid >= tilesets[t].firstGid && tilesets[t].loaded) {
-                    tsIndex = t;
-                    break;
-                }
-            }
-            
-            if (tsIndex >= 0) {
-                tile.textureIndex = tsIndex;
-                const TilesetInfo& ts = tilesets[tsIndex];
-                
-                int localId = gid - ts.firstGid;
-                int cols = ts.columns > 0 ? ts.columns : 16;
-                tile.texCoords.x = (localId % cols) * ts.tileWidth;
-                tile.texCoords.y = (localId / cols) * ts.tileHeight;
-                totalTilesPlaced++;
-            }
-            
             // Collision layer handling
             if (layer.isCollision) {
                 collisionLayer[i] = true;
-            } else if (!groundFilled) {
-                groundLayer[i] = tile;
-            } else {
-                decorationLayer[i] = tile;
+                continue;
             }
+            
+            if (gid > MAX_TILE_GID) {
+                skippedTiles++;
+                continue;
+            }
+            
+            TileGid cell = static_cast<TileGid>(gid);
+            (groundFilled ? decorationLayer : groundLayer)[i] = cell;
+            maxGid = std::max(maxGid, cell);
         }
         
         if (!layer.isCollision && !groundFilled) {
@@ -1204,10 +1424,62 @@ void TileMap::initializeFromLayers() {
         }
     }
     
-    std::cout << "[OK] Placed " << totalTilesPlaced << " tiles with valid textures" << std::endl;
+    if (skippedTiles > 0) {
+        LOG_WARN("[WARNING] Skipped " << skippedTiles << " tiles with gid > " << MAX_TILE_GID);
+    }
+    
+    // 每个 gid 只推导一次贴图坐标
+    tileInfos.clear();
+    ensureTileInfos(maxGid);
+    buildAnimations();
+    
+    // 顶点在渲染时按视野逐块生成
+    resetChunks();
+    
+    int totalTilesPlaced = 0;
+    for (size_t i = 0; i < groundLayer.size(); i++) {
+        if (groundLayer[i] != 0 && tileInfos[groundLayer[i]].tilesetIndex >= 0) totalTilesPlaced++;
+        if (decorationLayer[i] != 0 && tileInfos[decorationLayer[i]].tilesetIndex >= 0) totalTilesPlaced++;
+    }
+    
+    LOG_INFO("[OK] Placed " << totalTilesPlaced << " tiles with valid textures ("
+          << tileInfos.size() << " gid entries)");
     
     if (totalTilesPlaced == 0) {
-        std::cerr << "[WARNING] No tiles placed! Check tileset paths1." << std::endl;
+        LOG_WARN("[WARNING] No tiles placed! Check tileset paths1.");
+    }
+}
+
+// ============================================================================
+// gid 查找表
+// ============================================================================
+
+TileInfo TileMap::makeTileInfo(int gid) const {
+    TileInfo info;
+    
+    // Find corresponding tileset (search from back since sorted by firstGid)
+    for (int t = (int)tilesets.size() - 1; t >= 0; t--) {
+        const TilesetInfo& ts = tilesets[t];
+        if (gid < ts.firstGid) continue;
+        if (!ts.loaded) break;
+        
+        int localId = gid - ts.firstGid;
+        int cols = ts.columns > 0 ? ts.columns : 16;
+        info.tilesetIndex = static_cast<std::int16_t>(t);
+        info.texX = static_cast<std::uint16_t>((localId % cols) * ts.tileWidth);
+        info.texY = static_cast<std::uint16_t>((localId / cols) * ts.tileHeight);
+        break;
+    }
+    return info;
+}
+
+void TileMap::ensureTileInfos(TileGid maxGid) {
+    size_t oldSize = tileInfos.size();
+    if (maxGid < oldSize) return;
+    
+    tileInfos.resize(static_cast<size_t>(maxGid) + 1);
+    for (size_t gid = std::max<size_t>(oldSize, 1); gid <= maxGid; gid++) {
+        tileInfos[gid] = makeTileInfo(static_cast<int>(gid));
     }
 }
 
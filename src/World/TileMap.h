@@ -1,5 +1,6 @@
 #pragma once
 #include <SFML/Graphics.hpp>
+#include <cstdint>
 #include <vector>
 #include <string>
 #include <memory>
@@ -22,13 +23,22 @@ enum class TileType {
     Water = 2
 };
 
-struct Tile {
-    int id;
-    int textureIndex;
-    sf::Vector2i texCoords;
-    TileType type;
+// 图层格子只存 16 位 gid（0 = 空）；贴图坐标等按 gid 查 TileInfo 表
+using TileGid = std::uint16_t;
+
+// 每个 gid 一项，加载时从 tileset 推导，所有格子共用
+struct TileInfo {
+    std::int16_t tilesetIndex;      // -1 = 没有可用的 tileset
+    std::uint16_t texX, texY;       // 在 tileset 贴图中的像素位置
+    std::int16_t animation;         // TileMap::animations 下标，-1 = 静态
     
-    Tile() : id(0), textureIndex(0), texCoords(0, 0), type(TileType::Ground) {}
+    TileInfo() : tilesetIndex(-1), texX(0), texY(0), animation(-1) {}
+};
+
+// tsx 中 <animation> 的一帧（tileid 指同一 tileset 内的 tile）
+struct TileAnimationFrame {
+    int localId;
+    float duration;                 // 秒
 };
 
 // 从tsx文件读取的Tile属性（用于树木、建筑、植物等对象）
@@ -71,6 +81,9 @@ struct TileProperty {
     // === Spritesheet支持（仅用于记录原始位置）===
     sf::IntRect textureRect;        // 在spritesheet中的位置（供调试）
     
+    // === 动画帧（<animation>，为空表示静态 tile）===
+    std::vector<TileAnimationFrame> animation;
+    
     TileProperty() : localId(0), hp(30), defense(5), dropMax(3), 
                      expMin(0), expMax(0), goldMin(0), goldMax(0),
                      allowPickup(false), countMin(1), countMax(1), probability(1.0f),
@@ -88,11 +101,12 @@ struct TilesetInfo {
     std::string imagePath;
     sf::Texture texture;
     bool loaded;
+    bool collection;                            // 每个 tile 独立图片（columns == 0）
     std::string name;                           // tileset名称（如"tree"）
     std::vector<TileProperty> tileProperties;   // 存储每个tile的属性
     
     TilesetInfo() : firstGid(1), tileWidth(32), tileHeight(32), 
-                    columns(16), tileCount(256), loaded(false) {}
+                    columns(16), tileCount(256), loaded(false), collection(false) {}
     
     // 根据localId查找tile属性
     const TileProperty* getTileProperty(int localId) const {
@@ -103,6 +117,7 @@ struct TilesetInfo {
     }
 };
 
+// 解析时的原始图层数据（解码进 16 位图层后即丢弃）
 struct LayerInfo {
     std::string name;
     std::vector<int> data;
@@ -137,10 +152,15 @@ public:
     // ========================================
     bool loadFromTiled(const std::string& tmjPath, int displayTileSize = 0);
     
+    // 无渲染模式（基准测试等）：只解析地图数据和 tile 属性，不加载贴图
+    // 必须在 loadFromTiled 之前设置
+    void setTexturesEnabled(bool enabled) { texturesEnabled = enabled; }
+    
     // ========================================
     // Original array initialization (kept for compatibility)
     // ========================================
     bool loadTilesets();
+    // 需在 loadTilesets 之后调用（gid 表按当前 tileset 推导）
     void setTile(int x, int y, int rawID, bool isGround);
     void initializeFromArray(const std::vector<std::vector<int>>& ground, 
                             const std::vector<std::vector<int>>& decor);
@@ -150,11 +170,27 @@ public:
     // ========================================
     void render(sf::RenderWindow& window, const sf::View& view);
     
+    // 为 bounds（世界像素）覆盖的块生成顶点并标记为最近使用；render 每帧调用，
+    // 无渲染模式（基准测试）可直接调用
+    void prepareChunks(const sf::FloatRect& bounds);
+    
+    // 推进共享的动画时钟，只改写已生成块中帧发生变化的动画格子的贴图坐标
+    void update(float dt);
+    
+    // 已生成的块中登记的动画格子数
+    size_t getAnimatedCellCount() const;
+    
     // ========================================
     // Collision detection
     // ========================================
     bool isColliding(const sf::FloatRect& box) const;
     
+    // 单个图块是否在碰撞层上（越界视为阻挡）
+    bool isTileBlocked(int x, int y) const;
+    
+    // 对象的碰撞框（显示坐标）
+    sf::FloatRect getObjectBounds(const MapObject& obj) const;
+    
     // ========================================
     // Getters
     // ========================================
@@ -237,14 +273,27 @@ private:
     // ========================================
     void parseTilesets(const std::string& json);
     bool loadTsxFile(const std::string& tsxPath, TilesetInfo& ts);
-    void parseLayers(const std::string& json);
+    std::vector<LayerInfo> parseLayers(const std::string& json);
     void parseObjectGroups(const std::string& json);
-    void initializeFromLayers();
+    void initializeFromLayers(const std::vector<LayerInfo>& layers);
+    
+    // ========================================
+    // gid 查找表
+    // ========================================
+    TileInfo makeTileInfo(int gid) const;
+    void ensureTileInfos(TileGid maxGid);   // 表至少覆盖到 maxGid
     
     // ========================================
     // Rendering helpers
     // ========================================
-    void drawTile(sf::RenderWindow& window, const Tile& tile, int x, int y);
+    void resetChunks();                     // 按当前尺寸重建块布局，丢弃所有顶点
+    void chunkRange(const sf::FloatRect& bounds, int& startCX, int& startCY, int& endCX, int& endCY) const;
+    void buildChunk(int chunkIndex);
+    void releaseChunk(int chunkIndex);
+    void trimChunkCache();
+    void appendTileQuad(int chunkIndex, int layer, TileGid gid, int x, int y);
+    void buildAnimations();
+    void selectAnimationFrame(size_t animIndex, size_t frame);
     void renderObjects(sf::RenderWindow& window, const sf::View& view);
 
 private:
@@ -252,12 +301,63 @@ private:
     int tileSize;
     int srcTileSize;
     int tilesPerRow;
+    bool texturesEnabled;
     std::string tmjBasePath;
     
-    std::vector<Tile> groundLayer;
-    std::vector<Tile> decorationLayer;
+    // 每格 2 字节 gid；碰撞层每格 1 位
+    std::vector<TileGid> groundLayer;
+    std::vector<TileGid> decorationLayer;
     std::vector<bool> collisionLayer;
+    std::vector<TileInfo> tileInfos;    // 按 gid 下标，覆盖图层中出现的最大 gid
     std::vector<TilesetInfo> tilesets;
-    std::vector<LayerInfo> layers;
     std::vector<MapObject> objects;  // 对象层中的对象
+    
+    // ========================================
+    // 分块顶点缓存：每块每层按 tileset 各一个 Quads 数组
+    // 只为视野覆盖的块生成顶点，已生成的块数超过 MAX_CACHED_CHUNKS 时淘汰最久
+    // 未用的块（当前视野内的不淘汰）；setTile 只作废所在的块。
+    // 动画只改写已生成块里对应顶点的贴图坐标
+    // ========================================
+    struct TileBatch {
+        int tilesetIndex;
+        sf::VertexArray vertices;
+    };
+    
+    // 使用动画 gid 的格子在所在块顶点中的位置
+    struct AnimatedCell {
+        std::uint16_t animation;            // animations 下标
+        std::uint8_t layer;
+        std::uint8_t batch;
+        std::uint32_t vertex;               // 四边形第一个顶点
+    };
+    
+    struct TileChunk {
+        std::vector<TileBatch> layers[2];   // 0 = 地面，1 = 装饰
+        std::vector<AnimatedCell> animatedCells;
+        std::uint64_t lastUsed = 0;         // 最近一次被 prepareChunks 请求时的 chunkTick
+        bool built = false;
+    };
+    
+    struct TileAnimation {
+        std::int16_t tilesetIndex;
+        std::vector<TileAnimationFrame> frames;
+        float totalDuration;
+        size_t currentFrame;
+        bool frameChanged;                  // 本次 update 换了帧
+        sf::Vector2f texCoords;             // 当前帧左上角贴图坐标（新生成的块直接使用）
+    };
+    
+    std::vector<TileChunk> chunks;          // 未生成的块只占约 88 字节
+    std::vector<int> builtChunks;           // 已生成顶点的块下标
+    std::uint64_t chunkTick;
+    int chunksX, chunksY;
+    
+    std::vector<TileAnimation> animations;
+    double animationClock;                  // 所有动画共用的时钟（秒）
+    
+    static constexpr int CHUNK_SIZE = 16;   // 每块 16x16 格
+    // 每块每层最多约 20 KB 顶点（16x16 格 x 4 顶点 x 20 字节），缓存上限约 10 MB
+    static constexpr size_t MAX_CACHED_CHUNKS = 256;
+    
+    static constexpr int MAX_TILE_GID = 0xFFFF;
 };
\ No newline at end of file
@@ -1,41 +1,139 @@
 #include "Core/Game.h"
+#include "Core/BenchMode.h"
 #include "States/GameState.h"
-#include <iostream>
-#include <fstream>
+#include "Systems/Random.h"
+#include "Systems/InputSystem.h"
+#include "Systems/Logger.h"
+#include "Systems/Profiler.h"
+#include "World/StressScene.h"
 #include <filesystem>
+#include <cstring>
 
-// 全局日志文件
-std::ofstream logFile;
-
-// 自定义日志函数
-void log(const std::string& msg) {
-    logFile << msg << std::endl;
-    logFile.flush();  // 立即写入，防止崩溃丢失
-}
-
-int main() {
-    // 打开日志文件
-    logFile.open("game_log.txt");
-    if (!logFile.is_open()) {
+int main(int argc, char* argv[]) {
+    // 基准测试模式下日志不输出到控制台（结果 JSON 写到标准输出）
+    bool benchMode = false;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--bench") == 0) benchMode = true;
+    }
+    
+    // 启动日志（后台线程写入 game_log.txt 和控制台）
+    Logger& logger = Logger::getInstance();
+    if (!logger.start("game_log.txt", !benchMode)) {
         // 如果当前目录不能写，尝试用户目录
-        logFile.open("C:/game_log.txt");
+        logger.stop();
+        logger.start("C:/game_log.txt", !benchMode);
     }
+    logger.installCrashHandlers();
+    
+    LOG_INFO("========================================");
+    LOG_INFO("  PixelFarmRPG 启动诊断");
+    LOG_INFO("========================================");
     
-    log("========================================");
-    log("  PixelFarmRPG 启动诊断");
-    log("========================================");
+    // 基准测试结果（游戏对象析构、日志停止后再输出）
+    std::unique_ptr<BenchReport> benchReport;
+    std::string benchOutPath;
     
     try {
+        // 0. 命令行参数
+        //    --seed <n>      指定世界种子（用于复现）
+        //    --record <file> 录制输入
+        //    --replay <file> 无渲染回放（使用录制时的种子）
+        //    --trace <file> <first> <count>  导出第 first 帧起 count 帧的 Chrome Trace
+        //                                    （第 0 帧为启动加载）
+        //    --stress <WxH[,trees=N][,stones=N][,plants=N][,rabbits=N][,pools=N]>
+        //                    生成压力测试地图代替农场地图（见 World/StressScene.h）
+        //    --bench <scenario> [--frames N] [--bench-out <file>]
+        //                    端到端基准测试，结束后输出 JSON 并退出（见 Core/BenchMode.h）
+        std::string recordPath;
+        std::string stressSpec;
+        std::string benchScenarioName;
+        std::uint32_t benchFrames = 1800;
+        for (int i = 1; i < argc; i++) {
+            if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+                RandomService::getInstance().setWorldSeed(std::stoull(argv[++i]));
+            } else if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+                recordPath = argv[++i];
+            } else if (std::strcmp(argv[i], "--trace") == 0 && i + 3 < argc) {
+                std::string tracePath = argv[++i];
+                std::uint64_t firstFrame = std::stoull(argv[++i]);
+                std::uint32_t frameCount = static_cast<std::uint32_t>(std::stoul(argv[++i]));
+                Profiler::getInstance().requestCapture(firstFrame, frameCount, tracePath);
+            } else if (std::strcmp(argv[i], "--stress") == 0 && i + 1 < argc) {
+                stressSpec = argv[++i];
+            } else if (std::strcmp(argv[i], "--bench") == 0 && i + 1 < argc) {
+                benchScenarioName = argv[++i];
+            } else if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+                benchFrames = static_cast<std::uint32_t>(std::stoul(argv[++i]));
+            } else if (std::strcmp(argv[i], "--bench-out") == 0 && i + 1 < argc) {
+                benchOutPath = argv[++i];
+            } else if (std::strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+                std::uint64_t replaySeed = 0;
+                if (InputSystem::getInstance().loadReplay(argv[++i], replaySeed)) {
+                    RandomService::getInstance().setWorldSeed(replaySeed);
+                    LOG_INFO("[0] 回放模式: " << argv[i]);
+                }
+            }
+        }
+        
+        // 基准测试场景：决定地图、压力测试参数和输入来源
+        BenchScenario benchScenario;
+        if (benchMode) {
+            if (benchScenarioName.empty() || !BenchMode::findScenario(benchScenarioName, benchScenario)) {
+                std::string names;
+                for (const auto& name : BenchMode::getBuiltinScenarioNames()) names += " " + name;
+                LOG_ERROR("[0] --bench 需要场景名或场景文件，内置场景:" << names);
+                logger.stop();
+                return 2;
+            }
+            if (!benchScenario.stressSpec.empty()) {
+                stressSpec = benchScenario.stressSpec;
+            }
+            if (!benchScenario.replayPath.empty()) {
+                std::uint64_t replaySeed = 0;
+                if (!InputSystem::getInstance().loadReplay(benchScenario.replayPath, replaySeed)) {
+                    logger.stop();
+                    return 1;
+                }
+                RandomService::getInstance().setWorldSeed(replaySeed);
+            } else {
+                InputSystem::getInstance().loadFrames(
+                    BenchMode::buildScriptedInput(benchFrames, BenchMode::FIXED_DT));
+            }
+            LOG_INFO("[0] 基准测试: " << benchScenario.name << "，" << benchFrames << " 帧");
+        }
+        LOG_INFO("[0] 世界种子: " << RandomService::getInstance().getWorldSeed());
+        
+        // 压力测试场景的种子跟随世界种子（回放时也能复现同一张地图）
+        std::unique_ptr<StressSceneConfig> stressScene;
+        if (!stressSpec.empty()) {
+            stressScene = std::make_unique<StressSceneConfig>();
+            if (StressScene::parseSpec(stressSpec, *stressScene)) {
+                stressScene->seed = RandomService::getInstance().getWorldSeed();
+                stressScene->resolveCounts();
+                LOG_INFO("[0] 压力测试场景: " << StressScene::describe(*stressScene));
+            } else {
+                LOG_ERROR("[0] 无效的 --stress 参数: " << stressSpec
+                          << "（格式 WxH[,trees=N][,stones=N][,plants=N][,rabbits=N][,pools=N]，边长不超过 "
+                          << StressScene::MAX_SIZE << "）");
+                stressScene.reset();
+            }
+        }
+        
+        if (!recordPath.empty() && !InputSystem::getInstance().isReplaying()) {
+            InputSystem::getInstance().startRecording(recordPath, RandomService::getInstance().getWorldSeed());
+            LOG_INFO("[0] 录制输入: " << recordPath);
+        }
+        
         // 1. 检查工作目录
-        log("[1] 工作目录: " + std::filesystem::current_path().string());
+        LOG_INFO("[1] 工作目录: " << std::filesystem::current_path().string());
         
         // 2. 检查 assets 目录
         if (std::filesystem::exists("assets")) {
-            log("[2] assets 目录: 存在");
+            LOG_INFO("[2] assets 目录: 存在");
         } else if (std::filesystem::exists("../../assets")) {
-            log("[2] assets 目录: 存在于 ../../assets");
+            LOG_INFO("[2] assets 目录: 存在于 ../../assets");
         } else {
-            log("[2] assets 目录: 不存在!");
+            LOG_INFO("[2] assets 目录: 不存在!");
         }
         
         // 3. 检查关键文件
@@ -47,53 +145,73 @@ int main() {
             "../../assets/game_source/part1.tmj"
         };
         
-        log("[3] 检查关键文件:");
+        LOG_INFO("[3] 检查关键文件:");
         for (const auto& f : checkFiles) {
             if (std::filesystem::exists(f)) {
-                log("    [存在] " + f);
+                LOG_INFO("    [存在] " << f);
             } else {
-                log("    [缺失] " + f);
+                LOG_INFO("    [缺失] " << f);
             }
         }
         
         // 4. 列出 assets 目录内容
-        log("[4] 列出目录内容:");
+        LOG_INFO("[4] 列出目录内容:");
         if (std::filesystem::exists("assets")) {
             for (const auto& entry : std::filesystem::directory_iterator("assets")) {
-                log("    " + entry.path().string());
+                LOG_INFO("    " << entry.path().string());
             }
         }
         
         // 5. 创建游戏窗口
-        log("[5] 创建 Game 对象...");
+        LOG_INFO("[5] 创建 Game 对象...");
         Game game;
-        log("[5] Game 对象创建成功");
+        LOG_INFO("[5] Game 对象创建成功");
         
         // 6. 创建游戏状态
-        log("[6] 创建 GameState 对象...");
-        auto gameState = std::make_unique<GameState>(&game);
-        log("[6] GameState 对象创建成功");
+        LOG_INFO("[6] 创建 GameState 对象...");
+        sf::Clock loadClock;
+        MapType startMap = benchMode ? benchScenario.map : MapType::Farm;
+        auto gameState = std::make_unique<GameState>(&game, startMap, stressScene.get());
+        float loadMs = loadClock.getElapsedTime().asSeconds() * 1000.0f;
+        LOG_INFO("[6] GameState 对象创建成功 (" << loadMs << " ms)");
         
         // 7. 推入状态
-        log("[7] 推入游戏状态...");
+        LOG_INFO("[7] 推入游戏状态...");
         game.pushState(std::move(gameState));
-        log("[7] 状态推入成功");
+        LOG_INFO("[7] 状态推入成功");
         
         // 8. 运行游戏
-        log("[8] 开始游戏主循环...");
-        game.run();
-        log("[8] 游戏正常退出");
+        if (benchMode) {
+            LOG_INFO("[8] 开始基准测试...");
+            benchReport = std::make_unique<BenchReport>();
+            benchReport->scenario = benchScenario.name;
+            benchReport->stress = stressScene ? StressScene::describe(*stressScene) : "";
+            benchReport->input = benchScenario.replayPath.empty() ? "script" : benchScenario.replayPath;
+            benchReport->seed = RandomService::getInstance().getWorldSeed();
+            benchReport->loadMs = loadMs;
+            game.runBench(benchFrames, *benchReport);
+            LOG_INFO("[8] 基准测试完成: " << benchReport->measuredFrames << " 帧");
+        } else {
+            LOG_INFO("[8] 开始游戏主循环...");
+            game.run();
+            InputSystem::getInstance().stopRecording();
+            LOG_INFO("[8] 游戏正常退出");
+        }
         
     } catch (const std::exception& e) {
-        log("[错误] 异常: " + std::string(e.what()));
+        LOG_ERROR("[错误] 异常: " << e.what());
     } catch (...) {
-        log("[错误] 未知异常!");
+        LOG_ERROR("[错误] 未知异常!");
     }
     
-    log("========================================");
-    log("  诊断结束");
-    log("========================================");
+    LOG_INFO("========================================");
+    LOG_INFO("  诊断结束");
+    LOG_INFO("========================================");
+    
+    logger.stop();
     
-    logFile.close();
+    if (benchReport) {
+        return BenchMode::writeReport(*benchReport, benchOutPath) ? 0 : 1;
+    }
     return 0;
 }
\ No newline at end of file
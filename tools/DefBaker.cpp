@@ -0,0 +1,48 @@
+#include "Items/ItemDefinitions.h"
+#include <iostream>
+
+// ============================================================================
+// DefBaker - 物品定义烘焙工具
+//
+// 用法：DefBaker <数据目录> <输出文件>
+//   DefBaker assets/data build/bin/assets/data/defs.bin
+//
+// 读取 items.json / equipment.json / recipes.json，检查交叉引用，
+// 写出游戏启动时加载的二进制定义表。构建时由 CMake 自动运行，
+// 策划修改 JSON 后也可以单独运行，无需重新编译游戏。
+// ============================================================================
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        std::cerr << "Usage: DefBaker <data dir> <output defs.bin>" << std::endl;
+        return 2;
+    }
+
+    const std::string dataDir = argv[1];
+    const std::string outputPath = argv[2];
+
+    ItemDefinitionSet defs;
+    std::string error;
+    if (ItemDefinitions::loadJson(dataDir, defs, error) != DefLoadStatus::Ok) {
+        std::cerr << "[DefBaker] " << error << std::endl;
+        return 1;
+    }
+
+    std::vector<std::string> problems = ItemDefinitions::validate(defs);
+    for (const auto& problem : problems) {
+        std::cerr << "[DefBaker] " << problem << std::endl;
+    }
+    if (!problems.empty()) {
+        return 1;
+    }
+
+    if (!ItemDefinitions::writeBlob(outputPath, defs)) {
+        std::cerr << "[DefBaker] 无法写入: " << outputPath << std::endl;
+        return 1;
+    }
+
+    std::cout << "[DefBaker] " << defs.items.size() << " items, "
+              << defs.equipments.size() << " equipments, "
+              << defs.recipes.size() << " recipes -> " << outputPath << std::endl;
+    return 0;
+}